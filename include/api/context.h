@@ -239,6 +239,17 @@ class MS_API CPUDeviceInfo : public DeviceInfoContext {
   ///
   /// \return Whether enable float16 inference.
   bool GetEnableFP16() const;
+
+  /// \brief Set enables to run the supported float32 kernels with bfloat16 operands and float32 accumulation, only
+  /// takes effect on cpus with avx512-bf16 or armv8.6 bf16 instructions.
+  ///
+  /// \param[in] is_bf16 Enable bfloat16 inference or not.
+  void SetEnableBF16(bool is_bf16);
+
+  /// \brief Get enables to perform the bfloat16 inference
+  ///
+  /// \return Whether enable bfloat16 inference.
+  bool GetEnableBF16() const;
 };
 
 /// \brief Derived from DeviceInfoContext, The configuration of the model running on the NPU. This option is only valid
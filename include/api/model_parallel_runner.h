@@ -72,11 +72,20 @@ class RunnerConfig {
   /// \return The current config path.
   inline std::string GetConfigPath() const;
 
+  /// \brief Get the dynamic batching statistics of the ModelParallelRunner initialized with this config, which is
+  /// enabled by the "enable" key of the "dynamic_batch" config section. Only valid for ModelParallelRunner.
+  ///
+  /// \return The statistics, including batched_requests, batched_runs, average_batch_size, partial_runs and
+  /// fallback_requests. Empty if dynamic batching is not enabled.
+  inline std::map<std::string, std::string> GetBatchingStats() const;
+
  private:
+  friend class ModelPool;
   void SetConfigInfo(const std::vector<char> &section, const std::map<std::vector<char>, std::vector<char>> &config);
   std::map<std::vector<char>, std::map<std::vector<char>, std::vector<char>>> GetConfigInfoChar() const;
   void SetConfigPath(const std::vector<char> &config_path);
   std::vector<char> GetConfigPathChar() const;
+  std::map<std::vector<char>, std::vector<char>> GetBatchingStatsChar() const;
   std::shared_ptr<Data> data_ = nullptr;
 };
 
@@ -92,6 +101,10 @@ void RunnerConfig::SetConfigPath(const std::string &config_path) { SetConfigPath
 
 std::string RunnerConfig::GetConfigPath() const { return CharToString(GetConfigPathChar()); }
 
+std::map<std::string, std::string> RunnerConfig::GetBatchingStats() const {
+  return MapVectorCharToString(GetBatchingStatsChar());
+}
+
 class ModelParallelRunnerImpl;
 
 /// \brief The ModelParallelRunner class is used to define a MindSpore ModelParallelRunner, facilitating Model
@@ -260,6 +260,15 @@ bool EnablePyNativeSyncRunning() {
   MS_EXCEPTION_IF_NULL(ms_context);
   return ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_SYNCHRONIZE);
 }
+
+// Only the ops which can be run lazily are captured, and the outputs of them must not be read until the op sequence
+// is run, so the ops run for gradient are not captured.
+bool EnableOpSequenceCapture(const session::BackendOpRunInfoPtr &op_run_info) {
+  const auto &base_op_run_info = op_run_info->base_op_run_info;
+  return base_op_run_info.allow_deferred_run && base_op_run_info.lazy_build && !base_op_run_info.has_dynamic_output &&
+         !base_op_run_info.use_dynamic_shape_process && !OpInBlackList(op_run_info) &&
+         GetExecutionMode() == kPynativeMode && !EnablePyNativeSyncRunning();
+}
 }  // namespace
 
 VectorRef MsBackend::MsRunGraph(const GraphId &g, const VectorRef &args, const std::string &target) {
@@ -694,6 +703,44 @@ void MindRTBackend::RunMsGradGraph(const CNodePtr &kernel, const VectorRef &args
   root_graph_ = old_root_graph;
 }
 
+void MindRTBackend::InitOpSequenceRunner() {
+  op_sequence_runner_.run_op = [this](const session::BackendOpRunInfoPtr &op_run_info, VectorRef *outputs) {
+    RunOp(op_run_info, outputs);
+  };
+  op_sequence_runner_.compile_graph = [this](const FuncGraphPtr &func_graph) {
+    auto old_root_graph = root_graph_;
+    auto actor_info = CompileGraphs(func_graph);
+    op_sequence_root_graphs_[actor_info] = root_graph_;
+    root_graph_ = old_root_graph;
+    return actor_info;
+  };
+  op_sequence_runner_.run_graph = [this](const ActorInfo &actor_info, const VectorRef &args, VectorRef *outputs) {
+    RunOpSequenceGraph(actor_info, args, outputs);
+  };
+}
+
+void MindRTBackend::RunOpSequenceGraph(const ActorInfo &actor_info, const VectorRef &args, VectorRef *outputs) {
+  const auto &graph_iter = actor_to_graph_compiler_info_.find(actor_info);
+  if (graph_iter == actor_to_graph_compiler_info_.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the graph compiler info, actor_info:" << actor_info;
+  }
+  MS_EXCEPTION_IF_NULL(graph_iter->second);
+  const auto &root_graph_iter = op_sequence_root_graphs_.find(actor_info);
+  if (root_graph_iter == op_sequence_root_graphs_.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the root graph of the op sequence, actor_info:" << actor_info;
+  }
+
+  auto old_root_graph = root_graph_;
+  root_graph_ = root_graph_iter->second;
+  try {
+    RunGraphByActors(actor_info, *(graph_iter->second), args, outputs);
+  } catch (...) {
+    root_graph_ = old_root_graph;
+    throw;
+  }
+  root_graph_ = old_root_graph;
+}
+
 void MindRTBackend::RunGraphBySingleOp(const GraphCompilerInfo &graph_compiler_info, const VectorRef &args,
                                        VectorRef *outputs) {
   WaitTaskFinish();
@@ -1355,6 +1402,17 @@ void MindRTBackend::RunOp(const session::BackendOpRunInfoPtr &op_run_info, Vecto
   MS_EXCEPTION_IF_NULL(device_context);
   device_context->Initialize();
 
+  // The op may be deferred and run with the other ops of a captured op sequence.
+  auto &op_sequence_capture = runtime::OpSequenceCapture::GetInstance();
+  bool enable_capture = EnableOpSequenceCapture(op_run_info);
+  if (enable_capture) {
+    if (op_sequence_capture.Replay(op_run_info, op_sequence_runner_, outputs)) {
+      return;
+    }
+  } else {
+    op_sequence_capture.Interrupt();
+  }
+
   bool single_op_cache_hit = true;
   auto op_compiler_info =
     pynative::OpCompiler::GetInstance().Compile(op_run_info, &single_op_cache_hit, device_context);
@@ -1372,11 +1430,15 @@ void MindRTBackend::RunOp(const session::BackendOpRunInfoPtr &op_run_info, Vecto
   }
 
   RunOpImpl(single_op_cache_hit, op_compiler_info, op_run_info, outputs);
+  if (enable_capture) {
+    op_sequence_capture.Record(op_run_info, *outputs);
+  }
 }
 
 void MindRTBackend::RunOpDynamic(const session::BackendOpRunInfoPtr &op_run_info, VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(op_run_info);
   MS_EXCEPTION_IF_NULL(graph_compiler_);
+  runtime::OpSequenceCapture::GetInstance().Interrupt();
   // Get the device context.
   const auto &device_context =
     device::DeviceContextManager::GetInstance().GetOrCreateDeviceContext({device_name_, device_id_});
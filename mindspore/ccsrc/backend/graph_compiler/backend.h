@@ -36,6 +36,7 @@
 #include "runtime/graph_scheduler/graph_scheduler.h"
 #include "runtime/pynative/async/backend_op_task.h"
 #include "runtime/pynative/op_compiler.h"
+#include "runtime/pynative/op_sequence_capture.h"
 #include "include/backend/visible.h"
 
 namespace mindspore {
@@ -69,7 +70,9 @@ class BACKEND_EXPORT MsBackend : public Backend {
 class BACKEND_EXPORT MindRTBackend : public MindRTBackendBase {
  public:
   MindRTBackend(const std::string &backend_name, const std::string &device_name, uint32_t device_id)
-      : MindRTBackendBase(backend_name, device_name, device_id) {}
+      : MindRTBackendBase(backend_name, device_name, device_id) {
+    InitOpSequenceRunner();
+  }
   ~MindRTBackend() override = default;
 
   // Run single op in the PyNative mode.
@@ -124,6 +127,10 @@ class BACKEND_EXPORT MindRTBackend : public MindRTBackendBase {
 
   void RunMsGradGraph(const CNodePtr &kernel, const VectorRef &args, VectorRef *outputs);
 
+  // Compile and run the graphs of the op sequences captured in PyNative mode.
+  void InitOpSequenceRunner();
+  void RunOpSequenceGraph(const ActorInfo &actor_info, const VectorRef &args, VectorRef *outputs);
+
   void UpdateOutput(const std::vector<session::KernelWithIndex> &output_nodes, VectorRef *const outputs) const;
 
   void ReleaseForwardOutput(const std::vector<TensorPtr> &input_tensors);
@@ -138,6 +145,10 @@ class BACKEND_EXPORT MindRTBackend : public MindRTBackendBase {
 
   // Save the mapping between cell id and func graph infos.
   mindspore::HashMap<std::string, FuncGraphDynamicInfo> func_graph_dynamic_infos_;
+
+  runtime::OpSequenceRunner op_sequence_runner_;
+  // The root graphs of the captured op sequences.
+  mindspore::HashMap<ActorInfo, FuncGraphPtr> op_sequence_root_graphs_;
 };
 using MindRTBackendPtr = std::shared_ptr<compile::MindRTBackend>;
 }  // namespace compile
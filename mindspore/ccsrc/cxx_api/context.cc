@@ -22,6 +22,7 @@
 #include "utils/log_adapter.h"
 
 constexpr auto kModelOptionCpuEnableFP16 = "mindspore.option.cpu.enable_fp16";
+constexpr auto kModelOptionCpuEnableBF16 = "mindspore.option.cpu.enable_bf16";
 constexpr auto kModelOptionGPUEnableFP16 = "mindspore.option.gpu.enable_fp16";
 constexpr auto kModelOptionNPUEnableFP16 = "mindspore.option.npu.enable_fp16";
 constexpr auto kModelOptionKirinNpuFrequency = "mindspore.option.kirin_npu.frequency";
@@ -125,6 +126,15 @@ bool CPUDeviceInfo::GetEnableFP16() const {
   return GetAnyValueBool(data_->params, kModelOptionCpuEnableFP16);
 }
 
+void CPUDeviceInfo::SetEnableBF16(bool is_bf16) {
+  MS_EXCEPTION_IF_NULL(data_);
+  SetAnyValue(&data_->params[kModelOptionCpuEnableBF16], is_bf16);
+}
+bool CPUDeviceInfo::GetEnableBF16() const {
+  MS_EXCEPTION_IF_NULL(data_);
+  return GetAnyValueBool(data_->params, kModelOptionCpuEnableBF16);
+}
+
 void GPUDeviceInfo::SetEnableFP16(bool is_fp16) {
   MS_EXCEPTION_IF_NULL(data_);
   SetAnyValue(&data_->params[kModelOptionGPUEnableFP16], is_fp16);
@@ -0,0 +1,493 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/embedding_cache/sharded_embedding_hash_map.h"
+
+#include <algorithm>
+#include <mutex>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+// Control word of a slot which has never been used, stops the probing.
+constexpr int8_t kCtrlEmpty = -128;
+// Control word of a slot whose id has been erased, the probing goes on.
+constexpr int8_t kCtrlDeleted = -2;
+// Keep the load factor under 7/8 so that every probing sequence meets an empty slot.
+constexpr size_t kMaxLoadNumerator = 7;
+constexpr size_t kMaxLoadDenominator = 8;
+constexpr uint64_t kH2Mask = 0x7F;
+constexpr size_t kH1Shift = 7;
+
+// Bit i of the result is set if group[i] == value.
+inline uint32_t MatchGroup(const int8_t *group, int8_t value) {
+#if defined(__SSE2__)
+  auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl)));
+#elif defined(__aarch64__)
+  static const uint8_t kLaneBits[kSwissGroupWidth] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t cmp = vceqq_s8(vld1q_s8(group), vdupq_n_s8(value));
+  uint8x16_t bits = vandq_u8(cmp, vld1q_u8(kLaneBits));
+  return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits)))
+                                                                << 8);
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kSwissGroupWidth; ++i) {
+    mask |= static_cast<uint32_t>(group[i] == value) << i;
+  }
+  return mask;
+#endif
+}
+
+inline size_t LowestBit(uint32_t mask) { return static_cast<size_t>(__builtin_ctz(mask)); }
+}  // namespace
+
+SwissIdIndexMap::SwissIdIndexMap(size_t capacity) : max_size_(capacity) {
+  // Leave room for the tombstones on top of the max load, so that a full cache which keeps evicting ids does not
+  // rehash on every insertion.
+  constexpr size_t kTombstoneRoomRatio = 8;
+  capacity = std::max(capacity, static_cast<size_t>(1));
+  size_t slot_num = (capacity * kMaxLoadDenominator + kMaxLoadNumerator - 1) / kMaxLoadNumerator +
+                    capacity / kTombstoneRoomRatio;
+  size_t group_num = 1;
+  while (group_num * kSwissGroupWidth < slot_num) {
+    group_num <<= 1;
+  }
+  group_mask_ = group_num - 1;
+  ctrl_.assign(group_num * kSwissGroupWidth, kCtrlEmpty);
+  slots_.resize(group_num * kSwissGroupWidth);
+}
+
+uint64_t SwissIdIndexMap::Hash(int id) {
+  // The finalizer of splitmix64, ids are usually dense integers and need to be spread over all bits.
+  uint64_t x = static_cast<uint64_t>(static_cast<uint32_t>(id));
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+size_t SwissIdIndexMap::FindSlot(int id, uint64_t hash) const {
+  auto h2 = static_cast<int8_t>(hash & kH2Mask);
+  size_t group = (hash >> kH1Shift) & group_mask_;
+  for (size_t probe = 1; probe <= group_mask_ + 1; ++probe) {
+    const int8_t *ctrl = ctrl_.data() + group * kSwissGroupWidth;
+    for (uint32_t match = MatchGroup(ctrl, h2); match != 0; match &= match - 1) {
+      size_t pos = group * kSwissGroupWidth + LowestBit(match);
+      if (slots_[pos].first == id) {
+        return pos;
+      }
+    }
+    if (MatchGroup(ctrl, kCtrlEmpty) != 0) {
+      break;
+    }
+    // Triangular probing visits every group once when the group number is a power of two.
+    group = (group + probe) & group_mask_;
+  }
+  return ctrl_.size();
+}
+
+int SwissIdIndexMap::Find(int id, uint64_t hash) const {
+  size_t pos = FindSlot(id, hash);
+  return pos == ctrl_.size() ? INVALID_INDEX_VALUE : slots_[pos].second;
+}
+
+bool SwissIdIndexMap::Insert(int id, int index, uint64_t hash) {
+  size_t pos = FindSlot(id, hash);
+  if (pos != ctrl_.size()) {
+    slots_[pos].second = index;
+    return true;
+  }
+  if (size_ >= max_size_) {
+    return false;
+  }
+  if ((size_ + tombstones_ + 1) * kMaxLoadDenominator > ctrl_.size() * kMaxLoadNumerator) {
+    Rehash();
+  }
+  size_t group = (hash >> kH1Shift) & group_mask_;
+  for (size_t probe = 1; probe <= group_mask_ + 1; ++probe) {
+    const int8_t *ctrl = ctrl_.data() + group * kSwissGroupWidth;
+    uint32_t free_mask = MatchGroup(ctrl, kCtrlEmpty) | MatchGroup(ctrl, kCtrlDeleted);
+    if (free_mask != 0) {
+      pos = group * kSwissGroupWidth + LowestBit(free_mask);
+      if (ctrl_[pos] == kCtrlDeleted) {
+        tombstones_--;
+      }
+      ctrl_[pos] = static_cast<int8_t>(hash & kH2Mask);
+      slots_[pos] = std::make_pair(id, index);
+      size_++;
+      return true;
+    }
+    group = (group + probe) & group_mask_;
+  }
+  return false;
+}
+
+bool SwissIdIndexMap::Erase(int id, uint64_t hash) {
+  size_t pos = FindSlot(id, hash);
+  if (pos == ctrl_.size()) {
+    return false;
+  }
+  size_--;
+  // If the group still has an empty slot, no probing sequence has ever passed it, the slot can be empty again.
+  if (MatchGroup(ctrl_.data() + (pos / kSwissGroupWidth) * kSwissGroupWidth, kCtrlEmpty) != 0) {
+    ctrl_[pos] = kCtrlEmpty;
+    return true;
+  }
+  ctrl_[pos] = kCtrlDeleted;
+  tombstones_++;
+  return true;
+}
+
+void SwissIdIndexMap::Prefetch(uint64_t hash) const {
+  size_t group = (hash >> kH1Shift) & group_mask_;
+  __builtin_prefetch(ctrl_.data() + group * kSwissGroupWidth);
+  __builtin_prefetch(slots_.data() + group * kSwissGroupWidth);
+}
+
+void SwissIdIndexMap::Clear() {
+  std::fill(ctrl_.begin(), ctrl_.end(), kCtrlEmpty);
+  size_ = 0;
+  tombstones_ = 0;
+}
+
+void SwissIdIndexMap::Rehash() {
+  std::vector<std::pair<int, int>> elements;
+  elements.reserve(size_);
+  ForEach([&elements](int id, int index) { elements.emplace_back(id, index); });
+  Clear();
+  for (const auto &element : elements) {
+    (void)Insert(element.first, element.second, Hash(element.first));
+  }
+}
+
+ShardedEmbeddingHashMap::Shard::Shard(size_t begin, size_t end)
+    : id_to_index_(end - begin), begin_(begin), size_(end - begin) {
+  elements_ = std::make_unique<Element[]>(size_);
+  graph_running_index_ = std::make_unique<int[]>(size_);
+}
+
+int ShardedEmbeddingHashMap::Shard::FindInsertionPos(size_t graph_running_step, bool *const need_swap,
+                                                     bool *const need_wait_graph) {
+  int hash_index = INVALID_INDEX_VALUE;
+  while (!expired_element_full_) {
+    auto &element = elements_[current_pos_];
+    auto step = element.step_.load(std::memory_order_relaxed);
+    if (step == INVALID_STEP_VALUE) {
+      hash_index = SizeToInt(current_pos_);
+    } else if (graph_running_step > step) {
+      hash_index = SizeToInt(current_pos_);
+      *need_swap = true;
+    } else if (step == graph_running_step) {
+      graph_running_index_[graph_running_index_num_++] = SizeToInt(current_pos_);
+    }
+    current_pos_ = (current_pos_ + 1) % size_;
+    if (hash_index != INVALID_INDEX_VALUE) {
+      return hash_index;
+    }
+    if (current_pos_ == current_batch_start_pos_) {
+      expired_element_full_ = true;
+    }
+  }
+
+  if (graph_running_index_pos_ != graph_running_index_num_) {
+    *need_swap = true;
+    *need_wait_graph = true;
+    return graph_running_index_[graph_running_index_pos_++];
+  }
+  return INVALID_INDEX_VALUE;
+}
+
+ShardedEmbeddingHashMap::ShardedEmbeddingHashMap(size_t hash_capacity, size_t shard_num)
+    : hash_capacity_(hash_capacity) {
+  if (hash_capacity == 0) {
+    MS_LOG(EXCEPTION) << "The capacity of ShardedEmbeddingHashMap should be greater than 0.";
+  }
+  // The shard number is a power of two and every shard owns at least one cache index.
+  size_t real_shard_num = 1;
+  while (real_shard_num * 2 <= std::min(shard_num, hash_capacity)) {
+    real_shard_num <<= 1;
+  }
+  shard_mask_ = real_shard_num - 1;
+  shard_size_ = (hash_capacity + real_shard_num - 1) / real_shard_num;
+  for (size_t i = 0; i < real_shard_num; ++i) {
+    size_t begin = std::min(i * shard_size_, hash_capacity);
+    size_t end = std::min(begin + shard_size_, hash_capacity);
+    if (begin == end) {
+      MS_LOG(EXCEPTION) << "Can not split " << hash_capacity << " cache indices into " << real_shard_num << " shards.";
+    }
+    (void)shards_.emplace_back(std::make_unique<Shard>(begin, end));
+  }
+  // In multi-device mode, embedding table are distributed on different devices by id interval,
+  // and ids outside the range of local device will use the front and back positions of the table,
+  // the positions are reserved for this.
+  set_hash_step(0, SIZE_MAX);
+  set_hash_step(SizeToInt(hash_capacity - 1), SIZE_MAX);
+}
+
+ShardedEmbeddingHashMap::Shard *ShardedEmbeddingHashMap::ShardOfIndex(int hash_index) const {
+  auto index = IntToSize(hash_index);
+  if (index >= hash_capacity_) {
+    MS_LOG(EXCEPTION) << "The hash index " << hash_index << " is out of range [0, " << hash_capacity_ << ").";
+  }
+  return shards_[index / shard_size_].get();
+}
+
+size_t ShardedEmbeddingHashMap::hash_step(int hash_index) const {
+  auto shard = ShardOfIndex(hash_index);
+  return shard->elements_[IntToSize(hash_index) - shard->begin_].step_.load(std::memory_order_relaxed);
+}
+
+void ShardedEmbeddingHashMap::set_hash_step(int hash_index, size_t step) {
+  auto shard = ShardOfIndex(hash_index);
+  shard->elements_[IntToSize(hash_index) - shard->begin_].step_.store(step, std::memory_order_relaxed);
+}
+
+size_t ShardedEmbeddingHashMap::hash_count() const {
+  size_t count = 0;
+  for (const auto &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard->mutex_);
+    count += shard->id_to_index_.size();
+  }
+  return count;
+}
+
+void ShardedEmbeddingHashMap::GroupByShard(const int *ids, size_t id_num, std::vector<uint64_t> *hashes,
+                                           std::vector<size_t> *order, std::vector<size_t> *offsets) const {
+  hashes->resize(id_num);
+  order->resize(id_num);
+  offsets->assign(shards_.size() + 1, 0);
+  for (size_t i = 0; i < id_num; ++i) {
+    (*hashes)[i] = SwissIdIndexMap::Hash(ids[i]);
+    (*offsets)[ShardOf((*hashes)[i]) + 1]++;
+  }
+  for (size_t s = 0; s < shards_.size(); ++s) {
+    (*offsets)[s + 1] += (*offsets)[s];
+  }
+  std::vector<size_t> cursor(offsets->begin(), offsets->end() - 1);
+  for (size_t i = 0; i < id_num; ++i) {
+    (*order)[cursor[ShardOf((*hashes)[i])]++] = i;
+  }
+}
+
+size_t ShardedEmbeddingHashMap::BatchFind(const int *ids, size_t id_num, size_t data_step, int *indices) const {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  // Prefetch this many ids ahead of the one being probed.
+  constexpr size_t kPrefetchDistance = 16;
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> order;
+  std::vector<size_t> offsets;
+  GroupByShard(ids, id_num, &hashes, &order, &offsets);
+
+  size_t hit_num = 0;
+  for (size_t s = 0; s < shards_.size(); ++s) {
+    size_t begin = offsets[s];
+    size_t end = offsets[s + 1];
+    if (begin == end) {
+      continue;
+    }
+    auto &shard = *shards_[s];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    // Probe all the ids of the shard first, then refresh the steps of the hits, both with the memory prefetched
+    // ahead, so the cache misses of different ids overlap.
+    for (size_t k = begin; k < end; ++k) {
+      if (k + kPrefetchDistance < end) {
+        shard.id_to_index_.Prefetch(hashes[order[k + kPrefetchDistance]]);
+      }
+      size_t i = order[k];
+      indices[i] = shard.id_to_index_.Find(ids[i], hashes[i]);
+    }
+    for (size_t k = begin; k < end; ++k) {
+      if (k + kPrefetchDistance < end && indices[order[k + kPrefetchDistance]] != INVALID_INDEX_VALUE) {
+        __builtin_prefetch(&shard.elements_[IntToSize(indices[order[k + kPrefetchDistance]])], 1);
+      }
+      size_t i = order[k];
+      if (indices[i] == INVALID_INDEX_VALUE) {
+        continue;
+      }
+      auto &step = shard.elements_[IntToSize(indices[i])].step_;
+      if (step.load(std::memory_order_relaxed) != data_step) {
+        step.store(data_step, std::memory_order_relaxed);
+      }
+      indices[i] += SizeToInt(shard.begin_);
+      hit_num++;
+    }
+  }
+  // The shard locks are all released, the missing ids of the shards which have spilled look into the other shards.
+  for (size_t i = 0; i < id_num; ++i) {
+    if (indices[i] == INVALID_INDEX_VALUE) {
+      indices[i] = FindSpilled(ids[i], hashes[i], data_step);
+      hit_num += indices[i] == INVALID_INDEX_VALUE ? 0 : 1;
+    }
+  }
+  return hit_num;
+}
+
+int ShardedEmbeddingHashMap::FindSpilled(int id, uint64_t hash, size_t data_step) const {
+  size_t home = ShardOf(hash);
+  if (shards_[home]->spilled_num_.load() == 0) {
+    return INVALID_INDEX_VALUE;
+  }
+  for (size_t n = 1; n < shards_.size(); ++n) {
+    auto &shard = *shards_[(home + n) & shard_mask_];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    int local_index = shard.id_to_index_.Find(id, hash);
+    if (local_index != INVALID_INDEX_VALUE) {
+      shard.elements_[IntToSize(local_index)].step_.store(data_step, std::memory_order_relaxed);
+      return SizeToInt(shard.begin_) + local_index;
+    }
+  }
+  return INVALID_INDEX_VALUE;
+}
+
+int ShardedEmbeddingHashMap::InsertSpilled(int id, uint64_t hash, size_t data_step, size_t graph_running_step,
+                                           int *swap_out_index, int *swap_out_ids, size_t *swap_out_size,
+                                           bool *need_wait_graph) {
+  // The id may have spilled earlier in the batch.
+  int hash_index = FindSpilled(id, hash, data_step);
+  if (hash_index != INVALID_INDEX_VALUE) {
+    return hash_index;
+  }
+  size_t home = ShardOf(hash);
+  for (size_t n = 1; n < shards_.size(); ++n) {
+    size_t s = (home + n) & shard_mask_;
+    auto &shard = *shards_[s];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    bool need_swap = false;
+    int local_index = shard.FindInsertionPos(graph_running_step, &need_swap, need_wait_graph);
+    if (local_index != INVALID_INDEX_VALUE) {
+      return InsertElement(s, local_index, need_swap, id, hash, data_step, swap_out_index, swap_out_ids,
+                           swap_out_size);
+    }
+  }
+  return INVALID_INDEX_VALUE;
+}
+
+int ShardedEmbeddingHashMap::InsertElement(size_t shard_id, int local_index, bool need_swap, int id, uint64_t hash,
+                                           size_t data_step, int *swap_out_index, int *swap_out_ids,
+                                           size_t *swap_out_size) {
+  auto &shard = *shards_[shard_id];
+  auto &element = shard.elements_[IntToSize(local_index)];
+  int hash_index = SizeToInt(shard.begin_) + local_index;
+  if (need_swap) {
+    swap_out_index[*swap_out_size] = hash_index;
+    swap_out_ids[*swap_out_size] = element.id_;
+    (*swap_out_size)++;
+    auto evicted_hash = SwissIdIndexMap::Hash(element.id_);
+    (void)shard.id_to_index_.Erase(element.id_, evicted_hash);
+    if (ShardOf(evicted_hash) != shard_id) {
+      (void)shards_[ShardOf(evicted_hash)]->spilled_num_.fetch_sub(1);
+    }
+  }
+  if (!shard.id_to_index_.Insert(id, local_index, hash)) {
+    MS_LOG(EXCEPTION) << "Insert id " << id << " into shard " << shard_id << " failed.";
+  }
+  if (ShardOf(hash) != shard_id) {
+    (void)shards_[ShardOf(hash)]->spilled_num_.fetch_add(1);
+  }
+  element.id_ = id;
+  element.step_.store(data_step, std::memory_order_relaxed);
+  return hash_index;
+}
+
+bool ShardedEmbeddingHashMap::BatchInsert(const int *ids, size_t id_num, size_t data_step, size_t graph_running_step,
+                                          int *indices, int *swap_out_index, int *swap_out_ids,
+                                          size_t *swap_out_size, bool *need_wait_graph) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(swap_out_index);
+  MS_EXCEPTION_IF_NULL(swap_out_ids);
+  MS_EXCEPTION_IF_NULL(swap_out_size);
+  MS_EXCEPTION_IF_NULL(need_wait_graph);
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> order;
+  std::vector<size_t> offsets;
+  GroupByShard(ids, id_num, &hashes, &order, &offsets);
+
+  // The ids whose shard has no slot to give, they spill to the other shards once the shard locks are released.
+  std::vector<size_t> spilled;
+  for (size_t s = 0; s < shards_.size(); ++s) {
+    if (offsets[s] == offsets[s + 1]) {
+      continue;
+    }
+    auto &shard = *shards_[s];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    for (size_t k = offsets[s]; k < offsets[s + 1]; ++k) {
+      size_t i = order[k];
+      // The id may appear more than once in a batch.
+      int local_index = shard.id_to_index_.Find(ids[i], hashes[i]);
+      if (local_index != INVALID_INDEX_VALUE) {
+        shard.elements_[IntToSize(local_index)].step_.store(data_step, std::memory_order_relaxed);
+        indices[i] = SizeToInt(shard.begin_) + local_index;
+        continue;
+      }
+      bool need_swap = false;
+      local_index = shard.FindInsertionPos(graph_running_step, &need_swap, need_wait_graph);
+      if (local_index == INVALID_INDEX_VALUE) {
+        spilled.push_back(i);
+        continue;
+      }
+      indices[i] = InsertElement(s, local_index, need_swap, ids[i], hashes[i], data_step, swap_out_index,
+                                 swap_out_ids, swap_out_size);
+    }
+  }
+
+  bool success = true;
+  for (size_t i : spilled) {
+    indices[i] = InsertSpilled(ids[i], hashes[i], data_step, graph_running_step, swap_out_index, swap_out_ids,
+                               swap_out_size, need_wait_graph);
+    if (indices[i] == INVALID_INDEX_VALUE) {
+      MS_LOG(ERROR) << "All the shards of the embedding hash map are full, can not insert id " << ids[i];
+      success = false;
+    }
+  }
+  return success;
+}
+
+void ShardedEmbeddingHashMap::Reset() {
+  for (auto &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard->mutex_);
+    shard->current_batch_start_pos_ = shard->current_pos_;
+    shard->graph_running_index_num_ = 0;
+    shard->graph_running_index_pos_ = 0;
+    shard->expired_element_full_ = false;
+  }
+}
+
+void ShardedEmbeddingHashMap::DumpHashMap() const {
+  MS_LOG(INFO) << "Dump sharded hash map info begin, hash_capacity: " << hash_capacity_
+               << " shard_num: " << shards_.size() << " hash_count: " << hash_count();
+  for (size_t s = 0; s < shards_.size(); ++s) {
+    const auto &shard = *shards_[s];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    MS_LOG(INFO) << "Shard " << s << " range: [" << shard.begin_ << ", " << shard.begin_ + shard.size_
+                 << ") count: " << shard.id_to_index_.size();
+    shard.id_to_index_.ForEach([&shard](int id, int index) {
+      MS_LOG(INFO) << "  id: " << id << " index: " << shard.begin_ + IntToSize(index)
+                   << " step: " << shard.elements_[IntToSize(index)].step_.load(std::memory_order_relaxed);
+    });
+  }
+  MS_LOG(INFO) << "Dump sharded hash map info end.";
+}
+}  // namespace distributed
+}  // namespace mindspore
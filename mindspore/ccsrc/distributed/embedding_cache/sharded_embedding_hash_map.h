@@ -0,0 +1,181 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_SHARDED_EMBEDDING_HASH_MAP_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_SHARDED_EMBEDDING_HASH_MAP_H_
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "distributed/embedding_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace distributed {
+// The number of control bytes probed at once.
+constexpr size_t kSwissGroupWidth = 16;
+// The default number of shards of ShardedEmbeddingHashMap.
+constexpr size_t kDefaultEmbeddingHashShardNum = 16;
+
+// SwissIdIndexMap is an open addressing id -> index map in the style of Swiss tables. Every slot has a one byte
+// control word holding 7 bits of the hash, a lookup compares a whole group of 16 control words with one SIMD
+// instruction and only touches the slots whose control word matches.
+// The capacity is fixed at construction, the map never holds more ids than the cache slots it serves.
+class SwissIdIndexMap {
+ public:
+  explicit SwissIdIndexMap(size_t capacity);
+  ~SwissIdIndexMap() = default;
+
+  static uint64_t Hash(int id);
+
+  // Return the index of the id, or INVALID_INDEX_VALUE if the id is not in the map.
+  int Find(int id, uint64_t hash) const;
+  // Insert the id or update its index, return false if the map is full.
+  bool Insert(int id, int index, uint64_t hash);
+  // Remove the id, return false if the id is not in the map.
+  bool Erase(int id, uint64_t hash);
+  // Prefetch the first group probed for the hash, used by batched lookup to hide the cache misses.
+  void Prefetch(uint64_t hash) const;
+  void Clear();
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return max_size_; }
+
+  // Call func(id, index) for every id in the map.
+  template <typename Func>
+  void ForEach(Func &&func) const {
+    for (size_t i = 0; i < ctrl_.size(); ++i) {
+      if (ctrl_[i] >= 0) {
+        func(slots_[i].first, slots_[i].second);
+      }
+    }
+  }
+
+ private:
+  // Return the slot position of the id, or ctrl_.size() if the id is not in the map.
+  size_t FindSlot(int id, uint64_t hash) const;
+  // Rebuild the table to drop the tombstones.
+  void Rehash();
+
+  std::vector<int8_t> ctrl_;
+  std::vector<std::pair<int, int>> slots_;
+  size_t group_mask_{0};
+  size_t size_{0};
+  size_t tombstones_{0};
+  size_t max_size_{0};
+};
+
+// ShardedEmbeddingHashMap is a sharded variant of EmbeddingHashMap. The cache indices [0, hash_capacity) are split
+// into contiguous ranges, one per shard, and an id lives in the shard selected by its hash. Each shard has its own
+// Swiss table, slot steps and insertion cursor, guarded by a reader-writer lock, so lookups from several threads run
+// in parallel while a single writer inserts the missing ids.
+// When the ids are skewed and the shard of an id has no slot to give, the id spills to the next shards in turn, so the
+// map is only full when the whole cache is. A shard counts its ids living in other shards, the lookup of a missing id
+// goes on to the next shards only if the count is not zero.
+// The batched interfaces group the ids by shard, lock each shard once and prefetch the probed groups ahead.
+class ShardedEmbeddingHashMap {
+ public:
+  ShardedEmbeddingHashMap(size_t hash_capacity, size_t shard_num = kDefaultEmbeddingHashShardNum);
+  ~ShardedEmbeddingHashMap() = default;
+
+  // Look up a batch of ids, indices[i] is set to the cache index of ids[i] or INVALID_INDEX_VALUE on miss.
+  // The step of every hit element is refreshed to data_step, so it will not be swapped out by this step.
+  // Thread safe, can be called by several readers at the same time.
+  // Return the number of hits.
+  size_t BatchFind(const int *ids, size_t id_num, size_t data_step, int *indices) const;
+
+  // Insert a batch of ids which are not in the map, indices[i] is set to the cache index allocated for ids[i], or
+  // INVALID_INDEX_VALUE if all the shards are full of elements used by the running graph.
+  // The evicted elements are appended to swap_out_index/swap_out_ids, which should be able to hold id_num elements.
+  // Must be called by a single writer.
+  // Return false if any id can not be inserted.
+  bool BatchInsert(const int *ids, size_t id_num, size_t data_step, size_t graph_running_step, int *indices,
+                   int *swap_out_index, int *swap_out_ids, size_t *swap_out_size, bool *need_wait_graph);
+
+  // Get the global step of a element in hash map.
+  size_t hash_step(int hash_index) const;
+  // Set the global step of a element in hash map.
+  void set_hash_step(int hash_index, size_t step);
+
+  size_t hash_capacity() const { return hash_capacity_; }
+  size_t shard_num() const { return shards_.size(); }
+  // The number of ids in the map.
+  size_t hash_count() const;
+
+  // Reset the insertion cursor of every shard, called when a new batch of data starts.
+  void Reset();
+
+  void DumpHashMap() const;
+
+ private:
+  struct Element {
+    int id_{INVALID_INDEX_VALUE};
+    // The step is refreshed by readers under the shared lock, so it is atomic.
+    std::atomic<size_t> step_{INVALID_STEP_VALUE};
+  };
+
+  struct Shard {
+    Shard(size_t begin, size_t end);
+
+    // Find the insertion position (index in elements_) in the shard, the same policy as EmbeddingHashMap.
+    int FindInsertionPos(size_t graph_running_step, bool *const need_swap, bool *const need_wait_graph);
+
+    mutable std::shared_mutex mutex_;
+    SwissIdIndexMap id_to_index_;
+    // The first global cache index owned by this shard.
+    size_t begin_;
+    std::unique_ptr<Element[]> elements_;
+    size_t size_;
+    size_t current_pos_{0};
+    size_t current_batch_start_pos_{0};
+    size_t graph_running_index_num_{0};
+    size_t graph_running_index_pos_{0};
+    std::unique_ptr<int[]> graph_running_index_;
+    bool expired_element_full_{false};
+    // The number of ids of this shard which have spilled to other shards, updated under the lock of the shard holding
+    // the id.
+    std::atomic<size_t> spilled_num_{0};
+  };
+
+  size_t ShardOf(uint64_t hash) const { return (hash >> kShardHashShift) & shard_mask_; }
+  Shard *ShardOfIndex(int hash_index) const;
+  // Bucket the positions of ids by shard, order[offsets[s], offsets[s + 1]) are the positions of shard s.
+  void GroupByShard(const int *ids, size_t id_num, std::vector<uint64_t> *hashes, std::vector<size_t> *order,
+                    std::vector<size_t> *offsets) const;
+  // Look up the id in the shards it may have spilled to, refresh the step on hit. Return the cache index or
+  // INVALID_INDEX_VALUE. The caller must not hold the lock of any shard.
+  int FindSpilled(int id, uint64_t hash, size_t data_step) const;
+  // Insert the id into the next shard with a slot to give, return the cache index or INVALID_INDEX_VALUE.
+  // The caller must not hold the lock of any shard.
+  int InsertSpilled(int id, uint64_t hash, size_t data_step, size_t graph_running_step, int *swap_out_index,
+                    int *swap_out_ids, size_t *swap_out_size, bool *need_wait_graph);
+  // Put the id at local_index of the shard, whose lock is held, and swap out the id there if need_swap.
+  // Return the cache index.
+  int InsertElement(size_t shard_id, int local_index, bool need_swap, int id, uint64_t hash, size_t data_step,
+                    int *swap_out_index, int *swap_out_ids, size_t *swap_out_size);
+
+  // Use the high bits to pick the shard, the low bits pick the group inside the shard.
+  static constexpr size_t kShardHashShift = 48;
+
+  size_t hash_capacity_;
+  size_t shard_mask_;
+  size_t shard_size_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_SHARDED_EMBEDDING_HASH_MAP_H_
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/shm/shm_client.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+bool ShmClient::Connect(const std::string &name, const MemFreeCallback &free_cb) {
+  if (!ring_.Open(name)) {
+    MS_LOG(WARNING) << "Failed to connect to the shared memory server " << name;
+    return false;
+  }
+  free_cb_ = free_cb;
+  MS_LOG(INFO) << "Connect to the shared memory server " << name << ", capacity: " << ring_.capacity();
+  return true;
+}
+
+void ShmClient::Disconnect() { ring_.Close(); }
+
+bool ShmClient::Send(const AID &from, const std::vector<ShmBuffer> &buffers) {
+  return ring_.Write(std::string(from), buffers);
+}
+
+bool ShmClient::SendMessage(std::unique_ptr<MessageBase> &&msg) {
+  MS_ERROR_IF_NULL(msg);
+  if (msg->data == nullptr) {
+    return ring_.Write(std::string(msg->from), {{msg->body.data(), msg->body.size()}});
+  }
+
+  bool success = ring_.Write(std::string(msg->from), {{msg->data, msg->size}});
+  // The data has been copied to the shared memory, release it as the tcp connection does after sending.
+  if (!free_cb_) {
+    MS_LOG(ERROR) << "The free memory callback is not set. Can't free the data in message.";
+    return false;
+  }
+  if (!free_cb_(msg->data)) {
+    MS_LOG(ERROR) << "Failed to free message data memory.";
+    return false;
+  }
+  return success;
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
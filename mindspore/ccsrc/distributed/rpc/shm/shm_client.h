@@ -0,0 +1,68 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_CLIENT_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_CLIENT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "distributed/rpc/shm/shm_ring.h"
+#include "distributed/rpc/tcp/constants.h"
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// ShmClient sends messages to the ShmServer of another process on the same host. The sending is synchronous: it
+// returns after the message is copied into the shared memory ring, and blocks while the ring is full.
+class BACKEND_EXPORT ShmClient {
+ public:
+  ShmClient() = default;
+  ~ShmClient() = default;
+
+  // Connect to the server with the name of its shared memory.
+  // Function free_cb frees the data of the message after the data is copied to the shared memory.
+  bool Connect(
+    const std::string &name, const MemFreeCallback &free_cb = [](void *data) {
+      MS_ERROR_IF_NULL(data);
+      delete static_cast<char *>(data);
+      return true;
+    });
+
+  void Disconnect();
+
+  // Send the payload gathered from the buffers without building a message, so the payload is only copied once.
+  bool Send(const AID &from, const std::vector<ShmBuffer> &buffers);
+
+  // Send the data of the message if it's set, otherwise send the body of the message.
+  bool SendMessage(std::unique_ptr<MessageBase> &&msg);
+
+  const std::string &GetName() const { return ring_.name(); }
+
+ private:
+  ShmRing ring_;
+  MemFreeCallback free_cb_;
+
+  DISABLE_COPY_AND_ASSIGN(ShmClient);
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_CLIENT_H_
@@ -0,0 +1,450 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/shm/shm_ring.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <new>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+constexpr uint64_t kShmRingMagic = 0x4d5352494e473031;  // "MSRING01"
+constexpr size_t kShmRingHeaderSize = 4096;
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kRecordAlign = 16;
+constexpr size_t kShmRingMinCapacity = 1 << 16;
+// A chunk takes at most a quarter of the ring, so the writer can fill the ring while the reader drains it.
+constexpr size_t kMaxChunkRatio = 4;
+constexpr int kSpinCount = 4096;
+// The number of failed tries to take the writer lock between two liveness checks of its owner.
+constexpr size_t kLockCheckInterval = 1024;
+constexpr long kFutexWaitTimeoutNs = 10000000;  // 10ms
+constexpr char kBootIdPath[] = "/proc/sys/kernel/random/boot_id";
+
+constexpr uint32_t kRecordFirst = 1;
+constexpr uint32_t kRecordLast = 2;
+// The record tells the reader to skip the tail of the ring and go on from the beginning.
+constexpr uint32_t kRecordWrap = 4;
+
+// The first record of a message is followed by the meta, then every record is followed by a chunk of the payload.
+struct ShmRecordHeader {
+  uint32_t chunk_size;
+  uint16_t flags;
+  uint16_t meta_size;
+  // The byte size of the whole payload, only valid in the first record.
+  uint64_t total_size;
+};
+static_assert(sizeof(ShmRecordHeader) == kRecordAlign, "The record header should be aligned.");
+
+size_t AlignUp(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+size_t RoundUpPowerOfTwo(size_t size) {
+  size_t result = 1;
+  while (result < size) {
+    result <<= 1;
+  }
+  return result;
+}
+
+int FutexWait(std::atomic<uint32_t> *addr, uint32_t expected) {
+  struct timespec timeout = {0, kFutexWaitTimeoutNs};
+  // The ring is shared between processes, so the private futex can not be used.
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAIT, expected, &timeout,
+                                  nullptr, 0));
+}
+
+void FutexWakeAll(std::atomic<uint32_t> *addr) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// EPERM means the process exists but belongs to another user.
+bool IsProcessAlive(uint32_t pid) { return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH; }
+}  // namespace
+
+struct ShmRingHeader {
+  uint64_t magic;
+  uint64_t capacity;
+  // The positions increase monotonically, the offset in the ring is the position modulo the capacity.
+  alignas(kCacheLineSize) std::atomic<uint64_t> write_pos;
+  alignas(kCacheLineSize) std::atomic<uint64_t> read_pos;
+  // The pid of the reader, the creator of the ring.
+  uint32_t owner_pid;
+  // The pid of the writer holding the lock, 0 if the lock is free.
+  alignas(kCacheLineSize) std::atomic<uint32_t> writer_lock;
+  std::atomic<uint32_t> closed;
+  // The futex words which are bumped when data is written or space is freed.
+  alignas(kCacheLineSize) std::atomic<uint32_t> data_seq;
+  std::atomic<uint32_t> data_waiters;
+  alignas(kCacheLineSize) std::atomic<uint32_t> space_seq;
+  std::atomic<uint32_t> space_waiters;
+};
+static_assert(sizeof(ShmRingHeader) <= kShmRingHeaderSize, "The ring header is too large.");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The atomic in shared memory should be lock free.");
+
+ShmRing::~ShmRing() { Close(); }
+
+bool ShmRing::Create(const std::string &name, size_t capacity) {
+  capacity = RoundUpPowerOfTwo(std::max(capacity, kShmRingMinCapacity));
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0 && errno == EEXIST) {
+    // The shared memory is left by a crashed process with the same pid.
+    MS_LOG(WARNING) << "The shared memory " << name << " already exists, recreate it.";
+    (void)shm_unlink(name.c_str());
+    fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  }
+  if (fd < 0) {
+    MS_LOG(WARNING) << "Failed to create the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  size_t total_size = kShmRingHeaderSize + capacity;
+  if (ftruncate(fd, static_cast<off_t>(total_size)) != 0) {
+    MS_LOG(WARNING) << "Failed to resize the shared memory " << name << " to " << total_size << ", errno: " << errno;
+    (void)close(fd);
+    (void)shm_unlink(name.c_str());
+    return false;
+  }
+  name_ = name;
+  is_creator_ = true;
+  if (!Map(fd, total_size)) {
+    Close();
+    return false;
+  }
+  header_ = new (addr_) ShmRingHeader();
+  header_->capacity = capacity;
+  header_->owner_pid = static_cast<uint32_t>(getpid());
+  header_->write_pos = 0;
+  header_->read_pos = 0;
+  header_->writer_lock = 0;
+  header_->closed = 0;
+  header_->data_seq = 0;
+  header_->data_waiters = 0;
+  header_->space_seq = 0;
+  header_->space_waiters = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kShmRingMagic;
+  return true;
+}
+
+bool ShmRing::Open(const std::string &name) {
+  int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(WARNING) << "Failed to open the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) <= kShmRingHeaderSize) {
+    MS_LOG(WARNING) << "The shared memory " << name << " is not a ring.";
+    (void)close(fd);
+    return false;
+  }
+  name_ = name;
+  is_creator_ = false;
+  if (!Map(fd, static_cast<size_t>(file_stat.st_size))) {
+    Close();
+    return false;
+  }
+  header_ = reinterpret_cast<ShmRingHeader *>(addr_);
+  if (header_->magic != kShmRingMagic || header_->capacity + kShmRingHeaderSize != mapped_size_) {
+    MS_LOG(WARNING) << "The shared memory " << name << " is not a ring.";
+    Close();
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+bool ShmRing::Map(int fd, size_t total_size) {
+  auto addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping keeps the shared memory alive, the descriptor is no longer needed.
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Failed to map the shared memory " << name_ << ", errno: " << errno;
+    return false;
+  }
+  addr_ = addr;
+  mapped_size_ = total_size;
+  data_ = reinterpret_cast<uint8_t *>(addr_) + kShmRingHeaderSize;
+  return true;
+}
+
+void ShmRing::Close() {
+  if (addr_ != nullptr) {
+    (void)munmap(addr_, mapped_size_);
+    addr_ = nullptr;
+  }
+  if (is_creator_ && !name_.empty()) {
+    (void)shm_unlink(name_.c_str());
+  }
+  header_ = nullptr;
+  data_ = nullptr;
+  mapped_size_ = 0;
+  is_creator_ = false;
+}
+
+size_t ShmRing::capacity() const { return header_ == nullptr ? 0 : header_->capacity; }
+
+void ShmRing::Shutdown() {
+  if (header_ == nullptr) {
+    return;
+  }
+  header_->closed.store(1, std::memory_order_seq_cst);
+  header_->data_seq.fetch_add(1, std::memory_order_seq_cst);
+  header_->space_seq.fetch_add(1, std::memory_order_seq_cst);
+  FutexWakeAll(&header_->data_seq);
+  FutexWakeAll(&header_->space_seq);
+}
+
+template <typename Pred>
+bool ShmRing::WaitFor(std::atomic<uint32_t> *seq, std::atomic<uint32_t> *waiters, Pred &&ready) const {
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (ready()) {
+      return true;
+    }
+    if (header_->closed.load(std::memory_order_relaxed) != 0) {
+      return false;
+    }
+  }
+  while (header_->closed.load(std::memory_order_acquire) == 0) {
+    auto current = seq->load(std::memory_order_seq_cst);
+    (void)waiters->fetch_add(1, std::memory_order_seq_cst);
+    if (ready()) {
+      (void)waiters->fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    // The timeout bounds the wait if the peer process exits without waking us up.
+    (void)FutexWait(seq, current);
+    (void)waiters->fetch_sub(1, std::memory_order_relaxed);
+    if (ready()) {
+      return true;
+    }
+    // Nobody frees space in the ring after the reader exits.
+    if (!IsProcessAlive(header_->owner_pid)) {
+      MS_LOG(WARNING) << "The reader process " << header_->owner_pid << " of shared memory " << name_ << " exited.";
+      return false;
+    }
+  }
+  return false;
+}
+
+bool ShmRing::LockWriter() {
+  const auto self = static_cast<uint32_t>(getpid());
+  for (size_t i = 1;; ++i) {
+    uint32_t owner = 0;
+    if (header_->writer_lock.compare_exchange_weak(owner, self, std::memory_order_acquire)) {
+      return true;
+    }
+    if (header_->closed.load(std::memory_order_relaxed) != 0) {
+      return false;
+    }
+    // A writer killed while holding the lock never releases it, so the liveness of the owner is checked once in a
+    // while and the lock of a dead owner is taken over. The reader drops the message the dead writer left unfinished.
+    if (i % kLockCheckInterval == 0 && owner != 0 && !IsProcessAlive(owner) &&
+        header_->writer_lock.compare_exchange_strong(owner, self, std::memory_order_acquire)) {
+      MS_LOG(WARNING) << "The writer process " << owner << " of shared memory " << name_
+                      << " exited while holding the lock, take the lock over.";
+      return true;
+    }
+    (void)sched_yield();
+  }
+}
+
+void ShmRing::Notify(std::atomic<uint32_t> *seq, const std::atomic<uint32_t> *waiters) const {
+  (void)seq->fetch_add(1, std::memory_order_seq_cst);
+  if (waiters->load(std::memory_order_seq_cst) != 0) {
+    FutexWakeAll(seq);
+  }
+}
+
+bool ShmRing::Write(const std::string &meta, const std::vector<ShmBuffer> &buffers) {
+  MS_EXCEPTION_IF_NULL(header_);
+  if (meta.size() > kShmRingMaxMetaSize) {
+    MS_LOG(ERROR) << "The meta size " << meta.size() << " exceeds the limit " << kShmRingMaxMetaSize;
+    return false;
+  }
+  size_t total_size = 0;
+  for (const auto &buffer : buffers) {
+    total_size += buffer.second;
+  }
+
+  // The writers of different processes are serialized for the whole message, so the chunks are not interleaved.
+  if (!LockWriter()) {
+    return false;
+  }
+  if (header_->closed.load(std::memory_order_acquire) != 0) {
+    header_->writer_lock.store(0, std::memory_order_release);
+    return false;
+  }
+
+  const uint64_t capacity = header_->capacity;
+  const size_t max_chunk_size = capacity / kMaxChunkRatio - sizeof(ShmRecordHeader);
+  size_t buffer_index = 0;
+  size_t buffer_offset = 0;
+  size_t remaining = total_size;
+  bool first = true;
+  bool success = true;
+  while (first || remaining > 0) {
+    size_t meta_size = first ? meta.size() : 0;
+    size_t chunk_size = std::min(remaining, max_chunk_size - meta_size);
+    size_t record_size = sizeof(ShmRecordHeader) + AlignUp(meta_size + chunk_size, kRecordAlign);
+    uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
+    size_t offset = static_cast<size_t>(write_pos & (capacity - 1));
+    size_t contiguous = capacity - offset;
+    size_t wrap_size = contiguous < record_size ? contiguous : 0;
+    if (!WaitFor(&header_->space_seq, &header_->space_waiters, [this, write_pos, wrap_size, record_size, capacity]() {
+          return write_pos + wrap_size + record_size - header_->read_pos.load(std::memory_order_acquire) <= capacity;
+        })) {
+      success = false;
+      break;
+    }
+    if (wrap_size != 0) {
+      auto wrap = reinterpret_cast<ShmRecordHeader *>(data_ + offset);
+      wrap->chunk_size = 0;
+      wrap->flags = kRecordWrap;
+      wrap->meta_size = 0;
+      wrap->total_size = 0;
+      write_pos += wrap_size;
+      offset = 0;
+    }
+
+    auto record = reinterpret_cast<ShmRecordHeader *>(data_ + offset);
+    record->chunk_size = static_cast<uint32_t>(chunk_size);
+    record->flags = static_cast<uint16_t>((first ? kRecordFirst : 0) | (remaining == chunk_size ? kRecordLast : 0));
+    record->meta_size = static_cast<uint16_t>(meta_size);
+    record->total_size = total_size;
+    uint8_t *dst = data_ + offset + sizeof(ShmRecordHeader);
+    if (meta_size != 0) {
+      (void)memcpy(dst, meta.data(), meta_size);
+      dst += meta_size;
+    }
+    // Gather the pieces of the payload into the ring, this is the only copy on the sender side.
+    size_t to_copy = chunk_size;
+    while (to_copy > 0) {
+      const auto &buffer = buffers[buffer_index];
+      size_t copy_size = std::min(to_copy, buffer.second - buffer_offset);
+      (void)memcpy(dst, static_cast<const uint8_t *>(buffer.first) + buffer_offset, copy_size);
+      dst += copy_size;
+      to_copy -= copy_size;
+      buffer_offset += copy_size;
+      if (buffer_offset == buffer.second) {
+        ++buffer_index;
+        buffer_offset = 0;
+      }
+    }
+    header_->write_pos.store(write_pos + record_size, std::memory_order_release);
+    Notify(&header_->data_seq, &header_->data_waiters);
+    remaining -= chunk_size;
+    first = false;
+  }
+
+  header_->writer_lock.store(0, std::memory_order_release);
+  return success;
+}
+
+bool ShmRing::Read(std::string *meta, const std::function<void *(size_t size)> &allocate_cb, size_t *size,
+                   const std::function<void(void *data)> &free_cb) {
+  MS_EXCEPTION_IF_NULL(header_);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(size);
+  const uint64_t capacity = header_->capacity;
+  uint8_t *message = nullptr;
+  size_t received = 0;
+  bool discard = false;
+  bool started = false;
+  auto free_message = [&message, &free_cb]() {
+    if (message != nullptr && free_cb) {
+      free_cb(message);
+    }
+    message = nullptr;
+  };
+  while (true) {
+    uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+    if (!WaitFor(&header_->data_seq, &header_->data_waiters, [this, read_pos]() {
+          return header_->write_pos.load(std::memory_order_acquire) != read_pos;
+        })) {
+      free_message();
+      return false;
+    }
+    size_t offset = static_cast<size_t>(read_pos & (capacity - 1));
+    const auto record = reinterpret_cast<const ShmRecordHeader *>(data_ + offset);
+    if ((record->flags & kRecordWrap) != 0) {
+      header_->read_pos.store(read_pos + (capacity - offset), std::memory_order_release);
+      Notify(&header_->space_seq, &header_->space_waiters);
+      continue;
+    }
+    const uint8_t *src = data_ + offset + sizeof(ShmRecordHeader);
+    if ((record->flags & kRecordFirst) != 0) {
+      // The writer of the current message exited in the middle of it and another writer took the lock over, the
+      // record is left in the ring for the next read.
+      if (started) {
+        MS_LOG(WARNING) << "Drop the unfinished message from " << *meta << " in shared memory " << name_;
+        free_message();
+        return false;
+      }
+      started = true;
+      meta->assign(reinterpret_cast<const char *>(src), record->meta_size);
+      src += record->meta_size;
+      *size = static_cast<size_t>(record->total_size);
+      received = 0;
+      message = static_cast<uint8_t *>(allocate_cb(*size));
+      discard = (message == nullptr && *size != 0);
+      if (discard) {
+        MS_LOG(ERROR) << "Failed to allocate " << *size << " bytes for the message from shared memory " << name_;
+      }
+    }
+    if (!discard && record->chunk_size != 0) {
+      (void)memcpy(message + received, src, record->chunk_size);
+    }
+    received += record->chunk_size;
+    bool last = (record->flags & kRecordLast) != 0;
+    size_t record_size = sizeof(ShmRecordHeader) + AlignUp(record->meta_size + record->chunk_size, kRecordAlign);
+    header_->read_pos.store(read_pos + record_size, std::memory_order_release);
+    Notify(&header_->space_seq, &header_->space_waiters);
+    if (last) {
+      return !discard;
+    }
+  }
+}
+
+std::string ShmRing::HostId() {
+  char host_name[HOST_NAME_MAX + 1] = {0};
+  (void)gethostname(host_name, HOST_NAME_MAX);
+  // The boot id tells the containers on different hosts apart even if they have the same host name.
+  std::string boot_id;
+  std::ifstream ifs(kBootIdPath);
+  if (ifs.is_open()) {
+    std::getline(ifs, boot_id);
+  }
+  return std::string(host_name) + "_" + boot_id;
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_RING_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_RING_H_
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// The default byte size of the data region of a shared memory ring.
+constexpr size_t kShmRingDefaultCapacity = 1 << 24;
+// The environment variable to disable the shared memory transport between the processes on the same host.
+constexpr char kDisableShmTransportEnv[] = "MS_RPC_DISABLE_SHM";
+
+// The max byte size of the meta of a message, e.g. the sender of the message.
+constexpr size_t kShmRingMaxMetaSize = 4096;
+
+// A piece of the message to be written, a message may be gathered from several buffers.
+using ShmBuffer = std::pair<const void *, size_t>;
+
+// The header of the ring which is placed at the beginning of the shared memory.
+struct ShmRingHeader;
+
+// ShmRing is a byte ring in POSIX shared memory, which carries messages from the processes on the same host to the
+// owner process. The owner creates the ring and is its only reader, the other processes open it by name and write.
+// Writers are serialized by a lock in the shared memory, a message larger than the ring is split into chunks which
+// are streamed through the ring, so the payload is copied into the ring once by the writer and out of it once by the
+// reader. Both sides spin for a while then sleep on a futex when the ring is empty or full. The lock holds the pid of
+// its owner, so the lock of a writer process which exits in the middle of a message is taken over by the next writer.
+class ShmRing {
+ public:
+  ShmRing() = default;
+  ~ShmRing();
+
+  // Create and map the shared memory with the name, the name should be unique on the host.
+  bool Create(const std::string &name, size_t capacity = kShmRingDefaultCapacity);
+  // Map the shared memory created by another process.
+  bool Open(const std::string &name);
+  // Unmap the shared memory, the creator also removes its name.
+  void Close();
+
+  // Write one message composed by the meta and the buffers, block while the ring is full.
+  // Return false if the ring has been shut down.
+  bool Write(const std::string &meta, const std::vector<ShmBuffer> &buffers);
+
+  // Read one message, the memory of the payload is allocated by allocate_cb with the size of the payload, so the
+  // payload is copied to its destination directly. Block until a message arrives, return false if the ring has been
+  // shut down, the allocation fails or the writer of the message exited before finishing it. The memory allocated for
+  // a message which is not read completely is released by free_cb.
+  bool Read(std::string *meta, const std::function<void *(size_t size)> &allocate_cb, size_t *size,
+            const std::function<void(void *data)> &free_cb = {});
+
+  // Wake up the blocked reader and writers, and make the subsequent reads and writes fail.
+  void Shutdown();
+
+  const std::string &name() const { return name_; }
+  size_t capacity() const;
+
+  // Return the identity of the host, the processes with the same identity share the shared memory.
+  static std::string HostId();
+
+ private:
+  bool Map(int fd, size_t total_size);
+  // Take the writer lock, return false if the ring has been shut down.
+  bool LockWriter();
+  // Wait until the predicate is satisfied or the ring is shut down.
+  template <typename Pred>
+  bool WaitFor(std::atomic<uint32_t> *seq, std::atomic<uint32_t> *waiters, Pred &&ready) const;
+  void Notify(std::atomic<uint32_t> *seq, const std::atomic<uint32_t> *waiters) const;
+
+  std::string name_;
+  bool is_creator_{false};
+  void *addr_{nullptr};
+  size_t mapped_size_{0};
+  ShmRingHeader *header_{nullptr};
+  uint8_t *data_{nullptr};
+
+  DISABLE_COPY_AND_ASSIGN(ShmRing);
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_RING_H_
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/shm/shm_server.h"
+
+#include <memory>
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+ShmServer::~ShmServer() {
+  try {
+    Finalize();
+  } catch (const std::exception &) {
+    MS_LOG(ERROR) << "Failed to finalize the shared memory server.";
+  }
+}
+
+bool ShmServer::Initialize(const std::string &name, const MemAllocateCallback &allocate_cb,
+                           const MemFreeCallback &free_cb, size_t capacity) {
+  if (!ring_.Create(name, capacity)) {
+    MS_LOG(WARNING) << "Failed to create the shared memory ring " << name;
+    return false;
+  }
+  allocate_cb_ = allocate_cb;
+  free_cb_ = free_cb;
+  MS_LOG(INFO) << "The shared memory server " << name << " is initialized, capacity: " << ring_.capacity();
+  return true;
+}
+
+void ShmServer::Finalize() {
+  if (running_.exchange(false)) {
+    ring_.Shutdown();
+    if (recv_thread_.joinable()) {
+      recv_thread_.join();
+    }
+  }
+  ring_.Close();
+}
+
+void ShmServer::SetMessageHandler(const MessageHandler &handler) {
+  message_handler_ = handler;
+  // The thread is started here so that no message is received before the handler is set.
+  if (!running_.exchange(true)) {
+    recv_thread_ = std::thread(&ShmServer::RecvLoop, this);
+  }
+}
+
+void ShmServer::RecvLoop() {
+  while (running_.load()) {
+    auto message = std::make_unique<MessageBase>();
+    std::string from;
+    size_t size = 0;
+    bool success = false;
+    if (allocate_cb_) {
+      success = ring_.Read(
+        &from,
+        [this, &message](size_t size) {
+          message->data = allocate_cb_(size);
+          return message->data;
+        },
+        &size,
+        [this, &message](void *data) {
+          message->data = nullptr;
+          if (free_cb_ && !free_cb_(data)) {
+            MS_LOG(ERROR) << "Failed to free the memory of the dropped message in shared memory " << ring_.name();
+          }
+        });
+      message->size = size;
+    } else {
+      // The payload is copied from the shared memory to the body directly.
+      success = ring_.Read(
+        &from,
+        [&message](size_t size) -> void * {
+          message->body.resize(size);
+          return size == 0 ? nullptr : &message->body[0];
+        },
+        &size);
+    }
+    if (!success) {
+      continue;
+    }
+    message->from = AID(from);
+    if (message_handler_) {
+      (void)message_handler_(message.release());
+    }
+  }
+  MS_LOG(INFO) << "The receiving thread of shared memory server " << ring_.name() << " exits.";
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
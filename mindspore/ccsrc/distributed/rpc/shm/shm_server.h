@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_SERVER_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_SERVER_H_
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "distributed/rpc/shm/shm_ring.h"
+#include "distributed/rpc/tcp/constants.h"
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// ShmServer receives the messages sent by the ShmClients of the processes on the same host through a shared memory
+// ring. It has the same message handler as TCPServer, but the reply returned by the handler is not sent back.
+class BACKEND_EXPORT ShmServer {
+ public:
+  ShmServer() = default;
+  ~ShmServer();
+
+  // Create the shared memory ring with the name. If allocate_cb is set, the received payload is copied to the memory
+  // allocated by it and set to the data of the message, otherwise the payload is set to the body of the message. The
+  // memory allocated for a message which is dropped is released by free_cb.
+  bool Initialize(const std::string &name, const MemAllocateCallback &allocate_cb = {},
+                  const MemFreeCallback &free_cb = {}, size_t capacity = kShmRingDefaultCapacity);
+
+  // Stop receiving and destroy the shared memory ring.
+  void Finalize();
+
+  // Set the message processing handler and start receiving, the handler takes the ownership of the message.
+  void SetMessageHandler(const MessageHandler &handler);
+
+  // Return the name of the shared memory which the clients connect to.
+  const std::string &GetName() const { return ring_.name(); }
+
+ private:
+  void RecvLoop();
+
+  ShmRing ring_;
+  MemAllocateCallback allocate_cb_;
+  MemFreeCallback free_cb_;
+  MessageHandler message_handler_;
+
+  std::thread recv_thread_;
+  std::atomic<bool> running_{false};
+
+  DISABLE_COPY_AND_ASSIGN(ShmServer);
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_RPC_SHM_SHM_SERVER_H_
@@ -260,6 +260,15 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // setter function
+  // @param profile_dir - Directory of the AutoTune profiles, a pipeline run again on the same kind of host starts
+  //     from the configuration AutoTune saved there. Empty string to disable
+  void set_autotune_profile_dir(const std::string &profile_dir) { autotune_profile_dir_ = profile_dir; }
+
+  // getter function
+  // @return - Directory of the AutoTune profiles
+  std::string autotune_profile_dir() const { return autotune_profile_dir_; }
+
   // setter function
   // @param enable - To enable watchdog python thread
   void set_enable_watchdog(bool enable) { enable_watchdog_ = enable; }
@@ -319,6 +328,26 @@ class ConfigManager {
   // @notes This method is used for internal processing, using enum type
   ErrorSamplesMode error_samples_mode() const { return error_samples_mode_; }
 
+  // setter function
+  // @notes Rows of a map that only feeds shuffle or batch are no longer deterministic across runs
+  //     (System default = false)
+  // @param enable - Set whether map may output rows in any order when no downstream op relies on the order
+  void set_enable_unordered_connector(const bool enable) { enable_unordered_connector_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether map may output rows in any order when no downstream op relies on the order
+  bool enable_unordered_connector() const { return enable_unordered_connector_; }
+
+  // setter function
+  // @notes The decoded images are smaller before they are resized, so the results differ from the full decoding
+  //     (System default = false)
+  // @param enable - Set whether jpeg images may be decoded at a reduced DCT scale when they are resized down later
+  void set_enable_jpeg_dct_scaling(const bool enable) { enable_jpeg_dct_scaling_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether jpeg images may be decoded at a reduced DCT scale
+  bool enable_jpeg_dct_scaling() const { return enable_jpeg_dct_scaling_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -352,10 +381,13 @@ class ConfigManager {
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
+  std::string autotune_profile_dir_;           // Directory of the AutoTune profiles reused across runs
   bool dynamic_shape_{false};
   bool fast_recovery_{true};     // Used for failover scenario to recover quickly or produce same augmentations
   bool debug_mode_flag_{false};  // Indicator for debug mode
   ErrorSamplesMode error_samples_mode_{ErrorSamplesMode::kReturn};  // The method to process erroneous samples
+  bool enable_unordered_connector_{false};  // Whether map may output rows in any order if the order is not needed
+  bool enable_jpeg_dct_scaling_{false};     // Whether jpeg images may be decoded at a reduced DCT scale
 };
 }  // namespace dataset
 }  // namespace mindspore
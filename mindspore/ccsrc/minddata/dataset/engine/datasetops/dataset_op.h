@@ -281,6 +281,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  // \brief Getter function
+  // \return number of bytes read from the data files by this op, -1 if this op does not report its reads
+  virtual int64_t ReadBytes() const { return -1; }
+
   // \brief Getter function
   // \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
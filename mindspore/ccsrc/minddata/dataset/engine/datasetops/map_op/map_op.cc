@@ -168,15 +168,15 @@ Status MapOp::operator()() {
     }
 
     // Propagate the eoe row to worker
-    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(SendFlagToWorkers(
+      []() { return std::make_unique<MapWorkerJob>(TensorRow(TensorRow::kFlagEOE)); }, false));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
-  std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(
+    SendFlagToWorkers([]() { return std::make_unique<MapWorkerJob>(TensorRow(TensorRow::kFlagEOF)); }, true));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
@@ -212,14 +212,14 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       if (in_row.quit()) {
         break;
       }
-      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(in_row)));
+      RETURN_IF_NOT_OK(SendToCollector(worker_id, std::move(in_row)));
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "[Internal ERROR] MapOp got an empty TensorRow.");
       TensorRow out_row;
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
       // Push the row onto the connector for next operator to consume.
-      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
+      RETURN_IF_NOT_OK(SendToCollector(worker_id, std::move(out_row)));
     }
     // Fetch next data row and map job list
     RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
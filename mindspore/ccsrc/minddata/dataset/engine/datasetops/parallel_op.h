@@ -26,6 +26,7 @@
 #include "minddata/dataset/include/dataset/constants.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/engine/unordered_connector.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
 #include "minddata/dataset/util/status.h"
 
@@ -82,6 +83,17 @@ class ParallelOp : public DatasetOp {
 
   int32_t NumWorkers() const override { return num_workers_; }
 
+  /// Setter of the output ordering of the workers. When the order does not need to be preserved, the workers
+  /// push their results into a single lock-free UnorderedConnector and the collector takes whichever row is ready.
+  /// \note Only takes effect if it is called before the op is launched, and the derived op has to broadcast the
+  ///     eoe/eof to all workers (see SendFlagToWorkers).
+  /// \param preserve_order - whether rows leave the op in the order they entered it
+  void SetPreserveOrder(bool preserve_order) { preserve_order_ = preserve_order; }
+
+  /// Getter of the output ordering of the workers
+  /// \return Whether rows leave the op in the order they entered it
+  bool PreserveOrder() const { return preserve_order_; }
+
   Status WaitForWorkers() override {
     // reset num_paused workers to 0
     num_workers_paused_ = 0;
@@ -151,6 +163,9 @@ class ParallelOp : public DatasetOp {
     RETURN_UNEXPECTED_IF_NULL(tree_);
     worker_in_queues_.Init(num_workers_, worker_connector_size_);
     worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    if (!preserve_order_) {
+      unordered_out_queue_ = std::make_unique<UnorderedConnector<S>>(num_workers_ * worker_connector_size_);
+    }
 
     // Registers QueueList and individual Queues for interrupt services
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
@@ -316,7 +331,11 @@ class ParallelOp : public DatasetOp {
     ep_step_ = 0, total_step_ = 0;
     do {
       TensorRow row;
-      RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % num_workers_)]->PopFront(&row));
+      if (preserve_order_) {
+        RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % num_workers_)]->PopFront(&row));
+      } else {
+        RETURN_IF_NOT_OK(unordered_out_queue_->PopFront(&row));
+      }
       if (row.wait()) {
         // When collector receives the signal from worker thread, it increments an atomic int
         // If num_worker signals are received, wakes up the main thread
@@ -325,7 +344,11 @@ class ParallelOp : public DatasetOp {
           num_rows = 0;
         }
         continue;
+      } else if (!preserve_order_ && (row.eoe() || row.eof()) && ++num_flags_received_ < num_workers_) {
+        // every worker forwards its own copy of eoe/eof, only the last one means all the rows before it are out
+        continue;
       } else if (row.eoe()) {
+        num_flags_received_ = 0;
         RETURN_IF_NOT_OK(strategy_->HandleEOE(&row));
       } else if (row.eof()) {
         RETURN_IF_NOT_OK(strategy_->HandleEOF(&row));
@@ -361,6 +384,34 @@ class ParallelOp : public DatasetOp {
     return next_worker;
   }
 
+  /// Push the result of a worker to the collector
+  /// \param worker_id - id of the worker that produced the row
+  /// \param row - the row to be pushed
+  /// \return Status The status code returned
+  Status SendToCollector(int32_t worker_id, S &&row) {
+    if (preserve_order_) {
+      return worker_out_queues_[worker_id]->EmplaceBack(std::move(row));
+    }
+    return unordered_out_queue_->Add(std::move(row));
+  }
+
+  /// Send a control row (eoe/eof) to the workers. In ordered mode the next worker in the round robin gets it. In
+  /// unordered mode every worker gets a copy, and for eoe the main thread waits for the collector to drain all of
+  /// them so that rows of the next epoch can not overtake the flag.
+  /// \param make_job - creates a new job carrying the flag
+  /// \param is_eof - whether the flag is eof, nothing is sent after eof so there is no need to wait
+  /// \return Status The status code returned
+  template <typename F>
+  Status SendFlagToWorkers(F &&make_job, bool is_eof) {
+    if (preserve_order_) {
+      return worker_in_queues_[NextWorkerID()]->Add(make_job());
+    }
+    for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
+      RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(make_job()));
+    }
+    return is_eof ? Status::OK() : WaitForWorkers();
+  }
+
  public:
   int32_t NumWorkers() override { return num_workers_; }
 
@@ -390,6 +441,10 @@ class ParallelOp : public DatasetOp {
   QueueList<T> worker_in_queues_;
   /// queues to hold the output from workers
   QueueList<S> worker_out_queues_;
+  /// whether rows leave the op in the order they entered it
+  bool preserve_order_{true};
+  /// single output queue shared by all workers when the order does not need to be preserved
+  std::unique_ptr<UnorderedConnector<S>> unordered_out_queue_;
 
  private:
   std::unique_ptr<RowHandlingStrategy> strategy_;
@@ -397,6 +452,7 @@ class ParallelOp : public DatasetOp {
   int32_t total_step_{0};
   int32_t current_epochs_{0};
   int32_t current_repeats_{0};
+  int32_t num_flags_received_{0};
 };
 }  // namespace dataset
 }  // namespace mindspore
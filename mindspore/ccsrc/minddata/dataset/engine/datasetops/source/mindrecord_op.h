@@ -117,6 +117,10 @@ class MindRecordOp : public MappableLeafOp {
   /// @return Name of the current Op
   std::string Name() const override { return "MindRecordOp"; }
 
+  /// Getter method of the bytes read from the mindrecord files
+  /// @return Number of bytes read by the io engine of the shard reader
+  int64_t ReadBytes() const override { return static_cast<int64_t>(shard_reader_->GetIoStatistics().read_bytes); }
+
  private:
   Status GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
 
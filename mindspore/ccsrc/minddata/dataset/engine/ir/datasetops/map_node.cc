@@ -52,6 +52,7 @@ std::shared_ptr<DatasetNode> MapNode::Copy() {
                                         offload_, python_mp_);
   (void)node->SetNumWorkers(num_workers_);
   (void)node->SetConnectorQueueSize(connector_que_size_);
+  node->SetPreserveOrder(preserve_order_);
   return node;
 }
 
@@ -91,6 +92,7 @@ Status MapNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
 
   map_op->SetTotalRepeats(GetTotalRepeats());
   map_op->SetNumRepeatsPerEpoch(GetNumRepeatsPerEpoch());
+  map_op->SetPreserveOrder(preserve_order_);
   if (python_mp_ != nullptr) {
     map_op->SetPythonMp(python_mp_);
   }
@@ -94,6 +94,12 @@ class MapNode : public DatasetNode {
   /// \brief setter to set offload flag of node
   void SetOffload(ManualOffloadMode offload);
 
+  /// \brief Getter of whether the output rows keep the input order
+  bool PreserveOrder() const { return preserve_order_; }
+
+  /// \brief Setter of whether the output rows keep the input order
+  void SetPreserveOrder(bool preserve_order) { preserve_order_ = preserve_order; }
+
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
   /// \return Status of the function
@@ -127,6 +133,9 @@ class MapNode : public DatasetNode {
   /// \brief ManualOffloadMode to indicate manual_offload status
   ManualOffloadMode offload_;
 
+  /// \brief Whether the output rows keep the input order, turned off by UnorderedConnectorPass
+  bool preserve_order_{true};
+
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;
 };
 }  // namespace dataset
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/optional/batch_pushdown_pass.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/batched_image_op.h"
+#include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+#include "minddata/dataset/kernels/ir/vision/vertical_flip_ir.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// the tensor ops giving the same result on a batch as on every image of it, with a batched kernel
+bool IsBatchableMap(const std::shared_ptr<MapNode> &map) {
+  static const std::set<std::string> kBatchableOperations = {
+    vision::kNormalizeOperation, vision::kRescaleOperation, vision::kHorizontalFlipOperation,
+    vision::kVerticalFlipOperation, vision::kHwcToChwOperation};
+  if (map->IsCached() || !map->Callbacks().empty() || map->GetOffload() == ManualOffloadMode::kEnabled ||
+      map->TensorOperations().empty()) {
+    return false;
+  }
+  // a map renaming or splitting its columns changes the columns the batch works on
+  if (!map->OutputColumns().empty() && map->OutputColumns() != map->InputColumns()) {
+    return false;
+  }
+  for (const auto &op : map->TensorOperations()) {
+    if (op == nullptr || kBatchableOperations.find(op->Name()) == kBatchableOperations.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Run the ops of the map on batches. Their per image kernels would take a batch of <H, W> images for one image.
+Status SetBatchedOperations(const std::shared_ptr<MapNode> &map) {
+  std::vector<std::shared_ptr<TensorOperation>> ops;
+  for (const auto &op : map->TensorOperations()) {
+    auto image_op = op->Build();
+    RETURN_UNEXPECTED_IF_NULL(image_op);
+    (void)ops.emplace_back(std::make_shared<transforms::PreBuiltOperation>(std::make_shared<BatchedImageOp>(image_op)));
+  }
+  map->setOperations(ops);
+  return Status::OK();
+}
+}  // namespace
+
+Status BatchPushdownPass::BatchMapNodes::Visit(std::shared_ptr<BatchNode> node, bool *const modified) {
+#ifdef ENABLE_PYTHON
+  // per_batch_map and padding work on the rows of the batch, which must not be changed by the map below
+  if (node->BatchSizeFunc() || node->BatchMapFunc() || node->Pad() || !node->PadMap().empty() ||
+      !node->InColNames().empty() || !node->OutColNames().empty()) {
+    return Status::OK();
+  }
+#endif
+  if (node->Children().size() != 1) {
+    return Status::OK();
+  }
+  auto map = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+  if (map != nullptr && IsBatchableMap(map)) {
+    (void)batch_map_nodes_.emplace_back(node, map);
+  }
+  return Status::OK();
+}
+
+// Walk the tree to move the map nodes of batched image ops above their batch nodes.
+Status BatchPushdownPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(root_ir);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  MS_LOG(INFO) << "Optional pass: batch pushdown pass started.";
+  auto batch_map_nodes = std::make_unique<BatchPushdownPass::BatchMapNodes>();
+  RETURN_IF_NOT_OK(batch_map_nodes->Run(root_ir, modified));
+
+  for (auto &iter : batch_map_nodes->batch_map_nodes()) {
+    MS_LOG(INFO) << "Moving the map node below batch node (batch_size: " << iter.first->BatchSize()
+                 << ") above it, to run its tensor ops on batches.";
+    RETURN_IF_NOT_OK(SetBatchedOperations(iter.second));
+    RETURN_IF_NOT_OK(iter.second->Drop());
+    RETURN_IF_NOT_OK(iter.first->InsertAbove(iter.second));
+    *modified = true;
+  }
+
+  MS_LOG(INFO) << "Optional pass: batch pushdown pass is complete.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
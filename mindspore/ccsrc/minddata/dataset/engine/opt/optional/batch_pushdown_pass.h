@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_PUSHDOWN_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_PUSHDOWN_PASS_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+class BatchNode;
+class MapNode;
+
+/// \class BatchPushdownPass batch_pushdown_pass.h
+/// \brief An optional optimization pass that swaps a BatchNode with the MapNode right below it, when all the tensor
+///     ops of the map are deterministic per-pixel or layout ops with a batched kernel (Normalize, Rescale,
+///     HorizontalFlip, VerticalFlip and HWC2CHW). The ops then run once on every batch instead of once on every image.
+///     The moved ops are wrapped into BatchedImageOp, which takes the first dimension of the input for the batch size,
+///     so a batch of <H, W> images is not taken for one <H, W, C> image.
+class BatchPushdownPass : public IRTreePass {
+  /// \class BatchMapNodes
+  /// \brief This is a NodePass whose job is to collect the batch nodes and the map nodes below them to swap.
+  ///     It works in conjunction with the BatchPushdownPass.
+  class BatchMapNodes : public IRNodePass {
+   public:
+    /// \brief Constructor
+    BatchMapNodes() = default;
+
+    /// \brief Destructor
+    ~BatchMapNodes() = default;
+
+    /// \brief Check whether the BatchNode and its child MapNode can be swapped
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<BatchNode> node, bool *const modified) override;
+
+    /// \brief Getter
+    /// \return All the batch nodes and the map nodes to move above them
+    const std::vector<std::pair<std::shared_ptr<BatchNode>, std::shared_ptr<MapNode>>> &batch_map_nodes() const {
+      return batch_map_nodes_;
+    }
+
+   private:
+    std::vector<std::pair<std::shared_ptr<BatchNode>, std::shared_ptr<MapNode>>> batch_map_nodes_;
+  };
+
+ public:
+  /// \brief Constructor
+  BatchPushdownPass() = default;
+
+  /// \brief Destructor
+  ~BatchPushdownPass() = default;
+
+  /// \brief Runs a batch_pushdown pass to move the eligible map nodes above their batch nodes.
+  /// \param[in, out] root_ir The tree to operate on.
+  /// \param[in, out] modified Indicate of the tree was modified.
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_PUSHDOWN_PASS_H_
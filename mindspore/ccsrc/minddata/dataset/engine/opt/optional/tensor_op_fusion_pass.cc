@@ -16,19 +16,68 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/center_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_crop_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+using OpIter = std::vector<std::shared_ptr<TensorOperation>>::iterator;
+
+OpIter SearchPattern(std::vector<std::shared_ptr<TensorOperation>> *ops, const std::vector<std::string> &pattern) {
+  return std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
+                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+}
+
+// Decode, Resize and an optional CenterCrop, as in the evaluation pipelines of ImageNet
+Status FuseDecodeResizeCrop(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  constexpr size_t kDecodeResizeOpNum = 2;
+  const std::vector<std::vector<std::string>> patterns = {
+    {vision::kDecodeOperation, vision::kResizeOperation, vision::kCenterCropOperation},
+    {vision::kDecodeOperation, vision::kResizeOperation}};
+  for (auto &pattern : patterns) {
+    auto itr = SearchPattern(ops, pattern);
+    if (itr == ops->end()) {
+      continue;
+    }
+    // the op params are private to the IR, read them through the serialized form
+    nlohmann::json decode_args;
+    nlohmann::json resize_args;
+    RETURN_IF_NOT_OK((*itr)->to_json(&decode_args));
+    RETURN_IF_NOT_OK((*(itr + 1))->to_json(&resize_args));
+    // the fused op decodes into RGB only
+    if (!decode_args["rgb"].get<bool>()) {
+      return Status::OK();
+    }
+    std::vector<int32_t> crop_size;
+    if (pattern.size() > kDecodeResizeOpNum) {
+      nlohmann::json crop_args;
+      RETURN_IF_NOT_OK((*(itr + 2))->to_json(&crop_args));
+      crop_size = crop_args["size"].get<std::vector<int32_t>>();
+    }
+    std::vector<int32_t> size = resize_args["size"];
+    InterpolationMode interpolation = static_cast<InterpolationMode>(resize_args["interpolation"]);
+    (*itr) = std::make_shared<vision::DecodeCropResizeOperation>(size, crop_size, interpolation);
+    (void)ops->erase(itr + 1, itr + static_cast<int64_t>(pattern.size()));
+    *modified = true;
+    return Status::OK();
+  }
+  return Status::OK();
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   RETURN_UNEXPECTED_IF_NULL(node);
@@ -52,11 +101,18 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
 
   // logic below is for non-prebuilt TensorOperation
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
-  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
-                    [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  itr = SearchPattern(&ops, pattern);
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
+  // try the deterministic chains if the random crop pattern is not found, the fused op of them decodes at a reduced
+  // DCT scale and resizes once, so its output differs from the unfused ops
+  if (itr == ops.end()) {
+    RETURN_OK_IF_TRUE(!GlobalContext::config_manager()->enable_jpeg_dct_scaling());
+    RETURN_IF_NOT_OK(FuseDecodeResizeCrop(&ops, modified));
+    if (*modified) {
+      node->setOperations(ops);
+    }
+    return Status::OK();
+  }
   auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
   RETURN_UNEXPECTED_IF_NULL(fused_ir);
   // fuse the two ops
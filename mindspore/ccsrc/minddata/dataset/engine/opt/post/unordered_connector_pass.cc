@@ -0,0 +1,95 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/post/unordered_connector_pass.h"
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/concat_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/rename_node.h"
+#include "minddata/dataset/engine/ir/datasetops/shuffle_node.h"
+#include "minddata/dataset/engine/ir/datasetops/zip_node.h"
+
+namespace mindspore {
+namespace dataset {
+Status UnorderedConnectorPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  bool unordered = ParentUnordered();
+  if (unordered && node->PreserveOrder()) {
+    MS_LOG(INFO) << "Output order of " << node->Name() << " is not consumed, switch to the unordered connector.";
+    node->SetPreserveOrder(false);
+    *modified = true;
+  }
+  unordered_stack_.push_back(unordered);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<BatchNode> node, bool *const modified) {
+  unordered_stack_.push_back(order_keeping_ancestors_ == 0);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) {
+  unordered_stack_.push_back(order_keeping_ancestors_ == 0);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
+  unordered_stack_.push_back(ParentUnordered());
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<RenameNode> node, bool *const modified) {
+  unordered_stack_.push_back(ParentUnordered());
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<ZipNode> node, bool *const modified) {
+  order_keeping_ancestors_++;
+  unordered_stack_.push_back(false);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::VisitAfter(std::shared_ptr<ZipNode> node, bool *const modified) {
+  order_keeping_ancestors_--;
+  return VisitAfter(std::static_pointer_cast<DatasetNode>(node), modified);
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<ConcatNode> node, bool *const modified) {
+  order_keeping_ancestors_++;
+  unordered_stack_.push_back(false);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::VisitAfter(std::shared_ptr<ConcatNode> node, bool *const modified) {
+  order_keeping_ancestors_--;
+  return VisitAfter(std::static_pointer_cast<DatasetNode>(node), modified);
+}
+
+Status UnorderedConnectorPass::Visit(std::shared_ptr<DatasetNode> node, bool *const modified) {
+  unordered_stack_.push_back(false);
+  return Status::OK();
+}
+
+Status UnorderedConnectorPass::VisitAfter(std::shared_ptr<DatasetNode> node, bool *const modified) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!unordered_stack_.empty(), "[Internal ERROR] Unbalanced visit of " + node->Name());
+  unordered_stack_.pop_back();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
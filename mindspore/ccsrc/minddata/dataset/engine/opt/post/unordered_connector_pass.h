@@ -0,0 +1,121 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASET_ENGINE_OPT_POST_UNORDERED_CONNECTOR_PASS_H_
+#define DATASET_ENGINE_OPT_POST_UNORDERED_CONNECTOR_PASS_H_
+
+#include <memory>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+/// \class UnorderedConnectorPass
+/// \brief This is a post pass that lets MapNode output rows in any order when the order is consumed by nothing,
+///     i.e. the rows only go through order insensitive nodes (Map, Project, Rename) before reaching a Shuffle or
+///     a Batch. Such a Map collects the rows of its workers through a lock-free UnorderedConnector, so a slow row
+///     no longer holds the rows of the other workers back.
+///     A Zip pairs the rows of its children by position and a Concat keeps the rows of each child together, so the
+///     Shuffles and Batches below them still pass the order on.
+/// \note The rows (and so the batches) are no longer reproducible across runs, which is why the pass only runs
+///     when enable_unordered_connector is set in the config.
+class UnorderedConnectorPass : public IRNodePass {
+ public:
+  /// \brief Constructor
+  UnorderedConnectorPass() = default;
+
+  /// \brief Destructor
+  ~UnorderedConnectorPass() override = default;
+
+  /// \brief Marks the MapNode as unordered if no ancestor cares about the order
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Order does not matter below a BatchNode, unless it is below a ZipNode or a ConcatNode
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<BatchNode> node, bool *const modified) override;
+
+  /// \brief Order does not matter below a ShuffleNode, unless it is below a ZipNode or a ConcatNode
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) override;
+
+  /// \brief ProjectNode keeps the state of its parent
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<ProjectNode> node, bool *const modified) override;
+
+  /// \brief RenameNode keeps the state of its parent
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<RenameNode> node, bool *const modified) override;
+
+  /// \brief ZipNode pairs the rows of its children by position, the order matters below it
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<ZipNode> node, bool *const modified) override;
+
+  /// \brief Leaves the subtree of a ZipNode
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status VisitAfter(std::shared_ptr<ZipNode> node, bool *const modified) override;
+
+  /// \brief ConcatNode keeps the rows of each child together, the order matters below it
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<ConcatNode> node, bool *const modified) override;
+
+  /// \brief Leaves the subtree of a ConcatNode
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status VisitAfter(std::shared_ptr<ConcatNode> node, bool *const modified) override;
+
+  /// \brief Any other node may depend on the order of its input
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status Visit(std::shared_ptr<DatasetNode> node, bool *const modified) override;
+
+  /// \brief Restores the state of the parent when leaving a node
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status code
+  Status VisitAfter(std::shared_ptr<DatasetNode> node, bool *const modified) override;
+
+ private:
+  /// \brief Whether the order of the rows produced by the node being visited is consumed by nothing
+  bool ParentUnordered() const { return !unordered_stack_.empty() && unordered_stack_.back(); }
+
+  // one entry per node on the path from the root, tells whether the input order of that node matters
+  std::vector<bool> unordered_stack_;
+  // the number of ZipNodes and ConcatNodes on the path from the root
+  size_t order_keeping_ancestors_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_OPT_POST_UNORDERED_CONNECTOR_PASS_H_
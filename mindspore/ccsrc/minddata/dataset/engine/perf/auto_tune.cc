@@ -17,6 +17,7 @@
 #include "minddata/dataset/engine/perf/auto_tune.h"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -26,6 +27,7 @@
 #include <iomanip>
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
+#include "minddata/dataset/engine/perf/autotune_profile.h"
 #include "minddata/dataset/engine/serdes.h"
 #endif
 #include "minddata/dataset/util/task_manager.h"
@@ -83,6 +85,10 @@ Status AutoTune::Main() {
       (SaveAutotuneConfig(autotune_json_filepath_ + "_" + profiling_manager_->GetRankID() + ".json").IsError())) {
     MS_LOG(WARNING) << "Failed to write the final autotune configuration to disk";
   }
+  auto profile_dir = GlobalContext::config_manager()->autotune_profile_dir();
+  if (!profile_dir.empty() && !nodes_offloaded && SaveAutotuneProfile(profile_dir).IsError()) {
+    MS_LOG(WARNING) << "Failed to write the autotune profile to disk";
+  }
 #endif
   return Status::OK();
 }
@@ -185,6 +191,13 @@ Status AutoTune::SetAutotuneConfigJson() {
   }
   return Status::OK();
 }
+
+Status AutoTune::SaveAutotuneProfile(const std::string &profile_dir) {
+  RETURN_IF_NOT_OK(SetAutotuneConfigJson());
+  nlohmann::json tuned_json = autotune_config_json_;
+  RETURN_IF_NOT_OK(Serdes::UpdateOptimizedIRTreeJSON(&tuned_json, ops_));
+  return AutoTuneProfile::Save(profile_dir, tuned_json);
+}
 #endif
 
 Status AutoTune::SummarizeTreeConfiguration(std::vector<std::string> *out) {
@@ -537,6 +550,7 @@ Status AutoTune::IsDSaBottleneck(bool *isBottleneck) {
   MS_LOG(INFO) << "Device Connector Size: " << avg_size << ", Connector Capacity: " << avg_capacity
                << ", Utilization: " << (usage_avg_last * TO_PERCENT) << "%"
                << ", Empty Freq: " << (empty_freq * TO_PERCENT) << "% ";
+  device_connector_util_ = usage_avg_last;
   // Decision
   if (usage_avg_last < DEVICE_CONNECTOR_UTIL_THRESHOLD) {
     MS_LOG(INFO) << "Utilization: " << (usage_avg_last * TO_PERCENT) << "% < "
@@ -552,6 +566,19 @@ Status AutoTune::IsDSaBottleneck(bool *isBottleneck) {
   return Status::OK();
 }
 
+int32_t AutoTune::EstimateNumWorkers(int32_t num_workers, double worker_util) const {
+  if (worker_util <= 0) {
+    // no cpu statistics of the op
+    return num_workers + INCREMENT_WORKER;
+  }
+  // the throughput gain filling the device queue up to the threshold, bounded against noisy statistics
+  double gain = DEVICE_CONNECTOR_UTIL_THRESHOLD / std::max(device_connector_util_, MIN_DEVICE_CONNECTOR_UTIL);
+  gain = std::min(std::max(gain, 1.0), MAX_THROUGHPUT_GAIN);
+  // U * c = X * S stays the same per row, so c' = c * U * gain / U'
+  auto estimated = static_cast<int32_t>(std::ceil(num_workers * worker_util * gain / MAP_OP_WORKER_HIGH_THRESHOLD));
+  return std::max(estimated, num_workers + 1);
+}
+
 Status AutoTune::RequestNumWorkerChange(int32_t op_id, int32_t old_workers, int32_t *num_workers_requested) {
   AT_change_ = true;
   int new_workers = std::min(*num_workers_requested, max_workers_);
@@ -637,12 +664,14 @@ Status AutoTune::AnalyseTime() {
                    << ") is slow, input connector utilization=" << input_queue_util
                    << ", output connector utilization=" << output_queue_util << ", diff= " << queue_diff << " > "
                    << INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD << " threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
+      // the cpu time underestimates the service time of ops waiting for io, keep at least the fixed step
+      requested_workers = std::max(EstimateNumWorkers(num_workers, cpu_util / num_workers),
+                                   num_workers + INCREMENT_WORKER);
       RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
     } else if ((cpu_util / num_workers) > MAP_OP_WORKER_HIGH_THRESHOLD) {
       MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") getting high average worker cpu utilization "
                    << (cpu_util / num_workers) << "% > " << MAP_OP_WORKER_HIGH_THRESHOLD << "% threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
+      requested_workers = EstimateNumWorkers(num_workers, cpu_util / num_workers);
       RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
     }
     if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD &&
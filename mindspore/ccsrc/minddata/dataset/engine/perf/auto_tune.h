@@ -74,6 +74,11 @@ class AutoTune {
   /// Setter for autotune_config_json_
   /// \return Status code
   Status SetAutotuneConfigJson();
+
+  /// \brief Save the tuned workers and queue sizes to the AutoTune profile of the pipeline for the next run
+  /// \param profile_dir Directory of the AutoTune profiles
+  /// \return Status object
+  Status SaveAutotuneProfile(const std::string &profile_dir);
 #endif
 
   /// Function to collect info from the tree
@@ -137,6 +142,9 @@ class AutoTune {
 
   // Value to maintain checking for device_queue utlization at.
   const float_t DEVICE_CONNECTOR_UTIL_THRESHOLD = 0.75;
+  // Bounds of the device_queue utilization and the throughput gain used to estimate the number of workers
+  const double MIN_DEVICE_CONNECTOR_UTIL = 0.1;
+  const double MAX_THROUGHPUT_GAIN = 2.0;
 
   const float_t LEAF_QUEUE_THRESHOLD = 0.9;
   const float_t INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD = 0.35;
@@ -192,6 +200,14 @@ class AutoTune {
   /// \return Status code
   Status AnalyseMemory();
 
+  /// Estimate the number of workers of a slow parallel op with the utilization law U = X * S / c, for a throughput
+  /// X, a service time S per row and c workers, so that the op serves the throughput the device queue needs
+  /// with its workers kept at MAP_OP_WORKER_HIGH_THRESHOLD utilization
+  /// \param num_workers current number of workers
+  /// \param worker_util average cpu utilization percentage of a worker
+  /// \return the estimated number of workers, at least one more than the current
+  int32_t EstimateNumWorkers(int32_t num_workers, double worker_util) const;
+
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
   /// \param old_workers Old number of workers for logging purposes
@@ -260,6 +276,8 @@ class AutoTune {
   int32_t leaf_op_id_;
   /// vector of pipeline time per epoch
   std::vector<double> avg_pipeline_times_;
+  /// device_queue utilization of the last iteration
+  double device_connector_util_{0.0};
 
   /// the current epoch and step indices (starts from 1)
   int32_t cur_epoch_running_;
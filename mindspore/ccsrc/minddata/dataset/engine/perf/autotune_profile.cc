@@ -0,0 +1,200 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/autotune_profile.h"
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/serdes.h"
+#include "minddata/dataset/util/path.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr char kNumWorkersKey[] = "num_parallel_workers";
+constexpr char kQueueSizeKey[] = "connector_queue_size";
+constexpr char kNodesKey[] = "nodes";
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+// FNV-1a, stable across processes and builds unlike std::hash
+uint64_t HashString(const std::string &str) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (auto c : str) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+// remove the fields AutoTune changes, they must not change the fingerprint
+void EraseTunedFields(nlohmann::json *tree_json) {
+  (void)tree_json->erase(kNumWorkersKey);
+  (void)tree_json->erase(kQueueSizeKey);
+  if (tree_json->contains("children")) {
+    for (auto &child : (*tree_json)["children"]) {
+      EraseTunedFields(&child);
+    }
+  }
+}
+
+// the serialized nodes in DFS order, the order DatasetNode::Children is visited in
+void FlattenJson(const nlohmann::json &tree_json, std::vector<nlohmann::json> *nodes) {
+  nlohmann::json node;
+  node["op_type"] = tree_json["op_type"];
+  if (tree_json.contains(kNumWorkersKey) && tree_json.contains(kQueueSizeKey)) {
+    node[kNumWorkersKey] = tree_json[kNumWorkersKey];
+    node[kQueueSizeKey] = tree_json[kQueueSizeKey];
+  }
+  nodes->push_back(node);
+  if (tree_json.contains("children")) {
+    for (auto &child : tree_json["children"]) {
+      FlattenJson(child, nodes);
+    }
+  }
+}
+
+void FlattenTree(const std::shared_ptr<DatasetNode> &node, std::vector<std::shared_ptr<DatasetNode>> *nodes) {
+  nodes->push_back(node);
+  if (!node->IsLeaf()) {
+    for (auto &child : node->Children()) {
+      FlattenTree(child, nodes);
+    }
+  }
+}
+
+// skip the nodes AutoTune does not serialize on top of the tree
+std::shared_ptr<DatasetNode> GetTreeTop(std::shared_ptr<DatasetNode> node) {
+  while ((node->Name() == kRootNode || node->Name() == kEpochCtrlNode || node->Name() == kTransferNode) &&
+         node->Children().size() == 1) {
+    node = node->Children()[0];
+  }
+  return node;
+}
+}  // namespace
+
+Status AutoTuneProfile::GetFingerprint(const nlohmann::json &tree_json, std::string *fingerprint) {
+  RETURN_UNEXPECTED_IF_NULL(fingerprint);
+  nlohmann::json untuned_json = tree_json;
+  EraseTunedFields(&untuned_json);
+  std::stringstream ss;
+  ss << std::hex << std::setw(sizeof(uint64_t) * 2) << std::setfill('0') << HashString(untuned_json.dump()) << "_c"
+     << std::dec << GlobalContext::config_manager()->num_cpu_threads();
+  *fingerprint = ss.str();
+  return Status::OK();
+}
+
+std::string AutoTuneProfile::GetProfilePath(const std::string &profile_dir, const std::string &fingerprint) {
+  return (Path(profile_dir) / ("autotune_" + fingerprint + ".json")).ToString();
+}
+
+Status AutoTuneProfile::SerializeTree(const std::shared_ptr<DatasetNode> &root_ir, nlohmann::json *tree_json) {
+  RETURN_UNEXPECTED_IF_NULL(root_ir);
+  RETURN_UNEXPECTED_IF_NULL(tree_json);
+  return Serdes::SaveToJSON(GetTreeTop(root_ir), "", tree_json);
+}
+
+Status AutoTuneProfile::Save(const std::string &profile_dir, const nlohmann::json &tree_json) {
+  Path dir(profile_dir);
+  if (!dir.Exists()) {
+    RETURN_IF_NOT_OK(dir.CreateDirectories());
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(dir.IsDirectory(), "AutoTune profile dir is not a directory: " + profile_dir);
+  std::string fingerprint;
+  RETURN_IF_NOT_OK(GetFingerprint(tree_json, &fingerprint));
+  std::vector<nlohmann::json> nodes;
+  FlattenJson(tree_json, &nodes);
+  nlohmann::json profile_json;
+  profile_json["fingerprint"] = fingerprint;
+  profile_json[kNodesKey] = nodes;
+
+  // every rank of a distributed job may save the same profile, the last rename wins
+  auto profile_path = GetProfilePath(profile_dir, fingerprint);
+  auto tmp_path = profile_path + "." + std::to_string(getpid()) + ".tmp";
+  RETURN_IF_NOT_OK(Serdes::SaveJSONToFile(profile_json, tmp_path, true));
+  if (std::rename(tmp_path.c_str(), profile_path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to save AutoTune profile: " + profile_path);
+  }
+  MS_LOG(INFO) << "Saved AutoTune profile: " << profile_path;
+  return Status::OK();
+}
+
+Status AutoTuneProfile::Apply(const std::string &profile_dir, const std::shared_ptr<DatasetNode> &root_ir,
+                              bool *applied) {
+  RETURN_UNEXPECTED_IF_NULL(applied);
+  *applied = false;
+  nlohmann::json tree_json;
+  RETURN_IF_NOT_OK(SerializeTree(root_ir, &tree_json));
+  std::string fingerprint;
+  RETURN_IF_NOT_OK(GetFingerprint(tree_json, &fingerprint));
+  auto profile_path = GetProfilePath(profile_dir, fingerprint);
+  std::ifstream json_in(profile_path);
+  if (!json_in.is_open()) {
+    MS_LOG(INFO) << "No AutoTune profile of this pipeline is found in " << profile_dir
+                 << ", it will be saved after AutoTune: " << profile_path;
+    return Status::OK();
+  }
+  nlohmann::json profile_json;
+  try {
+    json_in >> profile_json;
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Invalid AutoTune profile " << profile_path << ", it is ignored: " << e.what();
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<DatasetNode>> nodes;
+  FlattenTree(GetTreeTop(root_ir), &nodes);
+  if (!profile_json.contains(kNodesKey) || !profile_json[kNodesKey].is_array() ||
+      profile_json[kNodesKey].size() != nodes.size()) {
+    MS_LOG(WARNING) << "AutoTune profile " << profile_path << " does not match the pipeline, it is ignored.";
+    return Status::OK();
+  }
+  // check all the nodes before changing any of them
+  const auto &profile_nodes = profile_json[kNodesKey];
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (!profile_nodes[i].contains("op_type") || profile_nodes[i]["op_type"] != nodes[i]->Name()) {
+      MS_LOG(WARNING) << "AutoTune profile " << profile_path << " does not match the pipeline, it is ignored.";
+      return Status::OK();
+    }
+  }
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (!profile_nodes[i].contains(kNumWorkersKey) || !profile_nodes[i][kNumWorkersKey].is_number_integer() ||
+        !profile_nodes[i].contains(kQueueSizeKey) || !profile_nodes[i][kQueueSizeKey].is_number_integer()) {
+      continue;
+    }
+    int32_t num_workers = profile_nodes[i][kNumWorkersKey];
+    int32_t queue_size = profile_nodes[i][kQueueSizeKey];
+    if (num_workers > 0) {
+      (void)nodes[i]->SetNumWorkers(num_workers);
+    }
+    if (queue_size > 0) {
+      (void)nodes[i]->SetConnectorQueueSize(queue_size);
+    }
+    MS_LOG(INFO) << "AutoTune profile sets " << nodes[i]->Name() << " num_parallel_workers: " << num_workers
+                 << ", prefetch_size: " << queue_size;
+  }
+  *applied = true;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTOTUNE_PROFILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTOTUNE_PROFILE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetNode;
+
+/// \class AutoTuneProfile autotune_profile.h
+/// \brief Persists the num_parallel_workers and connector_queue_size AutoTune converged to, so that the next run of
+///     the same pipeline on the same kind of host starts from them. A profile is keyed by a fingerprint of the
+///     optimized IR tree without the tuned fields, and the cpu thread num of the host.
+class AutoTuneProfile {
+ public:
+  /// \brief Get the fingerprint of a serialized optimized IR tree
+  /// \param[in] tree_json The serialized IR tree, as saved by Serdes::SaveToJSON
+  /// \param[out] fingerprint The fingerprint of the tree
+  /// \return Status The status code returned
+  static Status GetFingerprint(const nlohmann::json &tree_json, std::string *fingerprint);
+
+  /// \brief Save the tuned configuration of a serialized optimized IR tree to the profile directory
+  /// \param[in] profile_dir The directory of the profiles
+  /// \param[in] tree_json The serialized IR tree with the tuned num_parallel_workers and connector_queue_size
+  /// \return Status The status code returned
+  static Status Save(const std::string &profile_dir, const nlohmann::json &tree_json);
+
+  /// \brief Set the num_parallel_workers and connector_queue_size of the optimized IR tree from its saved profile
+  /// \param[in] profile_dir The directory of the profiles
+  /// \param[in] root_ir The root of the optimized IR tree
+  /// \param[out] applied Whether a profile of the tree was found and applied
+  /// \return Status The status code returned
+  static Status Apply(const std::string &profile_dir, const std::shared_ptr<DatasetNode> &root_ir, bool *applied);
+
+ private:
+  /// \brief Serialize the optimized IR tree the same way AutoTune does, without the Top, EpochCtrl and Transfer nodes
+  static Status SerializeTree(const std::shared_ptr<DatasetNode> &root_ir, nlohmann::json *tree_json);
+
+  /// \brief Get the path of the profile of a fingerprint
+  static std::string GetProfilePath(const std::string &profile_dir, const std::string &fingerprint);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTOTUNE_PROFILE_H_
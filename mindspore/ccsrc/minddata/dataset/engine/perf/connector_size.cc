@@ -37,12 +37,17 @@ Status ConnectorSize::Sample() {
   Qrow cur_row;
   (void)std::transform(tree_->begin(), tree_->end(), std::back_inserter(cur_row),
                        [](const DatasetOp &op) { return op.ConnectorSize(); });
+  ReadBytesSample cur_read_bytes;
+  (void)std::transform(tree_->begin(), tree_->end(), std::back_inserter(cur_read_bytes),
+                       [](const DatasetOp &op) { return op.ReadBytes(); });
   // Tree Iterator is in PostOrder (leaf first, e.g., 3,2,1)
   // reverse the order of the vector to get the root first.
   std::reverse(cur_row.begin(), cur_row.end());
+  std::reverse(cur_read_bytes.begin(), cur_read_bytes.end());
   std::lock_guard<std::mutex> guard(lock_);
   // Push new row of sample
   sample_table_.push_back(cur_row);
+  read_bytes_table_.push_back(cur_read_bytes);
   (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
   return Status::OK();
 }
@@ -59,6 +64,10 @@ json ConnectorSize::ParseOpInfo(const DatasetOp &node) const {
   if (!node.inlined() && node.Name() != "DataQueueOp") {
     metrics["output_queue"] = {{"length", node.ConnectorCapacity()}};
   }
+  // The read throughput is reported for the ops which read files, e.g. MindRecordOp.
+  if (node.ReadBytes() >= 0) {
+    metrics["read_throughput"] = {{"unit", "MB/s"}};
+  }
   json_node["metrics"] = metrics;
 
   auto children = node.Children();
@@ -93,6 +102,9 @@ Status ConnectorSize::SaveToFile(const std::string &dir_path, const std::string
     if (ops_data[idx]["metrics"].contains("output_queue") && ops_data[idx]["op_type"] != "DataQueueOp") {
       ops_data[idx]["metrics"]["output_queue"]["size"] = cur_queue_size;
     }
+    if (ops_data[idx]["metrics"].contains("read_throughput")) {
+      ops_data[idx]["metrics"]["read_throughput"]["throughput"] = GetReadThroughput(idx);
+    }
   }
 
   // Discard the content of the file when opening.
@@ -102,6 +114,21 @@ Status ConnectorSize::SaveToFile(const std::string &dir_path, const std::string
   return Status::OK();
 }
 
+std::vector<double> ConnectorSize::GetReadThroughput(uint32_t idx) const {
+  // The throughput of a sample is the bytes read since the previous sample divided by the elapsed time.
+  const double kBytesPerMsToMBps = 1000.0 / (1024.0 * 1024.0);
+  std::vector<double> throughput;
+  for (size_t i = 0; i < read_bytes_table_.size() && i < ts_.size(); ++i) {
+    if (i == 0 || ts_[i] <= ts_[i - 1] || read_bytes_table_[i][idx] < read_bytes_table_[i - 1][idx]) {
+      throughput.push_back(0.0);
+      continue;
+    }
+    auto bytes = read_bytes_table_[i][idx] - read_bytes_table_[i - 1][idx];
+    throughput.push_back(static_cast<double>(bytes) / static_cast<double>(ts_[i] - ts_[i - 1]) * kBytesPerMsToMBps);
+  }
+  return throughput;
+}
+
 Status ConnectorSize::Init() {
   // Traverse the ExecutionTree for JSON node generation
   for (auto &node : *tree_) {
@@ -118,6 +145,7 @@ Status ConnectorSize::Init() {
 void ConnectorSize::Clear() {
   ts_.clear();
   sample_table_.clear();
+  read_bytes_table_.clear();
   initial_nodes_data.clear();
 }
 
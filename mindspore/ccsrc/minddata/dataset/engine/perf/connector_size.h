@@ -40,6 +40,9 @@ class ConnectorSize : public Sampling {
   // A circular buffer will be implemented in the future to make this table more flexible.
   using ConnectorSizeSample = std::vector<int>;
   using ConnectorSizeSampleTable = std::vector<ConnectorSizeSample>;
+  // Read bytes sampling data is stored in the same layout, -1 for the ops which do not read files.
+  using ReadBytesSample = std::vector<int64_t>;
+  using ReadBytesSampleTable = std::vector<ReadBytesSample>;
   using Timestamps = std::vector<uint64_t>;
 
  public:
@@ -71,6 +74,9 @@ class ConnectorSize : public Sampling {
   // Clear all collected data
   void Clear() override;
 
+  // Get the read throughput in MB/s of the op at the given index of the samples, one value per sample
+  std::vector<double> GetReadThroughput(uint32_t idx) const;
+
  protected:
   Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
 
@@ -78,6 +84,7 @@ class ConnectorSize : public Sampling {
   json initial_nodes_data;  // store data when execution tree is running. (all information for ops except sampled data)
   ExecutionTree *tree_ = nullptr;          // ExecutionTree pointer
   ConnectorSizeSampleTable sample_table_;  // Dataset structure to store all samples of connector size sampling
+  ReadBytesSampleTable read_bytes_table_;  // Dataset structure to store all samples of read bytes sampling
   Timestamps ts_;                          // time of sample
 };
 
@@ -300,6 +300,7 @@ Serdes::InitializeFuncPtr() {
   ops_ptr[vision::kCutMixBatchOperation] = &(vision::CutMixBatchOperation::from_json);
   ops_ptr[vision::kCutOutOperation] = &(vision::CutOutOperation::from_json);
   ops_ptr[vision::kDecodeOperation] = &(vision::DecodeOperation::from_json);
+  ops_ptr[vision::kDecodeCropResizeOperation] = &(vision::DecodeCropResizeOperation::from_json);
 #if defined(WITH_BACKEND) || defined(ENABLE_ACL)
   if (AclAdapter::GetInstance().HasAclPlugin()) {
     ops_ptr[vision::kDvppCropJpegOperation] = &(vision::DvppCropJpegOperation::from_json);
@@ -19,13 +19,16 @@
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/batch_pushdown_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_offload_pass.h"
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
+#include "minddata/dataset/engine/perf/autotune_profile.h"
 #endif
 #include "minddata/dataset/engine/opt/pass.h"
 #include "minddata/dataset/engine/opt/post/auto_worker_pass.h"
+#include "minddata/dataset/engine/opt/post/unordered_connector_pass.h"
 #ifdef ENABLE_PYTHON
 #include "minddata/dataset/engine/opt/post/generator_node_pass.h"
 #endif
@@ -98,10 +101,11 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
 Status TreeAdapter::Optimize(std::shared_ptr<DatasetNode> ir) {
   RETURN_UNEXPECTED_IF_NULL(ir);
   // Vector of optimizations
-  std::vector<std::unique_ptr<IRNodePass>> optimizations;
+  std::vector<std::unique_ptr<IRPass>> optimizations;
   MS_LOG(INFO) << "Running optimization pass loops";
 #ifndef ENABLE_ANDROID
   (void)optimizations.emplace_back(std::make_unique<TensorOpFusionPass>());
+  (void)optimizations.emplace_back(std::make_unique<BatchPushdownPass>());
 #endif
   // Apply optimization pass actions
   for (auto i = 0; i < optimizations.size(); i++) {
@@ -123,6 +127,11 @@ Status TreeAdapter::PostPass(std::shared_ptr<DatasetNode> ir) {
     // skip this for getter pass
     (void)actions.emplace_back(std::make_unique<AutoWorkerPass>());
   }
+  // Debug mode runs the pipeline sequentially and expects deterministic results, keep the order there
+  if (GlobalContext::config_manager()->enable_unordered_connector() &&
+      !GlobalContext::config_manager()->get_debug_mode()) {
+    (void)actions.emplace_back(std::make_unique<UnorderedConnectorPass>());
+  }
 #ifdef ENABLE_PYTHON
   (void)actions.emplace_back(std::make_unique<GeneratorNodePass>());
 #endif
@@ -227,6 +236,19 @@ Status TreeAdapter::Compile(const std::shared_ptr<DatasetNode> &input_ir, int32_
   // Post-pass of the IR tree
   RETURN_IF_NOT_OK(PostPass(root_ir));
 
+#ifndef ENABLE_ANDROID
+  // Start from the workers and queue sizes AutoTune converged to in a previous run of the same pipeline
+  auto profile_dir = GlobalContext::config_manager()->autotune_profile_dir();
+  if (!profile_dir.empty()) {
+    bool applied = false;
+    // pipelines which can not be serialized, e.g. with python functions, have no profile
+    Status rc = AutoTuneProfile::Apply(profile_dir, root_ir, &applied);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to apply the AutoTune profile, the pipeline starts untuned: " << rc;
+    }
+  }
+#endif
+
   tree_state_ = kCompileStateOptimized;
   MS_LOG(INFO) << "Plan after optimization:" << '\n' << *root_ir << '\n';
   // Remember the root node
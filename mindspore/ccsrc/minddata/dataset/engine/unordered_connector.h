@@ -0,0 +1,195 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_UNORDERED_CONNECTOR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_UNORDERED_CONNECTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// UnorderedConnector is a communication data structure between two groups of threads that does NOT
+// preserve the global order. Any producer can push and any consumer can pop at any time, so a slow
+// producer never blocks the others the way the round robin of Connector does.
+//
+// It is a bounded lock-free multi-producer multi-consumer ring, every cell carries a sequence number
+// that tells whether the cell is ready to be written or read (refer to Dmitry Vyukov's bounded MPMC queue).
+// Elements pushed by the same producer are still popped in the order they were pushed if there is a
+// single consumer, ParallelOp relies on that to keep the eoe/eof flags behind the rows of each worker.
+//
+// Blocking conditions:
+//   1. Add() spins then sleeps while the ring is full.
+//   2. PopFront() spins then sleeps while the ring is empty.
+// Both of them wake up once a while to check for interrupt of the calling thread.
+template <class T>
+class UnorderedConnector {
+ public:
+  // Name: Constructor
+  // Description: The capacity is rounded up to the power of two.
+  // @param capacity The minimum number of elements the connector can hold.
+  explicit UnorderedConnector(int32_t capacity) {
+    size_t sz = 1;
+    while (sz < static_cast<size_t>(std::max(capacity, 1))) {
+      sz <<= 1;
+    }
+    mask_ = sz - 1;
+    cells_ = std::make_unique<Cell[]>(sz);
+    for (size_t i = 0; i < sz; ++i) {
+      cells_[i].seq_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~UnorderedConnector() = default;
+
+  UnorderedConnector(const UnorderedConnector &) = delete;
+  UnorderedConnector &operator=(const UnorderedConnector &) = delete;
+
+  // Push an element, the element is left untouched if the ring is full.
+  // @return false if the ring is full.
+  bool TryAdd(T &&elem) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq_.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data_ = std::move(elem);
+    cell->seq_.store(pos + 1, std::memory_order_release);
+    if (num_pop_waiters_.load(std::memory_order_acquire) > 0) {
+      std::lock_guard<std::mutex> lock(mux_);
+      not_empty_.notify_one();
+    }
+    return true;
+  }
+
+  // Pop an element.
+  // @return false if the ring is empty.
+  bool TryPopFront(T *result) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq_.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *result = std::move(cell->data_);
+    cell->seq_.store(pos + mask_ + 1, std::memory_order_release);
+    if (num_add_waiters_.load(std::memory_order_acquire) > 0) {
+      std::lock_guard<std::mutex> lock(mux_);
+      not_full_.notify_one();
+    }
+    return true;
+  }
+
+  // Blocking push, wait until there is a free cell.
+  Status Add(T &&elem) {
+    for (int32_t spin = 0; spin < kSpinCount; ++spin) {
+      if (TryAdd(std::move(elem))) {
+        return Status::OK();
+      }
+      std::this_thread::yield();
+    }
+    while (!TryAdd(std::move(elem))) {
+      RETURN_IF_NOT_OK(Sleep(&not_full_, &num_add_waiters_, [this]() { return !Full(); }));
+    }
+    return Status::OK();
+  }
+
+  // Blocking pop, wait until there is an element.
+  Status PopFront(T *result) {
+    RETURN_UNEXPECTED_IF_NULL(result);
+    for (int32_t spin = 0; spin < kSpinCount; ++spin) {
+      if (TryPopFront(result)) {
+        return Status::OK();
+      }
+      std::this_thread::yield();
+    }
+    while (!TryPopFront(result)) {
+      RETURN_IF_NOT_OK(Sleep(&not_empty_, &num_pop_waiters_, [this]() { return !Empty(); }));
+    }
+    return Status::OK();
+  }
+
+  // The results are only a snapshot since other threads may be working on the ring at the same time.
+  size_t Size() const {
+    size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  size_t Capacity() const { return mask_ + 1; }
+  bool Empty() const { return Size() == 0; }
+  bool Full() const { return Size() >= Capacity(); }
+
+ private:
+  static constexpr int32_t kSpinCount = 64;
+  static constexpr int64_t kSleepIntervalMs = 1;
+
+  struct Cell {
+    std::atomic<size_t> seq_{0};
+    T data_;
+  };
+
+  // Sleep a while on the given condition, the flag of waiters lets the other side skip the notify when nobody sleeps.
+  template <typename F>
+  Status Sleep(std::condition_variable *cv, std::atomic<int32_t> *num_waiters, F &&ready) {
+    std::unique_lock<std::mutex> lock(mux_);
+    num_waiters->fetch_add(1, std::memory_order_acq_rel);
+    (void)cv->wait_for(lock, std::chrono::milliseconds(kSleepIntervalMs), ready);
+    num_waiters->fetch_sub(1, std::memory_order_acq_rel);
+    RETURN_IF_INTERRUPTED();
+    return Status::OK();
+  }
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_{0};
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+  alignas(64) std::atomic<int32_t> num_add_waiters_{0};
+  std::atomic<int32_t> num_pop_waiters_{0};
+  std::mutex mux_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_UNORDERED_CONNECTOR_H_
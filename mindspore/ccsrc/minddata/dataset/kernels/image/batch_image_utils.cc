@@ -0,0 +1,275 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/batch_image_utils.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BATCH_IMAGE_NEON
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_IMAGE_AVX2
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kBatchMinRank = 4;
+constexpr int64_t kDim0Index = -3;
+constexpr int64_t kDim1Index = -2;
+constexpr int64_t kDim2Index = -1;
+// elements normalized per vector step, 8 floats of avx2 or 2 x 4 floats of neon
+constexpr int64_t kLanes = 8;
+constexpr int64_t kRgbChannel = 3;
+
+// the last three dims of a batch, and the number of images in it
+struct BatchImageDims {
+  int64_t num;
+  int64_t dim0;
+  int64_t dim1;
+  int64_t dim2;
+};
+
+Status GetBatchImageDims(const std::shared_ptr<Tensor> &input, const std::string &op_name, BatchImageDims *dims) {
+  const auto &shape = input->shape();
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.Rank() >= kBatchMinRank, op_name + ": batch of images should have at least " +
+                                                                 std::to_string(kBatchMinRank) +
+                                                                 " dimensions, but got: " +
+                                                                 std::to_string(shape.Rank()));
+  dims->dim0 = shape[kDim0Index];
+  dims->dim1 = shape[kDim1Index];
+  dims->dim2 = shape[kDim2Index];
+  int64_t image_size = dims->dim0 * dims->dim1 * dims->dim2;
+  dims->num = image_size == 0 ? 0 : input->Size() / image_size;
+  return Status::OK();
+}
+
+#if defined(BATCH_IMAGE_NEON)
+inline void NormalizeLanes(const uint8_t *in, float *out, const float *mean, const float *std) {
+  uint16x8_t in_u16 = vmovl_u8(vld1_u8(in));
+  float32x4_t low = vcvtq_f32_u32(vmovl_u16(vget_low_u16(in_u16)));
+  float32x4_t high = vcvtq_f32_u32(vmovl_u16(vget_high_u16(in_u16)));
+  vst1q_f32(out, vdivq_f32(vsubq_f32(low, vld1q_f32(mean)), vld1q_f32(std)));
+  vst1q_f32(out + 4, vdivq_f32(vsubq_f32(high, vld1q_f32(mean + 4)), vld1q_f32(std + 4)));
+}
+
+inline void NormalizeLanes(const float *in, float *out, const float *mean, const float *std) {
+  vst1q_f32(out, vdivq_f32(vsubq_f32(vld1q_f32(in), vld1q_f32(mean)), vld1q_f32(std)));
+  vst1q_f32(out + 4, vdivq_f32(vsubq_f32(vld1q_f32(in + 4), vld1q_f32(mean + 4)), vld1q_f32(std + 4)));
+}
+#elif defined(BATCH_IMAGE_AVX2)
+inline void NormalizeLanes(const uint8_t *in, float *out, const float *mean, const float *std) {
+  __m256 in_f32 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in))));
+  _mm256_storeu_ps(out, _mm256_div_ps(_mm256_sub_ps(in_f32, _mm256_loadu_ps(mean)), _mm256_loadu_ps(std)));
+}
+
+inline void NormalizeLanes(const float *in, float *out, const float *mean, const float *std) {
+  _mm256_storeu_ps(out,
+                   _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(in), _mm256_loadu_ps(mean)), _mm256_loadu_ps(std)));
+}
+#else
+template <typename T>
+inline void NormalizeLanes(const T *in, float *out, const float *mean, const float *std) {
+  for (int64_t i = 0; i < kLanes; i++) {
+    out[i] = (static_cast<float>(in[i]) - mean[i]) / std[i];
+  }
+}
+#endif
+
+// normalize `total` elements whose channel is the element index modulo the channel num. The mean and std repeat
+// every channel * kLanes elements, so each vector step uses a fixed slice of the repeated mean and std.
+template <typename T>
+void NormalizeInterleaved(const T *in, float *out, int64_t total, const std::vector<float> &mean,
+                          const std::vector<float> &std) {
+  const int64_t channel = static_cast<int64_t>(mean.size());
+  const int64_t period = channel * kLanes;
+  std::vector<float> mean_period(period);
+  std::vector<float> std_period(period);
+  for (int64_t i = 0; i < period; i++) {
+    mean_period[i] = mean[i % channel];
+    std_period[i] = std[i % channel];
+  }
+  int64_t i = 0;
+  for (; i + period <= total; i += period) {
+    for (int64_t k = 0; k < period; k += kLanes) {
+      NormalizeLanes(in + i + k, out + i + k, mean_period.data() + k, std_period.data() + k);
+    }
+  }
+  for (; i < total; i++) {
+    out[i] = (static_cast<float>(in[i]) - mean[i % channel]) / std[i % channel];
+  }
+}
+
+template <typename T>
+void NormalizeBatch(const T *in, float *out, const BatchImageDims &dims, const std::vector<float> &mean,
+                    const std::vector<float> &std, bool is_hwc) {
+  if (is_hwc) {
+    NormalizeInterleaved(in, out, dims.num * dims.dim0 * dims.dim1 * dims.dim2, mean, std);
+    return;
+  }
+  // every channel plane of <C, H, W> uses a single mean and std
+  const int64_t plane_size = dims.dim1 * dims.dim2;
+  for (int64_t n = 0; n < dims.num; n++) {
+    for (int64_t c = 0; c < dims.dim0; c++) {
+      int64_t offset = (n * dims.dim0 + c) * plane_size;
+      NormalizeInterleaved(in + offset, out + offset, plane_size, {mean[c]}, {std[c]});
+    }
+  }
+}
+
+template <typename T>
+void HwcToChwBatch(const T *in, T *out, const BatchImageDims &dims) {
+  const int64_t plane_size = dims.dim0 * dims.dim1;
+  const int64_t channel = dims.dim2;
+  for (int64_t n = 0; n < dims.num; n++) {
+    const T *in_image = in + n * plane_size * channel;
+    T *out_image = out + n * plane_size * channel;
+    int64_t p = 0;
+#if defined(BATCH_IMAGE_NEON)
+    // deinterleave 16 rgb pixels per step
+    constexpr int64_t kRgbPixels = 16;
+    if (std::is_same<T, uint8_t>::value && channel == kRgbChannel) {
+      auto in_u8 = reinterpret_cast<const uint8_t *>(in_image);
+      auto out_u8 = reinterpret_cast<uint8_t *>(out_image);
+      for (; p + kRgbPixels <= plane_size; p += kRgbPixels) {
+        uint8x16x3_t rgb = vld3q_u8(in_u8 + p * kRgbChannel);
+        vst1q_u8(out_u8 + p, rgb.val[0]);
+        vst1q_u8(out_u8 + plane_size + p, rgb.val[1]);
+        vst1q_u8(out_u8 + 2 * plane_size + p, rgb.val[2]);
+      }
+    }
+#endif
+    for (; p < plane_size; p++) {
+      for (int64_t c = 0; c < channel; c++) {
+        out_image[c * plane_size + p] = in_image[p * channel + c];
+      }
+    }
+  }
+}
+}  // namespace
+
+bool IsBatchNormalizeSupported(const DataType &type) {
+  return type == DataType(DataType::DE_UINT8) || type == DataType(DataType::DE_FLOAT32);
+}
+
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std, bool is_hwc) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  CHECK_FAIL_RETURN_UNEXPECTED(IsBatchNormalizeSupported(input->type()),
+                               "Normalize: batched normalize only supports uint8 and float32, but got: " +
+                                 input->type().ToString());
+  BatchImageDims dims{};
+  RETURN_IF_NOT_OK(GetBatchImageDims(input, "Normalize", &dims));
+  CHECK_FAIL_RETURN_UNEXPECTED(std.size() == mean.size(),
+                               "Normalize: mean and std vectors are not of same size, got size of std: " +
+                                 std::to_string(std.size()) + ", and mean size: " + std::to_string(mean.size()));
+  const int64_t channel = is_hwc ? dims.dim2 : dims.dim0;
+  // caller provided 1 mean/std value and there is more than one channel --> duplicate mean/std value
+  if (mean.size() == 1 && channel != 1) {
+    mean.resize(channel, mean[0]);
+    std.resize(channel, std[0]);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(channel == static_cast<int64_t>(mean.size()),
+                               "Normalize: number of channels does not match the size of mean and std vectors, got "
+                               "channels: " +
+                                 std::to_string(channel) + ", size of mean: " + std::to_string(mean.size()));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
+  auto out = reinterpret_cast<float *>((*output)->GetMutableBuffer());
+  if (input->type() == DataType(DataType::DE_UINT8)) {
+    NormalizeBatch(reinterpret_cast<const uint8_t *>(input->GetBuffer()), out, dims, mean, std, is_hwc);
+  } else {
+    NormalizeBatch(reinterpret_cast<const float *>(input->GetBuffer()), out, dims, mean, std, is_hwc);
+  }
+  return Status::OK();
+}
+
+Status BatchHorizontalFlip(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  BatchImageDims dims{};
+  RETURN_IF_NOT_OK(GetBatchImageDims(input, "HorizontalFlip", &dims));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), input->type(), output));
+  const size_t pixel_bytes = static_cast<size_t>(dims.dim2) * input->type().SizeInBytes();
+  const size_t row_bytes = pixel_bytes * dims.dim1;
+  const int64_t row_num = dims.num * dims.dim0;
+  const unsigned char *in = input->GetBuffer();
+  unsigned char *out = (*output)->GetMutableBuffer();
+  for (int64_t row = 0; row < row_num; row++) {
+    const unsigned char *in_row = in + row * row_bytes;
+    unsigned char *out_row = out + row * row_bytes + row_bytes - pixel_bytes;
+    for (int64_t w = 0; w < dims.dim1; w++) {
+      (void)memcpy(out_row - w * pixel_bytes, in_row + w * pixel_bytes, pixel_bytes);
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchVerticalFlip(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  BatchImageDims dims{};
+  RETURN_IF_NOT_OK(GetBatchImageDims(input, "VerticalFlip", &dims));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), input->type(), output));
+  const size_t row_bytes = static_cast<size_t>(dims.dim1 * dims.dim2) * input->type().SizeInBytes();
+  const unsigned char *in = input->GetBuffer();
+  unsigned char *out = (*output)->GetMutableBuffer();
+  for (int64_t n = 0; n < dims.num; n++) {
+    const unsigned char *in_image = in + n * dims.dim0 * row_bytes;
+    unsigned char *out_image = out + n * dims.dim0 * row_bytes;
+    for (int64_t h = 0; h < dims.dim0; h++) {
+      (void)memcpy(out_image + (dims.dim0 - 1 - h) * row_bytes, in_image + h * row_bytes, row_bytes);
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  BatchImageDims dims{};
+  RETURN_IF_NOT_OK(GetBatchImageDims(input, "HWC2CHW", &dims));
+  auto out_shape = input->shape().AsVector();
+  const size_t rank = out_shape.size();
+  out_shape[rank + kDim0Index] = dims.dim2;
+  out_shape[rank + kDim1Index] = dims.dim0;
+  out_shape[rank + kDim2Index] = dims.dim1;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(out_shape), input->type(), output));
+  const unsigned char *in = input->GetBuffer();
+  unsigned char *out = (*output)->GetMutableBuffer();
+  switch (input->type().SizeInBytes()) {
+    case sizeof(uint8_t):
+      HwcToChwBatch(reinterpret_cast<const uint8_t *>(in), reinterpret_cast<uint8_t *>(out), dims);
+      break;
+    case sizeof(uint16_t):
+      HwcToChwBatch(reinterpret_cast<const uint16_t *>(in), reinterpret_cast<uint16_t *>(out), dims);
+      break;
+    case sizeof(uint32_t):
+      HwcToChwBatch(reinterpret_cast<const uint32_t *>(in), reinterpret_cast<uint32_t *>(out), dims);
+      break;
+    case sizeof(uint64_t):
+      HwcToChwBatch(reinterpret_cast<const uint64_t *>(in), reinterpret_cast<uint64_t *>(out), dims);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HWC2CHW: unsupported type of batched input: " + input->type().ToString());
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCH_IMAGE_UTILS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCH_IMAGE_UTILS_H_
+
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Kernels on a contiguous batch of images of shape <..., H, W, C> (or <..., C, H, W> where noted), as produced by
+// BatchOp. They run on the whole buffer in one pass instead of splitting the batch into per image tensors, and use
+// NEON or AVX2 when the build targets them.
+
+/// \brief Whether the batched Normalize supports the input type.
+bool IsBatchNormalizeSupported(const DataType &type);
+
+/// \brief Normalize a batch of uint8 or float32 images into float32.
+/// \param is_hwc: the images are <..., H, W, C> if true, otherwise <..., C, H, W>.
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std, bool is_hwc);
+
+/// \brief Flip a batch of images horizontally.
+Status BatchHorizontalFlip(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+/// \brief Flip a batch of images vertically.
+Status BatchVerticalFlip(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+/// \brief Transpose a batch of images from <..., H, W, C> to <..., C, H, W>.
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCH_IMAGE_UTILS_H_
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/kernels/image/batched_image_op.h"
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status BatchedImageOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  RETURN_UNEXPECTED_IF_NULL(image_op_);
+  TensorShape batch_shape = input->shape();
+  CHECK_FAIL_RETURN_UNEXPECTED(batch_shape.Rank() > kMinImageRank,
+                               image_op_->Name() + ": input should be a batch of images of at least 3 dimensions, "
+                                                   "but got: " + std::to_string(batch_shape.Rank()));
+  if (batch_shape.Rank() > kDefaultImageRank) {
+    // <N, H, W, C>, the per image op runs its batched kernel on it
+    return image_op_->Compute(input, output);
+  }
+  // <N, H, W>, the per image op would take it for one <H, W, C> image
+  if (image_op_->Name() == kHwcToChwOp) {
+    // HWC2CHW keeps a <H, W> image as it is
+    *output = input;
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(input->ExpandDim(kDefaultImageRank));
+  Status rc = image_op_->Compute(input, output);
+  RETURN_IF_NOT_OK(input->Reshape(batch_shape));
+  RETURN_IF_NOT_OK(rc);
+  // the other ops keep the <H, W> of the images
+  return (*output)->Reshape(batch_shape);
+}
+
+Status BatchedImageOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_UNEXPECTED_IF_NULL(image_op_);
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty() && inputs[0].Rank() > kMinImageRank,
+                               image_op_->Name() + ": input should be a batch of images of at least 3 dimensions.");
+  std::vector<TensorShape> image_inputs;
+  for (const auto &input : inputs) {
+    auto dims = input.AsVector();
+    (void)image_inputs.emplace_back(std::vector<dsize_t>(dims.begin() + 1, dims.end()));
+  }
+  std::vector<TensorShape> image_outputs;
+  RETURN_IF_NOT_OK(image_op_->OutputShape(image_inputs, image_outputs));
+  outputs.clear();
+  for (const auto &image_output : image_outputs) {
+    auto dims = image_output.AsVector();
+    (void)dims.insert(dims.begin(), inputs[0][0]);
+    (void)outputs.emplace_back(dims);
+  }
+  return Status::OK();
+}
+
+Status BatchedImageOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_UNEXPECTED_IF_NULL(image_op_);
+  return image_op_->OutputType(inputs, outputs);
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCHED_IMAGE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCHED_IMAGE_OP_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Run a per image op on a batch of images, whose first dimension is always the batch size N.
+///     A per image op takes a rank 3 tensor for one <H, W, C> image, so a batch of <H, W> images is given to it as a
+///     batch of <H, W, 1> images, and its result is the same as running it on every image of the batch.
+class BatchedImageOp : public TensorOp {
+ public:
+  explicit BatchedImageOp(std::shared_ptr<TensorOp> image_op) : image_op_(std::move(image_op)) {}
+
+  ~BatchedImageOp() override = default;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kBatchedImageOp; }
+
+  Status to_json(nlohmann::json *out_json) override { return image_op_->to_json(out_json); }
+
+  /// \brief Getter
+  /// \return The per image op run on the batches
+  const std::shared_ptr<TensorOp> &image_op() const { return image_op_; }
+
+ private:
+  std::shared_ptr<TensorOp> image_op_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_BATCHED_IMAGE_OP_H_
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/decode_crop_resize_op.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+
+namespace mindspore {
+namespace dataset {
+DecodeCropResizeOp::DecodeCropResizeOp(int32_t resize_height, int32_t resize_width, int32_t crop_height,
+                                       int32_t crop_width, InterpolationMode interpolation)
+    : resize_height_(resize_height),
+      resize_width_(resize_width),
+      crop_height_(crop_height),
+      crop_width_(crop_width == 0 ? crop_height : crop_width),
+      interpolation_(interpolation) {}
+
+// the same output size as ResizeOp
+void DecodeCropResizeOp::GetResizedSize(int32_t input_h, int32_t input_w, int32_t *output_h, int32_t *output_w) const {
+  if (resize_width_ != 0) {
+    *output_h = resize_height_;
+    *output_w = resize_width_;
+  } else if (input_h < input_w) {
+    *output_h = resize_height_;
+    *output_w = static_cast<int32_t>(std::floor(static_cast<float>(input_w) / input_h * resize_height_));
+  } else {
+    *output_w = resize_height_;
+    *output_h = static_cast<int32_t>(std::floor(static_cast<float>(input_h) / input_w * resize_height_));
+  }
+}
+
+Status DecodeCropResizeOp::ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(DecodeOp(true).Compute(input, &decoded));
+  if (crop_height_ == 0) {
+    return ResizeOp(resize_height_, resize_width_, interpolation_).Compute(decoded, output);
+  }
+  std::shared_ptr<Tensor> resized;
+  RETURN_IF_NOT_OK(ResizeOp(resize_height_, resize_width_, interpolation_).Compute(decoded, &resized));
+  return CenterCropOp(crop_height_, crop_width_).Compute(resized, output);
+}
+
+Status DecodeCropResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (input->Rank() != 1) {
+    RETURN_STATUS_UNEXPECTED("DecodeCropResize: invalid input shape, only support 1D input, got rank: " +
+                             std::to_string(input->Rank()));
+  }
+  if (!IsNonEmptyJPEG(input)) {
+    return ComputeUnfused(input, output);
+  }
+  int32_t input_h = 0;
+  int32_t input_w = 0;
+  RETURN_IF_NOT_OK(GetJpegImageInfo(input, &input_w, &input_h));
+  CHECK_FAIL_RETURN_UNEXPECTED(input_h > 0 && input_w > 0, "DecodeCropResize: the input image size cannot be 0.");
+  int32_t resized_h = 0;
+  int32_t resized_w = 0;
+  GetResizedSize(input_h, input_w, &resized_h, &resized_w);
+  int32_t output_h = crop_height_ == 0 ? resized_h : crop_height_;
+  int32_t output_w = crop_height_ == 0 ? resized_w : crop_width_;
+  // the center crop pads a resized image smaller than the crop
+  if (output_h > resized_h || output_w > resized_w || output_h <= 0 || output_w <= 0) {
+    return ComputeUnfused(input, output);
+  }
+  // the center crop box of the resized image in the coordinates of the input image
+  const float scale_h = static_cast<float>(input_h) / resized_h;
+  const float scale_w = static_cast<float>(input_w) / resized_w;
+  int32_t crop_h = std::max(static_cast<int32_t>(std::round(output_h * scale_h)), 1);
+  int32_t crop_w = std::max(static_cast<int32_t>(std::round(output_w * scale_w)), 1);
+  crop_h = std::min(crop_h, input_h);
+  crop_w = std::min(crop_w, input_w);
+  int32_t crop_y = std::min(static_cast<int32_t>(((resized_h - output_h) / 2) * scale_h), input_h - crop_h);
+  int32_t crop_x = std::min(static_cast<int32_t>(((resized_w - output_w) / 2) * scale_w), input_w - crop_w);
+
+  int scale_denom = GetJpegScaleDenom(crop_w, crop_h, output_w, output_h);
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, crop_x, crop_y, crop_w, crop_h, scale_denom));
+  if (decoded->shape()[kHeightIndex] == output_h && decoded->shape()[kWidthIndex] == output_w) {
+    *output = decoded;
+    return Status::OK();
+  }
+  return Resize(decoded, output, output_h, output_w, 0.0, 0.0, interpolation_);
+}
+
+Status DecodeCropResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(inputs[0].Rank() == 1,
+                               "DecodeCropResize: invalid input shape, expected 1D input, but got input dimension is:" +
+                                 std::to_string(inputs[0].Rank()));
+  if (crop_height_ != 0) {
+    (void)outputs.emplace_back(TensorShape({crop_height_, crop_width_, kDefaultImageChannel}));
+  } else if (resize_width_ != 0) {
+    (void)outputs.emplace_back(TensorShape({resize_height_, resize_width_, kDefaultImageChannel}));
+  } else {
+    (void)outputs.emplace_back(TensorShape({-1, -1, kDefaultImageChannel}));
+  }
+  return Status::OK();
+}
+
+Status DecodeCropResizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_UINT8);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
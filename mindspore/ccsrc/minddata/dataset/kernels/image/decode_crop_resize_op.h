@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_CROP_RESIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_CROP_RESIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Fused Decode, Resize and an optional CenterCrop. A jpeg image is decoded only in the box that the center crop of the
+// resized image maps back to, at a reduced DCT scale when the box is much larger than the output, and the box is
+// resized to the output size directly. Other images run the three ops one by one.
+class DecodeCropResizeOp : public TensorOp {
+ public:
+  // @param resize_height, resize_width: the size of Resize, a zero width resizes the smaller edge to resize_height
+  //     and keeps the aspect ratio.
+  // @param crop_height, crop_width: the size of CenterCrop, zero means no crop.
+  DecodeCropResizeOp(int32_t resize_height, int32_t resize_width, int32_t crop_height, int32_t crop_width,
+                     InterpolationMode interpolation);
+
+  ~DecodeCropResizeOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << resize_height_ << " " << resize_width_ << " " << crop_height_ << " " << crop_width_;
+  }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kDecodeCropResizeOp; }
+
+ private:
+  Status ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  void GetResizedSize(int32_t input_h, int32_t input_w, int32_t *output_h, int32_t *output_w) const;
+
+  int32_t resize_height_;
+  int32_t resize_width_;
+  int32_t crop_height_;
+  int32_t crop_width_;
+  InterpolationMode interpolation_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_CROP_RESIZE_OP_H_
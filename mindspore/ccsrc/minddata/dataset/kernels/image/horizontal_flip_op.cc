@@ -17,6 +17,7 @@
 #include "minddata/dataset/kernels/image/horizontal_flip_op.h"
 
 #include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/image/batch_image_utils.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 
 namespace mindspore {
@@ -28,24 +29,8 @@ Status HorizontalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shar
   if (rank <= kDefaultImageRank) {
     RETURN_IF_NOT_OK(HorizontalFlip(input, output));
   } else {
-    // reshape input to nhwc
-    auto input_shape = input->shape();
-    dsize_t num_batch = input->Size() / (input_shape[-3] * input_shape[-2] * input_shape[-1]);
-    TensorShape new_shape({num_batch, input_shape[-3], input_shape[-2], input_shape[-1]});
-    RETURN_IF_NOT_OK(input->Reshape(new_shape));
-
-    // split [N, H, W, C] to N [H, W, C], and horizental flip N [H, W, C]
-    std::vector<std::shared_ptr<Tensor>> input_vector_hwc, output_vector_hwc;
-    RETURN_IF_NOT_OK(BatchTensorToTensorVector(input, &input_vector_hwc));
-    for (int i = 0; i < num_batch; i++) {
-      std::shared_ptr<Tensor> flip;
-      RETURN_IF_NOT_OK(HorizontalFlip(input_vector_hwc[i], &flip));
-      output_vector_hwc.push_back(flip);
-    }
-
-    // integrate N [H, W, C] to [N, H, W, C], and reshape [..., H, W, C]
-    RETURN_IF_NOT_OK(TensorVectorToBatchTensor(output_vector_hwc, output));
-    RETURN_IF_NOT_OK((*output)->Reshape(input_shape));
+    // [..., H, W, C], flip every image of the batch without splitting it
+    RETURN_IF_NOT_OK(BatchHorizontalFlip(input, output));
   }
   return Status::OK();
 }
@@ -15,7 +15,10 @@
  */
 #include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
 
+#include <algorithm>
+
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/batch_image_utils.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #else
 #include "minddata/dataset/kernels/image/lite_image_utils.h"
@@ -28,6 +31,12 @@ Status HwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   IO_CHECK(input, output);
   // input.shape == HWC
   // output.shape == CHW
+#ifndef ENABLE_ANDROID
+  if (input->Rank() > kDefaultImageRank) {
+    // [..., H, W, C] to [..., C, H, W]
+    return BatchHwcToChw(input, output);
+  }
+#endif
   return HwcToChw(input, output);
 }
 Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -39,6 +48,14 @@ Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vect
   if (inputs[0].Rank() == 3) {
     (void)outputs.emplace_back(out);
   }
+#ifndef ENABLE_ANDROID
+  if (inputs[0].Rank() > kDefaultImageRank) {
+    auto batch_shape = in.AsVector();
+    auto rank = batch_shape.size();
+    std::rotate(batch_shape.begin() + rank - kDefaultImageRank, batch_shape.end() - 1, batch_shape.end());
+    (void)outputs.emplace_back(TensorShape(batch_shape));
+  }
+#endif
   if (!outputs.empty()) {
     return Status::OK();
   }
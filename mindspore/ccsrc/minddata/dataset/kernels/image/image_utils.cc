@@ -512,8 +512,24 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
     STATUS_ERROR(StatusCode::kMDUnexpectedError, "Error raised by libjpeg: " + std::string(jpeg_error_msg)));
 }
 
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h) {
+  constexpr int kMaxJpegScaleDenom = 8;
+  int scale_denom = 1;
+  if (target_w <= 0 || target_h <= 0) {
+    return scale_denom;
+  }
+  while (scale_denom < kMaxJpegScaleDenom && crop_w / (scale_denom * DOUBLING_FACTOR) >= target_w &&
+         crop_h / (scale_denom * DOUBLING_FACTOR) >= target_h) {
+    scale_denom *= DOUBLING_FACTOR;
+  }
+  return scale_denom;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  CHECK_FAIL_RETURN_UNEXPECTED(scale_denom == 1 || scale_denom == 2 || scale_denom == 4 || scale_denom == 8,
+                               "JpegCropAndDecode: scale denom should be 1, 2, 4 or 8, got: " +
+                                 std::to_string(scale_denom));
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -527,11 +543,21 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    // the idct of libjpeg-turbo outputs the reduced size directly, which skips most of the decode work
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
     jpeg_calc_output_dimensions(&cinfo);
     RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
   }
+  if (scale_denom > 1 && (crop_w != 0 || crop_h != 0)) {
+    // map the crop box to the scaled image
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = std::min(std::max(crop_w / scale_denom, 1), static_cast<int>(cinfo.output_width) - crop_x);
+    crop_h = std::min(std::max(crop_h / scale_denom, 1), static_cast<int>(cinfo.output_height) - crop_y);
+  }
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int32_t>::max() - crop_w) > crop_x,
                                "JpegCropAndDecode: addition(crop x and crop width) out of bounds, got crop x:" +
                                  std::to_string(crop_x) + ", and crop width:" + std::to_string(crop_w));
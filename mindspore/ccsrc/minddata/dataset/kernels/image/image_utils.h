@@ -161,8 +161,15 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decode the crop box of a jpeg image, the crop box is given in the coordinates of the full image.
+/// \param scale_denom: decode at 1/scale_denom of the size by scaling in the DCT domain, must be 1, 2, 4 or 8.
+///     The output shape is the crop box scaled by 1/scale_denom.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
+
+/// \brief Get the largest DCT scale denom (1, 2, 4 or 8) a jpeg crop box can be decoded with, so that the decoded
+///     box is still no smaller than the target size of the following resize.
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -20,6 +20,7 @@
 
 #include "minddata/dataset/kernels/data/data_utils.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/batch_image_utils.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #else
 #include "minddata/dataset/kernels/image/lite_image_utils.h"
@@ -47,6 +48,12 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
     return Normalize(input, output, mean_, std_);
 #endif
   } else {
+#ifndef ENABLE_ANDROID
+    // normalize the whole batch in one pass without splitting it into images
+    if (IsBatchNormalizeSupported(input->type())) {
+      return BatchNormalize(input, output, mean_, std_, is_hwc_);
+    }
+#endif
     // reshape [..., H, W, C] to [N, H, W, C]
     dsize_t num_batch = input->Size() / (input_shape[-3] * input_shape[-2] * input_shape[-1]);
     TensorShape new_shape({num_batch, input_shape[-3], input_shape[-2], input_shape[-1]});
@@ -17,6 +17,7 @@
 #include <random>
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 
 namespace mindspore {
@@ -53,7 +54,11 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
         RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
       }
       std::shared_ptr<Tensor> decoded_tensor = nullptr;
-      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
+      // decode a crop much larger than the target at a reduced scale if it is enabled, the output changes slightly
+      int scale_denom = GlobalContext::config_manager()->enable_jpeg_dct_scaling()
+                          ? GetJpegScaleDenom(crop_width, crop_height, target_width_, target_height_)
+                          : 1;
+      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height, scale_denom));
       RETURN_IF_NOT_OK(Resize(decoded_tensor, &(*output)[i], target_height_, target_width_, 0.0, 0.0, interpolation_));
     }
   }
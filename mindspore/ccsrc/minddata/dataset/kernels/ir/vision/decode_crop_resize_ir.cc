@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/decode_crop_resize_ir.h"
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/decode_crop_resize_op.h"
+#endif
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+#ifndef ENABLE_ANDROID
+// DecodeCropResizeOperation
+DecodeCropResizeOperation::DecodeCropResizeOperation(const std::vector<int32_t> &size,
+                                                     const std::vector<int32_t> &crop_size,
+                                                     InterpolationMode interpolation)
+    : size_(size), crop_size_(crop_size), interpolation_(interpolation) {}
+
+DecodeCropResizeOperation::~DecodeCropResizeOperation() = default;
+
+std::string DecodeCropResizeOperation::Name() const { return kDecodeCropResizeOperation; }
+
+Status DecodeCropResizeOperation::ValidateParams() {
+  RETURN_IF_NOT_OK(ValidateVectorSize("DecodeCropResize", size_));
+  if (!crop_size_.empty()) {
+    RETURN_IF_NOT_OK(ValidateVectorSize("DecodeCropResize", crop_size_));
+  }
+  if (interpolation_ != InterpolationMode::kLinear && interpolation_ != InterpolationMode::kNearestNeighbour &&
+      interpolation_ != InterpolationMode::kCubic && interpolation_ != InterpolationMode::kArea &&
+      interpolation_ != InterpolationMode::kCubicPil) {
+    std::string err_msg = "DecodeCropResize: Invalid InterpolationMode, check input value of enum.";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> DecodeCropResizeOperation::Build() {
+  constexpr size_t dimension_zero = 0;
+  constexpr size_t dimension_one = 1;
+  constexpr size_t size_two = 2;
+
+  int32_t height = size_[dimension_zero];
+  int32_t width = size_.size() == size_two ? size_[dimension_one] : 0;
+  int32_t crop_height = crop_size_.empty() ? 0 : crop_size_[dimension_zero];
+  int32_t crop_width = crop_size_.size() == size_two ? crop_size_[dimension_one] : crop_height;
+
+  return std::make_shared<DecodeCropResizeOp>(height, width, crop_height, crop_width, interpolation_);
+}
+
+Status DecodeCropResizeOperation::to_json(nlohmann::json *out_json) {
+  nlohmann::json args;
+  args["size"] = size_;
+  args["crop_size"] = crop_size_;
+  args["interpolation"] = interpolation_;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status DecodeCropResizeOperation::from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "size", kDecodeCropResizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "crop_size", kDecodeCropResizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "interpolation", kDecodeCropResizeOperation));
+  std::vector<int32_t> size = op_params["size"];
+  std::vector<int32_t> crop_size = op_params["crop_size"];
+  InterpolationMode interpolation = static_cast<InterpolationMode>(op_params["interpolation"]);
+  *operation = std::make_shared<vision::DecodeCropResizeOperation>(size, crop_size, interpolation);
+  return Status::OK();
+}
+
+#endif
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
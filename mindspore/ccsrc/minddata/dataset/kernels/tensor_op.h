@@ -61,7 +61,9 @@ constexpr char kAdjustSaturationOp[] = "AdjustSaturationOp";
 constexpr char kAffineOp[] = "AffineOp";
 constexpr char kAutoAugmentOp[] = "AutoAugmentOp";
 constexpr char kAutoContrastOp[] = "AutoContrastOp";
+constexpr char kBatchedImageOp[] = "BatchedImageOp";
 constexpr char kBoundingBoxAugmentOp[] = "BoundingBoxAugmentOp";
+constexpr char kDecodeCropResizeOp[] = "DecodeCropResizeOp";
 constexpr char kDecodeOp[] = "DecodeOp";
 constexpr char kCenterCropOp[] = "CenterCropOp";
 constexpr char kConvertColorOp[] = "ConvertColorOp";
@@ -123,6 +123,11 @@ void BindShardWriter(py::module *m) {
            THROW_IF_ERROR(s.SetPageSize(page_size));
            return SUCCESS;
          })
+    .def("set_blob_layout",
+         [](ShardWriter &s, const std::string &blob_layout, const std::string &blob_compression) {
+           THROW_IF_ERROR(s.SetBlobLayout(blob_layout, blob_compression));
+           return SUCCESS;
+         })
     .def("set_shard_header",
          [](ShardWriter &s, std::shared_ptr<ShardHeader> header_data) {
            THROW_IF_ERROR(s.SetShardHeader(header_data));
@@ -88,6 +88,18 @@ enum SamplerType { kCustomTopNSampler, kCustomTopPercentSampler, kSubsetRandomSa
 
 enum ShuffleType { kShuffleCategory, kShuffleSample };
 
+// Layout of the blob data of a row. In the columnar layout, a row's blob starts with a directory of its blob columns,
+// followed by the blob columns which are compressed separately, so that the unselected columns are not read.
+enum BlobLayout { kBlobLayoutRow, kBlobLayoutColumnar };
+
+enum BlobCompression { kBlobCompressionNone, kBlobCompressionZlib };
+
+const std::unordered_map<std::string, BlobLayout> kBlobLayoutMap = {{"row", kBlobLayoutRow},
+                                                                    {"columnar", kBlobLayoutColumnar}};
+
+const std::unordered_map<std::string, BlobCompression> kBlobCompressionMap = {{"none", kBlobCompressionNone},
+                                                                              {"zlib", kBlobCompressionZlib}};
+
 const double kEpsilon = 1e-7;
 
 const int kThreadNumber = 14;
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -33,6 +34,7 @@ const uint64_t kNumDataOfByte = 4;
 const uint64_t kBytesOfColumnLen = 4;
 const uint64_t kDataTypeBitMask = 3;
 const uint64_t kDataTypes = 6;
+const uint64_t kColumnarEntryLen = 16;  // stored size and raw size of a blob column in the columnar directory
 
 enum IntegerType { kInt8Type = 0, kInt16Type, kInt32Type, kInt64Type };
 
@@ -77,6 +79,32 @@ class MINDRECORD_API ShardColumn {
   /// \brief check if blob compressed
   bool CheckCompressBlob() const { return has_compress_blob_; }
 
+  /// \brief get the size of the directory at the beginning of a blob in the columnar layout
+  uint64_t GetColumnarDirectorySize() const { return num_blob_column_ * kColumnarEntryLen; }
+
+  /// \brief encode a blob into the columnar layout, each blob column is compressed separately
+  Status EncodeColumnarBlob(const std::vector<uint8_t> &blob, BlobCompression compression,
+                            std::vector<uint8_t> *columnar_blob);
+
+  /// \brief parse the directory of a blob in the columnar layout
+  /// \param[in] directory the directory read from the beginning of the blob
+  /// \param[out] columns the offset in the blob, the stored size and the raw size of each blob column
+  Status ParseColumnarDirectory(const std::vector<uint8_t> &directory,
+                                std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> *columns);
+
+  /// \brief decode the blob columns read from a blob in the columnar layout into a blob in the row layout
+  /// \param[in] columns the stored data of each blob column, empty if the column is not selected
+  /// \param[in] raw_sizes the raw size of each blob column, zero if the column is not selected
+  /// \param[out] blob the blob in the row layout, in which the columns not selected are empty
+  Status DecodeColumnarBlob(const std::vector<std::vector<uint8_t>> &columns, const std::vector<uint64_t> &raw_sizes,
+                            std::vector<uint8_t> *blob);
+
+  /// \brief decode a whole blob in the columnar layout into a blob in the row layout
+  Status DecodeColumnarBlob(const std::vector<uint8_t> &columnar_blob, std::vector<uint8_t> *blob);
+
+  /// \brief get the blob column id of the column, -1 if it is not a blob column
+  int64_t GetBlobColumnId(const std::string &column_name) const;
+
   /// \brief getter
   uint64_t GetNumBlobColumn() const { return num_blob_column_; }
 
@@ -122,6 +150,9 @@ class MINDRECORD_API ShardColumn {
   /// \brief check if column name is available
   ColumnCategory CheckColumnName(const std::string &column_name);
 
+  /// \brief get the offset and the size of each blob column in a blob in the row layout
+  Status SplitBlob(const std::vector<uint8_t> &blob, std::vector<std::pair<uint64_t, uint64_t>> *columns);
+
   /// \brief compress integer column
   static vector<uint8_t> CompressInt(const vector<uint8_t> &src_bytes, const IntegerType &int_type);
 
@@ -124,12 +124,21 @@ class MINDRECORD_API ShardHeader {
 
   uint64_t GetCompressionSize() const { return compression_size_; }
 
+  BlobLayout GetBlobLayout() const { return blob_layout_; }
+
+  BlobCompression GetBlobCompression() const { return blob_compression_; }
+
   void SetHeaderSize(const uint64_t &header_size) { header_size_ = header_size; }
 
   void SetPageSize(const uint64_t &page_size) { page_size_ = page_size; }
 
   void SetCompressionSize(const uint64_t &compression_size) { compression_size_ = compression_size; }
 
+  void SetBlobLayout(BlobLayout blob_layout, BlobCompression blob_compression) {
+    blob_layout_ = blob_layout;
+    blob_compression_ = blob_compression;
+  }
+
   std::vector<std::string> SerializeHeader();
 
   Status PagesToFile(const std::string dump_file_name);
@@ -172,6 +181,8 @@ class MINDRECORD_API ShardHeader {
 
   void ParseShardAddress(const json &address);
 
+  Status ParseBlobLayout(const json &header);
+
   std::string SerializeIndexFields();
 
   std::vector<std::string> SerializePage();
@@ -190,6 +201,8 @@ class MINDRECORD_API ShardHeader {
   uint64_t header_size_;
   uint64_t page_size_;
   uint64_t compression_size_;
+  BlobLayout blob_layout_;
+  BlobCompression blob_compression_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
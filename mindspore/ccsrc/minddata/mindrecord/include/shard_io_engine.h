@@ -0,0 +1,173 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const int kIoQueueDepth = 64;                 // max number of reads in flight
+const int kIoThreadNumber = 8;                // number of threads of the pread fallback
+const uint64_t kIoMaxCoalesceGap = 4096;      // max gap between two reads to be coalesced, 4KB
+const uint64_t kIoMaxCoalesceSize = 1 << 22;  // max size of a coalesced read, 4MB
+
+/// \brief a read of a range of one shard file into the buffer
+struct ShardReadRequest {
+  int shard_id;
+  uint64_t offset;
+  uint64_t size;
+  uint8_t *buffer;
+};
+
+/// \brief accumulated statistics of the reads
+struct ShardIoStatistics {
+  uint64_t read_bytes = 0;     // bytes read from the files
+  uint64_t read_requests = 0;  // number of requests
+  uint64_t read_ops = 0;       // number of reads issued to the files after coalescing
+};
+
+/// \brief ShardIoEngine reads many ranges of the shard files concurrently to keep the disk queue deep. The reads are
+/// submitted to io_uring if the kernel supports it, otherwise they are executed by a thread pool with pread.
+class MINDRECORD_API ShardIoEngine {
+ public:
+  ShardIoEngine() = default;
+
+  ~ShardIoEngine();
+
+  /// \brief open the files and set up the io_uring or the thread pool
+  /// \param[in] file_paths the paths of the shard files, the index is the shard id
+  /// \param[in] queue_depth max number of reads in flight
+  /// \return Status the status of opening
+  Status Open(const std::vector<std::string> &file_paths, int queue_depth = kIoQueueDepth);
+
+  /// \brief close the files and stop the thread pool
+  void Close();
+
+  /// \brief read all the requests and wait for them to finish, the adjacent requests of the same file are coalesced
+  /// \param[in] requests the requests whose buffers are filled
+  /// \return Status the status of reading, error if any of the requests fails
+  Status Read(const std::vector<ShardReadRequest> &requests);
+
+  /// \brief get the accumulated statistics
+  ShardIoStatistics GetStatistics() const;
+
+  /// \brief whether the reads are submitted to io_uring
+  bool IsIoUringEnabled() const { return io_uring_enabled_; }
+
+ private:
+  /// \brief a read issued to the file, which covers one or more requests
+  struct IoOperation {
+    int shard_id;
+    uint64_t offset;
+    uint64_t size;
+    uint8_t *buffer;               // the buffer of the request, or the scratch buffer if coalesced
+    std::vector<uint8_t> scratch;  // the data of coalesced requests which is scattered to their buffers after reading
+    std::vector<ShardReadRequest> requests;
+    uint64_t done = 0;
+  };
+
+  /// \brief sort and coalesce the requests into the operations
+  std::vector<IoOperation> Coalesce(const std::vector<ShardReadRequest> &requests) const;
+
+  /// \brief read the operation by pread until it's finished
+  Status PRead(IoOperation *op) const;
+
+  /// \brief an io_uring and the mapped rings of it, used by one reading thread at a time
+  struct IoUring {
+    int ring_fd = -1;
+    unsigned sq_entries = 0;
+    void *sq_ptr = nullptr;
+    size_t sq_map_size = 0;
+    void *cq_ptr = nullptr;
+    size_t cq_map_size = 0;
+    void *sqes_ptr = nullptr;
+    size_t sqes_map_size = 0;
+    unsigned *sq_head = nullptr;
+    unsigned *sq_tail = nullptr;
+    unsigned *sq_mask = nullptr;
+    unsigned *sq_array = nullptr;
+    unsigned *cq_head = nullptr;
+    unsigned *cq_tail = nullptr;
+    unsigned *cq_mask = nullptr;
+    void *cqes = nullptr;
+  };
+
+  /// \brief set up the io_uring, return false if it is not supported
+  bool SetupIoUring(int queue_depth, IoUring *ring) const;
+
+  /// \brief unmap the rings and close the io_uring
+  void CloseIoUring(IoUring *ring) const;
+
+  /// \brief take a free io_uring, a new one is set up if all of them are used by other threads
+  IoUring *AcquireIoUring();
+
+  /// \brief give the io_uring back for the other reads
+  void ReleaseIoUring(IoUring *ring);
+
+  /// \brief submit the operations to an io_uring of this thread and wait for all of them
+  Status ReadByIoUring(std::vector<IoOperation> *ops);
+
+  /// \brief submit the operations to the io_uring and wait for all of them
+  Status ReadByIoUring(IoUring *ring, std::vector<IoOperation> *ops);
+
+  /// \brief wait for the submitted reads to complete and discard their completions
+  void DrainIoUring(IoUring *ring, size_t in_flight) const;
+
+  /// \brief execute the operations by the thread pool and wait for all of them
+  Status ReadByThreadPool(std::vector<IoOperation> *ops);
+
+  void IoThread();
+
+  std::vector<int> fds_;
+
+  // io_uring, every thread reading at the same time has its own one, so the reads of the threads are not serialized
+  bool io_uring_enabled_ = false;
+  int queue_depth_ = kIoQueueDepth;
+  std::vector<std::unique_ptr<IoUring>> rings_;
+  std::vector<IoUring *> free_rings_;
+  std::mutex ring_mutex_;
+  std::condition_variable ring_cv_;
+
+  // thread pool of pread
+  std::vector<std::thread> io_threads_;
+  std::deque<std::function<void()>> io_jobs_;
+  std::mutex io_mutex_;
+  std::condition_variable io_cv_;
+  bool io_stop_ = false;
+
+  std::atomic<uint64_t> read_bytes_{0};
+  std::atomic<uint64_t> read_requests_{0};
+  std::atomic<uint64_t> read_ops_{0};
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
@@ -47,6 +47,7 @@
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_io_engine.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -58,7 +59,9 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
-const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+const int kNumBatchInMap = 1000;                          // iterator buffer size in row-reader mode
+const int kNumPrefetchTask = 32;                          // number of tasks whose blobs are read together by the io engine
+const uint64_t kMaxPrefetchBytes = 256ULL * 1024 * 1024;  // max bytes of prefetched blobs which are not consumed yet
 
 class MINDRECORD_API ShardReader {
  public:
@@ -196,6 +199,10 @@ class MINDRECORD_API ShardReader {
   /// \brief get the size of blob data
   Status GetTotalBlobSize(int64_t *total_blob_size);
 
+  /// \brief get the statistics of the blob reads
+  /// \return the accumulated statistics, all zero if the io engine is not used
+  ShardIoStatistics GetIoStatistics() const;
+
   /// \brief extract uncompressed data based on column list
   Status UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                         std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr);
@@ -282,6 +289,24 @@ class MINDRECORD_API ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief read the blob of one task by the io engine, the blobs of the next tasks in the sample order are prefetched
+  Status ReadBlobByIoEngine(int64_t task_id, uint32_t shard_id, uint64_t file_offset, uint64_t size,
+                            std::vector<uint8_t> *blob);
+
+  /// \brief read a range of a shard file by the file stream of the consumer
+  Status ReadByFileStream(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t size,
+                          uint8_t *buffer);
+
+  /// \brief read the selected blob columns of a blob in the columnar layout whose directory is already read
+  Status ReadColumnarBlob(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                          std::vector<uint8_t> *blob);
+
+  /// \brief get the range of the blob of a task to read, false if it is not known without reading the index
+  bool GetTaskBlobRange(int64_t task_id, ShardReadRequest *request);
+
+  /// \brief drop the prefetched blobs and index the positions of the tasks after the sample order changes
+  void ResetPrefetch();
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
@@ -313,6 +338,7 @@ class MINDRECORD_API ShardReader {
  private:
   int n_consumer_;                                         // number of workers (threads)
   std::vector<std::string> selected_columns_;              // columns which will be read
+  std::vector<bool> selected_blob_columns_;                // blob columns which will be read, empty if all
   std::map<string, uint64_t> column_schema_id_;            // column-schema map
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // data operators, including shuffle, sample and category
   ShardTaskList tasks_;                                    // shard task list
@@ -341,6 +367,16 @@ class MINDRECORD_API ShardReader {
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
+  // Prefetch mode begin
+  std::unique_ptr<ShardIoEngine> io_engine_;  // reads the blobs with many reads in flight, null if not available
+  std::vector<int64_t> sample_positions_;     // position of the task in the sample ids, -1 if not sampled
+  std::unordered_map<int64_t, std::vector<uint8_t>> prefetch_blobs_;  // blobs read ahead, keyed by task id
+  std::unordered_set<int64_t> prefetch_pending_;                      // tasks whose blobs are being read
+  uint64_t prefetch_bytes_ = 0;                                       // total size of the blobs read ahead
+  std::mutex mtx_prefetch_;                                           // locker for prefetch
+  std::condition_variable cv_prefetch_;                               // conditional variable for prefetch
+  // Prefetch mode end
+
   // indicate shard_id : inc_count
   // 0 : 15  -  shard0 has 15 samples
   // 1 : 41  -  shard1 has 26 samples
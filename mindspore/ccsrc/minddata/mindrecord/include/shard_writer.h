@@ -80,6 +80,12 @@ class MINDRECORD_API ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   Status SetPageSize(const uint64_t &page_size);
 
+  /// \brief Set the layout of blob data, called before writing data to empty files
+  /// \param[in] blob_layout "row" or "columnar", in the columnar layout the blob columns are stored and read separately
+  /// \param[in] blob_compression "none" or "zlib", the compression of each blob column in the columnar layout
+  /// \return MSRStatus the status of MSRStatus
+  Status SetBlobLayout(const std::string &blob_layout, const std::string &blob_compression);
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -238,11 +244,13 @@ class MINDRECORD_API ShardWriter {
   std::string lock_file_;   // lock file for parallel run
   std::string pages_file_;  // temporary file of pages info for parallel run
 
-  int shard_count_;        // number of files
-  uint64_t header_size_;   // header size
-  uint64_t page_size_;     // page size
-  uint32_t row_count_;     // count of rows
-  uint32_t schema_count_;  // count of schemas
+  int shard_count_;                   // number of files
+  uint64_t header_size_;              // header size
+  uint64_t page_size_;                // page size
+  BlobLayout blob_layout_;            // layout of blob data
+  BlobCompression blob_compression_;  // compression of blob columns in the columnar layout
+  uint32_t row_count_;                // count of rows
+  uint32_t schema_count_;             // count of schemas
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
@@ -0,0 +1,497 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_io_engine.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define MINDRECORD_ENABLE_IO_URING
+#endif
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace mindrecord {
+ShardIoEngine::~ShardIoEngine() { Close(); }
+
+#if !defined(_WIN32) && !defined(_WIN64)
+Status ShardIoEngine::Open(const std::vector<std::string> &file_paths, int queue_depth) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(queue_depth > 0,
+                                  "[Internal ERROR] 'queue_depth' should be positive, but got: " +
+                                    std::to_string(queue_depth));
+  Close();
+  for (const auto &file : file_paths) {
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      Close();
+      RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to open file for io engine: " + file +
+                                  ", errno: " + std::to_string(errno));
+    }
+    fds_.push_back(fd);
+  }
+
+  auto ring = std::make_unique<IoUring>();
+  if (SetupIoUring(queue_depth, ring.get())) {
+    MS_LOG(INFO) << "The io engine of mindrecord reads files by io_uring, queue depth: " << ring->sq_entries;
+    queue_depth_ = queue_depth;
+    free_rings_.push_back(ring.get());
+    rings_.push_back(std::move(ring));
+    io_uring_enabled_ = true;
+    return Status::OK();
+  }
+
+  // The io_uring is not available, e.g. the kernel is too old or it's forbidden by seccomp, use the pread instead.
+  io_stop_ = false;
+  int thread_num = std::min(queue_depth, kIoThreadNumber);
+  for (int i = 0; i < thread_num; ++i) {
+    io_threads_.emplace_back(&ShardIoEngine::IoThread, this);
+  }
+  MS_LOG(INFO) << "The io engine of mindrecord reads files by pread in " << thread_num << " threads.";
+  return Status::OK();
+}
+
+void ShardIoEngine::Close() {
+  {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    io_stop_ = true;
+  }
+  io_cv_.notify_all();
+  for (auto &thread : io_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  io_threads_.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    for (auto &ring : rings_) {
+      CloseIoUring(ring.get());
+    }
+    rings_.clear();
+    free_rings_.clear();
+    io_uring_enabled_ = false;
+  }
+  for (int fd : fds_) {
+    (void)close(fd);
+  }
+  fds_.clear();
+}
+
+Status ShardIoEngine::Read(const std::vector<ShardReadRequest> &requests) {
+  for (const auto &request : requests) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(request.shard_id >= 0 && request.shard_id < static_cast<int>(fds_.size()),
+                                    "[Internal ERROR] Invalid shard id of read request: " +
+                                      std::to_string(request.shard_id));
+    RETURN_UNEXPECTED_IF_NULL_MR(request.buffer);
+  }
+  auto ops = Coalesce(requests);
+  if (ops.empty()) {
+    return Status::OK();
+  }
+
+  Status status = IsIoUringEnabled() ? ReadByIoUring(&ops) : ReadByThreadPool(&ops);
+  RETURN_IF_NOT_OK_MR(status);
+
+  // Scatter the data of coalesced operations to the buffers of the requests.
+  for (auto &op : ops) {
+    if (op.scratch.empty()) {
+      continue;
+    }
+    for (const auto &request : op.requests) {
+      auto ret = memcpy_s(request.buffer, request.size, op.scratch.data() + (request.offset - op.offset), request.size);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == EOK, "[Internal ERROR] Failed to copy the coalesced data, errno: " +
+                                                    std::to_string(ret));
+    }
+  }
+  read_requests_ += requests.size();
+  read_ops_ += ops.size();
+  return Status::OK();
+}
+
+std::vector<ShardIoEngine::IoOperation> ShardIoEngine::Coalesce(const std::vector<ShardReadRequest> &requests) const {
+  std::vector<ShardReadRequest> sorted;
+  std::copy_if(requests.begin(), requests.end(), std::back_inserter(sorted),
+               [](const ShardReadRequest &request) { return request.size > 0; });
+  std::sort(sorted.begin(), sorted.end(), [](const ShardReadRequest &lhs, const ShardReadRequest &rhs) {
+    return lhs.shard_id != rhs.shard_id ? lhs.shard_id < rhs.shard_id : lhs.offset < rhs.offset;
+  });
+
+  std::vector<IoOperation> ops;
+  size_t i = 0;
+  while (i < sorted.size()) {
+    // Extend the range while the next request is in the same file and close enough to the end of the range.
+    size_t j = i + 1;
+    uint64_t end = sorted[i].offset + sorted[i].size;
+    while (j < sorted.size() && sorted[j].shard_id == sorted[i].shard_id && sorted[j].offset >= sorted[i].offset &&
+           sorted[j].offset <= end + kIoMaxCoalesceGap &&
+           std::max(end, sorted[j].offset + sorted[j].size) - sorted[i].offset <= kIoMaxCoalesceSize) {
+      end = std::max(end, sorted[j].offset + sorted[j].size);
+      ++j;
+    }
+
+    IoOperation op;
+    op.shard_id = sorted[i].shard_id;
+    op.offset = sorted[i].offset;
+    op.size = end - sorted[i].offset;
+    op.requests.assign(sorted.begin() + i, sorted.begin() + j);
+    ops.push_back(std::move(op));
+    i = j;
+  }
+
+  // The single request is read to its buffer directly, the coalesced requests are read to the scratch buffer.
+  for (auto &op : ops) {
+    if (op.requests.size() == 1) {
+      op.buffer = op.requests[0].buffer;
+    } else {
+      op.scratch.resize(op.size);
+      op.buffer = op.scratch.data();
+    }
+  }
+  return ops;
+}
+
+Status ShardIoEngine::PRead(IoOperation *op) const {
+  while (op->done < op->size) {
+    auto ret = pread(fds_[op->shard_id], op->buffer + op->done, op->size - op->done,
+                     static_cast<off_t>(op->offset + op->done));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret > 0, "[Internal ERROR] Failed to read file of shard " +
+                                               std::to_string(op->shard_id) + ", offset: " +
+                                               std::to_string(op->offset + op->done) + ", errno: " +
+                                               std::to_string(ret < 0 ? errno : 0));
+    op->done += static_cast<uint64_t>(ret);
+  }
+  return Status::OK();
+}
+
+Status ShardIoEngine::ReadByThreadPool(std::vector<IoOperation> *ops) {
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  size_t pending = ops->size();
+  Status status = Status::OK();
+  {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(!io_stop_, "[Internal ERROR] The io engine is closed.");
+    for (auto &op : *ops) {
+      io_jobs_.emplace_back([this, &op, &done_mutex, &done_cv, &pending, &status]() {
+        auto rc = PRead(&op);
+        std::lock_guard<std::mutex> done_lock(done_mutex);
+        if (rc.IsError()) {
+          status = rc;
+        } else {
+          read_bytes_ += op.size;
+        }
+        if (--pending == 0) {
+          done_cv.notify_one();
+        }
+      });
+    }
+  }
+  io_cv_.notify_all();
+
+  std::unique_lock<std::mutex> done_lock(done_mutex);
+  done_cv.wait(done_lock, [&pending]() { return pending == 0; });
+  return status;
+}
+
+void ShardIoEngine::IoThread() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(io_mutex_);
+      io_cv_.wait(lock, [this]() { return io_stop_ || !io_jobs_.empty(); });
+      // The pending jobs are finished before exiting since their callers are waiting for them.
+      if (io_jobs_.empty()) {
+        return;
+      }
+      job = std::move(io_jobs_.front());
+      io_jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+ShardIoStatistics ShardIoEngine::GetStatistics() const {
+  ShardIoStatistics statistics;
+  statistics.read_bytes = read_bytes_.load();
+  statistics.read_requests = read_requests_.load();
+  statistics.read_ops = read_ops_.load();
+  return statistics;
+}
+#else
+Status ShardIoEngine::Open(const std::vector<std::string> &file_paths, int queue_depth) {
+  RETURN_STATUS_UNEXPECTED_MR("The io engine of mindrecord is not supported on Windows.");
+}
+
+void ShardIoEngine::Close() {}
+
+Status ShardIoEngine::Read(const std::vector<ShardReadRequest> &requests) {
+  RETURN_STATUS_UNEXPECTED_MR("The io engine of mindrecord is not supported on Windows.");
+}
+
+ShardIoStatistics ShardIoEngine::GetStatistics() const { return ShardIoStatistics(); }
+#endif
+
+#ifdef MINDRECORD_ENABLE_IO_URING
+bool ShardIoEngine::SetupIoUring(int queue_depth, IoUring *ring) const {
+  struct io_uring_params params;
+  (void)memset_s(&params, sizeof(params), 0, sizeof(params));
+  int fd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth), &params));
+  if (fd < 0) {
+    MS_LOG(INFO) << "The io_uring is not available, errno: " << errno;
+    return false;
+  }
+  ring->ring_fd = fd;
+  ring->sq_entries = params.sq_entries;
+
+  ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring->sq_map_size = std::max(ring->sq_map_size, ring->cq_map_size);
+    ring->cq_map_size = ring->sq_map_size;
+  }
+  ring->sq_ptr =
+    mmap(nullptr, ring->sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ptr == MAP_FAILED) {
+    ring->sq_ptr = nullptr;
+    CloseIoUring(ring);
+    return false;
+  }
+  if (single_mmap) {
+    ring->cq_ptr = ring->sq_ptr;
+  } else {
+    ring->cq_ptr =
+      mmap(nullptr, ring->cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ptr == MAP_FAILED) {
+      ring->cq_ptr = nullptr;
+      CloseIoUring(ring);
+      return false;
+    }
+  }
+  ring->sqes_map_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes_ptr =
+    mmap(nullptr, ring->sqes_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (ring->sqes_ptr == MAP_FAILED) {
+    ring->sqes_ptr = nullptr;
+    CloseIoUring(ring);
+    return false;
+  }
+
+  auto sq_base = static_cast<uint8_t *>(ring->sq_ptr);
+  auto cq_base = static_cast<uint8_t *>(ring->cq_ptr);
+  ring->sq_head = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+  ring->sq_tail = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+  ring->sq_mask = reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+  ring->sq_array = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+  ring->cq_head = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+  ring->cq_tail = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+  ring->cq_mask = reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+  ring->cqes = cq_base + params.cq_off.cqes;
+  return true;
+}
+
+void ShardIoEngine::CloseIoUring(IoUring *ring) const {
+  if (ring->sqes_ptr != nullptr) {
+    (void)munmap(ring->sqes_ptr, ring->sqes_map_size);
+    ring->sqes_ptr = nullptr;
+  }
+  if (ring->cq_ptr != nullptr && ring->cq_ptr != ring->sq_ptr) {
+    (void)munmap(ring->cq_ptr, ring->cq_map_size);
+  }
+  ring->cq_ptr = nullptr;
+  if (ring->sq_ptr != nullptr) {
+    (void)munmap(ring->sq_ptr, ring->sq_map_size);
+    ring->sq_ptr = nullptr;
+  }
+  if (ring->ring_fd >= 0) {
+    (void)close(ring->ring_fd);
+    ring->ring_fd = -1;
+  }
+}
+
+ShardIoEngine::IoUring *ShardIoEngine::AcquireIoUring() {
+  std::unique_lock<std::mutex> lock(ring_mutex_);
+  if (free_rings_.empty()) {
+    auto ring = std::make_unique<IoUring>();
+    if (SetupIoUring(queue_depth_, ring.get())) {
+      rings_.push_back(std::move(ring));
+      return rings_.back().get();
+    }
+    // No more io_uring can be set up, e.g. the limit of locked memory is reached, wait for one of the other threads.
+    ring_cv_.wait(lock, [this]() { return !free_rings_.empty(); });
+  }
+  auto ring = free_rings_.back();
+  free_rings_.pop_back();
+  return ring;
+}
+
+void ShardIoEngine::ReleaseIoUring(IoUring *ring) {
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    free_rings_.push_back(ring);
+  }
+  ring_cv_.notify_one();
+}
+
+Status ShardIoEngine::ReadByIoUring(std::vector<IoOperation> *ops) {
+  auto ring = AcquireIoUring();
+  auto status = ReadByIoUring(ring, ops);
+  ReleaseIoUring(ring);
+  return status;
+}
+
+void ShardIoEngine::DrainIoUring(IoUring *ring, size_t in_flight) const {
+  while (in_flight > 0) {
+    (void)syscall(__NR_io_uring_enter, ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    unsigned head = *ring->cq_head;
+    while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE) && in_flight > 0) {
+      ++head;
+      --in_flight;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+  }
+}
+
+Status ShardIoEngine::ReadByIoUring(IoUring *ring, std::vector<IoOperation> *ops) {
+  RETURN_UNEXPECTED_IF_NULL_MR(ring);
+  auto sqes = static_cast<struct io_uring_sqe *>(ring->sqes_ptr);
+  auto cqes = static_cast<struct io_uring_cqe *>(ring->cqes);
+  std::vector<struct iovec> iovecs(ops->size());
+
+  size_t next = 0;
+  size_t in_flight = 0;
+  size_t finished = 0;
+  std::vector<size_t> retry;
+  while (finished < ops->size()) {
+    // Fill the submission queue with the operations to retry and the new ones.
+    unsigned tail = *ring->sq_tail;
+    while (in_flight < ring->sq_entries && (!retry.empty() || next < ops->size())) {
+      size_t index = next;
+      if (!retry.empty()) {
+        index = retry.back();
+        retry.pop_back();
+      } else {
+        ++next;
+      }
+      auto &op = (*ops)[index];
+      iovecs[index].iov_base = op.buffer + op.done;
+      iovecs[index].iov_len = op.size - op.done;
+
+      unsigned sq_index = tail & *ring->sq_mask;
+      struct io_uring_sqe *sqe = &sqes[sq_index];
+      (void)memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_READV;
+      sqe->fd = fds_[op.shard_id];
+      sqe->off = op.offset + op.done;
+      sqe->addr = reinterpret_cast<uint64_t>(&iovecs[index]);
+      sqe->len = 1;
+      sqe->user_data = index;
+      ring->sq_array[sq_index] = sq_index;
+      ++tail;
+      ++in_flight;
+    }
+    // Publish the entries before the kernel reads the tail. The entries not consumed by the last interrupted submission
+    // are submitted again.
+    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+    unsigned to_submit = tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+
+    long ret = syscall(__NR_io_uring_enter, ring->ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      int err = errno;
+      // Withdraw the entries the kernel has not consumed, then wait for the submitted ones to finish writing to the
+      // buffers which are released after returning.
+      unsigned sq_head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+      in_flight -= tail - sq_head;
+      __atomic_store_n(ring->sq_tail, sq_head, __ATOMIC_RELEASE);
+      DrainIoUring(ring, in_flight);
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to submit reads to io_uring, errno: " + std::to_string(err));
+    }
+
+    // Reap the completions.
+    unsigned head = *ring->cq_head;
+    while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+      const struct io_uring_cqe &cqe = cqes[head & *ring->cq_mask];
+      size_t index = static_cast<size_t>(cqe.user_data);
+      int res = cqe.res;
+      ++head;
+      --in_flight;
+      auto &op = (*ops)[index];
+      if (res == -EINTR || res == -EAGAIN) {
+        retry.push_back(index);
+        continue;
+      }
+      if (res <= 0) {
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        // Drain the reads in flight since their buffers are released after returning.
+        DrainIoUring(ring, in_flight);
+        RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file of shard " + std::to_string(op.shard_id) +
+                                    " by io_uring, offset: " + std::to_string(op.offset + op.done) +
+                                    ", result: " + std::to_string(res));
+      }
+      op.done += static_cast<uint64_t>(res);
+      read_bytes_ += static_cast<uint64_t>(res);
+      if (op.done < op.size) {
+        // Short read, submit the rest again.
+        retry.push_back(index);
+      } else {
+        ++finished;
+      }
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+  }
+  return Status::OK();
+}
+#else
+bool ShardIoEngine::SetupIoUring(int queue_depth, IoUring *ring) const { return false; }
+
+void ShardIoEngine::CloseIoUring(IoUring *ring) const {}
+
+ShardIoEngine::IoUring *ShardIoEngine::AcquireIoUring() { return nullptr; }
+
+void ShardIoEngine::ReleaseIoUring(IoUring *ring) {}
+
+Status ShardIoEngine::ReadByIoUring(std::vector<IoOperation> *ops) {
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] The io_uring is not supported.");
+}
+
+Status ShardIoEngine::ReadByIoUring(IoUring *ring, std::vector<IoOperation> *ops) {
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] The io_uring is not supported.");
+}
+
+void ShardIoEngine::DrainIoUring(IoUring *ring, size_t in_flight) const {}
+#endif
+}  // namespace mindrecord
+}  // namespace mindspore
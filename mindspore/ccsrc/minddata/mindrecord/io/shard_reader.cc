@@ -212,6 +212,14 @@ Status ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Succeed to open file, path: " << file;
   }
+
+  // The blobs are read by the io engine if it's available, otherwise by the file streams above.
+  io_engine_ = std::make_unique<ShardIoEngine>();
+  auto status = io_engine_->Open(file_paths_);
+  if (status.IsError()) {
+    MS_LOG(WARNING) << "Failed to open the io engine, the blobs are read by file streams. " << status.ToString();
+    io_engine_.reset();
+  }
   return Status::OK();
 }
 
@@ -335,6 +343,9 @@ void ShardReader::Close() {
   }
 
   FileStreamsOperator();
+  if (io_engine_ != nullptr) {
+    io_engine_->Close();
+  }
 }
 
 std::shared_ptr<ShardHeader> ShardReader::GetShardHeader() const { return shard_header_; }
@@ -1093,6 +1104,16 @@ Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_d
 
   selected_columns_ = selected_columns;
   RETURN_IF_NOT_OK_MR(CheckColumnList(selected_columns_));
+  selected_blob_columns_.clear();
+  if (!selected_columns_.empty()) {
+    selected_blob_columns_.assign(shard_column_->GetNumBlobColumn(), false);
+    for (const auto &column : selected_columns_) {
+      auto blob_column_id = shard_column_->GetBlobColumnId(column);
+      if (blob_column_id >= 0) {
+        selected_blob_columns_[blob_column_id] = true;
+      }
+    }
+  }
 
   // Initialize argument
   shard_count_ = static_cast<int>(file_paths_.size());
@@ -1115,6 +1136,7 @@ Status ShardReader::Launch(bool is_sample_read) {
     interrupt_ = true;
     return status;
   }
+  ResetPrefetch();
   if (is_sample_read) {
     return Status::OK();
   }
@@ -1383,30 +1405,196 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
   RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
+  // Pack image list, only the directory of a blob in the columnar layout is read before the selected blob columns
+  uint64_t blob_size = blob_end - blob_start;
+  bool is_columnar = shard_header_->GetBlobLayout() == kBlobLayoutColumnar && blob_size > 0;
+  std::vector<uint8_t> images(is_columnar ? std::min(blob_size, shard_column_->GetColumnarDirectorySize()) : blob_size);
   auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
 
+  if (io_engine_ != nullptr) {
+    if (!images.empty()) {
+      RETURN_IF_NOT_OK_MR(ReadBlobByIoEngine(task_id, shard_id, file_offset, images.size(), &images));
+    }
+  } else {
+    RETURN_IF_NOT_OK_MR(ReadByFileStream(consumer_id, shard_id, file_offset, images.size(), images.data()));
+  }
+  if (is_columnar) {
+    RETURN_IF_NOT_OK_MR(ReadColumnarBlob(consumer_id, shard_id, file_offset, blob_size, &images));
+  }
+
+  // Deliver batch data to output map
+  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+  batch.emplace_back(std::move(images), std::move(var_fields));
+
+  *task_content_ptr = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::move(batch));
+  return Status::OK();
+}
+
+Status ShardReader::ReadByFileStream(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t size,
+                                     uint8_t *buffer) {
   auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+  auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(buffer), size);
   if (!io_read.good() || io_read.fail() || io_read.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
   }
+  return Status::OK();
+}
 
-  // Deliver batch data to output map
-  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(var_fields));
+Status ShardReader::ReadColumnarBlob(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                                     std::vector<uint8_t> *blob) {
+  RETURN_UNEXPECTED_IF_NULL_MR(blob);
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> directory;
+  RETURN_IF_NOT_OK_MR(shard_column_->ParseColumnarDirectory(*blob, &directory));
+
+  // Read the selected blob columns only, the others are left empty
+  std::vector<std::vector<uint8_t>> columns(directory.size());
+  std::vector<uint64_t> raw_sizes(directory.size(), 0);
+  std::vector<ShardReadRequest> requests;
+  for (size_t i = 0; i < directory.size(); ++i) {
+    if (!selected_blob_columns_.empty() && !selected_blob_columns_[i]) {
+      continue;
+    }
+    auto offset = std::get<0>(directory[i]);
+    auto stored_size = std::get<1>(directory[i]);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(offset + stored_size <= blob_size,
+                                    "Invalid data, the blob column exceeds the blob of the sample in shard: " +
+                                      std::to_string(shard_id));
+    raw_sizes[i] = std::get<2>(directory[i]);
+    if (stored_size == 0) {
+      continue;
+    }
+    columns[i].resize(stored_size);
+    requests.push_back({static_cast<int>(shard_id), file_offset + offset, stored_size, columns[i].data()});
+  }
 
-  *task_content_ptr = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::move(batch));
+  if (io_engine_ != nullptr) {
+    if (!requests.empty()) {
+      RETURN_IF_NOT_OK_MR(io_engine_->Read(requests));
+    }
+  } else {
+    for (const auto &request : requests) {
+      RETURN_IF_NOT_OK_MR(ReadByFileStream(consumer_id, shard_id, request.offset, request.size, request.buffer));
+    }
+  }
+  return shard_column_->DecodeColumnarBlob(columns, raw_sizes, blob);
+}
+
+Status ShardReader::ReadBlobByIoEngine(int64_t task_id, uint32_t shard_id, uint64_t file_offset, uint64_t size,
+                                       std::vector<uint8_t> *blob) {
+  RETURN_UNEXPECTED_IF_NULL_MR(blob);
+  std::vector<int64_t> task_ids = {task_id};
+  std::vector<ShardReadRequest> requests = {{static_cast<int>(shard_id), file_offset, size, nullptr}};
+  {
+    std::unique_lock<std::mutex> lck(mtx_prefetch_);
+    // Wait if the blob is being read by another consumer
+    cv_prefetch_.wait(lck, [task_id, this] { return prefetch_pending_.count(task_id) == 0; });
+    auto iter = prefetch_blobs_.find(task_id);
+    if (iter != prefetch_blobs_.end()) {
+      prefetch_bytes_ -= iter->second.size();
+      *blob = std::move(iter->second);
+      (void)prefetch_blobs_.erase(iter);
+      return Status::OK();
+    }
+    (void)prefetch_pending_.insert(task_id);
+
+    // Read ahead the blobs of the next tasks in the sample order, so that many reads are in flight and the adjacent
+    // blobs are coalesced by the io engine. The blobs read ahead are bounded by bytes since their sizes vary widely.
+    if (task_id >= 0 && task_id < static_cast<int64_t>(sample_positions_.size()) && sample_positions_[task_id] >= 0) {
+      const auto &sample_ids = tasks_.sample_ids_;
+      uint64_t prefetch_bytes = prefetch_bytes_;
+      for (size_t pos = static_cast<size_t>(sample_positions_[task_id]) + 1;
+           pos < sample_ids.size() && task_ids.size() < kNumPrefetchTask; ++pos) {
+        int64_t next_id = sample_ids[pos];
+        ShardReadRequest request;
+        if (prefetch_blobs_.count(next_id) > 0 || prefetch_pending_.count(next_id) > 0 ||
+            !GetTaskBlobRange(next_id, &request)) {
+          continue;
+        }
+        if (prefetch_bytes + request.size > kMaxPrefetchBytes) {
+          break;
+        }
+        prefetch_bytes += request.size;
+        (void)prefetch_pending_.insert(next_id);
+        task_ids.push_back(next_id);
+        requests.push_back(request);
+      }
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> blobs(requests.size());
+  blobs[0] = std::move(*blob);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    blobs[i].resize(requests[i].size);
+    requests[i].buffer = blobs[i].data();
+  }
+  auto status = io_engine_->Read(requests);
+
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    for (size_t i = 0; i < task_ids.size(); ++i) {
+      if (i > 0 && status.IsOk()) {
+        auto &prefetch_blob = prefetch_blobs_[task_ids[i]];
+        prefetch_bytes_ = prefetch_bytes_ - prefetch_blob.size() + blobs[i].size();
+        prefetch_blob = std::move(blobs[i]);
+      }
+      (void)prefetch_pending_.erase(task_ids[i]);
+    }
+  }
+  cv_prefetch_.notify_all();
+  RETURN_IF_NOT_OK_MR(status);
+  *blob = std::move(blobs[0]);
   return Status::OK();
 }
 
+bool ShardReader::GetTaskBlobRange(int64_t task_id, ShardReadRequest *request) {
+  // The blob range of the lazy loaded task is in the index which is read by its consumer
+  if (lazy_load_ || task_id < 0 || task_id >= tasks_.Size()) {
+    return false;
+  }
+  const ShardTask &task = tasks_.GetTaskByID(task_id);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return false;
+  }
+  auto shard_id = std::get<0>(std::get<1>(task));
+  auto group_id = std::get<1>(std::get<1>(task));
+  auto blob_start = std::get<2>(task)[0];
+  auto blob_end = std::get<2>(task)[1];
+  if (blob_end <= blob_start) {
+    return false;
+  }
+  std::shared_ptr<Page> page_ptr;
+  if (shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr).IsError()) {
+    return false;
+  }
+  request->shard_id = shard_id;
+  request->offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  request->size = blob_end - blob_start;
+  if (shard_header_->GetBlobLayout() == kBlobLayoutColumnar) {
+    // Only the directory of a blob in the columnar layout is prefetched, the selected columns are read by it
+    request->size = std::min(request->size, shard_column_->GetColumnarDirectorySize());
+  }
+  request->buffer = nullptr;
+  return true;
+}
+
+void ShardReader::ResetPrefetch() {
+  std::lock_guard<std::mutex> lck(mtx_prefetch_);
+  prefetch_blobs_.clear();
+  prefetch_bytes_ = 0;
+  sample_positions_.assign(static_cast<size_t>(tasks_.Size()), -1);
+  for (size_t pos = 0; pos < tasks_.sample_ids_.size(); ++pos) {
+    int64_t task_id = tasks_.sample_ids_[pos];
+    if (task_id >= 0 && task_id < tasks_.Size() && sample_positions_[task_id] < 0) {
+      sample_positions_[task_id] = static_cast<int64_t>(pos);
+    }
+  }
+}
+
 void ShardReader::ConsumerByRow(int consumer_id) {
   // Set thread name
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
@@ -1542,6 +1730,11 @@ void ShardReader::ShuffleTask() {
   if (tasks_.permutation_.empty()) {
     tasks_.MakePerm();
   }
+  ResetPrefetch();
+}
+
+ShardIoStatistics ShardReader::GetIoStatistics() const {
+  return io_engine_ == nullptr ? ShardIoStatistics() : io_engine_->GetStatistics();
 }
 
 const std::vector<int64_t> *ShardReader::GetSampleIds() {
@@ -215,6 +215,9 @@ Status ShardSegment::PackImages(int group_id, int shard_id, std::vector<uint64_t
     file_streams_random_[0][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("Failed to read file.");
   }
+  if (shard_header_->GetBlobLayout() == kBlobLayoutColumnar && !(*images_ptr)->empty()) {
+    RETURN_IF_NOT_OK_MR(shard_column_->DecodeColumnarBlob(**images_ptr, images_ptr->get()));
+  }
   return Status::OK();
 }
 
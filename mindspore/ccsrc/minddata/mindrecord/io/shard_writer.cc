@@ -23,7 +23,13 @@
 namespace mindspore {
 namespace mindrecord {
 ShardWriter::ShardWriter()
-    : shard_count_(1), header_size_(kDefaultHeaderSize), page_size_(kDefaultPageSize), row_count_(0), schema_count_(1) {
+    : shard_count_(1),
+      header_size_(kDefaultHeaderSize),
+      page_size_(kDefaultPageSize),
+      blob_layout_(kBlobLayoutRow),
+      blob_compression_(kBlobCompressionNone),
+      row_count_(0),
+      schema_count_(1) {
   compression_size_ = 0;
 }
 
@@ -187,6 +193,8 @@ Status ShardWriter::OpenForAppend(const std::string &path) {
   RETURN_IF_NOT_OK_MR(SetHeaderSize(shard_header_->GetHeaderSize()));
   RETURN_IF_NOT_OK_MR(SetPageSize(shard_header_->GetPageSize()));
   compression_size_ = shard_header_->GetCompressionSize();
+  blob_layout_ = shard_header_->GetBlobLayout();
+  blob_compression_ = shard_header_->GetBlobCompression();
   RETURN_IF_NOT_OK_MR(Open(*ds, true));
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
   return Status::OK();
@@ -238,6 +246,7 @@ Status ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data) {
   shard_header_ = header_data;
   shard_header_->SetHeaderSize(header_size_);
   shard_header_->SetPageSize(page_size_);
+  shard_header_->SetBlobLayout(blob_layout_, blob_compression_);
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
   return Status::OK();
 }
@@ -266,6 +275,26 @@ Status ShardWriter::SetPageSize(const uint64_t &page_size) {
   return Status::OK();
 }
 
+Status ShardWriter::SetBlobLayout(const std::string &blob_layout, const std::string &blob_compression) {
+  auto layout = kBlobLayoutMap.find(blob_layout);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(layout != kBlobLayoutMap.end(),
+                                  "Invalid data, blob layout: " + blob_layout + " should be 'row' or 'columnar'.");
+  auto compression = kBlobCompressionMap.find(blob_compression);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(compression != kBlobCompressionMap.end(),
+                                  "Invalid data, blob compression: " + blob_compression +
+                                    " should be 'none' or 'zlib'.");
+#ifndef ENABLE_MINDRECORD_ZLIB
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(compression->second == kBlobCompressionNone,
+                                  "Invalid data, blob compression: " + blob_compression + " is not supported.");
+#endif
+  blob_layout_ = layout->second;
+  blob_compression_ = compression->second;
+  if (shard_header_ != nullptr) {
+    shard_header_->SetBlobLayout(blob_layout_, blob_compression_);
+  }
+  return Status::OK();
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -570,6 +599,15 @@ Status ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &
       compression_size_ += compression_bytes;
     }
   }
+  // store the blob columns separately, so that they can be read and uncompressed one by one
+  if (blob_layout_ == kBlobLayoutColumnar && shard_column_->GetNumBlobColumn() > 0) {
+    std::vector<uint8_t> columnar_blob;
+    for (auto &blob : blob_data) {
+      RETURN_IF_NOT_OK_MR(shard_column_->EncodeColumnarBlob(blob, blob_compression_, &columnar_blob));
+      compression_size_ += static_cast<int64_t>(blob.size()) - static_cast<int64_t>(columnar_blob.size());
+      blob.swap(columnar_blob);
+    }
+  }
 
   // Add 4-bytes dummy blob data if no any blob fields
   if (blob_data.size() == 0 && raw_data.size() > 0) {
@@ -16,12 +16,58 @@
 
 #include "minddata/mindrecord/include/shard_column.h"
 
+#ifdef ENABLE_MINDRECORD_ZLIB
+#include <zlib.h>
+#endif
+
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_error.h"
 
 namespace mindspore {
 namespace mindrecord {
+namespace {
+Status CompressColumn(const uint8_t *src, uint64_t size, BlobCompression compression, std::vector<uint8_t> *dst) {
+  if (compression == kBlobCompressionNone || size == 0) {
+    dst->assign(src, src + size);
+    return Status::OK();
+  }
+#ifdef ENABLE_MINDRECORD_ZLIB
+  uLongf dst_size = compressBound(static_cast<uLong>(size));
+  dst->resize(dst_size);
+  auto ret = compress2(dst->data(), &dst_size, src, static_cast<uLong>(size), Z_BEST_SPEED);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == Z_OK, "[Internal ERROR] Failed to compress blob column, zlib error: " +
+                                                 std::to_string(ret));
+  // Keep the column uncompressed if it can not be compressed, the reader tells them apart by the sizes
+  if (dst_size >= size) {
+    dst->assign(src, src + size);
+  } else {
+    dst->resize(dst_size);
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Unsupported blob compression, zlib is not enabled in this build.");
+#endif
+}
+
+Status UncompressColumn(const std::vector<uint8_t> &src, uint64_t raw_size, std::vector<uint8_t> *dst) {
+  if (src.size() == raw_size) {
+    *dst = src;
+    return Status::OK();
+  }
+#ifdef ENABLE_MINDRECORD_ZLIB
+  dst->resize(raw_size);
+  uLongf dst_size = static_cast<uLongf>(raw_size);
+  auto ret = uncompress(dst->data(), &dst_size, src.data(), static_cast<uLong>(src.size()));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == Z_OK && dst_size == raw_size,
+                                  "Invalid data, failed to uncompress blob column, zlib error: " + std::to_string(ret));
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Unsupported blob compression, zlib is not enabled in this build.");
+#endif
+}
+}  // namespace
+
 ShardColumn::ShardColumn(const std::shared_ptr<ShardHeader> &shard_header, bool compress_integer) {
   auto first_schema = shard_header->GetSchemas()[0];
   json schema_json = first_schema->GetSchema();
@@ -267,6 +313,118 @@ Status ShardColumn::GetColumnFromBlob(const std::string &column_name, const std:
   return Status::OK();
 }
 
+int64_t ShardColumn::GetBlobColumnId(const std::string &column_name) const {
+  auto it_blob = blob_column_id_.find(column_name);
+  return it_blob == blob_column_id_.end() ? -1 : static_cast<int64_t>(it_blob->second);
+}
+
+Status ShardColumn::SplitBlob(const std::vector<uint8_t> &blob, std::vector<std::pair<uint64_t, uint64_t>> *columns) {
+  RETURN_UNEXPECTED_IF_NULL_MR(columns);
+  columns->clear();
+  if (num_blob_column_ == 1) {
+    columns->emplace_back(0, blob.size());
+    return Status::OK();
+  }
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < num_blob_column_; i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(offset + kInt64Len <= blob.size(),
+                                    "[Internal ERROR] the blob is too short to hold " +
+                                      std::to_string(num_blob_column_) + " blob columns.");
+    uint64_t num_bytes = BytesBigToUInt64(blob, offset, kInt64Type);
+    offset += kInt64Len;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(num_bytes <= blob.size() - offset,
+                                    "[Internal ERROR] the size of blob column: " + blob_column_[i] +
+                                      " exceeds the blob.");
+    columns->emplace_back(offset, num_bytes);
+    offset += num_bytes;
+  }
+  return Status::OK();
+}
+
+Status ShardColumn::EncodeColumnarBlob(const std::vector<uint8_t> &blob, BlobCompression compression,
+                                       std::vector<uint8_t> *columnar_blob) {
+  RETURN_UNEXPECTED_IF_NULL_MR(columnar_blob);
+  std::vector<std::pair<uint64_t, uint64_t>> columns;
+  RETURN_IF_NOT_OK_MR(SplitBlob(blob, &columns));
+
+  // Directory: stored size and raw size of each blob column, followed by the stored blob columns
+  std::vector<std::vector<uint8_t>> stored(columns.size());
+  uint64_t total_size = GetColumnarDirectorySize();
+  for (size_t i = 0; i < columns.size(); i++) {
+    RETURN_IF_NOT_OK_MR(CompressColumn(blob.data() + columns[i].first, columns[i].second, compression, &stored[i]));
+    total_size += stored[i].size();
+  }
+  columnar_blob->clear();
+  columnar_blob->reserve(total_size);
+  for (size_t i = 0; i < columns.size(); i++) {
+    auto stored_size = UIntToBytesBig(stored[i].size(), kInt64Type);
+    auto raw_size = UIntToBytesBig(columns[i].second, kInt64Type);
+    columnar_blob->insert(columnar_blob->end(), stored_size.begin(), stored_size.end());
+    columnar_blob->insert(columnar_blob->end(), raw_size.begin(), raw_size.end());
+  }
+  for (const auto &column : stored) {
+    columnar_blob->insert(columnar_blob->end(), column.begin(), column.end());
+  }
+  return Status::OK();
+}
+
+Status ShardColumn::ParseColumnarDirectory(const std::vector<uint8_t> &directory,
+                                           std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> *columns) {
+  RETURN_UNEXPECTED_IF_NULL_MR(columns);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(directory.size() >= GetColumnarDirectorySize(),
+                                  "Invalid data, the directory of columnar blob should be " +
+                                    std::to_string(GetColumnarDirectorySize()) + " bytes, but got: " +
+                                    std::to_string(directory.size()));
+  columns->clear();
+  uint64_t offset = GetColumnarDirectorySize();
+  for (uint64_t i = 0; i < num_blob_column_; i++) {
+    uint64_t stored_size = BytesBigToUInt64(directory, i * kColumnarEntryLen, kInt64Type);
+    uint64_t raw_size = BytesBigToUInt64(directory, i * kColumnarEntryLen + kInt64Len, kInt64Type);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(stored_size <= raw_size, "Invalid data, the stored size of blob column: " +
+                                                               blob_column_[i] + " is larger than its raw size.");
+    columns->emplace_back(offset, stored_size, raw_size);
+    offset += stored_size;
+  }
+  return Status::OK();
+}
+
+Status ShardColumn::DecodeColumnarBlob(const std::vector<std::vector<uint8_t>> &columns,
+                                       const std::vector<uint64_t> &raw_sizes, std::vector<uint8_t> *blob) {
+  RETURN_UNEXPECTED_IF_NULL_MR(blob);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(columns.size() == num_blob_column_ && raw_sizes.size() == num_blob_column_,
+                                  "[Internal ERROR] the number of blob columns should be " +
+                                    std::to_string(num_blob_column_) + ", but got: " + std::to_string(columns.size()));
+  if (num_blob_column_ == 1) {
+    return UncompressColumn(columns[0], raw_sizes[0], blob);
+  }
+  blob->clear();
+  std::vector<uint8_t> column;
+  for (uint64_t i = 0; i < num_blob_column_; i++) {
+    RETURN_IF_NOT_OK_MR(UncompressColumn(columns[i], raw_sizes[i], &column));
+    auto num_bytes = UIntToBytesBig(column.size(), kInt64Type);
+    blob->insert(blob->end(), num_bytes.begin(), num_bytes.end());
+    blob->insert(blob->end(), column.begin(), column.end());
+  }
+  return Status::OK();
+}
+
+Status ShardColumn::DecodeColumnarBlob(const std::vector<uint8_t> &columnar_blob, std::vector<uint8_t> *blob) {
+  RETURN_UNEXPECTED_IF_NULL_MR(blob);
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> directory;
+  RETURN_IF_NOT_OK_MR(ParseColumnarDirectory(columnar_blob, &directory));
+  std::vector<std::vector<uint8_t>> columns;
+  std::vector<uint64_t> raw_sizes;
+  for (const auto &entry : directory) {
+    auto offset = std::get<0>(entry);
+    auto stored_size = std::get<1>(entry);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(offset + stored_size <= columnar_blob.size(),
+                                    "Invalid data, the blob column exceeds the columnar blob.");
+    columns.emplace_back(columnar_blob.begin() + offset, columnar_blob.begin() + offset + stored_size);
+    raw_sizes.push_back(std::get<2>(entry));
+  }
+  return DecodeColumnarBlob(columns, raw_sizes, blob);
+}
+
 ColumnCategory ShardColumn::CheckColumnName(const std::string &column_name) {
   auto it_column = column_name_id_.find(column_name);
   if (it_column == column_name_id_.end()) {
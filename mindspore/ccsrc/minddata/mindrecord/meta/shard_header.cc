@@ -30,7 +30,13 @@
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0) {
+ShardHeader::ShardHeader()
+    : shard_count_(0),
+      header_size_(0),
+      page_size_(0),
+      compression_size_(0),
+      blob_layout_(kBlobLayoutRow),
+      blob_compression_(kBlobCompressionNone) {
   index_ = std::make_shared<Index>();
 }
 
@@ -48,6 +54,7 @@ Status ShardHeader::InitializeHeader(const std::vector<json> &headers, bool load
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
       compression_size_ = header.contains("compression_size") ? header["compression_size"].get<uint64_t>() : 0;
+      RETURN_IF_NOT_OK_MR(ParseBlobLayout(header));
     }
     RETURN_IF_NOT_OK_MR(ParsePage(header["page"], shard_index, load_dataset));
     shard_index++;
@@ -151,6 +158,11 @@ Status ShardHeader::BuildSingleHeader(const std::string &file_path, std::shared_
                  {"blob_fields", (*raw_header)["schema"][0]["blob_fields"]},
                  {"schema", (*raw_header)["schema"][0]["schema"]},
                  {"version", (*raw_header)["version"]}};
+  // The blob layout is only written by the files in the columnar layout
+  if (raw_header->contains("blob_layout")) {
+    header["blob_layout"] = (*raw_header)["blob_layout"];
+    header["blob_compression"] = (*raw_header)["blob_compression"];
+  }
   *header_ptr = std::make_shared<json>(header);
   return Status::OK();
 }
@@ -275,6 +287,26 @@ Status ShardHeader::ParsePage(const json &pages, int shard_index, bool load_data
   return Status::OK();
 }
 
+Status ShardHeader::ParseBlobLayout(const json &header) {
+  blob_layout_ = kBlobLayoutRow;
+  blob_compression_ = kBlobCompressionNone;
+  if (!header.contains("blob_layout")) {
+    return Status::OK();
+  }
+  auto layout_name = header["blob_layout"].get<std::string>();
+  auto compression_name = header.value("blob_compression", std::string("none"));
+  auto layout = kBlobLayoutMap.find(layout_name);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(layout != kBlobLayoutMap.end(),
+                                  "Invalid file, the blob layout of mindrecord file is not supported: " + layout_name);
+  auto compression = kBlobCompressionMap.find(compression_name);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    compression != kBlobCompressionMap.end(),
+    "Invalid file, the blob compression of mindrecord file is not supported: " + compression_name);
+  blob_layout_ = layout->second;
+  blob_compression_ = compression->second;
+  return Status::OK();
+}
+
 Status ShardHeader::ParseStatistics(const json &statistics) {
   for (auto &statistic : statistics) {
     CHECK_FAIL_RETURN_UNEXPECTED_MR(
@@ -327,6 +359,11 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
       s += "\"compression_size\":" + std::to_string(compression_size_) + ",";
+      if (blob_layout_ == kBlobLayoutColumnar) {
+        s += "\"blob_layout\":\"columnar\",";
+        s += "\"blob_compression\":\"" + std::string(blob_compression_ == kBlobCompressionZlib ? "zlib" : "none") +
+             "\",";
+      }
       s += "\"schema\":" + schema + ",";
       s += "\"shard_addresses\":" + address + ",";
       s += "\"shard_id\":" + std::to_string(shardId) + ",";
@@ -51,6 +51,7 @@
 #include "utils/ms_context.h"
 #include "utils/ms_utils.h"
 #include "backend/graph_compiler/transform.h"
+#include "runtime/graph_scheduler/kernel_select_cache.h"
 #include "load_mindir/infer_mindir.h"
 #include "debug/data_dump/dump_json_parser.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
@@ -172,6 +173,9 @@ void TaskEmitActionForMindRT(const ResourcePtr &resource) {
   // The output of graph compiler is actor.
   auto actor_info = mindrt_bc_ptr->CompileGraphs(resource->func_graph());
   resource->SetResult(kOutput, actor_info);
+  if (resource->EnableCompileCache()) {
+    runtime::KernelSelectCache::GetInstance().Save();
+  }
 }
 
 void ExecuteActionForMindRT(const ResourcePtr &resource) {
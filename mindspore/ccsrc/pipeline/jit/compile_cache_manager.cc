@@ -29,6 +29,7 @@
 #include "include/common/utils/utils.h"
 #include "frontend/parallel/step_parallel.h"
 #include "mindspore/core/utils/file_utils.h"
+#include "runtime/graph_scheduler/kernel_select_cache.h"
 
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "ps/core/node.h"
@@ -46,6 +47,7 @@ constexpr char kRoleServer[] = "server_";
 constexpr char kRolePServer[] = "pserver_";
 constexpr char kRolePScheduler[] = "pscheduler_";
 constexpr char kGroupCkptFileName[] = "group.ckpt";
+constexpr char kKernelSelectCacheFileName[] = "kernel_select_cache.json";
 
 std::string GetUserDefinedCachePath() {
   auto user_defined_path = MsContext::GetInstance()->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH);
@@ -92,6 +94,8 @@ std::string GetDepFilesHashPath() {
   return dep_files_hash_path;
 }
 
+std::string GetKernelSelectCachePath() { return GetCompileCacheDir() + "/" + GetRole() + kKernelSelectCacheFileName; }
+
 std::string GetGroupCkptSavePath() { return GetCompileCacheDir() + "/" + kGroupCkptFileName; }
 
 std::string GetCompileDepFilesHash(const py::list &dep_files) {
@@ -201,6 +205,10 @@ void CompileCacheManager::CacheFuncGraph(const FuncGraphPtr &fg, const FuncGraph
   }
 }
 
+void CompileCacheManager::InitKernelSelectCache(bool load) const {
+  runtime::KernelSelectCache::GetInstance().Initialize(GetKernelSelectCachePath(), load);
+}
+
 void CompileCacheManager::InitCompileCacheHash(const py::list &compile_cache_dep_files) {
   compile_cache_dep_files_hash_ = GetCompileDepFilesHash(compile_cache_dep_files);
 }
@@ -44,6 +44,8 @@ class CompileCacheManager {
                                   const std::string &queue_name);
   // Export the func_graph to mindir file.
   void CacheFuncGraph(const FuncGraphPtr &fg, const FuncGraphPtr &layout_fg) const;
+  // Enable the kernel select cache of the backend, the cached kernels are loaded only if the func_graph is loaded.
+  void InitKernelSelectCache(bool load) const;
 
   const LayoutMap &layout_map() const { return layout_map_; }
 
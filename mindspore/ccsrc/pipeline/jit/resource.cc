@@ -626,16 +626,19 @@ void Resource::GetCompileCacheResource(const py::list &compile_cache_dep_files,
   MS_EXCEPTION_IF_NULL(compile_cache_consistent);
   if (!*compile_cache_consistent) {
     MS_LOG(WARNING) << "Check the consistency of dependency files hash failed. Execute all the compilation actions.";
+    compile_cache_manager_->InitKernelSelectCache(false);
     return;
   }
   compile_cache_manager_->InitCompileCacheHash(compile_cache_dep_files);
   *compile_cache_consistent = compile_cache_manager_->CheckDepFilesHashConsistency();
   if (!*compile_cache_consistent) {
     MS_LOG(WARNING) << "Check the consistency of dependency files hash failed. Execute all the compilation actions.";
+    compile_cache_manager_->InitKernelSelectCache(false);
     return;
   }
   func_graph_ = compile_cache_manager_->GetCachedFuncGraph(manager_, weights, queue_name);
   layout_map_ = compile_cache_manager_->layout_map();
+  compile_cache_manager_->InitKernelSelectCache(func_graph_ != nullptr);
 }
 
 void Resource::CacheFuncGraph() const {
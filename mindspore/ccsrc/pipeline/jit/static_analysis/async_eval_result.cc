@@ -46,11 +46,58 @@ void AnalysisSchedule::YieldTask(AsyncInferTask *async_infer_task) {
       MS_LOG(DEBUG) << " The active thread count: " << activate_threads_.size() << " thread id: " << thread_id()
                     << " async_infer_task thread id:" << async_infer_task->thread_id();
       (void)activate_threads_.erase(thread_id());
+      HandOff();
     }
   }
   activate_thread_cv_.notify_one();
 }
 
+AnalysisSchedule::~AnalysisSchedule() {
+  std::unique_lock<std::mutex> lock(infer_task_lock_);
+  stop_infer_threads_ = true;
+  infer_task_cv_.notify_all();
+  infer_exit_cv_.wait(lock, [this] { return infer_threads_ == 0; });
+}
+
+void AnalysisSchedule::RunInferTask(std::function<void()> &&task) {
+  std::lock_guard<std::mutex> lock(infer_task_lock_);
+  infer_tasks_.push_back(std::move(task));
+  if (idle_infer_threads_ >= infer_tasks_.size()) {
+    infer_task_cv_.notify_one();
+    return;
+  }
+  ++infer_threads_;
+  auto thread = std::thread([this] { InferThreadLoop(); });
+  thread.detach();
+}
+
+void AnalysisSchedule::InferThreadLoop() {
+  // The idle infer thread exits if no task comes for a while.
+  const auto keep_alive_period = std::chrono::seconds(10);
+  std::unique_lock<std::mutex> lock(infer_task_lock_);
+  while (true) {
+    ++idle_infer_threads_;
+    auto ok = infer_task_cv_.wait_for(lock, keep_alive_period,
+                                      [this] { return !infer_tasks_.empty() || stop_infer_threads_; });
+    --idle_infer_threads_;
+    if (!ok) {
+      MS_LOG(DEBUG) << "Idle infer thread exits.";
+      break;
+    }
+    if (stop_infer_threads_) {
+      break;
+    }
+    auto task = std::move(infer_tasks_.front());
+    infer_tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+  // The thread does not touch the schedule after releasing the lock.
+  --infer_threads_;
+  infer_exit_cv_.notify_all();
+}
+
 void AnalysisSchedule::HandleException(const std::exception &ex) {
   // Just record the first exception information.
   if (!StaticAnalysisException::Instance().HasException()) {
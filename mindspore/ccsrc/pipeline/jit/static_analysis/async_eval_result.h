@@ -44,7 +44,7 @@ using AsyncInferTaskPtr = std::shared_ptr<AsyncInferTask>;
 using AsyncAbstractPtr = std::shared_ptr<AsyncAbstract>;
 class AnalysisSchedule {
  public:
-  ~AnalysisSchedule() = default;
+  ~AnalysisSchedule();
   AnalysisSchedule(const AnalysisSchedule &) = delete;
   AnalysisSchedule &operator=(const AnalysisSchedule &) = delete;
   static AnalysisSchedule &GetInstance() {
@@ -60,11 +60,16 @@ class AnalysisSchedule {
   void WaitForRun() const;
   void YieldTask(AsyncInferTask *asyncTask);
 
+  // Run the infer task on an idle infer thread, or on a new one if all of them are busy. The infer tasks wait for each
+  // other, so a task never waits for a thread.
+  void RunInferTask(std::function<void()> &&task);
+
   void EnterWaiting() {
     {
       std::lock_guard<std::mutex> activeLock(activate_thread_lock_);
       (void)activate_threads_.erase(AnalysisSchedule::thread_id());
       MS_LOG(DEBUG) << "Infer return to main thread.";
+      HandOff();
     }
     activate_thread_cv_.notify_one();
   }
@@ -90,6 +95,7 @@ class AnalysisSchedule {
                     << " The infer_thread_count: " << infer_thread_count_
                     << " schedule list size: " << schedule_list_.size() << " thread: " << thread_id() + " "
                     << (activate_threads_.size() > 0 ? activate_threads_.begin()->c_str() : "");
+      HandOff();
     }
     activate_thread_cv_.notify_one();
   }
@@ -97,6 +103,14 @@ class AnalysisSchedule {
  private:
   void Schedule();
   void SetNextReady();
+  // Called with activate_thread_lock_ held by the thread giving up running, to set the next task ready directly
+  // instead of waking up the schedule thread to do it.
+  void HandOff() {
+    if (activate_threads_.empty() && !schedule_list_.empty()) {
+      SetNextReady();
+    }
+  }
+  void InferThreadLoop();
   void Start() {
     auto thread = std::thread([this] { Schedule(); });
     thread.detach();
@@ -110,6 +124,15 @@ class AnalysisSchedule {
   std::condition_variable activate_thread_cv_;
   std::list<AsyncInferTaskPtr> schedule_list_;
   std::set<std::string> activate_threads_;
+  // The infer threads are reused by the following infer tasks. They are detached, so the destructor tells them to exit
+  // and waits until all of them have left the loop before the members they use are destroyed.
+  std::mutex infer_task_lock_;
+  std::condition_variable infer_task_cv_;
+  std::condition_variable infer_exit_cv_;
+  std::list<std::function<void()>> infer_tasks_;
+  size_t infer_threads_{0};
+  size_t idle_infer_threads_{0};
+  bool stop_infer_threads_{false};
   const std::string kStateStop = "Stop";
   static thread_local std::string thread_id_;
 };
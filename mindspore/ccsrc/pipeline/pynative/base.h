@@ -39,6 +39,8 @@ struct BaseOpRunInfo {
   bool is_mixed_precision_cast = false;
   bool lazy_build = false;
   bool use_dynamic_shape_process = false;
+  // The outputs are not read until the op is run, so the op can be deferred.
+  bool allow_deferred_run = false;
   std::string op_name;
   std::string next_op_name;
   std::string graph_info;
@@ -274,6 +274,7 @@ ValuePtr CastOperation::DoAutoCast(const FrontendOpRunInfoPtr &op_run_info, cons
   cast_run_info->base_op_run_info.next_op_name = op_name;
   cast_run_info->base_op_run_info.next_input_index = index;
   cast_run_info->base_op_run_info.lazy_build = op_run_info->base_op_run_info.lazy_build;
+  cast_run_info->base_op_run_info.allow_deferred_run = op_run_info->base_op_run_info.allow_deferred_run;
   cast_run_info->base_op_run_info.use_dynamic_shape_process = op_run_info->base_op_run_info.use_dynamic_shape_process;
   (void)cast_run_info->input_value.emplace_back(v);
   (void)cast_run_info->input_value.emplace_back(GetDstType(type_id));
@@ -21,6 +21,7 @@
 #include "pipeline/pynative/pynative_utils.h"
 #include "include/common/utils/scoped_long_running.h"
 #include "backend/graph_compiler/transform.h"
+#include "runtime/pynative/op_sequence_capture.h"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -219,6 +220,8 @@ FrontendOpRunInfoPtr ForwardExecutor::GenerateOpRunInfo(const py::args &args) co
     (device_target() == kAscendDevice ? false : grad()->use_dynamic_shape_process());
   op_run_info->base_op_run_info.op_name = args[static_cast<size_t>(RunOpArgsEnum::PY_NAME)].cast<std::string>();
   op_run_info->base_op_run_info.lazy_build = lazy_build_;
+  // The outputs of the op are read by the grad executor as soon as it is run.
+  op_run_info->base_op_run_info.allow_deferred_run = !op_run_info->grad_flag;
   PyNativeAlgo::PyParser::SetPrim(op_run_info, args[static_cast<size_t>(RunOpArgsEnum::PY_PRIM)]);
   PyNativeAlgo::PyParser::ParseOpInputByPythonObj(op_run_info, args[static_cast<size_t>(RunOpArgsEnum::PY_INPUTS)]);
   (void)op_run_prim_py_list_.emplace_back(op_run_info->op_prim);
@@ -399,6 +402,8 @@ void ForwardExecutor::ProcessBeforeEndGraph(const py::object &obj, bool is_cell)
   if (IsFirstCell()) {
     // Reset lazy build
     set_lazy_build(false);
+    // The ops run since the top cell started form an op sequence
+    runtime::OpSequenceCapture::GetInstance().EndSequence();
     // Finish lazy task
     ExecuteLazyTask();
     if (!grad()->grad_flag()) {
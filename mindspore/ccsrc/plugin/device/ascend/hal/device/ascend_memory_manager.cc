@@ -155,6 +155,17 @@ void AscendMemoryManager::SwapIn(const void *host_ptr, void *device_ptr, size_t
   }
 }
 
+void AscendMemoryManager::SwapInAsync(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+  if (stream == nullptr) {
+    SwapIn(host_ptr, device_ptr, mem_size, stream);
+    return;
+  }
+  auto ret_rt_memcpy = aclrtMemcpyAsync(device_ptr, mem_size, host_ptr, mem_size, ACL_MEMCPY_HOST_TO_DEVICE, stream);
+  if (ret_rt_memcpy != RT_ERROR_NONE) {
+    MS_EXCEPTION(DeviceProcessError) << "SwapInAsync aclrtMemcpyAsync failed.";
+  }
+}
+
 void AscendMemoryManager::SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) {
   if (stream == nullptr) {
     auto ret_rt_memcpy = aclrtMemcpy(host_ptr, mem_size, device_ptr, mem_size, ACL_MEMCPY_DEVICE_TO_HOST);
@@ -30,6 +30,7 @@
 #include "common/graph_kernel/graph_kernel_flags.h"
 #include "plugin/device/ascend/hal/device/kernel_select_ascend.h"
 #include "plugin/device/ascend/hal/device/kernel_adjust.h"
+#include "runtime/graph_scheduler/kernel_select_cache.h"
 
 #ifndef ENABLE_SECURITY
 #include "include/common/debug/anf_ir_dump.h"
@@ -369,11 +370,23 @@ void AscendGraphOptimization::SetOperatorInfo(const KernelGraphPtr &graph) {
     graph->set_manager(mng);
   }
   bool do_expand = false;
+  auto &kernel_select_cache = runtime::KernelSelectCache::GetInstance();
   auto &node_list = graph->execution_order();
   for (auto &node : node_list) {
+    // Only the kernels fully matched by a TBE kernel are cached, the selection of the others changes the graph.
+    std::string kernel_key;
+    if (!common::AnfAlgo::HasNodeAttr(kAttrPynativeNextOpName, node) &&
+        kernel_select_cache.Fetch(node, kAscendDevice, &kernel_key)) {
+      device::ascend::SetTensorDeviceInfo(node);
+      continue;
+    }
     auto [status, msg, etype] = device::ascend::SelectKernelInfoWithMsg(node);
     common::AnfAlgo::EraseNodeAttr(kAttrPynativeNextOpName, node);
     common::AnfAlgo::EraseNodeAttr(kAttrPynativeNextIndex, node);
+    if (status == device::ascend::kStatusAllMatched && AnfAlgo::GetKernelType(node) == KernelType::TBE_KERNEL &&
+        !common::AnfAlgo::HasNodeAttr(kAttrIsAiCpuKernel, node)) {
+      kernel_select_cache.Store(kernel_key, node);
+    }
     if (status != device::ascend::kNoMatched) {
       if (status == device::ascend::kStatusRaisePrecision) {
         raise_precision_count_++;
@@ -19,6 +19,7 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
 
 namespace mindspore {
 namespace device {
@@ -132,9 +133,7 @@ bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output
     // Step 3: Reduce the data, so we can overlap the time cost of send.
     MS_EXCEPTION_IF_NULL(rec_ptr);
     const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
-    }
+    (void)ElementAdd(tmp_data, rec_chunk, rec_chunk, SizeToInt(chunk_sizes[rec_chunk_index]));
     // Step 4: Wait until send is done.
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
       MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
@@ -202,9 +201,7 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
       }
       MS_EXCEPTION_IF_NULL(rec_ptr);
       const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-      for (size_t j = 0; j < data_num; j++) {
-        output_buff[j] += tmp_data[j];
-      }
+      (void)ElementAdd(tmp_data, output_buff, output_buff, SizeToInt(data_num));
     }
   } else {
     MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
@@ -50,6 +50,7 @@
 #endif
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
+#include "runtime/graph_scheduler/kernel_select_cache.h"
 #include "plugin/device/cpu/hal/profiler/cpu_profiling.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
@@ -274,11 +275,17 @@ void CPUKernelExecutor::SetOperatorInfo(const KernelGraphPtr &graph) const {
     graph->set_manager(mng);
   }
 #endif
+  auto &kernel_select_cache = runtime::KernelSelectCache::GetInstance();
   auto &node_list = graph->execution_order();
   for (auto &node : node_list) {
     if (!common::AnfAlgo::IsControlOpExecInBackend(node)) {
+      std::string kernel_key;
+      if (kernel_select_cache.Fetch(node, kCPUDevice, &kernel_key)) {
+        continue;
+      }
       auto [msg, etype] = SetKernelInfoWithMsg(node);
       if (msg.empty()) {
+        kernel_select_cache.Store(kernel_key, node);
         continue;
       }
 #ifdef ENABLE_AKG
@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <climits>
 #include <numeric>
+#include <set>
+#include <utility>
 #include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
 #include "distributed/cluster/cluster_context.h"
 #include "utils/ms_context.h"
 
@@ -27,6 +32,40 @@ const char kCollectivePhaseRing[] = "ring";
 const char kCollectivePhaseGather[] = "gather";
 const char kCollectivePhaseReduce[] = "reduce";
 const char kCollectivePhaseBroadcast[] = "broadcast";
+
+// Add the input to the output element-wise.
+template <typename T>
+void ReduceSum(const T *input, T *output, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    output[i] += input[i];
+  }
+}
+
+// The float and int data are added by the vectorized nnacl functions, whose element number is limited to INT_MAX.
+template <>
+void ReduceSum<float>(const float *input, float *output, size_t count) {
+  for (size_t offset = 0; offset < count; offset += INT_MAX) {
+    int size = static_cast<int>(std::min(count - offset, static_cast<size_t>(INT_MAX)));
+    (void)ElementAdd(input + offset, output + offset, output + offset, size);
+  }
+}
+
+template <>
+void ReduceSum<int>(const int *input, int *output, size_t count) {
+  for (size_t offset = 0; offset < count; offset += INT_MAX) {
+    int size = static_cast<int>(std::min(count - offset, static_cast<size_t>(INT_MAX)));
+    (void)ElementAddInt(input + offset, output + offset, output + offset, size);
+  }
+}
+
+// Split count elements into part_num parts as evenly as possible. Part i is [offsets[i], offsets[i + 1]).
+std::vector<size_t> SplitEvenly(size_t count, size_t part_num) {
+  std::vector<size_t> offsets(part_num + 1, 0);
+  for (size_t i = 0; i < part_num; i++) {
+    offsets[i + 1] = offsets[i] + count / part_num + (i < count % part_num ? 1 : 0);
+  }
+  return offsets;
+}
 }  // namespace
 
 bool MSCollectiveOpsImpl::Initialize() {
@@ -35,6 +74,190 @@ bool MSCollectiveOpsImpl::Initialize() {
   return true;
 }
 
+uint32_t MSCollectiveOpsImpl::GetCommTimeout() const {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // If enable recovery, set timeout 300s to prevent networking flapping.
+  return context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::ReceiveData(uint32_t rank, T *buff, size_t count, bool reduce, uint32_t timeout) {
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(rank, &message, timeout)) {
+    MS_LOG(ERROR) << "Failed to receive data from rank " << rank;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  std::unique_ptr<MessageBase> message_holder(message);
+
+  size_t size = count * sizeof(T);
+  if (message->body.length() != size) {
+    MS_LOG(ERROR) << "The size of data received from rank " << rank << " is " << message->body.length()
+                  << ", but the expected size is " << size;
+    return false;
+  }
+  if (reduce) {
+    ReduceSum<T>(reinterpret_cast<const T *>(message->body.data()), buff, count);
+    return true;
+  }
+  int ret = memcpy_s(buff, size, message->body.data(), message->body.length());
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << size << ", src size is " << message->body.length();
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RingAllReduce(T *buff, size_t count, uint32_t timeout) {
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  // Segment i is reduced by rank (i - 1) in the reduce-scatter phase.
+  std::vector<size_t> seg_offsets = SplitEvenly(count, rank_size_);
+  size_t piece_count = std::max(kRingAllReducePieceSize / sizeof(T), static_cast<size_t>(1));
+
+  uint32_t send_to_rank = (rank_id_ + 1) % rank_size_;
+  uint32_t recv_from_rank = (rank_id_ - 1 + rank_size_) % rank_size_;
+  MS_LOG(DEBUG) << "Ring AllReduce count:" << count << ", rank_size:" << rank_size_ << ", rank_id_:" << rank_id_
+                << ", piece_count:" << piece_count << ", send_to_rank:" << send_to_rank
+                << ", recv_from_rank:" << recv_from_rank;
+
+  // The segment of this rank is sent in the first step. After that, the data sent in a step is the segment received in
+  // the previous step, so each piece is forwarded as soon as it's received.
+  for (size_t begin = seg_offsets[rank_id_]; begin < seg_offsets[rank_id_ + 1]; begin += piece_count) {
+    size_t piece = std::min(piece_count, seg_offsets[rank_id_ + 1] - begin);
+    if (!topo_node_->SendAsync(send_to_rank, buff + begin, piece * sizeof(T))) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+      return false;
+    }
+  }
+
+  // The received pieces are reduced in the first (rank_size - 1) steps, after which this rank holds the fully reduced
+  // segment (rank_id + 1). The received pieces are the results in the last (rank_size - 1) steps and are copied.
+  size_t step_num = 2 * (rank_size_ - 1);
+  for (size_t step = 0; step < step_num; step++) {
+    size_t recv_seg_index = (rank_id_ + step_num + 1 - step) % rank_size_;
+    bool reduce = step < rank_size_ - 1;
+    bool forward = step + 1 < step_num;
+    for (size_t begin = seg_offsets[recv_seg_index]; begin < seg_offsets[recv_seg_index + 1]; begin += piece_count) {
+      size_t piece = std::min(piece_count, seg_offsets[recv_seg_index + 1] - begin);
+      if (!ReceiveData(recv_from_rank, buff + begin, piece, reduce, timeout)) {
+        return false;
+      }
+      if (forward && !topo_node_->SendAsync(send_to_rank, buff + begin, piece * sizeof(T))) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+        return false;
+      }
+    }
+  }
+
+  if (!topo_node_->WaitForSend(send_to_rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RecursiveHalvingDoublingAllReduce(T *buff, size_t count, uint32_t timeout) {
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  // Only the largest power of two ranks take part in the halving and doubling steps.
+  uint32_t pof2 = 1;
+  while (pof2 * 2 <= rank_size_) {
+    pof2 *= 2;
+  }
+  uint32_t extra = rank_size_ - pof2;
+  MS_LOG(DEBUG) << "Recursive halving doubling AllReduce count:" << count << ", rank_size:" << rank_size_
+                << ", rank_id_:" << rank_id_ << ", power of two:" << pof2;
+
+  // The even ranks in [0, 2 * extra) fold their data into the next odd ranks and wait for the result.
+  uint32_t new_rank = 0;
+  if (rank_id_ < 2 * extra) {
+    if (rank_id_ % 2 == 0) {
+      uint32_t peer = rank_id_ + 1;
+      if (!topo_node_->SendAsync(peer, buff, count * sizeof(T)) || !topo_node_->WaitForSend(peer)) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << peer;
+        return false;
+      }
+      return ReceiveData(peer, buff, count, false, timeout);
+    }
+    if (!ReceiveData(rank_id_ - 1, buff, count, true, timeout)) {
+      return false;
+    }
+    new_rank = rank_id_ / 2;
+  } else {
+    new_rank = rank_id_ - extra;
+  }
+  auto to_rank_id = [extra](uint32_t rank) { return rank < extra ? rank * 2 + 1 : rank + extra; };
+
+  std::set<uint32_t> peers;
+  std::vector<size_t> block_offsets = SplitEvenly(count, pof2);
+  auto send_blocks = [&](uint32_t peer, size_t begin, size_t end) {
+    size_t block_count = block_offsets[end] - block_offsets[begin];
+    (void)peers.insert(peer);
+    return block_count == 0 ||
+           topo_node_->SendAsync(peer, buff + block_offsets[begin], block_count * sizeof(T));
+  };
+  auto recv_blocks = [&](uint32_t peer, size_t begin, size_t end, bool reduce) {
+    size_t block_count = block_offsets[end] - block_offsets[begin];
+    return block_count == 0 || ReceiveData(peer, buff + block_offsets[begin], block_count, reduce, timeout);
+  };
+
+  // Reduce-scatter by recursive halving: in each step, the block range [begin, end) of this rank is halved. One half is
+  // sent to the peer and the other half is reduced with the data from the peer.
+  size_t begin = 0;
+  size_t end = pof2;
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (uint32_t mask = pof2 >> 1; mask > 0; mask >>= 1) {
+    uint32_t peer = to_rank_id(new_rank ^ mask);
+    size_t mid = (begin + end) / 2;
+    bool keep_upper = (new_rank & mask) != 0;
+    ranges.emplace_back(begin, end);
+    if (!(keep_upper ? send_blocks(peer, begin, mid) : send_blocks(peer, mid, end))) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << peer;
+      return false;
+    }
+    if (!(keep_upper ? recv_blocks(peer, mid, end, true) : recv_blocks(peer, begin, mid, true))) {
+      return false;
+    }
+    begin = keep_upper ? mid : begin;
+    end = keep_upper ? end : mid;
+  }
+
+  // Allgather by recursive doubling with the peers of halving steps in the reverse order. In each step, the reduced
+  // blocks of this rank are exchanged with the peer's, which are the other half of the range before the halving.
+  for (uint32_t mask = 1; mask < pof2; mask <<= 1) {
+    uint32_t peer = to_rank_id(new_rank ^ mask);
+    auto range = ranges.back();
+    ranges.pop_back();
+    if (!send_blocks(peer, begin, end)) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << peer;
+      return false;
+    }
+    if (!(begin == range.first ? recv_blocks(peer, end, range.second, false)
+                               : recv_blocks(peer, range.first, begin, false))) {
+      return false;
+    }
+    begin = range.first;
+    end = range.second;
+  }
+
+  // Send the result back to the folded ranks.
+  if (rank_id_ < 2 * extra && !send_blocks(rank_id_ - 1, 0, pof2)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << (rank_id_ - 1);
+    return false;
+  }
+  for (uint32_t peer : peers) {
+    if (!topo_node_->WaitForSend(peer)) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << peer;
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 bool MSCollectiveOpsImpl::RingAllGather(const void *sendbuff, void *recvbuff, size_t send_count) {
   MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
@@ -183,6 +406,43 @@ bool MSCollectiveOpsImpl::Broadcast(const void *sendbuff, void *recvbuff, size_t
   return true;
 }
 
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  rank_id_ = SizeToUint(topo_node_->rank_id());
+  rank_size_ = SizeToUint(topo_node_->rank_size());
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+
+  size_t data_size = count * sizeof(T);
+  if (recvbuff != sendbuff && data_size > 0) {
+    int ret = memcpy_s(recvbuff, data_size, sendbuff, data_size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << data_size << ", src size is " << data_size;
+      return false;
+    }
+  }
+  if (rank_size_ == 1 || count == 0) {
+    MS_LOG(INFO) << "Rank size is " << rank_size_ << ", count is " << count << ". Do nothing.";
+    return true;
+  }
+
+  MS_LOG(DEBUG) << "AllReduce " << data_name << ", data size:" << data_size;
+  T *buff = reinterpret_cast<T *>(recvbuff);
+  if (data_size < kRingAllReduceThreshold) {
+    return RecursiveHalvingDoublingAllReduce<T>(buff, count, GetCommTimeout());
+  }
+  return RingAllReduce<T>(buff, count, GetCommTimeout());
+}
+
 template <typename T>
 bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t send_count) {
   std::unique_lock<std::mutex> lock(mtx_);
@@ -204,6 +464,34 @@ bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t
 
   return RingAllGather<T>(sendbuff, recvbuff, send_count);
 }
+
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<uint64_t>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                       size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<char>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                   size_t count);
+
+template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                    const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                       uint32_t root, const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                  const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -31,6 +31,13 @@ namespace cpu {
 constexpr uint32_t kCollectiveCommTimeout = 30;
 // The max timeout for server collective communication, used in disaster recovery to prevent networking flapping.
 constexpr uint32_t kCollectiveCommMaxTimeout = 300;
+// The AllReduce whose data size in bytes is smaller than this threshold uses the recursive halving and doubling
+// algorithm, which is latency bound and takes 2*log(rank_size) steps. The larger one uses the pipelined ring algorithm,
+// which is bandwidth bound and takes 2*(rank_size-1) steps.
+constexpr size_t kRingAllReduceThreshold = 64 * 1024;
+// The segment of each rank in the ring AllReduce is sent in pieces of this size in bytes, so that reducing the received
+// piece overlaps with the transmission of the following pieces.
+constexpr size_t kRingAllReducePieceSize = 256 * 1024;
 
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
@@ -49,8 +56,8 @@ struct CommunicationGroupInfo {
 };
 
 // MSCollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// For now, it implements two AllReduce algorithms: the pipelined RingAllReduce for large data and the
+// RecursiveHalvingDoublingAllReduce for small data. The algorithm is selected by the data size.
 class MSCollectiveOpsImpl {
  public:
   explicit MSCollectiveOpsImpl(const std::shared_ptr<TopologyNode> &topo_node)
@@ -59,6 +66,7 @@ class MSCollectiveOpsImpl {
 
   bool Initialize();
 
+  // Collective sum of the data of all the ranks. The sendbuff and recvbuff could be the same.
   template <typename T>
   bool AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count);
 
@@ -83,6 +91,24 @@ class MSCollectiveOpsImpl {
   bool RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                          const std::vector<size_t> &chunk_offset, const std::vector<size_t> &chunk_sizes);
 
+  // Implementation of the pipelined RingAllReduce: a reduce-scatter followed by an allgather along the ring. Each
+  // received piece is reduced and forwarded to the next rank immediately instead of waiting for the whole segment.
+  template <typename T>
+  bool RingAllReduce(T *buff, size_t count, uint32_t timeout);
+
+  // Implementation of the RecursiveHalvingDoublingAllReduce(Rabenseifner's algorithm): a reduce-scatter by recursive
+  // halving followed by an allgather by recursive doubling. If the rank size is not a power of two, the extra ranks fold
+  // their data into their neighbors before the reduction and get the result back after it.
+  template <typename T>
+  bool RecursiveHalvingDoublingAllReduce(T *buff, size_t count, uint32_t timeout);
+
+  // Receive the data of count elements from the rank, then add it to or copy it to the buff.
+  template <typename T>
+  bool ReceiveData(uint32_t rank, T *buff, size_t count, bool reduce, uint32_t timeout);
+
+  // Get the timeout of receiving data according to whether the recovery is enabled.
+  uint32_t GetCommTimeout() const;
+
   uint32_t rank_id_;
   uint32_t rank_size_;
 
@@ -91,25 +117,6 @@ class MSCollectiveOpsImpl {
   // The mutex to ensure that collective communication is threadsafe.
   std::mutex mtx_;
 };
-
-template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                    const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
-                                                       uint32_t root, const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                  const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -103,7 +103,9 @@ bool TopologyNode::Finalize() {
 }
 
 bool TopologyNode::SendAsync(size_t rank_id, const void *data, size_t size) {
-  if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
+  // Only the connection to the next rank is built during initialization, the connections to other ranks are built on
+  // demand, e.g. by the recursive halving and doubling allreduce.
+  if (tcp_clients_.find(rank_id) == tcp_clients_.end() && !ConnectToRank(rank_id)) {
     MS_LOG(ERROR) << "Cann not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
     return false;
   }
@@ -158,6 +160,33 @@ bool TopologyNode::Receive(size_t rank_id, MessageBase **message, size_t timeout
   return rt;
 }
 
+bool TopologyNode::ConnectToRank(size_t rank_id) {
+  if (rank_id >= total_node_num_ || rank_id == rank_id_) {
+    MS_LOG(ERROR) << "Invalid rank id to connect: " << rank_id << ", local rank: " << rank_id_
+                  << ", total node number: " << total_node_num_;
+    return false;
+  }
+  auto tcp_client = std::make_unique<distributed::rpc::TCPClient>();
+  RETURN_IF_FALSE_WITH_LOG(tcp_client->Initialize(), "Failed to initialize the tcp client to rank " << rank_id);
+
+  size_t retry = 60;
+  auto rank_name = "RNAK_ID_" + std::to_string(rank_id);
+  while (retry-- > 0) {
+    std::string rank_addr = cgn_->GetMetadata(rank_name);
+    if (rank_addr.length() > 0 && tcp_client->Connect(rank_addr)) {
+      node_addresses_[rank_id] = rank_addr;
+      tcp_clients_[rank_id] = tcp_client.release();
+      return true;
+    }
+    MS_LOG(INFO) << "Retry to get the address of rank : " << rank_name;
+    static const uint32_t interval = 1;
+    (void)sleep(interval);
+  }
+  tcp_client->Finalize();
+  MS_LOG(ERROR) << "Failed to connect to rank " << rank_id << ", local rank: " << rank_id_;
+  return false;
+}
+
 size_t TopologyNode::rank_id() const { return rank_id_; }
 
 size_t TopologyNode::rank_size() const { return total_node_num_; }
@@ -171,6 +200,8 @@ MessageBase *const TopologyNode::HandleMessage(MessageBase *const message) {
   if (received_messages_.find(rank_id) == received_messages_.end()) {
     queue = new std::queue<MessageBase *>();
     received_messages_[rank_id] = queue;
+  } else {
+    queue = received_messages_[rank_id];
   }
   MS_EXCEPTION_IF_NULL(queue);
   queue->push(message);
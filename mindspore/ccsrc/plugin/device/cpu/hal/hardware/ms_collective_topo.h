@@ -61,6 +61,9 @@ class TopologyNode {
   size_t rank_size() const;
 
  private:
+  // Lookup the address of the specified rank from meta server node and build the tcp connection to it.
+  bool ConnectToRank(size_t rank_id);
+
   // Handle the message received by the tcp server.
   MessageBase *const HandleMessage(MessageBase *const message);
 
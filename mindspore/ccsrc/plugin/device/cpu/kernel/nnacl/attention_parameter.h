@@ -25,6 +25,20 @@ typedef struct AttentionParameter {
   bool cross_;
 } AttentionParameter;
 
+typedef struct ScaledDotProductAttentionParameter {
+  // Primitive parameter
+  OpParameter op_parameter_;
+  float scale_;       // multiplier of q * k before the mask and softmax
+  bool transpose_k_;  // key is [k_seq, head_size] when true, else [head_size, k_seq]
+  // args for compute
+  int q_seq_;        // length of sequence of query of attention
+  int k_seq_;        // length of sequence of key and value of attention
+  int head_size_;    // size of each head of query and key
+  int v_head_size_;  // size of each head of value
+  int q_block_;      // rows of query computed together
+  int kv_block_;     // rows of key and value streamed through one online softmax step
+} ScaledDotProductAttentionParameter;
+
 typedef struct RelativePositionAttentionParameter {
   // Primitive parameter
   OpParameter op_parameter_;
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_CAST_BF16_H_
+#define MINDSPORE_NNACL_BF16_CAST_BF16_H_
+
+#include <string.h>
+#include "nnacl/op_base.h"
+
+// bfloat16 values are kept as their raw uint16_t bits, the high half of the float32 encoding
+#ifdef __cplusplus
+extern "C" {
+#endif
+static inline uint16_t Fp32ToBf16(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    return (uint16_t)((bits >> 16) | 0x40u);  // keep nan quiet instead of rounding it to inf
+  }
+  bits += 0x7fffu + ((bits >> 16) & 1u);  // round to nearest even
+  return (uint16_t)(bits >> 16);
+}
+
+static inline float Bf16ToFp32(uint16_t value) {
+  uint32_t bits = (uint32_t)value << 16;
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+static inline float RoundFp32ToBf16(float value) { return Bf16ToFp32(Fp32ToBf16(value)); }
+
+void Float32ToBf16(const float *input, uint16_t *output, int number);
+void Bf16ToFloat32(const uint16_t *input, float *output, int number);
+// rounds float32 values to the nearest bfloat16 value, the result stays in float32
+void RoundFloat32ToBf16(const float *input, float *output, int number);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_CAST_BF16_H_
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/layer_norm_bf16.h"
+#include <math.h>
+#include "nnacl/errorcode.h"
+#include "nnacl/bf16/cast_bf16.h"
+
+static void LayerNormBf16MeanAndVariance(const float *src, int num, float *mean, float *variance) {
+  float sum = 0.0f;
+  float square_sum = 0.0f;
+  for (int i = 0; i < num; ++i) {
+    sum += src[i];
+    square_sum += src[i] * src[i];
+  }
+  *mean = sum / (float)num;
+  *variance = square_sum / (float)num - (*mean) * (*mean);
+}
+
+static void LayerNormBf16GammaAndBeta(float *dst, const float *src, const uint16_t *gamma, const uint16_t *beta,
+                                      int num, float mean, float deno) {
+  for (int i = 0; i < num; ++i) {
+    float value = (src[i] - mean) * deno;
+    dst[i] = RoundFp32ToBf16(value * Bf16ToFp32(gamma[i]) + Bf16ToFp32(beta[i]));
+  }
+}
+
+int LayerNormBf16(const float *src_data, const uint16_t *gamma_data, const uint16_t *beta_data, float *dst_data,
+                  const LayerNormParameter *param, size_t task_id) {
+  if (src_data == NULL || dst_data == NULL || gamma_data == NULL || beta_data == NULL) {
+    return NNACL_NULL_PTR;
+  }
+  NNACL_CHECK_NULL_RETURN_ERR(param);
+  NNACL_CHECK_ZERO_RETURN_ERR(param->params_inner_size_);
+  NNACL_CHECK_ZERO_RETURN_ERR(param->params_outer_size_);
+  NNACL_CHECK_ZERO_RETURN_ERR(param->norm_inner_size_);
+  int step = UP_DIV(param->norm_outer_size_, param->op_parameter_.thread_num_);
+  int thread_end = MSMIN((task_id + 1) * step, param->norm_outer_size_);
+  for (int i = task_id * step; i < thread_end; i++) {
+    const float *src_norm = src_data + i * param->norm_inner_size_;
+    float *dst_norm = dst_data + i * param->norm_inner_size_;
+    float cur_mean = 0.0f;
+    float cur_variance = 0.0f;
+    LayerNormBf16MeanAndVariance(src_norm, param->norm_inner_size_, &cur_mean, &cur_variance);
+    const float deno = 1 / sqrtf(cur_variance + param->epsilon_);
+    if (param->norm_outer_size_ <= param->params_outer_size_) {
+      for (int x = 0; x < param->norm_inner_size_ / param->params_inner_size_; x++) {
+        const float *src_param = src_norm + x * param->params_inner_size_;
+        float *dst_param = dst_norm + x * param->params_inner_size_;
+        LayerNormBf16GammaAndBeta(dst_param, src_param, gamma_data, beta_data, param->params_inner_size_, cur_mean,
+                                  deno);
+      }
+    } else {
+      int x = i / param->params_outer_size_;
+      const uint16_t *gamma = gamma_data + x * param->norm_inner_size_;
+      const uint16_t *beta = beta_data + x * param->norm_inner_size_;
+      LayerNormBf16GammaAndBeta(dst_norm, src_norm, gamma, beta, param->norm_inner_size_, cur_mean, deno);
+    }
+  }
+  return NNACL_OK;
+}
@@ -0,0 +1,32 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_LAYER_NORM_BF16_H_
+#define MINDSPORE_NNACL_BF16_LAYER_NORM_BF16_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/layer_norm_parameter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* the statistics are computed in fp32, gamma and beta are bf16 and the output is rounded to bf16 precision */
+int LayerNormBf16(const float *src_data, const uint16_t *gamma_data, const uint16_t *beta_data, float *dst_data,
+                  const LayerNormParameter *param, size_t task_id);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_LAYER_NORM_BF16_H_
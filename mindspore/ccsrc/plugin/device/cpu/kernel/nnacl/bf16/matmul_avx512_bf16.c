@@ -0,0 +1,139 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/matmul_bf16.h"
+#ifdef ENABLE_AVX512_BF16
+#include <immintrin.h>
+#include <string.h>
+
+#define BF16_TILE_ROW C4NUM
+#define BF16_TILE_BLOCK C4NUM
+
+static inline __m512 Bf16ActAndRound(__m512 value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm512_max_ps(value, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+  }
+  // the output keeps bf16 precision: round to nearest even and widen back
+  __m256bh rounded = _mm512_cvtneps_pbh(value);
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32((__m256i)rounded), C16NUM));
+}
+
+// rows x blocks tile of 16 columns, both are compile time constants after inlining so the accumulators stay in zmm
+static inline __attribute__((always_inline)) void MatmulBf16Avx512Tile(const uint16_t *a, const uint16_t *b, float *c,
+                                                                       const float *bias, ActType act_type, int deep_2,
+                                                                       int stride, __mmask16 last_mask,
+                                                                       const int rows, const int blocks) {
+  int deep_align = deep_2 * C2NUM;
+  int block_stride = deep_2 * C32NUM;
+  __m512 acc[BF16_TILE_ROW][BF16_TILE_BLOCK];
+#pragma GCC unroll 4
+  for (int r = 0; r < rows; ++r) {
+#pragma GCC unroll 4
+    for (int j = 0; j < blocks; ++j) {
+      acc[r][j] = _mm512_setzero_ps();
+    }
+  }
+  for (int p = 0; p < deep_2; ++p) {
+    __m512i weight[BF16_TILE_BLOCK];
+#pragma GCC unroll 4
+    for (int j = 0; j < blocks; ++j) {
+      weight[j] = _mm512_loadu_si512(b + j * block_stride + p * C32NUM);
+    }
+#pragma GCC unroll 4
+    for (int r = 0; r < rows; ++r) {
+      int32_t pair;
+      memcpy(&pair, a + r * deep_align + p * C2NUM, sizeof(pair));
+      __m512i input = _mm512_set1_epi32(pair);
+#pragma GCC unroll 4
+      for (int j = 0; j < blocks; ++j) {
+        acc[r][j] = _mm512_dpbf16_ps(acc[r][j], (__m512bh)input, (__m512bh)weight[j]);
+      }
+    }
+  }
+#pragma GCC unroll 4
+  for (int j = 0; j < blocks; ++j) {
+    __mmask16 mask = j == blocks - 1 ? last_mask : 0xFFFF;
+    __m512 bias_value = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask, bias + j * C16NUM);
+#pragma GCC unroll 4
+    for (int r = 0; r < rows; ++r) {
+      __m512 value = Bf16ActAndRound(_mm512_add_ps(acc[r][j], bias_value), act_type);
+      _mm512_mask_storeu_ps(c + r * stride + j * C16NUM, mask, value);
+    }
+  }
+}
+
+#define BF16_TILE(ROWS, BLOCKS) \
+  MatmulBf16Avx512Tile(a, b, c, bias, act_type, deep_2, stride, last_mask, ROWS, BLOCKS)
+
+#define BF16_TILE_BLOCKS(ROWS) \
+  switch (blocks) {            \
+    case C1NUM:                \
+      BF16_TILE(ROWS, C1NUM);  \
+      break;                   \
+    case C2NUM:                \
+      BF16_TILE(ROWS, C2NUM);  \
+      break;                   \
+    case C3NUM:                \
+      BF16_TILE(ROWS, C3NUM);  \
+      break;                   \
+    default:                   \
+      BF16_TILE(ROWS, C4NUM);  \
+      break;                   \
+  }
+
+static void MatmulBf16Avx512Block(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                                  int deep_2, int stride, __mmask16 last_mask, int rows, int blocks) {
+  switch (rows) {
+    case C1NUM:
+      BF16_TILE_BLOCKS(C1NUM);
+      break;
+    case C2NUM:
+      BF16_TILE_BLOCKS(C2NUM);
+      break;
+    case C3NUM:
+      BF16_TILE_BLOCKS(C3NUM);
+      break;
+    default:
+      BF16_TILE_BLOCKS(C4NUM);
+      break;
+  }
+}
+
+void MatmulBf16Avx512(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride) {
+  int deep_2 = UP_DIV(deep, C2NUM);
+  int deep_align = deep_2 * C2NUM;
+  int block_stride = deep_2 * C32NUM;
+  int col_block = UP_DIV(col, C16NUM);
+  for (int j = 0; j < col_block; j += BF16_TILE_BLOCK) {
+    int blocks = MSMIN(BF16_TILE_BLOCK, col_block - j);
+    int tail = col - (j + blocks - 1) * C16NUM;
+    __mmask16 last_mask = tail >= C16NUM ? 0xFFFF : (__mmask16)((1u << tail) - 1);
+    const float *cur_bias = bias == NULL ? NULL : bias + j * C16NUM;
+    for (int r = 0; r < row; r += BF16_TILE_ROW) {
+      MatmulBf16Avx512Block(a + r * deep_align, b + j * block_stride, c + r * stride + j * C16NUM, cur_bias, act_type,
+                            deep_2, stride, last_mask, MSMIN(BF16_TILE_ROW, row - r), blocks);
+    }
+  }
+}
+#else
+void MatmulBf16Avx512(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride) {
+  MatmulBf16(a, b, c, bias, act_type, deep, row, col, stride);
+}
+#endif
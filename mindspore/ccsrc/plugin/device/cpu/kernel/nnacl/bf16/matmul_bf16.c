@@ -0,0 +1,78 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/matmul_bf16.h"
+#include "nnacl/bf16/cast_bf16.h"
+
+void PackMatmulWeightBf16(const float *src, uint16_t *dst, int deep, int col, bool transpose) {
+  int deep_2 = UP_DIV(deep, C2NUM);
+  int col_16 = UP_ROUND(col, C16NUM);
+  for (int c = 0; c < col_16; ++c) {
+    uint16_t *dst_col = dst + (c / C16NUM) * deep_2 * C32NUM + (c % C16NUM) * C2NUM;
+    for (int d = 0; d < deep_2 * C2NUM; ++d) {
+      float value = 0.0f;
+      if (c < col && d < deep) {
+        value = transpose ? src[c * deep + d] : src[d * col + c];
+      }
+      dst_col[(d / C2NUM) * C32NUM + (d % C2NUM)] = Fp32ToBf16(value);
+    }
+  }
+}
+
+void PackMatmulInputBf16(const float *src, uint16_t *dst, int row, int deep, bool transpose) {
+  int deep_align = UP_ROUND(deep, C2NUM);
+  for (int r = 0; r < row; ++r) {
+    uint16_t *dst_row = dst + r * deep_align;
+    if (transpose) {
+      for (int d = 0; d < deep; ++d) {
+        dst_row[d] = Fp32ToBf16(src[d * row + r]);
+      }
+    } else {
+      const float *src_row = src + r * deep;
+      for (int d = 0; d < deep; ++d) {
+        dst_row[d] = Fp32ToBf16(src_row[d]);
+      }
+    }
+    for (int d = deep; d < deep_align; ++d) {
+      dst_row[d] = 0;
+    }
+  }
+}
+
+void MatmulBf16(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                int col, int stride) {
+  int deep_2 = UP_DIV(deep, C2NUM);
+  int deep_align = deep_2 * C2NUM;
+  for (int r = 0; r < row; ++r) {
+    const uint16_t *a_row = a + r * deep_align;
+    for (int j = 0; j < col; ++j) {
+      const uint16_t *b_col = b + (j / C16NUM) * deep_2 * C32NUM + (j % C16NUM) * C2NUM;
+      float value = 0.0f;
+      for (int d = 0; d < deep_align; ++d) {
+        value += Bf16ToFp32(a_row[d]) * Bf16ToFp32(b_col[(d / C2NUM) * C32NUM + (d % C2NUM)]);
+      }
+      if (bias != NULL) {
+        value += bias[j];
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(value, 0.0f);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(value, 6.0f);
+      }
+      c[r * stride + j] = RoundFp32ToBf16(value);
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+#define MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+
+#include "nnacl/op_base.h"
+
+#define BF16_MATMUL_COL_TILE C16NUM
+#define BF16_MATMUL_DEEP_TILE C2NUM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+typedef void (*MatmulBf16Func)(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                               int deep, int row, int col, int stride);
+
+/* weight [deep][col], or [col][deep] when transpose is set => [col/16][deep/2][16][2] bf16,
+ * one deep pair of 16 columns is a single vdpbf16ps / 4 bfdot operand, col and deep are zero padded */
+void PackMatmulWeightBf16(const float *src, uint16_t *dst, int deep, int col, bool transpose);
+
+/* input [row][deep], or [deep][row] when transpose is set => [row][deep/2][2] bf16, deep is zero padded */
+void PackMatmulInputBf16(const float *src, uint16_t *dst, int row, int deep, bool transpose);
+
+/* c[row][col] = act(a * b + bias) rounded to bf16 precision, accumulated in fp32.
+ * b points at the first col16 block to compute and bias at its first column, c has a row stride of stride. */
+void MatmulBf16(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                int col, int stride);
+
+#ifdef ENABLE_AVX512
+/* vdpbf16ps kernel, the same as MatmulBf16 when the compiler does not know avx512-bf16 */
+void MatmulBf16Avx512(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride);
+#endif
+
+#ifdef ENABLE_ARM64
+/* armv8.6 bfdot kernel, the same as MatmulBf16 when the compiler does not know the bf16 extension */
+void MatmulBf16Neon64(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/matmul_bf16.h"
+#if defined(ENABLE_ARM64) && defined(__ARM_FEATURE_BF16_VECTOR_ARITHMETIC)
+#include <arm_neon.h>
+#include <string.h>
+
+#define BF16_NEON_TILE_ROW C4NUM
+
+static inline float32x4_t Bf16NeonActAndRound(float32x4_t value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = vmaxq_f32(value, vdupq_n_f32(0.0f));
+  }
+  if (act_type == ActType_Relu6) {
+    value = vminq_f32(value, vdupq_n_f32(6.0f));
+  }
+  bfloat16x4_t rounded = vcvt_bf16_f32(value);
+  return vreinterpretq_f32_u32(vshll_n_u16(vreinterpret_u16_bf16(rounded), C16NUM));
+}
+
+// rows x 16 columns, rows is a compile time constant after inlining so the accumulators stay in registers
+static inline __attribute__((always_inline)) void MatmulBf16NeonTile(const uint16_t *a, const uint16_t *b, float *c,
+                                                                     const float *bias, ActType act_type, int deep_2,
+                                                                     int stride, int cols, const int rows) {
+  int deep_align = deep_2 * C2NUM;
+  float32x4_t acc[BF16_NEON_TILE_ROW][C4NUM];
+#pragma GCC unroll 4
+  for (int r = 0; r < rows; ++r) {
+#pragma GCC unroll 4
+    for (int q = 0; q < C4NUM; ++q) {
+      acc[r][q] = vdupq_n_f32(0.0f);
+    }
+  }
+  int p = 0;
+  for (; p <= deep_2 - C4NUM; p += C4NUM) {
+    bfloat16x8_t input[BF16_NEON_TILE_ROW];
+#pragma GCC unroll 4
+    for (int r = 0; r < rows; ++r) {
+      input[r] = vld1q_bf16((const bfloat16_t *)(a + r * deep_align + p * C2NUM));
+    }
+#define BF16_NEON_LANE(LANE)                                                                                 \
+  do {                                                                                                       \
+    const bfloat16_t *weight_ptr = (const bfloat16_t *)(b + (p + (LANE)) * C32NUM);                          \
+    bfloat16x8_t weight[C4NUM] = {vld1q_bf16(weight_ptr), vld1q_bf16(weight_ptr + C8NUM),                    \
+                                  vld1q_bf16(weight_ptr + C16NUM), vld1q_bf16(weight_ptr + C24NUM)};         \
+    _Pragma("GCC unroll 4") for (int r = 0; r < rows; ++r) {                                                 \
+      _Pragma("GCC unroll 4") for (int q = 0; q < C4NUM; ++q) {                                              \
+        acc[r][q] = vbfdotq_laneq_f32(acc[r][q], weight[q], input[r], (LANE));                               \
+      }                                                                                                      \
+    }                                                                                                        \
+  } while (0)
+    BF16_NEON_LANE(0);
+    BF16_NEON_LANE(1);
+    BF16_NEON_LANE(2);
+    BF16_NEON_LANE(3);
+#undef BF16_NEON_LANE
+  }
+  for (; p < deep_2; ++p) {
+    const bfloat16_t *weight_ptr = (const bfloat16_t *)(b + p * C32NUM);
+    bfloat16x8_t weight[C4NUM] = {vld1q_bf16(weight_ptr), vld1q_bf16(weight_ptr + C8NUM),
+                                  vld1q_bf16(weight_ptr + C16NUM), vld1q_bf16(weight_ptr + C24NUM)};
+#pragma GCC unroll 4
+    for (int r = 0; r < rows; ++r) {
+      uint32_t pair;
+      memcpy(&pair, a + r * deep_align + p * C2NUM, sizeof(pair));
+      bfloat16x8_t input = vreinterpretq_bf16_u32(vdupq_n_u32(pair));
+#pragma GCC unroll 4
+      for (int q = 0; q < C4NUM; ++q) {
+        acc[r][q] = vbfdotq_laneq_f32(acc[r][q], weight[q], input, 0);
+      }
+    }
+  }
+  float32x4_t bias_value[C4NUM];
+  float bias_tail[C16NUM] = {0};
+  if (bias != NULL) {
+    memcpy(bias_tail, bias, cols * sizeof(float));
+  }
+#pragma GCC unroll 4
+  for (int q = 0; q < C4NUM; ++q) {
+    bias_value[q] = vld1q_f32(bias_tail + q * C4NUM);
+  }
+#pragma GCC unroll 4
+  for (int r = 0; r < rows; ++r) {
+    float out[C16NUM];
+#pragma GCC unroll 4
+    for (int q = 0; q < C4NUM; ++q) {
+      vst1q_f32(out + q * C4NUM, Bf16NeonActAndRound(vaddq_f32(acc[r][q], bias_value[q]), act_type));
+    }
+    memcpy(c + r * stride, out, cols * sizeof(float));
+  }
+}
+
+void MatmulBf16Neon64(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride) {
+  int deep_2 = UP_DIV(deep, C2NUM);
+  int deep_align = deep_2 * C2NUM;
+  int block_stride = deep_2 * C32NUM;
+  for (int j = 0; j < col; j += C16NUM) {
+    int cols = MSMIN(C16NUM, col - j);
+    const uint16_t *cur_b = b + (j / C16NUM) * block_stride;
+    const float *cur_bias = bias == NULL ? NULL : bias + j;
+    int r = 0;
+    for (; r <= row - BF16_NEON_TILE_ROW; r += BF16_NEON_TILE_ROW) {
+      MatmulBf16NeonTile(a + r * deep_align, cur_b, c + r * stride + j, cur_bias, act_type, deep_2, stride, cols,
+                         BF16_NEON_TILE_ROW);
+    }
+    for (; r < row; ++r) {
+      MatmulBf16NeonTile(a + r * deep_align, cur_b, c + r * stride + j, cur_bias, act_type, deep_2, stride, cols,
+                         C1NUM);
+    }
+  }
+}
+#elif defined(ENABLE_ARM64)
+void MatmulBf16Neon64(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride) {
+  MatmulBf16(a, b, c, bias, act_type, deep, row, col, stride);
+}
+#endif
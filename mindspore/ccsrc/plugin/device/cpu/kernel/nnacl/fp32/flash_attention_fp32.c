@@ -0,0 +1,193 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include <float.h>
+#include <string.h>
+#include "nnacl/flash_attention_fp32_simd.h"
+
+size_t FlashAttentionBufferSize(const ScaledDotProductAttentionParameter *param) {
+  // score tile, row max, row sum and the key tile transposed to [head_size, kv_block]
+  size_t buffer_size = (size_t)param->q_block_ * param->kv_block_ + C2NUM * (size_t)param->q_block_;
+  if (param->transpose_k_) {
+    buffer_size += (size_t)param->head_size_ * param->kv_block_;
+  }
+  return buffer_size;
+}
+
+static void FlashAttentionAxpy(const float *src, float *dst, float alpha, int num) {
+  int i = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionAxpy, i, src, dst, alpha, num);
+  for (; i < num; ++i) {
+    dst[i] += alpha * src[i];
+  }
+}
+
+static void FlashAttentionScale(float *dst, float alpha, int num) {
+  int i = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionScale, i, dst, alpha, num);
+  for (; i < num; ++i) {
+    dst[i] *= alpha;
+  }
+}
+
+static void FlashAttentionAdd(const float *src, float *dst, int num) {
+  int i = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionAdd, i, src, dst, num);
+  for (; i < num; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+static float FlashAttentionGetMax(const float *src, int num) {
+  float max = -FLT_MAX;
+  int i = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionGetMax, i, src, &max, num);
+  for (; i < num; ++i) {
+    max = src[i] > max ? src[i] : max;
+  }
+  return max;
+}
+
+static float FlashAttentionExpSum(float *dst, float max, int num) {
+  float exp_sum = 0.0f;
+  int i = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionExpSum, i, dst, max, &exp_sum, num);
+  for (; i < num; ++i) {
+    dst[i] = simd_exp32_f32(dst[i] - max);
+    exp_sum += dst[i];
+  }
+  return exp_sum;
+}
+
+static float FlashAttentionDot(const float *q, int head_size, const float *key, int key_stride) {
+  float acc = 0.0f;
+  for (int d = 0; d < head_size; ++d) {
+    acc += q[d] * key[d * key_stride];
+  }
+  return acc;
+}
+
+// score[rows][kv_num] = q[rows][head_size] * key[head_size][kv_num] * scale
+static void FlashAttentionScore(const float *q, int rows, int head_size, const float *key, int key_stride, float scale,
+                                float *score, int score_stride, int kv_num) {
+  int r = 0;
+  for (; r + C4NUM <= rows; r += C4NUM) {
+    const float *q_row = q + r * head_size;
+    float *score_row = score + r * score_stride;
+    int j = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionScore4, j, q_row, head_size, key, key_stride, scale, score_row, score_stride,
+                       kv_num);
+    for (; j < kv_num; ++j) {
+      for (int i = 0; i < C4NUM; ++i) {
+        float dot = FlashAttentionDot(q_row + i * head_size, head_size, key + j, key_stride);
+        score_row[i * score_stride + j] = dot * scale;
+      }
+    }
+  }
+  for (; r < rows; ++r) {
+    float *score_row = score + r * score_stride;
+    memset(score_row, 0, kv_num * sizeof(float));
+    for (int d = 0; d < head_size; ++d) {
+      FlashAttentionAxpy(key + d * key_stride, score_row, q[r * head_size + d] * scale, kv_num);
+    }
+  }
+}
+
+// out[rows][v_head_size] += p[rows][kv_num] * value[kv_num][v_head_size]
+static void FlashAttentionWeightedSum(const float *p, int p_stride, int rows, const float *value, int kv_num,
+                                      float *out, int v_head_size) {
+  int r = 0;
+  for (; r + C4NUM <= rows; r += C4NUM) {
+    const float *p_row = p + r * p_stride;
+    float *out_row = out + r * v_head_size;
+    int y = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionWeightedSum4, y, p_row, p_stride, value, kv_num, out_row, v_head_size,
+                       v_head_size);
+    for (; y < v_head_size; ++y) {
+      for (int i = 0; i < C4NUM; ++i) {
+        float acc = out_row[i * v_head_size + y];
+        for (int j = 0; j < kv_num; ++j) {
+          acc += p_row[i * p_stride + j] * value[j * v_head_size + y];
+        }
+        out_row[i * v_head_size + y] = acc;
+      }
+    }
+  }
+  for (; r < rows; ++r) {
+    for (int j = 0; j < kv_num; ++j) {
+      FlashAttentionAxpy(value + j * v_head_size, out + r * v_head_size, p[r * p_stride + j], v_head_size);
+    }
+  }
+}
+
+void FlashAttentionFp32(const float *q, const float *k, const float *v, const float *mask, int mask_row_stride,
+                        float *out, float *buf, int q_rows, const ScaledDotProductAttentionParameter *param) {
+  int k_seq = param->k_seq_;
+  int head_size = param->head_size_;
+  int v_head_size = param->v_head_size_;
+  int kv_block = param->kv_block_;
+  float *scores = buf;
+  float *row_max = scores + param->q_block_ * kv_block;
+  float *row_sum = row_max + param->q_block_;
+  float *key_tile = row_sum + param->q_block_;
+  for (int r = 0; r < q_rows; ++r) {
+    row_max[r] = -FLT_MAX;
+    row_sum[r] = 0.0f;
+  }
+  memset(out, 0, (size_t)q_rows * v_head_size * sizeof(float));
+
+  for (int kv_start = 0; kv_start < k_seq; kv_start += kv_block) {
+    int kv_num = MSMIN(kv_block, k_seq - kv_start);
+    // scores are accumulated over the rows of key laid out as [head_size, kv_num]
+    const float *key = k + kv_start;
+    int key_stride = k_seq;
+    if (param->transpose_k_) {
+      const float *key_src = k + kv_start * head_size;
+      for (int j = 0; j < kv_num; ++j) {
+        for (int d = 0; d < head_size; ++d) {
+          key_tile[d * kv_num + j] = key_src[j * head_size + d];
+        }
+      }
+      key = key_tile;
+      key_stride = kv_num;
+    }
+    FlashAttentionScore(q, q_rows, head_size, key, key_stride, param->scale_, scores, kv_block, kv_num);
+
+    // online softmax: what was accumulated with the old row max is rescaled before this tile is added
+    for (int r = 0; r < q_rows; ++r) {
+      float *score = scores + r * kv_block;
+      if (mask != NULL) {
+        FlashAttentionAdd(mask + r * mask_row_stride + kv_start, score, kv_num);
+      }
+      float tile_max = FlashAttentionGetMax(score, kv_num);
+      float new_max = MSMAX(row_max[r], tile_max);
+      float exp_sum = FlashAttentionExpSum(score, new_max, kv_num);
+      float correction = simd_exp32_f32(row_max[r] - new_max);
+      row_max[r] = new_max;
+      row_sum[r] = row_sum[r] * correction + exp_sum;
+      if (correction != 1.0f) {
+        FlashAttentionScale(out + r * v_head_size, correction, v_head_size);
+      }
+    }
+    FlashAttentionWeightedSum(scores, kv_block, q_rows, v + kv_start * v_head_size, kv_num, out, v_head_size);
+  }
+
+  for (int r = 0; r < q_rows; ++r) {
+    if (row_sum[r] > 0.0f) {
+      FlashAttentionScale(out + r * v_head_size, 1.0f / row_sum[r], v_head_size);
+    }
+  }
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+#define MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/attention_parameter.h"
+
+#define FLASH_ATTENTION_Q_BLOCK 32
+#define FLASH_ATTENTION_KV_BLOCK 128
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// float number of the per-thread workspace of FlashAttentionFp32
+size_t FlashAttentionBufferSize(const ScaledDotProductAttentionParameter *param);
+
+// out[q_rows, v_head_size] = softmax(q * k * scale + mask) * v of one head, the q_seq * k_seq score matrix is never
+// stored: key and value are streamed in kv_block_ rows and the softmax is rescaled online.
+// mask is the row of the first query, or NULL.
+void FlashAttentionFp32(const float *q, const float *k, const float *v, const float *mask, int mask_row_stride,
+                        float *out, float *buf, int q_rows, const ScaledDotProductAttentionParameter *param);
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
@@ -116,6 +116,7 @@
 #include "nnacl/infer/rfft_infer.h"
 #include "nnacl/infer/roi_pooling_infer.h"
 #include "nnacl/infer/scatter_nd_infer.h"
+#include "nnacl/infer/scaled_dot_product_attention_infer.h"
 #include "nnacl/infer/scatter_nd_update_infer.h"
 #include "nnacl/infer/select_infer.h"
 #include "nnacl/infer/sgd_infer.h"
@@ -335,6 +336,7 @@ void RegAllInferFunc4() {
   g_infer_func[PrimType_Round] = CommonInferShape;
   g_infer_func[PrimType_Rsqrt] = CommonInferShape;
   g_infer_func[PrimType_RsqrtGrad] = NULL;
+  g_infer_func[PrimType_ScaledDotProductAttention] = ScaledDotProductAttentionInferShape;
   g_infer_func[PrimType_ScaleFusion] = CommonInferShape;
   g_infer_func[PrimType_ScatterNd] = ScatterNdInferShape;
   g_infer_func[PrimType_ScatterNdUpdate] = ScatterNdUpdateInferShape;
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/infer/scaled_dot_product_attention_infer.h"
+#include "nnacl/infer/infer_register.h"
+#include "nnacl/attention_parameter.h"
+
+int ScaledDotProductAttentionInferShape(const TensorC *const *inputs, size_t inputs_size, TensorC **outputs,
+                                        size_t outputs_size, OpParameter *parameter) {
+  int check_ret = CheckAugmentWithMinSize(inputs, inputs_size, outputs, outputs_size, parameter, C3NUM, 1);
+  if (check_ret != NNACL_OK) {
+    return check_ret;
+  }
+  if (inputs_size > C4NUM) {
+    return NNACL_INPUT_TENSOR_ERROR;
+  }
+  const TensorC *q = inputs[FIRST_INPUT];
+  const TensorC *k = inputs[SECOND_INPUT];
+  const TensorC *v = inputs[THIRD_INPUT];
+  TensorC *output = outputs[FIRST_INPUT];
+  SetDataTypeFormat(output, q);
+  if (!InferFlag(inputs, inputs_size)) {
+    return NNACL_INFER_INVALID;
+  }
+  if (q->shape_size_ < C2NUM || k->shape_size_ != q->shape_size_ || v->shape_size_ != q->shape_size_) {
+    return NNACL_INPUT_TENSOR_ERROR;
+  }
+  // output is [batch..., q_seq, v_head_size]
+  SetShapeTensor(output, q);
+  output->shape_[output->shape_size_ - 1] = v->shape_[v->shape_size_ - 1];
+  return NNACL_OK;
+}
+
+REG_INFER(ScaledDotProductAttention, PrimType_ScaledDotProductAttention, ScaledDotProductAttentionInferShape)
@@ -0,0 +1,445 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/int8/matmul_avx512_int8.h"
+#include "nnacl/int8/matmul_int8.h"
+#ifdef ENABLE_AVX512_VNNI
+#include <immintrin.h>
+#include <string.h>
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+
+typedef struct Int8RequantArgs {
+  __m512i left_shift_;
+  __m512i right_shift_;
+  __m512i multiplier_;
+  __m512i output_zp_;
+  __m512i mini_;
+  __m512i maxi_;
+} Int8RequantArgs;
+
+static inline __mmask16 ColMask(size_t cols) {
+  return cols >= C16NUM ? (__mmask16)0xFFFF : (__mmask16)((1 << cols) - 1);
+}
+
+static inline void LoadRequantArgs(Int8RequantArgs *args, const int32_t *left_shift, const int32_t *right_shift,
+                                   const int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi,
+                                   size_t per_channel, size_t col_offset, __mmask16 mask) {
+  if (per_channel) {
+    args->left_shift_ = _mm512_maskz_loadu_epi32(mask, left_shift + col_offset);
+    args->right_shift_ = _mm512_maskz_loadu_epi32(mask, right_shift + col_offset);
+    args->multiplier_ = _mm512_maskz_loadu_epi32(mask, multiplier + col_offset);
+  } else {
+    args->left_shift_ = _mm512_set1_epi32(left_shift[0]);
+    args->right_shift_ = _mm512_set1_epi32(right_shift[0]);
+    args->multiplier_ = _mm512_set1_epi32(multiplier[0]);
+  }
+  args->output_zp_ = _mm512_set1_epi32(output_zp);
+  args->mini_ = _mm512_set1_epi32(mini);
+  args->maxi_ = _mm512_set1_epi32(maxi);
+}
+
+// The vectorized MultiplyByQuantizedMultiplier, adds the output zero point, clamps and stores 16 int8 values.
+static inline void RequantStore16(__m512i value, const Int8RequantArgs *args, int8_t *dst, __mmask16 mask) {
+  value = _mm512_sllv_epi32(value, args->left_shift_);
+
+  // SaturatingRoundingDoublingHighMul on the even and the odd lanes with 64-bit products
+  const __m512i rounding = _mm512_set1_epi64(1ll << 30);
+  __m512i even = _mm512_mul_epi32(value, args->multiplier_);
+  __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(value, 32), _mm512_srli_epi64(args->multiplier_, 32));
+  even = _mm512_srai_epi64(_mm512_add_epi64(even, rounding), 31);
+  odd = _mm512_slli_epi64(_mm512_srai_epi64(_mm512_add_epi64(odd, rounding), 31), 32);
+  __m512i high = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+  const __m512i int_min = _mm512_set1_epi32(INT32_MIN);
+  __mmask16 overflow =
+    _mm512_cmpeq_epi32_mask(value, int_min) & _mm512_cmpeq_epi32_mask(args->multiplier_, int_min);
+  high = _mm512_mask_mov_epi32(high, overflow, _mm512_set1_epi32(INT32_MAX));
+
+  // RoundingDivideByPOT, the right shift is stored as a non-positive exponent
+  const __m512i one = _mm512_set1_epi32(1);
+  __m512i exponent = _mm512_sub_epi32(_mm512_setzero_si512(), args->right_shift_);
+  __m512i pot_mask = _mm512_sub_epi32(_mm512_sllv_epi32(one, exponent), one);
+  __m512i remainder = _mm512_and_si512(high, pot_mask);
+  __m512i threshold = _mm512_srai_epi32(pot_mask, 1);
+  threshold = _mm512_mask_add_epi32(threshold, _mm512_cmplt_epi32_mask(high, _mm512_setzero_si512()), threshold, one);
+  __m512i result = _mm512_srav_epi32(high, exponent);
+  result = _mm512_mask_add_epi32(result, _mm512_cmpgt_epi32_mask(remainder, threshold), result, one);
+
+  result = _mm512_add_epi32(result, args->output_zp_);
+  result = _mm512_min_epi32(result, args->maxi_);
+  result = _mm512_max_epi32(result, args->mini_);
+  _mm_mask_storeu_epi8(dst, mask, _mm512_cvtepi32_epi8(result));
+}
+
+static inline __m512i BroadcastInt32(const int8_t *src) {
+  int32_t value;
+  memcpy(&value, src, sizeof(int32_t));
+  return _mm512_set1_epi32(value);
+}
+
+static inline __m256i BroadcastInt32Ymm(const int8_t *src) {
+  int32_t value;
+  memcpy(&value, src, sizeof(int32_t));
+  return _mm256_set1_epi32(value);
+}
+
+#ifdef ENABLE_AMX
+#define AMX_TILE_A 4
+#define AMX_TILE_B 5
+#define AMX_TILE_BYTES 1024
+
+typedef struct AmxTileConfig {
+  uint8_t palette_id_;
+  uint8_t start_row_;
+  uint8_t reserved_[14];
+  uint16_t colsb_[16];
+  uint8_t rows_[16];
+} AmxTileConfig;
+
+static void AmxDotBlock(const int8_t *a_tile, size_t a_stride, const int8_t *b, size_t deep_4, size_t deep_64,
+                        int block_num, int8_t *b_tail) {
+  // the tile registers are named by immediates, the unused accumulators are computed but never stored
+  _tile_zero(0);
+  _tile_zero(1);
+  _tile_zero(2);
+  _tile_zero(3);
+  for (size_t k = 0; k < deep_64; k += C64NUM) {
+    _tile_loadd(AMX_TILE_A, a_tile + k, a_stride);
+    for (int j = 0; j < block_num; j++) {
+      // a 64-deep step of a row4x16-major block is a 16x64 tile with the 4-byte pairs already interleaved
+      const int8_t *b_src = b + j * C16NUM * deep_4 + k * C16NUM;
+      if (k + C64NUM > deep_4) {
+        memset(b_tail, 0, AMX_TILE_BYTES);
+        memcpy(b_tail, b_src, (deep_4 - k) * C16NUM);
+        b_src = b_tail;
+      }
+      _tile_loadd(AMX_TILE_B, b_src, C64NUM);
+      switch (j) {
+        case 0:
+          _tile_dpbssd(0, AMX_TILE_A, AMX_TILE_B);
+          break;
+        case 1:
+          _tile_dpbssd(1, AMX_TILE_A, AMX_TILE_B);
+          break;
+        case 2:
+          _tile_dpbssd(2, AMX_TILE_A, AMX_TILE_B);
+          break;
+        default:
+          _tile_dpbssd(3, AMX_TILE_A, AMX_TILE_B);
+          break;
+      }
+    }
+  }
+}
+
+static void AmxStoreBlock(int j, int32_t *c_buf) {
+  switch (j) {
+    case 0:
+      _tile_stored(0, c_buf, C16NUM * sizeof(int32_t));
+      break;
+    case 1:
+      _tile_stored(1, c_buf, C16NUM * sizeof(int32_t));
+      break;
+    case 2:
+      _tile_stored(2, c_buf, C16NUM * sizeof(int32_t));
+      break;
+    default:
+      _tile_stored(3, c_buf, C16NUM * sizeof(int32_t));
+      break;
+  }
+}
+
+/* Runs 16x64 output blocks with tdpbssd, the A blocks are repacked to row-major 16 x deep_64 tiles in a_tile. */
+static void Amx4x16Impl(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                        size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                        int32_t maxi, size_t per_channel, const int32_t *filter_zp, int8_t *a_tile) {
+  size_t deep_64 = UP_ROUND(deep_4, C64NUM);
+  int8_t b_tail[AMX_TILE_BYTES] __attribute__((aligned(64)));
+  int32_t c_buf[C16NUM * C16NUM] __attribute__((aligned(64)));
+
+  AmxTileConfig config;
+  memset(&config, 0, sizeof(AmxTileConfig));
+  config.palette_id_ = 1;
+  for (int i = 0; i <= AMX_TILE_B; i++) {
+    config.rows_[i] = C16NUM;
+    config.colsb_[i] = C64NUM;
+  }
+  _tile_loadconfig(&config);
+
+  for (size_t r = 0; r < row; r += C16NUM) {
+    size_t cur_row = MSMIN(C16NUM, row - r);
+    memset(a_tile, 0, C16NUM * deep_64);
+    for (size_t rb = 0; rb < UP_DIV(cur_row, C4NUM); rb++) {
+      const int8_t *src = a + (r + rb * C4NUM) * deep_4;
+      for (size_t d = 0; d < deep_4 / C4NUM; d++) {
+        for (size_t r4 = 0; r4 < C4NUM; r4++) {
+          memcpy(a_tile + (rb * C4NUM + r4) * deep_64 + d * C4NUM, src + d * C16NUM + r4 * C4NUM, C4NUM);
+        }
+      }
+    }
+    for (size_t c = 0; c < col; c += C64NUM) {
+      int block_num = (int)MSMIN(UP_DIV(col - c, C16NUM), C4NUM);
+      AmxDotBlock(a_tile, deep_64, b + c * deep_4, deep_4, deep_64, block_num, b_tail);
+      for (int j = 0; j < block_num; j++) {
+        size_t col_offset = c + j * C16NUM;
+        __mmask16 mask = ColMask(col - col_offset);
+        Int8RequantArgs args;
+        LoadRequantArgs(&args, left_shift, right_shift, multiplier, output_zp, mini, maxi, per_channel, col_offset,
+                        mask);
+        __m512i bias_vec = _mm512_maskz_loadu_epi32(mask, bias + col_offset);
+        __m512i filter_zp_vec = per_channel ? _mm512_maskz_loadu_epi32(mask, filter_zp + col_offset) : bias_vec;
+        AmxStoreBlock(j, c_buf);
+        for (size_t i = 0; i < cur_row; i++) {
+          __m512i sum = _mm512_set1_epi32(input_sum[r + i]);
+          if (per_channel) {
+            sum = _mm512_mullo_epi32(sum, filter_zp_vec);
+          }
+          __m512i value = _mm512_add_epi32(_mm512_load_si512(c_buf + i * C16NUM), bias_vec);
+          RequantStore16(_mm512_sub_epi32(value, sum), &args, dst + (r + i) * stride + col_offset, mask);
+        }
+      }
+    }
+  }
+  _tile_release();
+}
+#endif
+
+// vpdpbusd multiplies unsigned bytes by signed bytes: the int8 input is flipped to uint8 (a + 128) and the extra
+// 128 * sum(b) of each column is subtracted again.
+static inline __attribute__((always_inline)) void Vnni4x16Block(
+  const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4, size_t stride,
+  const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift, const int32_t *right_shift,
+  const int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+  const int32_t *filter_zp, const int block_num) {
+  const __m512i sign_flip = _mm512_set1_epi32((int)0x80808080);
+  const size_t deep_div4 = deep_4 / C4NUM;
+  __m512i correction[C4NUM];
+  __m512i bias_vec[C4NUM];
+  __m512i filter_zp_vec[C4NUM];
+  __mmask16 mask[C4NUM];
+  Int8RequantArgs args[C4NUM];
+  for (int j = 0; j < block_num; j++) {
+    const int8_t *b_block = b + j * C16NUM * deep_4;
+    correction[j] = _mm512_setzero_si512();
+    for (size_t d = 0; d < deep_div4; d++) {
+      correction[j] = _mm512_dpbusd_epi32(correction[j], sign_flip, _mm512_loadu_si512(b_block + d * C64NUM));
+    }
+    mask[j] = ColMask(col - j * C16NUM);
+    bias_vec[j] = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask[j], bias + j * C16NUM), correction[j]);
+    filter_zp_vec[j] = per_channel ? _mm512_maskz_loadu_epi32(mask[j], filter_zp + j * C16NUM) : bias_vec[j];
+    LoadRequantArgs(&args[j], left_shift, right_shift, multiplier, output_zp, mini, maxi, per_channel, j * C16NUM,
+                    mask[j]);
+  }
+
+  for (size_t r = 0; r < row; r += C4NUM) {
+    const int8_t *a_block = a + r * deep_4;
+    __m512i acc[C4NUM][C4NUM];
+    for (int i = 0; i < C4NUM; i++) {
+      for (int j = 0; j < block_num; j++) {
+        acc[i][j] = _mm512_setzero_si512();
+      }
+    }
+    for (size_t d = 0; d < deep_div4; d++) {
+      __m512i b_vec[C4NUM];
+      for (int j = 0; j < block_num; j++) {
+        b_vec[j] = _mm512_loadu_si512(b + j * C16NUM * deep_4 + d * C64NUM);
+      }
+      for (int i = 0; i < C4NUM; i++) {
+        __m512i a_vec = _mm512_xor_si512(BroadcastInt32(a_block + d * C16NUM + i * C4NUM), sign_flip);
+        for (int j = 0; j < block_num; j++) {
+          acc[i][j] = _mm512_dpbusd_epi32(acc[i][j], a_vec, b_vec[j]);
+        }
+      }
+    }
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t i = 0; i < cur_row; i++) {
+      for (int j = 0; j < block_num; j++) {
+        __m512i sum = _mm512_set1_epi32(input_sum[r + i]);
+        if (per_channel) {
+          sum = _mm512_mullo_epi32(sum, filter_zp_vec[j]);
+        }
+        __m512i value = _mm512_sub_epi32(_mm512_add_epi32(acc[i][j], bias_vec[j]), sum);
+        RequantStore16(value, &args[j], dst + (r + i) * stride + j * C16NUM, mask[j]);
+      }
+    }
+  }
+}
+
+void MatMulInt8Avx512Vnni_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                 size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                 const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                 int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                 const int32_t *filter_zp) {
+  for (size_t c = 0; c < col; c += C64NUM) {
+    size_t cur_col = MSMIN(C64NUM, col - c);
+    const int8_t *cur_b = b + c * deep_4;
+    int8_t *cur_dst = dst + c;
+    const int32_t *cur_bias = bias + c;
+    const int32_t *cur_left = per_channel ? left_shift + c : left_shift;
+    const int32_t *cur_right = per_channel ? right_shift + c : right_shift;
+    const int32_t *cur_multiplier = per_channel ? multiplier + c : multiplier;
+    const int32_t *cur_filter_zp = per_channel ? filter_zp + c : filter_zp;
+    switch (UP_DIV(cur_col, C16NUM)) {
+      case 1:
+        Vnni4x16Block(a, cur_b, cur_dst, row, cur_col, deep_4, stride, input_sum, cur_bias, cur_left, cur_right,
+                      cur_multiplier, output_zp, mini, maxi, per_channel, cur_filter_zp, 1);
+        break;
+      case 2:
+        Vnni4x16Block(a, cur_b, cur_dst, row, cur_col, deep_4, stride, input_sum, cur_bias, cur_left, cur_right,
+                      cur_multiplier, output_zp, mini, maxi, per_channel, cur_filter_zp, 2);
+        break;
+      case 3:
+        Vnni4x16Block(a, cur_b, cur_dst, row, cur_col, deep_4, stride, input_sum, cur_bias, cur_left, cur_right,
+                      cur_multiplier, output_zp, mini, maxi, per_channel, cur_filter_zp, 3);
+        break;
+      default:
+        Vnni4x16Block(a, cur_b, cur_dst, row, cur_col, deep_4, stride, input_sum, cur_bias, cur_left, cur_right,
+                      cur_multiplier, output_zp, mini, maxi, per_channel, cur_filter_zp, 4);
+        break;
+    }
+  }
+}
+
+size_t MatMulInt8AmxBufferSize(size_t row, size_t deep_4) {
+#ifdef ENABLE_AMX
+  if (X86_Amx_Support() && row >= C16NUM && deep_4 >= C64NUM) {
+    return C16NUM * UP_ROUND(deep_4, C64NUM);
+  }
+#endif
+  return 0;
+}
+
+void MatMulInt8Amx_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp, int8_t *buffer) {
+#ifdef ENABLE_AMX
+  if (buffer != NULL && MatMulInt8AmxBufferSize(row, deep_4) > 0) {
+    Amx4x16Impl(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier, output_zp,
+                mini, maxi, per_channel, filter_zp, buffer);
+    return;
+  }
+#endif
+  MatMulInt8Avx512Vnni_4x16_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift,
+                              multiplier, output_zp, mini, maxi, per_channel, filter_zp);
+}
+
+static inline __attribute__((always_inline)) void Vnni8x8Block(
+  const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4, size_t stride,
+  const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift, const int32_t *right_shift,
+  const int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel, size_t col_offset,
+  const int block_num) {
+  const __m256i sign_flip = _mm256_set1_epi32((int)0x80808080);
+  const size_t deep_div4 = deep_4 / C4NUM;
+  const size_t row_8 = UP_ROUND(row, C8NUM);
+  const int8_t *b_block[C2NUM] = {b, b + C8NUM * deep_4};
+  __m256i correction[C2NUM] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+  for (int j = 0; j < block_num; j++) {
+    for (size_t d = 0; d < deep_div4; d++) {
+      __m256i b_vec = _mm256_loadu_si256((__m256i *)(b_block[j] + d * C32NUM));
+      correction[j] = _mm256_dpbusd_epi32(correction[j], sign_flip, b_vec);
+    }
+  }
+  __mmask16 mask = ColMask(col);
+  __m512i bias_vec =
+    _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask, bias + col_offset),
+                     _mm512_inserti64x4(_mm512_castsi256_si512(correction[0]), correction[1], 1));
+  Int8RequantArgs args;
+  LoadRequantArgs(&args, left_shift, right_shift, multiplier, output_zp, mini, maxi, per_channel, col_offset, mask);
+  const int32_t *sum_block = input_sum + (col_offset / C8NUM) * row_8 * C8NUM;
+
+  for (size_t r = 0; r < row; r += C8NUM) {
+    const int8_t *a_block = a + r * deep_4;
+    __m256i acc[C8NUM][C2NUM];
+    for (int i = 0; i < C8NUM; i++) {
+      for (int j = 0; j < block_num; j++) {
+        acc[i][j] = _mm256_setzero_si256();
+      }
+    }
+    for (size_t d = 0; d < deep_div4; d++) {
+      __m256i b_vec[C2NUM];
+      for (int j = 0; j < block_num; j++) {
+        b_vec[j] = _mm256_loadu_si256((__m256i *)(b_block[j] + d * C32NUM));
+      }
+      for (int i = 0; i < C8NUM; i++) {
+        __m256i a_vec = _mm256_xor_si256(BroadcastInt32Ymm(a_block + d * C32NUM + i * C4NUM), sign_flip);
+        for (int j = 0; j < block_num; j++) {
+          acc[i][j] = _mm256_dpbusd_epi32(acc[i][j], a_vec, b_vec[j]);
+        }
+      }
+    }
+    size_t cur_row = MSMIN(C8NUM, row - r);
+    for (size_t i = 0; i < cur_row; i++) {
+      __m256i acc_high = block_num > 1 ? acc[i][1] : _mm256_setzero_si256();
+      __m512i value = _mm512_inserti64x4(_mm512_castsi256_si512(acc[i][0]), acc_high, 1);
+      __m512i sum;
+      if (per_channel) {
+        // the per-channel input sums are stored in row x 8 blocks of the output channels
+        __m256i sum_low = _mm256_loadu_si256((__m256i *)(sum_block + (r + i) * C8NUM));
+        __m256i sum_high = block_num > 1 ? _mm256_loadu_si256((__m256i *)(sum_block + (row_8 + r + i) * C8NUM))
+                                         : _mm256_setzero_si256();
+        sum = _mm512_inserti64x4(_mm512_castsi256_si512(sum_low), sum_high, 1);
+      } else {
+        sum = _mm512_set1_epi32(input_sum[r + i]);
+      }
+      value = _mm512_sub_epi32(_mm512_add_epi32(value, bias_vec), sum);
+      RequantStore16(value, &args, dst + (r + i) * stride + col_offset, mask);
+    }
+  }
+}
+
+void MatMulInt8Avx512Vnni_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                                const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                                int32_t maxi, size_t per_channel) {
+  for (size_t c = 0; c < col; c += C16NUM) {
+    size_t cur_col = MSMIN(C16NUM, col - c);
+    if (cur_col > C8NUM) {
+      Vnni8x8Block(a, b + c * deep_4, dst, row, cur_col, deep_4, stride, input_sum, bias, left_shift, right_shift,
+                   multiplier, output_zp, mini, maxi, per_channel, c, 2);
+    } else {
+      Vnni8x8Block(a, b + c * deep_4, dst, row, cur_col, deep_4, stride, input_sum, bias, left_shift, right_shift,
+                   multiplier, output_zp, mini, maxi, per_channel, c, 1);
+    }
+  }
+}
+#else
+void MatMulInt8Avx512Vnni_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                 size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                 const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                 int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                 const int32_t *filter_zp) {
+  MatMulInt8_4x16_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                    output_zp, mini, maxi, per_channel, filter_zp);
+}
+
+void MatMulInt8Avx512Vnni_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                                const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                                int32_t maxi, size_t per_channel) {
+  MatMulInt8_8x8_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier, output_zp,
+                   mini, maxi, per_channel);
+}
+
+size_t MatMulInt8AmxBufferSize(size_t row, size_t deep_4) { return 0; }
+
+void MatMulInt8Amx_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp, int8_t *buffer) {
+  MatMulInt8_4x16_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                    output_zp, mini, maxi, per_channel, filter_zp);
+}
+#endif
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_INT8_MATMUL_AVX512_INT8_H_
+#define MINDSPORE_NNACL_INT8_MATMUL_AVX512_INT8_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* row4x4-major * row4x16-major => (int8)row-major, the same layout as MatMulInt8_4x16_r.
+ * AVX512-VNNI vpdpbusd kernel. */
+void MatMulInt8Avx512Vnni_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                 size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                 const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                 int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                 const int32_t *filter_zp);
+
+/* The scratch bytes one MatMulInt8Amx_4x16_r call needs, 0 when the build, the cpu or the shape does not use AMX. */
+size_t MatMulInt8AmxBufferSize(size_t row, size_t deep_4);
+
+/* MatMulInt8Avx512Vnni_4x16_r on AMX tiles, the A blocks are repacked into buffer of MatMulInt8AmxBufferSize bytes.
+ * Runs the VNNI kernel when buffer is NULL or AMX is not used for the shape. */
+void MatMulInt8Amx_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp, int8_t *buffer);
+
+/* row8x4-major * row4x8-major => (int8)row-major, the same layout as MatMulInt8_8x8_r. */
+void MatMulInt8Avx512Vnni_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                                const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                                int32_t maxi, size_t per_channel);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_INT8_MATMUL_AVX512_INT8_H_
@@ -20,6 +20,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(ENABLE_AMX) && defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ARCH_REQ_XCOMP_PERM 0x1023
+#define XFEATURE_XTILEDATA 18
+#endif
 #include "nnacl/errorcode.h"
 
 typedef unsigned int DWORD;
@@ -28,6 +34,9 @@ struct X86CpuInfoContext {
   bool sse4_1_flag_;
   bool avx2_flag_;
   bool avx512_flag_;
+  bool avx512_vnni_flag_;
+  bool amx_flag_;
+  bool avx512_bf16_flag_;
 };
 
 static struct X86CpuInfoContext g_x86_cpu_info_context_;
@@ -58,6 +67,30 @@ inline const bool X86_Avx512_Support(void) {
 #endif
 }
 
+inline const bool X86_Avx512Vnni_Support(void) {
+#ifdef ENABLE_AVX512_VNNI
+  return g_x86_cpu_info_context_.avx512_vnni_flag_;
+#else
+  return false;
+#endif
+}
+
+inline const bool X86_Amx_Support(void) {
+#ifdef ENABLE_AMX
+  return g_x86_cpu_info_context_.amx_flag_;
+#else
+  return false;
+#endif
+}
+
+inline const bool X86_Avx512Bf16_Support(void) {
+#ifdef ENABLE_AVX512_BF16
+  return g_x86_cpu_info_context_.avx512_bf16_flag_;
+#else
+  return false;
+#endif
+}
+
 void ExecuteCpuIdCmd(DWORD cmd_code, DWORD *eax_data, DWORD *ebx_data, DWORD *ecx_data, DWORD *edx_data) {
   DWORD deax, debx, decx, dedx;
   asm volatile(
@@ -78,6 +111,28 @@ void ExecuteCpuIdCmd(DWORD cmd_code, DWORD *eax_data, DWORD *ebx_data, DWORD *ec
   *edx_data = dedx;
 }
 
+// the same as ExecuteCpuIdCmd, but selects the sub-leaf with ecx
+static void ExecuteCpuIdSubLeafCmd(DWORD cmd_code, DWORD sub_leaf, DWORD *eax_data, DWORD *ebx_data, DWORD *ecx_data,
+                                   DWORD *edx_data) {
+  DWORD deax, debx, decx, dedx;
+  asm volatile(
+    "movl %4, %%eax;\n"
+    "movl %5, %%ecx;\n"
+    "cpuid;\n"
+    "movl %%eax, %0;\n"
+    "movl %%ebx, %1;\n"
+    "movl %%ecx, %2;\n"
+    "movl %%edx, %3;\n"
+    : "=r"(deax), "=r"(debx), "=r"(decx), "=r"(dedx)
+    : "r"(cmd_code), "r"(sub_leaf)
+    : "%eax", "%ebx", "%ecx", "%edx");
+
+  *eax_data = deax;
+  *ebx_data = debx;
+  *ecx_data = decx;
+  *edx_data = dedx;
+}
+
 bool IsIntelX86Platform(void) {
   DWORD eax_data, ebx_data, ecx_data, edx_data;
 
@@ -109,6 +164,23 @@ int IntelX86CpuInfoInit(void) {
   ExecuteCpuIdCmd(7, &eax_data, &ebx_data, &ecx_data, &edx_data);  // eax = 7, execute cpuid to get avx2/avx512 flag
   g_x86_cpu_info_context_.avx2_flag_ = (ebx_data & (1 << 5)) == 0 ? false : true;     // avx2 flag is ecx 5 bit
   g_x86_cpu_info_context_.avx512_flag_ = (ebx_data & (1 << 16)) == 0 ? false : true;  // avx512 flag is ecx 16 bit
+  // vpdpbusd needs avx512_vnni (ecx 11 bit), the masked int8 stores need avx512bw (ebx 30 bit) and avx512vl (ebx 31)
+  g_x86_cpu_info_context_.avx512_vnni_flag_ = g_x86_cpu_info_context_.avx512_flag_ && (ecx_data & (1u << 11)) != 0 &&
+                                              (ebx_data & (1u << 30)) != 0 && (ebx_data & (1u << 31)) != 0;
+  // amx-tile is edx 24 bit and amx-int8 is edx 25 bit, the tile data state must be granted by the kernel before use
+  g_x86_cpu_info_context_.amx_flag_ = false;
+#if defined(ENABLE_AMX) && defined(__linux__)
+  if (g_x86_cpu_info_context_.avx512_vnni_flag_ && (edx_data & (1u << 24)) != 0 && (edx_data & (1u << 25)) != 0) {
+    g_x86_cpu_info_context_.amx_flag_ = syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) == 0;
+  }
+#endif
+  // avx512_bf16 is eax 5 bit of the leaf 7 sub-leaf 1
+  DWORD max_sub_leaf = eax_data;
+  g_x86_cpu_info_context_.avx512_bf16_flag_ = false;
+  if (max_sub_leaf >= 1 && g_x86_cpu_info_context_.avx512_flag_ && (ebx_data & (1u << 30)) != 0) {
+    ExecuteCpuIdSubLeafCmd(7, 1, &eax_data, &ebx_data, &ecx_data, &edx_data);
+    g_x86_cpu_info_context_.avx512_bf16_flag_ = (eax_data & (1u << 5)) != 0;
+  }
 
   return NNACL_OK;
 }
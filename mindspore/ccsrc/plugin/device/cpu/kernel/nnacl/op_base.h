@@ -521,8 +521,9 @@ enum PrimType {
   PrimType_GroupNormFusion = 211,
   PrimType_Log1p = 212,
   PrimType_TensorScatterAdd = 213,
+  PrimType_ScaledDotProductAttention = 214,
   PrimType_MIN = PrimType_NONE,
-  PrimType_MAX = PrimType_TensorScatterAdd + 1,
+  PrimType_MAX = PrimType_ScaledDotProductAttention + 1,
 
   // inner operators.
   PrimType_Inner_ToFormat = 10000,
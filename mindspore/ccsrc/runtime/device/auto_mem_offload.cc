@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 #include <queue>
+#include <algorithm>
 #include "runtime/hardware/device_context.h"
 #include "runtime/device/memory_offload_strategy.h"
 
@@ -73,6 +74,15 @@ void AutoMemoryOffload::Free(const void *key) {
 void *AutoMemoryOffload::Get(const void *key, void *stream, const HashSet<const void *> &pinned_memory) {
   auto iter = mem_result_.find(key);
   if (iter != mem_result_.end()) {
+    const auto &async_iter = async_swap_in_keys_.find(key);
+    if (async_iter != async_swap_in_keys_.end()) {
+      const auto &host_iter = swap_host_ptr_.find(key);
+      if (host_iter != swap_host_ptr_.end()) {
+        mem_handler_->FreeHost(host_iter->second);
+        (void)swap_host_ptr_.erase(host_iter);
+      }
+      (void)async_swap_in_keys_.erase(async_iter);
+    }
     return iter->second;
   }
   if (stream == nullptr) {
@@ -168,6 +178,30 @@ bool AutoMemoryOffload::TryAllocMemory(
   if (stream == nullptr) {
     return false;
   }
+  if (next_use_func_ != nullptr) {
+    // Offload the memory used latest first, the larger one first if they are used in the same step.
+    using KeyNextUsePair = std::pair<const void *, size_t>;
+    std::vector<KeyNextUsePair> mem_can_offload;
+    for (const auto &i : mem_result_) {
+      const auto offload_key = i.first;
+      if (pinned_memory.count(offload_key) == 0) {
+        (void)mem_can_offload.emplace_back(offload_key, next_use_func_(offload_key));
+      }
+    }
+    std::sort(mem_can_offload.begin(), mem_can_offload.end(),
+              [this](const KeyNextUsePair &a, const KeyNextUsePair &b) {
+                return a.second != b.second ? a.second > b.second : GetMemSize(a.first) > GetMemSize(b.first);
+              });
+    for (const auto &mem : mem_can_offload) {
+      const auto offload_mem_key = mem.first;
+      SwapOut(offload_mem_key, stream);
+      Free(offload_mem_key);
+      if (alloc_func(info, mem_handler_, &mem_result_, &mem_size_)) {
+        return true;
+      }
+    }
+    return false;
+  }
   using KeySizePair = std::pair<const void *, size_t>;
   auto less = [](const KeySizePair &a, const KeySizePair &b) -> bool { return a.second < b.second; };
   std::priority_queue<KeySizePair, std::vector<KeySizePair>, decltype(less)> mem_can_offload(less);
@@ -214,6 +248,8 @@ void AutoMemoryOffload::SwapOut(const void *key, void *stream) {
     return;
   }
   const auto device_ptr = iter->second;
+  // The host memory of the async swap in is reused, the copy to it is ordered after the swap in.
+  (void)async_swap_in_keys_.erase(key);
   GetOrMallocHostPtr(key, mem_size, &host_ptr, &from_init);
   MS_EXCEPTION_IF_NULL(host_ptr);
   auto updated_iter = from_init ? updated_device_mem_.find(key) : updated_device_mem_.end();
@@ -225,7 +261,7 @@ void AutoMemoryOffload::SwapOut(const void *key, void *stream) {
   }
 }
 
-void *AutoMemoryOffload::SwapIn(const void *key, void *stream) {
+void *AutoMemoryOffload::SwapIn(const void *key, void *stream, bool async) {
   MS_EXCEPTION_IF_NULL(mem_handler_);
   const size_t mem_size = GetMemSize(key);
   const auto &iter = mem_result_.find(key);
@@ -236,6 +272,13 @@ void *AutoMemoryOffload::SwapIn(const void *key, void *stream) {
   void *host_ptr = nullptr;
   GetHostPtr(key, &host_ptr, &from_init);
   MS_EXCEPTION_IF_NULL(host_ptr);
+  if (async) {
+    mem_handler_->SwapInAsync(host_ptr, iter->second, mem_size, stream);
+    if (!from_init) {
+      (void)async_swap_in_keys_.insert(key);
+    }
+    return iter->second;
+  }
   mem_handler_->SwapIn(host_ptr, iter->second, mem_size, stream);
   if (!from_init) {
     mem_handler_->FreeHost(host_ptr);
@@ -295,6 +338,7 @@ void AutoMemoryOffload::Clear() {
     }
   }
   swap_host_ptr_.clear();
+  async_swap_in_keys_.clear();
   init_host_ptr_.clear();
   init_from_host_keys_.clear();
 }
@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <shared_mutex>
 
 #include "runtime/device/memory_manager.h"
@@ -56,6 +57,9 @@ class MemHandler {
   void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
     memory_manager_->SwapIn(host_ptr, device_ptr, mem_size, stream);
   }
+  void SwapInAsync(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+    memory_manager_->SwapInAsync(host_ptr, device_ptr, mem_size, stream);
+  }
   void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) {
     memory_manager_->SwapOut(device_ptr, host_ptr, mem_size, stream);
   }
@@ -80,10 +84,14 @@ class BACKEND_EXPORT AutoMemoryOffload {
   void Clear();
   void SetInitHostPtr(const void *key, void *host_ptr, size_t mem_size);
   void UpdateHighPriorityMem(const void *key);
+  // Set the function to get the step where the memory of the key is used next. If set, the memory used latest is
+  // offloaded first when the device memory is not enough.
+  void set_next_use_func(const std::function<size_t(const void *)> &next_use_func) { next_use_func_ = next_use_func; }
 
   void SwapOut(const void *key, void *stream);
-  // Return the device ptr where the data is copied to
-  void *SwapIn(const void *key, void *stream);
+  // Return the device ptr where the data is copied to. The host memory of the async swap in is kept until the device
+  // memory is got, since the copy may not be finished before that.
+  void *SwapIn(const void *key, void *stream, bool async = false);
 
  private:
   size_t GetMemSize(const void *key);
@@ -102,6 +110,8 @@ class BACKEND_EXPORT AutoMemoryOffload {
   HashSet<const void *> continuous_mem_key_;
   HashMap<const void *, void *> init_host_ptr_;
   HashMap<const void *, void *> swap_host_ptr_;
+  HashSet<const void *> async_swap_in_keys_;
+  std::function<size_t(const void *)> next_use_func_{nullptr};
 };
 
 class BACKEND_EXPORT MindRTAutoOffloadAdapter {
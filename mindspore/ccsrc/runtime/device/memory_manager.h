@@ -67,6 +67,10 @@ class BACKEND_EXPORT MemoryManager {
   virtual void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
     MS_LOG(INFO) << "Call default swap in " << host_ptr << "," << device_ptr << "," << mem_size << "," << stream;
   }
+  // Swap in without waiting for the copy, the copy is ordered before the kernels launched to the stream later.
+  virtual void SwapInAsync(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+    SwapIn(host_ptr, device_ptr, mem_size, stream);
+  }
   virtual void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) {
     MS_LOG(INFO) << "Call default swap out " << host_ptr << "," << device_ptr << "," << mem_size << "," << stream;
   }
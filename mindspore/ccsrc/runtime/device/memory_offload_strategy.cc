@@ -26,6 +26,8 @@ namespace mindspore {
 namespace device {
 constexpr size_t kFirstGetMemEventIndex = 1;
 constexpr size_t kInitOrMallocMemEventIndex = 0;
+// The memory swapped in ahead of use stays in device for the steps in between, so limit how early it is swapped in.
+constexpr size_t kMaxSwapInAheadSpan = 3;
 
 MemoryOffloadConflict &MemoryOffloadConflict::GetInstance() {
   static MemoryOffloadConflict instance = MemoryOffloadConflict();
@@ -76,6 +78,23 @@ MemEventPtrList<Key> &MemOffloadStrategy<Key>::GetPostComputeEvents(size_t index
   return post_compute_events_[index];
 }
 
+template <typename Key>
+size_t MemOffloadStrategy<Key>::GetNextUseIndex(Key key, size_t index) const {
+  const auto &iter = mem_events_.find(key);
+  if (iter == mem_events_.end() || iter->second.size() <= kFirstGetMemEventIndex) {
+    return SIZE_MAX;
+  }
+  const auto &mem_events = iter->second;
+  const auto &next_event = std::lower_bound(
+    mem_events.begin() + kFirstGetMemEventIndex, mem_events.end(), index,
+    [](const MemEventPtr<Key> &event, size_t cur_index) { return event->index < cur_index; });
+  if (next_event != mem_events.end()) {
+    return (*next_event)->index;
+  }
+  // High priority memory is used again by the next execution of the graph.
+  return IsHighPriorityMem(key) ? mem_events[kFirstGetMemEventIndex]->index + total_compute_index_ : SIZE_MAX;
+}
+
 template <typename Key>
 void MemOffloadStrategy<Key>::Execute() {
   CountMemUsage();
@@ -195,6 +214,7 @@ void MemOffloadStrategy<Key>::GenEventSpan() {
 template <typename Key>
 void MemOffloadStrategy<Key>::GenSwapEventSet() {
   swap_events_.clear();
+  planned_mem_used_.clear();
   // manual offload strategy
   if (!manual_offload_keys_.empty()) {
     for (const auto &iter : event_span_) {
@@ -230,6 +250,32 @@ void MemOffloadStrategy<Key>::GenSwapEventSet() {
     auto span = iter.second.second;
     AddToSwapEventSetIfOutOfMem(event, span, &cur_mem_used);
   }
+  planned_mem_used_.swap(cur_mem_used);
+}
+
+template <typename Key>
+size_t MemOffloadStrategy<Key>::GetSwapInIndex(const MemEventPtr<Key> &event, size_t pre_index, size_t mem_size) {
+  MS_EXCEPTION_IF_NULL(event);
+  MS_EXCEPTION_IF_NULL(continuous_mem_info_helper_);
+  // The memory allocated by the continuous memory alloc event can not be swapped in earlier.
+  if (planned_mem_used_.size() != total_compute_index_ || continuous_mem_info_helper_->IsContinuousMem(event->key)) {
+    return event->index;
+  }
+  // Keep at least one step between the swap out and the swap in, and do not swap in before the start of the graph.
+  const size_t span = GetSpanBetweenMemEvents(pre_index, event->index);
+  const size_t max_ahead_span = span > 1 ? std::min({span - 2, kMaxSwapInAheadSpan, event->index}) : 0;
+  size_t swap_in_index = event->index;
+  for (size_t ahead_span = 1; ahead_span <= max_ahead_span; ++ahead_span) {
+    const size_t cur_index = event->index - ahead_span;
+    if (planned_mem_used_[cur_index] + mem_size > mem_size_) {
+      break;
+    }
+    swap_in_index = cur_index;
+  }
+  for (size_t cur_index = swap_in_index; cur_index < event->index; ++cur_index) {
+    planned_mem_used_[cur_index] += mem_size;
+  }
+  return swap_in_index;
 }
 
 template <typename Key>
@@ -442,10 +488,12 @@ void MemOffloadStrategy<Key>::GenComputeMemEvents() {
         (void)post_compute_events_[pre_index].emplace_back(swap_out_event);
         // avoid swap-in-event follow init-event
         if (i != kFirstGetMemEventIndex || first_event->type != kInit) {
-          auto swap_in_event = std::make_shared<MemEvent<Key>>(kSwapIn, event->index);
+          // Swap in ahead of use if the memory is enough, so that the copy is overlapped with the computing.
+          const size_t swap_in_index = GetSwapInIndex(event, pre_index, first_event->mem_size);
+          auto swap_in_event = std::make_shared<MemEvent<Key>>(kSwapIn, swap_in_index);
           swap_in_event->key = item.first;
           swap_in_event->mem_size = first_event->mem_size;
-          (void)pre_compute_events_[event->index].emplace_back(swap_in_event);
+          (void)pre_compute_events_[swap_in_index].emplace_back(swap_in_event);
         }
       }
       if (event->index < pre_compute_events_.size()) {
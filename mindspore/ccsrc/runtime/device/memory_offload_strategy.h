@@ -175,6 +175,9 @@ class MemOffloadStrategy {
 
   bool need_swap() const { return need_swap_; }
 
+  // Get the index of the step where the memory of the key is used next since the step of index.
+  size_t GetNextUseIndex(Key key, size_t index) const;
+
   std::vector<ContinuousMemInfoPtr<Key>> GetContinuousMemAllocInfo(size_t index) {
     return continuous_mem_info_helper_->GetContinuousMemAllocInfo(index);
   }
@@ -196,6 +199,8 @@ class MemOffloadStrategy {
 
   void GenFreeEvent(const MemEventPtr<Key> &last_event);
 
+  size_t GetSwapInIndex(const MemEventPtr<Key> &event, size_t pre_index, size_t mem_size);
+
   void AddToSwapEventSetIfOutOfMem(const MemEventPtr<Key> &mem_event, size_t span, std::vector<size_t> *mem_used);
 
   void GenContinuousMemSwapEvent(const ContinuousMemInfoPtr<Key> &continuous_mem_info, std::vector<size_t> *mem_used,
@@ -233,6 +238,8 @@ class MemOffloadStrategy {
   std::multimap<size_t, std::pair<MemEventPtr<Key>, size_t>> event_span_;
   std::set<MemEventPtr<Key>> swap_events_;
   std::vector<size_t> min_mem_used_;
+  // The memory used in each step with the swap events, used to swap in memory ahead of the step it is used.
+  std::vector<size_t> planned_mem_used_;
   size_t mem_used_without_swap_{0};
   size_t min_mem_needed_{0};
   std::shared_ptr<ContinuousMemInfoHelper<Key>> continuous_mem_info_helper_{nullptr};
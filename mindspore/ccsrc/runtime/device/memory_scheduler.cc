@@ -164,7 +164,8 @@ bool MemScheduler::PreComputeSwapIn(const MemEventPtr<const void *> &event, void
   if (Malloc(event, stream) == nullptr) {
     return false;
   }
-  return auto_mem_offload_->SwapIn(event->key, stream) != nullptr;
+  // The swap in event may be ahead of the step the memory is used, no need to wait for the copy.
+  return auto_mem_offload_->SwapIn(event->key, stream, true) != nullptr;
 }
 
 bool MemScheduler::PreComputeGet(const MemEventPtr<const void *> &event, void *stream) {
@@ -240,6 +241,8 @@ void MemScheduler::OptMemUsage(float mem_used_factor) {
       updated_ = true;
     }
   }
+  auto_mem_offload_->set_next_use_func(
+    [this](const void *key) { return strategy_->GetNextUseIndex(key, current_step_); });
 
   auto available_mem_size = mem_handler_->GetAvailableMemSize();
   available_mem_size = FloatToSize(available_mem_size * mem_used_factor);
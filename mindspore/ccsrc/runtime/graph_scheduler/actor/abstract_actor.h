@@ -60,7 +60,8 @@ class AbstractActor : public OpActor<DeviceTensor> {
         running_dependent_msg_num_(0),
         parent_fusion_actor_{nullptr},
         memory_alloc_insert_position_{nullptr},
-        memory_free_insert_position_{nullptr} {}
+        memory_free_insert_position_{nullptr},
+        trace_name_id_(ActorProfiler::enable() ? ActorProfiler::GetInstance().RegisterName(name) : 0) {}
   ~AbstractActor() override = default;
 
   bool IsActive(int msg_num) override { return msg_num >= running_dependent_msg_num_ ? true : false; }
@@ -96,6 +97,7 @@ class AbstractActor : public OpActor<DeviceTensor> {
   const std::unordered_set<std::string> &dependent_actors() const { return dependent_actors_; }
   AbstractActor *memory_alloc_insert_position() const { return memory_alloc_insert_position_; }
   AbstractActor *memory_free_insert_position() const { return memory_free_insert_position_; }
+  uint32_t trace_name_id() const { return trace_name_id_; }
 
  protected:
   friend class GraphScheduler;
@@ -182,6 +184,9 @@ class AbstractActor : public OpActor<DeviceTensor> {
   // The information used for integration of dynamic and static memory.
   AbstractActor *memory_alloc_insert_position_;
   AbstractActor *memory_free_insert_position_;
+
+  // The id of the actor name recorded by the actor profiler.
+  uint32_t trace_name_id_;
 };
 
 using AbstractActorPtr = std::shared_ptr<AbstractActor>;
@@ -36,6 +36,7 @@
 #include "runtime/device/ms_device_shape_transfer.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "runtime/graph_scheduler/actor/actor_profiler.h"
 
 namespace mindspore {
 namespace runtime {
@@ -160,6 +161,10 @@ class ActorDispatcher {
   template <typename T, typename Arg0, typename Arg1>
   static void Send(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
     if (is_multi_thread_execution_) {
+      if (ActorProfiler::enable()) {
+        AsyncWithTrace<T>(aid, [method, arg = std::forward<Arg1>(arg)](T *actor) { (actor->*method)(arg); });
+        return;
+      }
       Async(aid, method, arg);
     } else {
       // The single thread execution doesn't need to switch threads and calls function directly.
@@ -176,6 +181,10 @@ class ActorDispatcher {
   static void Send(const AID &aid, void (T::*method)(Args0...), Args1 &&... args) {
     if (is_multi_thread_execution_) {
       auto tuple = std::make_tuple(std::forward<Args1>(args)...);
+      if (ActorProfiler::enable()) {
+        AsyncWithTrace<T>(aid, [method, tuple = std::move(tuple)](T *actor) { Apply(actor, method, tuple); });
+        return;
+      }
       Async(aid, method, std::move(tuple));
     } else {
       // The single thread execution doesn't need to switch threads and calls function directly.
@@ -241,6 +250,36 @@ class ActorDispatcher {
   ~ActorDispatcher() = default;
   DISABLE_COPY_AND_ASSIGN(ActorDispatcher);
 
+  // Send the message and record the time it waits in the mailbox of the actor for the actor profiler.
+  template <typename T, typename F>
+  static void AsyncWithTrace(const AID &aid, F &&func) {
+    auto send_time = ActorProfiler::Now();
+    std::function<void(ActorBase *)> handler = [send_time, func = std::forward<F>(func)](ActorBase *base_actor) {
+      T *actor = static_cast<T *>(base_actor);
+      MS_EXCEPTION_IF_NULL(actor);
+      ActorProfiler::GetInstance().Record(ActorTraceEventType::kQueueWait, TraceNameIdOf(actor), send_time,
+                                         ActorProfiler::Now());
+      func(actor);
+    };
+    auto msg = std::make_unique<MessageAsync>(std::move(handler));
+    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  }
+
+  // The actors which have the trace name id are AbstractActor and MemoryManagerActor, the others are recorded with the
+  // unknown name.
+  template <typename T>
+  static auto TraceNameIdOfImpl(const T *actor, int) -> decltype(actor->trace_name_id()) {
+    return actor->trace_name_id();
+  }
+  template <typename T>
+  static uint32_t TraceNameIdOfImpl(const T *, ...) {
+    return 0;
+  }
+  template <typename T>
+  static uint32_t TraceNameIdOf(const T *actor) {
+    return TraceNameIdOfImpl(actor, 0);
+  }
+
   // Decide whether use the multi thread to execute actors.
   // There are scenarios with small network and data, and the performance of multi thread execution is not as good as
   // that of single thread, so single thread execution is required at this time.
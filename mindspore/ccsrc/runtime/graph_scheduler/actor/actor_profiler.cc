@@ -0,0 +1,220 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/actor_profiler.h"
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include "include/common/debug/common.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr double kNanosecondToMicrosecond = 1000.0;
+const char *kEventTypeNames[] = {"queue_wait", "run", "launch", "memory_alloc", "memory_free"};
+
+int GetProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+void WriteJsonString(const std::string &str, std::ofstream *ofs) {
+  *ofs << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      *ofs << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      *ofs << ' ';
+    } else {
+      *ofs << c;
+    }
+  }
+  *ofs << '"';
+}
+}  // namespace
+
+std::atomic<bool> ActorProfiler::enable_{!common::GetEnv(kActorTracePathEnv).empty()};
+
+void ActorTraceBuffer::Snapshot(std::vector<ActorTraceEvent> *events) const {
+  MS_EXCEPTION_IF_NULL(events);
+  const uint64_t capacity = events_.size();
+  auto count = count_.load(std::memory_order_acquire);
+  // The slot after the latest event may be being written by the next push.
+  auto num = std::min(count, capacity - 1);
+  auto first = count - num;
+  auto begin = events->size();
+  for (uint64_t i = first; i < count; ++i) {
+    events->push_back(events_[i & mask_]);
+  }
+  // The writer may go on while copying, the slot of index i is being overwritten once the event of index
+  // i + capacity is pushed, so the copied events up to the index latest - capacity are dropped.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  auto latest = count_.load(std::memory_order_relaxed);
+  if (latest < count) {
+    // Cleared while copying.
+    events->resize(static_cast<size_t>(begin));
+    return;
+  }
+  if (latest >= first + capacity) {
+    auto overwritten = std::min(latest - capacity - first + 1, num);
+    auto erase_begin = events->begin() + static_cast<std::ptrdiff_t>(begin);
+    (void)events->erase(erase_begin, erase_begin + static_cast<std::ptrdiff_t>(overwritten));
+  }
+}
+
+ActorProfiler &ActorProfiler::GetInstance() {
+  static ActorProfiler instance;
+  return instance;
+}
+
+ActorProfiler::ActorProfiler() : base_time_ns_(Now()) {
+  // The id 0 is reserved for the unknown name.
+  (void)names_.emplace_back("unknown");
+  trace_path_ = common::GetEnv(kActorTracePathEnv);
+}
+
+void ActorProfiler::Enable(const std::string &trace_path) {
+  trace_path_ = trace_path;
+  enable_.store(true, std::memory_order_relaxed);
+  MS_LOG(INFO) << "Enable the actor profiler, the trace path: " << trace_path;
+}
+
+uint32_t ActorProfiler::RegisterName(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = name_to_id_.find(name);
+  if (iter != name_to_id_.end()) {
+    return iter->second;
+  }
+  auto id = static_cast<uint32_t>(names_.size());
+  (void)names_.emplace_back(name);
+  (void)name_to_id_.emplace(name, id);
+  return id;
+}
+
+uint64_t ActorProfiler::Now() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+ActorTraceBuffer *ActorProfiler::LocalBuffer() {
+  // The buffer is owned by the profiler, so the events are kept after the thread exits.
+  static thread_local ActorTraceBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    buffer = CreateBuffer();
+  }
+  return buffer;
+}
+
+ActorTraceBuffer *ActorProfiler::CreateBuffer() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto thread_index = static_cast<uint32_t>(buffers_.size());
+  (void)buffers_.emplace_back(std::make_unique<ActorTraceBuffer>(kActorTraceBufferSize, thread_index));
+  return buffers_.back().get();
+}
+
+void ActorProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &buffer : buffers_) {
+    buffer->Clear();
+  }
+}
+
+bool ActorProfiler::DumpChromeTrace(const std::string &file_path) {
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open file [" << file_path << "] failed!";
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto pid = GetProcessId();
+  auto to_us = [this](uint64_t ns) { return static_cast<double>(ns - base_time_ns_) / kNanosecondToMicrosecond; };
+  ofs << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+  bool first = true;
+  auto begin_event = [&ofs, &first]() {
+    if (!first) {
+      ofs << ",\n";
+    }
+    first = false;
+  };
+
+  size_t queue_wait_id = 0;
+  std::vector<ActorTraceEvent> events;
+  for (const auto &buffer : buffers_) {
+    const auto tid = buffer->thread_index();
+    begin_event();
+    ofs << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+        << ",\"args\":{\"name\":\"actor thread " << tid << "\"}}";
+
+    events.clear();
+    buffer->Snapshot(&events);
+    for (const auto &event : events) {
+      if (event.start_ns < base_time_ns_ || event.type >= ActorTraceEventType::kTypeEnd) {
+        continue;
+      }
+      const auto &name = event.name_id < names_.size() ? names_[event.name_id] : names_[0];
+      const char *category = kEventTypeNames[static_cast<size_t>(event.type)];
+      begin_event();
+      if (event.type == ActorTraceEventType::kQueueWait) {
+        // The message waits while the thread is running other actors, so the waits are async slices which are drawn
+        // on their own tracks rather than nested in the slices of the thread.
+        ofs << "{\"name\":";
+        WriteJsonString(name, &ofs);
+        ofs << ",\"cat\":\"" << category << "\",\"ph\":\"b\",\"id\":" << queue_wait_id << ",\"ts\":"
+            << to_us(event.start_ns) << ",\"pid\":" << pid << ",\"tid\":" << tid << "},\n";
+        ofs << "{\"name\":";
+        WriteJsonString(name, &ofs);
+        ofs << ",\"cat\":\"" << category << "\",\"ph\":\"e\",\"id\":" << queue_wait_id << ",\"ts\":"
+            << to_us(event.end_ns) << ",\"pid\":" << pid << ",\"tid\":" << tid << "}";
+        ++queue_wait_id;
+        continue;
+      }
+      ofs << "{\"name\":";
+      WriteJsonString(name, &ofs);
+      ofs << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":" << to_us(event.start_ns)
+          << ",\"dur\":" << to_us(event.end_ns) - to_us(event.start_ns) << ",\"pid\":" << pid << ",\"tid\":" << tid
+          << "}";
+    }
+  }
+  ofs << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  ofs.close();
+  MS_LOG(INFO) << "Dump the actor trace to " << file_path;
+  return true;
+}
+
+void ActorProfiler::Dump() {
+  if (trace_path_.empty()) {
+    return;
+  }
+  std::string file_path = trace_path_ + "/actor_trace_" + std::to_string(GetProcessId()) + ".json";
+  auto realpath = Common::CreatePrefixPath(file_path);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path failed, path: " << file_path;
+    return;
+  }
+  (void)DumpChromeTrace(realpath.value());
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_ACTOR_PROFILER_H_
+#define MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_ACTOR_PROFILER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+// The environment variable to enable the actor profiler, the value is the directory of the trace file.
+constexpr char kActorTracePathEnv[] = "MS_ACTOR_TRACE_PATH";
+// The number of the slots of the ring buffer of each thread, the latest kActorTraceBufferSize - 1 events are dumped.
+constexpr size_t kActorTraceBufferSize = 1 << 16;
+
+enum class ActorTraceEventType : uint8_t {
+  // The time a message waits in the mailbox of the actor before it is handled.
+  kQueueWait = 0,
+  // The time an actor runs when its running condition is satisfied.
+  kRun,
+  // The time of launching the kernel or copying the data.
+  kLaunch,
+  // The time of allocating or freeing memory.
+  kMemoryAlloc,
+  kMemoryFree,
+  kTypeEnd,
+};
+
+struct ActorTraceEvent {
+  uint64_t start_ns;
+  uint64_t end_ns;
+  uint32_t name_id;
+  ActorTraceEventType type;
+};
+
+// The ring buffer of events written by one thread, the oldest events are overwritten when it is full.
+class ActorTraceBuffer {
+ public:
+  ActorTraceBuffer(size_t capacity, uint32_t thread_index)
+      : events_(capacity), mask_(capacity - 1), thread_index_(thread_index) {}
+  ~ActorTraceBuffer() = default;
+
+  void Push(ActorTraceEventType type, uint32_t name_id, uint64_t start_ns, uint64_t end_ns) {
+    auto count = count_.load(std::memory_order_relaxed);
+    auto &event = events_[count & mask_];
+    event.start_ns = start_ns;
+    event.end_ns = end_ns;
+    event.name_id = name_id;
+    event.type = type;
+    count_.store(count + 1, std::memory_order_release);
+  }
+
+  // Copy the latest capacity - 1 events from the oldest to the latest. It is best-effort when the thread is still
+  // writing: the events overwritten during the copy are dropped, so the copied ones are always complete.
+  void Snapshot(std::vector<ActorTraceEvent> *events) const;
+  uint32_t thread_index() const { return thread_index_; }
+  // Best-effort when the thread is still writing: an event being pushed during the clear may keep the events before it.
+  void Clear() { count_.store(0, std::memory_order_release); }
+
+ private:
+  std::vector<ActorTraceEvent> events_;
+  size_t mask_;
+  uint32_t thread_index_;
+  std::atomic<uint64_t> count_{0};
+};
+
+// ActorProfiler records the events of actor runtime with low overhead, so it can be kept on in production to find the
+// scheduling bubbles. Every thread writes to its own ring buffer without any lock, the names of actors are registered
+// once when the actors are created and the events only carry the name id. The events are dumped as the Chrome trace
+// json which can be loaded by chrome://tracing or Perfetto.
+class ActorProfiler {
+ public:
+  static ActorProfiler &GetInstance();
+
+  static bool enable() { return enable_.load(std::memory_order_relaxed); }
+  // Enable the profiler and set the directory of trace file, the trace is dumped to the directory when Dump is called.
+  void Enable(const std::string &trace_path);
+  void Disable() { enable_.store(false, std::memory_order_relaxed); }
+
+  // Return the id of the name, which is recorded by the events instead of the name.
+  uint32_t RegisterName(const std::string &name);
+
+  static uint64_t Now();
+  void Record(ActorTraceEventType type, uint32_t name_id, uint64_t start_ns, uint64_t end_ns) {
+    LocalBuffer()->Push(type, name_id, start_ns, end_ns);
+  }
+
+  // Dump the events of all threads to the json file, it should be called when the actors are idle, otherwise the
+  // events being written may be lost.
+  bool DumpChromeTrace(const std::string &file_path);
+  // Dump to the trace path set by Enable.
+  void Dump();
+  // Drop the recorded events of all threads, like dumping it should be called when the actors are idle.
+  void Clear();
+
+ private:
+  ActorProfiler();
+  ~ActorProfiler() = default;
+  DISABLE_COPY_AND_ASSIGN(ActorProfiler);
+
+  ActorTraceBuffer *LocalBuffer();
+  ActorTraceBuffer *CreateBuffer();
+
+  static std::atomic<bool> enable_;
+  std::string trace_path_;
+  uint64_t base_time_ns_;
+
+  std::mutex mutex_;
+  std::vector<std::string> names_;
+  mindspore::HashMap<std::string, uint32_t> name_to_id_;
+  std::vector<std::unique_ptr<ActorTraceBuffer>> buffers_;
+};
+
+// Record the time of the scope as one event if the profiler is enabled.
+class ActorTraceScope {
+ public:
+  ActorTraceScope(ActorTraceEventType type, uint32_t name_id) : type_(type), name_id_(name_id) {
+    if (ActorProfiler::enable()) {
+      start_ns_ = ActorProfiler::Now();
+    }
+  }
+  ~ActorTraceScope() {
+    if (start_ns_ != 0) {
+      ActorProfiler::GetInstance().Record(type_, name_id_, start_ns_, ActorProfiler::Now());
+    }
+  }
+
+ private:
+  ActorTraceEventType type_;
+  uint32_t name_id_;
+  uint64_t start_ns_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_ACTOR_ACTOR_PROFILER_H_
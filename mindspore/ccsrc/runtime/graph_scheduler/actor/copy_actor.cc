@@ -46,6 +46,7 @@ void CopyActor::Init() {
 }
 
 void CopyActor::Run(OpContext<DeviceTensor> *const context) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kRun, trace_name_id_);
   MS_EXCEPTION_IF_NULL(context);
   FetchDeviceTensor(context);
   SendMemoryAllocReq(context);
@@ -89,9 +90,12 @@ void CopyActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
                     << ", output size:" << output_device_tensor_[0]->GetSize();
   }
 
-  if (!Copy(output_device_tensor_[0], input_device_tensor_[0])) {
-    std::string error_info = "Copy device tensor failed: " + GetAID().Name();
-    SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+  {
+    ActorTraceScope trace_scope(ActorTraceEventType::kLaunch, trace_name_id_);
+    if (!Copy(output_device_tensor_[0], input_device_tensor_[0])) {
+      std::string error_info = "Copy device tensor failed: " + GetAID().Name();
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+    }
   }
 
   PostRun(context);
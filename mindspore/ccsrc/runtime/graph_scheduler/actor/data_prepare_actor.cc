@@ -420,6 +420,7 @@ void DataPrepareActor::SetInitTensorsIfNeeded(const std::vector<std::vector<Tens
 
 void DataPrepareActor::PrepareData(const std::vector<std::vector<TensorPtr>> &input_tensors,
                                    OpContext<DeviceTensor> *const context, GraphExecutionStrategy real_strategy) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kRun, trace_name_id_);
   MS_EXCEPTION_IF_NULL(context);
   try {
     // Preprocess before prepare data for data prepare actor.
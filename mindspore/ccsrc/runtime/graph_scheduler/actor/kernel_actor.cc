@@ -164,6 +164,7 @@ void KernelActor::InitWorkspaceInfo() {
 }
 
 void KernelActor::Run(OpContext<DeviceTensor> *const context) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kRun, trace_name_id_);
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
 
@@ -632,6 +633,7 @@ void KernelActor::PreLaunchKernel(OpContext<DeviceTensor> *) {
 }
 
 bool KernelActor::LaunchKernel(OpContext<DeviceTensor> *const) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kLaunch, trace_name_id_);
   // Check the skipped launch condition.
   if (is_launch_skipped_) {
     MS_EXCEPTION_IF_CHECK_FAIL((launch_info_.inputs_.size() >= 1), "The inputs size is wrong.");
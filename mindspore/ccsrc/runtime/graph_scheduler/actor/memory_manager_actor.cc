@@ -33,6 +33,7 @@ void OnMemoryAllocFinish(const AID &from_aid, OpContext<DeviceTensor> *const op_
 void MemoryManagerActor::AllocateMemory(const std::vector<DeviceTensor *> *alloc_list,
                                         const DeviceContext *device_context, OpContext<DeviceTensor> *const op_context,
                                         const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryAlloc, trace_name_id_);
   MS_EXCEPTION_IF_NULL(alloc_list);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(op_context);
@@ -64,6 +65,7 @@ void MemoryManagerActor::AllocateContinuousMemory(const std::vector<std::vector<
                                                   const std::vector<size_t> *total_size_list,
                                                   const std::vector<const DeviceContext *> *device_contexts,
                                                   OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryAlloc, trace_name_id_);
   MS_EXCEPTION_IF_NULL(alloc_list_list);
   MS_EXCEPTION_IF_NULL(size_list_list);
   MS_EXCEPTION_IF_NULL(total_size_list);
@@ -126,6 +128,7 @@ void MemoryManagerActor::AllocateContinuousMemory(const std::vector<std::vector<
 void MemoryManagerActor::AllocateBatchMemory(const std::vector<DeviceTensor *> *alloc_list,
                                              const std::vector<const DeviceContext *> *device_contexts,
                                              OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryAlloc, trace_name_id_);
   MS_EXCEPTION_IF_NULL(alloc_list);
   MS_EXCEPTION_IF_NULL(device_contexts);
   MS_EXCEPTION_IF_NULL(op_context);
@@ -162,6 +165,7 @@ void MemoryManagerActor::AllocateBatchMemory(const std::vector<DeviceTensor *> *
 
 void MemoryManagerActor::AllocateSomasMemory(SomasInfo *const somas_info, const DeviceContext *device_context,
                                              OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryAlloc, trace_name_id_);
   MS_EXCEPTION_IF_NULL(somas_info);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(device_context->device_res_manager_);
@@ -218,6 +222,7 @@ void MemoryManagerActor::AllocateSomasMemory(SomasInfo *const somas_info, const
 
 void MemoryManagerActor::FreeMemory(const std::vector<DeviceTensor *> *free_list, const DeviceContext *device_context,
                                     OpContext<DeviceTensor> *, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryFree, trace_name_id_);
   MS_EXCEPTION_IF_NULL(free_list);
   for (auto &device_tensor : *free_list) {
     FreeMemoryByRefCount(device_tensor, device_context, from_aid.Name());
@@ -227,6 +232,7 @@ void MemoryManagerActor::FreeMemory(const std::vector<DeviceTensor *> *free_list
 void MemoryManagerActor::FreeBatchMemory(const std::vector<DeviceTensor *> *free_list,
                                          const std::vector<const DeviceContext *> *device_contexts,
                                          OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryFree, trace_name_id_);
   MS_EXCEPTION_IF_NULL(free_list);
   MS_EXCEPTION_IF_NULL(device_contexts);
   MS_EXCEPTION_IF_NULL(op_context);
@@ -244,6 +250,7 @@ void MemoryManagerActor::FreeBatchMemory(const std::vector<DeviceTensor *> *free
 
 void MemoryManagerActor::FreeSomasMemory(SomasInfo *const somas_info, const DeviceContext *device_context,
                                          OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  ActorTraceScope trace_scope(ActorTraceEventType::kMemoryFree, trace_name_id_);
   MS_EXCEPTION_IF_NULL(somas_info);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(device_context->device_res_manager_);
@@ -35,7 +35,9 @@ using mindspore::session::SomasInfo;
 // MemoryManagerActor need response to memory alloc and free quickly, so must bind single thread.
 class MemoryManagerActor : public ActorBase {
  public:
-  MemoryManagerActor() : ActorBase("MemoryManagerActor") {}
+  MemoryManagerActor()
+      : ActorBase("MemoryManagerActor"),
+        trace_name_id_(ActorProfiler::enable() ? ActorProfiler::GetInstance().RegisterName("MemoryManagerActor") : 0) {}
   ~MemoryManagerActor() override = default;
 
   // The process entry of memory alloc.
@@ -70,6 +72,8 @@ class MemoryManagerActor : public ActorBase {
   // Wait the MemoryManagerActor to finish running all current messages.
   void Wait(OpContext<DeviceTensor> *const op_context, const AID &from_aid);
 
+  uint32_t trace_name_id() const { return trace_name_id_; }
+
  private:
   void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context,
                             const std::string &op_name);
@@ -86,6 +90,9 @@ class MemoryManagerActor : public ActorBase {
 
   // The memory free by the ref count maybe triggered concurrently, and the ref count decreased need the lock.
   std::mutex mem_free_mutex_;
+
+  // The id of the actor name recorded by the actor profiler.
+  uint32_t trace_name_id_;
 };
 }  // namespace runtime
 }  // namespace mindspore
@@ -116,6 +116,13 @@ void *MuxRecvActor::AllocateMessage(size_t size) {
   return AllocateMemByDeviceRes(size);
 }
 
+bool MuxRecvActor::FreeMessage(void *data) {
+  bool ret = RecvActor::FreeMessage(data);
+  // The dropped request is never processed, so it does not update the status itself.
+  UpdateStatus();
+  return ret;
+}
+
 void MuxRecvActor::UpdateStatus() {
   std::unique_lock<std::mutex> is_ready_lock(is_ready_mtx_);
   is_ready_ = true;
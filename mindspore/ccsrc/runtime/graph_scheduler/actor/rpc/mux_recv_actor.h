@@ -38,6 +38,8 @@ class MuxRecvActor : public RecvActor {
                   modifiable_ref_input_indexes, modifiable_ref_output_indexes) {}
   ~MuxRecvActor() override = default;
 
+  bool SupportShmTransport() const override { return false; }
+
   // Get the from actor aid of received message.
   const AID &from_actor_aid() const { return from_actor_aid_; }
 
@@ -65,6 +67,9 @@ class MuxRecvActor : public RecvActor {
   // The callback set to rpc module to allocate message(Raw pointer).
   void *AllocateMessage(size_t size);
 
+  // The callback set to rpc module to free the message which is dropped, the next request can be received then.
+  bool FreeMessage(void *data) override;
+
   // Record the from actor aid when receive a message;
   AID from_actor_aid_;
 
@@ -40,6 +40,8 @@ class MuxSendActor : public SendActor {
                   modifiable_ref_input_indexes, modifiable_ref_output_indexes) {}
   ~MuxSendActor() override = default;
 
+  bool SupportShmTransport() const override { return false; }
+
   // Set the MuxRecvActor paired with the MuxSendActor to get the 'from url' from the MuxRecvActor.
   void set_mux_recv_actor(const MuxRecvActorPtr &mux_recv_actor) { mux_recv_actor_ = mux_recv_actor; }
 
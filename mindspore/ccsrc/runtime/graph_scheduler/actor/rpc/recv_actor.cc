@@ -16,6 +16,7 @@
 
 #include "runtime/graph_scheduler/actor/rpc/recv_actor.h"
 
+#include <unistd.h>
 #include <memory>
 #include <utility>
 #include <functional>
@@ -35,6 +36,13 @@ RecvActor::~RecvActor() {
       MS_LOG(ERROR) << "Failed to finalize for tcp server in recv actor.";
     }
   }
+  if (shm_server_) {
+    try {
+      shm_server_->Finalize();
+    } catch (const std::exception &) {
+      MS_LOG(ERROR) << "Failed to finalize for shared memory server in recv actor.";
+    }
+  }
 }
 
 void RecvActor::SetOpcontext(OpContext<DeviceTensor> *const op_context) {
@@ -64,8 +72,10 @@ bool RecvActor::StartServer() {
   // Only set the memory allocating callback when using void* message.
   bool use_void_msg = common::GetEnv("use_void").empty() ? false : true;
   std::function<void *(size_t size)> allocate_callback;
+  std::function<bool(void *data)> free_callback;
   if (use_void_msg) {
     allocate_callback = std::bind(&RecvActor::AllocateMessage, this, std::placeholders::_1);
+    free_callback = std::bind(&RecvActor::FreeMessage, this, std::placeholders::_1);
   } else {
     allocate_callback = {};
   }
@@ -76,10 +86,22 @@ bool RecvActor::StartServer() {
   port_ = server_->GetPort();
   std::string server_url = ip_ + ":" + std::to_string(port_);
 
-  // Step 2: Set the message handler of the server.
+  // Step 2: Create a shared memory server for the send actors on the same host. If it fails, they connect to the tcp
+  // server instead.
+  std::string host_id;
+  if (SupportShmTransport()) {
+    auto shm_server = std::make_unique<ShmServer>();
+    std::string shm_name = "/mindspore_rpc_" + std::to_string(getpid()) + "_" + std::to_string(port_);
+    if (shm_server->Initialize(shm_name, allocate_callback, free_callback)) {
+      shm_server_ = std::move(shm_server);
+      host_id = distributed::rpc::ShmRing::HostId();
+    }
+  }
+
+  // Step 3: Set the message handler of the server.
   SetMessageHandler();
 
-  // Step 3: Register the server address to route table. The server should not be connected before this step is done.
+  // Step 4: Register the server address to route table. The server should not be connected before this step is done.
   for (const auto &inter_process_edge_name : inter_process_edge_names_) {
     MS_LOG(INFO) << "Start server for recv actor. Server address: " << server_url
                  << ", inter-process edge name: " << inter_process_edge_name;
@@ -87,6 +109,10 @@ bool RecvActor::StartServer() {
     recv_actor_addresss.set_actor_id(inter_process_edge_name);
     recv_actor_addresss.set_ip(ip_);
     recv_actor_addresss.set_port(port_);
+    if (shm_server_ != nullptr) {
+      recv_actor_addresss.set_host_id(host_id);
+      recv_actor_addresss.set_shm_name(shm_server_->GetName());
+    }
     MS_EXCEPTION_IF_NULL(actor_route_table_proxy_);
     if (!actor_route_table_proxy_->RegisterRoute(inter_process_edge_name, recv_actor_addresss)) {
       MS_LOG(EXCEPTION) << "Failed to register route for " << inter_process_edge_name << " " << server_url
@@ -194,6 +220,17 @@ void *RecvActor::AllocateMessage(size_t size) {
   return AllocateMemByDeviceRes(size);
 }
 
+bool RecvActor::FreeMessage(void *data) {
+  if (recv_data_ == nullptr || recv_data_->GetMutablePtr() != data) {
+    MS_LOG(ERROR) << "The memory " << data << " is not allocated by the recv actor " << GetAID();
+    return false;
+  }
+  MS_ERROR_IF_NULL_W_RET_VAL(device_contexts_[kIndex0], false);
+  MS_ERROR_IF_NULL_W_RET_VAL(device_contexts_[kIndex0]->device_res_manager_, false);
+  device_contexts_[kIndex0]->device_res_manager_->FreeMemory(recv_data_.get());
+  return true;
+}
+
 void *RecvActor::AllocateMemByDeviceRes(size_t size) {
   // Only need to create recv_data_ once.
   // The real data is allocated and freed multiple times as recv_data_->ptr_.
@@ -385,6 +422,9 @@ MessageBase *RecvActor::HandleMessage(MessageBase *const msg) {
 
 void RecvActor::SetMessageHandler() {
   server_->SetMessageHandler(std::bind(&RecvActor::HandleMessage, this, std::placeholders::_1));
+  if (shm_server_ != nullptr) {
+    shm_server_->SetMessageHandler(std::bind(&RecvActor::HandleMessage, this, std::placeholders::_1));
+  }
 }
 }  // namespace runtime
 }  // namespace mindspore
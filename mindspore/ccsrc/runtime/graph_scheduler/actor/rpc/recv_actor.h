@@ -39,6 +39,7 @@ class RecvActor : public RpcActor {
       : RpcActor(name, kernel, device_context, memory_manager_aid, debug_aid, recorder_aid, strategy,
                  modifiable_ref_input_indexes, modifiable_ref_output_indexes, KernelTransformType::kRecvActor),
         server_(nullptr),
+        shm_server_(nullptr),
         is_context_valid_(false),
         recv_data_(nullptr),
         ip_(""),
@@ -89,6 +90,14 @@ class RecvActor : public RpcActor {
    */
   virtual void *AllocateMessage(size_t size);
 
+  /**
+   * @description: The callback set to rpc module to free the message allocated by AllocateMessage which is dropped
+   * before it is received completely.
+   * @param {void *} data: The memory returned by AllocateMessage.
+   * @return {bool}: Whether the memory is freed.
+   */
+  virtual bool FreeMessage(void *data);
+
   /**
    * @description: Allocate memory by DeviceResManager.
    * @param {size_t} size: memory buffer's size.
@@ -97,6 +106,8 @@ class RecvActor : public RpcActor {
   void *AllocateMemByDeviceRes(size_t size);
 
   std::unique_ptr<TCPServer> server_;
+  // The shared memory server for the send actors on the same host, it's nullptr if the shared memory is not supported.
+  std::unique_ptr<ShmServer> shm_server_;
 
   // The variables used to ensure thread-safe of op context visited by recv actor.
   bool is_context_valid_;
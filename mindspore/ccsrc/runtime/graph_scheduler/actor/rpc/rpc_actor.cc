@@ -26,6 +26,10 @@ void RpcActor::set_inter_process_edge_names(const std::vector<std::string> &edge
   inter_process_edge_names_ = edge_names;
 }
 
+bool RpcActor::SupportShmTransport() const {
+  return common::GetEnv(distributed::rpc::kDisableShmTransportEnv).empty();
+}
+
 bool RpcActor::CopyRpcDataWithOffset(RpcDataPtr *rpc_data, const void *src_data, size_t src_data_size) const {
   MS_EXCEPTION_IF_NULL(rpc_data);
   MS_EXCEPTION_IF_NULL(*rpc_data);
@@ -26,6 +26,8 @@
 #include "distributed/cluster/cluster_context.h"
 #include "distributed/rpc/tcp/tcp_client.h"
 #include "distributed/rpc/tcp/tcp_server.h"
+#include "distributed/rpc/shm/shm_client.h"
+#include "distributed/rpc/shm/shm_server.h"
 #include "proto/rpc.pb.h"
 #include "proto/topology.pb.h"
 
@@ -35,6 +37,8 @@ using distributed::cluster::ActorRouteTableProxy;
 using distributed::cluster::ActorRouteTableProxyPtr;
 using distributed::cluster::ClusterContext;
 using distributed::cluster::topology::ActorAddress;
+using distributed::rpc::ShmClient;
+using distributed::rpc::ShmServer;
 using distributed::rpc::TCPClient;
 using distributed::rpc::TCPServer;
 using mindspore::device::KernelInfo;
@@ -91,6 +95,10 @@ class RpcActor : public KernelActor {
    */
   virtual void StopRpcAtException() {}
 
+  // Whether the actor communicates with the peers on the same host by shared memory instead of tcp. The mux rpc actors
+  // reply to the url of the received message, so they only support tcp.
+  virtual bool SupportShmTransport() const;
+
  protected:
   /**
    * @description: Copy rpc data with size and update the input data's address with offset.
@@ -30,6 +30,9 @@ SendActor::~SendActor() {
       MS_LOG(ERROR) << "Failed to disconnect and finalize for tcp client in send actor.";
     }
   }
+  for (auto &shm_client : shm_clients_) {
+    shm_client.second->Disconnect();
+  }
 }
 
 void SendActor::SetRouteInfo(uint32_t, const std::string &, const std::string &send_src_node_name,
@@ -50,7 +53,12 @@ bool SendActor::ConnectServer() {
     auto peer_actor_address = actor_route_table_proxy_->LookupRoute(peer_actor_id);
 
     // If route is successfully looked up, peer_actor_address is not empty.
-    server_url_ = peer_actor_address.ip() + ":" + std::to_string(peer_actor_address.port());
+    std::string server_url = peer_actor_address.ip() + ":" + std::to_string(peer_actor_address.port());
+    if (ConnectShmServer(peer_actor_id, peer_actor_address)) {
+      peer_actor_urls_[peer_actor_id] = server_url;
+      continue;
+    }
+    server_url_ = server_url;
     auto free_callback = std::bind(&SendActor::FreeMessage, this, std::placeholders::_1);
     size_t retry_count = 60;
     if (!client_->Connect(server_url_, retry_count, free_callback)) {
@@ -63,6 +71,24 @@ bool SendActor::ConnectServer() {
   return true;
 }
 
+bool SendActor::ConnectShmServer(const std::string &peer_actor_id, const ActorAddress &peer_actor_address) {
+  if (!SupportShmTransport() || peer_actor_address.shm_name().empty() ||
+      peer_actor_address.host_id() != distributed::rpc::ShmRing::HostId()) {
+    return false;
+  }
+  auto shm_client = std::make_unique<ShmClient>();
+  auto free_callback = std::bind(&SendActor::FreeMessage, this, std::placeholders::_1);
+  if (!shm_client->Connect(peer_actor_address.shm_name(), free_callback)) {
+    MS_LOG(WARNING) << "Failed to connect to the shared memory server " << peer_actor_address.shm_name()
+                    << " of actor " << peer_actor_id << ", use tcp instead.";
+    return false;
+  }
+  MS_LOG(INFO) << "Successfully connect to shared memory server " << peer_actor_address.shm_name()
+               << ", inter-process edge name: " << peer_actor_id;
+  shm_clients_[peer_actor_id] = std::move(shm_client);
+  return true;
+}
+
 bool SendActor::LaunchKernel(OpContext<DeviceTensor> *const context) {
   MS_ERROR_IF_NULL_W_RET_VAL(context, false);
   // Set context for later usage in FreeMessage.
@@ -80,6 +106,15 @@ bool SendActor::LaunchKernel(OpContext<DeviceTensor> *const context) {
   }
   auto send_output = launch_info_.inputs_;
   for (const auto &peer : peer_actor_urls_) {
+    const auto &shm_iter = shm_clients_.find(peer.first);
+    if (shm_iter != shm_clients_.end()) {
+      MS_LOG(INFO) << "Rpc actor send message by shared memory for inter-process edge: " << peer.first;
+      if (!SendByShm(shm_iter->second.get(), send_output)) {
+        MS_LOG(ERROR) << "Failed to send message by shared memory for inter-process edge: " << peer.first;
+        return false;
+      }
+      continue;
+    }
     std::string peer_server_url = peer.second;
     auto message = BuildRpcMessage(send_output, peer_server_url);
     MS_ERROR_IF_NULL_W_RET_VAL(message, false);
@@ -124,6 +159,26 @@ std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtr
   return message;
 }
 
+bool SendActor::SendByShm(ShmClient *shm_client, const kernel::AddressPtrList &data_list) {
+  MS_ERROR_IF_NULL(shm_client);
+  if (is_dynamic_shape_ || !common::GetEnv("use_void").empty()) {
+    // The message carries the serialized shapes or uses the workspace memory, build it the same as tcp.
+    auto message = BuildRpcMessage(data_list, shm_client->GetName());
+    MS_ERROR_IF_NULL(message);
+    message->from = GetAID();
+    return shm_client->SendMessage(std::move(message));
+  }
+
+  // The inputs are gathered into the shared memory without building the message body, so they are copied only once.
+  std::vector<distributed::rpc::ShmBuffer> buffers;
+  buffers.reserve(data_list.size());
+  for (const auto &data : data_list) {
+    MS_ERROR_IF_NULL(data);
+    (void)buffers.emplace_back(data->addr, data->size);
+  }
+  return shm_client->Send(GetAID(), buffers);
+}
+
 bool SendActor::FreeMessage(void *data) {
   auto memory_free_list = FindDeviceTensorNeedsFree(data);
   ActorDispatcher::SendSync(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list,
@@ -116,6 +116,14 @@ class SendActor : public RpcActor {
   void SerializeCommonMessage(MessageBase *message, const kernel::AddressPtrList &data_list,
                               const kernel::AddressPtr &workspace_addr) const;
 
+  // Connect to the shared memory server of the peer if the peer is on the same host, return false if the tcp should
+  // be used instead.
+  bool ConnectShmServer(const std::string &peer_actor_id, const ActorAddress &peer_actor_address);
+
+  // Send the inputs to the peer on the same host. The inputs are copied to the shared memory directly unless the message
+  // needs serializing.
+  bool SendByShm(ShmClient *shm_client, const kernel::AddressPtrList &data_list);
+
   friend class GraphScheduler;
 
   // OpC ontext passed by graph scheduler.
@@ -124,6 +132,8 @@ class SendActor : public RpcActor {
   // This send actor's destination peers' actor ids and route table.
   std::vector<std::string> peer_actor_ids_;
   mindspore::HashMap<std::string, std::string> peer_actor_urls_;
+  // The shared memory clients of the peers on the same host, the key is the peer actor id.
+  mindspore::HashMap<std::string, std::unique_ptr<ShmClient>> shm_clients_;
 
   // The url of the peer recv actor's tcp server.
   std::string server_url_;
@@ -323,6 +323,11 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
 }
 
 void GraphScheduler::Clear() {
+  // Dump the trace of actor profiler, the actors are idle here.
+  if (ActorProfiler::enable()) {
+    ActorProfiler::GetInstance().Dump();
+  }
+
   // Terminate all actors.
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
@@ -0,0 +1,280 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/kernel_select_cache.h"
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/debug/common.h"
+#include "kernel/kernel_build_info.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/system/sha256.h"
+#include "mindspore/core/utils/file_utils.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr char kCacheVersion[] = "1";
+constexpr char kVersionKey[] = "version";
+constexpr char kKernelsKey[] = "kernels";
+constexpr char kKernelTypeKey[] = "kernel_type";
+constexpr char kProcessorKey[] = "processor";
+constexpr char kOpPatternKey[] = "op_pattern";
+constexpr char kFusionTypeKey[] = "fusion_type";
+constexpr char kCoreTypeKey[] = "core_type";
+constexpr char kOriginFormatKey[] = "origin_format";
+constexpr char kInputsFormatKey[] = "inputs_format";
+constexpr char kOutputsFormatKey[] = "outputs_format";
+constexpr char kInputsDeviceTypeKey[] = "inputs_device_type";
+constexpr char kOutputsDeviceTypeKey[] = "outputs_device_type";
+constexpr char kInputsReshapeTypeKey[] = "inputs_reshape_type";
+constexpr char kOutputsReshapeTypeKey[] = "outputs_reshape_type";
+constexpr char kInputsObjectTypeKey[] = "inputs_object_type";
+constexpr char kOutputsObjectTypeKey[] = "outputs_object_type";
+constexpr char kOutputDataDescKey[] = "output_data_desc";
+
+// The kernels whose selection depends on more than the description below, such as the registration of custom ops.
+bool IsCacheableKernel(const CNodePtr &kernel) {
+  return !common::AnfAlgo::IsGraphKernel(kernel) && !IsPrimitiveCNode(kernel, prim::kPrimCustom) &&
+         GetCNodePrimitive(kernel) != nullptr;
+}
+
+std::string GetSelectedOutputFormat(const KernelWithIndex &output) {
+  MS_EXCEPTION_IF_NULL(output.first);
+  auto kernel_info = dynamic_cast<device::KernelInfo *>(output.first->kernel_info());
+  if (kernel_info == nullptr || kernel_info->select_kernel_build_info() == nullptr) {
+    return "";
+  }
+  return kernel_info->select_kernel_build_info()->GetOutputFormat(output.second);
+}
+
+void DumpAttrs(const mindspore::HashMap<std::string, ValuePtr> &attrs, std::ostringstream *desc) {
+  std::map<std::string, ValuePtr> ordered_attrs(attrs.begin(), attrs.end());
+  for (const auto &attr : ordered_attrs) {
+    *desc << attr.first << "=" << (attr.second == nullptr ? "null" : attr.second->ToString()) << ";";
+  }
+}
+
+// Describe everything the kernel selection depends on: the device, the op and its attrs, and the formats, types and
+// shapes of the inputs and outputs.
+std::string GetKernelKey(const CNodePtr &kernel, const std::string &device_name) {
+  std::ostringstream desc;
+  desc << device_name << "|" << common::AnfAlgo::GetCNodeName(kernel) << "|";
+  auto prim = GetCNodePrimitive(kernel);
+  MS_EXCEPTION_IF_NULL(prim);
+  DumpAttrs(prim->attrs(), &desc);
+  desc << "|";
+  DumpAttrs(kernel->attrs(), &desc);
+  desc << "|";
+  auto input_object_types = common::AnfAlgo::GetAllInputObjectType(kernel);
+  size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    desc << GetSelectedOutputFormat(common::AnfAlgo::GetPrevNodeOutput(kernel, i)) << ","
+         << common::AnfAlgo::GetPrevNodeOutputInferDataType(kernel, i) << ","
+         << ShapeVectorToStr(common::AnfAlgo::GetPrevNodeOutputInferShape(kernel, i)) << ";";
+  }
+  for (auto object_type : input_object_types) {
+    desc << object_type << ",";
+  }
+  desc << "|";
+  auto output_object_types = common::AnfAlgo::GetAllOutputObjectType(kernel);
+  size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    desc << common::AnfAlgo::GetOutputInferDataType(kernel, i) << ","
+         << ShapeVectorToStr(common::AnfAlgo::GetOutputInferShape(kernel, i)) << ";";
+  }
+  for (auto object_type : output_object_types) {
+    desc << object_type << ",";
+  }
+  return system::sha256::GetHashFromString(desc.str());
+}
+}  // namespace
+
+KernelSelectCache &KernelSelectCache::GetInstance() {
+  static KernelSelectCache instance{};
+  return instance;
+}
+
+void KernelSelectCache::Initialize(const std::string &cache_path, bool load) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enable_ = true;
+  // All the graphs of the process share the cache file, it is loaded only once.
+  if (cache_path == cache_path_) {
+    return;
+  }
+  cache_path_ = cache_path;
+  changed_ = false;
+  build_infos_.clear();
+  if (!load) {
+    return;
+  }
+  std::ifstream json_in(cache_path_);
+  if (!json_in.is_open()) {
+    MS_LOG(INFO) << "The kernel select cache file " << cache_path_ << " does not exist.";
+    return;
+  }
+  try {
+    nlohmann::json cache_json;
+    json_in >> cache_json;
+    if (cache_json.at(kVersionKey).get<std::string>() != kCacheVersion) {
+      MS_LOG(WARNING) << "The version of the kernel select cache file " << cache_path_ << " is not matched.";
+      return;
+    }
+    for (const auto &item : cache_json.at(kKernelsKey).items()) {
+      build_infos_[item.key()] = item.value();
+    }
+  } catch (const std::exception &e) {
+    build_infos_.clear();
+    MS_LOG(WARNING) << "Load the kernel select cache file " << cache_path_ << " failed: " << e.what();
+    return;
+  }
+  MS_LOG(INFO) << "Use the kernel select cache of " << build_infos_.size()
+               << " kernels, the kernel selection of the matched kernels is skipped.";
+}
+
+nlohmann::json KernelSelectCache::BuildInfoToJson(const kernel::KernelBuildInfoPtr &build_info) {
+  MS_EXCEPTION_IF_NULL(build_info);
+  nlohmann::json build_info_json;
+  build_info_json[kKernelTypeKey] = static_cast<int>(build_info->kernel_type());
+  build_info_json[kProcessorKey] = static_cast<int>(build_info->processor());
+  build_info_json[kOpPatternKey] = static_cast<int>(build_info->op_pattern());
+  build_info_json[kFusionTypeKey] = build_info->fusion_type();
+  build_info_json[kCoreTypeKey] = build_info->core_type();
+  build_info_json[kOriginFormatKey] = build_info->GetOriginDataFormat();
+  build_info_json[kInputsFormatKey] = build_info->GetAllInputFormats();
+  build_info_json[kOutputsFormatKey] = build_info->GetAllOutputFormats();
+  build_info_json[kInputsDeviceTypeKey] = build_info->GetAllInputDeviceTypes();
+  build_info_json[kOutputsDeviceTypeKey] = build_info->GetAllOutputDeviceTypes();
+  build_info_json[kInputsReshapeTypeKey] = build_info->GetAllInputReshapeType();
+  build_info_json[kOutputsReshapeTypeKey] = build_info->GetAllOutputReshapeType();
+  build_info_json[kInputsObjectTypeKey] = build_info->GetAllInputKernelObjectTypes();
+  build_info_json[kOutputsObjectTypeKey] = build_info->GetAllOutputKernelObjectTypes();
+  build_info_json[kOutputDataDescKey] = build_info->output_data_desc();
+  return build_info_json;
+}
+
+kernel::KernelBuildInfoPtr KernelSelectCache::JsonToBuildInfo(const nlohmann::json &build_info_json) {
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  MS_EXCEPTION_IF_NULL(builder);
+  builder->SetKernelType(static_cast<KernelType>(build_info_json.at(kKernelTypeKey).get<int>()));
+  builder->SetProcessor(static_cast<kernel::Processor>(build_info_json.at(kProcessorKey).get<int>()));
+  builder->SetOpPattern(static_cast<kernel::OpPattern>(build_info_json.at(kOpPatternKey).get<int>()));
+  builder->SetFusionType(build_info_json.at(kFusionTypeKey).get<std::string>());
+  builder->SetCoreType(build_info_json.at(kCoreTypeKey).get<std::string>());
+  builder->SetOriginDataFormat(build_info_json.at(kOriginFormatKey).get<std::string>());
+  builder->SetInputsFormat(build_info_json.at(kInputsFormatKey).get<std::vector<std::string>>());
+  builder->SetOutputsFormat(build_info_json.at(kOutputsFormatKey).get<std::vector<std::string>>());
+  builder->SetInputsDeviceType(build_info_json.at(kInputsDeviceTypeKey).get<std::vector<TypeId>>());
+  builder->SetOutputsDeviceType(build_info_json.at(kOutputsDeviceTypeKey).get<std::vector<TypeId>>());
+  builder->SetInputsReshapeType(build_info_json.at(kInputsReshapeTypeKey).get<std::vector<std::string>>());
+  builder->SetOutputsReshapeType(build_info_json.at(kOutputsReshapeTypeKey).get<std::vector<std::string>>());
+  builder->SetInputsKernelObjectType(
+    build_info_json.at(kInputsObjectTypeKey).get<std::vector<kernel::KernelObjectType>>());
+  builder->SetOutputsKernelObjectType(
+    build_info_json.at(kOutputsObjectTypeKey).get<std::vector<kernel::KernelObjectType>>());
+  builder->SetOutputDataDesc(build_info_json.at(kOutputDataDescKey).get<std::vector<nlohmann::json>>());
+  return builder->Build();
+}
+
+bool KernelSelectCache::Fetch(const CNodePtr &kernel, const std::string &device_name, std::string *kernel_key) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_key);
+  kernel_key->clear();
+  if (!enable_ || !IsCacheableKernel(kernel)) {
+    return false;
+  }
+  *kernel_key = GetKernelKey(kernel, device_name);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = build_infos_.find(*kernel_key);
+  if (iter == build_infos_.end()) {
+    ++miss_count_;
+    return false;
+  }
+  kernel::KernelBuildInfoPtr build_info = nullptr;
+  try {
+    build_info = JsonToBuildInfo(iter->second);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "The cached kernel build info of " << kernel->fullname_with_scope()
+                    << " is invalid: " << e.what();
+    (void)build_infos_.erase(iter);
+    ++miss_count_;
+    return false;
+  }
+  if (kernel->kernel_info() == nullptr) {
+    kernel->set_kernel_info(std::make_shared<device::KernelInfo>());
+  }
+  AnfAlgo::SetSelectKernelBuildInfo(build_info, kernel.get());
+  ++hit_count_;
+  MS_LOG(DEBUG) << "Kernel select cache hit: " << kernel->fullname_with_scope() << " " << build_info->ToString();
+  return true;
+}
+
+void KernelSelectCache::Store(const std::string &kernel_key, const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  if (!enable_ || kernel_key.empty()) {
+    return;
+  }
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(kernel);
+  if (build_info == nullptr) {
+    return;
+  }
+  auto build_info_json = BuildInfoToJson(build_info);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &cached = build_infos_[kernel_key];
+  if (cached != build_info_json) {
+    cached = build_info_json;
+    changed_ = true;
+  }
+}
+
+void KernelSelectCache::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enable_) {
+    return;
+  }
+  MS_LOG(INFO) << "Kernel select cache hit: " << hit_count_ << ", miss: " << miss_count_;
+  if (!changed_) {
+    return;
+  }
+  auto realpath = Common::CreatePrefixPath(cache_path_, true);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path of file " << cache_path_ << " failed.";
+    return;
+  }
+  nlohmann::json cache_json;
+  cache_json[kVersionKey] = kCacheVersion;
+  cache_json[kKernelsKey] = nlohmann::json::object();
+  for (const auto &build_info : build_infos_) {
+    cache_json[kKernelsKey][build_info.first] = build_info.second;
+  }
+  ChangeFileMode(realpath.value(), S_IWUSR);
+  std::ofstream fout(realpath.value());
+  if (!fout.is_open()) {
+    MS_LOG(ERROR) << "Open cache file '" << realpath.value() << "' failed!" << ErrnoToString(errno);
+    return;
+  }
+  fout << cache_json.dump();
+  fout.close();
+  ChangeFileMode(realpath.value(), S_IRUSR);
+  changed_ = false;
+  MS_LOG(INFO) << "Save the kernel select cache of " << build_infos_.size() << " kernels to " << realpath.value();
+}
+}  // namespace runtime
+}  // namespace mindspore
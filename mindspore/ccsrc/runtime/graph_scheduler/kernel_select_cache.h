@@ -0,0 +1,72 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_KERNEL_SELECT_CACHE_H_
+#define MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_KERNEL_SELECT_CACHE_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "ir/anf.h"
+#include "kernel/kernel_build_info.h"
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace runtime {
+// KernelSelectCache persists the KernelBuildInfo selected for the kernels of the compiled graphs to the compilation
+// cache directory. When the front-end graph of a restarted process is loaded from a consistent compilation cache, the
+// kernel selection of the kernels whose device, op, attrs, input formats, types and shapes are the same as a cached
+// kernel is skipped, and the cached KernelBuildInfo is set to the kernel directly.
+class BACKEND_EXPORT KernelSelectCache {
+ public:
+  static KernelSelectCache &GetInstance();
+
+  // Enable the cache of the file, the cached kernels are loaded from it only if the compilation cache is consistent.
+  void Initialize(const std::string &cache_path, bool load);
+  bool enable() const { return enable_; }
+
+  // Set the cached KernelBuildInfo to the kernel, return false if no kernel matched is cached. The key of the kernel
+  // is returned to store the KernelBuildInfo selected for it, since the selection may change the attrs of the kernel.
+  bool Fetch(const CNodePtr &kernel, const std::string &device_name, std::string *kernel_key);
+  // Cache the KernelBuildInfo selected for the kernel of the key returned by Fetch.
+  void Store(const std::string &kernel_key, const CNodePtr &kernel);
+
+  // Save the cached kernels to the file if new kernels are stored.
+  void Save();
+
+ private:
+  KernelSelectCache() = default;
+  ~KernelSelectCache() = default;
+  DISABLE_COPY_AND_ASSIGN(KernelSelectCache);
+
+  // The serialization of the KernelBuildInfo in the cache file.
+  static nlohmann::json BuildInfoToJson(const kernel::KernelBuildInfoPtr &build_info);
+  static kernel::KernelBuildInfoPtr JsonToBuildInfo(const nlohmann::json &build_info_json);
+
+  bool enable_{false};
+  bool changed_{false};
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  std::string cache_path_;
+  // The key is the hash of the kernel description, the value is the serialized KernelBuildInfo.
+  std::map<std::string, nlohmann::json> build_infos_;
+  std::mutex mutex_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_GRAPH_SCHEDULER_KERNEL_SELECT_CACHE_H_
@@ -16,19 +16,90 @@
 
 #include "runtime/pynative/async/async_queue.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
 #include "include/common/utils/signal_util.h"
 #endif
 #include "utils/log_adapter.h"
 #include "utils/ms_exception.h"
+#include "include/common/utils/scoped_long_running.h"
 
 namespace mindspore {
 namespace pynative {
-AsyncQueue::AsyncQueue() { worker_ = std::make_shared<std::thread>(&AsyncQueue::WorkerLoop, this); }
+namespace {
+// The capacity of the ring, must be a power of 2.
+constexpr size_t kQueueCapacity = 4096;
+constexpr size_t kQueueMask = kQueueCapacity - 1;
+// The max number of the tasks taken by the worker at a time.
+constexpr size_t kMaxBatchSize = 64;
+constexpr size_t kMinSpinBudget = 64;
+constexpr size_t kMaxSpinBudget = 16384;
+// Spin with yield after the number of loops, to give up the core to the producer when it is overcommitted.
+constexpr size_t kYieldThreshold = 32;
+constexpr size_t kWaitSpinCount = 1024;
+}  // namespace
+
+AsyncQueue::AsyncQueue() : slots_(new Slot[kQueueCapacity]), spin_budget_(kMinSpinBudget) {
+  for (size_t i = 0; i < kQueueCapacity; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  worker_ = std::make_shared<std::thread>(&AsyncQueue::WorkerLoop, this);
+}
 
 AsyncQueue::~AsyncQueue() { WorkerJoin(); }
 
+bool AsyncQueue::IsPublished(size_t position) const {
+  return slots_[position & kQueueMask].sequence.load(std::memory_order_seq_cst) == position + 1;
+}
+
+void AsyncQueue::WaitForTask(size_t position) {
+  for (size_t i = 0; i < spin_budget_; ++i) {
+    if (IsPublished(position)) {
+      // The task comes soon after the queue is empty, spinning longer next time is worth it.
+      spin_budget_ = std::min(spin_budget_ * 2, kMaxSpinBudget);
+      return;
+    }
+    if (i >= kYieldThreshold) {
+      std::this_thread::yield();
+    }
+  }
+  spin_budget_ = std::max(spin_budget_ / 2, kMinSpinBudget);
+
+  MS_LOG(DEBUG) << "Wait task in queue";
+  std::unique_lock<std::mutex> lock(worker_mutex_);
+  worker_parked_.store(true, std::memory_order_seq_cst);
+  worker_cond_var_.wait(lock, [this, position]() { return IsPublished(position); });
+  worker_parked_.store(false, std::memory_order_relaxed);
+}
+
+void AsyncQueue::WakeUpWorker() {
+  // Pairs with the store of worker_parked_ in WaitForTask, either the worker sees the task or the producer sees
+  // the worker parked.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (worker_parked_.load(std::memory_order_seq_cst)) {
+    std::lock_guard<std::mutex> lock(worker_mutex_);
+    worker_cond_var_.notify_one();
+  }
+}
+
+void AsyncQueue::FinishTask() {
+  if (pending_tasks_.fetch_sub(1, std::memory_order_seq_cst) == 1 && waiters_.load(std::memory_order_seq_cst) > 0) {
+    MS_LOG(DEBUG) << "Task queue empty";
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    task_cond_var_.notify_all();
+  }
+}
+
+void AsyncQueue::DiscardTasks() {
+  auto position = enqueue_position_.load(std::memory_order_acquire);
+  auto discard_position = discard_position_.load(std::memory_order_relaxed);
+  while (discard_position < position &&
+         !discard_position_.compare_exchange_weak(discard_position, position, std::memory_order_acq_rel)) {
+  }
+}
+
 void AsyncQueue::WorkerLoop() {
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
   SignalGuard sig([](int, siginfo_t *, void *) {
@@ -38,76 +109,97 @@ void AsyncQueue::WorkerLoop() {
   });
 #endif
 
+  size_t dequeue_position = 0;
+  std::vector<std::pair<size_t, std::shared_ptr<AsyncTask>>> batch;
+  batch.reserve(kMaxBatchSize);
   while (true) {
-    std::shared_ptr<AsyncTask> task;
-    bool task_empty = false;
-    {
-      MS_LOG(DEBUG) << "Wait task in queue";
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      task_empty = tasks_.empty();
-      if (!task_empty) {
-        task = tasks_.front();
-      }
+    // Take the published tasks and give their slots back to the producers at once.
+    while (batch.size() < kMaxBatchSize && IsPublished(dequeue_position)) {
+      auto &slot = slots_[dequeue_position & kQueueMask];
+      (void)batch.emplace_back(dequeue_position, std::move(slot.task));
+      slot.task = nullptr;
+      slot.sequence.store(dequeue_position + kQueueCapacity, std::memory_order_release);
+      ++dequeue_position;
     }
-    if (task_empty) {
-      std::this_thread::yield();
+    if (batch.empty()) {
+      WaitForTask(dequeue_position);
       continue;
     }
 
-    MS_LOG(DEBUG) << "Get task";
-    MS_EXCEPTION_IF_NULL(task);
-    if (task->task_type() == kExitTask) {
-      MS_LOG(DEBUG) << "Thread exit";
-      return;
-    }
-
-    try {
-      task->Run();
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      if (!tasks_.empty()) {
-        tasks_.pop();
+    MS_LOG(DEBUG) << "Get " << batch.size() << " tasks";
+    for (auto &item : batch) {
+      auto &task = item.second;
+      MS_EXCEPTION_IF_NULL(task);
+      if (task->task_type() == kExitTask) {
+        MS_LOG(DEBUG) << "Thread exit";
+        return;
       }
-
-      if (tasks_.empty()) {
-        MS_LOG(DEBUG) << "Task queue empty";
-        task_cond_var_.notify_all();
+      if (item.first < discard_position_.load(std::memory_order_acquire)) {
+        task = nullptr;
+        FinishTask();
+        continue;
       }
-    } catch (const std::exception &e) {
-      MS_LOG(ERROR) << "Run task failed, error msg:" << e.what();
-      {
-        std::unique_lock<std::mutex> lock(task_mutex_);
-        std::queue<std::shared_ptr<AsyncTask>> empty;
-        std::swap(tasks_, empty);
+      try {
+        task->Run();
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Run task failed, error msg:" << e.what();
+        DiscardTasks();
         MsException::Instance().SetException();
-        task_cond_var_.notify_all();
       }
+      // Release the task before it is counted as finished, as the old queue popped it.
+      task = nullptr;
+      FinishTask();
     }
+    batch.clear();
   }
 }
 
 void AsyncQueue::Push(const std::shared_ptr<AsyncTask> &task) {
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  tasks_.push(task);
-  task_cond_var_.notify_all();
+  (void)pending_tasks_.fetch_add(1, std::memory_order_seq_cst);
+  auto position = enqueue_position_.load(std::memory_order_relaxed);
+  // Release the GIL while waiting for a free slot, the tasks taken by the worker may acquire it.
+  std::unique_ptr<ScopedLongRunning> long_running;
+  while (true) {
+    auto &slot = slots_[position & kQueueMask];
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot.task = task;
+        slot.sequence.store(position + 1, std::memory_order_release);
+        break;
+      }
+    } else if (sequence < position) {
+      // The ring is full, wait for the worker to take the tasks.
+      if (long_running == nullptr) {
+        long_running = std::make_unique<ScopedLongRunning>();
+      }
+      WakeUpWorker();
+      std::this_thread::yield();
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+  WakeUpWorker();
 }
 
 void AsyncQueue::Wait() {
-  std::unique_lock<std::mutex> lock(task_mutex_);
-  task_cond_var_.wait(lock, [this]() { return tasks_.empty(); });
+  for (size_t i = 0; i < kWaitSpinCount && pending_tasks_.load(std::memory_order_seq_cst) != 0; ++i) {
+    std::this_thread::yield();
+  }
+  if (pending_tasks_.load(std::memory_order_seq_cst) != 0) {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    (void)waiters_.fetch_add(1, std::memory_order_seq_cst);
+    task_cond_var_.wait(lock, [this]() { return pending_tasks_.load(std::memory_order_seq_cst) == 0; });
+    (void)waiters_.fetch_sub(1, std::memory_order_seq_cst);
+  }
   MsException::Instance().CheckException();
 }
 
-bool AsyncQueue::Empty() {
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  return tasks_.empty();
-}
+bool AsyncQueue::Empty() { return pending_tasks_.load(std::memory_order_seq_cst) == 0; }
 
 void AsyncQueue::Reset() {
-  {
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    std::queue<std::shared_ptr<AsyncTask>> empty;
-    std::swap(tasks_, empty);
-  }
+  DiscardTasks();
   // There is still one task in progress
   Wait();
 }
@@ -116,13 +208,8 @@ void AsyncQueue::WorkerJoin() {
   try {
     // Avoid worker thread join itself which will cause deadlock
     if (worker_->joinable() && worker_->get_id() != std::this_thread::get_id()) {
-      {
-        std::lock_guard<std::mutex> lock(task_mutex_);
-        auto task = std::make_shared<ExitTask>();
-        tasks_.push(task);
-        task_cond_var_.notify_all();
-        MS_LOG(DEBUG) << "Push exit task and notify all";
-      }
+      Push(std::make_shared<ExitTask>());
+      MS_LOG(DEBUG) << "Push exit task and notify all";
       worker_->join();
       MS_LOG(DEBUG) << "Worker join finish";
     }
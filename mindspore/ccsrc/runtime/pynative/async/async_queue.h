@@ -17,7 +17,7 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 #define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 
-#include <queue>
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -29,6 +29,10 @@
 namespace mindspore {
 namespace pynative {
 // Create a new thread to execute the tasks in the queue sequentially.
+// The tasks are kept in a bounded lock-free ring: the producers claim slots with a CAS on the enqueue position and
+// publish them by the sequence number of the slot, the worker takes the published tasks in batches without any lock.
+// The worker spins for a while when the ring is empty and parks only if no task comes, so is the thread waiting for
+// all the tasks to finish.
 class BACKEND_EXPORT AsyncQueue {
  public:
   AsyncQueue();
@@ -50,10 +54,35 @@ class BACKEND_EXPORT AsyncQueue {
   void WorkerJoin();
 
  private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    std::shared_ptr<AsyncTask> task{nullptr};
+  };
+
   void WorkerLoop();
+  // Spin and then park the worker until the task of the position is published.
+  void WaitForTask(size_t position);
+  bool IsPublished(size_t position) const;
+  void WakeUpWorker();
+  void FinishTask();
+  // Drop the tasks pushed before, they are counted as finished without running.
+  void DiscardTasks();
+
+  std::unique_ptr<Slot[]> slots_;
+  // The position of the next task to push, shared by the producers.
+  alignas(64) std::atomic<size_t> enqueue_position_{0};
+  // The tasks before the position are dropped instead of running.
+  alignas(64) std::atomic<size_t> discard_position_{0};
+  // The number of the tasks pushed but not finished yet, including the running one.
+  alignas(64) std::atomic<size_t> pending_tasks_{0};
+  // The number of the spin loops before the worker parks, adjusted by whether spinning found a task.
+  size_t spin_budget_;
 
-  std::queue<std::shared_ptr<AsyncTask>> tasks_;
   std::shared_ptr<std::thread> worker_;
+  std::atomic<bool> worker_parked_{false};
+  std::mutex worker_mutex_;
+  std::condition_variable worker_cond_var_;
+  std::atomic<size_t> waiters_{0};
   std::mutex task_mutex_;
   std::condition_variable task_cond_var_;
 };
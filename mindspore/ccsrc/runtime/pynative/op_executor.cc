@@ -15,6 +15,7 @@
  */
 
 #include "runtime/pynative/op_executor.h"
+#include "runtime/pynative/op_sequence_capture.h"
 
 namespace mindspore::runtime {
 OpExecutor &OpExecutor::GetInstance() {
@@ -29,6 +30,7 @@ OpExecutor::~OpExecutor() = default;
 void OpExecutor::Register(const std::function<void()> &callback) { batch_build_callback_ = callback; }
 
 void OpExecutor::Reset() {
+  OpSequenceCapture::GetInstance().Clear();
   ClearResources();
   batch_build_callback_ = nullptr;
   async_queue_.Reset();
@@ -60,6 +62,8 @@ void OpExecutor::WaitForRun() {
 }
 
 void OpExecutor::Wait() {
+  // The ops deferred by the op sequence capture are run first, they may push tasks.
+  OpSequenceCapture::GetInstance().Flush();
   WaitForBuild();
   WaitForRun();
 }
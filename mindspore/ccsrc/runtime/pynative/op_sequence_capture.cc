@@ -0,0 +1,581 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/pynative/op_sequence_capture.h"
+#include <algorithm>
+#include <sstream>
+#include "ir/manager.h"
+#include "utils/flags.h"
+#include "utils/shape_utils.h"
+#include "utils/convert_utils_base.h"
+#include "mindspore/core/ops/core_ops.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/utils/utils.h"
+#include "runtime/pynative/op_executor.h"
+
+namespace mindspore::runtime {
+namespace {
+constexpr auto kEnvOpCapture = "MS_DEV_PYNATIVE_OP_CAPTURE";
+// A sequence is replayed after it is run the same way in so many consecutive steps.
+constexpr size_t kStableSequenceCount = 2;
+// A sequence is not replayed any more after the replay of it failed so many times.
+constexpr size_t kMaxReplayFailures = 3;
+constexpr size_t kMaxSequenceSize = 4096;
+constexpr size_t kMaxSequenceNum = 64;
+
+bool EnableOpCapture() { return common::GetEnv(kEnvOpCapture) == "1"; }
+
+bool HasSideEffect(const Primitive &prim) {
+  return prim.HasAttr(GRAPH_FLAG_SIDE_EFFECT_MEM) || prim.HasAttr(GRAPH_FLAG_SIDE_EFFECT_IO) ||
+         prim.HasAttr(GRAPH_FLAG_SIDE_EFFECT_HIDDEN);
+}
+
+bool IsStaticTensorAbstract(const AbstractBasePtr &abstract) {
+  if (abstract == nullptr || !abstract->isa<abstract::AbstractTensor>()) {
+    return false;
+  }
+  const auto &shape = abstract->cast<abstract::AbstractTensorPtr>()->shape();
+  return shape != nullptr && !IsDynamic(shape->shape());
+}
+
+// Only the ops whose outputs are a tensor or a tuple of tensors with static shapes are captured.
+bool GetOutputAbstracts(const AbstractBasePtr &abstract, std::vector<abstract::AbstractTensorPtr> *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  if (abstract == nullptr) {
+    return false;
+  }
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    for (const auto &element : abstract->cast<abstract::AbstractTuplePtr>()->elements()) {
+      if (!IsStaticTensorAbstract(element)) {
+        return false;
+      }
+      outputs->push_back(element->cast<abstract::AbstractTensorPtr>());
+    }
+  } else if (IsStaticTensorAbstract(abstract)) {
+    outputs->push_back(abstract->cast<abstract::AbstractTensorPtr>());
+  }
+  return !outputs->empty();
+}
+
+void FlattenOutputs(const VectorRef &outputs, std::vector<tensor::TensorPtr> *tensors) {
+  for (const auto &item : outputs) {
+    if (utils::isa<VectorRef>(item)) {
+      FlattenOutputs(utils::cast<VectorRef>(item), tensors);
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      tensors->push_back(utils::cast<tensor::TensorPtr>(item));
+    } else {
+      tensors->push_back(nullptr);
+    }
+  }
+}
+
+void BindOutput(const tensor::TensorPtr &placeholder, const tensor::TensorPtr &output) {
+  MS_EXCEPTION_IF_NULL(placeholder);
+  MS_EXCEPTION_IF_NULL(output);
+  placeholder->set_padding_type(output->padding_type());
+  if (output->device_address() != nullptr) {
+    placeholder->set_device_address(output->device_address());
+    placeholder->set_sync_status(kNeedSyncDeviceToHost);
+    return;
+  }
+  auto ret = memcpy_s(placeholder->data_c(), placeholder->Size(), output->data_c(), output->Size());
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "Copy the output of the op sequence failed, ret: " << ret;
+  }
+}
+}  // namespace
+
+OpSequenceCapture &OpSequenceCapture::GetInstance() {
+  static OpSequenceCapture instance;
+  return instance;
+}
+
+OpSequenceCapture::OpSequenceCapture() : enable_(EnableOpCapture()) {}
+
+bool OpSequenceCapture::GetOpKey(const session::BackendOpRunInfoPtr &op_run_info, std::string *key) const {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  MS_EXCEPTION_IF_NULL(key);
+  const auto &base_op_run_info = op_run_info->base_op_run_info;
+  const auto &op_prim = op_run_info->op_prim;
+  if (op_prim == nullptr || HasSideEffect(*op_prim)) {
+    return false;
+  }
+  std::vector<abstract::AbstractTensorPtr> output_abstracts;
+  if (!GetOutputAbstracts(base_op_run_info.abstract, &output_abstracts)) {
+    return false;
+  }
+  const auto &input_tensors = base_op_run_info.input_tensor;
+  const auto &input_mask = base_op_run_info.input_mask;
+  if (input_tensors.size() != input_mask.size()) {
+    return false;
+  }
+
+  // Unlike the graph info of the op, the device address of the inputs is not a part of the key, since the inputs
+  // produced by the deferred ops have no device address yet.
+  std::ostringstream buf;
+  buf << base_op_run_info.device_target << "_" << base_op_run_info.op_name << "_";
+  for (size_t index = 0; index < input_tensors.size(); ++index) {
+    const auto &input_tensor = input_tensors[index];
+    MS_EXCEPTION_IF_NULL(input_tensor);
+    buf << input_mask[index] << input_tensor->shape() << input_tensor->data_type() << input_tensor->padding_type();
+    if (input_mask[index] == kValueNodeTensorMask) {
+      buf << common::AnfAlgo::GetTensorValueString(input_tensor);
+    }
+    buf << "_";
+  }
+  const auto &attr_map = op_prim->attrs();
+  (void)std::for_each(attr_map.begin(), attr_map.end(),
+                      [&buf](const auto &element) { buf << element.first << element.second->ToString(); });
+  const auto &abstract = base_op_run_info.abstract;
+  buf << "_" << abstract->BuildShape()->ToString() << abstract->BuildType()->ToString();
+  *key = buf.str();
+  return true;
+}
+
+bool OpSequenceCapture::Replay(const session::BackendOpRunInfoPtr &op_run_info, const OpSequenceRunner &runner,
+                               VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  MS_EXCEPTION_IF_NULL(outputs);
+  last_op_run_info_ = nullptr;
+  if (!enable_ || flushing_) {
+    return false;
+  }
+  std::string key;
+  if (!GetOpKey(op_run_info, &key)) {
+    Interrupt();
+    return false;
+  }
+  last_op_run_info_ = op_run_info.get();
+  last_op_key_ = key;
+
+  if (replay_done_) {
+    // More ops are run after the sequence, the step is not the same as the steps recorded.
+    MS_LOG(DEBUG) << "Op " << op_run_info->base_op_run_info.op_name << " is run after the replayed op sequence";
+    ReplayFailed(replay_sequence_);
+    replay_sequence_ = nullptr;
+    replay_done_ = false;
+    record_valid_ = false;
+    return false;
+  }
+  if (replay_sequence_ == nullptr) {
+    if (!sequence_start_) {
+      return false;
+    }
+    auto iter = sequences_.find(key);
+    if (iter == sequences_.end() || iter->second->disabled || iter->second->stable_count < kStableSequenceCount) {
+      return false;
+    }
+    replay_sequence_ = iter->second;
+    replay_runner_ = runner;
+    replay_args_.assign(replay_sequence_->external_abstracts.size(), nullptr);
+  }
+
+  const auto &captured_op = replay_sequence_->ops[deferred_ops_.size()];
+  if (captured_op.key != key || !MatchOp(captured_op, op_run_info)) {
+    MS_LOG(DEBUG) << "Op " << op_run_info->base_op_run_info.op_name << " does not match the op " << deferred_ops_.size()
+                  << " of the replayed op sequence";
+    if (deferred_ops_.empty()) {
+      ReplayFailed(replay_sequence_);
+      replay_sequence_ = nullptr;
+    } else {
+      Flush();
+    }
+    return false;
+  }
+  sequence_start_ = false;
+  last_op_run_info_ = nullptr;
+  Defer(captured_op, op_run_info, outputs);
+  if (deferred_ops_.size() == replay_sequence_->ops.size()) {
+    Launch();
+  }
+  return true;
+}
+
+bool OpSequenceCapture::MatchOp(const CapturedOp &captured_op, const session::BackendOpRunInfoPtr &op_run_info) {
+  const auto &input_tensors = op_run_info->base_op_run_info.input_tensor;
+  if (input_tensors.size() != captured_op.inputs.size()) {
+    return false;
+  }
+  std::vector<std::pair<size_t, tensor::TensorPtr>> new_args;
+  for (size_t i = 0; i < input_tensors.size(); ++i) {
+    const auto &input_tensor = input_tensors[i];
+    const auto &captured_input = captured_op.inputs[i];
+    if (captured_input.kind == InputKind::kOpOutput) {
+      if (input_tensor != deferred_ops_[captured_input.index].outputs[captured_input.output_index]) {
+        return false;
+      }
+    } else if (captured_input.kind == InputKind::kExternal) {
+      if (placeholders_.count(input_tensor->id()) != 0) {
+        return false;
+      }
+      auto arg = replay_args_[captured_input.index];
+      auto iter = std::find_if(new_args.begin(), new_args.end(),
+                               [&captured_input](const auto &item) { return item.first == captured_input.index; });
+      if (iter != new_args.end()) {
+        arg = iter->second;
+      }
+      if (arg != nullptr && arg != input_tensor) {
+        return false;
+      }
+      (void)new_args.emplace_back(captured_input.index, input_tensor);
+    }
+  }
+  for (const auto &item : new_args) {
+    replay_args_[item.first] = item.second;
+  }
+  return true;
+}
+
+void OpSequenceCapture::Defer(const CapturedOp &captured_op, const session::BackendOpRunInfoPtr &op_run_info,
+                              VectorRef *outputs) {
+  std::vector<abstract::AbstractTensorPtr> output_abstracts;
+  (void)GetOutputAbstracts(captured_op.abstract, &output_abstracts);
+  DeferredOp deferred_op{op_run_info, {}};
+  for (const auto &output_abstract : output_abstracts) {
+    auto type_id = output_abstract->element()->BuildType()->type_id();
+    auto placeholder = std::make_shared<tensor::Tensor>(type_id, output_abstract->shape()->shape());
+    placeholder->set_lazy_callback([]() { runtime::OpExecutor::GetInstance().Wait(); });
+    (void)placeholders_.emplace(placeholder->id(), placeholder);
+    deferred_op.outputs.push_back(placeholder);
+    outputs->emplace_back(placeholder);
+  }
+  deferred_ops_.push_back(std::move(deferred_op));
+}
+
+void OpSequenceCapture::Launch() {
+  auto sequence = replay_sequence_;
+  auto deferred_ops = std::move(deferred_ops_);
+  deferred_ops_.clear();
+  auto args = std::move(replay_args_);
+  replay_args_.clear();
+  placeholders_.clear();
+  replay_done_ = true;
+
+  // The outputs used by nothing but the other ops of the sequence are not the outputs of the graph.
+  std::vector<std::vector<size_t>> internal_uses(sequence->ops.size());
+  for (size_t i = 0; i < sequence->ops.size(); ++i) {
+    internal_uses[i].resize(sequence->ops[i].output_num, 0);
+  }
+  for (const auto &captured_op : sequence->ops) {
+    for (const auto &input : captured_op.inputs) {
+      if (input.kind == InputKind::kOpOutput) {
+        ++internal_uses[input.index][input.output_index];
+      }
+    }
+  }
+  bool need_compile = sequence->actor_info.empty();
+  auto output_mask = sequence->compiled_outputs;
+  output_mask.resize(sequence->ops.size());
+  for (size_t i = 0; i < deferred_ops.size(); ++i) {
+    output_mask[i].resize(deferred_ops[i].outputs.size(), false);
+    for (size_t j = 0; j < deferred_ops[i].outputs.size(); ++j) {
+      // Referenced by the deferred op and the consumers of it.
+      auto use_count = LongToSize(deferred_ops[i].outputs[j].use_count());
+      if (use_count > 1 + internal_uses[i][j] && !output_mask[i][j]) {
+        output_mask[i][j] = true;
+        need_compile = true;
+      }
+    }
+  }
+
+  std::vector<tensor::TensorPtr> graph_outputs;
+  try {
+    if (need_compile) {
+      MS_LOG(INFO) << "Compile the op sequence of " << sequence->ops.size() << " ops";
+      sequence->actor_info = replay_runner_.compile_graph(BuildGraph(*sequence, output_mask));
+      sequence->compiled_outputs = output_mask;
+    }
+    VectorRef graph_args;
+    for (const auto &arg : args) {
+      graph_args.emplace_back(arg);
+    }
+    VectorRef outputs;
+    replay_runner_.run_graph(sequence->actor_info, graph_args, &outputs);
+    FlattenOutputs(outputs, &graph_outputs);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Run the op sequence of " << sequence->ops.size() << " ops failed, it will not be replayed any "
+                    << "more: " << e.what();
+    graph_outputs.clear();
+  }
+
+  size_t output_num = 0;
+  for (const auto &mask : output_mask) {
+    output_num += static_cast<size_t>(std::count(mask.begin(), mask.end(), true));
+  }
+  if (graph_outputs.size() != output_num ||
+      std::any_of(graph_outputs.begin(), graph_outputs.end(), [](const auto &output) { return output == nullptr; })) {
+    MS_LOG(WARNING) << "The outputs of the op sequence do not match the ops, expect " << output_num << ", but got "
+                    << graph_outputs.size();
+    sequence->disabled = true;
+    replay_sequence_ = nullptr;
+    replay_done_ = false;
+    RunDeferredOps(std::move(deferred_ops));
+    return;
+  }
+  size_t output_index = 0;
+  for (size_t i = 0; i < deferred_ops.size(); ++i) {
+    for (size_t j = 0; j < deferred_ops[i].outputs.size(); ++j) {
+      if (output_mask[i][j]) {
+        BindOutput(deferred_ops[i].outputs[j], graph_outputs[output_index++]);
+      }
+    }
+  }
+}
+
+FuncGraphPtr OpSequenceCapture::BuildGraph(const OpSequence &sequence,
+                                           const std::vector<std::vector<bool>> &output_mask) const {
+  auto func_graph = std::make_shared<FuncGraph>();
+  std::vector<AnfNodePtr> parameters;
+  for (const auto &abstract : sequence.external_abstracts) {
+    auto parameter = func_graph->add_parameter();
+    parameter->set_abstract(abstract);
+    parameters.push_back(parameter);
+  }
+
+  std::vector<std::vector<AnfNodePtr>> op_outputs(sequence.ops.size());
+  AnfNodePtrList make_tuple_inputs{NewValueNode(prim::kPrimMakeTuple)};
+  AbstractBasePtrList output_abstracts;
+  for (size_t i = 0; i < sequence.ops.size(); ++i) {
+    const auto &captured_op = sequence.ops[i];
+    AnfNodePtrList inputs{NewValueNode(captured_op.prim)};
+    for (const auto &input : captured_op.inputs) {
+      if (input.kind == InputKind::kExternal) {
+        inputs.push_back(parameters[input.index]);
+      } else if (input.kind == InputKind::kOpOutput) {
+        inputs.push_back(op_outputs[input.index][input.output_index]);
+      } else {
+        auto value_node = NewValueNode(input.value);
+        value_node->set_abstract(input.value->ToAbstract());
+        inputs.push_back(value_node);
+      }
+    }
+    auto cnode = func_graph->NewCNode(inputs);
+    cnode->set_abstract(captured_op.abstract);
+    if (captured_op.abstract->isa<abstract::AbstractTuple>()) {
+      const auto &elements = captured_op.abstract->cast<abstract::AbstractTuplePtr>()->elements();
+      for (size_t j = 0; j < elements.size(); ++j) {
+        auto index_node = NewValueNode(SizeToLong(j));
+        index_node->set_abstract(std::make_shared<abstract::AbstractScalar>(SizeToLong(j)));
+        auto tuple_get_item = func_graph->NewCNode({NewValueNode(prim::kPrimTupleGetItem), cnode, index_node});
+        tuple_get_item->set_abstract(elements[j]);
+        op_outputs[i].push_back(tuple_get_item);
+      }
+    } else {
+      op_outputs[i].push_back(cnode);
+    }
+    for (size_t j = 0; j < op_outputs[i].size(); ++j) {
+      if (j < output_mask[i].size() && output_mask[i][j]) {
+        make_tuple_inputs.push_back(op_outputs[i][j]);
+        output_abstracts.push_back(op_outputs[i][j]->abstract());
+      }
+    }
+  }
+  auto output = func_graph->NewCNode(make_tuple_inputs);
+  output->set_abstract(std::make_shared<abstract::AbstractTuple>(output_abstracts));
+  func_graph->set_output(output);
+  (void)Manage(func_graph, true);
+  return func_graph;
+}
+
+void OpSequenceCapture::RunDeferredOps(std::vector<DeferredOp> &&deferred_ops) {
+  auto runner = replay_runner_;
+  flushing_ = true;
+  try {
+    for (const auto &deferred_op : deferred_ops) {
+      VectorRef outputs;
+      runner.run_op(deferred_op.op_run_info, &outputs);
+      std::vector<tensor::TensorPtr> output_tensors;
+      FlattenOutputs(outputs, &output_tensors);
+      if (output_tensors.size() != deferred_op.outputs.size()) {
+        MS_LOG(EXCEPTION) << "The outputs num of op " << deferred_op.op_run_info->base_op_run_info.op_name
+                          << " is " << output_tensors.size() << ", but " << deferred_op.outputs.size()
+                          << " is deferred";
+      }
+      for (size_t i = 0; i < output_tensors.size(); ++i) {
+        BindOutput(deferred_op.outputs[i], output_tensors[i]);
+        // The consumers recorded later take the placeholder as the input.
+        auto iter = record_producers_.find(output_tensors[i]->id());
+        if (iter != record_producers_.end()) {
+          record_producers_[deferred_op.outputs[i]->id()] = iter->second;
+        }
+      }
+    }
+  } catch (...) {
+    flushing_ = false;
+    throw;
+  }
+  flushing_ = false;
+}
+
+void OpSequenceCapture::Flush() {
+  if (flushing_ || deferred_ops_.empty()) {
+    return;
+  }
+  auto sequence = replay_sequence_;
+  MS_EXCEPTION_IF_NULL(sequence);
+  MS_LOG(DEBUG) << "Run " << deferred_ops_.size() << " deferred ops of the op sequence of " << sequence->ops.size()
+                << " ops";
+  auto deferred_ops = std::move(deferred_ops_);
+  deferred_ops_.clear();
+  replay_sequence_ = nullptr;
+  replay_args_.clear();
+  placeholders_.clear();
+  RunDeferredOps(std::move(deferred_ops));
+  ReplayFailed(sequence);
+}
+
+void OpSequenceCapture::ReplayFailed(const OpSequencePtr &sequence) {
+  MS_EXCEPTION_IF_NULL(sequence);
+  sequence->stable_count = 0;
+  if (++sequence->failure_count >= kMaxReplayFailures && !sequence->disabled) {
+    MS_LOG(INFO) << "The replay of the op sequence of " << sequence->ops.size() << " ops failed "
+                 << sequence->failure_count << " times, it will not be replayed any more";
+    sequence->disabled = true;
+  }
+}
+
+void OpSequenceCapture::Record(const session::BackendOpRunInfoPtr &op_run_info, const VectorRef &outputs) {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  std::string key;
+  if (last_op_run_info_ == op_run_info.get()) {
+    key = std::move(last_op_key_);
+  } else if (enable_ && !GetOpKey(op_run_info, &key)) {
+    key.clear();
+  }
+  last_op_run_info_ = nullptr;
+  if (!enable_ || !record_valid_) {
+    return;
+  }
+  if (key.empty()) {
+    Interrupt();
+    return;
+  }
+  const auto &base_op_run_info = op_run_info->base_op_run_info;
+  if (record_ops_.empty()) {
+    record_device_target_ = base_op_run_info.device_target;
+  } else if (base_op_run_info.device_target != record_device_target_ || record_ops_.size() >= kMaxSequenceSize) {
+    record_valid_ = false;
+    return;
+  }
+  sequence_start_ = false;
+
+  std::vector<tensor::TensorPtr> output_tensors;
+  FlattenOutputs(outputs, &output_tensors);
+  CapturedOp captured_op;
+  captured_op.key = std::move(key);
+  captured_op.prim = std::make_shared<Primitive>(*op_run_info->op_prim);
+  captured_op.abstract = base_op_run_info.abstract;
+  captured_op.output_num = output_tensors.size();
+  const auto &input_tensors = base_op_run_info.input_tensor;
+  for (size_t i = 0; i < input_tensors.size(); ++i) {
+    const auto &input_tensor = input_tensors[i];
+    CapturedInput captured_input{InputKind::kExternal, 0, 0, nullptr};
+    auto producer_iter = record_producers_.find(input_tensor->id());
+    if (base_op_run_info.input_mask[i] == kValueNodeTensorMask) {
+      captured_input.kind = InputKind::kConst;
+      captured_input.value = input_tensor;
+    } else if (producer_iter != record_producers_.end()) {
+      captured_input.kind = InputKind::kOpOutput;
+      captured_input.index = producer_iter->second.first;
+      captured_input.output_index = producer_iter->second.second;
+    } else {
+      auto external_iter = record_externals_.find(input_tensor->id());
+      if (external_iter == record_externals_.end()) {
+        external_iter = record_externals_.emplace(input_tensor->id(), record_external_abstracts_.size()).first;
+        record_external_abstracts_.push_back(
+          std::make_shared<abstract::AbstractTensor>(input_tensor->Dtype(), input_tensor->shape()));
+      }
+      captured_input.index = external_iter->second;
+    }
+    captured_op.inputs.push_back(std::move(captured_input));
+  }
+  for (size_t i = 0; i < output_tensors.size(); ++i) {
+    if (output_tensors[i] == nullptr) {
+      record_valid_ = false;
+      return;
+    }
+    record_producers_[output_tensors[i]->id()] = std::make_pair(record_ops_.size(), i);
+  }
+  record_ops_.push_back(std::move(captured_op));
+}
+
+void OpSequenceCapture::Interrupt() {
+  last_op_run_info_ = nullptr;
+  if (!enable_ || flushing_ || sequence_start_) {
+    return;
+  }
+  // The deferred ops must be run before the op.
+  Flush();
+  if (replay_done_) {
+    ReplayFailed(replay_sequence_);
+    replay_sequence_ = nullptr;
+    replay_done_ = false;
+  }
+  record_valid_ = false;
+}
+
+void OpSequenceCapture::EndSequence() {
+  Flush();
+  if (!replay_done_ && record_valid_ && !record_ops_.empty()) {
+    const auto &first_key = record_ops_.front().key;
+    auto iter = sequences_.find(first_key);
+    auto is_same_op = [](const CapturedOp &op, const CapturedOp &other) {
+      return op.key == other.key &&
+             std::equal(op.inputs.begin(), op.inputs.end(), other.inputs.begin(), other.inputs.end(),
+                        [](const CapturedInput &input, const CapturedInput &other_input) {
+                          return input.kind == other_input.kind && input.index == other_input.index &&
+                                 input.output_index == other_input.output_index;
+                        });
+    };
+    if (iter != sequences_.end() && std::equal(iter->second->ops.begin(), iter->second->ops.end(),
+                                               record_ops_.begin(), record_ops_.end(), is_same_op)) {
+      if (++iter->second->stable_count == kStableSequenceCount && !iter->second->disabled) {
+        MS_LOG(INFO) << "Capture the op sequence of " << record_ops_.size() << " ops";
+      }
+    } else if (iter != sequences_.end() || sequences_.size() < kMaxSequenceNum) {
+      auto sequence = std::make_shared<OpSequence>();
+      sequence->ops = std::move(record_ops_);
+      sequence->external_abstracts = std::move(record_external_abstracts_);
+      sequence->stable_count = 1;
+      sequences_[sequence->ops.front().key] = sequence;
+    }
+  }
+  ResetSegment();
+  enable_ = EnableOpCapture();
+}
+
+void OpSequenceCapture::ResetSegment() {
+  sequence_start_ = true;
+  record_valid_ = true;
+  record_device_target_.clear();
+  record_ops_.clear();
+  record_external_abstracts_.clear();
+  record_producers_.clear();
+  record_externals_.clear();
+  replay_sequence_ = nullptr;
+  replay_done_ = false;
+  deferred_ops_.clear();
+  replay_args_.clear();
+  placeholders_.clear();
+  last_op_key_.clear();
+  last_op_run_info_ = nullptr;
+}
+
+void OpSequenceCapture::Clear() {
+  ResetSegment();
+  replay_runner_ = OpSequenceRunner();
+  sequences_.clear();
+}
+}  // namespace mindspore::runtime
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_SEQUENCE_CAPTURE_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_SEQUENCE_CAPTURE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/ms_utils.h"
+#include "ir/func_graph.h"
+#include "ir/tensor.h"
+#include "base/base_ref.h"
+#include "backend/common/session/session_basic.h"
+#include "include/backend/visible.h"
+
+namespace mindspore::runtime {
+// The backend entries used to run the ops and the captured graphs.
+struct OpSequenceRunner {
+  // Run a single op eagerly.
+  std::function<void(const session::BackendOpRunInfoPtr &, VectorRef *)> run_op;
+  // Compile the graph of a captured op sequence, return the key to run it.
+  std::function<std::string(const FuncGraphPtr &)> compile_graph;
+  // Run the compiled graph of a captured op sequence.
+  std::function<void(const std::string &, const VectorRef &, VectorRef *)> run_graph;
+};
+
+// OpSequenceCapture records the ops run between the start and the end of the top cell in PyNative mode. When the same
+// sequence of ops, with the same shapes, types and attrs, is run in several consecutive steps, the sequence is fused
+// into one graph, and the ops of the next steps are deferred and replayed by running the graph once the last op of the
+// sequence arrives. The outputs of the deferred ops are placeholder tensors which are bound to the outputs of the
+// graph; reading a placeholder before the graph is run, or an op that differs from the recorded one, runs the deferred
+// ops one by one instead.
+class BACKEND_EXPORT OpSequenceCapture {
+ public:
+  static OpSequenceCapture &GetInstance();
+
+  // Defer the op if it is the next op of a stable sequence, and fill the placeholder outputs of it.
+  bool Replay(const session::BackendOpRunInfoPtr &op_run_info, const OpSequenceRunner &runner, VectorRef *outputs);
+  // Record the op run eagerly.
+  void Record(const session::BackendOpRunInfoPtr &op_run_info, const VectorRef &outputs);
+  // An op which can not be captured is run, the sequence is broken.
+  void Interrupt();
+  // The top cell ends, the ops recorded since the last end form a sequence.
+  void EndSequence();
+  // Run the deferred ops one by one.
+  void Flush();
+  // Drop the deferred ops and all the sequences.
+  void Clear();
+
+ private:
+  OpSequenceCapture();
+  ~OpSequenceCapture() = default;
+  DISABLE_COPY_AND_ASSIGN(OpSequenceCapture);
+
+  enum class InputKind { kExternal, kOpOutput, kConst };
+  struct CapturedInput {
+    InputKind kind;
+    // The index of the external input, or the index of the producer op.
+    size_t index{0};
+    // The output index of the producer op.
+    size_t output_index{0};
+    tensor::TensorPtr value;
+  };
+  struct CapturedOp {
+    std::string key;
+    PrimitivePtr prim;
+    AbstractBasePtr abstract;
+    size_t output_num{0};
+    std::vector<CapturedInput> inputs;
+  };
+  struct OpSequence {
+    std::vector<CapturedOp> ops;
+    std::vector<AbstractBasePtr> external_abstracts;
+    size_t stable_count{0};
+    size_t failure_count{0};
+    bool disabled{false};
+    // The outputs of the ops returned by the compiled graph, indexed by op and output index.
+    std::vector<std::vector<bool>> compiled_outputs;
+    std::string actor_info;
+  };
+  using OpSequencePtr = std::shared_ptr<OpSequence>;
+  struct DeferredOp {
+    session::BackendOpRunInfoPtr op_run_info;
+    std::vector<tensor::TensorPtr> outputs;
+  };
+
+  bool GetOpKey(const session::BackendOpRunInfoPtr &op_run_info, std::string *key) const;
+  bool MatchOp(const CapturedOp &captured_op, const session::BackendOpRunInfoPtr &op_run_info);
+  void Defer(const CapturedOp &captured_op, const session::BackendOpRunInfoPtr &op_run_info, VectorRef *outputs);
+  void Launch();
+  FuncGraphPtr BuildGraph(const OpSequence &sequence, const std::vector<std::vector<bool>> &output_mask) const;
+  void RunDeferredOps(std::vector<DeferredOp> &&deferred_ops);
+  void ReplayFailed(const OpSequencePtr &sequence);
+  void ResetSegment();
+
+  bool enable_{false};
+  bool flushing_{false};
+  // No op has been run since the top cell started.
+  bool sequence_start_{true};
+
+  // The ops recorded in the current step.
+  bool record_valid_{true};
+  std::string record_device_target_;
+  std::vector<CapturedOp> record_ops_;
+  std::vector<AbstractBasePtr> record_external_abstracts_;
+  mindspore::HashMap<std::string, std::pair<size_t, size_t>> record_producers_;
+  mindspore::HashMap<std::string, size_t> record_externals_;
+
+  // The sequence replayed in the current step.
+  OpSequencePtr replay_sequence_;
+  bool replay_done_{false};
+  OpSequenceRunner replay_runner_;
+  std::vector<DeferredOp> deferred_ops_;
+  std::vector<tensor::TensorPtr> replay_args_;
+  mindspore::HashMap<std::string, tensor::TensorPtr> placeholders_;
+
+  // The key of the op computed by Replay, reused by Record.
+  std::string last_op_key_;
+  const session::BackendOpRunInfo *last_op_run_info_{nullptr};
+
+  // The sequences keyed by the key of the first op.
+  mindspore::HashMap<std::string, OpSequencePtr> sequences_;
+};
+}  // namespace mindspore::runtime
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_SEQUENCE_CAPTURE_H_
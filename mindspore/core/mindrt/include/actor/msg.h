@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -75,6 +76,7 @@ class MessageBase {
 
   friend class ActorBase;
   friend class TCPMgr;
+  friend class LockFreeMailBox;
   AID from;
   AID to;
   std::string name;
@@ -85,6 +87,10 @@ class MessageBase {
   size_t size;
 
   Type type;
+
+ private:
+  // The link of the intrusive message queue of LockFreeMailBox.
+  std::atomic<MessageBase *> next{nullptr};
 };
 }  // namespace mindspore
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "actor/mailbox.h"
+#include <thread>
 
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
@@ -70,6 +71,80 @@ std::list<std::unique_ptr<MessageBase>> *NonblockingMailBox::GetMsgs() {
   return ret;
 }
 
+LockFreeMailBox::~LockFreeMailBox() {
+  while (auto msg = Pop()) {
+    delete msg;
+  }
+}
+
+void LockFreeMailBox::Push(MessageBase *msg) {
+  msg->next.store(nullptr, std::memory_order_relaxed);
+  MessageBase *prev = head.exchange(msg, std::memory_order_acq_rel);
+  prev->next.store(msg, std::memory_order_release);
+}
+
+MessageBase *LockFreeMailBox::Pop() {
+  MessageBase *first = tail;
+  MessageBase *next = first->next.load(std::memory_order_acquire);
+  if (first == &stub) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail = next;
+    first = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail = next;
+    return first;
+  }
+  if (first != head.load(std::memory_order_acquire)) {
+    // a producer has swapped the head but not linked its message yet
+    return nullptr;
+  }
+  // first is the last message, push the stub behind it so that first can be taken away
+  Push(&stub);
+  next = first->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail = next;
+    return first;
+  }
+  return nullptr;
+}
+
+int LockFreeMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  // count the message before it is visible, so the consumer never sees more messages than pendingNum
+  int64_t prevNum = pendingNum.fetch_add(1, std::memory_order_acq_rel);
+  Push(msg.release());
+  if (prevNum == 0 && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> LockFreeMailBox::GetMsg() {
+  while (true) {
+    MessageBase *msg = Pop();
+    if (msg != nullptr) {
+      ++consumedNum;
+      return std::unique_ptr<MessageBase>(msg);
+    }
+    if (consumedNum > 0) {
+      int64_t consumed = consumedNum;
+      consumedNum = 0;
+      if (pendingNum.fetch_sub(consumed, std::memory_order_acq_rel) == consumed) {
+        return nullptr;
+      }
+      continue;
+    }
+    if (pendingNum.load(std::memory_order_acquire) == 0) {
+      return nullptr;
+    }
+    // the pending messages are being linked by producers
+    std::this_thread::yield();
+  }
+}
+
 int HQueMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
   bool empty = mailbox.Empty();
   MessageBase *msgPtr = msg.release();
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -82,6 +83,35 @@ class NonblockingMailBox : public MailBox {
   bool released_ = true;
 };
 
+// LockFreeMailBox is an unbounded multi-producer single-consumer mailbox, the messages are linked through the
+// intrusive link of MessageBase, so enqueue takes neither a lock nor a memory allocation (refer to Dmitry Vyukov's
+// intrusive MPSC node-based queue).
+// The number of pending messages decides who schedules the actor: the producer which makes it non-zero calls the
+// notify hook, and the consumer drains messages until it brings the number back to zero, it is decreased once per
+// drained batch instead of once per message.
+class LockFreeMailBox : public MailBox {
+ public:
+  LockFreeMailBox() : head(&stub), tail(&stub) { takeAllMsgsEachTime = false; }
+  ~LockFreeMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  // Return nullptr once the mailbox is drained, the next enqueued message will notify the actor again.
+  std::unique_ptr<MessageBase> GetMsg() override;
+
+ private:
+  void Push(MessageBase *msg);
+  // Return nullptr if the queue is empty or a producer has not finished linking its message.
+  MessageBase *Pop();
+
+  MessageBase stub;
+  // Producers push to the head, the consumer pops from the tail.
+  alignas(64) std::atomic<MessageBase *> head;
+  alignas(64) MessageBase *tail;
+  alignas(64) std::atomic<int64_t> pendingNum{0};
+  // The number of messages popped since pendingNum was decreased last time, only touched by the consumer.
+  int64_t consumedNum = 0;
+};
+
 class HQueMailBox : public MailBox {
  public:
   HQueMailBox() { takeAllMsgsEachTime = false; }
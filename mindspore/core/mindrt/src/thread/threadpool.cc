@@ -19,6 +19,7 @@
 #endif
 #include "thread/threadpool.h"
 #include "thread/core_affinity.h"
+#include "thread/work_stealing_threadpool.h"
 
 namespace mindspore {
 std::mutex ThreadPool::create_thread_pool_muntex_;
@@ -508,7 +509,11 @@ void ThreadPool::SetMinSpinCount(int spin_count) {
   min_spin_count_ = spin_count;
 }
 
-ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, const std::vector<int> &core_list) {
+ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, const std::vector<int> &core_list,
+                                         TaskScheduleMode schedule_mode) {
+  if (schedule_mode == kWorkStealing) {
+    return WorkStealingThreadPool::CreateThreadPool(thread_num, core_list);
+  }
   std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
   ThreadPool *pool = new (std::nothrow) ThreadPool();
   if (pool == nullptr) {
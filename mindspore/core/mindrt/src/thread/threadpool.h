@@ -53,6 +53,12 @@ constexpr int kThreadBusy = 0;  // busy, the thread is running task
 constexpr int kThreadHeld = 1;  // held, the thread has been marked as occupied
 constexpr int kThreadIdle = 2;  // idle, the thread is waiting
 
+/* Task schedule mode of ParallelLaunch */
+enum TaskScheduleMode {
+  kStaticSplit = 0,  // task ids are divided evenly among the idle workers in advance
+  kWorkStealing = 1  // task ranges are split recursively and idle workers steal from the busy ones
+};
+
 // used in scenarios with unequal division of task
 // the parameters indicate the start and end coefficients
 
@@ -153,7 +159,8 @@ class Worker {
 
 class MS_CORE_API ThreadPool {
  public:
-  static ThreadPool *CreateThreadPool(size_t thread_num, const std::vector<int> &core_list = {});
+  static ThreadPool *CreateThreadPool(size_t thread_num, const std::vector<int> &core_list = {},
+                                      TaskScheduleMode schedule_mode = kStaticSplit);
   virtual ~ThreadPool();
 
   size_t thread_num() const { return workers_.size(); }
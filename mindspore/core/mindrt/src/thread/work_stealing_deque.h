@@ -0,0 +1,123 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace mindspore {
+// implement a bounded Chase-Lev work-stealing deque
+// refer to https://fzn.fr/readings/ppopp13.pdf
+// only the owner thread may call Push and Pop, any thread may call Steal
+template <typename T>
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+  WorkStealingDeque() {}
+  virtual ~WorkStealingDeque() {}
+
+  bool IsInit() const { return buffer_ != nullptr; }
+
+  // sz is rounded up to the power of two
+  bool Init(int64_t sz) {
+    if (IsInit() || sz <= 0) {
+      return false;
+    }
+    int64_t capacity = 1;
+    while (capacity < sz) {
+      capacity <<= 1;
+    }
+    buffer_.reset(new (std::nothrow) std::atomic<T *>[capacity]);
+    if (buffer_ == nullptr) {
+      return false;
+    }
+    for (int64_t i = 0; i < capacity; ++i) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    top_ = 0;
+    bottom_ = 0;
+    return true;
+  }
+
+  // return false if the deque is full, the caller keeps the ownership of t
+  bool Push(T *t) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t_idx = top_.load(std::memory_order_acquire);
+    if (b - t_idx > mask_) {
+      return false;
+    }
+    buffer_[b & mask_].store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // pop from the bottom, LIFO for the owner to keep the cache hot
+  T *Pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t_idx = top_.load(std::memory_order_relaxed);
+    if (t_idx > b) {
+      // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *ret = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t_idx == b) {
+      // the last one, race against thieves
+      if (!top_.compare_exchange_strong(t_idx, t_idx + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        ret = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return ret;
+  }
+
+  // steal from the top, FIFO for thieves to take the largest pieces of work
+  T *Steal() {
+    int64_t t_idx = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t_idx >= b) {
+      return nullptr;
+    }
+    T *ret = buffer_[t_idx & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t_idx, t_idx + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return ret;
+  }
+
+  bool Empty() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t_idx = top_.load(std::memory_order_relaxed);
+    return t_idx >= b;
+  }
+
+ private:
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::unique_ptr<std::atomic<T *>[]> buffer_ { nullptr };
+  int64_t mask_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
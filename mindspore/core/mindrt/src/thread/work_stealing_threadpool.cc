@@ -0,0 +1,224 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _MSC_VER
+#include <sched.h>
+#include <unistd.h>
+#endif
+#include <memory>
+#include "thread/work_stealing_threadpool.h"
+#include "thread/core_affinity.h"
+
+namespace mindspore {
+void WorkStealingWorker::CreateThread() { thread_ = std::thread(&WorkStealingWorker::StealingRun, this); }
+
+void WorkStealingWorker::StealingRun() {
+  if (!core_list_.empty()) {
+    SetAffinity();
+  }
+#if !defined(__APPLE__) && !defined(_MSC_VER)
+  (void)pthread_setname_np(pthread_self(), ("StealingThread_" + std::to_string(worker_id_)).c_str());
+#endif
+#ifdef PLATFORM_86
+  // Some CPU kernels need set the flush zero mode to improve performance.
+  _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+  _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+#endif
+  while (alive_) {
+    if (RunLocalKernelTask()) {
+      spin_count_ = 0;
+    } else {
+      if (++spin_count_ > max_spin_count_) {
+        WaitUntilActive();
+        spin_count_ = 0;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+void WorkStealingWorker::WaitUntilActive() {
+  std::unique_lock<std::mutex> _l(mutex_);
+  cond_var_.wait(_l, [&, this] { return active_num_ > 0 || !alive_; });
+  if (active_num_ > 0) {
+    active_num_--;
+  }
+}
+
+bool WorkStealingWorker::RunLocalKernelTask() { return stealing_pool_->RunStealingTask(this); }
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  // workers touch the inject queue, stop them before the members are released
+  for (auto &worker : workers_) {
+    delete worker;
+    worker = nullptr;
+  }
+  workers_.clear();
+  inject_queue_.Clean();
+}
+
+TaskRange *WorkStealingThreadPool::StealRange(WorkStealingWorker *curr) {
+  auto worker_num = workers_.size();
+  if (worker_num == 0) {
+    return nullptr;
+  }
+  static thread_local uint32_t outer_seed = 0;
+  size_t start = curr != nullptr ? curr->NextRandom() % worker_num : (outer_seed++) % worker_num;
+  for (size_t i = 0; i < worker_num; ++i) {
+    auto victim = static_cast<WorkStealingWorker *>(workers_[(start + i) % worker_num]);
+    if (victim == curr) {
+      continue;
+    }
+    auto range = victim->deque()->Steal();
+    if (range != nullptr) {
+      return range;
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingThreadPool::RunRange(TaskRange *range, WorkStealingWorker *curr) {
+  Task *task = range->task_;
+  int begin = range->begin_;
+  int end = range->end_;
+  if (curr != nullptr) {
+    // lazy binary splitting: keep the first half, expose the second half to thieves
+    while (end - begin > 1) {
+      int mid = begin + (end - begin) / 2;
+      auto split = range->buffer_->Alloc(task, mid, end);
+      if (split == nullptr || !curr->deque()->Push(split)) {
+        break;
+      }
+      end = mid;
+    }
+  } else if (end - begin > 1) {
+    // outer threads own no deque, hand the rest back to the inject queue
+    range->begin_ = begin + 1;
+    end = begin + 1;
+    while (!inject_queue_.Enqueue(range)) {
+    }
+  }
+  int finish = 0;
+  for (int i = begin; i < end; ++i) {
+    task->status |= task->func(task->content, i, 0, 1);
+    finish++;
+  }
+  // the range and the task may be released by the launcher once finished is updated
+  task->finished += finish;
+}
+
+bool WorkStealingThreadPool::RunStealingTask(WorkStealingWorker *curr) {
+  TaskRange *range = curr != nullptr ? curr->deque()->Pop() : nullptr;
+  if (range == nullptr) {
+    range = inject_queue_.Dequeue();
+  }
+  if (range == nullptr) {
+    range = StealRange(curr);
+  }
+  if (range == nullptr) {
+    return false;
+  }
+  RunRange(range, curr);
+  return true;
+}
+
+int WorkStealingThreadPool::ParallelLaunch(const Func &func, Content content, int task_num) {
+  // if single thread, run master thread
+  if (task_num <= 1 || workers_.empty()) {
+    return SyncRunFunc(func, content, 0, task_num);
+  }
+  THREAD_DEBUG("stealing launch: %d", task_num);
+  Task task = {func, content};
+  bool own_buffer = !launch_buffer_busy_.exchange(true);
+  std::unique_ptr<TaskRangeBuffer> local_buffer = own_buffer ? nullptr : std::make_unique<TaskRangeBuffer>(task_num);
+  TaskRangeBuffer &buffer = own_buffer ? launch_buffer_ : *local_buffer;
+  if (own_buffer) {
+    buffer.Reset(task_num);
+  }
+  size_t worker_index = 0;
+  auto curr = static_cast<WorkStealingWorker *>(CurrentWorker(&worker_index));
+
+  // seed one coarse range per participant, finer pieces are produced by splitting on demand
+  int participants = static_cast<int>(workers_.size()) + (curr == nullptr ? 1 : 0);
+  int seed_num = task_num < participants ? task_num : participants;
+  int each_seed_num = task_num / seed_num;
+  int rest_num = task_num % seed_num;
+  int start = 0;
+  for (int i = 0; i < seed_num; ++i) {
+    int end = start + each_seed_num + (i < rest_num ? 1 : 0);
+    auto range = buffer.Alloc(&task, start, end);
+    if (curr == nullptr || !curr->deque()->Push(range)) {
+      while (!inject_queue_.Enqueue(range)) {
+      }
+    }
+    start = end;
+  }
+  for (size_t i = 0; i < workers_.size() && static_cast<int>(i) < seed_num; ++i) {
+    workers_[i]->Active();
+  }
+
+  // synchronization
+  // wait until the finished is equal to task_num
+  while (task.finished < task_num) {
+    if (!RunStealingTask(curr)) {
+      std::this_thread::yield();
+    }
+  }
+  // no range is referenced any more once all the tasks are finished
+  if (own_buffer) {
+    launch_buffer_busy_.store(false);
+  }
+  // check the return value of task
+  if (task.status != THREAD_OK) {
+    return THREAD_ERROR;
+  }
+  return THREAD_OK;
+}
+
+WorkStealingThreadPool *WorkStealingThreadPool::CreateThreadPool(size_t thread_num,
+                                                                 const std::vector<int> &core_list) {
+  std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
+  WorkStealingThreadPool *pool = new (std::nothrow) WorkStealingThreadPool();
+  if (pool == nullptr) {
+    return nullptr;
+  }
+  if (!pool->inject_queue_.Init(kMaxInjectQueueSize)) {
+    delete pool;
+    return nullptr;
+  }
+  if (pool->TaskQueuesInit(thread_num) != THREAD_OK) {
+    delete pool;
+    return nullptr;
+  }
+  int ret = pool->CreateThreads<WorkStealingWorker>(thread_num, core_list);
+  if (ret != THREAD_OK) {
+    delete pool;
+    return nullptr;
+  }
+  for (auto worker : pool->workers_) {
+    if (!static_cast<WorkStealingWorker *>(worker)->deque()->IsInit()) {
+      delete pool;
+      return nullptr;
+    }
+  }
+  ret = pool->InitAffinityInfo();
+  if (ret != THREAD_OK) {
+    delete pool;
+    return nullptr;
+  }
+  return pool;
+}
+}  // namespace mindspore
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_THREADPOOL_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_THREADPOOL_H_
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "thread/threadpool.h"
+#include "thread/hqueue.h"
+#include "thread/work_stealing_deque.h"
+
+namespace mindspore {
+constexpr size_t kMaxStealingDequeSize = 1024;
+constexpr size_t kMaxInjectQueueSize = 8192;
+
+struct TaskRangeBuffer;
+// a contiguous piece [begin_, end_) of task ids of one ParallelLaunch
+typedef struct TaskRange {
+  Task *task_{nullptr};
+  int begin_{0};
+  int end_{0};
+  TaskRangeBuffer *buffer_{nullptr};
+} TaskRange;
+
+// ranges of one ParallelLaunch, every range starts at a distinct task id, so task_num slots are always enough
+typedef struct TaskRangeBuffer {
+  TaskRangeBuffer() = default;
+  explicit TaskRangeBuffer(int task_num) : ranges_(task_num) {}
+  // reuse the buffer for another launch, it only grows
+  void Reset(int task_num) {
+    if (static_cast<int>(ranges_.size()) < task_num) {
+      ranges_.resize(task_num);
+    }
+    used_ = 0;
+  }
+  TaskRange *Alloc(Task *task, int begin, int end) {
+    int index = used_++;
+    if (index >= static_cast<int>(ranges_.size())) {
+      return nullptr;
+    }
+    auto range = &ranges_[index];
+    range->task_ = task;
+    range->begin_ = begin;
+    range->end_ = end;
+    range->buffer_ = this;
+    return range;
+  }
+  std::vector<TaskRange> ranges_;
+  std::atomic_int used_{0};
+} TaskRangeBuffer;
+
+class WorkStealingThreadPool;
+class WorkStealingWorker : public Worker {
+ public:
+  explicit WorkStealingWorker(ThreadPool *pool, size_t index) : Worker(pool, index) {
+    stealing_pool_ = reinterpret_cast<WorkStealingThreadPool *>(pool_);
+    seed_ = static_cast<uint32_t>(index) * 2654435761u + 1;
+    (void)deque_.Init(kMaxStealingDequeSize);
+  }
+  ~WorkStealingWorker() override {
+    {
+      std::lock_guard<std::mutex> _l(mutex_);
+      alive_ = false;
+    }
+    cond_var_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    pool_ = nullptr;
+    stealing_pool_ = nullptr;
+  }
+  void CreateThread() override;
+  bool RunLocalKernelTask() override;
+  WorkStealingDeque<TaskRange> *deque() { return &deque_; }
+  // xorshift, only used to pick the victim
+  uint32_t NextRandom() {
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+    return seed_;
+  }
+
+ protected:
+  void WaitUntilActive() override;
+
+ private:
+  void StealingRun();
+  WorkStealingThreadPool *stealing_pool_{nullptr};
+  WorkStealingDeque<TaskRange> deque_;
+  uint32_t seed_{1};
+};
+
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  static WorkStealingThreadPool *CreateThreadPool(size_t thread_num, const std::vector<int> &core_list = {});
+  ~WorkStealingThreadPool() override;
+
+  int ParallelLaunch(const Func &func, Content content, int task_num) override;
+
+  // run one range got from the own deque, the inject queue or a random victim,
+  // curr is nullptr when called by a thread outside the pool
+  bool RunStealingTask(WorkStealingWorker *curr);
+
+ private:
+  WorkStealingThreadPool() = default;
+  TaskRange *StealRange(WorkStealingWorker *curr);
+  void RunRange(TaskRange *range, WorkStealingWorker *curr);
+
+  HQueue<TaskRange> inject_queue_;
+  // ranges of the launches, reused unless a nested or concurrent launch finds it busy
+  TaskRangeBuffer launch_buffer_;
+  std::atomic_bool launch_buffer_busy_{false};
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_THREADPOOL_H_
@@ -239,6 +239,7 @@ constexpr auto kTopK = "top_k";
 constexpr auto kTrans = "trans";
 constexpr auto kTransposeA = "transpose_a";
 constexpr auto kTransposeB = "transpose_b";
+constexpr auto kTransposeK = "transpose_k";
 constexpr auto kNegativeSlope = "negative_slope";
 constexpr auto kType = "type";
 constexpr auto kUnitDiagonal = "unit_diagonal";
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ops/scaled_dot_product_attention.h"
+#include "ops/primitive_c.h"
+#include "ops/op_utils.h"
+#include "mindapi/src/helper.h"
+
+namespace mindspore {
+namespace ops {
+MIND_API_OPERATOR_IMPL(ScaledDotProductAttention, BaseOperator);
+void ScaledDotProductAttention::set_scale(const float scale) { (void)this->AddAttr(kScale, api::MakeValue(scale)); }
+
+void ScaledDotProductAttention::set_transpose_k(const bool transpose_k) {
+  (void)this->AddAttr(kTransposeK, api::MakeValue(transpose_k));
+}
+
+float ScaledDotProductAttention::get_scale() const {
+  auto value_ptr = this->GetAttr(kScale);
+  return GetValue<float>(value_ptr);
+}
+
+bool ScaledDotProductAttention::get_transpose_k() const {
+  auto value_ptr = this->GetAttr(kTransposeK);
+  return GetValue<bool>(value_ptr);
+}
+
+void ScaledDotProductAttention::Init(const float scale, const bool transpose_k) {
+  this->set_scale(scale);
+  this->set_transpose_k(transpose_k);
+}
+REGISTER_PRIMITIVE_C(kNameScaledDotProductAttention, ScaledDotProductAttention);
+}  // namespace ops
+}  // namespace mindspore
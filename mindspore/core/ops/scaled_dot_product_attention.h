@@ -0,0 +1,62 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_OPS_SCALED_DOT_PRODUCT_ATTENTION_H_
+#define MINDSPORE_CORE_OPS_SCALED_DOT_PRODUCT_ATTENTION_H_
+#include "ops/base_operator.h"
+#include "mindapi/base/types.h"
+
+namespace mindspore {
+namespace ops {
+constexpr auto kNameScaledDotProductAttention = "ScaledDotProductAttention";
+/// \brief ScaledDotProductAttention defined softmax(q * k * scale + mask) * v operator prototype of lite.
+class MIND_API ScaledDotProductAttention : public BaseOperator {
+ public:
+  MIND_API_BASE_MEMBER(ScaledDotProductAttention);
+  /// \brief Constructor.
+  ScaledDotProductAttention() : BaseOperator(kNameScaledDotProductAttention) {
+    InitIOName({"q", "k", "v", "mask"}, {"output"});
+  }
+  /// \brief Method to init the op's attributes.
+  ///
+  /// \param[in] scale Define the multiplier of q * k.
+  /// \param[in] transpose_k Define whether k is [k_seq, head_size] and multiplied transposed.
+  void Init(const float scale = 1.0f, const bool transpose_k = true);
+
+  /// \brief Method to set scale attribute.
+  ///
+  /// \param[in] scale Define the multiplier of q * k.
+  void set_scale(const float scale);
+
+  /// \brief Method to set transpose_k attribute.
+  ///
+  /// \param[in] transpose_k Define whether k is [k_seq, head_size] and multiplied transposed.
+  void set_transpose_k(const bool transpose_k);
+
+  /// \brief Method to get scale attribute.
+  ///
+  /// \return the multiplier of q * k.
+  float get_scale() const;
+
+  /// \brief Method to get transpose_k attribute.
+  ///
+  /// \return whether k is multiplied transposed.
+  bool get_transpose_k() const;
+};
+}  // namespace ops
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_OPS_SCALED_DOT_PRODUCT_ATTENTION_H_
@@ -460,6 +460,9 @@ class RunnerConfig:
             key currently supports ["weight"];
             value is in dict format, key of it currently supports ["weight_path"],
             value of it is the path of weight, For example, "/home/user/weight.cfg".
+            Requests with the same per-sample shape can be batched along dim 0 by the workers with
+            {"dynamic_batch": {"enable": "true", "max_batch_size": "8", "batch_timeout_us": "0"}}, where
+            `batch_timeout_us` is how long a worker waits for more requests before running a partial batch.
         config_path (str, optional): Define the config file path. the config file is used to transfer user defined
             options during building `ModelParallelRunner` . In the following scenarios, users may need to set the
             parameter. For example, "/home/user/config.txt". Default: "".
@@ -544,6 +547,22 @@ class RunnerConfig:
                 raise ValueError(f"RunnerConfig's init failed, config_path does not exist!")
             self._runner_config.set_config_path(config_path)
 
+    def get_batching_stats(self):
+        """
+        Get the dynamic batching statistics of the `ModelParallelRunner` initialized with this config.
+
+        Returns:
+            dict{str, str}, including batched_requests, batched_runs, average_batch_size, partial_runs and
+            fallback_requests. Empty if dynamic batching is not enabled.
+
+        Examples:
+            >>> import mindspore_lite as mslite
+            >>> runner_config = mslite.RunnerConfig(config_info={"dynamic_batch": {"enable": "true"}})
+            >>> print(runner_config.get_batching_stats())
+            {}
+        """
+        return self._runner_config.get_batching_stats()
+
     def __str__(self):
         res = f"workers num: {self._runner_config.get_workers_num()},\n" \
               f"config info: {self._runner_config.get_config_info_string()},\n" \
@@ -89,6 +89,7 @@ void ModelParallelRunnerPyBind(const py::module &m) {
     .def("get_config_info", &RunnerConfig::GetConfigInfo)
     .def("set_config_path", py::overload_cast<const std::string &>(&RunnerConfig::SetConfigPath))
     .def("get_config_path", &RunnerConfig::GetConfigPath)
+    .def("get_batching_stats", &RunnerConfig::GetBatchingStats)
     .def("set_workers_num", &RunnerConfig::SetWorkersNum)
     .def("get_workers_num", &RunnerConfig::GetWorkersNum)
     .def("set_context", &RunnerConfig::SetContext)
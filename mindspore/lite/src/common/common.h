@@ -61,12 +61,31 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 // weight path
 static const char *const kWeight = "weight";
 static const char *const kWeightPath = "weight_path";
+// model load
+static const char *const kModelLoad = "model_load";
+static const char *const kModelLoadMmap = "mmap";
 
 // model parallel runner id
 static const char *const kInnerIDs = "inner_ids";
 static const char *const kInnerRunnerID = "inner_runner_id";
 static const char *const kInnerNumaID = "inner_numa_id";
 
+// model parallel runner dynamic batch
+static const char *const kDynamicBatch = "dynamic_batch";
+static const char *const kDynamicBatchEnable = "enable";
+static const char *const kDynamicBatchMaxBatchSize = "max_batch_size";
+static const char *const kDynamicBatchTimeout = "batch_timeout_us";
+
+// persistent cache of packed weights
+static const char *const kPackWeightCache = "pack_weight_cache";
+static const char *const kPackWeightCacheDir = "cache_dir";
+
+// online thread num tuning of cpu kernels
+static const char *const kThreadNumTune = "thread_num_tune";
+static const char *const kThreadNumTuneEnable = "enable";
+static const char *const kThreadNumTuneProfilePath = "profile_path";
+static const char *const kThreadNumTuneLoops = "tune_loops";
+
 static const char *const kIsOptimized = "isOptimized";
 // gpu context
 static const char *const kGPUContext = "gpu_context";
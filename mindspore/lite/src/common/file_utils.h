@@ -51,6 +51,11 @@ char *ReadFileSegment(const std::string &file, int64_t offset, int64_t len);
 
 char *ReadFile(const char *file, size_t *size);
 
+// map the whole file copy-on-write instead of reading it to heap, release with UnmapFile
+char *MapFile(const char *file, size_t *size);
+
+void UnmapFile(char *buf, size_t size);
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *file_path);
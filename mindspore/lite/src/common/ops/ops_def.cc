@@ -231,6 +231,7 @@ OP_TYPE(GatherD)
 OP_TYPE(GroupNormFusion)
 OP_TYPE(Log1p)
 OP_TYPE(TensorScatterAdd)
+OP_TYPE(ScaledDotProductAttention)
 OP_TYPE_DEF_END(PrimitiveType)
 
 OP_SCHEMA_DEF(Abs)
@@ -1301,3 +1302,8 @@ OP_SCHEMA_DEF_END(Log1p)
 
 OP_SCHEMA_DEF(TensorScatterAdd)
 OP_SCHEMA_DEF_END(TensorScatterAdd)
+
+OP_SCHEMA_DEF(ScaledDotProductAttention)
+OP_ATTR_WITH_VALUE(scale, float, 1.0)
+OP_ATTR_WITH_VALUE(transpose_k, bool, true)
+OP_SCHEMA_DEF_END(ScaledDotProductAttention)
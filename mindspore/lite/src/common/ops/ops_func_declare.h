@@ -260,6 +260,7 @@
 #include "ops/format_transpose.h"
 #include "ops/gather_d.h"
 #include "ops/tensor_scatter_add.h"
+#include "ops/scaled_dot_product_attention.h"
 
 namespace mindspore::lite::ops {
 #define FUNC_MSOP2SCHEMAOP_DECLARE(OP) std::unique_ptr<schema::PrimitiveT> MSOp2SchemaOp(const mindspore::ops::OP *op);
@@ -488,6 +489,7 @@ FUNC_MSOP2SCHEMAOP_DECLARE(GatherD)
 FUNC_MSOP2SCHEMAOP_DECLARE(GroupNormFusion)
 FUNC_MSOP2SCHEMAOP_DECLARE(Log1p)
 FUNC_MSOP2SCHEMAOP_DECLARE(TensorScatterAdd)
+FUNC_MSOP2SCHEMAOP_DECLARE(ScaledDotProductAttention)
 #endif
 }  // namespace mindspore::lite::ops
 #else
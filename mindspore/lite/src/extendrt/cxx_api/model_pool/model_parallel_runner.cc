@@ -114,6 +114,26 @@ std::map<std::vector<char>, std::map<std::vector<char>, std::vector<char>>> Runn
   return MapMapStringToChar(data_->config_info);
 }
 
+std::map<std::vector<char>, std::vector<char>> RunnerConfig::GetBatchingStatsChar() const {
+  if (data_ == nullptr) {
+    MS_LOG(ERROR) << "Runner config data is nullptr.";
+    std::map<std::vector<char>, std::vector<char>> empty;
+    return empty;
+  }
+  std::map<std::string, std::string> stats;
+  auto info = data_->dynamic_batch_info;
+  if (info != nullptr) {
+    int64_t requests = info->batched_requests;
+    int64_t runs = info->batched_runs;
+    stats["batched_requests"] = std::to_string(requests);
+    stats["batched_runs"] = std::to_string(runs);
+    stats["average_batch_size"] = std::to_string(runs == 0 ? 0.0 : static_cast<double>(requests) / runs);
+    stats["partial_runs"] = std::to_string(info->partial_runs.load());
+    stats["fallback_requests"] = std::to_string(info->fallback_requests.load());
+  }
+  return MapStringToVectorChar(stats);
+}
+
 ModelParallelRunner::ModelParallelRunner() {}
 
 ModelParallelRunner::~ModelParallelRunner() {}
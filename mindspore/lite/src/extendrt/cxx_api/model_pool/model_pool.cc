@@ -26,6 +26,8 @@
 #include "src/litert/pack_weight_manager.h"
 #include "src/extendrt/numa_adapter.h"
 #include "src/common/common.h"
+#include "src/common/utils.h"
+#include "src/extendrt/cxx_api/model_pool/runner_config.h"
 namespace mindspore {
 namespace {
 constexpr int kNumDeviceInfo = 2;
@@ -38,6 +40,7 @@ constexpr int kDefaultThreadsNum = 8;
 constexpr int kInvalidNumaId = -1;
 constexpr int kNumDefaultInterOpParallel = 4;
 constexpr int kNumCoreNumTimes = 5;
+constexpr int kDefaultMaxBatchSize = 8;
 }  // namespace
 
 int ModelPool::GetDefaultThreadNum(int worker_num) {
@@ -833,6 +836,11 @@ Status ModelPool::Init(const char *model_buf, size_t size, const std::shared_ptr
     MS_LOG(ERROR) << "predict task queue init failed, status=" << status;
     return kLiteError;
   }
+  status = InitDynamicBatch(runner_config);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "init dynamic batch failed.";
+    return kLiteError;
+  }
   status = CreateWorkers(model_buf, size, model_pool_config, numa_available_ && (used_numa_node_num_ > 1));
   if (status != kSuccess) {
     MS_LOG(ERROR) << "create worker failed.";
@@ -850,6 +858,49 @@ Status ModelPool::Init(const char *model_buf, size_t size, const std::shared_ptr
   return kSuccess;
 }
 
+Status ModelPool::InitDynamicBatch(const std::shared_ptr<RunnerConfig> &runner_config) {
+  if (runner_config == nullptr) {
+    return kSuccess;
+  }
+  auto config_info = runner_config->GetConfigInfo();
+  auto section = config_info.find(lite::kDynamicBatch);
+  if (section == config_info.end()) {
+    return kSuccess;
+  }
+  auto &configs = section->second;
+  auto enable = configs.find(lite::kDynamicBatchEnable);
+  if (enable == configs.end() || enable->second != "true") {
+    return kSuccess;
+  }
+  auto info = std::make_shared<DynamicBatchInfo>();
+  if (info == nullptr) {
+    MS_LOG(ERROR) << "create dynamic batch info failed.";
+    return kLiteNullptr;
+  }
+  info->enable = true;
+  info->max_batch_size = kDefaultMaxBatchSize;
+  auto max_batch_size = configs.find(lite::kDynamicBatchMaxBatchSize);
+  if (max_batch_size != configs.end() &&
+      (!lite::ConvertStrToInt(max_batch_size->second, &info->max_batch_size) || info->max_batch_size <= 1)) {
+    MS_LOG(ERROR) << lite::kDynamicBatchMaxBatchSize << " should be an integer greater than 1, but got "
+                  << max_batch_size->second;
+    return kLiteParamInvalid;
+  }
+  auto timeout = configs.find(lite::kDynamicBatchTimeout);
+  if (timeout != configs.end() &&
+      (!lite::ConvertStrToInt(timeout->second, &info->timeout_us) || info->timeout_us < 0)) {
+    MS_LOG(ERROR) << lite::kDynamicBatchTimeout << " should be a non-negative integer, but got " << timeout->second;
+    return kLiteParamInvalid;
+  }
+  MS_LOG(INFO) << "enable dynamic batch, max batch size: " << info->max_batch_size
+               << " | batch timeout(us): " << info->timeout_us;
+  predict_task_queue_->SetDynamicBatchInfo(info);
+  if (runner_config->data_ != nullptr) {
+    runner_config->data_->dynamic_batch_info = info;
+  }
+  return kSuccess;
+}
+
 Status ModelPool::UpdateConfig(const std::string &section, const std::pair<std::string, std::string> &config) {
   for (auto &item : all_model_workers_) {
     auto &workers = item.second;
@@ -903,6 +954,7 @@ PredictTask *ModelPool::CreatePredictTask(const std::vector<MSTensor> &inputs, s
     task->outputs = outputs;
     task->before = before;
     task->after = after;
+    task->status = kSuccess;
     return task;
   } else {
     return nullptr;
@@ -977,7 +1029,12 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
     }
     predict_task_queue_->PushPredictTask(task, max_wait_worker_node_id);
     predict_task_queue_->WaitUntilPredictActive(task, max_wait_worker_node_id);
+    auto status = task->status;
     UpdateFreeTaskId(task_id);
+    if (status != kSuccess) {
+      MS_LOG(ERROR) << "queued predict failed, ret=" << status;
+      return status;
+    }
   }
   return kSuccess;
 }
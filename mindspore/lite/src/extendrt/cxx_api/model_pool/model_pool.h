@@ -113,6 +113,8 @@ class ModelPool {
 
   Status CheckThreadNum(const std::shared_ptr<RunnerConfig> &runner_config);
 
+  Status InitDynamicBatch(const std::shared_ptr<RunnerConfig> &runner_config);
+
   Status WarmUpForAllWorker(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
 
  private:
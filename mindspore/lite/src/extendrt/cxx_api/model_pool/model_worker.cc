@@ -15,6 +15,8 @@
  */
 #include "src/extendrt/cxx_api/model_pool/model_worker.h"
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include "src/common/log_adapter.h"
 #include "src/extendrt/numa_adapter.h"
 #include "src/common/common.h"
@@ -67,6 +69,8 @@ void ModelWorker::InitModelWorker(const char *model_buf, size_t size,
 void ModelWorker::Run() {
   auto numa_node_id = worker_config_->numa_id;
   int task_queue_id = numa_node_id != -1 ? numa_node_id : 0;
+  dynamic_batch_info_ = predict_task_queue_->GetDynamicBatchInfo();
+  dynamic_batch_ = dynamic_batch_info_ != nullptr && dynamic_batch_info_->enable;
   {
     // The scope of the lock is only for this variable
     std::unique_lock<std::mutex> create_work_lock(create_work_done_mutex_);
@@ -75,29 +79,240 @@ void ModelWorker::Run() {
   create_work_done_condition_.notify_one();
   MS_LOG(INFO) << "model worker is initialized.";
   while (!predict_task_queue_->IsPredictTaskDone()) {
-    auto task = predict_task_queue_->GetPredictTask(task_queue_id, this);
+    auto task = pending_task_;
+    pending_task_ = nullptr;
+    if (task == nullptr) {
+      task = predict_task_queue_->GetPredictTask(task_queue_id, this);
+    }
     if (task == nullptr) {
       MS_LOG(DEBUG) << "task queue is empty, wait task ...";
       available_ = true;
       continue;
     }
     available_ = false;
-    auto inputs = task->inputs;
-    auto *outputs = task->outputs;
-    auto before = task->before;
-    auto after = task->after;
-    auto status = Predict(*inputs, outputs, before, after);
-    if (status != kSuccess) {
-      PrintWorkerInfo();
-      MS_LOG(ERROR) << "model predict failed.";
-      task->ready = true;
-      predict_task_queue_->ActiveTask(task);
-      continue;
+    if (dynamic_batch_) {
+      RunBatchTasks(task, task_queue_id);
+    } else {
+      RunTask(task);
+    }
+  }
+  if (pending_task_ != nullptr) {
+    // the pool shuts down before the task runs
+    pending_task_->status = kLiteError;
+    pending_task_->ready = true;
+    predict_task_queue_->ActiveTask(pending_task_);
+    pending_task_ = nullptr;
+  }
+  MS_LOG(INFO) << "task queue all tasks completed.";
+}
+
+void ModelWorker::RunTask(PredictTask *task) {
+  auto status = Predict(*task->inputs, task->outputs, task->before, task->after);
+  if (status != kSuccess) {
+    PrintWorkerInfo();
+    MS_LOG(ERROR) << "model predict failed.";
+  }
+  task->status = status;
+  task->ready = true;
+  predict_task_queue_->ActiveTask(task);
+}
+
+int64_t ModelWorker::GetTaskBatch(const PredictTask *task) {
+  // callbacks are bound to a single request, and device data can not be concatenated on host
+  if (task->before != nullptr || task->after != nullptr) {
+    return -1;
+  }
+  auto &inputs = *task->inputs;
+  if (inputs.empty() || inputs.size() != origin_worker_inputs_.size()) {
+    return -1;
+  }
+  int64_t batch = -1;
+  for (auto &input : inputs) {
+    auto shape = input.Shape();
+    if (shape.empty() || shape[0] <= 0 || (batch != -1 && shape[0] != batch)) {
+      return -1;
+    }
+    if (input.DataType() == DataType::kObjectTypeString || input.Data() == nullptr ||
+        const_cast<MSTensor &>(input).GetDeviceData() != nullptr || input.DataSize() % shape[0] != 0) {
+      return -1;
+    }
+    batch = shape[0];
+  }
+  // user outputs are filled either all or none
+  auto &outputs = *task->outputs;
+  size_t user_output_num = 0;
+  for (auto &output : outputs) {
+    if (const_cast<MSTensor &>(output).GetDeviceData() != nullptr) {
+      return -1;
+    }
+    if (output.Data() != nullptr) {
+      user_output_num++;
+    }
+  }
+  if (user_output_num != 0 && (user_output_num != outputs.size() || outputs.size() != origin_worker_outputs_.size())) {
+    return -1;
+  }
+  return batch;
+}
+
+bool ModelWorker::IsSameSample(const PredictTask *task, const PredictTask *other) {
+  auto &inputs = *task->inputs;
+  auto &other_inputs = *other->inputs;
+  if (inputs.size() != other_inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto shape = inputs[i].Shape();
+    auto other_shape = other_inputs[i].Shape();
+    if (inputs[i].DataType() != other_inputs[i].DataType() || shape.empty() || shape.size() != other_shape.size() ||
+        !std::equal(shape.begin() + 1, shape.end(), other_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ModelWorker::RunBatchTasks(PredictTask *first_task, int task_queue_id) {
+  std::vector<PredictTask *> tasks = {first_task};
+  int64_t batch = GetTaskBatch(first_task);
+  int64_t max_batch_size = dynamic_batch_info_->max_batch_size;
+  if (batch <= 0 || batch >= max_batch_size) {
+    RunTask(first_task);
+    return;
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(dynamic_batch_info_->timeout_us);
+  while (batch < max_batch_size && !predict_task_queue_->IsPredictTaskDone()) {
+    auto remain_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+    auto task = predict_task_queue_->GetPredictTaskWithTimeout(task_queue_id, remain_us);
+    if (task == nullptr) {
+      break;
+    }
+    auto task_batch = IsSameSample(first_task, task) ? GetTaskBatch(task) : -1;
+    if (task_batch <= 0 || batch + task_batch > max_batch_size) {
+      // keep it for the next round instead of putting it back behind newer requests
+      pending_task_ = task;
+      break;
     }
+    tasks.push_back(task);
+    batch += task_batch;
+  }
+  if (tasks.size() == 1) {
+    RunTask(first_task);
+    return;
+  }
+  auto status = PredictBatchTasks(tasks, batch);
+  if (status == kLiteNotSupport) {
+    // the output shapes do not follow the batch size, every later batch would fail the split the same way
+    MS_LOG(WARNING) << "outputs of the model are not batched along dim 0, dynamic batch of worker "
+                    << worker_config_->worker_id << " is disabled.";
+    dynamic_batch_ = false;
+  }
+  if (status != kSuccess) {
+    MS_LOG(WARNING) << "batched predict of " << tasks.size() << " requests failed, run them one by one.";
+    dynamic_batch_info_->fallback_requests += static_cast<int64_t>(tasks.size());
+    for (auto task : tasks) {
+      RunTask(task);
+    }
+    return;
+  }
+  dynamic_batch_info_->batched_requests += static_cast<int64_t>(tasks.size());
+  dynamic_batch_info_->batched_runs += 1;
+  if (batch < max_batch_size) {
+    dynamic_batch_info_->partial_runs += 1;
+  }
+  for (auto task : tasks) {
+    task->status = kSuccess;
     task->ready = true;
     predict_task_queue_->ActiveTask(task);
   }
-  MS_LOG(INFO) << "task queue all tasks completed.";
+}
+
+Status ModelWorker::PredictBatchTasks(const std::vector<PredictTask *> &tasks, int64_t batch) {
+  auto &first_inputs = *tasks.front()->inputs;
+  std::vector<MSTensor> batch_inputs;
+  batch_input_buffers_.resize(first_inputs.size());
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    auto &buffer = batch_input_buffers_[i];
+    auto shape = first_inputs[i].Shape();
+    auto sample_size = first_inputs[i].DataSize() / static_cast<size_t>(shape[0]);
+    buffer.resize(sample_size * static_cast<size_t>(batch));
+    size_t offset = 0;
+    for (auto task : tasks) {
+      auto &input = task->inputs->at(i);
+      if (offset + input.DataSize() > buffer.size()) {
+        MS_LOG(ERROR) << "input " << input.Name() << " data size is not consistent with its shape.";
+        return kLiteError;
+      }
+      (void)memcpy(buffer.data() + offset, input.Data().get(), input.DataSize());
+      offset += input.DataSize();
+    }
+    shape[0] = batch;
+    auto tensor = MSTensor::CreateRefTensor(first_inputs[i].Name(), first_inputs[i].DataType(), shape, buffer.data(),
+                                            buffer.size(), false);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "create batched input tensor failed.";
+      return kLiteNullptr;
+    }
+    batch_inputs.push_back(*tensor);
+    delete tensor;
+  }
+  std::vector<MSTensor> batch_outputs;
+  auto status = Predict(batch_inputs, &batch_outputs);
+  if (status != kSuccess) {
+    return status;
+  }
+  // every output has to be batched along dim 0 to be split back to the requests
+  for (auto &output : batch_outputs) {
+    auto shape = output.Shape();
+    if (shape.empty() || shape[0] != batch || output.DataSize() % static_cast<size_t>(batch) != 0) {
+      MS_LOG(INFO) << "output " << output.Name() << " shape " << shape << " is not batched by " << batch;
+      return kLiteNotSupport;
+    }
+  }
+  for (auto task : tasks) {
+    auto rows = static_cast<size_t>(task->inputs->front().Shape()[0]);
+    if (task->outputs->empty() || task->outputs->front().Data() == nullptr) {
+      continue;
+    }
+    for (size_t i = 0; i < batch_outputs.size(); i++) {
+      if (task->outputs->at(i).DataSize() != batch_outputs[i].DataSize() / static_cast<size_t>(batch) * rows) {
+        MS_LOG(INFO) << "user output " << task->outputs->at(i).Name() << " size does not match the batched output.";
+        return kLiteError;
+      }
+    }
+  }
+  size_t row_offset = 0;
+  for (auto task : tasks) {
+    auto rows = static_cast<size_t>(task->inputs->front().Shape()[0]);
+    bool user_outputs = !task->outputs->empty() && task->outputs->front().Data() != nullptr;
+    std::vector<MSTensor> new_outputs;
+    for (size_t i = 0; i < batch_outputs.size(); i++) {
+      auto &output = batch_outputs[i];
+      auto sample_size = output.DataSize() / static_cast<size_t>(batch);
+      auto src = static_cast<char *>(output.MutableData()) + row_offset * sample_size;
+      auto shape = output.Shape();
+      shape[0] = static_cast<int64_t>(rows);
+      if (user_outputs) {
+        auto &user_output = task->outputs->at(i);
+        (void)memcpy(user_output.MutableData(), src, rows * sample_size);
+        user_output.SetShape(shape);
+        continue;
+      }
+      auto tensor = MSTensor::CreateTensor(output.Name(), output.DataType(), shape, src, rows * sample_size);
+      if (tensor == nullptr) {
+        MS_LOG(ERROR) << "create split output tensor failed.";
+        return kLiteNullptr;
+      }
+      new_outputs.push_back(*tensor);
+      delete tensor;
+    }
+    if (!user_outputs) {
+      *task->outputs = new_outputs;
+    }
+    row_offset += rows;
+  }
+  return kSuccess;
 }
 
 Status ModelWorker::Init(const char *model_buf, size_t size) {
@@ -28,6 +28,8 @@
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
 namespace mindspore {
 class PredictTaskQueue;
+struct PredictTask;
+struct DynamicBatchInfo;
 
 struct WorkerConfig {
   std::map<std::string, std::map<std::string, std::string>> config_info;
@@ -64,6 +66,17 @@ class ModelWorker {
  private:
   void Run();
 
+  void RunTask(PredictTask *task);
+
+  void RunBatchTasks(PredictTask *first_task, int task_queue_id);
+
+  int64_t GetTaskBatch(const PredictTask *task);
+
+  bool IsSameSample(const PredictTask *task, const PredictTask *other);
+
+  // returns kLiteNotSupport if the outputs of the model are not batched along dim 0
+  Status PredictBatchTasks(const std::vector<PredictTask *> &tasks, int64_t batch);
+
   std::pair<std::vector<std::vector<int64_t>>, bool> GetModelResize(const std::vector<MSTensor> &model_inputs,
                                                                     const std::vector<MSTensor> &inputs);
 
@@ -84,6 +97,11 @@ class ModelWorker {
   // run
   std::mutex mtx_worker_;
   std::atomic_bool available_ = true;
+  // dynamic batch
+  std::shared_ptr<DynamicBatchInfo> dynamic_batch_info_ = nullptr;
+  bool dynamic_batch_ = false;  // turned off once the batched outputs can not be split
+  PredictTask *pending_task_ = nullptr;  // dequeued but not fitting into the previous batch
+  std::vector<std::vector<char>> batch_input_buffers_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_MODEL_WORKER_H_
@@ -15,6 +15,7 @@
  */
 
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
+#include <chrono>
 #include "src/common/log_adapter.h"
 namespace mindspore {
 PredictTaskQueue::~PredictTaskQueue() {
@@ -133,4 +134,29 @@ PredictTask *PredictTaskQueue::GetPredictTask(int node_id, ModelWorker *worker)
   return predict_task;
 #endif
 }
+
+PredictTask *PredictTaskQueue::GetPredictTaskWithTimeout(int node_id, int64_t timeout_us) {
+#ifdef USE_HQUEUE
+  auto predict_task = predict_task_[node_id].Dequeue();
+  if (predict_task != nullptr || timeout_us <= 0) {
+    return predict_task;
+  }
+  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
+  (void)task_push_cond_.wait_for(task_lock, std::chrono::microseconds(timeout_us),
+                                 [&] { return !predict_task_[node_id].Empty() || predict_task_done_; });
+  return predict_task_[node_id].Dequeue();
+#else
+  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
+  if (timeout_us > 0) {
+    (void)task_push_cond_.wait_for(task_lock, std::chrono::microseconds(timeout_us),
+                                   [&] { return !predict_task_[node_id].empty() || predict_task_done_; });
+  }
+  if (predict_task_done_ || predict_task_[node_id].empty()) {
+    return nullptr;
+  }
+  auto predict_task = predict_task_[node_id].front();
+  predict_task_[node_id].pop();
+  return predict_task;
+#endif
+}
 }  // namespace mindspore
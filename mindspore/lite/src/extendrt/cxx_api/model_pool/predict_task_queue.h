@@ -20,6 +20,7 @@
 #include <mutex>
 #include <memory>
 #include <vector>
+#include <atomic>
 #include <condition_variable>
 #include "include/api/types.h"
 #include "include/api/status.h"
@@ -39,10 +40,23 @@ struct PredictTask {
   MSKernelCallBack before;
   MSKernelCallBack after;
   std::atomic_bool ready;
+  Status status = kSuccess;  // set by the worker before the task is ready
   std::condition_variable task_done_condition;
   std::mutex task_done_mutex;
 };
 
+// queued requests with the same per-sample shape are coalesced along dim 0 and run as one inference
+struct DynamicBatchInfo {
+  bool enable = false;
+  int max_batch_size = 0;  // upper bound of the summed dim 0 of one batched inference
+  int timeout_us = 0;      // how long a worker waits for more requests before running a partial batch
+  // statistics
+  std::atomic_int64_t batched_requests = 0;   // requests served by batched inferences
+  std::atomic_int64_t batched_runs = 0;       // batched inferences
+  std::atomic_int64_t partial_runs = 0;       // batched inferences run before reaching max batch size
+  std::atomic_int64_t fallback_requests = 0;  // requests rerun alone because the batched outputs can not be split
+};
+
 class PredictTaskQueue {
  public:
   PredictTaskQueue() = default;
@@ -51,6 +65,7 @@ class PredictTaskQueue {
   void PushPredictTask(PredictTask *task, int node_id);
   void WaitUntilPredictActive(PredictTask *task, int node_id);
   PredictTask *GetPredictTask(int node_id, ModelWorker *worker);
+  PredictTask *GetPredictTaskWithTimeout(int node_id, int64_t timeout_us);
   void ActiveTask(PredictTask *task);
   void ActiveTaskQueue();
   Status InitTaskQueue(size_t num, size_t max_queue_size);
@@ -60,6 +75,8 @@ class PredictTaskQueue {
   int GetWaitModelNum(int node_id) const { return idle_worker_num_[node_id]; }
   void DecreaseWaitModelNum(int num, int node_id) { idle_worker_num_[node_id] -= num; }
   void IncreaseWaitModelNum(int num, int node_id) { idle_worker_num_[node_id] += num; }
+  void SetDynamicBatchInfo(const std::shared_ptr<DynamicBatchInfo> &info) { dynamic_batch_info_ = info; }
+  std::shared_ptr<DynamicBatchInfo> GetDynamicBatchInfo() const { return dynamic_batch_info_; }
 
  private:
   // use an array to save predict tasks, different numa nodes correspond to different arrays
@@ -74,6 +91,7 @@ class PredictTaskQueue {
   std::condition_variable task_pop_cond_;
   std::condition_variable task_push_cond_;
   bool predict_task_done_ = false;
+  std::shared_ptr<DynamicBatchInfo> dynamic_batch_info_ = nullptr;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
@@ -19,12 +19,14 @@
 #include <string>
 #include <map>
 #include "include/api/model_parallel_runner.h"
+#include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
 namespace mindspore {
 struct RunnerConfig::Data {
   int workers_num = 0;
   std::shared_ptr<Context> context = nullptr;
   std::map<std::string, std::map<std::string, std::string>> config_info;
   std::string config_path = "";
+  std::shared_ptr<DynamicBatchInfo> dynamic_batch_info = nullptr;  // set by the model pool built with this config
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_RUNNER_CONFIG_H_
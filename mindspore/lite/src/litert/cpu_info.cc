@@ -203,5 +203,22 @@ bool CpuInfo::ArmIsSupportFp16() {
   return fp16_flag_;
 #endif
 }
+
+bool CpuInfo::ArmIsSupportBf16() {
+  // bfdot and bfmmla come with armv8.6, the kernel reports them in hwcap2
+#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(MS_COMPILE_IOS) && \
+  (defined(__ANDROID__) || defined(MACHINE_LINUX_ARM64))
+#ifndef HWCAP2_BF16
+#define HWCAP2_BF16 (1 << 14)
+#endif
+  const uint32_t hwcap2 = getauxval(AT_HWCAP2);
+  if (hwcap2 & HWCAP2_BF16) {
+    MS_LOG(DEBUG) << "Hw cap2 support BF16, hwcap2: 0x" << hwcap2;
+    return true;
+  }
+  MS_LOG(DEBUG) << "Hw cap2 NOT support BF16, hwcap2: 0x" << hwcap2;
+#endif
+  return false;
+}
 }  // namespace mindspore::lite
 #endif
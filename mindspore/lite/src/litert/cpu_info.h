@@ -63,6 +63,7 @@ class CpuInfo {
   CpuInfo() = default;
   virtual ~CpuInfo() = default;
   bool ArmIsSupportFp16();
+  bool ArmIsSupportBf16();
 
  private:
 #ifndef MS_COMPILE_IOS
@@ -133,6 +133,10 @@ std::shared_ptr<lite::InnerContext> ContextUtils::Convert(Context *context) {
       }
       ret = AddCpuDevice(cpu_context->GetAllocator(), context->GetThreadAffinityMode(), cpu_context->GetEnableFP16(),
                          cpu_context->GetProvider(), cpu_context->GetProviderDevice(), inner_context.get());
+      if (ret == kSuccess) {
+        inner_context->device_list_.back().device_info_.cpu_device_info_.enable_bfloat16_ =
+          cpu_context->GetEnableBF16();
+      }
     } else if (device->GetDeviceType() == kGPU) {
       auto gpu_context = device->Cast<GPUDeviceInfo>();
       bool enable_gl_texture = gpu_context->GetEnableGLTexture();
@@ -29,6 +29,10 @@
 #ifdef GPU_OPENCL
 #include "src/litert/kernel/gpu/opencl/opencl_runtime.h"
 #endif
+#ifdef ENABLE_AVX512
+#include "nnacl/errorcode.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
 #include "nnacl/kernel.h"
 #include "src/litert/inner_allocator.h"
 #include "experimental/src/exec_env_utils.h"
@@ -44,6 +48,12 @@ InnerContext::InnerContext() {
   CpuInfo cpu_info;
   device_and_pkg_support_fp16_ = cpu_info.ArmIsSupportFp16();
 #endif
+#if defined(ENABLE_ARM64)
+  CpuInfo bf16_cpu_info;
+  device_and_pkg_support_bf16_ = bf16_cpu_info.ArmIsSupportBf16();
+#elif defined(ENABLE_AVX512)
+  device_and_pkg_support_bf16_ = IntelX86CpuInfoInit() == NNACL_OK && X86_Avx512Bf16_Support();
+#endif
 }
 
 void InnerContext::InitExperimentalExecEnv() {
@@ -190,6 +200,16 @@ bool InnerContext::IsCpuFloat16Enabled() const {
   return GetDeviceInfo(DT_CPU).cpu_device_info_.enable_float16_;
 }
 
+bool InnerContext::IsCpuBFloat16Enabled() const {
+  if (!IsDeviceTypeEnabled(DT_CPU)) {
+    return false;
+  }
+  if (!device_and_pkg_support_bf16_) {
+    return false;
+  }
+  return GetDeviceInfo(DT_CPU).cpu_device_info_.enable_bfloat16_;
+}
+
 bool InnerContext::IsGpuFloat16Enabled() const {
 #ifdef GPU_OPENCL
   if (!IsDeviceTypeEnabled(DT_GPU)) {
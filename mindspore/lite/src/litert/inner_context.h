@@ -40,6 +40,7 @@ constexpr int kDefaultParallelNum = 2;
 typedef struct CpuDeviceInfo {
   bool enable_float16_ = false; /**< prior enable float16 inference */
   CpuBindMode cpu_bind_mode_ = MID_CPU;
+  bool enable_bfloat16_ = false; /**< prior enable bfloat16 compute for the supported fp32 kernels */
 } CpuDeviceInfo;
 
 typedef struct GpuDeviceInfo {
@@ -84,6 +85,7 @@ struct InnerContext {
   virtual ~InnerContext();
   int Init();
   bool IsCpuFloat16Enabled() const;
+  bool IsCpuBFloat16Enabled() const;
   bool IsGpuFloat16Enabled() const;
   bool IsNpuFloat16Enabled() const;
   bool IsGLTextureEnabled() const;
@@ -111,6 +113,7 @@ struct InnerContext {
   bool float_mode = false; /**< convert full quant model to float model */
 
   bool device_and_pkg_support_fp16_ = false;
+  bool device_and_pkg_support_bf16_ = false;
   ThreadPool *thread_pool_ = nullptr;
   // key is the precursor tensor's pointer, value is the group of successors' pointer.
   std::unordered_map<void *, std::set<void *>> link_info_{};
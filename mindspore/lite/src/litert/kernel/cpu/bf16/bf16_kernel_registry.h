@@ -0,0 +1,79 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_BF16_KERNEL_REGISTRY_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_BF16_KERNEL_REGISTRY_H_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "src/litert/kernel_registry.h"
+
+namespace mindspore::kernel {
+using Bf16KernelSupport = bool (*)(const std::vector<lite::Tensor *> &inputs,
+                                   const std::vector<lite::Tensor *> &outputs, const OpParameter *parameter);
+
+// bf16 compute kernels for fp32 graphs. The tensors stay fp32, a kernel takes bf16 operands and accumulates in fp32.
+// The registry answers the fp32 cpu kernel keys of the ops it holds, the scheduler checks Support before creating a
+// kernel and keeps the fp32 kernel for the cases a bf16 kernel does not handle.
+class Bf16KernelRegistry : public lite::KernelRegistry {
+ public:
+  static Bf16KernelRegistry *GetInstance() {
+    static Bf16KernelRegistry instance;
+    return &instance;
+  }
+  KernelCreator GetCreator(const KernelKey &desc) override {
+    auto iter = FindKernel(desc);
+    return iter == kernels_.end() ? nullptr : iter->second.first;
+  }
+  bool Support(const KernelKey &desc, const std::vector<lite::Tensor *> &inputs,
+               const std::vector<lite::Tensor *> &outputs, const OpParameter *parameter) const {
+    auto iter = FindKernel(desc);
+    return iter != kernels_.end() && parameter != nullptr && iter->second.second(inputs, outputs, parameter);
+  }
+  void RegBf16Kernel(int op_type, KernelCreator creator, Bf16KernelSupport support) {
+    kernels_[op_type] = std::make_pair(creator, support);
+  }
+
+ private:
+  Bf16KernelRegistry() = default;
+  ~Bf16KernelRegistry() override = default;
+
+  using Bf16KernelMap = std::unordered_map<int, std::pair<KernelCreator, Bf16KernelSupport>>;
+  Bf16KernelMap::const_iterator FindKernel(const KernelKey &desc) const {
+    if (desc.arch != KERNEL_ARCH::kCPU || desc.data_type != kNumberTypeFloat32 || desc.provider != kBuiltin) {
+      return kernels_.end();
+    }
+    return kernels_.find(desc.type);
+  }
+
+  Bf16KernelMap kernels_;
+};
+
+class Bf16KernelRegistrar {
+ public:
+  Bf16KernelRegistrar(int op_type, KernelCreator creator, Bf16KernelSupport support) {
+    Bf16KernelRegistry::GetInstance()->RegBf16Kernel(op_type, creator, support);
+  }
+  ~Bf16KernelRegistrar() = default;
+};
+
+#define REG_BF16_KERNEL(op_type, kernel_class)                                                    \
+  static Bf16KernelRegistrar g_bf16##op_type##kernelReg(op_type, LiteKernelCreator<kernel_class>, \
+                                                        kernel_class::Support);
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_BF16_KERNEL_REGISTRY_H_
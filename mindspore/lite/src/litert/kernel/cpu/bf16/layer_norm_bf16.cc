@@ -0,0 +1,93 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/bf16/layer_norm_bf16.h"
+#include "schema/model_generated.h"
+#include "src/litert/kernel/cpu/bf16/bf16_kernel_registry.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/layer_norm_bf16.h"
+#include "include/errorcode.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_LayerNormFusion;
+
+namespace mindspore::kernel {
+LayerNormBf16CPUKernel::~LayerNormBf16CPUKernel() {
+  if (gamma_bf16_ != nullptr) {
+    free(gamma_bf16_);
+    gamma_bf16_ = nullptr;
+  }
+  if (beta_bf16_ != nullptr) {
+    free(beta_bf16_);
+    beta_bf16_ = nullptr;
+  }
+}
+
+bool LayerNormBf16CPUKernel::Support(const std::vector<lite::Tensor *> &inputs,
+                                     const std::vector<lite::Tensor *> &outputs, const OpParameter *parameter) {
+  // the mean and variance outputs are only used by training
+  if (inputs.size() != C3NUM || outputs.size() != 1 || inputs[FIRST_INPUT]->data_type() != kNumberTypeFloat32) {
+    return false;
+  }
+  for (size_t i = SECOND_INPUT; i <= THIRD_INPUT; ++i) {
+    if (!inputs[i]->IsConst() || inputs[i]->data_type() != kNumberTypeFloat32 || inputs[i]->data() == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int LayerNormBf16CPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C3NUM);
+  auto gamma = in_tensors_.at(SECOND_INPUT);
+  auto beta = in_tensors_.at(THIRD_INPUT);
+  gamma_bf16_ = reinterpret_cast<uint16_t *>(malloc(gamma->ElementsNum() * sizeof(uint16_t)));
+  MS_CHECK_TRUE_MSG(gamma_bf16_ != nullptr, RET_MEMORY_FAILED, "malloc bf16 gamma failed.");
+  beta_bf16_ = reinterpret_cast<uint16_t *>(malloc(beta->ElementsNum() * sizeof(uint16_t)));
+  MS_CHECK_TRUE_MSG(beta_bf16_ != nullptr, RET_MEMORY_FAILED, "malloc bf16 beta failed.");
+  Float32ToBf16(reinterpret_cast<float *>(gamma->data()), gamma_bf16_, gamma->ElementsNum());
+  Float32ToBf16(reinterpret_cast<float *>(beta->data()), beta_bf16_, beta->ElementsNum());
+  return LayerNormCPUKernel::Prepare();
+}
+
+int LayerNormBf16CPUKernel::DoLayerNormBf16(int thread_id) const {
+  auto src_data = reinterpret_cast<const float *>(in_tensors_.at(FIRST_INPUT)->data());
+  auto dst_data = reinterpret_cast<float *>(out_tensors_.at(FIRST_INPUT)->data());
+  auto param = reinterpret_cast<const LayerNormParameter *>(op_parameter_);
+  auto ret = LayerNormBf16(src_data, gamma_bf16_, beta_bf16_, dst_data, param, thread_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "DoLayerNormBf16 error error_code[" << ret << "]";
+    return ret;
+  }
+  return RET_OK;
+}
+
+int LayerNormBf16Run(void *cdata, int task_id, float, float) {
+  auto kernel = reinterpret_cast<const LayerNormBf16CPUKernel *>(cdata);
+  CHECK_NULL_RETURN(kernel);
+  return kernel->DoLayerNormBf16(task_id);
+}
+
+int LayerNormBf16CPUKernel::Run() {
+  CHECK_NULL_RETURN(in_tensors_.at(FIRST_INPUT)->data());
+  CHECK_NULL_RETURN(out_tensors_.at(FIRST_INPUT)->data());
+  return ParallelLaunch(this->ms_context_, LayerNormBf16Run, this, thread_num_);
+}
+
+REG_BF16_KERNEL(PrimitiveType_LayerNormFusion, LayerNormBf16CPUKernel)
+}  // namespace mindspore::kernel
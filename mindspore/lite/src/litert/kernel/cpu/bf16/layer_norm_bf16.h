@@ -0,0 +1,44 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_LAYER_NORM_BF16_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_LAYER_NORM_BF16_H_
+
+#include <vector>
+#include "src/litert/kernel/cpu/fp32/layer_norm_fp32.h"
+
+namespace mindspore::kernel {
+// const gamma and beta are kept as bf16, the output is rounded to bf16 precision
+class LayerNormBf16CPUKernel : public LayerNormCPUKernel {
+ public:
+  LayerNormBf16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                         const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LayerNormCPUKernel(parameter, inputs, outputs, ctx) {}
+  ~LayerNormBf16CPUKernel() override;
+  static bool Support(const std::vector<lite::Tensor *> &inputs, const std::vector<lite::Tensor *> &outputs,
+                      const OpParameter *parameter);
+
+  int Prepare() override;
+  int Run() override;
+  int DoLayerNormBf16(int thread_id) const;
+
+ private:
+  uint16_t *gamma_bf16_ = nullptr;
+  uint16_t *beta_bf16_ = nullptr;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_LAYER_NORM_BF16_H_
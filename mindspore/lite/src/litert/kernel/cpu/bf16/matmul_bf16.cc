@@ -0,0 +1,236 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/bf16/matmul_bf16.h"
+#include <cstring>
+#include "schema/model_generated.h"
+#include "src/litert/kernel/cpu/bf16/bf16_kernel_registry.h"
+#include "include/errorcode.h"
+#if defined(ENABLE_AVX512)
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#elif defined(ENABLE_ARM64)
+#include "src/litert/cpu_info.h"
+#endif
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_FullConnection;
+using mindspore::schema::PrimitiveType_MatMulFusion;
+
+namespace mindspore::kernel {
+namespace {
+bool IsConstFp32(const lite::Tensor *tensor) {
+  return tensor != nullptr && tensor->IsConst() && tensor->data_type() == kNumberTypeFloat32 &&
+         tensor->data() != nullptr;
+}
+}  // namespace
+
+MatmulBf16CPUKernel::~MatmulBf16CPUKernel() {
+  if (pack_b_ != nullptr) {
+    free(pack_b_);
+    pack_b_ = nullptr;
+  }
+  if (bias_ != nullptr) {
+    free(bias_);
+    bias_ = nullptr;
+  }
+}
+
+bool MatmulBf16CPUKernel::Support(const std::vector<lite::Tensor *> &inputs, const std::vector<lite::Tensor *> &outputs,
+                                  const OpParameter *parameter) {
+  if (inputs.size() < C2NUM || inputs.size() > C3NUM || outputs.size() != 1) {
+    return false;
+  }
+  if (inputs[kInputIndex]->data_type() != kNumberTypeFloat32 || !IsConstFp32(inputs[kWeightIndex])) {
+    return false;
+  }
+  if (inputs.size() == C3NUM && !IsConstFp32(inputs[kBiasIndex])) {
+    return false;
+  }
+  // the packed weight is shared by every batch of the input
+  auto weight_shape = inputs[kWeightIndex]->shape();
+  if (weight_shape.size() < C2NUM) {
+    return false;
+  }
+  if (parameter->type_ == PrimitiveType_FullConnection) {
+    return weight_shape.size() == C2NUM;
+  }
+  int weight_batch = 1;
+  for (size_t i = 0; i < weight_shape.size() - C2NUM; ++i) {
+    weight_batch *= weight_shape[i];
+  }
+  return weight_batch == 1;
+}
+
+int MatmulBf16CPUKernel::InitWeightAndBias() {
+  auto weight = in_tensors_[kWeightIndex];
+  auto weight_shape = weight->shape();
+  MS_CHECK_TRUE_RET(weight_shape.size() >= C2NUM, RET_ERROR);
+  col_ = params_->b_transpose_ ? weight_shape[weight_shape.size() - C2NUM] : weight_shape.back();
+  deep_ = params_->b_transpose_ ? weight_shape.back() : weight_shape[weight_shape.size() - C2NUM];
+  MS_CHECK_TRUE_RET(col_ > 0 && deep_ > 0, RET_ERROR);
+  deep_align_ = UP_ROUND(deep_, C2NUM);
+  int col_align = UP_ROUND(col_, BF16_MATMUL_COL_TILE);
+  MS_CHECK_FALSE_MSG(INT_MUL_OVERFLOW(col_align, deep_align_), RET_ERROR, "mul overflow.");
+  pack_b_ = reinterpret_cast<uint16_t *>(malloc(col_align * deep_align_ * sizeof(uint16_t)));
+  MS_CHECK_TRUE_MSG(pack_b_ != nullptr, RET_MEMORY_FAILED, "malloc packed bf16 weight failed.");
+  PackMatmulWeightBf16(reinterpret_cast<float *>(weight->data()), pack_b_, deep_, col_, params_->b_transpose_);
+
+  if (in_tensors_.size() == C3NUM) {
+    auto bias = in_tensors_[kBiasIndex];
+    MS_CHECK_TRUE_MSG(bias->ElementsNum() == col_, RET_ERROR, "bias size does not match the weight.");
+    bias_ = reinterpret_cast<float *>(malloc(col_align * sizeof(float)));
+    MS_CHECK_TRUE_MSG(bias_ != nullptr, RET_MEMORY_FAILED, "malloc bias failed.");
+    memset(bias_, 0, col_align * sizeof(float));
+    memcpy(bias_, bias->data(), col_ * sizeof(float));
+  }
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C2NUM);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  CHECK_NULL_RETURN(params_);
+  auto ret = InitWeightAndBias();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "init bf16 weight failed: " << name_;
+    return ret;
+  }
+#if defined(ENABLE_AVX512)
+  if (X86_Avx512Bf16_Support()) {
+    matmul_func_ = MatmulBf16Avx512;
+  }
+#elif defined(ENABLE_ARM64)
+  lite::CpuInfo cpu_info;
+  if (cpu_info.ArmIsSupportBf16()) {
+    matmul_func_ = MatmulBf16Neon64;
+  }
+#endif
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int MatmulBf16CPUKernel::ReSize() {
+  auto input = in_tensors_[kInputIndex];
+  auto a_shape = input->shape();
+  if (op_parameter_->type_ == PrimitiveType_FullConnection || a_shape.size() < C2NUM) {
+    MS_CHECK_TRUE_MSG(input->ElementsNum() % deep_ == 0, RET_ERROR, "input size does not match the weight.");
+    batch_ = 1;
+    row_ = input->ElementsNum() / deep_;
+    a_transpose_ = false;
+  } else {
+    a_transpose_ = params_->a_transpose_;
+    int a_deep = a_transpose_ ? a_shape[a_shape.size() - C2NUM] : a_shape.back();
+    MS_CHECK_TRUE_MSG(a_deep == deep_, RET_ERROR, "input deep does not match the weight.");
+    row_ = a_transpose_ ? a_shape.back() : a_shape[a_shape.size() - C2NUM];
+    batch_ = 1;
+    for (size_t i = 0; i < a_shape.size() - C2NUM; ++i) {
+      batch_ *= a_shape[i];
+    }
+  }
+  MS_CHECK_FALSE_MSG(INT_MUL_OVERFLOW(batch_, row_), RET_ERROR, "mul overflow.");
+  total_row_ = batch_ * row_;
+  MS_CHECK_TRUE_MSG(out_tensors_[0]->ElementsNum() == total_row_ * col_, RET_ERROR, "invalid output shape.");
+
+  // every thread owns some col16 blocks of the whole output, rows are split when there are too few blocks
+  int col_block = UP_DIV(col_, BF16_MATMUL_COL_TILE);
+  split_by_col_ = col_block >= thread_num_ || total_row_ < thread_num_;
+  int units = split_by_col_ ? col_block : total_row_;
+  thread_stride_ = MSMAX(UP_DIV(units, thread_num_), 1);
+  thread_count_ = MSMAX(UP_DIV(units, thread_stride_), 1);
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::DoPackInput(int task_id) {
+  auto input = reinterpret_cast<float *>(in_tensors_[kInputIndex]->data());
+  if (a_transpose_) {
+    // [batch][deep][row], one task packs whole batches
+    int stride = UP_DIV(batch_, thread_count_);
+    int end = MSMIN(batch_, (task_id + 1) * stride);
+    for (int b = task_id * stride; b < end; ++b) {
+      PackMatmulInputBf16(input + b * row_ * deep_, pack_a_ + b * row_ * deep_align_, row_, deep_, true);
+    }
+    return RET_OK;
+  }
+  int stride = UP_DIV(total_row_, thread_count_);
+  int start = task_id * stride;
+  int rows = MSMIN(total_row_ - start, stride);
+  if (rows > 0) {
+    PackMatmulInputBf16(input + start * deep_, pack_a_ + start * deep_align_, rows, deep_, false);
+  }
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::DoMatmul(int task_id) {
+  if (split_by_col_) {
+    int start_block = task_id * thread_stride_;
+    int col_start = start_block * BF16_MATMUL_COL_TILE;
+    int cols = MSMIN(col_ - col_start, thread_stride_ * BF16_MATMUL_COL_TILE);
+    if (cols <= 0) {
+      return RET_OK;
+    }
+    matmul_func_(pack_a_, pack_b_ + start_block * deep_align_ * BF16_MATMUL_COL_TILE, output_ + col_start,
+                 bias_ == nullptr ? nullptr : bias_ + col_start, params_->act_type_, deep_, total_row_, cols, col_);
+    return RET_OK;
+  }
+  int row_start = task_id * thread_stride_;
+  int rows = MSMIN(total_row_ - row_start, thread_stride_);
+  if (rows <= 0) {
+    return RET_OK;
+  }
+  matmul_func_(pack_a_ + row_start * deep_align_, pack_b_, output_ + row_start * col_, bias_, params_->act_type_,
+               deep_, rows, col_, col_);
+  return RET_OK;
+}
+
+int MatmulBf16PackInputRun(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulBf16CPUKernel *>(cdata);
+  return kernel->DoPackInput(task_id);
+}
+
+int MatmulBf16Run(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulBf16CPUKernel *>(cdata);
+  return kernel->DoMatmul(task_id);
+}
+
+int MatmulBf16CPUKernel::Run() {
+  CHECK_NULL_RETURN(in_tensors_[kInputIndex]->data());
+  output_ = reinterpret_cast<float *>(out_tensors_[0]->data());
+  CHECK_NULL_RETURN(output_);
+  MS_CHECK_FALSE_MSG(INT_MUL_OVERFLOW(total_row_, deep_align_), RET_ERROR, "mul overflow.");
+  pack_a_ = reinterpret_cast<uint16_t *>(
+    ms_context_->allocator->Malloc(static_cast<size_t>(total_row_ * deep_align_) * sizeof(uint16_t)));
+  MS_CHECK_TRUE_MSG(pack_a_ != nullptr, RET_MEMORY_FAILED, "malloc packed bf16 input failed.");
+  auto ret = ParallelLaunch(this->ms_context_, MatmulBf16PackInputRun, this, thread_count_);
+  if (ret == RET_OK) {
+    ret = ParallelLaunch(this->ms_context_, MatmulBf16Run, this, thread_count_);
+  }
+  ms_context_->allocator->Free(pack_a_);
+  pack_a_ = nullptr;
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulBf16CPUKernel run failed: " << name_;
+  }
+  return ret;
+}
+
+REG_BF16_KERNEL(PrimitiveType_MatMulFusion, MatmulBf16CPUKernel)
+REG_BF16_KERNEL(PrimitiveType_FullConnection, MatmulBf16CPUKernel)
+}  // namespace mindspore::kernel
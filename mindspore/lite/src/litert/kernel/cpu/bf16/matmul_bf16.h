@@ -0,0 +1,66 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_MATMUL_BF16_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_MATMUL_BF16_H_
+
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/bf16/matmul_bf16.h"
+
+namespace mindspore::kernel {
+// MatMulFusion and FullConnection with a const fp32 weight, the weight is packed to bf16 once in Prepare
+class MatmulBf16CPUKernel : public LiteKernel {
+ public:
+  MatmulBf16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                      const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    params_ = reinterpret_cast<MatMulParameter *>(op_parameter_);
+  }
+  ~MatmulBf16CPUKernel() override;
+  static bool Support(const std::vector<lite::Tensor *> &inputs, const std::vector<lite::Tensor *> &outputs,
+                      const OpParameter *parameter);
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoPackInput(int task_id);
+  int DoMatmul(int task_id);
+
+ private:
+  int InitWeightAndBias();
+
+  MatMulParameter *params_ = nullptr;
+  MatmulBf16Func matmul_func_ = MatmulBf16;
+  uint16_t *pack_b_ = nullptr;
+  float *bias_ = nullptr;
+  uint16_t *pack_a_ = nullptr;
+  float *output_ = nullptr;
+  int batch_ = 1;
+  int row_ = 0;
+  int col_ = 0;
+  int deep_ = 0;
+  int deep_align_ = 0;
+  int total_row_ = 0;
+  bool a_transpose_ = false;
+  bool split_by_col_ = true;
+  int thread_stride_ = 0;
+  int thread_count_ = 1;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_MATMUL_BF16_H_
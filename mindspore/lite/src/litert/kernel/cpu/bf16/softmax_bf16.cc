@@ -0,0 +1,45 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/bf16/softmax_bf16.h"
+#include "schema/model_generated.h"
+#include "src/litert/kernel/cpu/bf16/bf16_kernel_registry.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "include/errorcode.h"
+
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_Softmax;
+
+namespace mindspore::kernel {
+bool SoftmaxBf16CPUKernel::Support(const std::vector<lite::Tensor *> &inputs,
+                                   const std::vector<lite::Tensor *> &outputs, const OpParameter *parameter) {
+  return inputs.size() == 1 && outputs.size() == 1 && inputs[kInputIndex]->data_type() == kNumberTypeFloat32;
+}
+
+int SoftmaxBf16CPUKernel::Run() {
+  auto ret = SoftmaxCPUKernel::Run();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  auto output = out_tensors_.at(kOutputIndex);
+  auto output_ptr = reinterpret_cast<float *>(output->data());
+  CHECK_NULL_RETURN(output_ptr);
+  RoundFloat32ToBf16(output_ptr, output_ptr, output->ElementsNum());
+  return RET_OK;
+}
+
+REG_BF16_KERNEL(PrimitiveType_Softmax, SoftmaxBf16CPUKernel)
+}  // namespace mindspore::kernel
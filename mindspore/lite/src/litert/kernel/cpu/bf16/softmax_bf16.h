@@ -0,0 +1,38 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_SOFTMAX_BF16_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_SOFTMAX_BF16_H_
+
+#include <vector>
+#include "src/litert/kernel/cpu/fp32/softmax_fp32.h"
+
+namespace mindspore::kernel {
+// the fp32 softmax with the output rounded to bf16 precision
+class SoftmaxBf16CPUKernel : public SoftmaxCPUKernel {
+ public:
+  SoftmaxBf16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                       const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : SoftmaxCPUKernel(parameter, inputs, outputs, ctx) {}
+  ~SoftmaxBf16CPUKernel() override = default;
+  static bool Support(const std::vector<lite::Tensor *> &inputs, const std::vector<lite::Tensor *> &outputs,
+                      const OpParameter *parameter);
+
+  int Run() override;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BF16_SOFTMAX_BF16_H_
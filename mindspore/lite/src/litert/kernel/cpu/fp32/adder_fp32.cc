@@ -85,7 +85,8 @@ int AdderCPUKernel::InitWeightBias() {
   CHECK_NULL_RETURN(origin_weight);
   CHECK_LESS_RETURN(MAX_MALLOC_SIZE, pack_weight_size * sizeof(float));
   packed_weight_ = lite::PackWeightManager::GetInstance()->GetPackData(
-    in_tensors_[1]->data(), pack_weight_size * sizeof(float), &weight_is_packed_);
+    in_tensors_[1]->data(), pack_weight_size * sizeof(float), &weight_is_packed_,
+    lite::PackVariant("Adder", {oc_block}));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed weight failed.";
     return RET_ERROR;
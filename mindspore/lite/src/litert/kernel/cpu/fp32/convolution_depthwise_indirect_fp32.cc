@@ -216,7 +216,8 @@ int ConvolutionDepthwiseIndirectCPUKernel::MallocWeightBiasData() {
   if (!op_parameter_->is_train_session_) {
     CHECK_LESS_RETURN(MAX_MALLOC_SIZE, pack_weight_size * sizeof(float));
     packed_weight_ = lite::PackWeightManager::GetInstance()->GetPackData(
-      in_tensors_[1]->data(), static_cast<size_t>(pack_weight_size * sizeof(float)), &weight_is_packed_);
+      in_tensors_[1]->data(), static_cast<size_t>(pack_weight_size * sizeof(float)), &weight_is_packed_,
+      lite::PackVariant("ConvDwIndirect", {div_flag}));
     if (packed_weight_ == nullptr) {
       MS_LOG(ERROR) << "Malloc buffer failed.";
       return RET_ERROR;
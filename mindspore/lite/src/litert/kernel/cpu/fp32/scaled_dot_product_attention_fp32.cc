@@ -0,0 +1,195 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/scaled_dot_product_attention_fp32.h"
+#include <algorithm>
+#include "schema/model_generated.h"
+#include "src/litert/kernel_registry.h"
+#include "include/errorcode.h"
+#include "nnacl/fp32/flash_attention_fp32.h"
+
+using mindspore::kernel::KERNEL_ARCH;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_ScaledDotProductAttention;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kMaskIndex = 3;
+}  // namespace
+
+int ScaledDotProductAttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C3NUM);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  CHECK_NULL_RETURN(param_);
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int ScaledDotProductAttentionCPUKernel::InitMaskOffsets() {
+  mask_offsets_.clear();
+  mask_row_stride_ = 0;
+  if (in_tensors_.size() <= kMaskIndex) {
+    return RET_OK;
+  }
+  if (in_tensors_.at(kMaskIndex)->data_type() != kNumberTypeFloat32) {
+    MS_LOG(ERROR) << "mask of attention should be float32, but got " << in_tensors_.at(kMaskIndex)->data_type();
+    return RET_ERROR;
+  }
+  auto q_shape = in_tensors_.at(FIRST_INPUT)->shape();
+  auto mask_shape = in_tensors_.at(kMaskIndex)->shape();
+  auto rank = q_shape.size();
+  if (mask_shape.size() < C2NUM || mask_shape.size() > rank || mask_shape.back() != param_->k_seq_) {
+    MS_LOG(ERROR) << "mask of attention should be broadcast to [..., " << param_->q_seq_ << ", " << param_->k_seq_
+                  << "], but got rank " << mask_shape.size();
+    return RET_ERROR;
+  }
+  auto mask_rows = mask_shape.at(mask_shape.size() - C2NUM);
+  if (mask_rows != param_->q_seq_ && mask_rows != 1) {
+    MS_LOG(ERROR) << "mask rows " << mask_rows << " can not be broadcast to " << param_->q_seq_;
+    return RET_ERROR;
+  }
+  mask_row_stride_ = mask_rows == 1 ? 0 : param_->k_seq_;
+
+  // offset of each flattened leading index of q into the mask, with the size-1 dims of the mask broadcast
+  std::vector<int> mask_dims(rank, 1);
+  std::copy(mask_shape.begin(), mask_shape.end(), mask_dims.begin() + (rank - mask_shape.size()));
+  mask_offsets_.assign(batch_, 0);
+  for (int b = 0; b < batch_; ++b) {
+    int index = b;
+    int offset = 0;
+    int mask_stride = mask_rows * param_->k_seq_;
+    for (int dim = static_cast<int>(rank) - C3NUM; dim >= 0; --dim) {
+      int coord = index % q_shape.at(dim);
+      index /= q_shape.at(dim);
+      if (mask_dims.at(dim) != 1) {
+        if (mask_dims.at(dim) != q_shape.at(dim)) {
+          MS_LOG(ERROR) << "mask dim " << dim << " can not be broadcast to " << q_shape.at(dim);
+          return RET_ERROR;
+        }
+        offset += coord * mask_stride;
+      }
+      mask_stride *= mask_dims.at(dim);
+    }
+    mask_offsets_[b] = offset;
+  }
+  return RET_OK;
+}
+
+int ScaledDotProductAttentionCPUKernel::ReSize() {
+  auto q_shape = in_tensors_.at(FIRST_INPUT)->shape();
+  auto k_shape = in_tensors_.at(SECOND_INPUT)->shape();
+  auto v_shape = in_tensors_.at(THIRD_INPUT)->shape();
+  auto rank = q_shape.size();
+  if (rank < C2NUM || k_shape.size() != rank || v_shape.size() != rank) {
+    MS_LOG(ERROR) << "q, k and v of attention should have the same rank which is at least 2.";
+    return RET_ERROR;
+  }
+  batch_ = 1;
+  for (size_t i = 0; i < rank - C2NUM; ++i) {
+    if (k_shape.at(i) != q_shape.at(i) || v_shape.at(i) != q_shape.at(i)) {
+      MS_LOG(ERROR) << "batch dim " << i << " of q, k and v of attention mismatch.";
+      return RET_ERROR;
+    }
+    MS_CHECK_FALSE_MSG(INT_MUL_OVERFLOW(batch_, q_shape.at(i)), RET_ERROR, "mul overflow.");
+    batch_ *= q_shape.at(i);
+  }
+  param_->q_seq_ = q_shape.at(rank - C2NUM);
+  param_->head_size_ = q_shape.back();
+  param_->k_seq_ = param_->transpose_k_ ? k_shape.at(rank - C2NUM) : k_shape.back();
+  auto k_head_size = param_->transpose_k_ ? k_shape.back() : k_shape.at(rank - C2NUM);
+  param_->v_head_size_ = v_shape.back();
+  if (k_head_size != param_->head_size_ || v_shape.at(rank - C2NUM) != param_->k_seq_) {
+    MS_LOG(ERROR) << "shape of q, k and v of attention mismatch.";
+    return RET_ERROR;
+  }
+  param_->q_block_ = FLASH_ATTENTION_Q_BLOCK;
+  param_->kv_block_ = FLASH_ATTENTION_KV_BLOCK;
+  if (InitMaskOffsets() != RET_OK) {
+    return RET_ERROR;
+  }
+
+  q_block_num_ = UP_DIV(param_->q_seq_, param_->q_block_);
+  MS_CHECK_FALSE_MSG(INT_MUL_OVERFLOW(batch_, q_block_num_), RET_ERROR, "mul overflow.");
+  unit_num_ = batch_ * q_block_num_;
+  thread_num_ = MSMAX(MSMIN(op_parameter_->thread_num_, unit_num_), 1);
+  buffer_size_ = FlashAttentionBufferSize(param_);
+  return RET_OK;
+}
+
+int ScaledDotProductAttentionCPUKernel::DoAttention(int task_id) {
+  auto q = reinterpret_cast<const float *>(in_tensors_.at(FIRST_INPUT)->data());
+  auto k = reinterpret_cast<const float *>(in_tensors_.at(SECOND_INPUT)->data());
+  auto v = reinterpret_cast<const float *>(in_tensors_.at(THIRD_INPUT)->data());
+  auto out = reinterpret_cast<float *>(out_tensors_.at(FIRST_INPUT)->data());
+  const float *mask = nullptr;
+  if (!mask_offsets_.empty()) {
+    mask = reinterpret_cast<const float *>(in_tensors_.at(kMaskIndex)->data());
+  }
+  float *buffer = buffer_ + task_id * buffer_size_;
+
+  // contiguous units keep the key and value of a head hot in the cache of one thread
+  int stride = UP_DIV(unit_num_, thread_num_);
+  int start = task_id * stride;
+  int end = MSMIN(unit_num_, start + stride);
+  int q_seq = param_->q_seq_;
+  int k_seq = param_->k_seq_;
+  for (int unit = start; unit < end; ++unit) {
+    int b = unit / q_block_num_;
+    int q_start = unit % q_block_num_ * param_->q_block_;
+    int q_rows = MSMIN(param_->q_block_, q_seq - q_start);
+    const float *mask_rows = mask == nullptr ? nullptr : mask + mask_offsets_[b] + q_start * mask_row_stride_;
+    FlashAttentionFp32(q + (static_cast<size_t>(b) * q_seq + q_start) * param_->head_size_,
+                       k + static_cast<size_t>(b) * k_seq * param_->head_size_,
+                       v + static_cast<size_t>(b) * k_seq * param_->v_head_size_, mask_rows, mask_row_stride_,
+                       out + (static_cast<size_t>(b) * q_seq + q_start) * param_->v_head_size_, buffer, q_rows, param_);
+  }
+  return RET_OK;
+}
+
+int ScaledDotProductAttentionRun(void *cdata, int task_id, float, float) {
+  auto kernel = reinterpret_cast<ScaledDotProductAttentionCPUKernel *>(cdata);
+  CHECK_NULL_RETURN(kernel);
+  auto ret = kernel->DoAttention(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "ScaledDotProductAttentionRun error task_id[" << task_id << "] error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int ScaledDotProductAttentionCPUKernel::Run() {
+  for (size_t i = 0; i < in_tensors_.size(); ++i) {
+    CHECK_NULL_RETURN(in_tensors_.at(i)->data());
+  }
+  CHECK_NULL_RETURN(out_tensors_.at(FIRST_INPUT)->data());
+  buffer_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(thread_num_ * buffer_size_ * sizeof(float)));
+  if (buffer_ == nullptr) {
+    MS_LOG(ERROR) << "malloc attention buffer failed.";
+    return RET_ERROR;
+  }
+  auto ret = ParallelLaunch(this->ms_context_, ScaledDotProductAttentionRun, this, thread_num_);
+  ms_context_->allocator->Free(buffer_);
+  buffer_ = nullptr;
+  return ret;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_ScaledDotProductAttention,
+           LiteKernelCreator<ScaledDotProductAttentionCPUKernel>)
+}  // namespace mindspore::kernel
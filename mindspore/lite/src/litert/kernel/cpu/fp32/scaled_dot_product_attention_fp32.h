@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SCALED_DOT_PRODUCT_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SCALED_DOT_PRODUCT_ATTENTION_FP32_H_
+
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+// softmax(q * k * scale + mask) * v computed per (batch, query block) without materializing the score matrix
+class ScaledDotProductAttentionCPUKernel : public LiteKernel {
+ public:
+  ScaledDotProductAttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                                     const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<ScaledDotProductAttentionParameter *>(op_parameter_);
+  }
+  ~ScaledDotProductAttentionCPUKernel() override = default;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoAttention(int task_id);
+
+ private:
+  int InitMaskOffsets();
+
+  ScaledDotProductAttentionParameter *param_ = nullptr;
+  int batch_ = 1;
+  int q_block_num_ = 0;
+  int unit_num_ = 0;
+  size_t buffer_size_ = 0;
+  int mask_row_stride_ = 0;
+  std::vector<int> mask_offsets_;
+  float *buffer_ = nullptr;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SCALED_DOT_PRODUCT_ATTENTION_FP32_H_
@@ -25,6 +25,16 @@
 #include "nnacl/int8/quantize.h"
 #include "nnacl/int8/common_func_int8.h"
 #include "nnacl/int8/matmul_int8.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+// the row4x4 * row4x16 dot product path, sdot on arm64 and vpdpbusd on x86 avx512-vnni
+#if (defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && !defined(MACHINE_LINUX_ARM64)) || \
+  defined(ENABLE_AVX512)
+#define MATMUL_INT8_DOT_PRODUCT
+#endif
 
 namespace mindspore::kernel {
 class MatmulBaseInt8CPUKernel : public LiteKernel {
@@ -44,10 +54,10 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
 
  public:
   int RunImpl(int task_id);
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && (!defined(MACHINE_LINUX_ARM64))
-  int RunArm64Sdot();
-  int Arm64SdotImpl(int task_id);
-  int Arm64SdotPre(int task_id);
+#ifdef MATMUL_INT8_DOT_PRODUCT
+  int RunDotProduct();
+  int DotProductImpl(int task_id);
+  int DotProductPre(int task_id);
 #endif
 
  protected:
@@ -87,7 +97,12 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
   int col_tile_ = C4NUM;
   int deep_tile_ = C16NUM;
   int channel_num_ = 0;
-  bool support_sdot_ = false;
+  bool support_dot_product_ = false;
+#ifdef ENABLE_AVX512
+  // the per-thread AMX repack buffers, allocated with the other resize buffers
+  int8_t *amx_buffer_ = nullptr;
+  size_t amx_buffer_size_ = 0;
+#endif
   PackFunc a_pack_func_{nullptr};
   PackFunc b_pack_func_{nullptr};
   std::vector<int> a_offset_;
@@ -89,6 +89,11 @@ int LiteKernel::UpdateThreadNumProcess(int32_t kernel_type, int64_t per_unit_loa
 
 int LiteKernel::UpdateThreadNumPass(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num,
                                     int64_t unit_num) {
+  // only kernels splitting their work here follow a new thread num after ReSize
+  thread_num_tunable_ = true;
+  if (tuned_thread_num_ > 0) {
+    op_parameter_->thread_num_ = tuned_thread_num_;
+  }
 #ifdef DYNAMIC_THREAD_DISTRIBUTE
   if (UpdateThreadNumProcess(kernel_type, per_unit_load_num, per_unit_store_num, unit_num) != lite::RET_OK) {
     MS_LOG(ERROR) << "update thread num failed";
@@ -188,6 +188,12 @@ class LiteKernel : public Abstractkernel {
   }
   bool ws_allocated_ = false;
 
+  // thread num chosen by the online tuner, once set it replaces the context thread num in UpdateThreadNumPass. Under
+  // DYNAMIC_THREAD_DISTRIBUTE the cost model then picks at most this many threads.
+  void set_tuned_thread_num(int thread_num) { tuned_thread_num_ = thread_num; }
+  int tuned_thread_num() const { return tuned_thread_num_; }
+  bool thread_num_tunable() const { return thread_num_tunable_; }
+
  protected:
   virtual int UpdateThreadNumProcess(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num,
                                      int64_t unit_num);
@@ -206,6 +212,8 @@ class LiteKernel : public Abstractkernel {
   const lite::InnerContext *ms_context_ = nullptr;
 
   int thread_num_ = 1;
+  int tuned_thread_num_ = 0;
+  bool thread_num_tunable_ = false;
 };
 }  // namespace mindspore::kernel
 
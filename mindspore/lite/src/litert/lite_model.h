@@ -62,6 +62,10 @@ class LiteModel : public Model {
 
   void set_keep_model_buf(bool keep) { this->keep_model_buf_ = keep; }
 
+  bool model_buf_by_mmap() const { return this->model_buf_by_mmap_; }
+
+  void set_model_buf_by_mmap(bool by_mmap) { this->model_buf_by_mmap_ = by_mmap; }
+
   int GetSchemaVersion() const { return schema_version_; }
 
   SchemaTensorWrapper *GetSchemaTensor(const size_t &tensor_index) const;
@@ -336,6 +340,7 @@ class LiteModel : public Model {
  protected:
   std::vector<char *> attr_tensor_bufs_;
   bool keep_model_buf_ = false;
+  bool model_buf_by_mmap_ = false;
   int schema_version_ = SCHEMA_VERSION::SCHEMA_CUR;
   // tensor_index --- external_data
   std::vector<SchemaTensorWrapper *> inner_all_tensors_;
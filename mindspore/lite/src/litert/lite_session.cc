@@ -573,12 +573,26 @@ int LiteSession::CompileGraph(Model *model) {
 
   non_tail_call_kernels_ = scheduler.NonTailCallNodes();
 
+  // weights are updated in training, so only inference sessions use the pack weight cache
+  if (!is_train_session_) {
+    // const tensor data may be replaced during scheduling, so record it after that
+    ret = lite::PackWeightManager::GetInstance()->StorePackCacheTensors(id_, tensors_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "StorePackCacheTensors failed.";
+      is_running_.store(false);
+      return ret;
+    }
+  }
+
   ret = PrepareKernels(model);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Prepare kernels failed: " << ret;
     is_running_.store(false);
     return ret;
   }
+  if (lite::PackWeightManager::GetInstance()->FlushPackCache(id_) != RET_OK) {
+    MS_LOG(WARNING) << "Save pack weight cache failed, weights will be packed again in the next load.";
+  }
 
   if (is_train_session_ || is_prepare_session_) {
     is_running_.store(false);
@@ -601,6 +615,13 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  ret = InitThreadNumTuner();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init thread num tuner failed.";
+    is_running_.store(false);
+    return ret;
+  }
+
   is_running_.store(false);
   return RET_OK;
 }
@@ -741,7 +762,24 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
     return ret;
   }
   MS_ASSERT(this->context_ != nullptr);
-  ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, before, after);
+  if (thread_num_tuner_ != nullptr && thread_num_tuner_->IsTuning()) {
+    KernelCallBack tune_before = nullptr;
+    KernelCallBack tune_after = nullptr;
+    ret = thread_num_tuner_->BeginRun(before, after, &tune_before, &tune_after);
+    if (ret != RET_OK) {
+      is_running_.store(false);
+      MS_LOG(ERROR) << "Begin thread num tuning run failed.";
+      return ret;
+    }
+    ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, tune_before, tune_after);
+    auto tune_ret = thread_num_tuner_->EndRun(ret == RET_OK);
+    if (ret == RET_OK && tune_ret != RET_OK) {
+      MS_LOG(ERROR) << "End thread num tuning run failed.";
+      ret = tune_ret;
+    }
+  } else {
+    ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, before, after);
+  }
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "RunGraph failed : " << ret;
   }
@@ -1265,6 +1303,13 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     return RET_ERROR;
   }
 
+  // the tuned thread nums are bound to the input shapes
+  if (thread_num_tuner_ != nullptr && thread_num_tuner_->Init(kernels_) != RET_OK) {
+    MS_LOG(ERROR) << "Init thread num tuner in resize failed.";
+    is_running_.store(false);
+    return RET_ERROR;
+  }
+
   is_running_.store(false);
   ret = UpdateInputShapeMap();
   if (ret != RET_OK) {
@@ -1660,6 +1705,69 @@ const char *lite::LiteSession::LoadModelByPath(const std::string &file, mindspor
   return lite_buf;
 }
 
+const char *lite::LiteSession::LoadModelByMmap(const std::string &file, size_t *size) {
+  size_t buf_size = 0;
+  auto model_buf = lite::MapFile(file.c_str(), &buf_size);
+  if (model_buf == nullptr) {
+    return nullptr;
+  }
+  // only an ms flatbuffer can be referenced in place, other formats need runtime convert
+  flatbuffers::Verifier verify((const uint8_t *)model_buf, buf_size, INT32_MAX, INT32_MAX);
+  if (lite::LiteModel::VersionVerify(&verify) == SCHEMA_INVALID) {
+    MS_LOG(INFO) << "Model file " << file << " is not a mslite model, can not be mapped.";
+    lite::UnmapFile(model_buf, buf_size);
+    return nullptr;
+  }
+  *size = buf_size;
+  return model_buf;
+}
+
+bool lite::LiteSession::IsMmapModelEnabled() {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto model_load = config_info_->find(kModelLoad);
+  if (model_load == config_info_->end()) {
+    return false;
+  }
+  auto mmap_iter = model_load->second.find(kModelLoadMmap);
+  return mmap_iter != model_load->second.end() && mmap_iter->second == "true";
+}
+
+int lite::LiteSession::InitThreadNumTuner() {
+  if (config_info_ == nullptr) {
+    return RET_OK;
+  }
+  auto tune_config = config_info_->find(kThreadNumTune);
+  if (tune_config == config_info_->end()) {
+    return RET_OK;
+  }
+  auto enable_iter = tune_config->second.find(kThreadNumTuneEnable);
+  if (enable_iter == tune_config->second.end() || enable_iter->second != "true") {
+    return RET_OK;
+  }
+  if (context_->thread_num_ <= 1) {
+    MS_LOG(INFO) << "thread num of context is " << context_->thread_num_ << ", no thread num to tune.";
+    return RET_OK;
+  }
+  std::string profile_path;
+  auto path_iter = tune_config->second.find(kThreadNumTuneProfilePath);
+  if (path_iter != tune_config->second.end()) {
+    profile_path = path_iter->second;
+  }
+  int tune_loops = 1;
+  auto loops_iter = tune_config->second.find(kThreadNumTuneLoops);
+  if (loops_iter != tune_config->second.end()) {
+    tune_loops = std::atoi(loops_iter->second.c_str());
+    if (tune_loops <= 0) {
+      MS_LOG(ERROR) << "tune_loops of thread num tune should be positive, but got " << loops_iter->second;
+      return RET_ERROR;
+    }
+  }
+  thread_num_tuner_ = std::make_unique<ThreadNumTuner>(context_->thread_num_, profile_path, tune_loops);
+  return thread_num_tuner_->Init(kernels_);
+}
+
 std::string lite::LiteSession::ParseWeightPath() {
   std::string weight_path = "";
   if (config_info_ != nullptr) {
@@ -1724,37 +1832,62 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
 
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, mindspore::ModelType model_type) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  const char *model_buf = nullptr;
+  bool model_buf_by_mmap = false;
+  if (IsMmapModelEnabled()) {
+    model_buf = LoadModelByMmap(model_path, &model_size);
+    model_buf_by_mmap = (model_buf != nullptr);
+  }
+  if (model_buf == nullptr) {
+    model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
   }
-  auto status =
-    lite::PackWeightManager::GetInstance()->InitPackWeightManager(model_buf, model_size, &id_, config_info_);
+  // release the buffer read from the file, as long as it is not taken by the model
+  auto free_model_buf = [&model_buf, &model_buf_by_mmap, model_size]() {
+    if (model_buf_by_mmap) {
+      lite::UnmapFile(const_cast<char *>(model_buf), model_size);
+      model_buf_by_mmap = false;
+    } else {
+      delete[] model_buf;
+    }
+    model_buf = nullptr;
+  };
+  auto status = lite::PackWeightManager::GetInstance()->InitPackWeightManager(model_buf, model_size, &id_,
+                                                                              config_info_, model_path);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "InitPackWeightByBuf failed.";
+    free_model_buf();
     return RET_ERROR;
   }
   auto new_model_buf =
     lite::PackWeightManager::GetInstance()->GetSharedModelBuf(model_buf, id_, config_info_, &is_shared_weight_);
   if (new_model_buf == nullptr) {
     MS_LOG(ERROR) << "get shared model buf is nullptr.";
+    free_model_buf();
     return RET_ERROR;
   }
   if (is_shared_weight_) {
-    delete[] model_buf;
-    model_buf = nullptr;
+    free_model_buf();
   }
   auto *model = lite::ImportFromBuffer(new_model_buf, model_size, true, model_type, model_path);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
+    if (model_buf_by_mmap) {
+      lite::UnmapFile(new_model_buf, model_size);
+    }
     return RET_ERROR;
   }
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_model_buf_by_mmap(model_buf_by_mmap);
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
-    model->buf = nullptr;
+    if (!model_buf_by_mmap) {
+      model->buf = nullptr;
+    }
     delete model;
     return RET_ERROR;
   }
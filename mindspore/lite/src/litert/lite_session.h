@@ -29,6 +29,7 @@
 #include "src/litert/runtime_allocator.h"
 #include "schema/model_generated.h"
 #include "src/litert/executor.h"
+#include "src/litert/thread_num_tuner.h"
 #include "src/tensor.h"
 #include "src/tensorlist.h"
 #include "src/common/dynamic_library_loader.h"
@@ -60,6 +61,7 @@ class LiteSession {
   mindspore::ModelType LoadModelByBuff(const char *model_buf, const size_t &buf_size, char **lite_buf, size_t *size,
                                        mindspore::ModelType model_type);
   const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size);
+  const char *LoadModelByMmap(const std::string &file, size_t *size);
   virtual int Init(const std::shared_ptr<InnerContext> &context);
   virtual void BindThread(bool if_bind);
   virtual int CompileGraph(Model *model);
@@ -153,6 +155,8 @@ class LiteSession {
     const std::unordered_map<Tensor *, Tensor *> &isolate_input_map = std::unordered_map<Tensor *, Tensor *>());
   static void FreePackOpWeight(const std::vector<kernel::KernelExec *> &kernels);
   std::string ParseWeightPath();
+  bool IsMmapModelEnabled();
+  int InitThreadNumTuner();
 
  private:
   int PreCheck(Model *model);
@@ -228,6 +232,7 @@ class LiteSession {
   std::vector<kernel::KernelExec *> non_tail_call_kernels_;
   std::string id_;
   bool is_shared_weight_ = false;
+  std::unique_ptr<ThreadNumTuner> thread_num_tuner_ = nullptr;
 };
 }  // namespace lite
 }  // namespace mindspore
@@ -0,0 +1,256 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/pack_weight_cache.h"
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "src/common/file_utils.h"
+#include "src/common/log_adapter.h"
+#if defined(ENABLE_AVX512)
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore::lite {
+namespace {
+constexpr char kPackCacheMagic[] = "MSPACKW";
+// bump when a packing layout of any cached kernel changes
+constexpr uint32_t kPackCacheVersion = 2;
+constexpr size_t kPackCacheAlign = 64;
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+// a model given by buffer is keyed by its head, holding the flatbuffer root and tables, and by blocks spread over the
+// rest of it, so the key reads a bounded number of pages whatever the model size is
+constexpr size_t kModelHeadSize = 4096;
+constexpr size_t kSampleBlockNum = 64;
+constexpr size_t kSampleBlockSize = 64;
+
+struct PackCacheHeader {
+  char magic[sizeof(kPackCacheMagic)];
+  uint32_t version;
+  uint32_t entry_num;
+};
+
+struct PackCacheEntry {
+  uint64_t tensor_index;
+  uint64_t variant;
+  uint64_t size;
+  uint64_t offset;
+};
+
+size_t AlignUp(size_t size) { return (size + kPackCacheAlign - 1) & (~(kPackCacheAlign - 1)); }
+
+uint64_t HashBuf(const char *buf, size_t size, uint64_t hash = kFnvOffsetBasis) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<uint8_t>(buf[i]);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t HashModelBuf(const char *buf, size_t size) {
+  if (size <= kModelHeadSize + kSampleBlockNum * kSampleBlockSize) {
+    return HashBuf(buf, size) ^ static_cast<uint64_t>(size);
+  }
+  auto hash = HashBuf(buf, kModelHeadSize);
+  size_t stride = (size - kModelHeadSize) / kSampleBlockNum;
+  for (size_t i = 0; i + 1 < kSampleBlockNum; i++) {
+    hash = HashBuf(buf + kModelHeadSize + i * stride, kSampleBlockSize, hash);
+  }
+  // the last block ends at the end of the buffer
+  hash = HashBuf(buf + size - kSampleBlockSize, kSampleBlockSize, hash);
+  return hash ^ static_cast<uint64_t>(size);
+}
+
+// a model file is keyed by its path, size and modification time without reading it
+bool HashModelFile(const std::string &model_path, size_t model_size, uint64_t *hash) {
+  auto real_path = RealPath(model_path.c_str());
+  struct stat file_stat;
+  if (real_path.empty() || stat(real_path.c_str(), &file_stat) != 0) {
+    return false;
+  }
+  auto key = real_path + ":" + std::to_string(model_size) + ":" + std::to_string(file_stat.st_mtime);
+  *hash = HashBuf(key.data(), key.size());
+  return true;
+}
+
+// the packing layouts follow the simd width the kernels are built and dispatched with
+std::string CpuIsaName() {
+#if defined(ENABLE_ARM64)
+  return "arm64";
+#elif defined(ENABLE_ARM32)
+  return "arm32";
+#elif defined(ENABLE_AVX512)
+  return X86_Avx512_Support() ? "avx512" : "avx";
+#elif defined(ENABLE_AVX)
+  return "avx";
+#elif defined(ENABLE_SSE)
+  return "sse";
+#else
+  return "generic";
+#endif
+}
+}  // namespace
+
+PackWeightCache::~PackWeightCache() {
+  UnmapFile(mapped_buf_, mapped_size_);
+  mapped_buf_ = nullptr;
+  mapped_size_ = 0;
+}
+
+std::string PackWeightCache::GenCacheFilePath(const std::string &cache_dir, const char *model_buf, size_t model_size,
+                                              const std::string &model_path) {
+  uint64_t model_hash = 0;
+  if (model_path.empty() || !HashModelFile(model_path, model_size, &model_hash)) {
+    model_hash = HashModelBuf(model_buf, model_size);
+  }
+  std::stringstream file_name;
+  file_name << std::hex << model_hash << std::dec << "_" << CpuIsaName() << ".pack";
+  return cache_dir + FILE_SEPARATOR + file_name.str();
+}
+
+STATUS PackWeightCache::Init(const std::string &file_path) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  file_path_ = file_path;
+  if (access(file_path_.c_str(), F_OK) != 0) {
+    MS_LOG(INFO) << "pack weight cache " << file_path_ << " not found, packed weights will be cached after compile.";
+    return RET_OK;
+  }
+  if (MapCacheFile() != RET_OK) {
+    MS_LOG(WARNING) << "pack weight cache " << file_path_ << " is invalid, it will be rebuilt.";
+  }
+  return RET_OK;
+}
+
+STATUS PackWeightCache::MapCacheFile() {
+  size_t size = 0;
+  auto buf = MapFile(file_path_.c_str(), &size);
+  if (buf == nullptr) {
+    return RET_ERROR;
+  }
+  auto header = reinterpret_cast<const PackCacheHeader *>(buf);
+  if (size < sizeof(PackCacheHeader) || memcmp(header->magic, kPackCacheMagic, sizeof(kPackCacheMagic)) != 0 ||
+      header->version != kPackCacheVersion ||
+      (size - sizeof(PackCacheHeader)) / sizeof(PackCacheEntry) < header->entry_num) {
+    UnmapFile(buf, size);
+    return RET_ERROR;
+  }
+  std::map<std::pair<size_t, uint64_t>, std::pair<size_t, size_t>> entries;
+  auto entry = reinterpret_cast<const PackCacheEntry *>(buf + sizeof(PackCacheHeader));
+  for (uint32_t i = 0; i < header->entry_num; i++) {
+    if (entry[i].offset % kPackCacheAlign != 0 || entry[i].offset > size || entry[i].size > size - entry[i].offset) {
+      UnmapFile(buf, size);
+      return RET_ERROR;
+    }
+    entries[std::make_pair(entry[i].tensor_index, entry[i].variant)] = std::make_pair(entry[i].offset, entry[i].size);
+  }
+  mapped_buf_ = buf;
+  mapped_size_ = size;
+  cached_entries_.swap(entries);
+  MS_LOG(INFO) << "map pack weight cache " << file_path_ << " with " << cached_entries_.size() << " weights.";
+  return RET_OK;
+}
+
+void *PackWeightCache::GetPackData(size_t tensor_index, const std::string &pack_variant, size_t size) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  auto iter = cached_entries_.find(std::make_pair(tensor_index, HashBuf(pack_variant.data(), pack_variant.size())));
+  if (mapped_buf_ == nullptr || iter == cached_entries_.end() || iter->second.second != size) {
+    return nullptr;
+  }
+  return mapped_buf_ + iter->second.first;
+}
+
+void PackWeightCache::RecordPackData(size_t tensor_index, const std::string &pack_variant, void *pack_data,
+                                     size_t size) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  if (mapped_buf_ != nullptr || pack_data == nullptr || size == 0) {
+    return;
+  }
+  // a weight shared by several kernels with the same layout is cached with the first packing
+  auto key = std::make_pair(tensor_index, HashBuf(pack_variant.data(), pack_variant.size()));
+  (void)pending_entries_.emplace(key, std::make_pair(pack_data, size));
+}
+
+void PackWeightCache::ForgetPackData(const void *pack_data) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  for (auto iter = pending_entries_.begin(); iter != pending_entries_.end();) {
+    if (iter->second.first == pack_data) {
+      iter = pending_entries_.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+}
+
+bool PackWeightCache::IsCachedData(const void *data) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  auto addr = reinterpret_cast<const char *>(data);
+  return mapped_buf_ != nullptr && addr >= mapped_buf_ && addr < mapped_buf_ + mapped_size_;
+}
+
+STATUS PackWeightCache::Flush() {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  if (mapped_buf_ != nullptr || pending_entries_.empty()) {
+    pending_entries_.clear();
+    return RET_OK;
+  }
+  PackCacheHeader header;
+  memcpy(header.magic, kPackCacheMagic, sizeof(kPackCacheMagic));
+  header.version = kPackCacheVersion;
+  header.entry_num = static_cast<uint32_t>(pending_entries_.size());
+  std::vector<PackCacheEntry> entries;
+  size_t offset = AlignUp(sizeof(PackCacheHeader) + pending_entries_.size() * sizeof(PackCacheEntry));
+  for (auto &item : pending_entries_) {
+    entries.push_back({item.first.first, item.first.second, item.second.second, offset});
+    offset = AlignUp(offset + item.second.second);
+  }
+  // write to a private file and rename it, so that a concurrent loader never maps a partial cache
+#ifdef _WIN32
+  auto tmp_path = file_path_ + ".tmp";
+#else
+  auto tmp_path = file_path_ + "." + std::to_string(getpid()) + ".tmp";
+#endif
+  std::ofstream out_file(tmp_path, std::ios::binary);
+  if (!out_file.good() || !out_file.is_open()) {
+    MS_LOG(WARNING) << "open pack weight cache " << tmp_path << " failed.";
+    pending_entries_.clear();
+    return RET_ERROR;
+  }
+  const char padding[kPackCacheAlign] = {0};
+  out_file.write(reinterpret_cast<const char *>(&header), sizeof(PackCacheHeader));
+  out_file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(PackCacheEntry));
+  size_t pos = sizeof(PackCacheHeader) + entries.size() * sizeof(PackCacheEntry);
+  size_t i = 0;
+  for (auto &item : pending_entries_) {
+    out_file.write(padding, entries[i].offset - pos);
+    out_file.write(reinterpret_cast<const char *>(item.second.first), item.second.second);
+    pos = entries[i].offset + item.second.second;
+    i++;
+  }
+  out_file.close();
+  pending_entries_.clear();
+  if (!out_file.good() || std::rename(tmp_path.c_str(), file_path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "write pack weight cache " << file_path_ << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  MS_LOG(INFO) << "save pack weight cache " << file_path_ << " with " << entries.size() << " weights.";
+  // later loads in this process map the cache as well
+  return MapCacheFile();
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+// On-disk cache of the packed const weights of one model on one cpu isa. The file is
+// `<cache_dir>/<model hash>_<isa>.pack`, holding a header, an entry table of
+// {tensor index, pack variant hash, packed size, offset} and the packed data at 64-byte aligned offsets. The pack
+// variant names the kernel and its packing layout, so a weight consumed by kernels with different layouts is cached
+// once per layout. The file is mapped copy-on-write, so every process loading the same
+// model shares its pages through the page cache instead of repacking the weights.
+class PackWeightCache {
+ public:
+  PackWeightCache() = default;
+  ~PackWeightCache();
+
+  // the model hash of a model built from its file is taken from the path, size and modification time of the file,
+  // otherwise from the head and some strided blocks of the model buffer. Models given by buffer which only differ
+  // between the sampled blocks share the cache, give them different cache dirs.
+  static std::string GenCacheFilePath(const std::string &cache_dir, const char *model_buf, size_t model_size,
+                                      const std::string &model_path = "");
+  // map the cache file if it exists and is valid, otherwise packed weights are recorded for Flush.
+  STATUS Init(const std::string &file_path);
+  // packed data of the tensor in the mapped file, nullptr if not cached.
+  void *GetPackData(size_t tensor_index, const std::string &pack_variant, size_t size);
+  // remember a freshly packed buffer, its content is read at Flush.
+  void RecordPackData(size_t tensor_index, const std::string &pack_variant, void *pack_data, size_t size);
+  void ForgetPackData(const void *pack_data);
+  bool IsCachedData(const void *data);
+  // write the recorded buffers to the cache file and map it.
+  STATUS Flush();
+
+ private:
+  STATUS MapCacheFile();
+
+  std::mutex cache_mutex_;
+  std::string file_path_;
+  char *mapped_buf_ = nullptr;
+  size_t mapped_size_ = 0;
+  // {tensor index, pack variant hash} : {offset in mapped file, packed size}
+  std::map<std::pair<size_t, uint64_t>, std::pair<size_t, size_t>> cached_entries_;
+  // {tensor index, pack variant hash} : {packed buffer, packed size}
+  std::map<std::pair<size_t, uint64_t>, std::pair<void *, size_t>> pending_entries_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
@@ -18,12 +18,28 @@
 #include <map>
 #include <string>
 #include "src/common/graph_util.h"
+#include "src/common/file_utils.h"
 namespace mindspore::lite {
 namespace {
 #ifndef __ANDROID__
 constexpr size_t kMemAlignSize = 64;
 #endif
 
+std::string ParsePackCacheDir(const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  std::string cache_dir;
+  if (config_info == nullptr) {
+    return cache_dir;
+  }
+  auto it_cache = config_info->find(kPackWeightCache);
+  if (it_cache != config_info->end()) {
+    auto item_dir = it_cache->second.find(kPackWeightCacheDir);
+    if (item_dir != it_cache->second.end()) {
+      cache_dir = item_dir->second;
+    }
+  }
+  return cache_dir;
+}
+
 #ifdef SHARING_MODEL_WEIGHT
 std::string ParseNumaId(const std::map<std::string, std::map<std::string, std::string>> *config_info) {
   std::string numa_id = "-1";
@@ -90,7 +106,7 @@ bool PackWeightManager::IsCopyTensor(int op_type) {
 
 STATUS PackWeightManager::InitPackWeightManager(
   const char *model_buf, size_t model_size, std::string *model_id,
-  const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  const std::map<std::string, std::map<std::string, std::string>> *config_info, const std::string &model_path) {
 #ifdef SHARING_MODEL_WEIGHT
   std::unique_lock<std::mutex> l(manager_mutex_);
   if (pack_weight_ == nullptr) {
@@ -107,11 +123,87 @@ STATUS PackWeightManager::InitPackWeightManager(
     MS_LOG(INFO) << "model use share pack weight.";
     id = *model_id;
   }
-  return pack_weight_->InitPackWeight(static_cast<const void *>(model_buf), model_size, id, numa_id);
+  auto status = pack_weight_->InitPackWeight(static_cast<const void *>(model_buf), model_size, id, numa_id);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "InitPackWeight failed.";
+    return status;
+  }
+  l.unlock();
+#else
+  if (!ParsePackCacheDir(config_info).empty()) {
+    // the pack weight cache is bound to the model id, which is only generated for shared weight by default
+    std::unique_lock<std::mutex> l(manager_mutex_);
+    *model_id = GenModelID();
+  }
 #endif
+  return InitPackWeightCache(model_buf, model_size, *model_id, config_info, model_path);
+}
+
+STATUS PackWeightManager::InitPackWeightCache(
+  const char *model_buf, size_t model_size, const std::string &id,
+  const std::map<std::string, std::map<std::string, std::string>> *config_info, const std::string &model_path) {
+  auto cache_dir = ParsePackCacheDir(config_info);
+  if (cache_dir.empty()) {
+    return RET_OK;
+  }
+  if (model_buf == nullptr || model_size == 0 || id.empty()) {
+    MS_LOG(WARNING) << "model buf or model id is invalid, pack weight cache is disabled.";
+    return RET_OK;
+  }
+  auto real_dir = RealPath(cache_dir.c_str());
+  if (real_dir.empty()) {
+    MS_LOG(WARNING) << "pack weight cache dir " << cache_dir << " is invalid, pack weight cache is disabled.";
+    return RET_OK;
+  }
+  auto file_path = PackWeightCache::GenCacheFilePath(real_dir, model_buf, model_size, model_path);
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  auto &cache = cache_files_[file_path];
+  if (cache == nullptr) {
+    cache = std::make_shared<PackWeightCache>();
+    if (cache == nullptr || cache->Init(file_path) != RET_OK) {
+      MS_LOG(ERROR) << "init pack weight cache " << file_path << " failed.";
+      (void)cache_files_.erase(file_path);
+      return RET_ERROR;
+    }
+  }
+  pack_caches_[id].cache = cache;
+  return RET_OK;
+}
+
+STATUS PackWeightManager::StorePackCacheTensors(const std::string &id, const std::vector<Tensor *> &all_tensors) {
+  std::unique_lock<std::mutex> l(cache_mutex_);
+  auto it_cache = pack_caches_.find(id);
+  if (it_cache == pack_caches_.end()) {
+    return RET_OK;
+  }
+  auto &origin_tensors = it_cache->second.origin_tensors;
+  origin_tensors.clear();
+  for (size_t i = 0; i < all_tensors.size(); i++) {
+    auto tensor = all_tensors[i];
+    MS_CHECK_TRUE_MSG(tensor != nullptr, RET_ERROR, "tensor is nullptr in pack weight manager.");
+    if (!tensor->IsConst() || tensor->data() == nullptr) {
+      continue;
+    }
+    (void)origin_tensors.emplace(tensor->data(), i);
+  }
   return RET_OK;
 }
 
+STATUS PackWeightManager::FlushPackCache(const std::string &id) {
+  std::shared_ptr<PackWeightCache> cache = nullptr;
+  {
+    std::unique_lock<std::mutex> l(cache_mutex_);
+    auto it_cache = pack_caches_.find(id);
+    if (it_cache == pack_caches_.end()) {
+      return RET_OK;
+    }
+    // origin weights of packed ops are freed after compile, their addresses must not hit the cache any more
+    it_cache->second.origin_tensors.clear();
+    cache = it_cache->second.cache;
+  }
+  return cache->Flush();
+}
+
 char *PackWeightManager::GetSharedModelBuf(const char *model_buf, std::string model_id,
                                            const std::map<std::string, std::map<std::string, std::string>> *config_info,
                                            bool *is_shared) {
@@ -207,7 +299,37 @@ void *PackWeightManager::MallocData(size_t size) {
   return data;
 }
 
-void *PackWeightManager::GetPackData(const void *tensor_data, const size_t size, bool *is_packed) {
+void *PackWeightManager::GetPackData(const void *tensor_data, const size_t size, bool *is_packed,
+                                     const std::string &pack_variant) {
+  std::shared_ptr<PackWeightCache> cache = nullptr;
+  size_t tensor_index = 0;
+  if (!pack_variant.empty()) {
+    std::unique_lock<std::mutex> l(cache_mutex_);
+    for (auto &item : pack_caches_) {
+      auto it_tensor = item.second.origin_tensors.find(tensor_data);
+      if (it_tensor != item.second.origin_tensors.end()) {
+        cache = item.second.cache;
+        tensor_index = it_tensor->second;
+        break;
+      }
+    }
+  }
+  if (cache == nullptr) {
+    return GetPackDataImpl(tensor_data, size, is_packed);
+  }
+  auto data = cache->GetPackData(tensor_index, pack_variant, size);
+  if (data != nullptr) {
+    *is_packed = true;
+    return data;
+  }
+  data = GetPackDataImpl(tensor_data, size, is_packed);
+  if (data != nullptr && !(*is_packed)) {
+    cache->RecordPackData(tensor_index, pack_variant, data, size);
+  }
+  return data;
+}
+
+void *PackWeightManager::GetPackDataImpl(const void *tensor_data, const size_t size, bool *is_packed) {
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     void *data = MallocData(size);
@@ -233,6 +355,15 @@ void PackWeightManager::FreeData(void *tensor_data) {
 }
 
 void PackWeightManager::Free(void *tensor_data) {
+  {
+    std::unique_lock<std::mutex> l(cache_mutex_);
+    for (auto &item : cache_files_) {
+      if (item.second->IsCachedData(tensor_data)) {
+        return;
+      }
+      item.second->ForgetPackData(tensor_data);
+    }
+  }
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     FreeData(tensor_data);
@@ -243,6 +374,17 @@ void PackWeightManager::Free(void *tensor_data) {
 }
 
 void PackWeightManager::FreePackWeight(std::string id) {
+  {
+    std::unique_lock<std::mutex> l(cache_mutex_);
+    (void)pack_caches_.erase(id);
+    for (auto it_file = cache_files_.begin(); it_file != cache_files_.end();) {
+      if (it_file->second.use_count() == 1) {
+        it_file = cache_files_.erase(it_file);
+      } else {
+        it_file++;
+      }
+    }
+  }
 #ifdef SHARING_MODEL_WEIGHT
   std::unique_lock<std::mutex> l(manager_mutex_);
   if (pack_weight_ != nullptr) {
@@ -257,6 +399,12 @@ void PackWeightManager::FreePackWeight(std::string id) {
       runner_ids_.erase(it);
     }
   }
+#else
+  std::unique_lock<std::mutex> l(manager_mutex_);
+  auto it = find(model_ids_.begin(), model_ids_.end(), id);
+  if (it != model_ids_.end()) {
+    model_ids_.erase(it);
+  }
 #endif
   return;
 }
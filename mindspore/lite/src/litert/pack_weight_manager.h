@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
+#include <initializer_list>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -24,31 +25,55 @@
 #include "include/model.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
+#include "src/litert/pack_weight_cache.h"
 #ifdef SHARING_MODEL_WEIGHT
 #include "src/litert/pack_weight.h"
 #endif
 namespace mindspore::lite {
+// tag of a packing layout: the kernel name followed by the tiles and flags the packed layout depends on
+inline std::string PackVariant(const std::string &kernel, std::initializer_list<int> layout) {
+  std::string variant = kernel;
+  for (auto value : layout) {
+    variant += "_" + std::to_string(value);
+  }
+  return variant;
+}
+
 class PackWeightManager {
  public:
   static PackWeightManager *GetInstance();
   ~PackWeightManager() = default;
+  // model_path keys the pack weight cache of the model without reading model_buf, empty if built from a buffer.
   STATUS InitPackWeightManager(const char *model_buf, size_t model_size, std::string *model_id,
-                               const std::map<std::string, std::map<std::string, std::string>> *config_info);
+                               const std::map<std::string, std::map<std::string, std::string>> *config_info,
+                               const std::string &model_path = "");
   char *GetSharedModelBuf(const char *model_buf, std::string model_id,
                           const std::map<std::string, std::map<std::string, std::string>> *config_info,
                           bool *is_shared);
   STATUS StoreOriginTensorData(Model *model, std::vector<Tensor *> *all_tensors);
-  void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed);
+  // pack_variant names the kernel and its packing layout, the data packed without it is not persistently cached.
+  void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed, const std::string &pack_variant = "");
   void Free(void *tensor_data);
   bool IsCopyTensor(int op_type);
   void *ReplaceFp16Data(void *origin_fp16_data, size_t size, bool *replace);
   void FreePackWeight(std::string id);
+  STATUS StorePackCacheTensors(const std::string &id, const std::vector<Tensor *> &all_tensors);
+  STATUS FlushPackCache(const std::string &id);
   std::string GenRunnerID();
   std::string GenModelID();
 
  private:
   void *MallocData(size_t size);
   void FreeData(void *tensor_data);
+  void *GetPackDataImpl(const void *tensor_data, const size_t size, bool *is_packed);
+  STATUS InitPackWeightCache(const char *model_buf, size_t model_size, const std::string &id,
+                             const std::map<std::string, std::map<std::string, std::string>> *config_info,
+                             const std::string &model_path);
+  struct PackCacheInfo {
+    std::shared_ptr<PackWeightCache> cache = nullptr;
+    // origin const tensor data : tensor index in model
+    std::unordered_map<const void *, size_t> origin_tensors;
+  };
   PackWeightManager() = default;
   bool is_parallel_ = false;
 #ifdef SHARING_MODEL_WEIGHT
@@ -59,6 +84,11 @@ class PackWeightManager {
   std::vector<std::string> model_ids_;
   size_t runner_id_ = 1;
   size_t model_id_ = 1;
+  std::mutex cache_mutex_;
+  // runner_id/model_id : persistent pack weight cache of the model
+  std::unordered_map<std::string, PackCacheInfo> pack_caches_;
+  // cache file path : cache shared by the models loaded from the same buf
+  std::unordered_map<std::string, std::shared_ptr<PackWeightCache>> cache_files_;
 };
 }  // namespace mindspore::lite
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
@@ -15,8 +15,16 @@
  */
 
 #include "src/litert/runtime_allocator.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include "src/common/log_adapter.h"
 
 namespace mindspore {
+namespace {
+constexpr size_t kInvalidStep = std::numeric_limits<size_t>::max();
+}  // namespace
+
 RuntimeAllocator::RuntimeAllocator(size_t aligned_size) {
   aligned_size_ = aligned_size;
   return;
@@ -31,11 +39,93 @@ RuntimeAllocator::~RuntimeAllocator() {
 
 void *RuntimeAllocator::MallocOptData() {
   if (data_ == nullptr) {
+    PlanOffsets();
     data_ = malloc(total_size_);
   }
   return data_;
 }
 
+size_t RuntimeAllocator::PackBuffers(const std::vector<size_t> &order, std::vector<size_t> *offsets) const {
+  auto align = [this](size_t size) { return (size + aligned_size_ - 1) / aligned_size_ * aligned_size_; };
+  auto overlap = [](const DataBuffer &a, const DataBuffer &b) {
+    return a.malloc_step < b.free_step && b.malloc_step < a.free_step;
+  };
+  size_t total_size = 0;
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> used_ranges; /* begin, end */
+  for (auto index : order) {
+    auto &buffer = buffers_[index];
+    auto size = align(buffer.size);
+    used_ranges.clear();
+    for (auto placed_index : placed) {
+      if (overlap(buffer, buffers_[placed_index])) {
+        auto begin = offsets->at(placed_index);
+        used_ranges.emplace_back(begin, begin + align(buffers_[placed_index].size));
+      }
+    }
+    std::sort(used_ranges.begin(), used_ranges.end());
+    // best fit: the smallest gap between buffers alive at the same time, otherwise on top of them
+    size_t best_offset = kInvalidStep;
+    size_t best_gap = kInvalidStep;
+    size_t cur_offset = 0;
+    for (auto &range : used_ranges) {
+      if (range.first > cur_offset) {
+        auto gap = range.first - cur_offset;
+        if (gap >= size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = cur_offset;
+        }
+      }
+      cur_offset = std::max(cur_offset, range.second);
+    }
+    if (best_offset == kInvalidStep) {
+      best_offset = cur_offset;
+    }
+    offsets->at(index) = best_offset;
+    total_size = std::max(total_size, best_offset + size);
+    placed.push_back(index);
+  }
+  return total_size;
+}
+
+void RuntimeAllocator::PlanOffsets() {
+  if (buffers_.empty()) {
+    return;
+  }
+  auto life = [this](const DataBuffer &buffer) { return std::min(buffer.free_step, step_) - buffer.malloc_step; };
+  std::vector<std::function<bool(const DataBuffer &, const DataBuffer &)>> orders = {
+    [](const DataBuffer &a, const DataBuffer &b) { return a.size > b.size; },
+    [&life](const DataBuffer &a, const DataBuffer &b) {
+      return life(a) > life(b) || (life(a) == life(b) && a.size > b.size);
+    },
+    [&life](const DataBuffer &a, const DataBuffer &b) { return a.size * life(a) > b.size * life(b); }};
+  std::vector<size_t> best_offsets;
+  size_t best_size = total_size_;
+  for (auto &compare : orders) {
+    std::vector<size_t> order(buffers_.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [this, &compare](size_t a, size_t b) { return compare(buffers_[a], buffers_[b]); });
+    std::vector<size_t> offsets(buffers_.size(), 0);
+    auto size = PackBuffers(order, &offsets);
+    if (size < best_size) {
+      best_size = size;
+      best_offsets.swap(offsets);
+    }
+  }
+  MS_LOG(DEBUG) << "runtime allocator greedy size: " << total_size_ << ", packed size: " << best_size;
+  if (best_offsets.empty()) {
+    return;
+  }
+  for (auto &iter : offset_map_) {
+    auto buffer_iter = tensor_buffers_.find(iter.first);
+    iter.second = buffer_iter == tensor_buffers_.end() ? 0 : best_offsets[buffer_iter->second];
+  }
+  total_size_ = best_size;
+}
+
 size_t RuntimeAllocator::FindMinFree(size_t size) {
   size_t min_size = total_size_ + 1;
   size_t min_addr = total_size_ + 1;
@@ -49,7 +139,12 @@ size_t RuntimeAllocator::FindMinFree(size_t size) {
 }
 
 void RuntimeAllocator::FreeTensorData(lite::Tensor *tensor) {
+  auto buffer_iter = tensor_buffers_.find(tensor);
+  if (buffer_iter != tensor_buffers_.end()) {
+    buffers_[buffer_iter->second].free_step = step_++;
+  }
   size_t offset = offset_map_[tensor];
+  (void)live_buffers_.erase(offset);
   free_list_[offset] = used_list_[offset];
   used_list_.erase(offset);
 
@@ -76,6 +171,11 @@ void RuntimeAllocator::FreeTensorData(lite::Tensor *tensor) {
 
 void RuntimeAllocator::SetDataOffset(lite::Tensor *tensor, size_t offset) {
   offset_map_[tensor] = offset;
+  // the tensor shares the data of the live buffer at this offset
+  auto buffer_iter = live_buffers_.find(offset);
+  if (buffer_iter != live_buffers_.end()) {
+    tensor_buffers_[tensor] = buffer_iter->second;
+  }
   return;
 }
 
@@ -92,10 +192,15 @@ void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
   offset_map_.clear();
   free_list_.clear();
   used_list_.clear();
+  buffers_.clear();
+  tensor_buffers_.clear();
+  live_buffers_.clear();
+  step_ = 0;
 }
 
 void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
-  size_t size = tensor->Size();
+  // a zero size tensor still takes one byte, so that no live tensor shares its offset in the used list
+  size_t size = std::max(tensor->Size(), static_cast<size_t>(1));
   size_t offset = FindMinFree(size);
 
   if (offset > total_size_) {
@@ -119,5 +224,9 @@ void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
 
   used_list_[offset] = size;
   offset_map_[tensor] = offset;
+
+  buffers_.push_back({size, step_++, kInvalidStep});
+  tensor_buffers_[tensor] = buffers_.size() - 1;
+  live_buffers_[offset] = buffers_.size() - 1;
 }
 }  // namespace mindspore
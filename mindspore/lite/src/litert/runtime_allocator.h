@@ -20,11 +20,16 @@
 #include <memory>
 #include <map>
 #include <unordered_map>
+#include <vector>
 #include "include/api/allocator.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
 
 namespace mindspore {
+// Static activation memory of a graph: the session replays the execution order with MallocTensorData/FreeTensorData
+// before the first run, then MallocOptData places all tensors in one arena. The replay records the lifetime of every
+// buffer, and the final offsets are solved by best-fit-decreasing packing over those lifetimes, falling back to the
+// greedy offsets found during the replay when they are smaller.
 class RuntimeAllocator : public Allocator {
  public:
   explicit RuntimeAllocator(size_t aligned_size = 32);
@@ -48,13 +53,25 @@ class RuntimeAllocator : public Allocator {
 
  private:
   size_t FindMinFree(size_t size);
+  void PlanOffsets();
+  size_t PackBuffers(const std::vector<size_t> &order, std::vector<size_t> *offsets) const;
 
  private:
+  struct DataBuffer {
+    size_t size;
+    size_t malloc_step;
+    size_t free_step;
+  };
+
   void *data_ = nullptr;
   size_t total_size_ = 0;
   std::unordered_map<lite::Tensor *, size_t> offset_map_;
   std::map<size_t, size_t> free_list_; /* offset, size */
   std::map<size_t, size_t> used_list_; /* offset, size */
+  std::vector<DataBuffer> buffers_;
+  std::unordered_map<lite::Tensor *, size_t> tensor_buffers_; /* tensor, buffer index */
+  std::map<size_t, size_t> live_buffers_;                     /* greedy offset, buffer index */
+  size_t step_ = 0;
 };
 
 using RuntimeAllocatorPtr = std::shared_ptr<RuntimeAllocator>;
@@ -47,6 +47,7 @@
 #endif
 #include "src/litert/weight_decoder.h"
 #include "src/litert/kernel/cpu/fp16/fp16_op_handler.h"
+#include "src/litert/kernel/cpu/bf16/bf16_kernel_registry.h"
 #include "nnacl/nnacl_common.h"
 #if GPU_OPENCL
 #include "src/litert/kernel/opencl/opencl_subgraph.h"
@@ -1093,6 +1094,34 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
   return ret;
 }
 
+int Scheduler::FindCpuBf16Kernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                                 OpParameter *op_parameter, const kernel::KernelKey &desc,
+                                 kernel::KernelExec **kernel) {
+  MS_CHECK_TRUE_MSG(op_parameter != nullptr, RET_ERROR, "op parameter is nullptr.");
+  if (is_train_session_ || desc.data_type != kNumberTypeFloat32 || !context_->IsCpuBFloat16Enabled()) {
+    return RET_NOT_SUPPORT;
+  }
+  auto bf16_registry = kernel::Bf16KernelRegistry::GetInstance();
+  if (bf16_registry->GetCreator(desc) == nullptr) {
+    return RET_NOT_SUPPORT;
+  }
+  auto ret = WeightDecoder::DequantNode(op_parameter, in_tensors, kNumberTypeFloat32, src_model_->graph_.version_,
+                                        context_->float_mode);
+  if (ret != RET_OK) {
+    MS_LOG(DEBUG) << "Dequant input tensors failed: " << ret;
+    return RET_NOT_SUPPORT;
+  }
+  // the bf16 kernels compute fp32 tensors, the cases a bf16 kernel does not handle stay on the fp32 kernel
+  if (!bf16_registry->Support(desc, in_tensors, out_tensors, op_parameter)) {
+    return RET_NOT_SUPPORT;
+  }
+  ret = bf16_registry->GetKernelExec(in_tensors, out_tensors, context_, ms_context_, desc, op_parameter, kernel);
+  if (ret == RET_OK) {
+    MS_LOG(DEBUG) << "Get bf16 compute op success: " << PrimitiveCurVersionTypeName(op_parameter->type_);
+  }
+  return ret;
+}
+
 #ifdef GPU_OPENCL
 int Scheduler::FindGpuKernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
                              OpParameter *op_parameter, const kernel::KernelKey &desc, kernel::KernelExec **kernel,
@@ -1280,6 +1309,14 @@ kernel::KernelExec *Scheduler::FindBackendKernel(const std::vector<Tensor *> &in
     MS_LOG(DEBUG) << "Get fp16 op failed, back to fp32 op.";
     desc.data_type = kNumberTypeFloat32;
   }
+  status = FindCpuBf16Kernel(in_tensors, out_tensors, op_parameter, desc, &kernel);
+  if (status == RET_OK) {
+    return kernel;
+  } else if (status == RET_ERROR) {
+    MS_LOG(ERROR) << "Create bf16 kernel failed: " << node->name_;
+    op_parameters_.erase(node->output_indices_.at(0));
+    return nullptr;
+  }
   status = FindCpuKernel(in_tensors, out_tensors, op_parameter, desc, kNumberTypeFloat32, &kernel);
   if (status == RET_OK) {
     return kernel;
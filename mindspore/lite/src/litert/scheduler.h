@@ -80,6 +80,8 @@ class Scheduler {
   int FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
                     OpParameter *op_parameter, const kernel::KernelKey &desc, TypeId kernel_data_type,
                     kernel::KernelExec **kernel);
+  int FindCpuBf16Kernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                        OpParameter *op_parameter, const kernel::KernelKey &desc, kernel::KernelExec **kernel);
   int CheckCpuValid(const std::vector<kernel::KernelExec *> *dst_kernels) const;
   void ResetByExecutionPlan(std::string node_name, TypeId *data_type);
 
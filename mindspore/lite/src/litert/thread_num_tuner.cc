@@ -0,0 +1,269 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/thread_num_tuner.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <utility>
+#include "src/litert/lite_kernel.h"
+#include "src/litert/sub_graph_kernel.h"
+#include "src/common/utils.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr uint64_t kInvalidCost = std::numeric_limits<uint64_t>::max();
+
+// the first "model name"(x86) or "Hardware"/"CPU part"(arm) of /proc/cpuinfo, with the core num
+std::string GetCpuModel() {
+  std::string cpu_model;
+#ifndef _WIN32
+  std::ifstream infile("/proc/cpuinfo", std::ios::in);
+  std::string line;
+  while (cpu_model.empty() && getline(infile, line)) {
+    if (line.find("model name") == 0 || line.find("Hardware") == 0 || line.find("CPU part") == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 1 < line.size()) {
+        cpu_model = line.substr(pos + 1);
+      }
+    }
+  }
+  infile.close();
+#endif
+  if (cpu_model.empty()) {
+    cpu_model = "unknown";
+  }
+  cpu_model += "_c" + std::to_string(GetCoreNum());
+  // the profile is a text file of "key thread_num" lines
+  std::replace_if(
+    cpu_model.begin(), cpu_model.end(), [](char c) { return !isalnum(static_cast<unsigned char>(c)); }, '_');
+  return cpu_model;
+}
+
+void CollectNodes(const std::vector<kernel::KernelExec *> &kernels, std::vector<kernel::KernelExec *> *nodes) {
+  for (auto kernel : kernels) {
+    if (kernel == nullptr || kernel->desc().arch == kernel::kDelegate) {
+      continue;
+    }
+    if (kernel->subgraph_type() == kernel::kNotSubGraph) {
+      nodes->push_back(kernel);
+    } else {
+      CollectNodes(reinterpret_cast<kernel::SubGraphKernel *>(kernel)->nodes(), nodes);
+    }
+  }
+}
+}  // namespace
+
+ThreadNumTuner::ThreadNumTuner(int max_thread_num, const std::string &profile_path, int tune_loops)
+    : max_thread_num_(MSMAX(max_thread_num, 1)), profile_path_(profile_path), tune_loops_(MSMAX(tune_loops, 1)) {
+  for (int thread_num = 1; thread_num < max_thread_num_; thread_num *= C2NUM) {
+    candidates_.push_back(thread_num);
+  }
+  candidates_.push_back(max_thread_num_);
+  cpu_model_ = GetCpuModel();
+  LoadProfile();
+}
+
+std::string ThreadNumTuner::GenTuneKey(const kernel::KernelExec *kernel) const {
+  std::stringstream key;
+  key << schema::EnumNamePrimitiveType(kernel->type()) << "_" << kernel->desc().data_type;
+  for (auto tensor : kernel->in_tensors()) {
+    key << "_";
+    auto shape = tensor->shape();
+    for (size_t i = 0; i < shape.size(); i++) {
+      key << (i == 0 ? "" : "x") << shape[i];
+    }
+  }
+  key << "_" << cpu_model_ << "_t" << max_thread_num_;
+  return key.str();
+}
+
+int ThreadNumTuner::SetThreadNum(kernel::KernelExec *kernel, int thread_num) const {
+  auto lite_kernel = static_cast<kernel::LiteKernel *>(kernel->kernel());
+  auto cur_thread_num = lite_kernel->tuned_thread_num();
+  // an untuned kernel is bounded by the context thread num, the same as the max candidate. Under
+  // DYNAMIC_THREAD_DISTRIBUTE the cost model still picks the thread num within the bound, so a candidate is an upper
+  // bound there rather than the exact thread num.
+  if (cur_thread_num == thread_num || (cur_thread_num == 0 && thread_num == max_thread_num_)) {
+    return RET_OK;
+  }
+  lite_kernel->set_tuned_thread_num(thread_num);
+  // kernels split their work by the thread num in ReSize
+  auto ret = kernel->ReSize();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "ReSize " << kernel->name() << " with thread num " << thread_num << " failed.";
+  }
+  return ret;
+}
+
+int ThreadNumTuner::Init(const std::vector<kernel::KernelExec *> &kernels) {
+  tune_nodes_.clear();
+  candidate_index_ = 0;
+  loop_index_ = 0;
+  std::vector<kernel::KernelExec *> nodes;
+  CollectNodes(kernels, &nodes);
+  for (auto node : nodes) {
+    if (node->desc().arch != kernel::kCPU || !node->IsBuiltin() ||
+        !static_cast<kernel::LiteKernel *>(node->kernel())->thread_num_tunable()) {
+      continue;
+    }
+    auto key = GenTuneKey(node);
+    auto iter = profile_.find(key);
+    auto thread_num = iter == profile_.end() ? max_thread_num_ : MSMIN(iter->second, max_thread_num_);
+    if (SetThreadNum(node, thread_num) != RET_OK) {
+      return RET_ERROR;
+    }
+    if (iter != profile_.end() || tune_nodes_.find(node->name()) != tune_nodes_.end()) {
+      continue;
+    }
+    TuneNode tune_node;
+    tune_node.kernel = node;
+    tune_node.key = key;
+    tune_node.costs.resize(candidates_.size(), kInvalidCost);
+    tune_nodes_[node->name()] = tune_node;
+  }
+  MS_LOG(INFO) << tune_nodes_.size() << " kernels will tune thread num in " << candidates_.size() * tune_loops_
+               << " warmup runs.";
+  return RET_OK;
+}
+
+int ThreadNumTuner::BeginRun(const KernelCallBack &before, const KernelCallBack &after, KernelCallBack *tune_before,
+                             KernelCallBack *tune_after) {
+  MS_CHECK_TRUE_MSG(tune_before != nullptr && tune_after != nullptr, RET_ERROR, "tune callback is nullptr.");
+  for (auto &item : tune_nodes_) {
+    if (SetThreadNum(item.second.kernel, candidates_[candidate_index_]) != RET_OK) {
+      return RET_ERROR;
+    }
+  }
+  *tune_before = [this, before](std::vector<lite::Tensor *> inputs, std::vector<lite::Tensor *> outputs,
+                                const MSCallBackParam &call_param) {
+    auto ret = before == nullptr ? true : before(inputs, outputs, call_param);
+    std::unique_lock<std::mutex> l(time_mutex_);
+    auto iter = tune_nodes_.find(call_param.node_name);
+    if (iter != tune_nodes_.end()) {
+      iter->second.start_time = GetTimeUs();
+    }
+    return ret;
+  };
+  *tune_after = [this, after](std::vector<lite::Tensor *> inputs, std::vector<lite::Tensor *> outputs,
+                              const MSCallBackParam &call_param) {
+    auto end_time = GetTimeUs();
+    {
+      std::unique_lock<std::mutex> l(time_mutex_);
+      auto iter = tune_nodes_.find(call_param.node_name);
+      if (iter != tune_nodes_.end() && iter->second.start_time != 0) {
+        auto &cost = iter->second.costs[candidate_index_];
+        cost = MSMIN(cost, end_time - iter->second.start_time);
+        iter->second.start_time = 0;
+      }
+    }
+    return after == nullptr ? true : after(inputs, outputs, call_param);
+  };
+  return RET_OK;
+}
+
+int ThreadNumTuner::EndRun(bool run_success) {
+  if (!run_success) {
+    MS_LOG(WARNING) << "graph run failed, stop tuning thread num.";
+    for (auto &item : tune_nodes_) {
+      (void)SetThreadNum(item.second.kernel, max_thread_num_);
+    }
+    tune_nodes_.clear();
+    return RET_OK;
+  }
+  if (++loop_index_ < tune_loops_) {
+    return RET_OK;
+  }
+  loop_index_ = 0;
+  if (++candidate_index_ < candidates_.size()) {
+    return RET_OK;
+  }
+  return FinishTune();
+}
+
+int ThreadNumTuner::FinishTune() {
+  for (auto &item : tune_nodes_) {
+    auto &costs = item.second.costs;
+    auto best = std::min_element(costs.begin(), costs.end());
+    // kernels skipped by control flow keep the default thread num and are not profiled
+    if (*best == kInvalidCost) {
+      (void)SetThreadNum(item.second.kernel, max_thread_num_);
+      continue;
+    }
+    auto thread_num = candidates_[best - costs.begin()];
+    MS_LOG(DEBUG) << "kernel " << item.first << " tuned thread num: " << thread_num << ", cost: " << *best << "us";
+    profile_[item.second.key] = thread_num;
+    if (SetThreadNum(item.second.kernel, thread_num) != RET_OK) {
+      return RET_ERROR;
+    }
+  }
+  tune_nodes_.clear();
+  candidate_index_ = 0;
+  return SaveProfile();
+}
+
+void ThreadNumTuner::LoadProfile() {
+  if (profile_path_.empty()) {
+    return;
+  }
+  std::ifstream infile(profile_path_, std::ios::in);
+  if (!infile.is_open()) {
+    MS_LOG(INFO) << "thread num profile " << profile_path_ << " not found, it will be created after tuning.";
+    return;
+  }
+  std::string key;
+  int thread_num = 0;
+  while (infile >> key >> thread_num) {
+    if (thread_num > 0) {
+      profile_[key] = thread_num;
+    }
+  }
+  infile.close();
+}
+
+int ThreadNumTuner::SaveProfile() {
+  if (profile_path_.empty()) {
+    return RET_OK;
+  }
+  // keep the entries other processes saved meanwhile, the ones tuned here win
+  auto tuned = std::move(profile_);
+  profile_.clear();
+  LoadProfile();
+  for (auto &item : tuned) {
+    profile_[item.first] = item.second;
+  }
+  auto tmp_path = profile_path_ + ".tmp";
+  std::ofstream outfile(tmp_path, std::ios::out | std::ios::trunc);
+  if (!outfile.is_open()) {
+    MS_LOG(WARNING) << "open thread num profile " << tmp_path << " failed.";
+    return RET_OK;
+  }
+  for (auto &item : profile_) {
+    outfile << item.first << " " << item.second << "\n";
+  }
+  outfile.close();
+  if (!outfile.good() || std::rename(tmp_path.c_str(), profile_path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "save thread num profile " << profile_path_ << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return RET_OK;
+  }
+  MS_LOG(INFO) << "save thread num profile " << profile_path_ << " with " << profile_.size() << " kernels.";
+  return RET_OK;
+}
+}  // namespace mindspore::lite
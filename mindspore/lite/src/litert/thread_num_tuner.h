@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "src/litert/kernel_exec.h"
+
+namespace mindspore::lite {
+// Online thread num tuning of cpu kernels. The first graph runs are used as warmup: every tunable kernel runs
+// `tune_loops` times with each candidate thread num and keeps the fastest one. The choices are saved to the profile
+// file per (op, input shapes, cpu model), and a later load applies the profiled thread num without tuning again.
+class ThreadNumTuner {
+ public:
+  ThreadNumTuner(int max_thread_num, const std::string &profile_path, int tune_loops);
+  ~ThreadNumTuner() = default;
+
+  // collect the tunable kernels of the graph and apply the profiled thread nums, called again after resize.
+  int Init(const std::vector<kernel::KernelExec *> &kernels);
+  bool IsTuning() const { return !tune_nodes_.empty(); }
+  // set the candidate thread num of this run and wrap the callbacks to time every tuned kernel.
+  int BeginRun(const KernelCallBack &before, const KernelCallBack &after, KernelCallBack *tune_before,
+               KernelCallBack *tune_after);
+  int EndRun(bool run_success);
+
+ private:
+  struct TuneNode {
+    kernel::KernelExec *kernel = nullptr;
+    std::string key;
+    // min cost of each candidate in us
+    std::vector<uint64_t> costs;
+    uint64_t start_time = 0;
+  };
+  std::string GenTuneKey(const kernel::KernelExec *kernel) const;
+  int SetThreadNum(kernel::KernelExec *kernel, int thread_num) const;
+  int FinishTune();
+  void LoadProfile();
+  int SaveProfile();
+
+  int max_thread_num_ = 1;
+  std::string profile_path_;
+  int tune_loops_ = 1;
+  std::string cpu_model_;
+  std::vector<int> candidates_;
+  // tune key : best thread num
+  std::map<std::string, int> profile_;
+  // kernel name : kernel under tuning
+  std::unordered_map<std::string, TuneNode> tune_nodes_;
+  size_t candidate_index_ = 0;
+  int loop_index_ = 0;
+  std::mutex time_mutex_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
@@ -169,6 +169,11 @@ else
   fi
 fi
 
+if [ -e mobilenetv2.ms ]; then
+  echo 'run mmap model load ut test'
+  ./lite-test --gtest_filter="ModelMmapLoadTest.*"
+fi
+
 if [ "$MSLITE_ENABLE_SERVER_INFERENCE" = on ];then
   echo 'run ModelParallelRunner api ut test'
   ./lite-test --gtest_filter="ModelParallelRunnerTest.*"
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/matmul_avx512_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+
+namespace mindspore {
+namespace {
+struct Int8MatmulCase {
+  size_t row;
+  size_t col;
+  size_t deep;
+  bool per_channel;
+};
+
+// The kernels only read the packed buffers, so random packed data covers every layout position including the padding.
+struct Int8MatmulData {
+  Int8MatmulData(const Int8MatmulCase &test_case, size_t row_tile, size_t col_tile, size_t sum_size) {
+    std::mt19937 gen(static_cast<unsigned int>(test_case.row * 1000003 + test_case.col * 1009 + test_case.deep));
+    std::uniform_int_distribution<int> int8_dist(INT8_MIN, INT8_MAX);
+    std::uniform_int_distribution<int32_t> sum_dist(-100000, 100000);
+    std::uniform_int_distribution<int32_t> multiplier_dist(1 << 30, INT32_MAX);
+    std::uniform_int_distribution<int32_t> left_dist(0, 1);
+    std::uniform_int_distribution<int32_t> right_dist(-14, -8);
+    size_t deep_4 = UP_ROUND(test_case.deep, C4NUM);
+    size_t col_align = UP_ROUND(test_case.col, col_tile);
+    size_t channel = test_case.per_channel ? col_align : 1;
+    a.resize(UP_ROUND(test_case.row, row_tile) * deep_4);
+    b.resize(col_align * deep_4);
+    for (auto &value : a) {
+      value = static_cast<int8_t>(int8_dist(gen));
+    }
+    for (auto &value : b) {
+      value = static_cast<int8_t>(int8_dist(gen));
+    }
+    input_sum.resize(sum_size);
+    for (auto &value : input_sum) {
+      value = sum_dist(gen);
+    }
+    bias.resize(col_align);
+    filter_zp.resize(channel);
+    left_shift.resize(channel);
+    right_shift.resize(channel);
+    multiplier.resize(channel);
+    for (size_t c = 0; c < col_align; c++) {
+      bias[c] = sum_dist(gen);
+    }
+    for (size_t c = 0; c < channel; c++) {
+      filter_zp[c] = int8_dist(gen);
+      left_shift[c] = left_dist(gen);
+      right_shift[c] = right_dist(gen);
+      multiplier[c] = multiplier_dist(gen);
+    }
+  }
+
+  std::vector<int8_t> a;
+  std::vector<int8_t> b;
+  std::vector<int32_t> input_sum;
+  std::vector<int32_t> bias;
+  std::vector<int32_t> filter_zp;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> multiplier;
+};
+
+// row, col and deep tails of the 4x16, 8x8 and AMX 16x64 blocks, plus the small shapes below the AMX threshold
+const std::vector<Int8MatmulCase> kCases = {
+  {1, 1, 4, false},    {3, 7, 5, true},      {4, 16, 64, false},   {5, 17, 67, true},   {13, 33, 100, false},
+  {16, 64, 64, true},  {17, 65, 129, false}, {31, 79, 255, true},  {32, 128, 256, true}, {45, 200, 300, false},
+  {64, 19, 1000, true}};
+constexpr int32_t kOutputZp = 3;
+constexpr int32_t kActMin = -100;
+constexpr int32_t kActMax = 110;
+}  // namespace
+
+class TestMatmulAvx512Int8 : public mindspore::CommonTest {
+ public:
+  TestMatmulAvx512Int8() {}
+
+  void SetUp() override { (void)IntelX86CpuInfoInit(); }
+};
+
+TEST_F(TestMatmulAvx512Int8, Vnni4x16MatchesReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  for (const auto &test_case : kCases) {
+    Int8MatmulData data(test_case, C4NUM, C16NUM, UP_ROUND(test_case.row, C4NUM));
+    size_t deep_4 = UP_ROUND(test_case.deep, C4NUM);
+    size_t stride = test_case.col + 3;
+    std::vector<int8_t> expect(test_case.row * stride, 0);
+    std::vector<int8_t> output(test_case.row * stride, 0);
+    MatMulInt8_4x16_r(data.a.data(), data.b.data(), expect.data(), test_case.row, test_case.col, deep_4, stride,
+                      data.input_sum.data(), data.bias.data(), data.left_shift.data(), data.right_shift.data(),
+                      data.multiplier.data(), kOutputZp, kActMin, kActMax, test_case.per_channel,
+                      data.filter_zp.data());
+    MatMulInt8Avx512Vnni_4x16_r(data.a.data(), data.b.data(), output.data(), test_case.row, test_case.col, deep_4,
+                                stride, data.input_sum.data(), data.bias.data(), data.left_shift.data(),
+                                data.right_shift.data(), data.multiplier.data(), kOutputZp, kActMin, kActMax,
+                                test_case.per_channel, data.filter_zp.data());
+    ASSERT_EQ(expect, output) << "row " << test_case.row << " col " << test_case.col << " deep " << test_case.deep;
+  }
+}
+
+TEST_F(TestMatmulAvx512Int8, Vnni8x8MatchesReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  for (const auto &test_case : kCases) {
+    // the per-channel input sums are stored in row8 x 8 blocks of the output channels
+    size_t sum_size = test_case.per_channel ? UP_ROUND(test_case.row, C8NUM) * UP_ROUND(test_case.col, C8NUM)
+                                            : UP_ROUND(test_case.row, C8NUM);
+    Int8MatmulData data(test_case, C8NUM, C8NUM, sum_size);
+    size_t deep_4 = UP_ROUND(test_case.deep, C4NUM);
+    size_t stride = test_case.col + 3;
+    std::vector<int8_t> expect(test_case.row * stride, 0);
+    std::vector<int8_t> output(test_case.row * stride, 0);
+    MatMulInt8_8x8_r(data.a.data(), data.b.data(), expect.data(), test_case.row, test_case.col, deep_4, stride,
+                     data.input_sum.data(), data.bias.data(), data.left_shift.data(), data.right_shift.data(),
+                     data.multiplier.data(), kOutputZp, kActMin, kActMax, test_case.per_channel);
+    MatMulInt8Avx512Vnni_8x8_r(data.a.data(), data.b.data(), output.data(), test_case.row, test_case.col, deep_4,
+                               stride, data.input_sum.data(), data.bias.data(), data.left_shift.data(),
+                               data.right_shift.data(), data.multiplier.data(), kOutputZp, kActMin, kActMax,
+                               test_case.per_channel);
+    ASSERT_EQ(expect, output) << "row " << test_case.row << " col " << test_case.col << " deep " << test_case.deep;
+  }
+}
+
+TEST_F(TestMatmulAvx512Int8, Amx4x16MatchesReference) {
+  if (!X86_Amx_Support()) {
+    return;
+  }
+  for (const auto &test_case : kCases) {
+    Int8MatmulData data(test_case, C4NUM, C16NUM, UP_ROUND(test_case.row, C4NUM));
+    size_t deep_4 = UP_ROUND(test_case.deep, C4NUM);
+    size_t stride = test_case.col + 3;
+    std::vector<int8_t> expect(test_case.row * stride, 0);
+    std::vector<int8_t> output(test_case.row * stride, 0);
+    std::vector<int8_t> buffer(MatMulInt8AmxBufferSize(test_case.row, deep_4));
+    MatMulInt8_4x16_r(data.a.data(), data.b.data(), expect.data(), test_case.row, test_case.col, deep_4, stride,
+                      data.input_sum.data(), data.bias.data(), data.left_shift.data(), data.right_shift.data(),
+                      data.multiplier.data(), kOutputZp, kActMin, kActMax, test_case.per_channel,
+                      data.filter_zp.data());
+    MatMulInt8Amx_4x16_r(data.a.data(), data.b.data(), output.data(), test_case.row, test_case.col, deep_4, stride,
+                         data.input_sum.data(), data.bias.data(), data.left_shift.data(), data.right_shift.data(),
+                         data.multiplier.data(), kOutputZp, kActMin, kActMax, test_case.per_channel,
+                         data.filter_zp.data(), buffer.empty() ? nullptr : buffer.data());
+    ASSERT_EQ(expect, output) << "row " << test_case.row << " col " << test_case.col << " deep " << test_case.deep;
+  }
+}
+
+TEST_F(TestMatmulAvx512Int8, AmxBufferSize) {
+  constexpr size_t kTileBytes = C16NUM * C64NUM;
+  if (!X86_Amx_Support()) {
+    ASSERT_EQ(MatMulInt8AmxBufferSize(64, 256), 0u);
+    return;
+  }
+  ASSERT_EQ(MatMulInt8AmxBufferSize(15, 256), 0u);
+  ASSERT_EQ(MatMulInt8AmxBufferSize(16, 60), 0u);
+  ASSERT_EQ(MatMulInt8AmxBufferSize(16, 64), kTileBytes);
+  ASSERT_EQ(MatMulInt8AmxBufferSize(100, 68), kTileBytes * 2);
+}
+}  // namespace mindspore
+#endif
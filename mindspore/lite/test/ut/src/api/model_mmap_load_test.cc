@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/api/context.h"
+#include "include/api/model.h"
+#include "src/common/common.h"
+#include "src/common/file_utils.h"
+
+namespace mindspore {
+namespace {
+const char in_data_path[] = "./mobilenetv2.ms.bin";
+const char model_path[] = "./mobilenetv2.ms";
+constexpr int32_t kNumThreads = 2;
+
+// build the model from its file, mapped or read into the heap, and predict the test input
+void BuildAndPredict(bool enable_mmap, std::vector<std::vector<char>> *outputs_data) {
+  auto context = std::make_shared<Context>();
+  ASSERT_NE(context, nullptr);
+  context->SetThreadNum(kNumThreads);
+  context->MutableDeviceInfo().push_back(std::make_shared<CPUDeviceInfo>());
+
+  Model model;
+  if (enable_mmap) {
+    ASSERT_EQ(model.UpdateConfig(lite::kModelLoad, {lite::kModelLoadMmap, "true"}), kSuccess);
+  }
+  ASSERT_EQ(model.Build(model_path, ModelType::kMindIR, context), kSuccess);
+  auto inputs = model.GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  size_t size = 0;
+  auto bin_buf = lite::ReadFile(in_data_path, &size);
+  ASSERT_NE(bin_buf, nullptr);
+  ASSERT_EQ(size, inputs.front().DataSize());
+  memcpy(inputs.front().MutableData(), bin_buf, size);
+  delete[] bin_buf;
+
+  std::vector<MSTensor> outputs;
+  ASSERT_EQ(model.Predict(inputs, &outputs), kSuccess);
+  ASSERT_FALSE(outputs.empty());
+  // the output tensors are released with the model
+  outputs_data->clear();
+  for (auto &output : outputs) {
+    auto data = static_cast<const char *>(output.Data().get());
+    ASSERT_NE(data, nullptr);
+    outputs_data->emplace_back(data, data + output.DataSize());
+  }
+}
+}  // namespace
+
+class ModelMmapLoadTest : public mindspore::CommonTest {
+ public:
+  ModelMmapLoadTest() = default;
+};
+
+TEST_F(ModelMmapLoadTest, OutputSameAsHeapLoad) {
+  std::vector<std::vector<char>> expect_outputs;
+  ASSERT_NO_FATAL_FAILURE(BuildAndPredict(false, &expect_outputs));
+  std::vector<std::vector<char>> outputs;
+  ASSERT_NO_FATAL_FAILURE(BuildAndPredict(true, &outputs));
+  ASSERT_EQ(outputs.size(), expect_outputs.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    ASSERT_EQ(outputs[i], expect_outputs[i]);
+  }
+}
+}  // namespace mindspore
@@ -15,6 +15,9 @@
  */
 #include "include/api/model_parallel_runner.h"
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include "common/common_test.h"
 #include "src/common/file_utils.h"
 
@@ -193,6 +196,74 @@ TEST_F(ModelParallelRunnerTest, RunnerPredict) {
   }
 }
 
+TEST_F(ModelParallelRunnerTest, RunnerPredictWithDynamicBatch) {
+  auto config = std::make_shared<RunnerConfig>();
+  ASSERT_NE(nullptr, config);
+  auto context = std::make_shared<Context>();
+  ASSERT_NE(nullptr, context);
+  auto &device_list = context->MutableDeviceInfo();
+  auto device_info = std::make_shared<mindspore::CPUDeviceInfo>();
+  ASSERT_NE(nullptr, device_info);
+  device_list.push_back(device_info);
+  config->SetContext(context);
+  config->SetWorkersNum(1);
+  // the worker waits long enough for the concurrent requests to queue up behind the first one
+  config->SetConfigInfo("dynamic_batch",
+                        {{"enable", "true"}, {"max_batch_size", "4"}, {"batch_timeout_us", "200000"}});
+  ModelParallelRunner runner;
+  auto status = runner.Init(model_path, config);
+  ASSERT_EQ(status, kSuccess);
+
+  // every request has its own input, so a batched output split back to the wrong request is found
+  constexpr int kRequestNum = 8;
+  std::vector<std::vector<MSTensor>> request_inputs(kRequestNum);
+  for (int i = 0; i < kRequestNum; i++) {
+    request_inputs[i] = runner.GetInputs();
+    SetInputTensorData(&request_inputs[i]);
+    auto data = static_cast<float *>(request_inputs[i].front().MutableData());
+    for (size_t j = 0; j < kInputDataSize / sizeof(float); j++) {
+      data[j] *= 1.0f + 0.1f * i;
+    }
+  }
+  // the sequential requests go to the idle worker directly and are not batched
+  std::vector<std::vector<MSTensor>> expect_outputs(kRequestNum);
+  for (int i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(runner.Predict(request_inputs[i], &expect_outputs[i]), kSuccess);
+    ASSERT_EQ(expect_outputs[i].size(), 1);
+  }
+  auto stats = config->GetBatchingStats();
+  ASSERT_EQ(stats.at("batched_runs"), "0");
+
+  std::vector<std::thread> requests;
+  std::vector<Status> request_status(kRequestNum, kSuccess);
+  std::vector<std::vector<MSTensor>> request_outputs(kRequestNum);
+  for (int i = 0; i < kRequestNum; i++) {
+    requests.emplace_back([&, i]() { request_status[i] = runner.Predict(request_inputs[i], &request_outputs[i]); });
+  }
+  for (auto &request : requests) {
+    request.join();
+  }
+  for (int i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(request_status[i], kSuccess);
+    ASSERT_EQ(request_outputs[i].size(), 1);
+    ASSERT_EQ(request_outputs[i].front().DataSize(), kOutputDataSize);
+    ASSERT_EQ(0, CompareOutputData(static_cast<const float *>(request_outputs[i].front().Data().get()),
+                                   static_cast<const float *>(expect_outputs[i].front().Data().get()),
+                                   static_cast<int>(kOutputDataSize / sizeof(float)), 1e-4));
+  }
+  stats = config->GetBatchingStats();
+  ASSERT_GT(std::stoll(stats.at("batched_runs")), 0);
+  ASSERT_GE(std::stoll(stats.at("batched_requests")), 2);
+  ASSERT_EQ(stats.at("fallback_requests"), "0");
+  for (auto &inputs : request_inputs) {
+    for (auto &tensor : inputs) {
+      char *data = static_cast<char *>(tensor.MutableData());
+      delete[] data;
+      tensor.SetData(nullptr);
+    }
+  }
+}
+
 TEST_F(ModelParallelRunnerTest, RunnerInitByBuf) {
   auto config = std::make_shared<RunnerConfig>();
   ASSERT_NE(nullptr, config);
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "thread/threadpool.h"
+
+// The launch latency distribution of the static split and the work stealing thread pools on skewed slices.
+// Built by the target lite-threadpool-benchmark, not run with the tests.
+namespace mindspore {
+namespace {
+constexpr size_t kThreadNum = 4;
+constexpr int kTaskNum = 32;
+constexpr int kLaunchLoop = 2000;
+constexpr int kHeavyTaskRatio = 8;
+constexpr int kLightWork = 2000;
+constexpr int kHeavyWork = 40000;
+constexpr double kP50 = 0.5;
+constexpr double kP99 = 0.99;
+
+struct SkewedWork {
+  std::vector<std::atomic_int> hits = std::vector<std::atomic_int>(kTaskNum);
+  int heavy_task = 0;
+};
+
+// every launch one slice is much heavier than the others, which is what imbalanced kernel slices look like
+int SkewedRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto work = reinterpret_cast<SkewedWork *>(cdata);
+  work->hits[task_id]++;
+  int loop = (task_id % kHeavyTaskRatio == work->heavy_task) ? kHeavyWork : kLightWork;
+  volatile int sum = 0;
+  for (int i = 0; i < loop; ++i) {
+    sum = sum + i;
+  }
+  return 0;
+}
+
+// the sorted costs of the launches in microseconds, empty if any launch fails or misses a task
+std::vector<double> RunSkewedLaunch(ThreadPool *pool) {
+  std::vector<double> costs;
+  SkewedWork work;
+  for (int loop = 0; loop < kLaunchLoop; ++loop) {
+    for (auto &hit : work.hits) {
+      hit = 0;
+    }
+    work.heavy_task = loop % kHeavyTaskRatio;
+    auto start = std::chrono::steady_clock::now();
+    if (pool->ParallelLaunch(SkewedRun, &work, kTaskNum) != THREAD_OK) {
+      return {};
+    }
+    auto end = std::chrono::steady_clock::now();
+    costs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    if (std::any_of(work.hits.begin(), work.hits.end(), [](const std::atomic_int &hit) { return hit != 1; })) {
+      return {};
+    }
+  }
+  std::sort(costs.begin(), costs.end());
+  return costs;
+}
+
+int RunBenchmark() {
+  for (auto mode : {kStaticSplit, kWorkStealing}) {
+    auto name = (mode == kWorkStealing ? "WorkStealing" : "StaticSplit");
+    auto pool = ThreadPool::CreateThreadPool(kThreadNum, {}, mode);
+    if (pool == nullptr) {
+      std::cerr << "Failed to create the " << name << " thread pool." << std::endl;
+      return 1;
+    }
+    pool->SetMaxSpinCount(kDefaultSpinCount);
+    pool->SetSpinCountMaxValue();
+    auto costs = RunSkewedLaunch(pool);
+    delete pool;
+    if (costs.empty()) {
+      std::cerr << "The launches of the " << name << " thread pool failed." << std::endl;
+      return 1;
+    }
+    auto p50 = costs[static_cast<size_t>(costs.size() * kP50)];
+    auto p99 = costs[static_cast<size_t>(costs.size() * kP99)];
+    std::cout << name << ": p50 = " << p50 << " us, p99 = " << p99 << " us, max = " << costs.back() << " us"
+              << std::endl;
+  }
+  return 0;
+}
+}  // namespace
+}  // namespace mindspore
+
+int main() { return mindspore::RunBenchmark(); }
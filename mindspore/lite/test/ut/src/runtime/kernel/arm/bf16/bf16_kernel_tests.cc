@@ -0,0 +1,257 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/softmax_parameter.h"
+#include "nnacl/layer_norm_parameter.h"
+#include "src/litert/kernel_registry.h"
+#include "src/litert/kernel/cpu/bf16/bf16_kernel_registry.h"
+
+namespace mindspore {
+namespace {
+// a bf16 operand keeps 8 significant bits, so rounding both operands of a product moves it by less than 2^-8
+constexpr float kBf16Tolerance = 1.0f / 128;
+
+std::vector<float> RandomData(size_t size, float low, float high, uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> distribution(low, high);
+  std::vector<float> data(size);
+  for (auto &value : data) {
+    value = distribution(generator);
+  }
+  return data;
+}
+
+bool IsBf16Value(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0xffffu) == 0;
+}
+
+template <typename T>
+T *NewParameter(int type) {
+  auto param = reinterpret_cast<T *>(malloc(sizeof(T)));
+  if (param != nullptr) {
+    memset(param, 0, sizeof(T));
+    reinterpret_cast<OpParameter *>(param)->type_ = type;
+  }
+  return param;
+}
+}  // namespace
+
+class TestBf16Kernel : public mindspore::CommonTest {
+ public:
+  TestBf16Kernel() {}
+
+  void SetUp() override {
+    ctx_ = std::make_shared<lite::InnerContext>();
+    ctx_->thread_num_ = 2;
+    ASSERT_EQ(ctx_->Init(), lite::RET_OK);
+  }
+
+  // runs the kernel the registry holds for the op and returns its output, the parameter is owned by the kernel
+  std::vector<float> RunKernel(lite::KernelRegistry *registry, const std::vector<lite::Tensor *> &inputs,
+                               lite::Tensor *output, OpParameter *parameter) {
+    parameter->thread_num_ = ctx_->thread_num_;
+    kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, parameter->type_};
+    auto creator = registry->GetCreator(desc);
+    EXPECT_NE(creator, nullptr);
+    if (creator == nullptr) {
+      free(parameter);
+      return {};
+    }
+    std::vector<lite::Tensor *> outputs = {output};
+    auto kernel = creator(inputs, outputs, parameter, ctx_.get(), desc);
+    EXPECT_NE(kernel, nullptr);
+    if (kernel == nullptr) {
+      return {};
+    }
+    EXPECT_EQ(kernel->Prepare(), lite::RET_OK);
+    EXPECT_EQ(kernel->Run(), lite::RET_OK);
+    delete kernel;
+    auto data = reinterpret_cast<float *>(output->data());
+    return std::vector<float>(data, data + output->ElementsNum());
+  }
+
+  void TestMatmul(int op_type, int batch, int row, int deep, int col, bool b_transpose, bool has_bias) {
+    auto a = RandomData(batch * row * deep, -1.0f, 1.0f, 1);
+    auto b = RandomData(deep * col, -1.0f, 1.0f, 2);
+    auto bias = RandomData(col, -1.0f, 1.0f, 3);
+    std::vector<int> a_shape = {row, deep};
+    std::vector<int> out_shape = {row, col};
+    if (op_type == schema::PrimitiveType_MatMulFusion) {
+      a_shape.insert(a_shape.begin(), batch);
+      out_shape.insert(out_shape.begin(), batch);
+    }
+    std::vector<lite::Tensor *> inputs = {
+      CreateTensor<float>(kNumberTypeFloat32, a_shape, a),
+      CreateTensor<float>(kNumberTypeFloat32, b_transpose ? std::vector<int>{col, deep} : std::vector<int>{deep, col},
+                          b, NHWC, lite::Category::CONST_TENSOR)};
+    if (has_bias) {
+      inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {col}, bias, NHWC, lite::Category::CONST_TENSOR));
+    }
+    auto output = CreateTensor<float>(kNumberTypeFloat32, out_shape, {});
+
+    auto param = NewParameter<MatMulParameter>(op_type);
+    ASSERT_NE(param, nullptr);
+    param->b_transpose_ = b_transpose;
+    param->has_bias_ = has_bias;
+    param->act_type_ = ActType_No;
+    kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, op_type};
+    EXPECT_TRUE(kernel::Bf16KernelRegistry::GetInstance()->Support(desc, inputs, {output},
+                                                                    reinterpret_cast<OpParameter *>(param)));
+    auto result = RunKernel(kernel::Bf16KernelRegistry::GetInstance(), inputs, output,
+                            reinterpret_cast<OpParameter *>(param));
+    ASSERT_EQ(result.size(), static_cast<size_t>(batch * row * col));
+
+    // fp32 reference, the bf16 error of an element is bounded by the magnitude of its products
+    for (int i = 0; i < batch * row; ++i) {
+      for (int j = 0; j < col; ++j) {
+        double expect = has_bias ? bias[j] : 0.0;
+        double magnitude = 0.0;
+        for (int k = 0; k < deep; ++k) {
+          float weight = b_transpose ? b[j * deep + k] : b[k * col + j];
+          expect += static_cast<double>(a[i * deep + k]) * weight;
+          magnitude += std::fabs(static_cast<double>(a[i * deep + k]) * weight);
+        }
+        ASSERT_NEAR(result[i * col + j], expect, kBf16Tolerance * magnitude + 1e-5) << "row " << i << " col " << j;
+      }
+    }
+    DestroyTensors(inputs);
+    DestroyTensors({output});
+  }
+
+ protected:
+  std::shared_ptr<lite::InnerContext> ctx_;
+};
+
+TEST_F(TestBf16Kernel, FullConnectionWithTails) {
+  // col 19 leaves a partial col16 block and the odd deep a padded bf16 pair
+  TestMatmul(schema::PrimitiveType_FullConnection, 1, 5, 37, 19, true, true);
+}
+
+TEST_F(TestBf16Kernel, MatMulBatchedInput) {
+  TestMatmul(schema::PrimitiveType_MatMulFusion, 3, 7, 64, 48, false, false);
+}
+
+TEST_F(TestBf16Kernel, MatMulSplitByRow) {
+  // a single col block makes the threads split the rows
+  TestMatmul(schema::PrimitiveType_MatMulFusion, 2, 9, 15, 8, true, true);
+}
+
+TEST_F(TestBf16Kernel, MatMulRejectsVariableWeight) {
+  std::vector<lite::Tensor *> inputs = {CreateTensor<float>(kNumberTypeFloat32, {4, 8}, {}),
+                                        CreateTensor<float>(kNumberTypeFloat32, {8, 16}, {})};
+  auto output = CreateTensor<float>(kNumberTypeFloat32, {4, 16}, {});
+  auto param = NewParameter<MatMulParameter>(schema::PrimitiveType_MatMulFusion);
+  ASSERT_NE(param, nullptr);
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_MatMulFusion};
+  EXPECT_NE(kernel::Bf16KernelRegistry::GetInstance()->GetCreator(desc), nullptr);
+  EXPECT_FALSE(kernel::Bf16KernelRegistry::GetInstance()->Support(desc, inputs, {output},
+                                                                   reinterpret_cast<OpParameter *>(param)));
+  free(param);
+  DestroyTensors(inputs);
+  DestroyTensors({output});
+}
+
+TEST_F(TestBf16Kernel, NoCreatorForOtherKeys) {
+  auto registry = kernel::Bf16KernelRegistry::GetInstance();
+  kernel::KernelKey fp16_desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat16, NHWC, schema::PrimitiveType_Softmax};
+  EXPECT_EQ(registry->GetCreator(fp16_desc), nullptr);
+  kernel::KernelKey conv_desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC,
+                                 schema::PrimitiveType_Conv2DFusion};
+  EXPECT_EQ(registry->GetCreator(conv_desc), nullptr);
+}
+
+TEST_F(TestBf16Kernel, SoftmaxAgainstFp32) {
+  for (int axis : {-1, 1}) {
+    std::vector<int> shape = {2, 5, 3, 17};
+    auto in = RandomData(2 * 5 * 3 * 17, -4.0f, 4.0f, 4);
+    auto input = CreateTensor<float>(kNumberTypeFloat32, shape, in);
+    auto fp32_output = CreateTensor<float>(kNumberTypeFloat32, shape, {});
+    auto bf16_output = CreateTensor<float>(kNumberTypeFloat32, shape, {});
+
+    auto fp32_param = NewParameter<SoftmaxParameter>(schema::PrimitiveType_Softmax);
+    auto bf16_param = NewParameter<SoftmaxParameter>(schema::PrimitiveType_Softmax);
+    ASSERT_NE(fp32_param, nullptr);
+    ASSERT_NE(bf16_param, nullptr);
+    fp32_param->axis_ = axis;
+    bf16_param->axis_ = axis;
+    auto expect = RunKernel(lite::KernelRegistry::GetInstance(), {input}, fp32_output,
+                            reinterpret_cast<OpParameter *>(fp32_param));
+    auto result = RunKernel(kernel::Bf16KernelRegistry::GetInstance(), {input}, bf16_output,
+                            reinterpret_cast<OpParameter *>(bf16_param));
+    ASSERT_EQ(result.size(), expect.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+      ASSERT_TRUE(IsBf16Value(result[i])) << "axis " << axis << " index " << i;
+      // only the output is rounded, by half an ulp of bf16
+      ASSERT_NEAR(result[i], expect[i], expect[i] / 256) << "axis " << axis << " index " << i;
+    }
+    DestroyTensors({input, fp32_output, bf16_output});
+  }
+}
+
+TEST_F(TestBf16Kernel, LayerNormAgainstFp32) {
+  // {begin_norm_axis, begin_params_axis}, the second case applies one gamma and beta to several params blocks
+  std::vector<std::pair<int, int>> axes = {{2, 2}, {1, 2}, {1, 1}};
+  for (const auto &axis : axes) {
+    std::vector<int> shape = {4, 6, 33};
+    std::vector<int> params_shape(shape.begin() + axis.second, shape.end());
+    int params_size = 1;
+    for (auto dim : params_shape) {
+      params_size *= dim;
+    }
+    auto in = RandomData(4 * 6 * 33, -3.0f, 3.0f, 5);
+    auto gamma = RandomData(params_size, 0.5f, 1.5f, 6);
+    auto beta = RandomData(params_size, -0.5f, 0.5f, 7);
+    std::vector<lite::Tensor *> inputs = {
+      CreateTensor<float>(kNumberTypeFloat32, shape, in),
+      CreateTensor<float>(kNumberTypeFloat32, params_shape, gamma, NHWC, lite::Category::CONST_TENSOR),
+      CreateTensor<float>(kNumberTypeFloat32, params_shape, beta, NHWC, lite::Category::CONST_TENSOR)};
+    auto fp32_output = CreateTensor<float>(kNumberTypeFloat32, shape, {});
+    auto bf16_output = CreateTensor<float>(kNumberTypeFloat32, shape, {});
+
+    std::vector<float> results[2];
+    lite::Tensor *outputs[2] = {fp32_output, bf16_output};
+    lite::KernelRegistry *registries[2] = {lite::KernelRegistry::GetInstance(),
+                                           kernel::Bf16KernelRegistry::GetInstance()};
+    for (int i = 0; i < 2; ++i) {
+      auto param = NewParameter<LayerNormParameter>(schema::PrimitiveType_LayerNormFusion);
+      ASSERT_NE(param, nullptr);
+      param->epsilon_ = 1e-5f;
+      param->elementwise_affine_ = true;
+      param->begin_norm_axis_ = axis.first;
+      param->begin_params_axis_ = axis.second;
+      results[i] = RunKernel(registries[i], inputs, outputs[i], reinterpret_cast<OpParameter *>(param));
+    }
+    ASSERT_EQ(results[0].size(), results[1].size());
+    for (size_t i = 0; i < results[0].size(); ++i) {
+      ASSERT_TRUE(IsBf16Value(results[1][i])) << "norm axis " << axis.first << " index " << i;
+      // gamma, beta and the output are rounded to bf16
+      ASSERT_NEAR(results[1][i], results[0][i], (std::fabs(results[0][i]) + 1.0f) / 64)
+        << "norm axis " << axis.first << " index " << i;
+    }
+    DestroyTensors(inputs);
+    DestroyTensors({fp32_output, bf16_output});
+  }
+}
+}  // namespace mindspore
@@ -286,4 +286,47 @@ TEST_F(TestActivationFp32, Softplus) {
   delete kernel;
 }
 
+TEST_F(TestActivationFp32, TunedThreadNum) {
+  ActivationParameter op_param;
+  op_param.op_parameter_.type_ = schema::PrimitiveType_Activation;
+  op_param.type_ = schema::ActivationType_RELU;
+  op_param.op_parameter_.thread_num_ = 4;
+
+  const int length = 1000;
+  std::vector<float> input(length);
+  std::vector<float> expect_output(length);
+  for (int i = 0; i < length; ++i) {
+    input[i] = static_cast<float>(i % 7 - 3);
+    expect_output[i] = input[i] > 0 ? input[i] : 0;
+  }
+  std::vector<float> output(length);
+  lite::Tensor input0_tensor(kNumberTypeFloat32, {length});
+  lite::Tensor output0_tensor(kNumberTypeFloat32, {length});
+  input0_tensor.set_data(input.data());
+  output0_tensor.set_data(output.data());
+  std::vector<lite::Tensor *> inputs_tensor = {&input0_tensor};
+  std::vector<lite::Tensor *> outputs_tensor = {&output0_tensor};
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_Activation};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  lite::InnerContext ctx;
+  ctx.thread_num_ = 4;
+  ASSERT_EQ(lite::RET_OK, ctx.Init());
+  auto *kernel = creator(inputs_tensor, outputs_tensor, reinterpret_cast<OpParameter *>(&op_param), &ctx, desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(lite::RET_OK, kernel->Prepare());
+  ASSERT_TRUE(kernel->thread_num_tunable());
+  // the tuned thread num takes effect in ReSize
+  kernel->set_tuned_thread_num(1);
+  ASSERT_EQ(lite::RET_OK, kernel->ReSize());
+  ASSERT_EQ(op_param.op_parameter_.thread_num_, 1);
+  ASSERT_EQ(lite::RET_OK, kernel->Run());
+  ASSERT_EQ(0, CompareOutputData(output.data(), expect_output.data(), length, 0.00001));
+
+  input0_tensor.set_data(nullptr);
+  output0_tensor.set_data(nullptr);
+  delete kernel;
+}
+
 }  // namespace mindspore
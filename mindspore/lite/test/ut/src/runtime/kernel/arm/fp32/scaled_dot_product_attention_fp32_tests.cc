@@ -0,0 +1,135 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/attention_parameter.h"
+#include "src/litert/kernel/cpu/fp32/scaled_dot_product_attention_fp32.h"
+
+namespace mindspore {
+class TestScaledDotProductAttentionFp32 : public mindspore::CommonTest {
+ public:
+  TestScaledDotProductAttentionFp32() {}
+};
+
+namespace {
+void FillData(std::vector<float> *data, int seed) {
+  for (size_t i = 0; i < data->size(); ++i) {
+    data->at(i) = static_cast<float>((static_cast<int>(i) * 37 + seed * 11) % 101 - 50) / 50.0f;
+  }
+}
+
+// softmax(q * k^T * scale + mask) * v, k is [k_seq, head_size] and mask is [q_seq, k_seq] shared by all batches
+void NaiveAttention(const std::vector<float> &q, const std::vector<float> &k, const std::vector<float> &v,
+                    const std::vector<float> &mask, int batch, int q_seq, int k_seq, int head_size, float scale,
+                    std::vector<float> *out) {
+  std::vector<double> scores(k_seq);
+  for (int b = 0; b < batch; ++b) {
+    for (int i = 0; i < q_seq; ++i) {
+      double max_score = -INFINITY;
+      for (int j = 0; j < k_seq; ++j) {
+        double sum = 0;
+        for (int d = 0; d < head_size; ++d) {
+          sum += q[(b * q_seq + i) * head_size + d] * k[(b * k_seq + j) * head_size + d];
+        }
+        scores[j] = sum * scale + (mask.empty() ? 0 : mask[i * k_seq + j]);
+        max_score = std::max(max_score, scores[j]);
+      }
+      double exp_sum = 0;
+      for (int j = 0; j < k_seq; ++j) {
+        scores[j] = std::exp(scores[j] - max_score);
+        exp_sum += scores[j];
+      }
+      for (int d = 0; d < head_size; ++d) {
+        double sum = 0;
+        for (int j = 0; j < k_seq; ++j) {
+          sum += scores[j] * v[(b * k_seq + j) * head_size + d];
+        }
+        out->at((b * q_seq + i) * head_size + d) = static_cast<float>(sum / exp_sum);
+      }
+    }
+  }
+}
+
+void RunAttention(int batch, int q_seq, int k_seq, int head_size, bool with_mask) {
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  std::vector<float> q(batch * q_seq * head_size);
+  std::vector<float> k(batch * k_seq * head_size);
+  std::vector<float> v(batch * k_seq * head_size);
+  std::vector<float> mask;
+  FillData(&q, 1);
+  FillData(&k, 2);
+  FillData(&v, 3);
+  if (with_mask) {
+    mask.resize(q_seq * k_seq);
+    for (int i = 0; i < q_seq; ++i) {
+      for (int j = 0; j < k_seq; ++j) {
+        mask[i * k_seq + j] = j > i + k_seq - q_seq ? -10000.0f : 0.0f;
+      }
+    }
+  }
+  std::vector<float> expect(batch * q_seq * head_size);
+  NaiveAttention(q, k, v, mask, batch, q_seq, k_seq, head_size, scale, &expect);
+
+  lite::Tensor q_tensor(kNumberTypeFloat32, {batch, q_seq, head_size});
+  lite::Tensor k_tensor(kNumberTypeFloat32, {batch, k_seq, head_size});
+  lite::Tensor v_tensor(kNumberTypeFloat32, {batch, k_seq, head_size});
+  lite::Tensor mask_tensor(kNumberTypeFloat32, {q_seq, k_seq});
+  lite::Tensor out_tensor(kNumberTypeFloat32, {batch, q_seq, head_size});
+  std::vector<float> out(expect.size());
+  q_tensor.set_data(q.data());
+  k_tensor.set_data(k.data());
+  v_tensor.set_data(v.data());
+  mask_tensor.set_data(mask.data());
+  out_tensor.set_data(out.data());
+  std::vector<lite::Tensor *> inputs = {&q_tensor, &k_tensor, &v_tensor};
+  if (with_mask) {
+    inputs.push_back(&mask_tensor);
+  }
+  std::vector<lite::Tensor *> outputs = {&out_tensor};
+
+  auto param =
+    reinterpret_cast<ScaledDotProductAttentionParameter *>(malloc(sizeof(ScaledDotProductAttentionParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(ScaledDotProductAttentionParameter));
+  param->op_parameter_.thread_num_ = 2;
+  param->scale_ = scale;
+  param->transpose_k_ = true;
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  auto kernel = new kernel::ScaledDotProductAttentionCPUKernel(reinterpret_cast<OpParameter *>(param), inputs,
+                                                                outputs, ctx);
+  EXPECT_EQ(lite::RET_OK, kernel->Prepare());
+  EXPECT_EQ(lite::RET_OK, kernel->Run());
+  ASSERT_EQ(0, CommonTest::CompareOutputData(out.data(), expect.data(), static_cast<int>(expect.size()), 0.0001));
+  for (auto tensor : inputs) {
+    tensor->set_data(nullptr);
+  }
+  mask_tensor.set_data(nullptr);
+  out_tensor.set_data(nullptr);
+  delete kernel;
+  delete ctx;
+}
+}  // namespace
+
+TEST_F(TestScaledDotProductAttentionFp32, SingleBlock) { RunAttention(2, 5, 7, 8, false); }
+
+// q and kv lengths that are not multiples of the query block and the kv tile
+TEST_F(TestScaledDotProductAttentionFp32, MultiBlockWithMask) { RunAttention(3, 37, 301, 19, true); }
+}  // namespace mindspore
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "common/common_test.h"
+#include "src/litert/pack_weight_cache.h"
+#include "src/litert/pack_weight_manager.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kCacheAlignSize = 64;
+constexpr char kVariant[] = "MatMulB_0_8";
+}  // namespace
+class PackWeightCacheTest : public mindspore::CommonTest {
+ public:
+  PackWeightCacheTest() = default;
+};
+
+TEST_F(PackWeightCacheTest, SaveAndMap) {
+  std::vector<float> model(1024, 1.5f);
+  auto model_buf = reinterpret_cast<const char *>(model.data());
+  auto file_path = lite::PackWeightCache::GenCacheFilePath(".", model_buf, model.size() * sizeof(float));
+  (void)std::remove(file_path.c_str());
+  std::vector<float> weight_a(17, 2.0f);
+  std::vector<float> weight_b(100, 3.0f);
+  {
+    lite::PackWeightCache cache;
+    ASSERT_EQ(cache.Init(file_path), lite::RET_OK);
+    ASSERT_EQ(cache.GetPackData(3, kVariant, weight_a.size() * sizeof(float)), nullptr);
+    cache.RecordPackData(3, kVariant, weight_a.data(), weight_a.size() * sizeof(float));
+    cache.RecordPackData(9, kVariant, weight_b.data(), weight_b.size() * sizeof(float));
+    cache.RecordPackData(11, kVariant, weight_a.data(), sizeof(float));
+    // a freed pack buffer must not be written
+    cache.ForgetPackData(weight_a.data());
+    cache.RecordPackData(3, kVariant, weight_a.data(), weight_a.size() * sizeof(float));
+    ASSERT_EQ(cache.Flush(), lite::RET_OK);
+  }
+
+  lite::PackWeightCache cache;
+  ASSERT_EQ(cache.Init(file_path), lite::RET_OK);
+  auto data_a = reinterpret_cast<float *>(cache.GetPackData(3, kVariant, weight_a.size() * sizeof(float)));
+  ASSERT_NE(data_a, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(data_a) % kCacheAlignSize, 0);
+  ASSERT_EQ(0, CommonTest::CompareOutputData(data_a, weight_a.data(), static_cast<int>(weight_a.size()), 0));
+  auto data_b = reinterpret_cast<float *>(cache.GetPackData(9, kVariant, weight_b.size() * sizeof(float)));
+  ASSERT_NE(data_b, nullptr);
+  ASSERT_EQ(0, CommonTest::CompareOutputData(data_b, weight_b.data(), static_cast<int>(weight_b.size()), 0));
+  ASSERT_TRUE(cache.IsCachedData(data_b));
+  ASSERT_FALSE(cache.IsCachedData(weight_b.data()));
+  // a different packed size means a different layout
+  ASSERT_EQ(cache.GetPackData(9, kVariant, weight_b.size() * sizeof(float) + sizeof(float)), nullptr);
+  ASSERT_EQ(cache.GetPackData(11, kVariant, sizeof(float)), nullptr);
+  (void)std::remove(file_path.c_str());
+}
+
+TEST_F(PackWeightCacheTest, DifferentLayoutsOfOneWeight) {
+  std::vector<float> model(512, 0.5f);
+  auto model_buf = reinterpret_cast<const char *>(model.data());
+  auto file_path = lite::PackWeightCache::GenCacheFilePath(".", model_buf, model.size() * sizeof(float));
+  (void)std::remove(file_path.c_str());
+  // two kernels consume the same weight with packed buffers of the same size but different layouts
+  auto conv_variant = lite::PackVariant("ConvIm2Col", {8, 12});
+  auto matmul_variant = lite::PackVariant("MatMulB", {1, 8});
+  ASSERT_NE(conv_variant, matmul_variant);
+  std::vector<float> conv_pack(64, 1.0f);
+  std::vector<float> matmul_pack(64, 2.0f);
+  auto pack_size = conv_pack.size() * sizeof(float);
+  {
+    lite::PackWeightCache cache;
+    ASSERT_EQ(cache.Init(file_path), lite::RET_OK);
+    cache.RecordPackData(5, conv_variant, conv_pack.data(), pack_size);
+    cache.RecordPackData(5, matmul_variant, matmul_pack.data(), pack_size);
+    ASSERT_EQ(cache.Flush(), lite::RET_OK);
+  }
+
+  lite::PackWeightCache cache;
+  ASSERT_EQ(cache.Init(file_path), lite::RET_OK);
+  auto conv_data = reinterpret_cast<float *>(cache.GetPackData(5, conv_variant, pack_size));
+  ASSERT_NE(conv_data, nullptr);
+  ASSERT_EQ(0, CommonTest::CompareOutputData(conv_data, conv_pack.data(), static_cast<int>(conv_pack.size()), 0));
+  auto matmul_data = reinterpret_cast<float *>(cache.GetPackData(5, matmul_variant, pack_size));
+  ASSERT_NE(matmul_data, nullptr);
+  ASSERT_EQ(0,
+            CommonTest::CompareOutputData(matmul_data, matmul_pack.data(), static_cast<int>(matmul_pack.size()), 0));
+  // a layout that was never packed is not served from another layout of the same weight
+  ASSERT_EQ(cache.GetPackData(5, lite::PackVariant("MatMulB", {0, 8}), pack_size), nullptr);
+  (void)std::remove(file_path.c_str());
+}
+
+TEST_F(PackWeightCacheTest, CacheFileOfModelFile) {
+  const char model_path[] = "./pack_weight_cache_test_model.ms";
+  std::vector<char> model(1 << 20, 1);
+  {
+    std::ofstream model_file(model_path, std::ios::binary);
+    ASSERT_TRUE(model_file.is_open());
+    model_file.write(model.data(), static_cast<std::streamsize>(model.size()));
+  }
+  // a model file is keyed by its path, size and modification time, its buffer is never read
+  auto file_path = lite::PackWeightCache::GenCacheFilePath(".", nullptr, model.size(), model_path);
+  ASSERT_EQ(lite::PackWeightCache::GenCacheFilePath(".", nullptr, model.size(), "././pack_weight_cache_test_model.ms"),
+            file_path);
+  ASSERT_NE(lite::PackWeightCache::GenCacheFilePath(".", nullptr, model.size() + 1, model_path), file_path);
+  (void)std::remove(model_path);
+
+  // a model without its file is keyed by its buffer, of which the head and the tail are always read
+  auto buf_path = lite::PackWeightCache::GenCacheFilePath(".", model.data(), model.size(), model_path);
+  ASSERT_NE(buf_path, file_path);
+  ASSERT_EQ(lite::PackWeightCache::GenCacheFilePath(".", model.data(), model.size()), buf_path);
+  model.front() = 0;
+  auto head_changed_path = lite::PackWeightCache::GenCacheFilePath(".", model.data(), model.size());
+  ASSERT_NE(head_changed_path, buf_path);
+  model.back() = 0;
+  ASSERT_NE(lite::PackWeightCache::GenCacheFilePath(".", model.data(), model.size()), head_changed_path);
+}
+}  // namespace mindspore
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "src/tensor.h"
+#define private public
+#include "src/litert/runtime_allocator.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr size_t kAlignSize = 32;
+}  // namespace
+class RuntimeAllocatorTest : public mindspore::CommonTest {
+ public:
+  RuntimeAllocatorTest() = default;
+
+  // every pair of tensors whose buffers are alive at the same time must get disjoint ranges of the arena
+  static void CheckNoOverlap(const RuntimeAllocator &allocator, const std::vector<lite::Tensor *> &tensors) {
+    for (size_t i = 0; i < tensors.size(); i++) {
+      for (size_t j = i + 1; j < tensors.size(); j++) {
+        auto buffer_i = allocator.tensor_buffers_.at(tensors[i]);
+        auto buffer_j = allocator.tensor_buffers_.at(tensors[j]);
+        if (buffer_i == buffer_j) {
+          continue;
+        }
+        auto &a = allocator.buffers_[buffer_i];
+        auto &b = allocator.buffers_[buffer_j];
+        if (a.malloc_step >= b.free_step || b.malloc_step >= a.free_step) {
+          continue;
+        }
+        auto offset_a = allocator.offset_map_.at(tensors[i]);
+        auto offset_b = allocator.offset_map_.at(tensors[j]);
+        ASSERT_TRUE(offset_a + a.size <= offset_b || offset_b + b.size <= offset_a)
+          << "tensor " << i << " [" << offset_a << ", " << offset_a + a.size << ") overlaps tensor " << j << " ["
+          << offset_b << ", " << offset_b + b.size << ")";
+      }
+    }
+  }
+};
+
+TEST_F(RuntimeAllocatorTest, DisjointLifetimesShareOffset) {
+  lite::Tensor t0(kNumberTypeFloat32, {64});
+  lite::Tensor t1(kNumberTypeFloat32, {32});
+  RuntimeAllocator allocator(kAlignSize);
+  allocator.MallocTensorData(&t0);
+  allocator.FreeTensorData(&t0);
+  allocator.MallocTensorData(&t1);
+  allocator.FreeTensorData(&t1);
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t0), allocator.GetOffsetMap().at(&t1));
+  ASSERT_EQ(allocator.total_size_, t0.Size());
+}
+
+TEST_F(RuntimeAllocatorTest, OverlappingLifetimesPackBelowGreedy) {
+  // greedy: t0 [0, 64), t1 [64, 96), t0 freed, t2 does not fit the hole and goes to [96, 192)
+  // packed: t2 [0, 96), t0 [0, 64) since it is dead before t2, t1 on top of both at [96, 128)
+  lite::Tensor t0(kNumberTypeFloat32, {16});
+  lite::Tensor t1(kNumberTypeFloat32, {8});
+  lite::Tensor t2(kNumberTypeFloat32, {24});
+  RuntimeAllocator allocator(kAlignSize);
+  allocator.MallocTensorData(&t0);
+  allocator.MallocTensorData(&t1);
+  allocator.FreeTensorData(&t0);
+  allocator.MallocTensorData(&t2);
+  constexpr size_t kGreedySize = 192;
+  ASSERT_EQ(allocator.total_size_, kGreedySize);
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  constexpr size_t kPackedSize = 128;
+  ASSERT_EQ(allocator.total_size_, kPackedSize);
+  CheckNoOverlap(allocator, {&t0, &t1, &t2});
+}
+
+TEST_F(RuntimeAllocatorTest, PackBuffersBestFit) {
+  RuntimeAllocator allocator(kAlignSize);
+  /* size, malloc step, free step */
+  allocator.buffers_ = {{32, 0, 10}, {64, 0, 1}, {32, 0, 10}, {32, 0, 1}, {32, 0, 10}, {32, 2, 10}};
+  std::vector<size_t> offsets(allocator.buffers_.size(), 0);
+  auto size = allocator.PackBuffers({0, 1, 2, 3, 4, 5}, &offsets);
+  std::vector<size_t> expect_offsets = {0, 32, 96, 128, 160, 128};
+  // buffer 5 only lives with 0, 2 and 4: of the holes [32, 96) and [128, 160) it takes the smaller one
+  ASSERT_EQ(offsets, expect_offsets);
+  ASSERT_EQ(size, 192u);
+  // buffers alive at the same time go on top of each other when there is no hole
+  size = allocator.PackBuffers({5, 4, 2, 0}, &offsets);
+  ASSERT_EQ(offsets[5], 0u);
+  ASSERT_EQ(offsets[4], 32u);
+  ASSERT_EQ(offsets[2], 64u);
+  ASSERT_EQ(offsets[0], 96u);
+  ASSERT_EQ(size, 128u);
+}
+
+TEST_F(RuntimeAllocatorTest, KeepGreedyWhenNotSmaller) {
+  lite::Tensor t0(kNumberTypeFloat32, {8});
+  lite::Tensor t1(kNumberTypeFloat32, {8});
+  RuntimeAllocator allocator(kAlignSize);
+  allocator.MallocTensorData(&t0);
+  allocator.MallocTensorData(&t1);
+  auto greedy_offset0 = allocator.GetOffsetMap().at(&t0);
+  auto greedy_offset1 = allocator.GetOffsetMap().at(&t1);
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t0), greedy_offset0);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t1), greedy_offset1);
+  ASSERT_EQ(allocator.total_size_, 2 * kAlignSize);
+}
+
+TEST_F(RuntimeAllocatorTest, ZeroSizeTensor) {
+  lite::Tensor empty(kNumberTypeFloat32, {0});
+  lite::Tensor t0(kNumberTypeFloat32, {8});
+  lite::Tensor t1(kNumberTypeFloat32, {8});
+  RuntimeAllocator allocator(kAlignSize);
+  allocator.MallocTensorData(&t0);
+  allocator.FreeTensorData(&t0);
+  // the zero size tensor takes a byte, so the tensor allocated while it is alive gets its own offset
+  allocator.MallocTensorData(&empty);
+  allocator.MallocTensorData(&t1);
+  ASSERT_NE(allocator.GetOffsetMap().at(&empty), allocator.GetOffsetMap().at(&t1));
+  allocator.FreeTensorData(&t1);
+  allocator.FreeTensorData(&empty);
+  ASSERT_TRUE(allocator.used_list_.empty());
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_NE(allocator.GetOffsetMap().at(&empty), allocator.GetOffsetMap().at(&t1));
+  ASSERT_LE(allocator.total_size_, 2 * kAlignSize);
+  CheckNoOverlap(allocator, {&empty, &t0, &t1});
+}
+
+TEST_F(RuntimeAllocatorTest, AliasedTensorFollowsBuffer) {
+  // the same shape as OverlappingLifetimesPackBelowGreedy, t1 moves from 64 to 96 and its alias moves with it
+  lite::Tensor t0(kNumberTypeFloat32, {16});
+  lite::Tensor t1(kNumberTypeFloat32, {8});
+  lite::Tensor t1_alias(kNumberTypeFloat32, {8});
+  lite::Tensor t2(kNumberTypeFloat32, {24});
+  RuntimeAllocator allocator(kAlignSize);
+  allocator.MallocTensorData(&t0);
+  allocator.MallocTensorData(&t1);
+  allocator.SetDataOffset(&t1_alias, allocator.GetOffsetMap().at(&t1));
+  allocator.FreeTensorData(&t0);
+  allocator.MallocTensorData(&t2);
+  allocator.FreeTensorData(&t1_alias);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t1), 64u);
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t1), 96u);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&t1_alias), allocator.GetOffsetMap().at(&t1));
+  CheckNoOverlap(allocator, {&t0, &t1, &t1_alias, &t2});
+}
+}  // namespace mindspore
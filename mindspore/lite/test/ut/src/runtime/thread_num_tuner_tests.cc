@@ -0,0 +1,210 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "src/litert/kernel_registry.h"
+#include "src/litert/lite_kernel.h"
+#define private public
+#include "src/litert/thread_num_tuner.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kMaxThreadNum = 4;
+constexpr char kProfilePath[] = "./thread_num_tuner_test.profile";
+
+void WriteProfile(const std::string &content) {
+  std::ofstream outfile(kProfilePath, std::ios::out | std::ios::trunc);
+  outfile << content;
+}
+}  // namespace
+class ThreadNumTunerTest : public mindspore::CommonTest {
+ public:
+  ThreadNumTunerTest() = default;
+
+  void SetUp() override {
+    (void)std::remove(kProfilePath);
+    ctx_.thread_num_ = kMaxThreadNum;
+    ASSERT_EQ(lite::RET_OK, ctx_.Init());
+  }
+
+  void TearDown() override {
+    (void)std::remove(kProfilePath);
+    input_.set_data(nullptr);
+    output_.set_data(nullptr);
+  }
+
+  // a relu kernel, which splits its work by the thread num in ReSize, on the input of shape 2x3
+  std::unique_ptr<kernel::KernelExec> CreateKernel() {
+    auto param = reinterpret_cast<ActivationParameter *>(malloc(sizeof(ActivationParameter)));
+    if (param == nullptr) {
+      return nullptr;
+    }
+    memset(param, 0, sizeof(ActivationParameter));
+    param->op_parameter_.type_ = schema::PrimitiveType_Activation;
+    param->op_parameter_.thread_num_ = kMaxThreadNum;
+    param->type_ = schema::ActivationType_RELU;
+    input_.set_data(input_data_.data());
+    output_.set_data(output_data_.data());
+    kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_Activation};
+    auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+    if (creator == nullptr) {
+      free(param);
+      return nullptr;
+    }
+    auto lite_kernel = creator({&input_}, {&output_}, reinterpret_cast<OpParameter *>(param), &ctx_, desc);
+    if (lite_kernel == nullptr) {
+      free(param);
+      return nullptr;
+    }
+    auto kernel = std::make_unique<kernel::KernelExec>(std::shared_ptr<kernel::Kernel>(lite_kernel));
+    kernel->set_name("relu");
+    kernel->set_desc(desc);
+    if (kernel->Prepare() != lite::RET_OK || kernel->ReSize() != lite::RET_OK) {
+      return nullptr;
+    }
+    return kernel;
+  }
+
+  static kernel::LiteKernel *GetLiteKernel(kernel::KernelExec *kernel) {
+    return static_cast<kernel::LiteKernel *>(kernel->kernel());
+  }
+
+  static int TunedThreadNum(kernel::KernelExec *kernel) { return GetLiteKernel(kernel)->tuned_thread_num(); }
+
+  // run the kernel between the callbacks as the executor does
+  static int RunKernel(kernel::KernelExec *kernel, const KernelCallBack &before, const KernelCallBack &after) {
+    MSCallBackParam call_param = {kernel->name(), "Activation", 0};
+    (void)before(kernel->in_tensors(), kernel->out_tensors(), call_param);
+    auto ret = GetLiteKernel(kernel)->Run();
+    (void)after(kernel->in_tensors(), kernel->out_tensors(), call_param);
+    return ret;
+  }
+
+ protected:
+  lite::InnerContext ctx_;
+  std::vector<float> input_data_ = {-1, 2, -3, 4, -5, 6};
+  std::vector<float> output_data_ = std::vector<float>(6);
+  lite::Tensor input_ = lite::Tensor(kNumberTypeFloat32, {2, 3});
+  lite::Tensor output_ = lite::Tensor(kNumberTypeFloat32, {2, 3});
+};
+
+TEST_F(ThreadNumTunerTest, Candidates) {
+  // powers of two below the max thread num, then the max thread num itself
+  ASSERT_EQ(lite::ThreadNumTuner(6, "", 1).candidates_, std::vector<int>({1, 2, 4, 6}));
+  ASSERT_EQ(lite::ThreadNumTuner(4, "", 1).candidates_, std::vector<int>({1, 2, 4}));
+  ASSERT_EQ(lite::ThreadNumTuner(1, "", 1).candidates_, std::vector<int>({1}));
+  ASSERT_EQ(lite::ThreadNumTuner(0, "", 1).candidates_, std::vector<int>({1}));
+  // the tune loops are at least one
+  ASSERT_EQ(lite::ThreadNumTuner(4, "", 0).tune_loops_, 1);
+}
+
+TEST_F(ThreadNumTunerTest, TuneKey) {
+  auto kernel = CreateKernel();
+  ASSERT_NE(kernel, nullptr);
+  lite::ThreadNumTuner tuner(kMaxThreadNum, "", 1);
+  // the profile is a text file of "key thread_num" lines, so the cpu model has no blank
+  ASSERT_EQ(tuner.cpu_model_.find_first_of(" \t\n"), std::string::npos);
+  auto expect_key = "Activation_" + std::to_string(kNumberTypeFloat32) + "_2x3_" + tuner.cpu_model_ + "_t" +
+                    std::to_string(kMaxThreadNum);
+  ASSERT_EQ(tuner.GenTuneKey(kernel.get()), expect_key);
+  // the key follows the input shapes
+  input_.set_shape({6});
+  ASSERT_EQ(tuner.GenTuneKey(kernel.get()).find("Activation_" + std::to_string(kNumberTypeFloat32) + "_6_"), 0u);
+}
+
+TEST_F(ThreadNumTunerTest, LoadAndMergeProfile) {
+  // entries of non-positive thread nums are ignored
+  WriteProfile("a 2\nb 0\nc 3\n");
+  lite::ThreadNumTuner tuner(kMaxThreadNum, kProfilePath, 1);
+  ASSERT_EQ(tuner.profile_, (std::map<std::string, int>{{"a", 2}, {"c", 3}}));
+  // another process saves its entries meanwhile, they are kept and the ones tuned here win
+  WriteProfile("a 1\nc 3\ne 2\n");
+  tuner.profile_["a"] = 4;
+  tuner.profile_["d"] = 1;
+  ASSERT_EQ(tuner.SaveProfile(), lite::RET_OK);
+  std::map<std::string, int> expect_profile = {{"a", 4}, {"c", 3}, {"d", 1}, {"e", 2}};
+  ASSERT_EQ(tuner.profile_, expect_profile);
+  std::ifstream tmp_file(std::string(kProfilePath) + ".tmp");
+  ASSERT_FALSE(tmp_file.is_open());
+  ASSERT_EQ(lite::ThreadNumTuner(kMaxThreadNum, kProfilePath, 1).profile_, expect_profile);
+}
+
+TEST_F(ThreadNumTunerTest, TuneAndApplyProfile) {
+  auto kernel = CreateKernel();
+  ASSERT_NE(kernel, nullptr);
+  constexpr int kTuneLoops = 2;
+  lite::ThreadNumTuner tuner(kMaxThreadNum, kProfilePath, kTuneLoops);
+  ASSERT_EQ(tuner.Init({kernel.get()}), lite::RET_OK);
+  ASSERT_TRUE(tuner.IsTuning());
+  auto key = tuner.GenTuneKey(kernel.get());
+  // every candidate runs the tune loops, the kernel is timed by the wrapped callbacks
+  for (auto candidate : tuner.candidates_) {
+    for (int loop = 0; loop < kTuneLoops; loop++) {
+      ASSERT_TRUE(tuner.IsTuning());
+      KernelCallBack before = nullptr;
+      KernelCallBack after = nullptr;
+      ASSERT_EQ(tuner.BeginRun(nullptr, nullptr, &before, &after), lite::RET_OK);
+      ASSERT_EQ(TunedThreadNum(kernel.get()), candidate);
+      ASSERT_EQ(kernel->op_parameter()->thread_num_, candidate);
+      ASSERT_EQ(RunKernel(kernel.get(), before, after), lite::RET_OK);
+      ASSERT_EQ(tuner.EndRun(true), lite::RET_OK);
+    }
+  }
+  ASSERT_FALSE(tuner.IsTuning());
+  ASSERT_EQ(tuner.profile_.count(key), 1u);
+  auto best = tuner.profile_[key];
+  ASSERT_EQ(TunedThreadNum(kernel.get()), best);
+  std::vector<float> expect_output = {0, 2, 0, 4, 0, 6};
+  ASSERT_EQ(output_data_, expect_output);
+
+  // a later load applies the profiled thread num without tuning again
+  auto other_kernel = CreateKernel();
+  ASSERT_NE(other_kernel, nullptr);
+  lite::ThreadNumTuner other_tuner(kMaxThreadNum, kProfilePath, kTuneLoops);
+  ASSERT_EQ(other_tuner.profile_.at(key), best);
+  ASSERT_EQ(other_tuner.Init({other_kernel.get()}), lite::RET_OK);
+  ASSERT_FALSE(other_tuner.IsTuning());
+  if (best != kMaxThreadNum) {
+    ASSERT_EQ(TunedThreadNum(other_kernel.get()), best);
+  }
+}
+
+TEST_F(ThreadNumTunerTest, StopTuningOnFailedRun) {
+  auto kernel = CreateKernel();
+  ASSERT_NE(kernel, nullptr);
+  lite::ThreadNumTuner tuner(kMaxThreadNum, kProfilePath, 1);
+  ASSERT_EQ(tuner.Init({kernel.get()}), lite::RET_OK);
+  KernelCallBack before = nullptr;
+  KernelCallBack after = nullptr;
+  ASSERT_EQ(tuner.BeginRun(nullptr, nullptr, &before, &after), lite::RET_OK);
+  ASSERT_EQ(TunedThreadNum(kernel.get()), 1);
+  // the kernel goes back to the max thread num and nothing is profiled
+  ASSERT_EQ(tuner.EndRun(false), lite::RET_OK);
+  ASSERT_FALSE(tuner.IsTuning());
+  ASSERT_EQ(TunedThreadNum(kernel.get()), kMaxThreadNum);
+  ASSERT_TRUE(tuner.profile_.empty());
+  std::ifstream profile(kProfilePath);
+  ASSERT_FALSE(profile.is_open());
+}
+}  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <vector>
+#include "common/common_test.h"
+#include "thread/threadpool.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kThreadNum = 4;
+constexpr int kTaskNum = 32;
+constexpr int kLaunchLoop = 200;
+constexpr int kHeavyTaskRatio = 8;
+constexpr int kLightWork = 200;
+constexpr int kHeavyWork = 20000;
+
+struct SkewedWork {
+  std::vector<std::atomic_int> hits = std::vector<std::atomic_int>(kTaskNum);
+  int heavy_task = 0;
+};
+
+// one slice of every kHeavyTaskRatio is much heavier, so the idle threads steal the slices left behind it
+int SkewedRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto work = reinterpret_cast<SkewedWork *>(cdata);
+  work->hits[task_id]++;
+  int loop = (task_id % kHeavyTaskRatio == work->heavy_task) ? kHeavyWork : kLightWork;
+  volatile int sum = 0;
+  for (int i = 0; i < loop; ++i) {
+    sum = sum + i;
+  }
+  return 0;
+}
+}  // namespace
+
+class ThreadPoolTest : public mindspore::CommonTest {
+ public:
+  ThreadPoolTest() = default;
+};
+
+TEST_F(ThreadPoolTest, WorkStealingRunEveryTaskOnce) {
+  auto pool = ThreadPool::CreateThreadPool(kThreadNum, {}, kWorkStealing);
+  ASSERT_NE(pool, nullptr);
+  SkewedWork work;
+  // the task numbers change between the launches, so the ranges buffer of the pool is reused and grown
+  for (int loop = 0; loop < kLaunchLoop; ++loop) {
+    int task_num = (loop % 2 == 0) ? kTaskNum : kTaskNum / 2 + loop % kHeavyTaskRatio;
+    for (auto &hit : work.hits) {
+      hit = 0;
+    }
+    work.heavy_task = loop % kHeavyTaskRatio;
+    ASSERT_EQ(pool->ParallelLaunch(SkewedRun, &work, task_num), THREAD_OK);
+    for (int i = 0; i < kTaskNum; ++i) {
+      ASSERT_EQ(work.hits[i], i < task_num ? 1 : 0) << "launch " << loop << ", task " << i;
+    }
+  }
+  delete pool;
+}
+
+TEST_F(ThreadPoolTest, WorkStealingNestedLaunch) {
+  auto pool = ThreadPool::CreateThreadPool(kThreadNum, {}, kWorkStealing);
+  ASSERT_NE(pool, nullptr);
+  std::atomic_int count{0};
+  auto inner = [&count](void *, int, float, float) {
+    count++;
+    return 0;
+  };
+  auto outer = [&](void *, int, float, float) { return pool->ParallelLaunch(inner, nullptr, kTaskNum); };
+  ASSERT_EQ(pool->ParallelLaunch(outer, nullptr, kThreadNum), THREAD_OK);
+  ASSERT_EQ(count, kTaskNum * static_cast<int>(kThreadNum));
+  delete pool;
+}
+}  // namespace mindspore
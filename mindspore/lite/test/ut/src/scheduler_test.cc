@@ -14,9 +14,15 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
 #include "common/common_test.h"
 #include "schema/inner/model_generated.h"
 #include "src/litert/lite_session.h"
+#include "src/litert/cxx_api/converters.h"
+#include "include/api/context.h"
 #include "ir/dtype/type_id.h"
 
 using mindspore::kernel::KernelExec;
@@ -438,3 +444,166 @@ TEST_F(SchedulerTest, TestScheduleInt32OpToFp16Subgraph) {
   ASSERT_EQ(mindspore::lite::RET_OK, lite_session->CompileGraph(model));
   ASSERT_EQ(1, lite_session->get_kernels().size());
 }
+
+namespace {
+// 1 + 2^-12 is exact in fp32 and rounds to 1 in bf16, so a bf16 matmul over it sums to the deep size exactly
+constexpr float kNotBf16Value = 1.0f + 1.0f / 4096;
+constexpr int kBf16Row = 4;
+constexpr int kBf16Deep = 24;
+constexpr int kBf16Col = 20;
+constexpr float kBf16MatMulResult = kBf16Deep;
+constexpr float kFp32MatMulResult = kBf16Deep * kNotBf16Value * kNotBf16Value;
+
+mindspore::lite::Model *ImportMatMulModel(bool const_weight) {
+  auto meta_graph = std::make_shared<mindspore::schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = mindspore::Version();
+
+  auto matmul = std::make_unique<mindspore::schema::CNodeT>();
+  matmul->inputIndex = {0, 1};
+  matmul->outputIndex = {2};
+  matmul->primitive = std::make_unique<mindspore::schema::PrimitiveT>();
+  matmul->primitive->value.type = mindspore::schema::PrimitiveType_MatMulFusion;
+  auto primitive = new mindspore::schema::MatMulFusionT;
+  matmul->primitive->value.value = primitive;
+  matmul->name = "matmul";
+
+  auto tensor0 = std::make_unique<mindspore::schema::TensorT>();
+  tensor0->nodeType = mindspore::lite::NodeType_Parameter;
+  tensor0->format = mindspore::schema::Format_NHWC;
+  tensor0->dataType = mindspore::TypeId::kNumberTypeFloat32;
+  tensor0->dims = {kBf16Row, kBf16Deep};
+  tensor0->offset = -1;
+
+  auto tensor1 = std::make_unique<mindspore::schema::TensorT>();
+  tensor1->nodeType = const_weight ? mindspore::lite::NodeType_ValueNode : mindspore::lite::NodeType_Parameter;
+  tensor1->format = mindspore::schema::Format_NHWC;
+  tensor1->dataType = mindspore::TypeId::kNumberTypeFloat32;
+  tensor1->dims = {kBf16Deep, kBf16Col};
+  tensor1->offset = -1;
+  if (const_weight) {
+    std::vector<float> weight(kBf16Deep * kBf16Col, kNotBf16Value);
+    tensor1->data.resize(weight.size() * sizeof(float));
+    ::memcpy(tensor1->data.data(), weight.data(), tensor1->data.size());
+  }
+
+  auto tensor2 = std::make_unique<mindspore::schema::TensorT>();
+  tensor2->nodeType = mindspore::lite::NodeType_CNode;
+  tensor2->format = mindspore::schema::Format_NHWC;
+  tensor2->dataType = mindspore::TypeId::kNumberTypeFloat32;
+  tensor2->dims = {kBf16Row, kBf16Col};
+  tensor2->offset = -1;
+
+  meta_graph->nodes.emplace_back(std::move(matmul));
+  meta_graph->allTensors.emplace_back(std::move(tensor0));
+  meta_graph->allTensors.emplace_back(std::move(tensor1));
+  meta_graph->allTensors.emplace_back(std::move(tensor2));
+  meta_graph->inputIndex = {0};
+  if (!const_weight) {
+    meta_graph->inputIndex.push_back(1);
+  }
+  meta_graph->outputIndex = {2};
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  mindspore::schema::FinishMetaGraphBuffer(builder, offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+  return mindspore::lite::Model::Import(content, size);
+}
+
+// compiles and runs the matmul model, every element of the output is the same
+float RunMatMulModel(const std::shared_ptr<InnerContext> &context, bool const_weight) {
+  auto model = ImportMatMulModel(const_weight);
+  EXPECT_NE(model, nullptr);
+  if (model == nullptr) {
+    return NAN;
+  }
+  auto lite_session = new LiteSession();
+  float result = NAN;
+  if (lite_session->Init(context) == mindspore::lite::RET_OK &&
+      lite_session->CompileGraph(model) == mindspore::lite::RET_OK) {
+    EXPECT_EQ(1, lite_session->get_kernels().size());
+    for (auto input : lite_session->GetInputs()) {
+      auto data = reinterpret_cast<float *>(input->MutableData());
+      std::fill(data, data + input->ElementsNum(), kNotBf16Value);
+    }
+    if (lite_session->RunGraph() == mindspore::lite::RET_OK) {
+      auto outputs = lite_session->GetOutputs();
+      EXPECT_EQ(1, outputs.size());
+      auto output = outputs.begin()->second;
+      auto data = reinterpret_cast<float *>(output->data());
+      result = data[0];
+      for (int i = 1; i < output->ElementsNum(); ++i) {
+        EXPECT_EQ(result, data[i]);
+      }
+    }
+  }
+  delete lite_session;
+  delete model;
+  return result;
+}
+
+std::shared_ptr<InnerContext> CreateBf16Context(bool enable_bf16, bool device_support_bf16) {
+  auto context = std::make_shared<InnerContext>();
+  context->device_list_[0].device_info_.cpu_device_info_.enable_bfloat16_ = enable_bf16;
+  context->device_and_pkg_support_bf16_ = device_support_bf16;
+  return context;
+}
+}  // namespace
+
+TEST_F(SchedulerTest, TestScheduleBf16MatMul) {
+  auto context = CreateBf16Context(true, true);
+  ASSERT_EQ(mindspore::lite::RET_OK, context->Init());
+  ASSERT_TRUE(context->IsCpuBFloat16Enabled());
+  ASSERT_EQ(kBf16MatMulResult, RunMatMulModel(context, true));
+}
+
+TEST_F(SchedulerTest, TestScheduleBf16DisabledKeepsFp32) {
+  auto context = CreateBf16Context(false, true);
+  ASSERT_EQ(mindspore::lite::RET_OK, context->Init());
+  ASSERT_FALSE(context->IsCpuBFloat16Enabled());
+  ASSERT_NEAR(kFp32MatMulResult, RunMatMulModel(context, true), 1e-4);
+}
+
+TEST_F(SchedulerTest, TestScheduleBf16WithoutDeviceSupportFallsBack) {
+  auto context = CreateBf16Context(true, false);
+  ASSERT_EQ(mindspore::lite::RET_OK, context->Init());
+  ASSERT_FALSE(context->IsCpuBFloat16Enabled());
+  ASSERT_NEAR(kFp32MatMulResult, RunMatMulModel(context, true), 1e-4);
+}
+
+TEST_F(SchedulerTest, TestScheduleBf16UnsupportedCaseFallsBack) {
+  // the bf16 matmul packs a const weight once, a weight fed at runtime stays on the fp32 kernel
+  auto context = CreateBf16Context(true, true);
+  ASSERT_EQ(mindspore::lite::RET_OK, context->Init());
+  ASSERT_NEAR(kFp32MatMulResult, RunMatMulModel(context, false), 1e-4);
+}
+
+TEST_F(SchedulerTest, TestScheduleBf16FromCpuDeviceInfo) {
+  auto cpu_device_info = std::make_shared<mindspore::CPUDeviceInfo>();
+  ASSERT_FALSE(cpu_device_info->GetEnableBF16());
+  mindspore::Context default_context;
+  default_context.MutableDeviceInfo().push_back(cpu_device_info);
+  auto default_inner_context = mindspore::ContextUtils::Convert(&default_context);
+  ASSERT_NE(default_inner_context, nullptr);
+  ASSERT_FALSE(default_inner_context->device_list_[0].device_info_.cpu_device_info_.enable_bfloat16_);
+
+  cpu_device_info->SetEnableBF16(true);
+  ASSERT_TRUE(cpu_device_info->GetEnableBF16());
+  mindspore::Context context;
+  context.MutableDeviceInfo().push_back(cpu_device_info);
+  auto inner_context = mindspore::ContextUtils::Convert(&context);
+  ASSERT_NE(inner_context, nullptr);
+  ASSERT_TRUE(inner_context->device_list_[0].device_info_.cpu_device_info_.enable_bfloat16_);
+  // the result depends on the host, the scheduler must pick the bf16 kernel exactly when the host supports it
+  auto expect = inner_context->device_and_pkg_support_bf16_ ? kBf16MatMulResult : kFp32MatMulResult;
+  ASSERT_EQ(mindspore::lite::RET_OK, inner_context->Init());
+  ASSERT_NEAR(expect, RunMatMulModel(inner_context, true), 1e-4);
+
+  inner_context = mindspore::ContextUtils::Convert(&context);
+  ASSERT_NE(inner_context, nullptr);
+  inner_context->device_and_pkg_support_bf16_ = true;
+  ASSERT_EQ(mindspore::lite::RET_OK, inner_context->Init());
+  ASSERT_EQ(kBf16MatMulResult, RunMatMulModel(inner_context, true));
+}
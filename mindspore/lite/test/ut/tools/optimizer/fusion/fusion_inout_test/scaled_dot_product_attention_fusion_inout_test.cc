@@ -0,0 +1,146 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define USE_DEPRECATED_API
+#include <memory>
+#include <string>
+#include <vector>
+#include "tools/optimizer/fusion/scaled_dot_product_attention_fusion.h"
+#include "test/ut/tools/optimizer/fusion/fusion_inout_test/fusion_inout_test.h"
+#include "plugin/device/cpu/kernel/nnacl/op_base.h"
+#include "ops/fusion/add_fusion.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/softmax.h"
+#include "ops/scaled_dot_product_attention.h"
+
+namespace mindspore {
+namespace {
+constexpr int64_t kMaskKeyLen = 128;
+}  // namespace
+
+class ScaledDotProductAttentionFusionInoutTest : public FusionInoutTest {
+ public:
+  ScaledDotProductAttentionFusionInoutTest() = default;
+
+  bool IsFused() {
+    if (graph_ == nullptr) {
+      return false;
+    }
+    for (const auto &cnode : graph_->GetOrderedCnodes()) {
+      auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+      if (prim != nullptr && prim->name() == ops::kNameScaledDotProductAttention) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ protected:
+  void InitPass() override { this->pass_ = std::make_shared<opt::ScaledDotProductAttentionFusion>(); }
+
+  void InitGraph() override {
+    this->graph_ = std::make_shared<FuncGraph>();
+    MS_CHECK_TRUE_MSG(graph_ != nullptr, , "Create FuncGraph failed");
+    auto q = AddParameter(graph_, 0, {batch_, q_seq_, head_size_}, kNumberTypeFloat32, "q");
+    auto k = AddParameter(graph_, 0, {batch_, head_size_, k_seq_}, kNumberTypeFloat32, "k");
+    auto v = AddParameter(graph_, 0, {batch_, k_seq_, head_size_}, kNumberTypeFloat32, "v");
+    auto mask = AddParameter(graph_, 0, mask_shape_, kNumberTypeFloat32, "mask");
+    auto scores = AddMatMul(graph_, q, k, "score_matmul");
+    auto masked_scores = AddAdd(graph_, scores, mask, "mask_add");
+    auto softmax = AddSoftmax(graph_, masked_scores, "softmax");
+    auto output = AddMatMul(graph_, softmax, v, "output_matmul");
+    if (output == nullptr || AddReturn(graph_, {output}) == nullptr) {
+      this->graph_ = nullptr;
+    }
+  }
+
+  ShapeVector mask_shape_;
+
+ private:
+  static CNodePtr AddMatMul(const FuncGraphPtr &graph, const AnfNodePtr &input1, const AnfNodePtr &input2,
+                            const std::string &name) {
+    if (input1 == nullptr || input2 == nullptr) {
+      return nullptr;
+    }
+    auto prim = std::make_unique<ops::MatMulFusion>();
+    MS_CHECK_TRUE_MSG(prim != nullptr, nullptr, "create MatMul primitivec failed");
+    prim->Init(false, false, ActivationType::NO_ACTIVATION);
+    auto prim_c = prim->GetPrim();
+    MS_CHECK_TRUE_MSG(prim_c != nullptr, nullptr, "prim_c is nullptr");
+    auto matmul = graph->NewCNode({NewValueNode(prim_c), input1, input2});
+    MS_CHECK_TRUE_MSG(matmul != nullptr, nullptr, "create MatMul failed");
+    matmul->set_fullname_with_scope(name);
+    return matmul;
+  }
+
+  static CNodePtr AddAdd(const FuncGraphPtr &graph, const AnfNodePtr &input1, const AnfNodePtr &input2,
+                         const std::string &name) {
+    if (input1 == nullptr || input2 == nullptr) {
+      return nullptr;
+    }
+    auto prim = std::make_unique<ops::AddFusion>();
+    MS_CHECK_TRUE_MSG(prim != nullptr, nullptr, "create AddFusion primitivec failed");
+    prim->Init(ActivationType::NO_ACTIVATION);
+    auto prim_c = prim->GetPrim();
+    MS_CHECK_TRUE_MSG(prim_c != nullptr, nullptr, "prim_c is nullptr");
+    auto add = graph->NewCNode({NewValueNode(prim_c), input1, input2});
+    MS_CHECK_TRUE_MSG(add != nullptr, nullptr, "create AddFusion failed");
+    add->set_fullname_with_scope(name);
+    return add;
+  }
+
+  static CNodePtr AddSoftmax(const FuncGraphPtr &graph, const AnfNodePtr &input, const std::string &name) {
+    if (input == nullptr) {
+      return nullptr;
+    }
+    auto prim = std::make_unique<ops::Softmax>();
+    MS_CHECK_TRUE_MSG(prim != nullptr, nullptr, "create Softmax primitivec failed");
+    prim->Init(-1);
+    auto prim_c = prim->GetPrim();
+    MS_CHECK_TRUE_MSG(prim_c != nullptr, nullptr, "prim_c is nullptr");
+    auto softmax = graph->NewCNode({NewValueNode(prim_c), input});
+    MS_CHECK_TRUE_MSG(softmax != nullptr, nullptr, "create Softmax failed");
+    softmax->set_fullname_with_scope(name);
+    return softmax;
+  }
+
+ protected:
+  int64_t batch_ = 2;
+  int64_t q_seq_ = 64;
+  int64_t k_seq_ = 128;
+  int64_t head_size_ = 32;
+};
+
+TEST_F(ScaledDotProductAttentionFusionInoutTest, test) {
+  mask_shape_ = {1, q_seq_, k_seq_};
+  ASSERT_EQ(DoTest(), true);
+  ASSERT_EQ(IsFused(), true);
+}
+
+// the kernel rejects a mask of rank lower than 2, so the fusion must keep the original subgraph
+TEST_F(ScaledDotProductAttentionFusionInoutTest, test_rank1_mask) {
+  mask_shape_ = {k_seq_};
+  ASSERT_EQ(DoTest(), true);
+  ASSERT_EQ(IsFused(), false);
+}
+
+TEST_F(ScaledDotProductAttentionFusionInoutTest, test_mask_with_dynamic_key_len) {
+  k_seq_ = -1;
+  mask_shape_ = {q_seq_, kMaskKeyLen};
+  ASSERT_EQ(DoTest(), true);
+  ASSERT_EQ(IsFused(), false);
+}
+}  // namespace mindspore
@@ -428,9 +428,11 @@ int BenchmarkBase::Init() {
   MS_LOG(INFO) << "NumThreads = " << this->flags_->num_threads_;
   MS_LOG(INFO) << "InterOpParallelNum = " << this->flags_->inter_op_parallel_num_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
+  MS_LOG(INFO) << "Bf16Priority = " << this->flags_->enable_bf16_;
   MS_LOG(INFO) << "EnableParallel = " << this->flags_->enable_parallel_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
   MS_LOG(INFO) << "EnableGLTexture = " << this->flags_->enable_gl_texture_;
+  MS_LOG(INFO) << "EnableMmapModel = " << this->flags_->enable_mmap_model_;
 
   std::cout << "ModelPath = " << this->flags_->model_file_ << std::endl;
   std::cout << "ModelType = " << this->flags_->model_type_ << std::endl;
@@ -445,9 +447,11 @@ int BenchmarkBase::Init() {
   std::cout << "NumThreads = " << this->flags_->num_threads_ << std::endl;
   std::cout << "InterOpParallelNum = " << this->flags_->inter_op_parallel_num_ << std::endl;
   std::cout << "Fp16Priority = " << this->flags_->enable_fp16_ << std::endl;
+  std::cout << "Bf16Priority = " << this->flags_->enable_bf16_ << std::endl;
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
   std::cout << "EnableGLTexture = " << this->flags_->enable_gl_texture_ << std::endl;
+  std::cout << "EnableMmapModel = " << this->flags_->enable_mmap_model_ << std::endl;
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
     std::cerr << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0" << std::endl;
@@ -524,6 +528,35 @@ int BenchmarkBase::Init() {
   return RET_OK;
 }
 
+void BenchmarkBase::PrintMemoryUsage(const std::string &stage) {
+#if defined(__linux__) || defined(__ANDROID__)
+  std::ifstream status_file("/proc/self/status");
+  if (!status_file.is_open()) {
+    MS_LOG(WARNING) << "Open /proc/self/status failed.";
+    return;
+  }
+  std::string line;
+  std::string rss;
+  std::string peak_rss;
+  while (std::getline(status_file, line)) {
+    auto pos = line.find(':');
+    auto value_pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos || value_pos == std::string::npos) {
+      continue;
+    }
+    auto key = line.substr(0, pos);
+    auto value = line.substr(value_pos);
+    if (key == "VmRSS") {
+      rss = value;
+    } else if (key == "VmHWM") {
+      peak_rss = value;
+    }
+  }
+  MS_LOG(INFO) << stage << " RSS = " << rss << ", PeakRSS = " << peak_rss;
+  std::cout << stage << " RSS = " << rss << ", PeakRSS = " << peak_rss << std::endl;
+#endif
+}
+
 int BenchmarkBase::PrintResult(const std::vector<std::string> &title,
                                const std::map<std::string, std::pair<int, float>> &result) {
   std::vector<size_t> columnLenMax(kPrintColNum);
@@ -128,6 +128,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loop_count_, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
+    AddFlag(&BenchmarkFlags::enable_bf16_, "enableBf16",
+            "Enable bfloat16 compute of the cpu kernels and report the latency and output delta to float32", false);
     AddFlag(&BenchmarkFlags::enable_parallel_, "enableParallel", "Enable subgraph parallel : true | false", false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
@@ -157,6 +159,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::inter_op_parallel_num_, "interOpParallelNum", "parallel number of operators in predict",
             1);
     AddFlag(&BenchmarkFlags::enable_gl_texture_, "enableGLTexture", "Enable GlTexture2D", false);
+    AddFlag(&BenchmarkFlags::enable_mmap_model_, "enableMmapModel", "Load model file by mmap : true | false", false);
   }
 
   ~BenchmarkFlags() override = default;
@@ -188,7 +191,9 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loop_count_ = 10;
   int num_threads_ = 2;
   bool enable_fp16_ = false;
+  bool enable_bf16_ = false;
   bool enable_gl_texture_ = false;
+  bool enable_mmap_model_ = false;
   bool enable_parallel_ = false;
   int warm_up_loop_count_ = 3;
   // MarkAccuracy
@@ -255,6 +260,8 @@ class MS_API BenchmarkBase {
 
   int PrintResult(const std::vector<std::string> &title, const std::map<std::string, std::pair<int, float>> &result);
 
+  void PrintMemoryUsage(const std::string &stage);
+
 #ifdef ENABLE_ARM64
   int PrintPerfResult(const std::vector<std::string> &title,
                       const std::map<std::string, std::pair<int, struct PerfCount>> &result);
@@ -23,6 +23,7 @@
 #include <functional>
 #include <iomanip>
 #include <limits>
+#include <cmath>
 #include "src/common/common.h"
 #include "src/tensor.h"
 #include "tools/common/string_util.h"
@@ -499,6 +500,7 @@ int BenchmarkUnifiedApi::InitMSContext(const std::shared_ptr<mindspore::Context>
   // CPU priority is behind GPU and NPU
   std::shared_ptr<CPUDeviceInfo> device_info = std::make_shared<CPUDeviceInfo>();
   device_info->SetEnableFP16(flags_->enable_fp16_);
+  device_info->SetEnableBF16(flags_->enable_bf16_);
   device_info->SetProvider(flags_->provider_);
   device_list.push_back(device_info);
 
@@ -897,6 +899,7 @@ int BenchmarkUnifiedApi::MarkPerformance() {
            flags_->model_file_.substr(flags_->model_file_.find_last_of(DELIM_SLASH) + 1).c_str(), flags_->num_threads_,
            time_min / kFloatMSEC, time_max / kFloatMSEC, time_avg / kFloatMSEC);
   }
+  PrintMemoryUsage("Inference");
   return RET_OK;
 }
 
@@ -954,6 +957,127 @@ int BenchmarkUnifiedApi::MarkAccuracy() {
   return RET_OK;
 }
 
+int BenchmarkUnifiedApi::CompareBf16WithFp32(mindspore::ModelType model_type) {
+  // a second model with bf16 compute off runs the same inputs, so the deltas only come from the bf16 kernels
+  std::cout << "Compare bfloat16 with float32" << std::endl;
+  if (!flags_->crypto_lib_path_.empty()) {
+    std::cout << "Skip the bfloat16 comparison of an encrypted model" << std::endl;
+    return RET_OK;
+  }
+  auto context = std::make_shared<mindspore::Context>();
+  if (context == nullptr) {
+    MS_LOG(ERROR) << "New context failed.";
+    return RET_ERROR;
+  }
+  flags_->enable_bf16_ = false;
+  auto status = InitMSContext(context);
+  flags_->enable_bf16_ = true;
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "InitMSContext failed.";
+    return RET_ERROR;
+  }
+  mindspore::Model fp32_model;
+  if (!flags_->config_file_.empty()) {
+    (void)fp32_model.LoadConfig(flags_->config_file_);
+  }
+  if (fp32_model.Build(flags_->model_file_, model_type, context) != kSuccess) {
+    MS_LOG(ERROR) << "Build float32 model failed.";
+    std::cerr << "Build float32 model failed." << std::endl;
+    return RET_ERROR;
+  }
+  auto fp32_inputs = fp32_model.GetInputs();
+  if (!flags_->resize_dims_.empty()) {
+    std::vector<std::vector<int64_t>> resize_dims;
+    (void)std::transform(flags_->resize_dims_.begin(), flags_->resize_dims_.end(), std::back_inserter(resize_dims),
+                         [&](auto &shapes) { return this->ConverterToInt64Vector<int>(shapes); });
+    if (fp32_model.Resize(fp32_inputs, resize_dims) != kSuccess) {
+      MS_LOG(ERROR) << "Resize float32 model failed.";
+      return RET_ERROR;
+    }
+    fp32_inputs = fp32_model.GetInputs();
+  }
+  if (fp32_inputs.size() != ms_inputs_for_api_.size()) {
+    MS_LOG(ERROR) << "Input number of float32 model mismatch: " << fp32_inputs.size();
+    return RET_ERROR;
+  }
+  for (size_t i = 0; i < fp32_inputs.size(); i++) {
+    auto src = ms_inputs_for_api_[i].MutableData();
+    auto dst = fp32_inputs[i].MutableData();
+    if (src == nullptr || dst == nullptr || fp32_inputs[i].DataSize() != ms_inputs_for_api_[i].DataSize()) {
+      MS_LOG(ERROR) << "Copy input " << fp32_inputs[i].Name() << " to float32 model failed.";
+      return RET_ERROR;
+    }
+    memcpy(dst, src, fp32_inputs[i].DataSize());
+  }
+
+  std::vector<MSTensor> bf16_outputs;
+  std::vector<MSTensor> fp32_outputs;
+  auto run_loops = [&](mindspore::Model *model, const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                       uint64_t *time_avg) {
+    *time_avg = 0;
+    for (int i = 0; i < flags_->warm_up_loop_count_; i++) {
+      if (model->Predict(inputs, outputs) != kSuccess) {
+        return RET_ERROR;
+      }
+    }
+    int loop_count = std::max(flags_->loop_count_, 1);
+    for (int i = 0; i < loop_count; i++) {
+      auto start = GetTimeUs();
+      if (model->Predict(inputs, outputs) != kSuccess) {
+        return RET_ERROR;
+      }
+      *time_avg += GetTimeUs() - start;
+    }
+    *time_avg /= static_cast<uint64_t>(loop_count);
+    return RET_OK;
+  };
+  uint64_t bf16_time = 0;
+  uint64_t fp32_time = 0;
+  if (run_loops(&ms_model_, ms_inputs_for_api_, &bf16_outputs, &bf16_time) != RET_OK ||
+      run_loops(&fp32_model, fp32_inputs, &fp32_outputs, &fp32_time) != RET_OK) {
+    MS_LOG(ERROR) << "Inference error ";
+    std::cerr << "Inference error " << std::endl;
+    return RET_ERROR;
+  }
+  printf("Bf16AvgRunTime = %f ms, Fp32AvgRunTime = %f ms, Speedup = %f\n", bf16_time / kFloatMSEC,
+         fp32_time / kFloatMSEC, bf16_time == 0 ? 0.0f : static_cast<float>(fp32_time) / bf16_time);
+
+  if (bf16_outputs.size() != fp32_outputs.size()) {
+    MS_LOG(ERROR) << "Output number of bfloat16 and float32 model mismatch.";
+    return RET_ERROR;
+  }
+  for (size_t i = 0; i < bf16_outputs.size(); i++) {
+    auto &bf16_out = bf16_outputs[i];
+    auto &fp32_out = fp32_outputs[i];
+    if (bf16_out.DataType() != DataType::kNumberTypeFloat32 || fp32_out.DataType() != DataType::kNumberTypeFloat32 ||
+        bf16_out.ElementNum() != fp32_out.ElementNum()) {
+      std::cout << "Skip output " << bf16_out.Name() << std::endl;
+      continue;
+    }
+    auto bf16_data = reinterpret_cast<const float *>(bf16_out.Data().get());
+    auto fp32_data = reinterpret_cast<const float *>(fp32_out.Data().get());
+    if (bf16_data == nullptr || fp32_data == nullptr) {
+      MS_LOG(ERROR) << "Output " << bf16_out.Name() << " data is nullptr.";
+      return RET_ERROR;
+    }
+    double abs_sum = 0.0;
+    double ref_sum = 0.0;
+    double abs_max = 0.0;
+    auto element_num = bf16_out.ElementNum();
+    for (int64_t j = 0; j < element_num; j++) {
+      double diff = std::fabs(static_cast<double>(bf16_data[j]) - fp32_data[j]);
+      abs_sum += diff;
+      ref_sum += std::fabs(static_cast<double>(fp32_data[j]));
+      abs_max = std::max(abs_max, diff);
+    }
+    double mean_abs = element_num > 0 ? abs_sum / element_num : 0.0;
+    double relative = ref_sum > 0.0 ? abs_sum / ref_sum : 0.0;
+    printf("Output %s: MeanAbsError = %e, MaxAbsError = %e, RelativeError = %e\n", bf16_out.Name().c_str(), mean_abs,
+           abs_max, relative);
+  }
+  return RET_OK;
+}
+
 int BenchmarkUnifiedApi::PrintInputData() {
   for (size_t i = 0; i < ms_inputs_for_api_.size(); i++) {
     mindspore::MSTensor input = ms_inputs_for_api_[i];
@@ -1238,11 +1362,19 @@ int BenchmarkUnifiedApi::RunBenchmark() {
   }
 #endif
 
+  if (flags_->enable_mmap_model_) {
+    ms_model_.UpdateConfig(kModelLoad, std::make_pair(kModelLoadMmap, "true"));
+  }
+  auto start_load_time = GetTimeUs();
   status = CompileGraph(model_type, context, model_name);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "Compile graph failed.";
     return status;
   }
+  auto end_load_time = GetTimeUs();
+  MS_LOG(INFO) << "ModelLoadTime = " << ((end_load_time - start_load_time) / kFloatMSEC) << " ms";
+  std::cout << "ModelLoadTime = " << ((end_load_time - start_load_time) / kFloatMSEC) << " ms" << std::endl;
+  PrintMemoryUsage("ModelLoad");
   if (!flags_->resize_dims_.empty()) {
     std::vector<std::vector<int64_t>> resize_dims;
     (void)std::transform(flags_->resize_dims_.begin(), flags_->resize_dims_.end(), std::back_inserter(resize_dims),
@@ -1284,6 +1416,14 @@ int BenchmarkUnifiedApi::RunBenchmark() {
       return status;
     }
   }
+  if (flags_->enable_bf16_ && flags_->device_ == "CPU") {
+    status = CompareBf16WithFp32(model_type);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Run CompareBf16WithFp32 error: " << status;
+      std::cout << "Run CompareBf16WithFp32 error: " << status << std::endl;
+      return status;
+    }
+  }
   if (flags_->dump_tensor_data_) {
     std::cout << "Dumped file is saved to : " + dump_file_output_dir_ << std::endl;
   }
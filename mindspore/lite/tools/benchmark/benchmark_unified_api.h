@@ -116,6 +116,8 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
 
   int MarkAccuracy();
 
+  int CompareBf16WithFp32(mindspore::ModelType model_type);
+
   void UpdateDistributionName(const std::shared_ptr<mindspore::Context> &context, std::string *name);
 
  private:
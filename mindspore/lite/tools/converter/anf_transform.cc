@@ -52,6 +52,7 @@
 #include "tools/optimizer/fusion/tensor_dot_fusion.h"
 #include "tools/optimizer/fusion/multi_head_attention_fusion.h"
 #include "tools/optimizer/fusion/glu_fusion.h"
+#include "tools/optimizer/fusion/scaled_dot_product_attention_fusion.h"
 #include "tools/optimizer/fusion/tflite_rel_pos_multi_head_attention_fusion.h"
 #include "tools/optimizer/fusion/matmul_add_fusion.h"
 #include "tools/optimizer/fusion/matmul_mul_fusion.h"
@@ -323,6 +324,10 @@ int AnfTransform::RunFusionPass(const FuncGraphPtr &old_graph, const std::shared
 #ifdef ENABLE_CLOUD_FUSION_INFERENCE
   fusions.push_back(std::make_shared<opt::MultiHeadAttentionFusion>());
 #endif
+  // runs after the multi-head attention fusion so that it only picks up the attention cores left over
+  if (param->device.find("Ascend") == std::string::npos) {
+    fusions.push_back(std::make_shared<opt::ScaledDotProductAttentionFusion>());
+  }
   for (size_t index = 0; index < fusions.size(); index++) {
     auto pass_ptr = fusions.at(index);
     MS_CHECK_TRUE_RET(pass_ptr != nullptr, RET_ERROR);
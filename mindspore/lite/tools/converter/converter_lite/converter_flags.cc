@@ -49,6 +49,10 @@ Flags::Flags() {
   AddFlag(&Flags::saveFP16Str, "fp16",
           "Serialize const tensor in Float16 data type, only effective for const tensor in Float32 data type. on | off",
           "off");
+  AddFlag(&Flags::roundBF16Str, "bf16",
+          "Round the Float32 weights of the ops with a bfloat16 cpu kernel to bfloat16 values, the data type stays "
+          "Float32. Used with the bfloat16 inference of the cpu. on | off",
+          "off");
   AddFlag(&Flags::trainModelIn, "trainModel",
           "whether the model is going to be trained on device. "
           "true | false",
@@ -218,6 +222,22 @@ int Flags::InitSaveFP16() {
   return RET_OK;
 }
 
+int Flags::InitRoundBF16() {
+  if (roundBF16Str == "on") {
+    roundBF16 = true;
+  } else if (roundBF16Str == "off") {
+    roundBF16 = false;
+  } else {
+    std::cerr << "Init bf16 failed." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+  if (roundBF16 && saveFP16) {
+    std::cerr << "fp16 and bf16 can not be both on." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+  return RET_OK;
+}
+
 int Flags::InitPreInference() {
   if (this->inferStr == "true") {
     this->infer = true;
@@ -306,6 +326,11 @@ int Flags::Init(int argc, const char **argv) {
     std::cerr << "Init save fp16 failed." << std::endl;
     return RET_INPUT_PARAM_INVALID;
   }
+  ret = InitRoundBF16();
+  if (ret != RET_OK) {
+    std::cerr << "Init bf16 failed." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
 
   ret = InitInputOutputDataType();
   if (ret != RET_OK) {
@@ -39,6 +39,7 @@ class Flags : public virtual mindspore::lite::FlagParser {
   int InitEncrypt();
   int InitPreInference();
   int InitSaveFP16();
+  int InitRoundBF16();
   int InitNoFusion();
   int InitExportMindIR();
   int Init(int argc, const char **argv);
@@ -51,6 +52,8 @@ class Flags : public virtual mindspore::lite::FlagParser {
   std::string weightFile;
   std::string saveFP16Str = "off";
   bool saveFP16 = false;
+  std::string roundBF16Str = "off";
+  bool roundBF16 = false;
   std::string noFusionStr = "false";
   bool disableFusion = false;
   std::string inputDataTypeStr;
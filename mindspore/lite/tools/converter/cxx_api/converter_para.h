@@ -44,6 +44,7 @@ struct ConverterPara {
   std::string config_file;
   std::map<std::string, std::map<std::string, std::string>> config_param;
   bool weight_fp16 = false;
+  bool weight_bf16 = false;
   std::map<std::string, std::vector<int64_t>> input_shape;
   Format input_format = NHWC;
   Format spec_input_format = DEFAULT_FORMAT;
@@ -30,6 +30,7 @@
 #include "tools/converter/legacy_optimizer/graph/infer_quant_param_pass.h"
 #include "tools/converter/legacy_optimizer/graph/set_unused_quant_param_to_default_pass.h"
 #include "tools/converter/legacy_optimizer/graph/convert_fp32_to_fp16_pass.h"
+#include "tools/converter/legacy_optimizer/graph/round_fp32_to_bf16_pass.h"
 #include "tools/converter/legacy_optimizer/graph/subgraph_node_pass.h"
 #include "tools/converter/legacy_optimizer/graph/subgraph_tensor_pass.h"
 
@@ -137,6 +138,7 @@ int GraphDefTransform::Transform(const std::shared_ptr<ConverterPara> &param) {
     forming_model_optimizer.AddPass(new (std::nothrow) InferShapePass(param->fmk_type));
     forming_model_optimizer.AddPass(new (std::nothrow) SetUnusedQuantParamToDefaultPass(param));
     forming_model_optimizer.AddPass(new (std::nothrow) TensorNamePass());
+    forming_model_optimizer.AddPass(new (std::nothrow) RoundFP32ToBF16Pass(param->weight_bf16));
     forming_model_optimizer.AddPass(new (std::nothrow) ConvertFP32ToFP16Pass(param->weight_fp16));
     status = forming_model_optimizer.Run(graph_defT_);
     if (status != RET_OK) {
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/graph/round_fp32_to_bf16_pass.h"
+#include <vector>
+#include "tools/converter/converter_context.h"
+#include "src/common/log_adapter.h"
+#include "tools/common/tensor_util.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "src/common/log_util.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+// the weight inputs read as bf16 by the cpu bf16 kernels, the bias stays fp32
+std::vector<size_t> GetBf16WeightIndex(schema::PrimitiveType type) {
+  switch (type) {
+    case schema::PrimitiveType_MatMulFusion:
+    case schema::PrimitiveType_FullConnection:
+      return {kWeightIndex};
+    case schema::PrimitiveType_LayerNormFusion:
+      return {SECOND_INPUT, THIRD_INPUT};
+    default:
+      return {};
+  }
+}
+}  // namespace
+
+STATUS RoundFP32ToBF16Pass::Run(schema::MetaGraphT *graph) {
+  if (!need_round_) {
+    return RET_NO_CHANGE;
+  }
+  CHECK_NULL_RETURN(graph);
+  std::set<uint32_t> rounded;
+  for (auto &node : graph->nodes) {
+    CHECK_NULL_RETURN(node);
+    if (node->primitive == nullptr) {
+      continue;
+    }
+    for (auto index : GetBf16WeightIndex(node->primitive->value.type)) {
+      if (index >= node->inputIndex.size() || rounded.count(node->inputIndex.at(index)) != 0) {
+        continue;
+      }
+      auto tensor_index = node->inputIndex.at(index);
+      MS_CHECK_TRUE_RET(tensor_index < graph->allTensors.size(), RET_ERROR);
+      auto &tensor = graph->allTensors.at(tensor_index);
+      CHECK_NULL_RETURN(tensor);
+      if (tensor->dataType != kNumberTypeFloat32 || tensor->data.empty()) {
+        continue;
+      }
+      auto ele_num = lite::GetShapeSize(tensor->dims);
+      if (tensor->data.size() != ele_num * sizeof(float)) {
+        MS_LOG(ERROR) << "Tensor data length error.";
+        ReturnCode::GetSingleReturnCode()->UpdateReturnCode(RET_ERROR);
+        return RET_ERROR;
+      }
+      auto fp32_data = reinterpret_cast<float *>(tensor->data.data());
+      for (size_t i = 0; i < ele_num; i++) {
+        fp32_data[i] = RoundFp32ToBf16(fp32_data[i]);
+      }
+      rounded.insert(tensor_index);
+    }
+  }
+  return rounded.empty() ? RET_NO_CHANGE : RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_ROUND_FP32_TO_BF16_PASS_H_
+#define MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_ROUND_FP32_TO_BF16_PASS_H_
+
+#include <set>
+#include "tools/converter/optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// Rounds the const fp32 weights of the ops that have a bf16 cpu kernel to bf16 values. The tensors stay fp32, so the
+// fp32 fallback kernels see the same weights as the bf16 ones and the accuracy of a bf16 run can be checked anywhere.
+class RoundFP32ToBF16Pass : public GraphPass {
+ public:
+  explicit RoundFP32ToBF16Pass(bool round_bf16) : need_round_(round_bf16) {}
+
+  ~RoundFP32ToBF16Pass() override = default;
+
+  STATUS Run(schema::MetaGraphT *graph) override;
+
+ private:
+  bool need_round_ = false;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_ROUND_FP32_TO_BF16_PASS_H_
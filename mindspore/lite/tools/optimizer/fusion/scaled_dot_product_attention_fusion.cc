@@ -0,0 +1,284 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define USE_DEPRECATED_API
+#include "tools/optimizer/fusion/scaled_dot_product_attention_fusion.h"
+#include <memory>
+#include <vector>
+#include "ops/scaled_dot_product_attention.h"
+#include "include/common/utils/utils.h"
+#include "ops/op_utils.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// below this key length the score matrix fits in cache and the matmul + softmax kernels are as fast
+constexpr int64_t kMinKeySeqLen = 128;
+constexpr size_t kMinAttentionRank = 2;
+
+bool HasNoActivation(const PrimitivePtr &prim) {
+  auto act = prim->GetAttr(ops::kActivationType);
+  return act == nullptr || GetValue<int64_t>(act) == static_cast<int64_t>(NO_ACTIVATION);
+}
+
+bool GetBoolAttr(const PrimitivePtr &prim, const std::string &name) {
+  auto value = prim->GetAttr(name);
+  return value != nullptr && GetValue<bool>(value);
+}
+
+bool IsElementwiseWithoutActivation(const AnfNodePtr &node) {
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr || cnode->size() != kInputSizeThree) {
+    return false;
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  return prim != nullptr && HasNoActivation(prim);
+}
+
+// matmul without bias and activation, whose left operand is not transposed
+bool IsPlainMatMul(const AnfNodePtr &node) {
+  if (!utils::isa<CNodePtr>(node) || !CheckPrimitiveType(node, prim::kPrimMatMulFusion)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode->size() != kInputSizeThree) {
+    return false;
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  return prim != nullptr && HasNoActivation(prim) && !GetBoolAttr(prim, ops::kTransposeA);
+}
+
+bool IsScaleNode(const AnfNodePtr &node) {
+  return CheckPrimitiveType(node, prim::kPrimMulFusion) || CheckPrimitiveType(node, prim::kPrimRealDiv) ||
+         CheckPrimitiveType(node, prim::kPrimDivFusion);
+}
+
+bool GetConstScalar(const AnfNodePtr &node, float *value) {
+  auto tensor = GetTensorInfo(node);
+  if (tensor == nullptr || tensor->data_type() != kNumberTypeFloat32 || tensor->DataSize() != 1 ||
+      tensor->data_c() == nullptr) {
+    return false;
+  }
+  *value = *reinterpret_cast<float *>(tensor->data_c());
+  return true;
+}
+
+bool IsFloat32(const AnfNodePtr &node) {
+  TypeId type_id = kTypeUnknown;
+  return GetDataTypeFromAnfNode(node, &type_id) == lite::RET_OK && type_id == kNumberTypeFloat32;
+}
+}  // namespace
+
+const BaseRef ScaledDotProductAttentionFusion::DefinePattern() const {
+  auto is_softmax = std::make_shared<CondVar>(IsSpecifiedNode<&prim::kPrimSoftmax>);
+  MS_CHECK_TRUE_RET(is_softmax != nullptr, {});
+  auto is_scores = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(is_scores != nullptr, {});
+  auto is_matmul = std::make_shared<CondVar>(IsSpecifiedNode<&prim::kPrimMatMulFusion>);
+  MS_CHECK_TRUE_RET(is_matmul != nullptr, {});
+  auto is_value = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(is_value != nullptr, {});
+  VectorRef softmax_ref({is_softmax, is_scores});
+  return VectorRef({is_matmul, softmax_ref, is_value});
+}
+
+bool ScaledDotProductAttentionFusion::CheckSoftmax(const CNodePtr &softmax) const {
+  auto prim = GetValueNode<PrimitivePtr>(softmax->input(0));
+  if (prim == nullptr || prim->GetAttr(ops::kAxis) == nullptr) {
+    return false;
+  }
+  auto axis = GetValue<std::vector<int64_t>>(prim->GetAttr(ops::kAxis));
+  if (axis.size() != 1) {
+    return false;
+  }
+  if (axis.front() == -1) {
+    return true;
+  }
+  ShapeVector shape;
+  if (FetchShapeFromAbstract(softmax->abstract(), &shape) != lite::RET_OK || IsDynamicRank(shape)) {
+    return false;
+  }
+  return axis.front() == static_cast<int64_t>(shape.size()) - 1;
+}
+
+CNodePtr ScaledDotProductAttentionFusion::GetScoreMatMul(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
+                                                         float *scale, AnfNodePtr *mask) const {
+  MS_ASSERT(func_graph != nullptr && node != nullptr && scale != nullptr && mask != nullptr);
+  *scale = 1.0f;
+  *mask = nullptr;
+  auto cur_node = node;
+  if (CheckPrimitiveType(cur_node, prim::kPrimAddFusion)) {
+    if (!IsElementwiseWithoutActivation(cur_node) || IsMultiOutputTensors(func_graph, cur_node)) {
+      return nullptr;
+    }
+    auto add = cur_node->cast<CNodePtr>();
+    // the operand coming from the score matmul is the scores, the other one is the additive mask
+    auto is_scores = [](const AnfNodePtr &input) {
+      return IsScaleNode(input) || CheckPrimitiveType(input, prim::kPrimMatMulFusion);
+    };
+    if (is_scores(add->input(kInputIndexOne))) {
+      cur_node = add->input(kInputIndexOne);
+      *mask = add->input(kInputIndexTwo);
+    } else if (is_scores(add->input(kInputIndexTwo))) {
+      cur_node = add->input(kInputIndexTwo);
+      *mask = add->input(kInputIndexOne);
+    } else {
+      return nullptr;
+    }
+  }
+  if (IsScaleNode(cur_node)) {
+    if (!IsElementwiseWithoutActivation(cur_node) || IsMultiOutputTensors(func_graph, cur_node)) {
+      return nullptr;
+    }
+    auto scale_node = cur_node->cast<CNodePtr>();
+    bool is_mul = CheckPrimitiveType(cur_node, prim::kPrimMulFusion);
+    float value = 1.0f;
+    if (GetConstScalar(scale_node->input(kInputIndexTwo), &value)) {
+      cur_node = scale_node->input(kInputIndexOne);
+    } else if (is_mul && GetConstScalar(scale_node->input(kInputIndexOne), &value)) {
+      cur_node = scale_node->input(kInputIndexTwo);
+    } else {
+      return nullptr;
+    }
+    if (!is_mul && value == 0.0f) {
+      return nullptr;
+    }
+    *scale = is_mul ? value : 1.0f / value;
+  }
+  if (!IsPlainMatMul(cur_node) || IsMultiOutputTensors(func_graph, cur_node)) {
+    return nullptr;
+  }
+  return cur_node->cast<CNodePtr>();
+}
+
+bool ScaledDotProductAttentionFusion::CheckShapes(const AnfNodePtr &q, const AnfNodePtr &k, const AnfNodePtr &v,
+                                                  const AnfNodePtr &mask, bool transpose_k) const {
+  if (!IsFloat32(q) || !IsFloat32(k) || !IsFloat32(v) || (mask != nullptr && !IsFloat32(mask))) {
+    return false;
+  }
+  ShapeVector q_shape;
+  ShapeVector k_shape;
+  ShapeVector v_shape;
+  if (FetchShapeFromAbstract(q->abstract(), &q_shape) != lite::RET_OK ||
+      FetchShapeFromAbstract(k->abstract(), &k_shape) != lite::RET_OK ||
+      FetchShapeFromAbstract(v->abstract(), &v_shape) != lite::RET_OK) {
+    return false;
+  }
+  if (IsDynamicRank(q_shape) || IsDynamicRank(k_shape) || IsDynamicRank(v_shape)) {
+    return false;
+  }
+  auto rank = q_shape.size();
+  if (rank < kMinAttentionRank || k_shape.size() != rank || v_shape.size() != rank) {
+    return false;
+  }
+  // the kernel does not broadcast q, k and v, unknown leading dims are expected to be equal at runtime
+  for (size_t i = 0; i < rank - kMinAttentionRank; ++i) {
+    auto q_dim = q_shape.at(i);
+    if ((q_dim > 0 && k_shape.at(i) > 0 && q_dim != k_shape.at(i)) ||
+        (q_dim > 0 && v_shape.at(i) > 0 && q_dim != v_shape.at(i))) {
+      return false;
+    }
+  }
+  auto k_seq = transpose_k ? k_shape.at(rank - kMinAttentionRank) : k_shape.back();
+  if (k_seq > 0 && k_seq < kMinKeySeqLen) {
+    return false;
+  }
+  return mask == nullptr || CheckMaskShape(mask, q_shape, k_seq);
+}
+
+// the kernel only broadcasts size-1 mask dims, so every mask dim has to be verified here against a static q and k
+bool ScaledDotProductAttentionFusion::CheckMaskShape(const AnfNodePtr &mask, const ShapeVector &q_shape,
+                                                     int64_t k_seq) const {
+  ShapeVector mask_shape;
+  if (FetchShapeFromAbstract(mask->abstract(), &mask_shape) != lite::RET_OK || IsDynamic(mask_shape)) {
+    return false;
+  }
+  auto rank = q_shape.size();
+  if (mask_shape.size() < kMinAttentionRank || mask_shape.size() > rank) {
+    return false;
+  }
+  if (k_seq <= 0 || mask_shape.back() != k_seq) {
+    return false;
+  }
+  // mask rows broadcast against q_seq, the leading mask dims against the leading dims of q
+  auto offset = rank - mask_shape.size();
+  for (size_t i = 0; i + 1 < mask_shape.size(); ++i) {
+    auto mask_dim = mask_shape.at(i);
+    if (mask_dim != 1 && mask_dim != q_shape.at(offset + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const AnfNodePtr ScaledDotProductAttentionFusion::Process(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
+                                                          const EquivPtr &) const {
+  if (func_graph == nullptr || node == nullptr) {
+    return nullptr;
+  }
+  if (!IsPlainMatMul(node)) {
+    return nullptr;
+  }
+  auto matmul = node->cast<CNodePtr>();
+  if (IsMarkedTrainOp(matmul)) {
+    return nullptr;
+  }
+  auto matmul_prim = GetValueNode<PrimitivePtr>(matmul->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, nullptr);
+  if (GetBoolAttr(matmul_prim, ops::kTransposeB)) {
+    return nullptr;
+  }
+  auto softmax = matmul->input(kInputIndexOne)->cast<CNodePtr>();
+  if (softmax == nullptr || !CheckSoftmax(softmax) || IsMultiOutputTensors(func_graph, softmax)) {
+    return nullptr;
+  }
+  float scale = 1.0f;
+  AnfNodePtr mask = nullptr;
+  auto score_matmul = GetScoreMatMul(func_graph, softmax->input(kInputIndexOne), &scale, &mask);
+  if (score_matmul == nullptr) {
+    return nullptr;
+  }
+  auto score_prim = GetValueNode<PrimitivePtr>(score_matmul->input(0));
+  MS_CHECK_TRUE_RET(score_prim != nullptr, nullptr);
+  bool transpose_k = GetBoolAttr(score_prim, ops::kTransposeB);
+  auto q = score_matmul->input(kInputIndexOne);
+  auto k = score_matmul->input(kInputIndexTwo);
+  auto v = matmul->input(kInputIndexTwo);
+  if (!CheckShapes(q, k, v, mask, transpose_k)) {
+    return nullptr;
+  }
+
+  auto attention_prim = std::make_shared<ops::ScaledDotProductAttention>();
+  MS_CHECK_TRUE_RET(attention_prim != nullptr, nullptr);
+  attention_prim->Init(scale, transpose_k);
+  auto attention_prim_c = attention_prim->GetPrim();
+  MS_CHECK_TRUE_RET(attention_prim_c != nullptr, nullptr);
+  std::vector<AnfNodePtr> inputs = {q, k, v};
+  if (mask != nullptr) {
+    inputs.push_back(mask);
+  }
+  auto attention_cnode = func_graph->NewCNode(attention_prim_c, inputs);
+  MS_CHECK_TRUE_RET(attention_cnode != nullptr, nullptr);
+  attention_cnode->set_fullname_with_scope(matmul->fullname_with_scope() + "_sdpa");
+  if (matmul->abstract() != nullptr) {
+    attention_cnode->set_abstract(matmul->abstract()->Clone());
+  }
+  MS_LOG(INFO) << "fuse attention to " << attention_cnode->fullname_with_scope() << ", scale: " << scale
+               << ", transpose_k: " << transpose_k;
+  return attention_cnode;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_SCALED_DOT_PRODUCT_ATTENTION_FUSION_H_
+#define MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_SCALED_DOT_PRODUCT_ATTENTION_FUSION_H_
+
+#include <string>
+#include "tools/optimizer/common/pattern_process_pass_extends.h"
+#include "tools/optimizer/common/gllo_utils.h"
+
+namespace mindspore {
+namespace opt {
+/// \brief Fuse MatMul(Softmax([Add]([Mul|Div](MatMul(q, k), scale), mask)), v) into ScaledDotProductAttention, whose
+/// cpu kernel streams key and value through an online softmax instead of storing the q_seq * k_seq scores.
+class ScaledDotProductAttentionFusion : public LitePatternProcessPass {
+ public:
+  explicit ScaledDotProductAttentionFusion(const std::string &name = "ScaledDotProductAttentionFusion",
+                                           bool multigraph = true)
+      : LitePatternProcessPass(name, multigraph) {}
+
+  ~ScaledDotProductAttentionFusion() override = default;
+
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  bool CheckSoftmax(const CNodePtr &softmax) const;
+  CNodePtr GetScoreMatMul(const FuncGraphPtr &func_graph, const AnfNodePtr &node, float *scale,
+                          AnfNodePtr *mask) const;
+  bool CheckShapes(const AnfNodePtr &q, const AnfNodePtr &k, const AnfNodePtr &v, const AnfNodePtr &mask,
+                   bool transpose_k) const;
+  bool CheckMaskShape(const AnfNodePtr &mask, const ShapeVector &q_shape, int64_t k_seq) const;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_SCALED_DOT_PRODUCT_ATTENTION_FUSION_H_
@@ -43,11 +43,14 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_autotune_profile_dir', 'get_autotune_profile_dir',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
            'set_fast_recovery', 'get_fast_recovery',
            'set_debug_mode', 'get_debug_mode',
            'set_error_samples_mode', 'get_error_samples_mode', 'ErrorSamplesMode',
+           'set_enable_unordered_connector', 'get_enable_unordered_connector',
+           'set_enable_jpeg_dct_scaling', 'get_enable_jpeg_dct_scaling',
            'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
 
 INT32_MAX = 2147483647
@@ -592,6 +595,47 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_autotune_profile_dir(profile_dir):
+    """
+    Set the directory of the AutoTune profiles, so that a data pipeline run again on a host with the same number
+    of CPU threads starts from the configuration AutoTune converged to, instead of tuning from scratch.
+
+    When the pipeline is compiled, the num_parallel_workers and prefetch_size saved in the profile of the same
+    pipeline are applied. When AutoTune is enabled, it saves the tuned configuration to the profile at the end of
+    the tuning. A profile is found by a fingerprint of the optimized pipeline, so any change of the pipeline other
+    than num_parallel_workers and prefetch_size uses another profile.
+
+    Args:
+        profile_dir (str): The directory of the AutoTune profiles, it is created if it does not exist.
+            The empty string disables the profiles. System default: "".
+
+    Raises:
+        TypeError: If `profile_dir` is not of type str.
+
+    Examples:
+        >>> ds.config.set_autotune_profile_dir("/path/to/autotune_profiles")
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(profile_dir, str):
+        raise TypeError("profile_dir must be of type str.")
+    if profile_dir:
+        profile_dir = os.path.realpath(profile_dir)
+    _config.set_autotune_profile_dir(profile_dir)
+
+
+def get_autotune_profile_dir():
+    """
+    Get the directory of the AutoTune profiles.
+
+    Returns:
+        str, the directory of the AutoTune profiles, the empty string if the profiles are disabled.
+
+    Examples:
+        >>> profile_dir = ds.config.get_autotune_profile_dir()
+    """
+    return _config.get_autotune_profile_dir()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -880,6 +924,75 @@ def get_debug_mode():
     return _config.get_debug_mode()
 
 
+def set_enable_unordered_connector(enable):
+    """
+    Set whether map operations may output rows in any order when no downstream operation relies on the order,
+    i.e. the rows only go through map, project or rename before reaching a shuffle or a batch operation.
+    The workers of such a map operation no longer wait for each other, which improves the throughput when
+    the processing time of the rows varies a lot, at the cost of results that are not reproducible across runs.
+    It has no effect in debug mode.
+
+    Args:
+        enable (bool): Whether to enable the unordered output of map operations. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_enable_unordered_connector(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_unordered_connector(enable)
+
+
+def get_enable_unordered_connector():
+    """
+    Get whether map operations may output rows in any order when no downstream operation relies on the order.
+
+    Returns:
+        bool, whether the unordered output of map operations is enabled.
+
+    Examples:
+        >>> is_unordered = ds.config.get_enable_unordered_connector()
+    """
+    return _config.get_enable_unordered_connector()
+
+
+def set_enable_jpeg_dct_scaling(enable):
+    """
+    Set whether jpeg images may be decoded at a reduced scale (1/2, 1/4 or 1/8) in the DCT domain when they are
+    resized down right after decoding, i.e. by `RandomCropDecodeResize` , or by `Decode` followed by `Resize`
+    and an optional `CenterCrop` in the same map operation. Decoding fewer pixels is faster, but the results differ
+    slightly from decoding the full image.
+
+    Args:
+        enable (bool): Whether to enable decoding jpeg images at a reduced DCT scale. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_enable_jpeg_dct_scaling(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_jpeg_dct_scaling(enable)
+
+
+def get_enable_jpeg_dct_scaling():
+    """
+    Get whether jpeg images may be decoded at a reduced DCT scale when they are resized down right after decoding.
+
+    Returns:
+        bool, whether decoding jpeg images at a reduced DCT scale is enabled.
+
+    Examples:
+        >>> is_dct_scaling = ds.config.get_enable_jpeg_dct_scaling()
+    """
+    return _config.get_enable_jpeg_dct_scaling()
+
+
 class ErrorSamplesMode(IntEnum):
     """
     An enumeration for `error_samples_mode` .
@@ -326,6 +326,34 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_blob_layout(self, blob_layout, blob_compression="none"):
+        """
+        Set the layout of blob data. In the default 'row' layout, all the blob fields of a sample are stored \
+        together and read together. In the 'columnar' layout, each blob field of a sample is stored and \
+        compressed separately, so that only the blob fields in `columns_list` of MindDataset are read from disk.
+
+        Note:
+            It should be called before writing data to the new MindRecord files.
+
+        Args:
+            blob_layout (str): Layout of blob data, 'row' or 'columnar'.
+            blob_compression (str, optional): Compression of each blob field in the 'columnar' layout,
+                'none' or 'zlib'. Default: 'none'. 'zlib' trades the decompression cost of reading for smaller files,
+                it is only available when MindSpore is built with zlib.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If failed to set blob layout.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> status = writer.set_blob_layout("columnar")
+        """
+        return self._writer.set_blob_layout(blob_layout, blob_compression)
+
     def commit(self):
         """
         Flush data in memory to disk and generate the corresponding database files.
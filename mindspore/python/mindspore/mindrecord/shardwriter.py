@@ -126,6 +126,26 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_blob_layout(self, blob_layout, blob_compression):
+        """
+        Set the layout of blob data.
+
+        Args:
+           blob_layout (str): Layout of blob data, 'row' or 'columnar'.
+           blob_compression (str): Compression of each blob column in the columnar layout, 'none' or 'zlib'.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If failed to set blob layout.
+        """
+        ret = self._writer.set_blob_layout(blob_layout, blob_compression)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.critical("Failed to set blob layout.")
+            raise MRMSetHeaderError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
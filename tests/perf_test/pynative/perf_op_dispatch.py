@@ -0,0 +1,79 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Microbenchmark of the per-op dispatch overhead of PyNative, from Python to kernel launch."""
+import time
+import numpy as np
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common.api import _pynative_executor
+from mindspore.ops import composite as C
+from mindspore.ops import operations as P
+
+WARMUP_STEPS = 100
+BENCHMARK_STEPS = 2000
+
+
+class ChainNet(nn.Cell):
+    """A chain of tiny ops, the time of which is dominated by the dispatch."""
+
+    def __init__(self, op_num):
+        super(ChainNet, self).__init__()
+        self.op_num = op_num
+        self.add = P.Add()
+        self.mul = P.Mul()
+
+    def construct(self, x, y):
+        for _ in range(self.op_num):
+            x = self.add(x, y)
+            x = self.mul(x, y)
+        return x
+
+
+def measure_us_per_op(func, op_num_per_step):
+    for _ in range(WARMUP_STEPS):
+        func()
+    _pynative_executor.sync()
+    start = time.perf_counter()
+    for _ in range(BENCHMARK_STEPS):
+        func()
+    # Wait for the launched kernels, so the time covers the path from Python to kernel launch
+    _pynative_executor.sync()
+    cost = time.perf_counter() - start
+    return cost * 1e6 / (BENCHMARK_STEPS * op_num_per_step)
+
+
+def perf_op_dispatch():
+    """Print the dispatch overhead per op of tiny ops in PyNative mode, with and without grad."""
+    context.set_context(mode=context.PYNATIVE_MODE, device_target="CPU")
+    op_num = 4
+    x = Tensor(np.ones([2, 2]).astype(np.float32))
+    y = Tensor(np.full([2, 2], 0.5).astype(np.float32))
+
+    single_add = P.Add()
+    us_per_op = measure_us_per_op(lambda: single_add(x, y), 1)
+    print("PyNative single op dispatch: {:.2f} us/op".format(us_per_op))
+
+    net = ChainNet(op_num)
+    us_per_op = measure_us_per_op(lambda: net(x, y), 2 * op_num)
+    print("PyNative forward op dispatch: {:.2f} us/op".format(us_per_op))
+
+    grad_net = C.GradOperation()(net)
+    us_per_op = measure_us_per_op(lambda: grad_net(x, y), 2 * op_num)
+    print("PyNative forward and backward op dispatch: {:.2f} us/forward op".format(us_per_op))
+
+
+if __name__ == '__main__':
+    perf_op_dispatch()
@@ -16,6 +16,7 @@ import os
 import re
 import shutil
 import subprocess
+import time
 import pytest
 import numpy as np
 
@@ -109,6 +110,51 @@ def run_twice_with_different_networks(file_name_first, file_name_second, cache_p
     shutil.rmtree(cache_path)
 
 
+def get_kernel_select_cache_hit_miss(log_file_name):
+    with open(log_file_name, "r") as f:
+        data = f.read()
+    # the counts are accumulated in the process, the last log has the total
+    counts = re.findall(r"Kernel select cache hit: (\d+), miss: (\d+)", data)
+    assert counts
+    return int(counts[-1][0]), int(counts[-1][1])
+
+
+def run_twice_and_check_kernel_select_cache(file_name, cache_path, log_file_name_first, log_file_name_second):
+    # Clear compile cache folder
+    shutil.rmtree(cache_path, ignore_errors=True)
+    assert not os.path.exists(cache_path)
+
+    # First run without compile cache
+    cmd_first = f"GLOG_v=1 python " + file_name + " '" + cache_path + "' > " + log_file_name_first + " 2>&1"
+    start_time = time.time()
+    subprocess.check_output(cmd_first, shell=True)
+    first_time = time.time() - start_time
+    assert os.path.exists(cache_path + "/rank_0/graph_cache/kernel_select_cache.json")
+    first_hit, first_miss = get_kernel_select_cache_hit_miss(log_file_name_first)
+    assert first_hit == 0
+    assert first_miss > 0
+
+    # Second run with both the front-end and the kernel select cache
+    cmd_second = f"GLOG_v=1 python " + file_name + " '" + cache_path + "' > " + log_file_name_second + " 2>&1"
+    start_time = time.time()
+    subprocess.check_output(cmd_second, shell=True)
+    second_time = time.time() - start_time
+    with open(log_file_name_second, "r") as f_second:
+        data_second = f_second.read()
+    assert "Use the kernel select cache of" in data_second
+    second_hit, second_miss = get_kernel_select_cache_hit_miss(log_file_name_second)
+    assert second_hit > 0
+    assert second_miss < first_miss
+    # the wall clock time also includes the front-end compile cache and varies with the machine, only report it
+    print(f"Kernel select cache hit: {second_hit}, miss: {second_miss}. Startup and run time without cache: "
+          f"{first_time:.2f}s, with cache: {second_time:.2f}s")
+
+    # Clean files
+    os.remove(log_file_name_first)
+    os.remove(log_file_name_second)
+    shutil.rmtree(cache_path)
+
+
 def run_two_cells_networks_once(file_name, cache_path, log_file_name):
     # Clear compile cache folder
     if os.path.exists(cache_path):
@@ -327,3 +373,18 @@ def test_compile_cache_run_two_cells_once():
     Expectation: success.
     """
     run_two_cells_networks_once("run_lenet_two_cells.py", "./lenet_two_cells", "lenet_two_cells.txt")
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_ascend_training
+@pytest.mark.platform_arm_ascend_training
+@pytest.mark.env_onecard
+def test_compile_cache_lenet_startup_time():
+    """
+    Feature: Compile cache.
+    Description: Test the kernel select cache saved by the first run is hit by the second run, and report the startup
+        time of both runs.
+    Expectation: success.
+    """
+    run_twice_and_check_kernel_select_cache("run_lenet.py", "./lenet_startup", "lenet_startup_first.txt",
+                                            "lenet_startup_second.txt")
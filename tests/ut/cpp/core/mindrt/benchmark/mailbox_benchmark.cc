@@ -0,0 +1,188 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "actor/mailbox.h"
+
+// The throughput of many producers sending to one actor and the round trip latency of two actors, with
+// LockFreeMailBox and NonblockingMailBox. Built by the target mindrt_mailbox_benchmark, not run with the tests.
+namespace mindspore {
+namespace {
+constexpr int kMsgKindStop = 1;
+
+class CountMessage : public MessageBase {
+ public:
+  CountMessage(int producer, int seq, int kind = 0) : MessageBase("Count"), producer_(producer), seq_(seq), kind_(kind) {}
+  ~CountMessage() override = default;
+
+  int producer_;
+  int seq_;
+  int kind_;
+};
+
+// TestActor emulates how ActorThreadPool runs an actor: the notify hook of the mailbox marks the actor ready, a
+// dedicated thread takes the ready actor and drains its mailbox the same way as ActorBase::Run.
+template <typename Box>
+class TestActor {
+ public:
+  explicit TestActor(std::function<void(CountMessage *)> &&handler) : handler_(std::move(handler)) {
+    box_.SetNotifyHook(std::make_unique<std::function<void()>>([this]() {
+      (void)ready_.fetch_add(1, std::memory_order_release);
+    }));
+  }
+
+  void Start() { thread_ = std::thread([this]() { Loop(); }); }
+  void Join() { thread_.join(); }
+  void Send(std::unique_ptr<MessageBase> msg) { (void)box_.EnqueueMessage(std::move(msg)); }
+  // How many times the actor has been scheduled.
+  int64_t scheduled() const { return scheduled_; }
+
+ private:
+  void Loop() {
+    while (!stop_) {
+      if (ready_.load(std::memory_order_acquire) == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      (void)ready_.fetch_sub(1, std::memory_order_acq_rel);
+      ++scheduled_;
+      Run();
+    }
+  }
+
+  void Run() {
+    if (box_.TakeAllMsgsEachTime()) {
+      while (auto msgs = box_.GetMsgs()) {
+        for (auto &msg : *msgs) {
+          Handle(msg.get());
+        }
+        msgs->clear();
+      }
+    } else {
+      while (auto msg = box_.GetMsg()) {
+        Handle(msg.get());
+      }
+    }
+  }
+
+  void Handle(MessageBase *msg) {
+    auto count_msg = static_cast<CountMessage *>(msg);
+    if (count_msg->kind_ == kMsgKindStop) {
+      stop_ = true;
+      return;
+    }
+    handler_(count_msg);
+  }
+
+  Box box_;
+  std::function<void(CountMessage *)> handler_;
+  std::atomic<int64_t> ready_{0};
+  std::thread thread_;
+  bool stop_{false};
+  int64_t scheduled_{0};
+};
+
+// Every producer sends msg_num messages to one actor, return the throughput in messages per second, or a negative
+// value if a message is lost or out of the order of its producer.
+template <typename Box>
+double RunFanIn(int producer_num, int msg_num) {
+  std::vector<int> last_seq(producer_num, -1);
+  int64_t received = 0;
+  bool in_order = true;
+  TestActor<Box> actor([&](CountMessage *msg) {
+    in_order = in_order && (msg->seq_ == last_seq[msg->producer_] + 1);
+    last_seq[msg->producer_] = msg->seq_;
+    ++received;
+  });
+  actor.Start();
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_num; ++p) {
+    producers.emplace_back([&actor, p, msg_num]() {
+      for (int i = 0; i < msg_num; ++i) {
+        actor.Send(std::make_unique<CountMessage>(p, i));
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  actor.Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+  actor.Join();
+  auto end = std::chrono::steady_clock::now();
+  if (received != static_cast<int64_t>(producer_num) * msg_num || !in_order) {
+    return -1;
+  }
+  return received / std::chrono::duration<double>(end - start).count();
+}
+
+// Two actors send one message back and forth, return the average round trip latency in microseconds.
+template <typename Box>
+double RunPingPong(int round_num) {
+  std::unique_ptr<TestActor<Box>> ping;
+  std::unique_ptr<TestActor<Box>> pong;
+  std::atomic<int> rounds{0};
+  ping = std::make_unique<TestActor<Box>>([&](CountMessage *msg) {
+    if (rounds.fetch_add(1) + 1 < round_num) {
+      pong->Send(std::make_unique<CountMessage>(0, msg->seq_ + 1));
+    } else {
+      pong->Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+      ping->Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+    }
+  });
+  pong = std::make_unique<TestActor<Box>>([&](CountMessage *msg) {
+    ping->Send(std::make_unique<CountMessage>(1, msg->seq_ + 1));
+  });
+  ping->Start();
+  pong->Start();
+  auto start = std::chrono::steady_clock::now();
+  pong->Send(std::make_unique<CountMessage>(0, 0));
+  ping->Join();
+  pong->Join();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / round_num;
+}
+
+int RunBenchmark() {
+  const int msg_num = 100000;
+  for (int producer_num : {1, 4, 8}) {
+    auto lock_free = RunFanIn<LockFreeMailBox>(producer_num, msg_num);
+    auto locked = RunFanIn<NonblockingMailBox>(producer_num, msg_num);
+    if (lock_free < 0 || locked < 0) {
+      std::cerr << "Messages are lost or out of order with " << producer_num << " producers." << std::endl;
+      return 1;
+    }
+    std::cout << "fan in, producers: " << producer_num << ", LockFreeMailBox: " << lock_free
+              << " msg/s, NonblockingMailBox: " << locked << " msg/s" << std::endl;
+  }
+
+  const int round_num = 20000;
+  auto lock_free = RunPingPong<LockFreeMailBox>(round_num);
+  auto locked = RunPingPong<NonblockingMailBox>(round_num);
+  std::cout << "ping pong, LockFreeMailBox: " << lock_free << " us/round, NonblockingMailBox: " << locked
+            << " us/round" << std::endl;
+  return 0;
+}
+}  // namespace
+}  // namespace mindspore
+
+int main() { return mindspore::RunBenchmark(); }
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common_test.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "actor/mailbox.h"
+
+namespace mindspore {
+class TestMailBox : public UT::Common {
+ public:
+  TestMailBox() = default;
+  virtual ~TestMailBox() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+constexpr int kMsgKindStop = 1;
+
+class CountMessage : public MessageBase {
+ public:
+  CountMessage(int producer, int seq, int kind = 0) : MessageBase("Count"), producer_(producer), seq_(seq), kind_(kind) {}
+  ~CountMessage() override = default;
+
+  int producer_;
+  int seq_;
+  int kind_;
+};
+
+// TestActor emulates how ActorThreadPool runs an actor: the notify hook of the mailbox marks the actor ready, a
+// dedicated thread takes the ready actor and drains its mailbox the same way as ActorBase::Run.
+template <typename Box>
+class TestActor {
+ public:
+  explicit TestActor(std::function<void(CountMessage *)> &&handler) : handler_(std::move(handler)) {
+    box_.SetNotifyHook(std::make_unique<std::function<void()>>([this]() {
+      (void)ready_.fetch_add(1, std::memory_order_release);
+    }));
+  }
+
+  void Start() { thread_ = std::thread([this]() { Loop(); }); }
+  void Join() { thread_.join(); }
+  void Send(std::unique_ptr<MessageBase> msg) { (void)box_.EnqueueMessage(std::move(msg)); }
+  // How many times the actor has been scheduled.
+  int64_t scheduled() const { return scheduled_; }
+
+ private:
+  void Loop() {
+    while (!stop_) {
+      if (ready_.load(std::memory_order_acquire) == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      (void)ready_.fetch_sub(1, std::memory_order_acq_rel);
+      ++scheduled_;
+      Run();
+    }
+  }
+
+  void Run() {
+    if (box_.TakeAllMsgsEachTime()) {
+      while (auto msgs = box_.GetMsgs()) {
+        for (auto &msg : *msgs) {
+          Handle(msg.get());
+        }
+        msgs->clear();
+      }
+    } else {
+      while (auto msg = box_.GetMsg()) {
+        Handle(msg.get());
+      }
+    }
+  }
+
+  void Handle(MessageBase *msg) {
+    auto count_msg = static_cast<CountMessage *>(msg);
+    if (count_msg->kind_ == kMsgKindStop) {
+      stop_ = true;
+      return;
+    }
+    handler_(count_msg);
+  }
+
+  Box box_;
+  std::function<void(CountMessage *)> handler_;
+  std::atomic<int64_t> ready_{0};
+  std::thread thread_;
+  bool stop_{false};
+  int64_t scheduled_{0};
+};
+
+// Every producer sends msg_num messages to one actor, check every message is handled once and in the order of its
+// producer.
+template <typename Box>
+void RunFanIn(int producer_num, int msg_num) {
+  std::vector<int> last_seq(producer_num, -1);
+  int64_t received = 0;
+  bool in_order = true;
+  TestActor<Box> actor([&](CountMessage *msg) {
+    in_order = in_order && (msg->seq_ == last_seq[msg->producer_] + 1);
+    last_seq[msg->producer_] = msg->seq_;
+    ++received;
+  });
+  actor.Start();
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_num; ++p) {
+    producers.emplace_back([&actor, p, msg_num]() {
+      for (int i = 0; i < msg_num; ++i) {
+        actor.Send(std::make_unique<CountMessage>(p, i));
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  actor.Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+  actor.Join();
+  EXPECT_EQ(received, static_cast<int64_t>(producer_num) * msg_num);
+  EXPECT_TRUE(in_order);
+}
+
+// Two actors send one message back and forth, check all the rounds are made.
+template <typename Box>
+void RunPingPong(int round_num) {
+  std::unique_ptr<TestActor<Box>> ping;
+  std::unique_ptr<TestActor<Box>> pong;
+  std::atomic<int> rounds{0};
+  ping = std::make_unique<TestActor<Box>>([&](CountMessage *msg) {
+    if (rounds.fetch_add(1) + 1 < round_num) {
+      pong->Send(std::make_unique<CountMessage>(0, msg->seq_ + 1));
+    } else {
+      pong->Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+      ping->Send(std::make_unique<CountMessage>(0, 0, kMsgKindStop));
+    }
+  });
+  pong = std::make_unique<TestActor<Box>>([&](CountMessage *msg) {
+    ping->Send(std::make_unique<CountMessage>(1, msg->seq_ + 1));
+  });
+  ping->Start();
+  pong->Start();
+  pong->Send(std::make_unique<CountMessage>(0, 0));
+  ping->Join();
+  pong->Join();
+  EXPECT_EQ(rounds.load(), round_num);
+}
+}  // namespace
+
+/// Feature: Lock free mailbox of actor.
+/// Description: enqueue messages then drain them without a consumer thread.
+/// Expectation: messages come out in order, the notify hook is called only when the mailbox becomes non empty.
+TEST_F(TestMailBox, test_lock_free_mailbox_notify) {
+  LockFreeMailBox box;
+  int notified = 0;
+  box.SetNotifyHook(std::make_unique<std::function<void()>>([&notified]() { ++notified; }));
+  EXPECT_FALSE(box.TakeAllMsgsEachTime());
+  EXPECT_EQ(box.GetMsg(), nullptr);
+
+  const int msg_num = 10;
+  for (int i = 0; i < msg_num; ++i) {
+    (void)box.EnqueueMessage(std::make_unique<CountMessage>(0, i));
+  }
+  EXPECT_EQ(notified, 1);
+  for (int i = 0; i < msg_num; ++i) {
+    auto msg = box.GetMsg();
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(static_cast<CountMessage *>(msg.get())->seq_, i);
+    if (i == 0) {
+      // a message sent while the actor is running does not schedule it again
+      (void)box.EnqueueMessage(std::make_unique<CountMessage>(0, msg_num));
+    }
+  }
+  auto msg = box.GetMsg();
+  ASSERT_NE(msg, nullptr);
+  EXPECT_EQ(static_cast<CountMessage *>(msg.get())->seq_, msg_num);
+  EXPECT_EQ(box.GetMsg(), nullptr);
+  EXPECT_EQ(notified, 1);
+
+  // the drained mailbox notifies again
+  (void)box.EnqueueMessage(std::make_unique<CountMessage>(0, 0));
+  EXPECT_EQ(notified, 2);
+  // the messages left in the mailbox are freed by the destructor
+  (void)box.EnqueueMessage(std::make_unique<CountMessage>(0, 1));
+}
+
+/// Feature: Lock free mailbox of actor.
+/// Description: several producers send messages to one actor, with LockFreeMailBox and NonblockingMailBox.
+/// Expectation: every message is handled once, the messages of each producer keep their order.
+TEST_F(TestMailBox, test_fan_in) {
+  const int msg_num = 10000;
+  for (int producer_num : {1, 4, 8}) {
+    RunFanIn<LockFreeMailBox>(producer_num, msg_num);
+    RunFanIn<NonblockingMailBox>(producer_num, msg_num);
+  }
+}
+
+/// Feature: Lock free mailbox of actor.
+/// Description: two actors send one message back and forth, with LockFreeMailBox and NonblockingMailBox.
+/// Expectation: the ping pong finishes after all the rounds.
+TEST_F(TestMailBox, test_ping_pong) {
+  const int round_num = 1000;
+  RunPingPong<LockFreeMailBox>(round_num);
+  RunPingPong<NonblockingMailBox>(round_num);
+}
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "common/common.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/perf/autotune_profile.h"
+#include "minddata/dataset/engine/serdes.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/vision.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestAutoTuneProfile : public UT::DatasetOpTesting {
+ protected:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    GlobalContext::config_manager()->set_autotune_profile_dir(profile_dir_);
+  }
+
+  void TearDown() override {
+    GlobalContext::config_manager()->set_autotune_profile_dir("");
+    DatasetOpTesting::TearDown();
+  }
+
+  std::shared_ptr<Dataset> CreatePipeline(int32_t batch_size) {
+    std::string folder_path = datasets_root_path_ + "/testPK/data/";
+    std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+    ds = ds->Map({std::make_shared<vision::Decode>()}, {"image"});
+    return ds->Batch(batch_size);
+  }
+
+  /// \brief Compile the pipeline and get its map node
+  std::shared_ptr<DatasetNode> CompileAndGetMap(const std::shared_ptr<Dataset> &ds,
+                                                std::shared_ptr<TreeAdapter> *ir_tree) {
+    *ir_tree = std::make_shared<TreeAdapter>();
+    EXPECT_OK((*ir_tree)->Compile(ds->IRNode(), 1));
+    auto node = (*ir_tree)->RootIRNode();
+    while (node->Name() != kMapNode) {
+      node = node->Children()[0];
+    }
+    return node;
+  }
+
+  std::string profile_dir_ = "./autotune_profile_ut";
+};
+
+/// Feature: AutoTune profile
+/// Description: Save a tuned configuration of a pipeline, then compile the same pipeline and another one
+/// Expectation: The configuration is applied to the same pipeline only
+TEST_F(MindDataTestAutoTuneProfile, TestSaveApply) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTuneProfile-TestSaveApply.";
+  constexpr int32_t kTunedWorkers = 3;
+  constexpr int32_t kTunedQueueSize = 7;
+  std::shared_ptr<TreeAdapter> ir_tree;
+  auto map = CompileAndGetMap(CreatePipeline(2), &ir_tree);
+  EXPECT_NE(map->NumWorkers(), kTunedWorkers);
+
+  // what AutoTune saves at the end of the tuning
+  nlohmann::json tree_json;
+  ASSERT_OK(Serdes::SaveToJSON(ir_tree->RootIRNode(), "", &tree_json));
+  ASSERT_EQ(tree_json["children"][0]["op_type"], kMapNode);
+  tree_json["children"][0]["num_parallel_workers"] = kTunedWorkers;
+  tree_json["children"][0]["connector_queue_size"] = kTunedQueueSize;
+  ASSERT_OK(AutoTuneProfile::Save(profile_dir_, tree_json));
+
+  // the fingerprint does not depend on the tuned fields
+  nlohmann::json untuned_json;
+  ASSERT_OK(Serdes::SaveToJSON(ir_tree->RootIRNode(), "", &untuned_json));
+  std::string fingerprint;
+  std::string untuned_fingerprint;
+  ASSERT_OK(AutoTuneProfile::GetFingerprint(tree_json, &fingerprint));
+  ASSERT_OK(AutoTuneProfile::GetFingerprint(untuned_json, &untuned_fingerprint));
+  EXPECT_EQ(fingerprint, untuned_fingerprint);
+
+  std::shared_ptr<TreeAdapter> tuned_tree;
+  auto tuned_map = CompileAndGetMap(CreatePipeline(2), &tuned_tree);
+  EXPECT_EQ(tuned_map->NumWorkers(), kTunedWorkers);
+  EXPECT_EQ(tuned_map->ConnectorQueueSize(), kTunedQueueSize);
+  TensorRow row;
+  ASSERT_OK(tuned_tree->GetNext(&row));
+  EXPECT_EQ(row.size(), 2);
+
+  std::shared_ptr<TreeAdapter> other_tree;
+  auto other_map = CompileAndGetMap(CreatePipeline(4), &other_tree);
+  EXPECT_EQ(other_map->NumWorkers(), map->NumWorkers());
+  EXPECT_EQ(other_map->ConnectorQueueSize(), map->ConnectorQueueSize());
+}
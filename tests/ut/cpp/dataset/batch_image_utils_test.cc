@@ -0,0 +1,198 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/kernels/image/batch_image_utils.h"
+#include "minddata/dataset/kernels/image/batched_image_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/vertical_flip_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+using ImageFunc = std::function<Status(const std::shared_ptr<Tensor> &, std::shared_ptr<Tensor> *)>;
+
+// the batched kernels and the per image kernels are given the same images, stacked into a batch for the former
+class MindDataTestBatchImageUtils : public UT::Common {
+ public:
+  MindDataTestBatchImageUtils() = default;
+
+ protected:
+  /// \brief Create the random images of the shape and the batch of them
+  /// \param[in] type Type of the images, uint8 or float32
+  /// \param[in] image_shape Shape of every image
+  /// \param[in] num Number of the images
+  /// \param[out] images Images of the batch
+  /// \return The batch of the images, in the shape of <num, image_shape...>
+  std::shared_ptr<Tensor> CreateBatch(const DataType &type, const std::vector<dsize_t> &image_shape, dsize_t num,
+                                      std::vector<std::shared_ptr<Tensor>> *images) {
+    std::vector<dsize_t> batch_shape = image_shape;
+    (void)batch_shape.insert(batch_shape.begin(), num);
+    std::shared_ptr<Tensor> batch;
+    EXPECT_OK(Tensor::CreateEmpty(TensorShape(batch_shape), type, &batch));
+    dsize_t image_size = batch->Size() / num;
+    std::uniform_int_distribution<int32_t> distribution(0, UINT8_MAX);
+    if (type == DataType(DataType::DE_UINT8)) {
+      for (auto itr = batch->begin<uint8_t>(); itr != batch->end<uint8_t>(); ++itr) {
+        *itr = static_cast<uint8_t>(distribution(engine_));
+      }
+    } else {
+      for (auto itr = batch->begin<float>(); itr != batch->end<float>(); ++itr) {
+        *itr = static_cast<float>(distribution(engine_)) / 3;
+      }
+    }
+    images->clear();
+    for (dsize_t i = 0; i < num; i++) {
+      std::shared_ptr<Tensor> image;
+      EXPECT_OK(Tensor::CreateFromMemory(TensorShape(image_shape), type,
+                                         batch->GetBuffer() + i * image_size * type.SizeInBytes(), &image));
+      images->push_back(image);
+    }
+    return batch;
+  }
+
+  /// \brief Check the output of a batched kernel is the outputs of the per image kernel stacked, bit by bit
+  void ExpectSameAsImages(const std::shared_ptr<Tensor> &batch_output, const ImageFunc &image_func,
+                          const std::vector<std::shared_ptr<Tensor>> &images) {
+    ASSERT_NE(batch_output, nullptr);
+    size_t offset = 0;
+    for (const auto &image : images) {
+      std::shared_ptr<Tensor> image_output;
+      ASSERT_OK(image_func(image, &image_output));
+      std::vector<dsize_t> batch_shape = image_output->shape().AsVector();
+      (void)batch_shape.insert(batch_shape.begin(), static_cast<dsize_t>(images.size()));
+      ASSERT_EQ(batch_output->shape(), TensorShape(batch_shape));
+      ASSERT_EQ(batch_output->type(), image_output->type());
+      size_t image_bytes = static_cast<size_t>(image_output->SizeInBytes());
+      EXPECT_EQ(std::memcmp(batch_output->GetBuffer() + offset, image_output->GetBuffer(), image_bytes), 0);
+      offset += image_bytes;
+    }
+  }
+
+  std::mt19937 engine_{0};
+};
+
+/// Feature: Batched image kernels
+/// Description: Test BatchNormalize on uint8 <N, H, W, C> batches whose sizes leave a tail shorter than a vector step
+///     and span many vector steps, and on float32 <N, C, H, W> batches
+/// Expectation: The vectorized output is bitwise identical to the output of the scalar per image Normalize
+TEST_F(MindDataTestBatchImageUtils, TestBatchNormalize) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchImageUtils-TestBatchNormalize.";
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std_dev = {70.0, 68.0, 71.0};
+  EXPECT_TRUE(IsBatchNormalizeSupported(DataType(DataType::DE_UINT8)));
+  EXPECT_TRUE(IsBatchNormalizeSupported(DataType(DataType::DE_FLOAT32)));
+  EXPECT_FALSE(IsBatchNormalizeSupported(DataType(DataType::DE_INT16)));
+
+  for (bool is_hwc : {true, false}) {
+    for (const auto &type : {DataType(DataType::DE_UINT8), DataType(DataType::DE_FLOAT32)}) {
+      for (const auto &image_shape : std::vector<std::vector<dsize_t>>{{5, 7, 3}, {3, 5, 7}, {16, 16, 3}, {3, 16, 16}}) {
+        if (image_shape[is_hwc ? 2 : 0] != static_cast<dsize_t>(mean.size())) {
+          continue;
+        }
+        std::vector<std::shared_ptr<Tensor>> images;
+        auto batch = CreateBatch(type, image_shape, 3, &images);
+        std::shared_ptr<Tensor> output;
+        ASSERT_OK(BatchNormalize(batch, &output, mean, std_dev, is_hwc));
+        ExpectSameAsImages(
+          output,
+          [&](const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *image_output) {
+            return Normalize(input, image_output, mean, std_dev, is_hwc);
+          },
+          images);
+      }
+    }
+  }
+
+  // a single mean and std is used for all the channels
+  std::vector<std::shared_ptr<Tensor>> images;
+  auto batch = CreateBatch(DataType(DataType::DE_UINT8), {5, 7, 3}, 2, &images);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(BatchNormalize(batch, &output, {121.0}, {70.0}, true));
+  ExpectSameAsImages(
+    output,
+    [](const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *image_output) {
+      return Normalize(input, image_output, {121.0}, {70.0}, true);
+    },
+    images);
+  EXPECT_ERROR(BatchNormalize(batch, &output, {121.0, 115.0}, {70.0, 68.0}, true));
+}
+
+/// Feature: Batched image kernels
+/// Description: Test BatchHorizontalFlip, BatchVerticalFlip and BatchHwcToChw on uint8 and float32 batches of one
+///     and three channels, the latter taking the deinterleaving path for rgb uint8 images where the target has one
+/// Expectation: The output is the same as the output of the per image kernels
+TEST_F(MindDataTestBatchImageUtils, TestBatchFlipAndHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchImageUtils-TestBatchFlipAndHwcToChw.";
+  for (const auto &type : {DataType(DataType::DE_UINT8), DataType(DataType::DE_FLOAT32)}) {
+    for (const auto &image_shape : std::vector<std::vector<dsize_t>>{{5, 7, 3}, {4, 6, 1}, {17, 19, 3}}) {
+      std::vector<std::shared_ptr<Tensor>> images;
+      auto batch = CreateBatch(type, image_shape, 3, &images);
+      std::shared_ptr<Tensor> output;
+      ASSERT_OK(BatchHorizontalFlip(batch, &output));
+      ExpectSameAsImages(output, HorizontalFlip, images);
+      ASSERT_OK(BatchVerticalFlip(batch, &output));
+      ExpectSameAsImages(output, VerticalFlip, images);
+      ASSERT_OK(BatchHwcToChw(batch, &output));
+      ExpectSameAsImages(output, HwcToChw, images);
+    }
+  }
+}
+
+/// Feature: Batched image kernels
+/// Description: Test VerticalFlipOp, HorizontalFlipOp, HwcToChwOp, NormalizeOp and RescaleOp on <N, H, W, C> batches
+///     given to them directly, and on <N, H, W> batches of grayscale images given to them through BatchedImageOp
+/// Expectation: The output is the same as running the op on every image of the batch
+TEST_F(MindDataTestBatchImageUtils, TestBatchedImageOp) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchImageUtils-TestBatchedImageOp.";
+  std::vector<std::shared_ptr<TensorOp>> image_ops = {
+    std::make_shared<VerticalFlipOp>(), std::make_shared<HorizontalFlipOp>(), std::make_shared<HwcToChwOp>(),
+    std::make_shared<NormalizeOp>(std::vector<float>{121.0}, std::vector<float>{70.0}, true),
+    std::make_shared<RescaleOp>(1.0f / 255, -0.5f)};
+  for (const auto &image_op : image_ops) {
+    ImageFunc image_func = [&image_op](const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+      return image_op->Compute(input, output);
+    };
+    for (const auto &image_shape : std::vector<std::vector<dsize_t>>{{5, 7, 3}, {5, 7}}) {
+      std::vector<std::shared_ptr<Tensor>> images;
+      auto batch = CreateBatch(DataType(DataType::DE_UINT8), image_shape, 3, &images);
+      TensorShape batch_shape = batch->shape();
+      std::shared_ptr<Tensor> output;
+      auto batched_op = std::make_shared<BatchedImageOp>(image_op);
+      ASSERT_OK(batched_op->Compute(batch, &output));
+      // the batch of <H, W> images is given to the per image op in another shape, and is restored
+      EXPECT_EQ(batch->shape(), batch_shape);
+      ExpectSameAsImages(output, image_func, images);
+      if (image_shape.size() == kDefaultImageRank) {
+        // a <N, H, W, C> batch runs the batched kernel of the per image op itself
+        ASSERT_OK(image_op->Compute(batch, &output));
+        ExpectSameAsImages(output, image_func, images);
+      }
+    }
+  }
+  std::shared_ptr<Tensor> image;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({5, 7}), DataType(DataType::DE_UINT8), &image));
+  std::shared_ptr<Tensor> output;
+  EXPECT_ERROR(std::make_shared<BatchedImageOp>(image_ops[0])->Compute(image, &output));
+}
@@ -24,6 +24,7 @@
 
 #include "common/common.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/unordered_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -45,6 +46,10 @@ public:
   // A random sleep/delay can be introduced for each thread. See run().
   Status Run_test_1();
 
+  // Test scenario: multiple producers push to an UnorderedConnector with a small capacity, a single consumer
+  // checks that every element arrives once and that the elements of each producer keep their order.
+  Status Run_test_unordered();
+
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
 private:
@@ -77,6 +82,9 @@ private:
                       std::shared_ptr<Connector<uint32_t> > from_conn,
                       std::shared_ptr<Connector<uint32_t> > to_conn);
 
+  // This worker loop pushes the elements of input_ owned by tid (round robin) to the UnorderedConnector.
+  Status UnorderedWorkerPush(int tid, int num_workers, std::shared_ptr<UnorderedConnector<uint32_t>> my_conn);
+
   Status ValidateOutput(const std::vector<uint32_t> &output);
 
   uint32_t GenRand(int max);
@@ -123,7 +131,17 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
-
+/// Feature: UnorderedConnector
+/// Description: Test UnorderedConnector with multiple producers with random delay and a single consumer
+/// Expectation: All elements are received, the elements of the same producer keep their order
+TEST_F(MindDataTestConnector, TestUnordered) {
+  MS_LOG(INFO) << "MindDataTestConnector TestUnordered.";
+  this->SetSleepMilliSec(3);
+  Status rc = this->Run_test_unordered();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -242,6 +260,48 @@ Status MindDataTestConnector::Run_test_1() {
   return ValidateOutput(output);
 }
 
+Status MindDataTestConnector::Run_test_unordered() {
+  const int num_producers = 4;
+  const int capacity = 4;
+  auto my_conn = std::make_shared<UnorderedConnector<uint32_t>>(capacity);
+  for (int i = 0; i < num_producers; i++) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(
+      "Unordered Worker Push",
+      std::bind(&MindDataTestConnector::UnorderedWorkerPush, this, i, num_producers, my_conn)));
+  }
+  // the master thread is the only consumer
+  std::vector<uint32_t> last(num_producers, 0);
+  std::vector<bool> seen(input_.size() + 1, false);
+  for (size_t i = 0; i < input_.size(); i++) {
+    uint32_t res = 0;
+    RETURN_IF_NOT_OK(my_conn->PopFront(&res));
+    CHECK_FAIL_RETURN_UNEXPECTED(res > 0 && res < seen.size() && !seen[res], "Element is lost or duplicated.");
+    seen[res] = true;
+    // input_ is 1..n and producer i owns input_[i], input_[i + num_producers], ...
+    int tid = static_cast<int>((res - 1) % num_producers);
+    CHECK_FAIL_RETURN_UNEXPECTED(last[tid] < res, "Elements of the same producer are not in-order.");
+    last[tid] = res;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(my_conn->Empty(), "UnorderedConnector is expected to be empty.");
+  tg_->interrupt_all();
+  tg_->join_all(Task::WaitFlag::kNonBlocking);
+  return Status::OK();
+}
+
+Status MindDataTestConnector::UnorderedWorkerPush(int tid, int num_workers,
+                                                  std::shared_ptr<UnorderedConnector<uint32_t>> my_conn) {
+  TaskManager::FindMe()->Post();
+  MS_ASSERT(my_conn != nullptr);
+  for (int i = tid; i < input_.size(); i += num_workers) {
+    RETURN_IF_NOT_OK(my_conn->Add(uint32_t(input_[i])));
+    // Emulate different processing time for each thread
+    if (sleep_ms_ != 0) {
+      GoToSleep(sleep_ms_);
+    }
+  }
+  return Status::OK();
+}
+
 Status MindDataTestConnector::SerialWorkerPull(
                                                int tid,
                                                std::shared_ptr<Connector<uint32_t>> my_conn,
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_crop_resize_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+// the fused op decodes at a reduced DCT scale and resizes once, so it is close to but not equal to the unfused ops
+constexpr double kMeanDiffThreshold = 10.0;
+
+class MindDataTestDecodeCropResizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestDecodeCropResizeOp() : CVOpCommon() {}
+
+  double MeanDiff(const std::shared_ptr<Tensor> &output1, const std::shared_ptr<Tensor> &output2) {
+    cv::Mat m1 = CVTensor::AsCVTensor(output1)->mat();
+    cv::Mat m2 = CVTensor::AsCVTensor(output2)->mat();
+    double diff_sum = 0;
+    for (int i = 0; i < m1.rows; i++) {
+      for (int j = 0; j < m1.cols; j++) {
+        diff_sum += std::abs(static_cast<int>(m1.at<cv::Vec3b>(i, j)[1]) - static_cast<int>(m2.at<cv::Vec3b>(i, j)[1]));
+      }
+    }
+    return diff_sum / (m1.rows * m1.cols);
+  }
+};
+
+/// Feature: DecodeCropResize op
+/// Description: Test DecodeCropResizeOp against Decode, Resize and CenterCrop on a jpeg decoded at a reduced scale
+/// Expectation: Output shape is the crop size and the data is close to the unfused ops
+TEST_F(MindDataTestDecodeCropResizeOp, TestDecodeResizeCenterCrop) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeCropResizeOp-TestDecodeResizeCenterCrop.";
+  constexpr int resize = 256;
+  constexpr int crop = 224;
+  std::shared_ptr<Tensor> decoded, resized, expect, output;
+  ASSERT_OK(DecodeOp(true).Compute(raw_input_tensor_, &decoded));
+  ASSERT_OK(ResizeOp(resize).Compute(decoded, &resized));
+  ASSERT_OK(CenterCropOp(crop, crop).Compute(resized, &expect));
+
+  DecodeCropResizeOp op(resize, 0, crop, crop, InterpolationMode::kLinear);
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  double mean_diff = MeanDiff(output, expect);
+  MS_LOG(INFO) << "mean diff: " << mean_diff;
+  EXPECT_LT(mean_diff, kMeanDiffThreshold);
+}
+
+/// Feature: DecodeCropResize op
+/// Description: Test DecodeCropResizeOp without crop against Decode and Resize
+/// Expectation: Output shape is the resized shape and the data is close to the unfused ops
+TEST_F(MindDataTestDecodeCropResizeOp, TestDecodeResize) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeCropResizeOp-TestDecodeResize.";
+  constexpr int resize_h = 300;
+  constexpr int resize_w = 400;
+  std::shared_ptr<Tensor> decoded, expect, output;
+  ASSERT_OK(DecodeOp(true).Compute(raw_input_tensor_, &decoded));
+  ASSERT_OK(ResizeOp(resize_h, resize_w).Compute(decoded, &expect));
+
+  DecodeCropResizeOp op(resize_h, resize_w, 0, 0, InterpolationMode::kLinear);
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  EXPECT_LT(MeanDiff(output, expect), kMeanDiffThreshold);
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/vision.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBatchPushdownPass : public UT::DatasetOpTesting {
+ public:
+  MindDataTestBatchPushdownPass() = default;
+
+ protected:
+  /// \brief Compile the dataset and get the names of the nodes from the root to the leaf
+  /// \param[in] ds Dataset to compile, every node of it has at most one child
+  /// \param[in] optimize Whether to run the optional optimization passes
+  /// \param[out] ir_tree Compiled tree
+  /// \return Names of the nodes below the root
+  std::vector<std::string> CompileTree(const std::shared_ptr<Dataset> &ds, bool optimize,
+                                       std::shared_ptr<TreeAdapter> *ir_tree) {
+    *ir_tree = std::make_shared<TreeAdapter>();
+    (*ir_tree)->SetOptimize(optimize);
+    EXPECT_OK((*ir_tree)->Compile(ds->IRNode(), 1));
+    std::vector<std::string> names;
+    auto node = (*ir_tree)->RootIRNode();
+    while (!node->Children().empty()) {
+      node = node->Children()[0];
+      names.push_back(node->Name());
+    }
+    return names;
+  }
+
+  /// \brief Check the two compiled trees give the same rows
+  /// \param[in] expect_tree Tree compiled without the optional optimization passes
+  /// \param[in] ir_tree Tree compiled with the optional optimization passes
+  /// \param[in] shapes Shapes of the first column of every row
+  void ExpectSameRows(const std::shared_ptr<TreeAdapter> &expect_tree, const std::shared_ptr<TreeAdapter> &ir_tree,
+                      const std::vector<TensorShape> &shapes) {
+    TensorRow expect_row;
+    TensorRow row;
+    ASSERT_OK(expect_tree->GetNext(&expect_row));
+    ASSERT_OK(ir_tree->GetNext(&row));
+    size_t i = 0;
+    while (!expect_row.empty() && !row.empty()) {
+      ASSERT_EQ(expect_row.size(), row.size());
+      ASSERT_LT(i, shapes.size());
+      EXPECT_EQ(row[0]->shape(), shapes[i]);
+      for (size_t j = 0; j < row.size(); j++) {
+        EXPECT_TRUE(*expect_row[j] == *row[j]);
+      }
+      ASSERT_OK(expect_tree->GetNext(&expect_row));
+      ASSERT_OK(ir_tree->GetNext(&row));
+      i++;
+    }
+    EXPECT_TRUE(expect_row.empty() && row.empty());
+    EXPECT_EQ(i, shapes.size());
+  }
+};
+
+/// Feature: MindData Batch Pushdown Pass Support
+/// Description: Test Normalize and HWC2CHW op in a map below batch with IR optimization pass
+/// Expectation: The map is moved above the batch, and the output is the same as without the pass
+TEST_F(MindDataTestBatchPushdownPass, NormalizeHWC2CHWEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchPushdownPass-NormalizeHWC2CHWEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+  auto decode = std::make_shared<vision::Decode>();
+  // not fused by the tensor op fusion pass, to compare with the output of the unoptimized tree
+  auto center_crop = std::make_shared<vision::CenterCrop>(std::vector<int32_t>{32, 24});
+  ds = ds->Map({decode, center_crop}, {"image"});
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{121.0, 115.0, 100.0},
+                                                       std::vector<float>{70.0, 68.0, 71.0});
+  auto hwc2chw = std::make_shared<vision::HWC2CHW>();
+  auto flip = std::make_shared<vision::HorizontalFlip>();
+  ds = ds->Map({flip, normalize, hwc2chw}, {"image"});
+  ds = ds->Batch(4);
+
+  std::shared_ptr<TreeAdapter> expect_tree;
+  std::vector<std::string> expect_names = CompileTree(ds, false, &expect_tree);
+  EXPECT_EQ(expect_names, (std::vector<std::string>{kBatchNode, kMapNode, kMapNode, kImageFolderNode}));
+  std::shared_ptr<TreeAdapter> ir_tree;
+  std::vector<std::string> names = CompileTree(ds, true, &ir_tree);
+  EXPECT_EQ(names, (std::vector<std::string>{kMapNode, kBatchNode, kMapNode, kImageFolderNode}));
+
+  ExpectSameRows(expect_tree, ir_tree, {TensorShape({4, 3, 32, 24}), TensorShape({4, 3, 32, 24}),
+                                       TensorShape({2, 3, 32, 24})});
+}
+
+/// Feature: MindData Batch Pushdown Pass Support
+/// Description: Test the flips, HWC2CHW and Normalize op on grayscale <H, W> images in a map below batch with IR
+///     optimization pass
+/// Expectation: The map is moved above the batch, the <N, H, W> batches are not taken for <H, W, C> images and the
+///     output is the same as without the pass
+TEST_F(MindDataTestBatchPushdownPass, GrayscaleImagesEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchPushdownPass-GrayscaleImagesEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+  auto decode = std::make_shared<vision::Decode>();
+  auto center_crop = std::make_shared<vision::CenterCrop>(std::vector<int32_t>{32, 24});
+  auto gray = std::make_shared<vision::ConvertColor>(ConvertMode::COLOR_RGB2GRAY);
+  ds = ds->Map({decode, center_crop, gray}, {"image"});
+  auto horizontal_flip = std::make_shared<vision::HorizontalFlip>();
+  auto vertical_flip = std::make_shared<vision::VerticalFlip>();
+  auto hwc2chw = std::make_shared<vision::HWC2CHW>();
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{121.0}, std::vector<float>{70.0});
+  ds = ds->Map({horizontal_flip, vertical_flip, hwc2chw, normalize}, {"image"});
+  ds = ds->Batch(4);
+
+  std::shared_ptr<TreeAdapter> expect_tree;
+  std::vector<std::string> expect_names = CompileTree(ds, false, &expect_tree);
+  EXPECT_EQ(expect_names, (std::vector<std::string>{kBatchNode, kMapNode, kMapNode, kImageFolderNode}));
+  std::shared_ptr<TreeAdapter> ir_tree;
+  std::vector<std::string> names = CompileTree(ds, true, &ir_tree);
+  EXPECT_EQ(names, (std::vector<std::string>{kMapNode, kBatchNode, kMapNode, kImageFolderNode}));
+
+  ExpectSameRows(expect_tree, ir_tree,
+                 {TensorShape({4, 32, 24}), TensorShape({4, 32, 24}), TensorShape({2, 32, 24})});
+}
+
+/// Feature: MindData Batch Pushdown Pass Support
+/// Description: Test RandomHorizontalFlip op in a map below batch with IR optimization pass
+/// Expectation: The random op is applied per image, so the map stays below the batch
+TEST_F(MindDataTestBatchPushdownPass, RandomOpNotPushedDown) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchPushdownPass-RandomOpNotPushedDown";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+  auto decode = std::make_shared<vision::Decode>();
+  auto resize = std::make_shared<vision::Resize>(std::vector<int32_t>{32, 24});
+  auto random_flip = std::make_shared<vision::RandomHorizontalFlip>();
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{121.0, 115.0, 100.0},
+                                                       std::vector<float>{70.0, 68.0, 71.0});
+  ds = ds->Map({decode, resize, random_flip, normalize}, {"image"});
+  ds = ds->Batch(4);
+
+  std::shared_ptr<TreeAdapter> ir_tree;
+  std::vector<std::string> names = CompileTree(ds, true, &ir_tree);
+  EXPECT_EQ(names, (std::vector<std::string>{kBatchNode, kMapNode, kImageFolderNode}));
+}
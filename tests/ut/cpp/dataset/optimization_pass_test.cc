@@ -24,6 +24,7 @@
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/post/auto_worker_pass.h"
+#include "minddata/dataset/engine/opt/post/unordered_connector_pass.h"
 #include "minddata/dataset/include/dataset/transforms.h"
 #include "minddata/dataset/include/dataset/vision.h"
 #include "minddata/dataset/include/dataset/vision_lite.h"
@@ -120,3 +121,62 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: IR Optimization
+/// Description: Test UnorderedConnectorPass on a pipeline with maps below and above a batch
+/// Expectation: Only the maps whose output order is consumed by nothing are set to unordered
+TEST_F(MindDataTestOptimizationPass, MindDataTestUnorderedConnectorPass) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestUnorderedConnectorPass.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<std::shared_ptr<TensorTransform>> decode = {std::make_shared<vision::Decode>()};
+  // ImageFolder -> map1 -> project -> batch -> map2 -> shuffle
+  std::shared_ptr<Dataset> map1 = ImageFolder(folder_path, false)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> map2 = map1->Project({"image"})->Batch(2)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> root = map2->Shuffle(4);
+  EXPECT_NE(root, nullptr);
+
+  UnorderedConnectorPass pass;
+  bool modified = false;
+  ASSERT_OK(pass.Run(root->IRNode(), &modified));
+  EXPECT_TRUE(modified);
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(map1->IRNode())->PreserveOrder());
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(map2->IRNode())->PreserveOrder());
+}
+
+/// Feature: IR Optimization
+/// Description: Test UnorderedConnectorPass on the maps below a batch or a shuffle which is below a zip or a concat
+/// Expectation: The maps keep the order, since the zip pairs the rows by position and the concat keeps them together
+TEST_F(MindDataTestOptimizationPass, MindDataTestUnorderedConnectorPassZipConcat) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestUnorderedConnectorPassZipConcat.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<std::shared_ptr<TensorTransform>> decode = {std::make_shared<vision::Decode>()};
+  // {ImageFolder -> map1 -> batch, {ImageFolder -> map2, ImageFolder} -> zip -> shuffle} -> zip
+  std::shared_ptr<Dataset> map1 = ImageFolder(folder_path, false)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> map2 = ImageFolder(folder_path, false)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> zip = Zip({map2, ImageFolder(folder_path, false)->Rename({"image"}, {"image2"})});
+  std::shared_ptr<Dataset> zip_root =
+    Zip({map1->Batch(2)->Rename({"label"}, {"label1"}), zip->Shuffle(4)->Rename({"image"}, {"image1"})});
+  EXPECT_NE(zip_root, nullptr);
+
+  UnorderedConnectorPass zip_pass;
+  bool modified = false;
+  ASSERT_OK(zip_pass.Run(zip_root->IRNode(), &modified));
+  EXPECT_FALSE(modified);
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapNode>(map1->IRNode())->PreserveOrder());
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapNode>(map2->IRNode())->PreserveOrder());
+
+  // {ImageFolder -> map3 -> shuffle, ImageFolder} -> concat -> batch -> map4 -> shuffle
+  std::shared_ptr<Dataset> map3 = ImageFolder(folder_path, false)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> concat = map3->Shuffle(4)->Concat({ImageFolder(folder_path, false)});
+  std::shared_ptr<Dataset> map4 = concat->Batch(2)->Map(decode, {"image"});
+  std::shared_ptr<Dataset> concat_root = map4->Shuffle(4);
+  EXPECT_NE(concat_root, nullptr);
+
+  UnorderedConnectorPass concat_pass;
+  modified = false;
+  ASSERT_OK(concat_pass.Run(concat_root->IRNode(), &modified));
+  EXPECT_TRUE(modified);
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapNode>(map3->IRNode())->PreserveOrder());
+  // the shuffle above the concat still takes the rows in any order
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(map4->IRNode())->PreserveOrder());
+}
@@ -64,10 +64,18 @@ class MemoryManagerStub : public MemoryManager {
     return ret;
   }
 
-  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {}
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override { ++swap_in_count_; }
+
+  void SwapInAsync(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {
+    ++async_swap_in_count_;
+  }
 
   void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override {}
 
+  size_t swap_in_count() const { return swap_in_count_; }
+
+  size_t async_swap_in_count() const { return async_swap_in_count_; }
+
  protected:
   uint8_t *MallocStaticMem(size_t size, bool communication_mem, uint32_t graph_id) { return nullptr; }
 
@@ -75,6 +83,8 @@ class MemoryManagerStub : public MemoryManager {
   std::vector<uint8_t> device_mem_;
   size_t device_virtual_count_{0};
   std::map<void *, size_t> device_mem_size_;
+  size_t swap_in_count_{0};
+  size_t async_swap_in_count_{0};
 };
 
 class TestMemScheduler : public UT::Common {
@@ -283,4 +293,81 @@ scheduler->Optimize();
 // run
 Run(scheduler);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+/// Feature: MemScheduler
+/// Description: Test MemScheduler with memory swapped out and used again after the memory is enough
+/// Expectation: Memory is swapped in asynchronously ahead of the step it is used
+TEST_F(TestMemScheduler, test_mem_scheduler_swap_in_ahead) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  auto mem_manager = std::make_shared<MemoryManagerStub>();
+  scheduler->SetMemHandler(std::make_shared<MemHandler>(mem_manager));
+
+  // input data
+  used_tensor_num_ = 7;
+  total_step_ = 8;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  // 8 step tensor usage
+  //
+  // 0-----------------0--0
+  // 1--1--1
+  // 2--2--2
+  // 3--3--3
+  // 4--4--4
+  // 5--5--5
+  //             6--6--6
+  std::vector<std::vector<size_t>> step_used_tensors = {{0}, {1, 2, 3, 4, 5}, {1, 2, 3, 4, 5}, {1, 2, 3, 4, 5},
+                                                        {6}, {6},             {0, 6},          {0}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  // record
+  Record(scheduler);
+  // optimize
+  ASSERT_TRUE(scheduler->Optimize());
+  // run
+  void *stream = nullptr;
+  scheduler->Reset();
+  size_t swap_in_step = total_step_;
+  for (size_t i = 0; i < total_step_; ++i) {
+    ASSERT_TRUE(scheduler->PreCompute(stream));
+    if (swap_in_step == total_step_ && mem_manager->async_swap_in_count() != 0) {
+      swap_in_step = i;
+    }
+    for (auto j : step_used_tensors_[i]) {
+      ASSERT_NE(scheduler->GetOrMalloc(tensor_keys_.data() + j, 1), nullptr);
+    }
+    ASSERT_TRUE(scheduler->PostCompute(stream));
+  }
+  // Tensor 0 is swapped in at step 4, once tensor 1 to tensor 5 are freed.
+  ASSERT_EQ(swap_in_step, 4);
+  ASSERT_EQ(mem_manager->async_swap_in_count(), 1);
+  ASSERT_EQ(mem_manager->swap_in_count(), 0);
+}
+
+/// Feature: AutoMemoryOffload
+/// Description: Malloc memory when the device memory is not enough and the next use of the memory is known
+/// Expectation: The memory used latest is offloaded
+TEST_F(TestMemScheduler, test_auto_mem_offload_by_next_use) {
+  auto mem_handler = std::make_shared<MemHandler>(std::make_shared<MemoryManagerStub>());
+  AutoMemoryOffload auto_mem_offload(mem_handler);
+  std::vector<uint8_t> keys(kDeviceMemSize + 1, 0);
+  std::map<const void *, size_t> next_use_index = {
+    {keys.data(), 1}, {keys.data() + 1, 9}, {keys.data() + 2, 3}, {keys.data() + 3, 4}, {keys.data() + 4, 5}};
+  auto_mem_offload.set_next_use_func([&next_use_index](const void *key) { return next_use_index[key]; });
+  int stream = 0;
+  for (size_t i = 0; i < kDeviceMemSize; ++i) {
+    ASSERT_NE(auto_mem_offload.Malloc(keys.data() + i, 1, &stream, {}), nullptr);
+  }
+  ASSERT_NE(auto_mem_offload.Malloc(keys.data() + kDeviceMemSize, 1, &stream, {}), nullptr);
+  ASSERT_EQ(auto_mem_offload.Get(keys.data() + 1), nullptr);
+  for (size_t i : std::vector<size_t>{0, 2, 3, 4}) {
+    ASSERT_NE(auto_mem_offload.Get(keys.data() + i), nullptr);
+  }
+  auto_mem_offload.Clear();
+}
+}  // namespace mindspore::device
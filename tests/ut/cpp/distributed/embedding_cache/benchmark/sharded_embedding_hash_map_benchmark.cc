@@ -0,0 +1,109 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "distributed/embedding_cache/embedding_hash_map.h"
+#include "distributed/embedding_cache/sharded_embedding_hash_map.h"
+
+// The batched lookup of ShardedEmbeddingHashMap against the one by one lookup of EmbeddingHashMap, over batch sizes
+// and hit ratios. Built by the target sharded_embedding_hash_map_benchmark, not run with the tests.
+namespace mindspore {
+namespace distributed {
+namespace {
+struct BenchResult {
+  double sharded_us{0};
+  double baseline_us{0};
+};
+
+// Look up one batch with the hit ratio given, the misses are inserted afterwards, like a prefetch step does.
+BenchResult RunLookupBench(size_t capacity, size_t batch, double hit_ratio, size_t loop) {
+  ShardedEmbeddingHashMap sharded(capacity);
+  EmbeddingHashMap baseline(0, capacity);
+  std::mt19937 rng(0);
+  // warm up, fill half of the cache with ids [0, capacity / 2)
+  const int resident = static_cast<int>(capacity / 2);
+  std::vector<int> warm_ids(resident);
+  for (int i = 0; i < resident; ++i) {
+    warm_ids[i] = i;
+  }
+  std::vector<int> indices(std::max(batch, static_cast<size_t>(resident)));
+  std::vector<int> swap_out_index(indices.size());
+  std::vector<int> swap_out_ids(indices.size());
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  (void)sharded.BatchInsert(warm_ids.data(), warm_ids.size(), 1, 0, indices.data(), swap_out_index.data(),
+                            swap_out_ids.data(), &swap_out_size, &need_wait_graph);
+  for (int id : warm_ids) {
+    swap_out_size = 0;
+    (void)baseline.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 0, &swap_out_size, &need_wait_graph);
+  }
+
+  std::uniform_int_distribution<int> hit_dist(0, resident - 1);
+  std::uniform_int_distribution<int> miss_dist(resident, INT32_MAX - 1);
+  std::bernoulli_distribution is_hit(hit_ratio);
+  std::vector<std::vector<int>> batches(loop, std::vector<int>(batch));
+  for (auto &ids : batches) {
+    for (auto &id : ids) {
+      id = is_hit(rng) ? hit_dist(rng) : miss_dist(rng);
+    }
+  }
+
+  BenchResult result;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &ids : batches) {
+    (void)sharded.BatchFind(ids.data(), batch, 1, indices.data());
+  }
+  auto end = std::chrono::steady_clock::now();
+  result.sharded_us = std::chrono::duration<double, std::micro>(end - start).count() / loop;
+
+  const auto &id_to_index = baseline.hash_id_to_index();
+  start = std::chrono::steady_clock::now();
+  for (const auto &ids : batches) {
+    for (size_t i = 0; i < batch; ++i) {
+      auto iter = id_to_index.find(ids[i]);
+      indices[i] = iter != id_to_index.end() ? iter->second : INVALID_INDEX_VALUE;
+      if (iter != id_to_index.end() && baseline.hash_step(iter->second) != 1) {
+        baseline.set_hash_step(iter->second, 1);
+      }
+    }
+  }
+  end = std::chrono::steady_clock::now();
+  result.baseline_us = std::chrono::duration<double, std::micro>(end - start).count() / loop;
+  return result;
+}
+
+int RunBenchmark() {
+  const size_t capacity = 1 << 20;
+  const size_t total_ids = 1 << 20;
+  for (size_t batch : {256, 4096, 65536}) {
+    for (double hit_ratio : {0.5, 0.9, 0.99}) {
+      auto result = RunLookupBench(capacity, batch, hit_ratio, std::max(total_ids / batch, static_cast<size_t>(1)));
+      std::cout << "batch: " << batch << ", hit ratio: " << hit_ratio << ", sharded BatchFind: " << result.sharded_us
+                << " us, EmbeddingHashMap find: " << result.baseline_us << " us" << std::endl;
+    }
+  }
+  return 0;
+}
+}  // namespace
+}  // namespace distributed
+}  // namespace mindspore
+
+int main() { return mindspore::distributed::RunBenchmark(); }
@@ -0,0 +1,235 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common_test.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "distributed/embedding_cache/embedding_hash_map.h"
+#define private public
+#include "distributed/embedding_cache/sharded_embedding_hash_map.h"
+#undef private
+
+namespace mindspore {
+namespace distributed {
+class TestShardedEmbeddingHashMap : public UT::Common {
+ public:
+  TestShardedEmbeddingHashMap() = default;
+  virtual ~TestShardedEmbeddingHashMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: Swiss table of embedding cache.
+/// Description: insert, find and erase ids until the tombstones force a rehash.
+/// Expectation: the map always returns the latest index of an id and reports missing ids.
+TEST_F(TestShardedEmbeddingHashMap, test_swiss_id_index_map) {
+  const size_t capacity = 1000;
+  SwissIdIndexMap map(capacity);
+  for (int id = 0; id < static_cast<int>(capacity); ++id) {
+    EXPECT_TRUE(map.Insert(id, id + 1, SwissIdIndexMap::Hash(id)));
+  }
+  EXPECT_EQ(map.size(), capacity);
+  EXPECT_FALSE(map.Insert(-1, 0, SwissIdIndexMap::Hash(-1)));
+  // update an existing id does not need a new slot
+  EXPECT_TRUE(map.Insert(7, 70, SwissIdIndexMap::Hash(7)));
+  EXPECT_EQ(map.Find(7, SwissIdIndexMap::Hash(7)), 70);
+
+  // keep the map full and evict one id per insertion, like a full cache does
+  for (int id = static_cast<int>(capacity); id < static_cast<int>(capacity) * 10; ++id) {
+    int evict = id - static_cast<int>(capacity);
+    EXPECT_TRUE(map.Erase(evict, SwissIdIndexMap::Hash(evict)));
+    EXPECT_TRUE(map.Insert(id, id + 1, SwissIdIndexMap::Hash(id)));
+  }
+  EXPECT_EQ(map.size(), capacity);
+  for (int id = 0; id < static_cast<int>(capacity) * 10; ++id) {
+    int expect = id >= static_cast<int>(capacity) * 9 ? id + 1 : INVALID_INDEX_VALUE;
+    EXPECT_EQ(map.Find(id, SwissIdIndexMap::Hash(id)), expect);
+  }
+}
+
+/// Feature: Sharded embedding hash map.
+/// Description: insert a batch, look it up, then overflow the cache so that expired ids are swapped out.
+/// Expectation: hits map to the same index, expired ids are reported in swap out info.
+TEST_F(TestShardedEmbeddingHashMap, test_batch_find_and_insert) {
+  const size_t capacity = 256;
+  const size_t shard_num = 4;
+  ShardedEmbeddingHashMap hash_map(capacity, shard_num);
+  EXPECT_EQ(hash_map.shard_num(), shard_num);
+  EXPECT_EQ(hash_map.hash_step(0), SIZE_MAX);
+  EXPECT_EQ(hash_map.hash_step(capacity - 1), SIZE_MAX);
+
+  const size_t batch = 64;
+  std::vector<int> ids(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    ids[i] = static_cast<int>(i * 3);
+  }
+  std::vector<int> indices(batch);
+  std::vector<int> swap_out_index(batch);
+  std::vector<int> swap_out_ids(batch);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  size_t data_step = 1;
+  EXPECT_EQ(hash_map.BatchFind(ids.data(), batch, data_step, indices.data()), 0);
+  EXPECT_TRUE(hash_map.BatchInsert(ids.data(), batch, data_step, 0, indices.data(), swap_out_index.data(),
+                                   swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+  EXPECT_EQ(swap_out_size, 0);
+  EXPECT_EQ(hash_map.hash_count(), batch);
+  std::set<int> used(indices.begin(), indices.end());
+  EXPECT_EQ(used.size(), batch);
+  EXPECT_EQ(used.count(0), 0);
+  EXPECT_EQ(used.count(capacity - 1), 0);
+
+  std::vector<int> found(batch);
+  EXPECT_EQ(hash_map.BatchFind(ids.data(), batch, data_step, found.data()), batch);
+  EXPECT_EQ(found, indices);
+
+  // insert until every shard is full, the ids of step 1 expire once the graph runs step 2
+  size_t total_swap_out = 0;
+  for (data_step = 2; data_step < 10; ++data_step) {
+    hash_map.Reset();
+    for (size_t i = 0; i < batch; ++i) {
+      ids[i] = static_cast<int>(data_step * 1000 + i);
+    }
+    swap_out_size = 0;
+    EXPECT_TRUE(hash_map.BatchInsert(ids.data(), batch, data_step, data_step - 1, indices.data(),
+                                     swap_out_index.data(), swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+    for (size_t i = 0; i < swap_out_size; ++i) {
+      EXPECT_EQ(hash_map.hash_step(swap_out_index[i]), data_step);
+    }
+    total_swap_out += swap_out_size;
+    EXPECT_EQ(hash_map.BatchFind(ids.data(), batch, data_step, found.data()), batch);
+    EXPECT_EQ(found, indices);
+  }
+  EXPECT_GT(total_swap_out, 0);
+  EXPECT_LE(hash_map.hash_count(), capacity - 2);
+}
+
+namespace {
+// The ids from start on whose shard is the one given.
+std::vector<int> IdsOfShard(const ShardedEmbeddingHashMap &hash_map, size_t shard, size_t id_num, int start) {
+  std::vector<int> ids;
+  for (int id = start; ids.size() < id_num; ++id) {
+    if (hash_map.ShardOf(SwissIdIndexMap::Hash(id)) == shard) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+}  // namespace
+
+/// Feature: Sharded embedding hash map.
+/// Description: insert more ids of one shard than the shard holds, then more than the whole cache holds, then expire
+/// the spilled ids by the ids of another shard.
+/// Expectation: the ids spill to the next shards until the whole cache is full, the spilled ids are found and swapped
+/// out like the others.
+TEST_F(TestShardedEmbeddingHashMap, test_full_shard_spill) {
+  // 4 shards of 16 indices, the first and the last index of the cache are reserved
+  const size_t capacity = 64;
+  const size_t shard_num = 4;
+  const size_t shard_size = capacity / shard_num;
+  const size_t free_num = capacity - 2;
+  ShardedEmbeddingHashMap hash_map(capacity, shard_num);
+  std::vector<int> indices(free_num);
+  std::vector<int> found(free_num);
+  std::vector<int> swap_out_index(free_num);
+  std::vector<int> swap_out_ids(free_num);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+
+  // the ids of shard 1 take all of it and spill to shard 2 and shard 3
+  auto ids = IdsOfShard(hash_map, 1, 40, 0);
+  EXPECT_TRUE(hash_map.BatchInsert(ids.data(), ids.size(), 1, 0, indices.data(), swap_out_index.data(),
+                                   swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+  EXPECT_EQ(swap_out_size, 0);
+  EXPECT_FALSE(need_wait_graph);
+  EXPECT_EQ(hash_map.hash_count(), ids.size());
+  std::set<int> used(indices.begin(), indices.begin() + ids.size());
+  EXPECT_EQ(used.size(), ids.size());
+  EXPECT_EQ(used.count(0), 0);
+  EXPECT_EQ(used.count(capacity - 1), 0);
+  EXPECT_EQ(*used.begin(), static_cast<int>(shard_size));
+  EXPECT_EQ(hash_map.shards_[1]->spilled_num_.load(), ids.size() - shard_size);
+  EXPECT_EQ(hash_map.BatchFind(ids.data(), ids.size(), 1, found.data()), ids.size());
+  EXPECT_TRUE(std::equal(indices.begin(), indices.begin() + ids.size(), found.begin()));
+
+  // the ids of step 1 are not expired by the graph of step 0, only the free slots of the whole cache are left
+  auto more_ids = IdsOfShard(hash_map, 1, 30, ids.back() + 1);
+  EXPECT_FALSE(hash_map.BatchInsert(more_ids.data(), more_ids.size(), 1, 0, indices.data(), swap_out_index.data(),
+                                    swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+  EXPECT_EQ(swap_out_size, 0);
+  EXPECT_EQ(hash_map.hash_count(), free_num);
+  size_t inserted = std::count_if(indices.begin(), indices.begin() + more_ids.size(),
+                                  [](int index) { return index != INVALID_INDEX_VALUE; });
+  EXPECT_EQ(inserted, free_num - ids.size());
+  EXPECT_EQ(hash_map.BatchFind(ids.data(), ids.size(), 1, found.data()), ids.size());
+
+  // once the graph runs step 2, the ids of shard 0 swap out all the ids of step 1, spilled or not
+  hash_map.Reset();
+  auto other_ids = IdsOfShard(hash_map, 0, free_num, 0);
+  EXPECT_TRUE(hash_map.BatchInsert(other_ids.data(), other_ids.size(), 3, 2, indices.data(), swap_out_index.data(),
+                                   swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+  EXPECT_EQ(swap_out_size, free_num);
+  EXPECT_EQ(hash_map.hash_count(), free_num);
+  EXPECT_EQ(hash_map.shards_[1]->spilled_num_.load(), 0);
+  EXPECT_EQ(hash_map.shards_[0]->spilled_num_.load(), free_num - (shard_size - 1));
+  EXPECT_EQ(hash_map.BatchFind(ids.data(), ids.size(), 3, found.data()), 0);
+  EXPECT_EQ(hash_map.BatchFind(other_ids.data(), other_ids.size(), 3, found.data()), free_num);
+  EXPECT_TRUE(std::equal(indices.begin(), indices.end(), found.begin()));
+}
+
+/// Feature: Sharded embedding hash map.
+/// Description: several readers look up the same batch of ids in the map at the same time.
+/// Expectation: every reader finds all the ids of every lookup.
+TEST_F(TestShardedEmbeddingHashMap, test_concurrent_batch_find) {
+  const size_t capacity = 1 << 16;
+  const size_t reader_num = 4;
+  const size_t batch = 4096;
+  ShardedEmbeddingHashMap sharded(capacity);
+  std::vector<int> ids(batch);
+  std::vector<int> indices(batch);
+  std::vector<int> swap_out_index(batch);
+  std::vector<int> swap_out_ids(batch);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  for (size_t i = 0; i < batch; ++i) {
+    ids[i] = static_cast<int>(i);
+  }
+  ASSERT_TRUE(sharded.BatchInsert(ids.data(), batch, 1, 0, indices.data(), swap_out_index.data(),
+                                  swap_out_ids.data(), &swap_out_size, &need_wait_graph));
+  std::vector<std::thread> readers;
+  std::vector<size_t> hits(reader_num, 0);
+  for (size_t r = 0; r < reader_num; ++r) {
+    readers.emplace_back([&, r]() {
+      std::vector<int> found(batch);
+      for (size_t loop = 0; loop < 100; ++loop) {
+        hits[r] += sharded.BatchFind(ids.data(), batch, 1, found.data());
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  for (auto hit : hits) {
+    EXPECT_EQ(hit, batch * 100);
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,215 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "distributed/rpc/shm/shm_client.h"
+#include "distributed/rpc/shm/shm_server.h"
+#include "distributed/rpc/tcp/tcp_client.h"
+#include "distributed/rpc/tcp/tcp_server.h"
+
+// The throughput of the shared memory and the loopback tcp transports between two processes, a child process sends
+// messages of sizes from 16B to 64MB to this process. Built by the target rpc_shm_benchmark, not run with the tests.
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+constexpr size_t kMaxBenchmarkBytes = 1 << 28;
+constexpr int kBenchmarkTimeoutInSec = 300;
+
+// Receive the messages of the benchmark, a message of size zero marks the end of the messages of one size.
+class BenchmarkReceiver {
+ public:
+  explicit BenchmarkReceiver(size_t size_num) : start_(size_num), end_(size_num) {}
+
+  MessageBase *const Handle(MessageBase *const message) {
+    auto now = std::chrono::steady_clock::now();
+    size_t size = message->data != nullptr ? message->size : message->body.size();
+    auto index = size_index_.load();
+    if (size == 0) {
+      end_[index] = now;
+      received_ = 0;
+      size_index_.store(index + 1);
+    } else if (received_++ == 0) {
+      start_[index] = now;
+    }
+    delete message;
+    return NULL_MSG;
+  }
+
+  bool Wait(size_t size_num, int timeout_in_sec) const {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_in_sec);
+    while (size_index_.load() < size_num) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  double Seconds(size_t index) const { return std::chrono::duration<double>(end_[index] - start_[index]).count(); }
+
+ private:
+  std::vector<std::chrono::steady_clock::time_point> start_;
+  std::vector<std::chrono::steady_clock::time_point> end_;
+  std::atomic<size_t> size_index_{0};
+  size_t received_{0};
+};
+
+size_t RoundsOfSize(size_t size) { return std::max<size_t>(4, std::min<size_t>(1000, kMaxBenchmarkBytes / size)); }
+
+// Fork a child process which reads the address of the server from the pipe and runs the sender.
+template <typename Sender>
+pid_t ForkSender(int *write_fd, Sender &&sender) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return -1;
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    (void)close(fds[1]);
+    char address[256] = {0};
+    auto len = read(fds[0], address, sizeof(address) - 1);
+    (void)close(fds[0]);
+    if (len <= 0) {
+      _exit(1);
+    }
+    sender(std::string(address, static_cast<size_t>(len)));
+    // The parent kills the child after it receives all messages, so the asynchronous sending is not interrupted.
+    while (true) {
+      (void)pause();
+    }
+  }
+  (void)close(fds[0]);
+  *write_fd = fds[1];
+  return pid;
+}
+
+void NotifyAddress(int write_fd, const std::string &address) {
+  (void)write(write_fd, address.data(), address.size());
+  (void)close(write_fd);
+}
+
+void StopSender(pid_t pid) {
+  (void)kill(pid, SIGKILL);
+  (void)waitpid(pid, nullptr, 0);
+}
+
+int RunBenchmark() {
+  std::vector<size_t> sizes = {16, 1 << 12, 1 << 16, 1 << 20, 1 << 24, 1 << 26};
+  // The sender of the child process, send the payload of every size then an empty message as the end mark.
+  auto run_sender = [&sizes](const std::function<void(const std::vector<uint8_t> &)> &send) {
+    for (size_t size : sizes) {
+      std::vector<uint8_t> payload(size, 'A');
+      for (size_t i = 0; i < RoundsOfSize(size); ++i) {
+        send(payload);
+      }
+      send({});
+    }
+  };
+
+  // The shared memory transport.
+  int write_fd = -1;
+  pid_t shm_pid = ForkSender(&write_fd, [&run_sender](const std::string &name) {
+    ShmClient client;
+    if (!client.Connect(name)) {
+      _exit(1);
+    }
+    AID from("shm_sender", "");
+    run_sender([&client, &from](const std::vector<uint8_t> &payload) {
+      (void)client.Send(from, {{payload.data(), payload.size()}});
+    });
+  });
+  if (shm_pid <= 0) {
+    std::cerr << "Failed to fork the shared memory sender." << std::endl;
+    return 1;
+  }
+  BenchmarkReceiver shm_receiver(sizes.size());
+  ShmServer shm_server;
+  if (!shm_server.Initialize("/mindspore_shm_benchmark_" + std::to_string(getpid()))) {
+    StopSender(shm_pid);
+    std::cerr << "Failed to initialize the shared memory server." << std::endl;
+    return 1;
+  }
+  shm_server.SetMessageHandler(std::bind(&BenchmarkReceiver::Handle, &shm_receiver, std::placeholders::_1));
+  NotifyAddress(write_fd, shm_server.GetName());
+  bool shm_finished = shm_receiver.Wait(sizes.size(), kBenchmarkTimeoutInSec);
+  StopSender(shm_pid);
+  shm_server.Finalize();
+  if (!shm_finished) {
+    std::cerr << "The shared memory transport timed out." << std::endl;
+    return 1;
+  }
+
+  // The tcp transport on the loopback.
+  pid_t tcp_pid = ForkSender(&write_fd, [&run_sender](const std::string &url) {
+    TCPClient client;
+    if (!client.Initialize() || !client.Connect(url)) {
+      _exit(1);
+    }
+    run_sender([&client, &url](const std::vector<uint8_t> &payload) {
+      auto message = std::make_unique<MessageBase>();
+      message->from = AID("tcp_sender", "");
+      message->to = AID("", url);
+      message->body.assign(payload.begin(), payload.end());
+      client.SendAsync(std::move(message));
+    });
+  });
+  if (tcp_pid <= 0) {
+    std::cerr << "Failed to fork the tcp sender." << std::endl;
+    return 1;
+  }
+  BenchmarkReceiver tcp_receiver(sizes.size());
+  TCPServer tcp_server;
+  bool tcp_finished = tcp_server.Initialize();
+  if (tcp_finished) {
+    tcp_server.SetMessageHandler(std::bind(&BenchmarkReceiver::Handle, &tcp_receiver, std::placeholders::_1));
+    NotifyAddress(write_fd, tcp_server.GetIP() + ":" + std::to_string(tcp_server.GetPort()));
+    tcp_finished = tcp_receiver.Wait(sizes.size(), kBenchmarkTimeoutInSec);
+  }
+  StopSender(tcp_pid);
+  tcp_server.Finalize();
+
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    // The first message of each size is not timed.
+    double bytes = static_cast<double>(sizes[i]) * (RoundsOfSize(sizes[i]) - 1);
+    std::cout << "message size: " << sizes[i] << " bytes, shm: " << bytes / shm_receiver.Seconds(i) / (1 << 20)
+              << " MB/s";
+    if (tcp_finished) {
+      std::cout << ", tcp: " << bytes / tcp_receiver.Seconds(i) / (1 << 20) << " MB/s";
+    }
+    std::cout << std::endl;
+  }
+  return 0;
+}
+}  // namespace
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+int main() { return mindspore::distributed::rpc::RunBenchmark(); }
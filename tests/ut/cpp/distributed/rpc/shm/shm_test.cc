@@ -0,0 +1,240 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "distributed/rpc/shm/shm_client.h"
+#include "distributed/rpc/shm/shm_ring.h"
+#include "distributed/rpc/shm/shm_server.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+class ShmTest : public UT::Common {
+ public:
+  ShmTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+constexpr size_t kTestRingCapacity = 1 << 16;
+
+std::string UniqueShmName(const std::string &tag) {
+  return "/mindspore_shm_test_" + tag + "_" + std::to_string(getpid());
+}
+
+// The content of every byte depends on the message index and the offset, so the reordered or corrupted bytes are found.
+uint8_t ExpectedByte(size_t index, size_t offset) { return static_cast<uint8_t>((index * 131 + offset * 7) & 0xff); }
+
+std::vector<uint8_t> MakePayload(size_t index, size_t size) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < size; ++i) {
+    payload[i] = ExpectedByte(index, i);
+  }
+  return payload;
+}
+
+void StopProcess(pid_t pid) {
+  (void)kill(pid, SIGKILL);
+  (void)waitpid(pid, nullptr, 0);
+}
+}  // namespace
+
+/// Feature: Shared memory ring.
+/// Description: write messages gathered from several buffers with random sizes, some of them are larger than the ring.
+/// Expectation: every message is read once with the same meta and payload, in the order of writing.
+TEST_F(ShmTest, test_ring_write_and_read) {
+  ShmRing reader;
+  auto name = UniqueShmName("ring");
+  ASSERT_TRUE(reader.Create(name, kTestRingCapacity));
+  EXPECT_EQ(reader.capacity(), kTestRingCapacity);
+  ShmRing writer;
+  ASSERT_TRUE(writer.Open(name));
+  ShmRing unknown;
+  EXPECT_FALSE(unknown.Open(UniqueShmName("unknown")));
+
+  std::vector<size_t> sizes = {0, 1, 15, 16, 17, 1000, kTestRingCapacity / 4, kTestRingCapacity - 1,
+                               kTestRingCapacity * 3 + 5};
+  for (size_t i = 0; i < 200; ++i) {
+    sizes.push_back((i * 7919) % 5000);
+  }
+  std::thread writer_thread([&writer, &sizes]() {
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      auto payload = MakePayload(i, sizes[i]);
+      // Split the payload into three pieces, the first one may be empty.
+      size_t first = payload.size() / 3;
+      size_t second = payload.size() / 2;
+      std::vector<ShmBuffer> buffers = {{payload.data(), first},
+                                        {payload.data() + first, second - first},
+                                        {payload.data() + second, payload.size() - second}};
+      ASSERT_TRUE(writer.Write("sender_" + std::to_string(i), buffers));
+    }
+  });
+
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    std::string meta;
+    std::vector<uint8_t> received;
+    size_t size = 0;
+    ASSERT_TRUE(reader.Read(
+      &meta,
+      [&received](size_t size) -> void * {
+        received.resize(size);
+        return received.data();
+      },
+      &size));
+    EXPECT_EQ(meta, "sender_" + std::to_string(i));
+    ASSERT_EQ(size, sizes[i]);
+    for (size_t j = 0; j < size; ++j) {
+      ASSERT_EQ(received[j], ExpectedByte(i, j)) << "message " << i << ", offset " << j;
+    }
+  }
+  writer_thread.join();
+
+  // The blocked reader returns after shutdown.
+  std::thread shutdown_thread([&reader]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reader.Shutdown();
+  });
+  std::string meta;
+  size_t size = 0;
+  EXPECT_FALSE(reader.Read(&meta, [](size_t) -> void * { return nullptr; }, &size));
+  shutdown_thread.join();
+  EXPECT_FALSE(writer.Write("", {}));
+}
+
+/// Feature: Shared memory ring.
+/// Description: a writer process is killed in the middle of a message larger than the ring while holding the lock.
+/// Expectation: the next writer takes the lock over, the unfinished message is dropped and the next one is read.
+TEST_F(ShmTest, test_ring_dead_writer) {
+  ShmRing reader;
+  auto name = UniqueShmName("dead_writer");
+  ASSERT_TRUE(reader.Create(name, kTestRingCapacity));
+  pid_t pid = fork();
+  if (pid == 0) {
+    ShmRing dead_writer;
+    if (dead_writer.Open(name)) {
+      // Blocks with the lock held once the ring is full, nobody reads until the process is killed.
+      auto payload = MakePayload(0, kTestRingCapacity * 3);
+      (void)dead_writer.Write("dead", {{payload.data(), payload.size()}});
+    }
+    _exit(0);
+  }
+  ASSERT_GT(pid, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  StopProcess(pid);
+
+  ShmRing writer;
+  ASSERT_TRUE(writer.Open(name));
+  auto payload = MakePayload(1, 1000);
+  std::thread writer_thread([&writer, &payload]() {
+    EXPECT_TRUE(writer.Write("alive", {{payload.data(), payload.size()}}));
+  });
+  std::string meta;
+  std::vector<uint8_t> received;
+  size_t size = 0;
+  auto allocate = [&received](size_t size) -> void * {
+    received.resize(size);
+    return received.data();
+  };
+  size_t freed = 0;
+  auto free_message = [&freed, &received](void *data) {
+    EXPECT_EQ(data, received.data());
+    ++freed;
+  };
+  // The first read fails on the unfinished message unless the child was killed before it took the lock, the memory
+  // allocated for the unfinished message is freed.
+  bool dropped = !reader.Read(&meta, allocate, &size, free_message);
+  if (dropped) {
+    ASSERT_TRUE(reader.Read(&meta, allocate, &size, free_message));
+  }
+  writer_thread.join();
+  EXPECT_EQ(freed, dropped ? 1 : 0);
+  EXPECT_EQ(meta, "alive");
+  ASSERT_EQ(size, payload.size());
+  EXPECT_EQ(received, payload);
+}
+
+/// Feature: Shared memory server and client.
+/// Description: several clients send messages with body or raw data to one server.
+/// Expectation: the server receives all messages with the sender and the payload.
+TEST_F(ShmTest, test_server_and_client) {
+  const size_t client_num = 4;
+  const size_t msg_num = 100;
+  ShmServer server;
+  ASSERT_TRUE(server.Initialize(UniqueShmName("server"), {}, {}, kTestRingCapacity));
+  std::atomic<size_t> received{0};
+  std::atomic<size_t> invalid{0};
+  server.SetMessageHandler([&](MessageBase *const message) -> MessageBase *const {
+    if (message->From().Name().find("client_") != 0 || message->body.size() != msg_num) {
+      ++invalid;
+    }
+    ++received;
+    delete message;
+    return NULL_MSG;
+  });
+
+  std::vector<std::thread> clients;
+  std::atomic<size_t> freed{0};
+  for (size_t c = 0; c < client_num; ++c) {
+    clients.emplace_back([&, c]() {
+      ShmClient client;
+      ASSERT_TRUE(client.Connect(server.GetName(), [&freed](void *data) {
+        free(data);
+        ++freed;
+        return true;
+      }));
+      AID from("client_" + std::to_string(c), "127.0.0.1:0");
+      for (size_t i = 0; i < msg_num; ++i) {
+        auto message = std::make_unique<MessageBase>();
+        message->from = from;
+        if (i % 2 == 0) {
+          message->body = std::string(msg_num, 'A');
+          ASSERT_TRUE(client.SendMessage(std::move(message)));
+        } else {
+          message->data = malloc(msg_num);
+          message->size = msg_num;
+          ASSERT_TRUE(client.SendMessage(std::move(message)));
+        }
+      }
+      client.Disconnect();
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (received.load() < client_num * msg_num && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  server.Finalize();
+  EXPECT_EQ(received.load(), client_num * msg_num);
+  EXPECT_EQ(invalid.load(), 0);
+  EXPECT_EQ(freed.load(), client_num * msg_num / 2);
+}
+
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common/common_test.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// Merge the blob columns into a blob in the row layout, in which each column is prefixed by its big endian size
+std::vector<uint8_t> MergeBlob(const std::vector<std::vector<uint8_t>> &columns) {
+  std::vector<uint8_t> blob;
+  for (const auto &column : columns) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      blob.push_back(static_cast<uint8_t>((column.size() >> shift) & 0xff));
+    }
+    blob.insert(blob.end(), column.begin(), column.end());
+  }
+  return blob;
+}
+}  // namespace
+
+class TestShardColumn : public UT::Common {
+ public:
+  TestShardColumn() {}
+
+  void SetUp() override {
+    json schema = R"({"schema": {"file_name": {"type": "string"},
+                                 "label": {"type": "int32"},
+                                 "data": {"type": "bytes"},
+                                 "mask": {"type": "bytes"}},
+                      "blob_fields": ["data", "mask"]})"_json;
+    column_ = std::make_shared<ShardColumn>(schema, false);
+    data_ = std::vector<uint8_t>(10000, 7);
+    for (size_t i = 0; i < data_.size(); i += 100) {
+      data_[i] = static_cast<uint8_t>(i & 0xff);
+    }
+    mask_ = {1, 2, 3};
+  }
+
+  std::shared_ptr<ShardColumn> column_;
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> mask_;
+};
+
+/// Feature: ShardColumn
+/// Description: encode a blob into the columnar layout and decode it back
+/// Expectation: the decoded blob is the same as the original blob
+TEST_F(TestShardColumn, TestColumnarRoundTrip) {
+  EXPECT_EQ(column_->GetBlobColumnId("data"), 0);
+  EXPECT_EQ(column_->GetBlobColumnId("mask"), 1);
+  EXPECT_EQ(column_->GetBlobColumnId("label"), -1);
+
+  auto blob = MergeBlob({data_, mask_});
+  for (auto compression : {kBlobCompressionNone, kBlobCompressionZlib}) {
+    std::vector<uint8_t> columnar_blob;
+    auto status = column_->EncodeColumnarBlob(blob, compression, &columnar_blob);
+    if (compression == kBlobCompressionZlib && status.IsError()) {
+      MS_LOG(WARNING) << "zlib is not enabled, skip the compressed round trip.";
+      continue;
+    }
+    ASSERT_TRUE(status.IsOk());
+    if (compression == kBlobCompressionZlib) {
+      EXPECT_LT(columnar_blob.size(), blob.size());
+    } else {
+      EXPECT_EQ(columnar_blob.size(), column_->GetColumnarDirectorySize() + data_.size() + mask_.size());
+    }
+
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(column_->DecodeColumnarBlob(columnar_blob, &decoded).IsOk());
+    EXPECT_EQ(decoded, blob);
+  }
+}
+
+/// Feature: ShardColumn
+/// Description: decode only one blob column of a blob in the columnar layout by its directory
+/// Expectation: the selected column is decoded and the other column is empty
+TEST_F(TestShardColumn, TestColumnarProjection) {
+  auto blob = MergeBlob({data_, mask_});
+  std::vector<uint8_t> columnar_blob;
+  ASSERT_TRUE(column_->EncodeColumnarBlob(blob, kBlobCompressionNone, &columnar_blob).IsOk());
+
+  std::vector<uint8_t> directory(columnar_blob.begin(), columnar_blob.begin() + column_->GetColumnarDirectorySize());
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> entries;
+  ASSERT_TRUE(column_->ParseColumnarDirectory(directory, &entries).IsOk());
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(std::get<2>(entries[0]), data_.size());
+  EXPECT_EQ(std::get<2>(entries[1]), mask_.size());
+
+  auto offset = std::get<0>(entries[1]);
+  auto stored_size = std::get<1>(entries[1]);
+  std::vector<std::vector<uint8_t>> columns = {
+    {}, std::vector<uint8_t>(columnar_blob.begin() + offset, columnar_blob.begin() + offset + stored_size)};
+  std::vector<uint8_t> decoded;
+  ASSERT_TRUE(column_->DecodeColumnarBlob(columns, {0, std::get<2>(entries[1])}, &decoded).IsOk());
+  EXPECT_EQ(decoded, MergeBlob({{}, mask_}));
+
+  // A truncated directory is rejected
+  directory.pop_back();
+  EXPECT_TRUE(column_->ParseColumnarDirectory(directory, &entries).IsError());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,165 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "common/common_test.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#define private public
+#include "minddata/mindrecord/include/shard_io_engine.h"
+#undef private
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kFileSize = 1 << 20;
+
+uint8_t ByteAt(int shard_id, uint64_t offset) { return static_cast<uint8_t>((offset * 131 + shard_id * 7) & 0xff); }
+}  // namespace
+
+class TestShardIoEngine : public UT::Common {
+ public:
+  TestShardIoEngine() {}
+
+  void SetUp() override {
+    for (int shard_id = 0; shard_id < 2; ++shard_id) {
+      std::string file_name = "./io_engine_test.shard0" + std::to_string(shard_id);
+      std::vector<uint8_t> data(kFileSize);
+      for (uint64_t i = 0; i < kFileSize; ++i) {
+        data[i] = ByteAt(shard_id, i);
+      }
+      std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+      ofs.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+      ofs.close();
+      file_names_.push_back(file_name);
+    }
+  }
+
+  void TearDown() override {
+    for (const auto &file_name : file_names_) {
+      (void)remove(file_name.c_str());
+    }
+    file_names_.clear();
+  }
+
+  bool CheckRead(int shard_id, uint64_t offset, const std::vector<uint8_t> &buffer) {
+    for (uint64_t i = 0; i < buffer.size(); ++i) {
+      if (buffer[i] != ByteAt(shard_id, offset + i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<std::string> file_names_;
+};
+
+/// Feature: ShardIoEngine
+/// Description: read scattered ranges of two files, the adjacent ranges are coalesced
+/// Expectation: the data of all ranges is read and the number of reads is less than the number of requests
+TEST_F(TestShardIoEngine, TestReadCoalesced) {
+  ShardIoEngine engine;
+  ASSERT_TRUE(engine.Open(file_names_).IsOk());
+  MS_LOG(INFO) << "io_uring enabled: " << engine.IsIoUringEnabled();
+
+  std::vector<std::tuple<int, uint64_t, uint64_t>> ranges = {
+    {0, 0, 100},      {0, 100, 200},   {0, 400, 50},  {0, 500000, 4096}, {1, 8192, 1000},
+    {1, 10000, 1000}, {1, 700000, 17}, {0, 120, 300}, {1, 1048000, 576}};
+  std::vector<std::vector<uint8_t>> buffers(ranges.size());
+  std::vector<ShardReadRequest> requests;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    buffers[i].resize(std::get<2>(ranges[i]));
+    requests.push_back({std::get<0>(ranges[i]), std::get<1>(ranges[i]), std::get<2>(ranges[i]), buffers[i].data()});
+  }
+  ASSERT_TRUE(engine.Read(requests).IsOk());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    EXPECT_TRUE(CheckRead(std::get<0>(ranges[i]), std::get<1>(ranges[i]), buffers[i]));
+  }
+
+  auto statistics = engine.GetStatistics();
+  EXPECT_EQ(statistics.read_requests, ranges.size());
+  EXPECT_LT(statistics.read_ops, statistics.read_requests);
+  EXPECT_GT(statistics.read_bytes, 0);
+}
+
+/// Feature: ShardIoEngine
+/// Description: read more ranges than the queue depth from many threads
+/// Expectation: the data of all ranges is read, the threads reading at the same time do not share an io_uring
+TEST_F(TestShardIoEngine, TestReadConcurrently) {
+  ShardIoEngine engine;
+  ASSERT_TRUE(engine.Open(file_names_, 4).IsOk());
+
+  const int thread_num = 4;
+  const uint64_t range_size = 1000;
+  std::vector<std::thread> threads;
+  std::vector<int> results(thread_num, 0);
+  for (int t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<std::vector<uint8_t>> buffers(64, std::vector<uint8_t>(range_size));
+      std::vector<ShardReadRequest> requests;
+      for (size_t i = 0; i < buffers.size(); ++i) {
+        // The ranges of the same file are apart more than the coalescing gap, so that every range is a read.
+        uint64_t offset = (i * thread_num + t) * 4096;
+        requests.push_back({static_cast<int>(i % 2), offset, range_size, buffers[i].data()});
+      }
+      if (engine.Read(requests).IsError()) {
+        return;
+      }
+      for (size_t i = 0; i < buffers.size(); ++i) {
+        if (!CheckRead(requests[i].shard_id, requests[i].offset, buffers[i])) {
+          return;
+        }
+      }
+      results[t] = 1;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < thread_num; ++t) {
+    EXPECT_EQ(results[t], 1);
+  }
+  EXPECT_EQ(engine.GetStatistics().read_bytes, thread_num * 64 * range_size);
+  if (engine.IsIoUringEnabled()) {
+    // A ring is set up for every thread reading at the same time, all of them are given back after the reads.
+    EXPECT_LE(engine.rings_.size(), static_cast<size_t>(thread_num));
+    EXPECT_EQ(engine.free_rings_.size(), engine.rings_.size());
+  }
+}
+
+/// Feature: ShardIoEngine
+/// Description: read a range beyond the end of the file and a range of an invalid shard
+/// Expectation: the reads fail
+TEST_F(TestShardIoEngine, TestReadInvalid) {
+  ShardIoEngine engine;
+  ASSERT_TRUE(engine.Open(file_names_).IsOk());
+
+  std::vector<uint8_t> buffer(100);
+  EXPECT_TRUE(engine.Read({{0, kFileSize - 10, 100, buffer.data()}}).IsError());
+  EXPECT_TRUE(engine.Read({{2, 0, 100, buffer.data()}}).IsError());
+  EXPECT_TRUE(engine.Read({{1, 0, 100, buffer.data()}}).IsOk());
+  EXPECT_TRUE(CheckRead(1, 0, buffer));
+
+  EXPECT_TRUE(engine.Open({"./io_engine_test.not_exist"}).IsError());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
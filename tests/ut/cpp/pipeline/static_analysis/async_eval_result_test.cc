@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/common_test.h"
+#define private public
+#include "pipeline/jit/static_analysis/async_eval_result.h"
+#undef private
+
+namespace mindspore {
+namespace abstract {
+namespace {
+constexpr auto kTaskTimeout = std::chrono::seconds(5);
+
+// Wait until all the infer threads are idle, return the number of them.
+size_t WaitInferThreadsIdle(AnalysisSchedule *schedule) {
+  auto deadline = std::chrono::steady_clock::now() + kTaskTimeout;
+  while (std::chrono::steady_clock::now() < deadline) {
+    {
+      std::lock_guard<std::mutex> lock(schedule->infer_task_lock_);
+      if (schedule->infer_tasks_.empty() && schedule->idle_infer_threads_ == schedule->infer_threads_) {
+        return schedule->infer_threads_;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return 0;
+}
+}  // namespace
+
+class TestAnalysisSchedule : public UT::Common {
+ public:
+  TestAnalysisSchedule() = default;
+};
+
+/// Feature: infer threads of the analysis schedule.
+/// Description: run two infer tasks one after the other.
+/// Expectation: the second task runs on an idle infer thread and no thread is created for it.
+TEST_F(TestAnalysisSchedule, test_infer_thread_reuse) {
+  auto &schedule = AnalysisSchedule::GetInstance();
+  std::promise<std::thread::id> first;
+  schedule.RunInferTask([&first]() { first.set_value(std::this_thread::get_id()); });
+  auto first_future = first.get_future();
+  ASSERT_EQ(first_future.wait_for(kTaskTimeout), std::future_status::ready);
+  auto first_id = first_future.get();
+  auto thread_num = WaitInferThreadsIdle(&schedule);
+  ASSERT_GT(thread_num, 0u);
+
+  std::promise<std::thread::id> second;
+  schedule.RunInferTask([&second]() { second.set_value(std::this_thread::get_id()); });
+  auto second_future = second.get_future();
+  ASSERT_EQ(second_future.wait_for(kTaskTimeout), std::future_status::ready);
+  auto second_id = second_future.get();
+  ASSERT_NE(second_id, std::this_thread::get_id());
+  if (thread_num == 1) {
+    ASSERT_EQ(second_id, first_id);
+  }
+  // no thread is created for the second task, an idle one may have exited meanwhile
+  ASSERT_LE(WaitInferThreadsIdle(&schedule), thread_num);
+}
+
+/// Feature: infer threads of the analysis schedule.
+/// Description: run an infer task which waits for the infer task added after it.
+/// Expectation: the tasks run on different threads and both finish, a task never waits for a thread.
+TEST_F(TestAnalysisSchedule, test_infer_tasks_wait_each_other) {
+  auto &schedule = AnalysisSchedule::GetInstance();
+  auto thread_num = WaitInferThreadsIdle(&schedule);
+  std::promise<std::thread::id> first;
+  std::promise<std::thread::id> second;
+  auto second_future = second.get_future().share();
+  schedule.RunInferTask([&first, second_future]() {
+    if (second_future.wait_for(kTaskTimeout) == std::future_status::ready) {
+      first.set_value(std::this_thread::get_id());
+    }
+  });
+  schedule.RunInferTask([&second]() { second.set_value(std::this_thread::get_id()); });
+  auto first_future = first.get_future();
+  ASSERT_EQ(first_future.wait_for(kTaskTimeout), std::future_status::ready);
+  ASSERT_NE(first_future.get(), second_future.get());
+  // a thread is created only when all the infer threads are busy
+  auto new_thread_num = WaitInferThreadsIdle(&schedule);
+  ASSERT_GE(new_thread_num, 2u);
+  ASSERT_LE(new_thread_num, thread_num + 2);
+}
+}  // namespace abstract
+}  // namespace mindspore
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "utils/ms_utils.h"
+
+// The bandwidth of the allreduce of cpu collective ops, the data from 4KB to 64MB is reduced in 4 local processes over
+// loopback. Built by the target ms_collective_allreduce_benchmark, not run with the tests.
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kRankNum = 4;
+constexpr size_t kIterations = 5;
+constexpr char kServerPort[] = "8093";
+
+// Run the AllReduce of the data sizes as one rank in a child process, the bandwidth of each data size is printed by
+// rank 0.
+bool RunAllReduceRank(const std::vector<size_t> &data_sizes) {
+  auto cgn = std::make_shared<distributed::cluster::topology::ComputeGraphNode>(
+    "compute_graph_node_" + std::to_string(getpid()), "worker");
+  if (!cgn->Initialize()) {
+    return false;
+  }
+  size_t retry = 30;
+  while (!cgn->Initialized() && retry-- > 0) {
+    sleep(1);
+  }
+
+  auto topo_node = std::make_shared<TopologyNode>(kRankNum, cgn);
+  if (!topo_node->Initialize() || !topo_node->Initialized()) {
+    return false;
+  }
+  MSCollectiveOpsImpl ops_impl(topo_node);
+  if (!ops_impl.Initialize()) {
+    return false;
+  }
+
+  bool success = true;
+  size_t rank_id = topo_node->rank_id();
+  for (size_t data_size : data_sizes) {
+    size_t count = data_size / sizeof(float);
+    std::vector<float> input(count, static_cast<float>(rank_id + 1));
+    std::vector<float> output(count, 0);
+    // The first round is the warm up and is not timed.
+    success = success && ops_impl.AllReduce<float>("data", input.data(), output.data(), count);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kIterations && success; i++) {
+      success = ops_impl.AllReduce<float>("data", input.data(), output.data(), count);
+    }
+    double cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / kIterations;
+    if (success && rank_id == 0) {
+      // The bus bandwidth is the algorithm bandwidth scaled by 2*(n-1)/n, the data each rank sends in the ring.
+      double alg_bw = data_size / cost / (1 << 30);
+      double bus_bw = alg_bw * 2 * (kRankNum - 1) / kRankNum;
+      printf("AllReduce ranks: %zu, size: %zu bytes, time: %.3f ms, algbw: %.3f GB/s, busbw: %.3f GB/s\n", kRankNum,
+             data_size, cost * 1000, alg_bw, bus_bw);
+    }
+  }
+
+  (void)topo_node->Finalize();
+  (void)cgn->Finalize();
+  return success;
+}
+
+// Fork the rank processes, run the meta server node in the current process and wait for the ranks to exit.
+int RunBenchmark() {
+  std::vector<size_t> data_sizes;
+  for (size_t size = 4 * 1024; size <= 64 * 1024 * 1024; size *= 4) {
+    data_sizes.push_back(size);
+  }
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, "127.0.0.1");
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, kServerPort);
+
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < kRankNum; ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      printf("Failed to fork the rank process.\n");
+      return 1;
+    }
+    if (pid == 0) {
+      _exit(RunAllReduceRank(data_sizes) ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+
+  int result = 0;
+  distributed::cluster::topology::MetaServerNode msn("meta_server_node", "scheduler", kRankNum);
+  if (!msn.Initialize()) {
+    printf("Failed to initialize the meta server node.\n");
+    result = 1;
+  }
+  for (auto pid : pids) {
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      result = 1;
+    }
+  }
+  msn.Finalize(true);
+  if (result != 0) {
+    printf("The allreduce benchmark failed.\n");
+  }
+  return result;
+}
+}  // namespace
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+int main() { return mindspore::device::cpu::RunBenchmark(); }
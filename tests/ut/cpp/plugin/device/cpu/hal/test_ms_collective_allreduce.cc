@@ -0,0 +1,151 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <vector>
+#include <gtest/gtest.h>
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "utils/ms_utils.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestMSCollectiveAllReduce : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+// The inputs are small integers which are exact in float, so the sums do not depend on the order of the reduction.
+constexpr size_t kValueRange = 1000;
+
+// The input of every element depends on its index and the rank, so a segment reduced with the wrong segment of another
+// rank, or an element missing the data of some rank, changes the result.
+template <typename T>
+T InputValue(size_t rank_id, size_t index) {
+  return static_cast<T>((index % kValueRange) * (rank_id + 1) + rank_id);
+}
+
+template <typename T>
+T ExpectedValue(size_t rank_num, size_t index) {
+  return static_cast<T>((index % kValueRange) * rank_num * (rank_num + 1) / 2 + rank_num * (rank_num - 1) / 2);
+}
+
+template <typename T>
+bool CheckAllReduce(MSCollectiveOpsImpl *ops_impl, size_t rank_num, size_t rank_id, size_t data_size) {
+  size_t count = data_size / sizeof(T);
+  std::vector<T> input(count);
+  for (size_t i = 0; i < count; i++) {
+    input[i] = InputValue<T>(rank_id, i);
+  }
+  std::vector<T> output(count, 0);
+  if (!ops_impl->AllReduce<T>("data", input.data(), output.data(), count)) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (output[i] != ExpectedValue<T>(rank_num, i)) {
+      printf("AllReduce rank: %zu, count: %zu, element %zu is wrong\n", rank_id, count, i);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Run the AllReduce of the data sizes as one rank in a child process, and check the results.
+bool RunAllReduceRank(size_t rank_num, const std::vector<size_t> &data_sizes) {
+  auto cgn = std::make_shared<distributed::cluster::topology::ComputeGraphNode>(
+    "compute_graph_node_" + std::to_string(getpid()), "worker");
+  if (!cgn->Initialize()) {
+    return false;
+  }
+  size_t retry = 30;
+  while (!cgn->Initialized() && retry-- > 0) {
+    sleep(1);
+  }
+
+  auto topo_node = std::make_shared<TopologyNode>(rank_num, cgn);
+  if (!topo_node->Initialize() || !topo_node->Initialized()) {
+    return false;
+  }
+  MSCollectiveOpsImpl ops_impl(topo_node);
+  if (!ops_impl.Initialize()) {
+    return false;
+  }
+
+  bool success = true;
+  size_t rank_id = topo_node->rank_id();
+  for (size_t data_size : data_sizes) {
+    success = success && CheckAllReduce<float>(&ops_impl, rank_num, rank_id, data_size) &&
+              CheckAllReduce<int>(&ops_impl, rank_num, rank_id, data_size);
+  }
+
+  (void)topo_node->Finalize();
+  (void)cgn->Finalize();
+  return success;
+}
+
+// Fork the rank processes, run the meta server node in the current process and wait for the ranks to exit.
+void RunAllReduce(size_t rank_num, const std::string &server_port, const std::vector<size_t> &data_sizes) {
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, "127.0.0.1");
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, server_port.c_str());
+
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < rank_num; ++i) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      _exit(RunAllReduceRank(rank_num, data_sizes) ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+
+  distributed::cluster::topology::MetaServerNode msn("meta_server_node", "scheduler", rank_num);
+  ASSERT_TRUE(msn.Initialize());
+  for (auto pid : pids) {
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+  }
+  msn.Finalize(true);
+}
+}  // namespace
+
+/// Feature: test the allreduce of cpu collective ops.
+/// Description: run the allreduce in 3 processes, whose rank size is not a power of two, with both the small data
+/// reduced by recursive halving and doubling and the large data reduced by the pipelined ring.
+/// Expectation: every element of the results of all the ranks is the sum of the element over the ranks.
+TEST_F(TestMSCollectiveAllReduce, AllReduceNonPowerOfTwoRanks) {
+  RunAllReduce(3, "8091", {4, 4096, kRingAllReduceThreshold, 4 * 1024 * 1024 + 4});
+}
+
+/// Feature: test the allreduce of cpu collective ops.
+/// Description: run the allreduce in 4 processes with the data whose count is not a multiple of the rank size, so the
+/// segments of the ranks have different sizes, and with the data of several pieces of the pipelined ring.
+/// Expectation: every element of the results of all the ranks is the sum of the element over the ranks.
+TEST_F(TestMSCollectiveAllReduce, AllReducePowerOfTwoRanks) {
+  RunAllReduce(4, "8092", {12, 4092, kRingAllReduceThreshold + 4, 3 * kRingAllReducePieceSize * 4 + 12});
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,211 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "include/common/utils/python_adapter.h"
+#include "pybind_api/gil_scoped_long_running.h"
+#include "runtime/pynative/async/async_queue.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+// The capacity of the ring of AsyncQueue.
+constexpr size_t kRingCapacity = 4096;
+}  // namespace
+
+class TestAsyncQueue : public UT::Common {
+ public:
+  TestAsyncQueue() {}
+};
+
+class FuncTask : public AsyncTask {
+ public:
+  explicit FuncTask(std::function<void()> func) : AsyncTask(kOpRunTask), func_(std::move(func)) {}
+  ~FuncTask() override = default;
+  void Run() override { func_(); }
+
+ private:
+  std::function<void()> func_;
+};
+
+/// Feature: PyNative async queue
+/// Description: Push more tasks than the capacity of the ring and wait for them
+/// Expectation: All the tasks run in the order they are pushed
+TEST_F(TestAsyncQueue, test_run_in_order) {
+  AsyncQueue queue;
+  constexpr int kTaskNum = 10000;
+  std::vector<int> results;
+  for (int i = 0; i < kTaskNum; ++i) {
+    queue.Push(std::make_shared<FuncTask>([&results, i]() { results.push_back(i); }));
+  }
+  queue.Wait();
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(results.size(), kTaskNum);
+  for (int i = 0; i < kTaskNum; ++i) {
+    ASSERT_EQ(results[i], i);
+  }
+}
+
+/// Feature: PyNative async queue
+/// Description: Push tasks from several threads at the same time
+/// Expectation: All the tasks run exactly once
+TEST_F(TestAsyncQueue, test_multi_producer) {
+  AsyncQueue queue;
+  constexpr int kThreadNum = 4;
+  constexpr int kTaskNum = 5000;
+  std::atomic<int> count{0};
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kThreadNum; ++i) {
+    (void)producers.emplace_back([&queue, &count]() {
+      for (int j = 0; j < kTaskNum; ++j) {
+        queue.Push(std::make_shared<FuncTask>([&count]() { ++count; }));
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  queue.Wait();
+  ASSERT_EQ(count.load(), kThreadNum * kTaskNum);
+}
+
+/// Feature: PyNative async queue
+/// Description: Push a task after the worker is parked on an empty queue
+/// Expectation: The worker is woken up and the task runs
+TEST_F(TestAsyncQueue, test_wake_up_parked_worker) {
+  AsyncQueue queue;
+  std::atomic<int> count{0};
+  for (int i = 0; i < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.Push(std::make_shared<FuncTask>([&count]() { ++count; }));
+    queue.Wait();
+    ASSERT_EQ(count.load(), i + 1);
+  }
+}
+
+/// Feature: PyNative async queue
+/// Description: A task throws an exception with tasks pushed after it
+/// Expectation: The tasks after it are dropped, Wait throws the exception and the queue runs new tasks
+TEST_F(TestAsyncQueue, test_task_exception) {
+  AsyncQueue queue;
+  std::atomic<int> count{0};
+  queue.Push(std::make_shared<FuncTask>([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    throw std::runtime_error("task failed");
+  }));
+  for (int i = 0; i < 10; ++i) {
+    queue.Push(std::make_shared<FuncTask>([&count]() { ++count; }));
+  }
+  ASSERT_ANY_THROW(queue.Wait());
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(count.load(), 0);
+
+  queue.Push(std::make_shared<FuncTask>([&count]() { ++count; }));
+  queue.Wait();
+  ASSERT_EQ(count.load(), 1);
+}
+
+/// Feature: PyNative async queue
+/// Description: Reset the queue with a task in progress and tasks pending
+/// Expectation: The task in progress finishes and the pending tasks are dropped
+TEST_F(TestAsyncQueue, test_reset) {
+  AsyncQueue queue;
+  std::atomic<int> count{0};
+  std::atomic<bool> started{false};
+  queue.Push(std::make_shared<FuncTask>([&count, &started]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++count;
+  }));
+  // Make sure the first task is in progress.
+  while (!started) {
+    std::this_thread::yield();
+  }
+  for (int i = 0; i < 10; ++i) {
+    queue.Push(std::make_shared<FuncTask>([&count]() { count += 10; }));
+  }
+  queue.Reset();
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(count.load(), 1);
+}
+
+/// Feature: PyNative async queue
+/// Description: Push more tasks than the capacity of the ring while the worker is blocked by a task
+/// Expectation: Push waits when the ring is full, and all the tasks run in order once the worker goes on
+TEST_F(TestAsyncQueue, test_push_to_full_ring) {
+  AsyncQueue queue;
+  constexpr size_t kTaskNum = kRingCapacity + 1000;
+  std::atomic<bool> blocked{true};
+  queue.Push(std::make_shared<FuncTask>([&blocked]() {
+    while (blocked) {
+      std::this_thread::yield();
+    }
+  }));
+  std::atomic<size_t> pushed{0};
+  std::vector<size_t> results;
+  std::thread producer([&queue, &pushed, &results]() {
+    for (size_t i = 0; i < kTaskNum; ++i) {
+      queue.Push(std::make_shared<FuncTask>([&results, i]() { results.push_back(i); }));
+      ++pushed;
+    }
+  });
+  while (pushed < kRingCapacity - 1) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // The ring is full, the producer can not push all the tasks before the worker takes them.
+  ASSERT_LT(pushed.load(), kTaskNum);
+  ASSERT_TRUE(results.empty());
+
+  blocked = false;
+  producer.join();
+  queue.Wait();
+  ASSERT_EQ(results.size(), kTaskNum);
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    ASSERT_EQ(results[i], i);
+  }
+}
+
+/// Feature: PyNative async queue
+/// Description: Push more tasks than the capacity of the ring with the GIL held, and the tasks acquire the GIL
+/// Expectation: Push releases the GIL while the ring is full, so the tasks run without deadlock
+TEST_F(TestAsyncQueue, test_full_ring_with_gil_tasks) {
+  auto env = python_adapter::set_python_scoped();
+  ScopedLongRunning::SetHook(std::make_unique<GilScopedLongRunningHook>());
+  AsyncQueue queue;
+  constexpr size_t kTaskNum = kRingCapacity * 2;
+  size_t count = 0;
+  py::gil_scoped_acquire acquire;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    queue.Push(std::make_shared<FuncTask>([&count]() {
+      py::gil_scoped_acquire task_acquire;
+      ++count;
+    }));
+  }
+  {
+    py::gil_scoped_release release;
+    queue.Wait();
+  }
+  ASSERT_EQ(count, kTaskNum);
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "runtime/pynative/op_sequence_capture.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr float kGraphOutputValue = 42;
+const ShapeVector kShape{2};
+}  // namespace
+
+class TestOpSequenceCapture : public UT::Common {
+ public:
+  TestOpSequenceCapture() {}
+
+  void SetUp() override {
+    (void)setenv("MS_DEV_PYNATIVE_OP_CAPTURE", "1", 1);
+    auto &capture = OpSequenceCapture::GetInstance();
+    capture.Clear();
+    // Read the env at the end of a sequence.
+    capture.EndSequence();
+
+    runner_.run_op = [this](const session::BackendOpRunInfoPtr &op_run_info, VectorRef *outputs) {
+      RunOp(op_run_info, outputs);
+    };
+    runner_.compile_graph = [this](const FuncGraphPtr &func_graph) {
+      ++compile_count_;
+      graph_ = func_graph;
+      return std::string("op_sequence");
+    };
+    runner_.run_graph = [this](const std::string &, const VectorRef &args, VectorRef *outputs) {
+      ++run_graph_count_;
+      graph_arg_num_ = args.size();
+      VectorRef graph_outputs;
+      auto output_abstract = graph_->output()->abstract()->cast<abstract::AbstractTuplePtr>();
+      for (size_t i = 0; i < output_abstract->size(); ++i) {
+        graph_outputs.emplace_back(MakeTensor(kGraphOutputValue));
+      }
+      outputs->emplace_back(graph_outputs);
+    };
+  }
+
+  void TearDown() override {
+    OpSequenceCapture::GetInstance().Clear();
+    (void)unsetenv("MS_DEV_PYNATIVE_OP_CAPTURE");
+  }
+
+  static tensor::TensorPtr MakeTensor(float value) {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape);
+    auto data = static_cast<float *>(tensor->data_c());
+    for (int64_t i = 0; i < kShape[0]; ++i) {
+      data[i] = value;
+    }
+    return tensor;
+  }
+
+  static float GetValue(const BaseRef &output) {
+    auto tensor = utils::cast<tensor::TensorPtr>(output);
+    return static_cast<float *>(tensor->data_c())[0];
+  }
+
+  // Run the op the way MindRTBackend::RunOp does, with the op computed on host.
+  void RunOp(const session::BackendOpRunInfoPtr &op_run_info, VectorRef *outputs) {
+    auto &capture = OpSequenceCapture::GetInstance();
+    if (capture.Replay(op_run_info, runner_, outputs)) {
+      return;
+    }
+    ++run_op_count_;
+    const auto &inputs = op_run_info->base_op_run_info.input_tensor;
+    auto lhs = static_cast<float *>(inputs[0]->data_c())[0];
+    auto rhs = static_cast<float *>(inputs[1]->data_c())[0];
+    const auto &op_name = op_run_info->base_op_run_info.op_name;
+    auto result = op_name == "Add" ? lhs + rhs : (op_name == "Mul" ? lhs * rhs : lhs - rhs);
+    outputs->emplace_back(MakeTensor(result));
+    capture.Record(op_run_info, *outputs);
+  }
+
+  BaseRef RunOp(const PrimitivePtr &prim, const tensor::TensorPtr &lhs, const tensor::TensorPtr &rhs) {
+    pynative::BaseOpRunInfo base_op_run_info;
+    base_op_run_info.op_name = prim->name();
+    base_op_run_info.device_target = "CPU";
+    base_op_run_info.lazy_build = true;
+    base_op_run_info.allow_deferred_run = true;
+    base_op_run_info.input_tensor = {lhs, rhs};
+    base_op_run_info.input_mask = {0, 0};
+    base_op_run_info.abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, kShape);
+    auto op_run_info =
+      std::make_shared<session::BackendOpRunInfo>(std::move(base_op_run_info), prim.get(), true, false);
+    VectorRef outputs;
+    RunOp(op_run_info, &outputs);
+    return outputs[0];
+  }
+
+  // ((x + w) * w) + w
+  float RunStep(const PrimitivePtr &second_prim, const tensor::TensorPtr &x, const tensor::TensorPtr &w) {
+    auto y = utils::cast<tensor::TensorPtr>(RunOp(add_, x, w));
+    auto z = utils::cast<tensor::TensorPtr>(RunOp(second_prim, y, w));
+    y = nullptr;
+    auto output = RunOp(add_, z, w);
+    z = nullptr;
+    OpSequenceCapture::GetInstance().EndSequence();
+    return GetValue(output);
+  }
+
+  OpSequenceRunner runner_;
+  PrimitivePtr add_ = std::make_shared<Primitive>("Add");
+  PrimitivePtr mul_ = std::make_shared<Primitive>("Mul");
+  PrimitivePtr sub_ = std::make_shared<Primitive>("Sub");
+  FuncGraphPtr graph_;
+  size_t run_op_count_{0};
+  size_t compile_count_{0};
+  size_t run_graph_count_{0};
+  size_t graph_arg_num_{0};
+};
+
+/// Feature: PyNative op sequence capture
+/// Description: Run the same op sequence in several steps
+/// Expectation: The sequence is replayed by running one graph after it is stable
+TEST_F(TestOpSequenceCapture, test_replay_stable_sequence) {
+  auto x = MakeTensor(1);
+  auto w = MakeTensor(2);
+  ASSERT_EQ(RunStep(mul_, x, w), 8);
+  ASSERT_EQ(RunStep(mul_, x, w), 8);
+  ASSERT_EQ(run_op_count_, 6);
+  ASSERT_EQ(compile_count_, 0);
+
+  ASSERT_EQ(RunStep(mul_, x, w), kGraphOutputValue);
+  ASSERT_EQ(run_op_count_, 6);
+  ASSERT_EQ(compile_count_, 1);
+  ASSERT_EQ(run_graph_count_, 1);
+  ASSERT_EQ(graph_arg_num_, 2);
+  // The output of the first op is only used by the second op, so it is not an output of the graph.
+  auto output = graph_->output()->cast<CNodePtr>();
+  ASSERT_NE(output, nullptr);
+  ASSERT_EQ(output->size(), 3);
+
+  ASSERT_EQ(RunStep(mul_, MakeTensor(3), w), kGraphOutputValue);
+  ASSERT_EQ(run_op_count_, 6);
+  ASSERT_EQ(compile_count_, 1);
+  ASSERT_EQ(run_graph_count_, 2);
+}
+
+/// Feature: PyNative op sequence capture
+/// Description: Run an op different from the captured one in the middle of the sequence
+/// Expectation: The deferred ops are run one by one and the results are right
+TEST_F(TestOpSequenceCapture, test_mismatch_op) {
+  auto x = MakeTensor(1);
+  auto w = MakeTensor(2);
+  (void)RunStep(mul_, x, w);
+  (void)RunStep(mul_, x, w);
+  ASSERT_EQ(RunStep(sub_, x, w), 3);
+  ASSERT_EQ(run_op_count_, 9);
+  ASSERT_EQ(run_graph_count_, 0);
+}
+
+/// Feature: PyNative op sequence capture
+/// Description: Read the output of a deferred op before the sequence ends
+/// Expectation: The deferred ops are run when flushed and the output is bound to the result
+TEST_F(TestOpSequenceCapture, test_flush_deferred_ops) {
+  auto x = MakeTensor(1);
+  auto w = MakeTensor(2);
+  (void)RunStep(mul_, x, w);
+  (void)RunStep(mul_, x, w);
+  auto y = RunOp(add_, x, w);
+  ASSERT_EQ(run_op_count_, 6);
+  OpSequenceCapture::GetInstance().Flush();
+  ASSERT_EQ(run_op_count_, 7);
+  ASSERT_EQ(GetValue(y), 3);
+  OpSequenceCapture::GetInstance().EndSequence();
+  ASSERT_EQ(run_graph_count_, 0);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "nlohmann/json.hpp"
+#include "runtime/graph_scheduler/actor/actor_profiler.h"
+
+namespace mindspore {
+namespace runtime {
+class ActorProfilerTest : public UT::Common {
+ public:
+  ActorProfilerTest() {}
+  void SetUp() override { ActorProfiler::GetInstance().Clear(); }
+  void TearDown() override {
+    ActorProfiler::GetInstance().Disable();
+    ActorProfiler::GetInstance().Clear();
+  }
+};
+
+/// Feature: Actor profiler.
+/// Description: Record events from several threads and dump the chrome trace.
+/// Expectation: The trace is valid json, every thread has its events and the queue waits are async slices.
+TEST_F(ActorProfilerTest, DumpChromeTrace) {
+  auto &profiler = ActorProfiler::GetInstance();
+  profiler.Enable(".");
+  ASSERT_TRUE(ActorProfiler::enable());
+  const size_t thread_num = 3;
+  const size_t event_num = 10;
+  auto kernel_id = profiler.RegisterName("kernel_\"actor\"");
+  EXPECT_EQ(profiler.RegisterName("kernel_\"actor\""), kernel_id);
+  auto memory_id = profiler.RegisterName("MemoryManagerActor");
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&]() {
+      for (size_t i = 0; i < event_num; ++i) {
+        auto send_time = ActorProfiler::Now();
+        profiler.Record(ActorTraceEventType::kQueueWait, kernel_id, send_time, ActorProfiler::Now());
+        ActorTraceScope run_scope(ActorTraceEventType::kRun, kernel_id);
+        {
+          ActorTraceScope alloc_scope(ActorTraceEventType::kMemoryAlloc, memory_id);
+        }
+        ActorTraceScope launch_scope(ActorTraceEventType::kLaunch, kernel_id);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const std::string file_path = "./actor_profiler_test_trace.json";
+  ASSERT_TRUE(profiler.DumpChromeTrace(file_path));
+  std::ifstream ifs(file_path);
+  ASSERT_TRUE(ifs.is_open());
+  auto trace = nlohmann::json::parse(ifs);
+  ifs.close();
+  (void)std::remove(file_path.c_str());
+
+  std::map<std::string, size_t> category_count;
+  std::map<std::string, size_t> phase_count;
+  for (const auto &event : trace["traceEvents"]) {
+    phase_count[event["ph"].get<std::string>()]++;
+    if (event.contains("cat")) {
+      category_count[event["cat"].get<std::string>()]++;
+      if (event["cat"] == "launch") {
+        EXPECT_EQ(event["name"], "kernel_\"actor\"");
+        EXPECT_GE(event["dur"].get<double>(), 0);
+      }
+    }
+  }
+  const size_t total = thread_num * event_num;
+  EXPECT_GE(phase_count["M"], thread_num);
+  EXPECT_EQ(category_count["queue_wait"], total * 2);
+  EXPECT_EQ(phase_count["b"], total);
+  EXPECT_EQ(phase_count["e"], total);
+  EXPECT_EQ(category_count["run"], total);
+  EXPECT_EQ(category_count["launch"], total);
+  EXPECT_EQ(category_count["memory_alloc"], total);
+}
+
+/// Feature: Actor profiler.
+/// Description: Record more events than the ring buffer holds, then record with the profiler disabled.
+/// Expectation: Only the latest events are kept, the disabled scope records nothing.
+TEST_F(ActorProfilerTest, RingBuffer) {
+  auto &profiler = ActorProfiler::GetInstance();
+  auto name_id = profiler.RegisterName("ring_buffer_actor");
+  const size_t loop = kActorTraceBufferSize * 4;
+  ActorTraceBuffer buffer(kActorTraceBufferSize, 0);
+  for (size_t i = 0; i < loop; ++i) {
+    buffer.Push(ActorTraceEventType::kRun, name_id, i, i + 1);
+  }
+  std::vector<ActorTraceEvent> events;
+  buffer.Snapshot(&events);
+  ASSERT_EQ(events.size(), kActorTraceBufferSize - 1);
+  EXPECT_EQ(events.front().start_ns, loop - kActorTraceBufferSize + 1);
+  EXPECT_EQ(events.back().start_ns, loop - 1);
+
+  profiler.Disable();
+  for (size_t i = 0; i < loop; ++i) {
+    ActorTraceScope scope(ActorTraceEventType::kRun, name_id);
+  }
+  const std::string file_path = "./actor_profiler_test_disabled.json";
+  ASSERT_TRUE(profiler.DumpChromeTrace(file_path));
+  std::ifstream ifs(file_path);
+  ASSERT_TRUE(ifs.is_open());
+  auto trace = nlohmann::json::parse(ifs);
+  ifs.close();
+  (void)std::remove(file_path.c_str());
+  for (const auto &event : trace["traceEvents"]) {
+    EXPECT_FALSE(event.contains("cat")) << event.dump();
+  }
+}
+
+/// Feature: Actor profiler.
+/// Description: Snapshot the ring buffer while its thread keeps pushing and wrapping around.
+/// Expectation: The snapshots only hold complete events, which are consecutive from the oldest to the latest.
+TEST_F(ActorProfilerTest, SnapshotWhileWriting) {
+  const size_t capacity = 1 << 10;
+  const uint64_t event_num = capacity * 1000;
+  ActorTraceBuffer buffer(capacity, 0);
+  std::atomic<bool> finished{false};
+  std::thread writer([&]() {
+    for (uint64_t i = 0; i < event_num; ++i) {
+      buffer.Push(ActorTraceEventType::kRun, static_cast<uint32_t>(i), i, i + 1);
+    }
+    finished = true;
+  });
+  std::vector<ActorTraceEvent> events;
+  bool complete = true;
+  while (!finished && complete) {
+    events.clear();
+    buffer.Snapshot(&events);
+    complete = events.size() < capacity;
+    for (size_t i = 0; i < events.size() && complete; ++i) {
+      complete = events[i].start_ns == events.front().start_ns + i && events[i].end_ns == events[i].start_ns + 1 &&
+                 events[i].name_id == static_cast<uint32_t>(events[i].start_ns);
+    }
+  }
+  writer.join();
+  ASSERT_TRUE(complete);
+  events.clear();
+  buffer.Snapshot(&events);
+  ASSERT_EQ(events.size(), capacity - 1);
+  EXPECT_EQ(events.back().start_ns, event_num - 1);
+}
+}  // namespace runtime
+}  // namespace mindspore
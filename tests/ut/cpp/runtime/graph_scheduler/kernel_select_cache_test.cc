@@ -0,0 +1,172 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "backend/common/session/kernel_graph.h"
+#include "include/common/utils/utils.h"
+#include "kernel/oplib/op_info_keys.h"
+#define private public
+#include "runtime/graph_scheduler/kernel_select_cache.h"
+#undef private
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr char kCachePath[] = "./kernel_select_cache_test.json";
+constexpr char kOtherCachePath[] = "./kernel_select_cache_test_other.json";
+constexpr char kDeviceName[] = "CPU";
+
+kernel::KernelBuildInfoPtr CreateBuildInfo() {
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetKernelType(CPU_KERNEL);
+  builder.SetProcessor(kernel::Processor::CPU);
+  builder.SetOpPattern(kernel::OpPattern::kBroadcastPattern);
+  builder.SetFusionType("ELEMWISE");
+  builder.SetCoreType("AiCore");
+  builder.SetOriginDataFormat(kOpFormat_NCHW);
+  builder.SetInputsFormat({kOpFormat_NCHW, kOpFormat_DEFAULT});
+  builder.SetOutputsFormat({kOpFormat_NC1HWC0});
+  builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeFloat16});
+  builder.SetOutputsDeviceType({kNumberTypeFloat32});
+  builder.SetInputsReshapeType({"NC", ""});
+  builder.SetOutputsReshapeType({"NH"});
+  builder.SetInputsKernelObjectType({kernel::KernelObjectType::TENSOR, kernel::KernelObjectType::TUPLE});
+  builder.SetOutputsKernelObjectType({kernel::KernelObjectType::TENSOR});
+  nlohmann::json data_desc;
+  data_desc["shape"] = {2, 3};
+  data_desc["dtype"] = "float32";
+  builder.SetOutputDataDesc({data_desc});
+  return builder.Build();
+}
+
+void ExpectSameBuildInfo(const kernel::KernelBuildInfoPtr &expect, const kernel::KernelBuildInfoPtr &actual) {
+  ASSERT_NE(actual, nullptr);
+  ASSERT_EQ(actual->kernel_type(), expect->kernel_type());
+  ASSERT_EQ(actual->processor(), expect->processor());
+  ASSERT_EQ(actual->op_pattern(), expect->op_pattern());
+  ASSERT_EQ(actual->fusion_type(), expect->fusion_type());
+  ASSERT_EQ(actual->core_type(), expect->core_type());
+  ASSERT_EQ(actual->GetOriginDataFormat(), expect->GetOriginDataFormat());
+  ASSERT_EQ(actual->GetAllInputFormats(), expect->GetAllInputFormats());
+  ASSERT_EQ(actual->GetAllOutputFormats(), expect->GetAllOutputFormats());
+  ASSERT_EQ(actual->GetAllInputDeviceTypes(), expect->GetAllInputDeviceTypes());
+  ASSERT_EQ(actual->GetAllOutputDeviceTypes(), expect->GetAllOutputDeviceTypes());
+  ASSERT_EQ(actual->GetAllInputReshapeType(), expect->GetAllInputReshapeType());
+  ASSERT_EQ(actual->GetAllOutputReshapeType(), expect->GetAllOutputReshapeType());
+  ASSERT_EQ(actual->GetAllInputKernelObjectTypes(), expect->GetAllInputKernelObjectTypes());
+  ASSERT_EQ(actual->GetAllOutputKernelObjectTypes(), expect->GetAllOutputKernelObjectTypes());
+  ASSERT_EQ(actual->output_data_desc(), expect->output_data_desc());
+}
+
+// An Add kernel of the two parameters of the shape.
+CNodePtr CreateAddKernel(const KernelGraphPtr &kernel_graph, const ShapeVector &shape) {
+  std::vector<AnfNodePtr> inputs{NewValueNode(prim::kPrimAdd)};
+  for (size_t i = 0; i < 2; ++i) {
+    auto parameter = kernel_graph->add_parameter();
+    parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    inputs.push_back(parameter);
+  }
+  auto kernel = kernel_graph->NewCNode(inputs);
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  return kernel;
+}
+}  // namespace
+
+class KernelSelectCacheTest : public UT::Common {
+ public:
+  KernelSelectCacheTest() {}
+
+  void SetUp() override {
+    ResetCache();
+    (void)std::remove(kCachePath);
+  }
+
+  void TearDown() override {
+    ResetCache();
+    (void)std::remove(kCachePath);
+  }
+
+  // The cache is a singleton of the process, every case starts from a disabled cache.
+  static void ResetCache() {
+    auto &cache = KernelSelectCache::GetInstance();
+    cache.enable_ = false;
+    cache.changed_ = false;
+    cache.hit_count_ = 0;
+    cache.miss_count_ = 0;
+    cache.cache_path_.clear();
+    cache.build_infos_.clear();
+  }
+};
+
+/// Feature: kernel select cache.
+/// Description: convert a kernel build info of no default field to json, dump and parse the json, and convert it back.
+/// Expectation: every field of the kernel build info is the same as the original one.
+TEST_F(KernelSelectCacheTest, test_build_info_json_round_trip) {
+  auto build_info = CreateBuildInfo();
+  auto build_info_json = KernelSelectCache::BuildInfoToJson(build_info);
+  auto parsed_json = nlohmann::json::parse(build_info_json.dump());
+  ExpectSameBuildInfo(build_info, KernelSelectCache::JsonToBuildInfo(parsed_json));
+  ASSERT_EQ(KernelSelectCache::BuildInfoToJson(KernelSelectCache::JsonToBuildInfo(parsed_json)), build_info_json);
+}
+
+/// Feature: kernel select cache.
+/// Description: store the build info of a kernel, save the cache and load it again, then fetch the kernel of the same
+/// inputs and the kernel of the different input shapes.
+/// Expectation: the former hits and gets the stored build info, the latter misses and keeps no build info.
+TEST_F(KernelSelectCacheTest, test_fetch_hit_and_miss) {
+  auto &cache = KernelSelectCache::GetInstance();
+  auto kernel_graph = std::make_shared<session::KernelGraph>();
+  auto kernel = CreateAddKernel(kernel_graph, {2, 3});
+  cache.Initialize(kCachePath, false);
+  std::string key;
+  ASSERT_FALSE(cache.Fetch(kernel, kDeviceName, &key));
+  ASSERT_FALSE(key.empty());
+  ASSERT_EQ(cache.miss_count_, 1u);
+
+  auto build_info = CreateBuildInfo();
+  AnfAlgo::SetSelectKernelBuildInfo(build_info, kernel.get());
+  cache.Store(key, kernel);
+  ASSERT_TRUE(cache.changed_);
+  cache.Save();
+  ASSERT_FALSE(cache.changed_);
+
+  // load the saved file as a restarted process does
+  ResetCache();
+  cache.Initialize(kOtherCachePath, false);
+  ASSERT_TRUE(cache.build_infos_.empty());
+  cache.Initialize(kCachePath, true);
+  ASSERT_EQ(cache.build_infos_.size(), 1u);
+
+  auto same_kernel = CreateAddKernel(kernel_graph, {2, 3});
+  std::string same_key;
+  ASSERT_TRUE(cache.Fetch(same_kernel, kDeviceName, &same_key));
+  ASSERT_EQ(same_key, key);
+  ASSERT_EQ(cache.hit_count_, 1u);
+  ExpectSameBuildInfo(build_info, AnfAlgo::GetSelectKernelBuildInfo(same_kernel));
+
+  auto other_kernel = CreateAddKernel(kernel_graph, {4, 3});
+  std::string other_key;
+  ASSERT_FALSE(cache.Fetch(other_kernel, kDeviceName, &other_key));
+  ASSERT_NE(other_key, key);
+  ASSERT_EQ(cache.miss_count_, 1u);
+  ASSERT_EQ(AnfAlgo::GetSelectKernelBuildInfo(other_kernel), nullptr);
+}
+}  // namespace runtime
+}  // namespace mindspore
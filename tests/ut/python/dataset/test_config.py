@@ -534,6 +534,23 @@ def test_fast_recovery():
     assert "set_fast_recovery() missing 1 required positional argument: 'fast_recovery'" in str(error_info.value)
 
 
+def test_jpeg_dct_scaling():
+    """
+    Feature: Test the set_enable_jpeg_dct_scaling and get_enable_jpeg_dct_scaling functions
+    Description: Check the default value, set the flag, and set it with invalid inputs
+    Expectation: It is disabled by default, the getter returns the value set, and TypeError is raised for non-boolean
+    """
+    assert not ds.config.get_enable_jpeg_dct_scaling()
+    ds.config.set_enable_jpeg_dct_scaling(True)
+    assert ds.config.get_enable_jpeg_dct_scaling()
+    ds.config.set_enable_jpeg_dct_scaling(False)
+    assert not ds.config.get_enable_jpeg_dct_scaling()
+
+    config_error_func(ds.config.set_enable_jpeg_dct_scaling, 1, TypeError, "enable must be a boolean dtype")
+    config_error_func(ds.config.set_enable_jpeg_dct_scaling, "True", TypeError, "enable must be a boolean dtype")
+    config_error_func(ds.config.set_enable_jpeg_dct_scaling, None, TypeError, "enable must be a boolean dtype")
+
+
 @pytest.mark.forked
 def test_debug_mode():
     """
@@ -612,5 +629,6 @@ if __name__ == '__main__':
     test_multiprocessing_timeout_interval()
     test_config_bool_type_error()
     test_fast_recovery()
+    test_jpeg_dct_scaling()
     test_debug_mode()
     test_error_samples_mode()
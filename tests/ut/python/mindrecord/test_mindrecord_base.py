@@ -13,7 +13,9 @@
 # limitations under the License.
 # ============================================================================
 """test mindrecord base"""
+import json
 import os
+import struct
 import uuid
 import pytest
 import numpy as np
@@ -1270,3 +1272,74 @@ def test_cv_file_overwrite_exception_02():
         writer.write_raw_data(data)
     assert 'Invalid file, mindrecord files already exist. Please check file path:' in str(err.value)
     remove_multi_files(mindrecord_file_name, FILES_NUM)
+
+
+def read_mindrecord_header(file_name):
+    """read the json header at the beginning of a mindrecord file"""
+    with open(file_name, 'rb') as f:
+        header_len = struct.unpack('<Q', f.read(8))[0]
+        return json.loads(f.read(header_len))
+
+
+def test_set_blob_layout_default_uncompressed():
+    """
+    Feature: Columnar blob layout in FileWriter
+    Description: set the columnar layout without compression, write blob fields, then read all and part of them
+    Expectation: the blob fields are stored uncompressed by default and read back unchanged
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    remove_one_file(mindrecord_file_name)
+    remove_one_file(mindrecord_file_name + ".db")
+
+    data = [{"label": i,
+             "image1": bytes("image{} bytes abc".format(i), encoding='UTF-8') * 16,
+             "image2": bytes("image{} bytes def".format(i), encoding='UTF-8'),
+             "mask": np.array([i, i + 1, i + 2], dtype=np.int64)} for i in range(6)]
+    writer = FileWriter(mindrecord_file_name)
+    assert writer.set_blob_layout("columnar") == SUCCESS
+    schema = {"label": {"type": "int32"},
+              "image1": {"type": "bytes"},
+              "image2": {"type": "bytes"},
+              "mask": {"type": "int64", "shape": [-1]}}
+    writer.add_schema(schema, "data is so cool")
+    writer.write_raw_data(data)
+    writer.commit()
+
+    header = read_mindrecord_header(mindrecord_file_name)
+    assert header["blob_layout"] == "columnar"
+    assert header["blob_compression"] == "none"
+
+    for columns in [None, ["image2", "label"], ["mask", "image1"]]:
+        reader = FileReader(file_name=mindrecord_file_name, columns=columns)
+        count = 0
+        for x in reader.get_next():
+            assert set(x.keys()) == set(columns if columns else schema.keys())
+            for field in x:
+                if isinstance(x[field], np.ndarray):
+                    assert (x[field] == data[count][field]).all()
+                else:
+                    assert x[field] == data[count][field]
+            count = count + 1
+        assert count == 6
+        reader.close()
+
+    remove_one_file(mindrecord_file_name)
+    remove_one_file(mindrecord_file_name + ".db")
+
+
+def test_set_blob_layout_invalid():
+    """
+    Feature: Columnar blob layout in FileWriter
+    Description: set an unknown blob layout and an unknown blob compression
+    Expectation: exception occur
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    writer = FileWriter(mindrecord_file_name)
+    with pytest.raises(RuntimeError) as err:
+        writer.set_blob_layout("page")
+    assert "blob layout: page should be 'row' or 'columnar'" in str(err.value)
+    with pytest.raises(RuntimeError) as err:
+        writer.set_blob_layout("columnar", "lz4")
+    assert "blob compression: lz4 should be 'none' or 'zlib'" in str(err.value)
+    remove_one_file(mindrecord_file_name)
+    remove_one_file(mindrecord_file_name + ".db")